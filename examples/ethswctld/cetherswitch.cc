@@ -116,6 +116,16 @@ void cetherswitch::handle_timeout(cthread &thread, uint32_t timer_id) {
 
       dpt.send_flow_stats_request(rofl::cauxid(0), 0, req);
     } break;
+    case TIMER_ID_AGE_ENTRIES: {
+
+      // re-register timer for next round
+      thread.add_timer(TIMER_ID_AGE_ENTRIES,
+                       rofl::ctimespec().expire_in(AGE_ENTRIES_INTERVAL));
+
+      // remove expired FIB and flow entries
+      cfibtable::age_fibs();
+      cflowtable::age_flowtables();
+    } break;
     default: {
       // unhandled timer event
     };
@@ -139,6 +149,10 @@ void cetherswitch::handle_dpt_open(rofl::crofdpt &dpt) {
   thread.add_timer(TIMER_ID_GET_FLOW_STATS,
                    rofl::ctimespec().expire_in(get_flow_stats_interval));
 
+  // start periodic timer for aging FIB and flow entries
+  thread.add_timer(TIMER_ID_AGE_ENTRIES,
+                   rofl::ctimespec().expire_in(AGE_ENTRIES_INTERVAL));
+
   dptid = dpt.get_dptid();
 
   // New connection => cleanup the RIB by re-creating the FIB table
@@ -187,6 +201,8 @@ void cetherswitch::handle_dpt_close(const rofl::cdptid &dptid) {
 
   thread.drop_timer(TIMER_ID_GET_FLOW_STATS);
 
+  thread.drop_timer(TIMER_ID_AGE_ENTRIES);
+
   std::cerr << "[cetherswitch] datapath detached, dptid: " << dptid << std::endl
             << cfibtable::get_fib(dptid);
 
@@ -235,7 +251,7 @@ void cetherswitch::handle_packet_in(rofl::crofdpt &dpt,
 
     // SRC is a unicast address => Update RIB: learn the source address and its
     // associated portno
-    fib.set_fib_entry(eth_src, in_port).set_port_no(in_port);
+    fib.learn(eth_src, in_port);
 
     // Drop frames destined to 01:80:c2:00:00:00
     if (eth_dst == rofl::caddress_ll("01:80:c2:00:00:00")) {
@@ -247,7 +263,8 @@ void cetherswitch::handle_packet_in(rofl::crofdpt &dpt,
     dump_packet_in(dpt, msg);
 
     // Flood multicast and yet unknown frames (DST)
-    if (eth_dst.is_multicast() || (not fib.has_fib_entry(eth_dst))) {
+    uint32_t out_port = 0;
+    if (eth_dst.is_multicast() || (not fib.lookup(eth_dst, out_port))) {
       rofl::openflow::cofactions actions(dpt.get_version());
       if (rofl::openflow10::OFP_VERSION == dpt.get_version()) {
         actions.add_action_output(rofl::cindex(0))
@@ -261,17 +278,13 @@ void cetherswitch::handle_packet_in(rofl::crofdpt &dpt,
     }
 
     // SRC and DST are unicast addresses => Create flow entry on data path
-    if (fib.has_fib_entry(eth_dst)) {
-      ftb.set_flow_entry(eth_src, eth_dst,
-                         fib.get_fib_entry(eth_dst).get_port_no());
+    ftb.set_flow_entry(eth_src, eth_dst, out_port);
 
-      if (rofl::openflow::OFP_NO_BUFFER != msg.get_buffer_id()) {
-        rofl::openflow::cofactions actions(dpt.get_version());
-        actions.add_action_output(rofl::cindex(0))
-            .set_port_no(fib.get_fib_entry(eth_dst).get_port_no());
-        dpt.send_packet_out_message(auxid, msg.get_buffer_id(), in_port,
-                                    actions);
-      }
+    if (rofl::openflow::OFP_NO_BUFFER != msg.get_buffer_id()) {
+      rofl::openflow::cofactions actions(dpt.get_version());
+      actions.add_action_output(rofl::cindex(0)).set_port_no(out_port);
+      dpt.send_packet_out_message(auxid, msg.get_buffer_id(), in_port,
+                                  actions);
     }
 
   } catch (exceptions::eFibInval &e) {
@@ -166,6 +166,7 @@ private:
   enum cetherswitch_timer_t {
     TIMER_ID_DUMP_FIB = 1,
     TIMER_ID_GET_FLOW_STATS = 2,
+    TIMER_ID_AGE_ENTRIES = 3,
   };
 
   static bool keep_on_running;
@@ -179,6 +180,8 @@ private:
 
   unsigned int get_flow_stats_interval;
   static const unsigned int GET_FLOW_STATS_DEFAULT_INTERVAL = 30; // seconds
+
+  static const unsigned int AGE_ENTRIES_INTERVAL = 1; // seconds
 };
 
 }; // namespace ethswctld
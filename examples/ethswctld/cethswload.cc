@@ -0,0 +1,235 @@
+/*
+ * cethswload.cc
+ *
+ *  Created on: 18.10.2026
+ */
+
+#include "cethswload.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <time.h>
+
+#include "cunixenv.h"
+
+using namespace rofl::examples::ethswctld;
+
+int cethswload::run(int argc, char **argv) {
+  rofl::cunixenv env_parser(argc, argv);
+
+  env_parser.add_option(rofl::coption(true, REQUIRED_ARGUMENT, 'c',
+                                      "controller",
+                                      "controller address", "127.0.0.1"));
+  env_parser.add_option(rofl::coption(true, REQUIRED_ARGUMENT, 'n', "hosts",
+                                      "number of hosts", "10000"));
+  env_parser.add_option(rofl::coption(true, REQUIRED_ARGUMENT, 'P', "pid",
+                                      "process id of controller", "0"));
+  env_parser.parse_args();
+
+  if (env_parser.is_arg_set("help")) {
+    std::cout << env_parser.get_usage(argv[0]);
+    return EXIT_SUCCESS;
+  }
+
+  unsigned int num_hosts = atoi(env_parser.get_arg("hosts").c_str());
+  pid_t pid = atoi(env_parser.get_arg("pid").c_str());
+
+  cethswload load(num_hosts);
+
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+
+  load.ctlid = rofl::cctlid(0);
+  load.add_ctl(load.ctlid)
+      .add_conn(rofl::cauxid(0))
+      .set_raddr(rofl::csockaddr(AF_INET, env_parser.get_arg("controller"),
+                                 6653))
+      .tcp_connect(vbitmap, rofl::crofconn::MODE_DATAPATH, false);
+
+  double deadline = now() + TIMEOUT;
+  while ((not load.connected) && (now() < deadline)) {
+    usleep(10000);
+  }
+  if (not load.connected) {
+    std::cerr << "[ethswload] controller not reachable" << std::endl;
+    return EXIT_FAILURE;
+  }
+  /* let the controller install its table-miss entry */
+  sleep(1);
+
+  report_process("idle", pid);
+
+  std::vector<double> latencies;
+  unsigned int lost = load.replay(false, latencies);
+  report("learning packet-in->packet-out", latencies, lost);
+
+  lost = load.replay(true, latencies);
+  report("flows packet-in->flow-mod", latencies, lost);
+
+  report_process("loaded", pid);
+
+  load.drop_ctl(load.ctlid);
+
+  return EXIT_SUCCESS;
+}
+
+cethswload::cethswload(unsigned int num_hosts, unsigned int num_ports)
+    : num_hosts(num_hosts), num_ports(num_ports), ctlid(0), connected(false),
+      flows(false) {}
+
+unsigned int cethswload::replay(bool flows,
+                                std::vector<double> &latencies) {
+  {
+    AcquireReadWriteLock rwlock(pending_rwlock);
+    this->flows = flows;
+    pending.clear();
+    this->latencies.clear();
+    this->latencies.reserve(num_hosts);
+  }
+
+  for (unsigned int i = 0; i < num_hosts; i++) {
+    while (true) {
+      {
+        AcquireReadLock rlock(pending_rwlock);
+        if (pending.size() < WINDOW)
+          break;
+      }
+      usleep(100);
+    }
+    uint64_t dst = flows ? hwaddr((i + 1) % num_hosts) : 0xffffffffffffULL;
+    send_packet_in(i, dst);
+  }
+
+  double deadline = now() + TIMEOUT;
+  while (now() < deadline) {
+    {
+      AcquireReadLock rlock(pending_rwlock);
+      if (pending.empty())
+        break;
+    }
+    usleep(1000);
+  }
+
+  AcquireReadWriteLock rwlock(pending_rwlock);
+  latencies.swap(this->latencies);
+  unsigned int lost = pending.size();
+  pending.clear();
+  return lost;
+}
+
+void cethswload::send_packet_in(unsigned int src, uint64_t dst) {
+  uint8_t frame[64];
+  memset(frame, 0, sizeof(frame));
+  rofl::caddress_ll eth_src(hwaddr(src));
+  rofl::caddress_ll eth_dst(dst);
+  eth_dst.pack(frame, 6);
+  eth_src.pack(frame + 6, 6);
+  frame[12] = 0x08; /* IPv4 */
+
+  uint32_t in_port = 1 + (src % num_ports);
+  rofl::openflow::cofmatch match(rofl::openflow13::OFP_VERSION);
+  match.set_in_port(in_port);
+  match.set_eth_dst(eth_dst);
+  match.set_eth_src(eth_src);
+  match.set_eth_type(0x0800);
+
+  {
+    AcquireReadWriteLock rwlock(pending_rwlock);
+    pending[eth_src.get_mac()] = now();
+  }
+
+  /* buffer id identifies the host in Packet-Outs */
+  set_ctl(ctlid).send_packet_in_message(
+      rofl::cauxid(0), src, sizeof(frame),
+      rofl::openflow13::OFPR_NO_MATCH, 0, 0, in_port, match, frame,
+      sizeof(frame));
+}
+
+void cethswload::answered(uint64_t src) {
+  double t = now();
+  AcquireReadWriteLock rwlock(pending_rwlock);
+  auto it = pending.find(src);
+  if (it == pending.end())
+    return;
+  latencies.push_back(t - it->second);
+  pending.erase(it);
+}
+
+void cethswload::report(const std::string &phase,
+                        std::vector<double> &latencies, unsigned int lost) {
+  std::cout << "[ethswload] " << phase << ": " << latencies.size()
+            << " answered, " << lost << " lost";
+  if (latencies.empty()) {
+    std::cout << std::endl;
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  double sum = 0;
+  for (auto l : latencies)
+    sum += l;
+  size_t n = latencies.size();
+  std::cout << ", latency us min: " << (unsigned long)(latencies[0] * 1e6)
+            << " avg: " << (unsigned long)(sum / n * 1e6)
+            << " p50: " << (unsigned long)(latencies[n / 2] * 1e6)
+            << " p99: " << (unsigned long)(latencies[(n * 99) / 100] * 1e6)
+            << " max: " << (unsigned long)(latencies[n - 1] * 1e6)
+            << std::endl;
+}
+
+void cethswload::report_process(const std::string &phase, pid_t pid) {
+  if (0 == pid)
+    return;
+  std::stringstream path;
+  path << "/proc/" << pid << "/status";
+  std::ifstream status(path.str().c_str());
+  std::string line;
+  std::cout << "[ethswload] controller " << phase << ":";
+  while (std::getline(status, line)) {
+    if ((line.compare(0, 6, "VmRSS:") == 0) ||
+        (line.compare(0, 8, "Threads:") == 0)) {
+      line.erase(std::remove(line.begin(), line.end(), '\t'), line.end());
+      std::cout << " " << line;
+    }
+  }
+  std::cout << std::endl;
+}
+
+double cethswload::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void cethswload::handle_ctl_open(rofl::crofctl &ctl) { connected = true; }
+
+void cethswload::handle_ctl_close(const rofl::cctlid &ctlid) {
+  connected = false;
+}
+
+void cethswload::handle_features_request(
+    rofl::crofctl &ctl, const rofl::cauxid &auxid,
+    rofl::openflow::cofmsg_features_request &msg) {
+  ctl.send_features_reply(auxid, msg.get_xid(), 0x0000000000010001ULL, 0, 1,
+                          0, auxid.get_id());
+}
+
+void cethswload::handle_packet_out(rofl::crofctl &ctl,
+                                   const rofl::cauxid &auxid,
+                                   rofl::openflow::cofmsg_packet_out &msg) {
+  if (flows || (msg.get_buffer_id() >= num_hosts))
+    return;
+  answered(hwaddr(msg.get_buffer_id()));
+}
+
+void cethswload::handle_flow_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_flow_mod &msg) {
+  if ((not flows) ||
+      (msg.get_flowmod().get_command() != rofl::openflow::OFPFC_ADD))
+    return;
+  try {
+    answered(msg.get_flowmod().get_match().get_eth_src().get_mac());
+  } catch (rofl::openflow::eOxmNotFound &e) {
+    // table-miss entry
+  }
+}
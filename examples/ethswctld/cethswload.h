@@ -0,0 +1,144 @@
+/*
+ * cethswload.h
+ *
+ *  Created on: 18.10.2026
+ */
+
+#ifndef CETHSWLOAD_H_
+#define CETHSWLOAD_H_ 1
+
+#include <inttypes.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <rofl/common/crofbase.h>
+#include <rofl/common/locking.hpp>
+
+namespace rofl {
+namespace examples {
+namespace ethswctld {
+
+/**
+ * @ingroup common_howto_ethswctld
+ *
+ * @brief	Load generator for ethswctld
+ *
+ * Emulates a datapath element connecting to ethswctld and replays
+ * Packet-In messages for a given number of hosts in two phases:
+ *
+ * 1. Learning: each host sends a broadcast frame, which ethswctld learns
+ * and floods via Packet-Out.
+ *
+ * 2. Flows: each host i sends a frame to host i+1, which makes ethswctld
+ * install a flow entry via Flow-Mod.
+ *
+ * For each phase the time between sending a Packet-In and receiving the
+ * resulting Packet-Out or Flow-Mod is measured. Memory consumption and
+ * number of threads of the controller process are read from procfs, if
+ * its process id was given.
+ */
+class cethswload : public rofl::crofbase {
+public:
+  /**
+   * @brief	Runs the load generator, returns exit code
+   */
+  static int run(int argc, char **argv);
+
+public:
+  /**
+   * @brief	cethswload destructor
+   */
+  virtual ~cethswload(){};
+
+  /**
+   * @brief	cethswload constructor
+   *
+   * @param num_hosts number of emulated hosts
+   * @param num_ports number of ports hosts are distributed over
+   */
+  cethswload(unsigned int num_hosts, unsigned int num_ports = 48);
+
+private:
+  /**
+   * @brief	Sends Packet-Ins for all hosts and waits for the responses
+   *
+   * @param flows false: learning phase, true: flow phase
+   * @param latencies latency in seconds per response received
+   * @return number of responses lost
+   */
+  unsigned int replay(bool flows, std::vector<double> &latencies);
+
+  /**
+   * @brief	Sends Packet-In for a frame from host src to host dst
+   */
+  void send_packet_in(unsigned int src, uint64_t dst);
+
+  /**
+   * @brief	Marks Packet-In from host src as answered
+   */
+  void answered(uint64_t src);
+
+  /**
+   * @brief	Returns hardware address of host i
+   */
+  uint64_t hwaddr(unsigned int i) const {
+    return 0x020000000000ULL + i + 1;
+  };
+
+  /**
+   * @brief	Prints latency statistics
+   */
+  static void report(const std::string &phase, std::vector<double> &latencies,
+                     unsigned int lost);
+
+  /**
+   * @brief	Prints memory and thread statistics of process pid
+   */
+  static void report_process(const std::string &phase, pid_t pid);
+
+  /**
+   * @brief	Returns monotonic time in seconds
+   */
+  static double now();
+
+private:
+  virtual void handle_ctl_open(rofl::crofctl &ctl);
+
+  virtual void handle_ctl_close(const rofl::cctlid &ctlid);
+
+  virtual void
+  handle_features_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                          rofl::openflow::cofmsg_features_request &msg);
+
+  virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_packet_out &msg);
+
+  virtual void handle_flow_mod(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                               rofl::openflow::cofmsg_flow_mod &msg);
+
+private:
+  // maximum number of unanswered Packet-Ins
+  static const unsigned int WINDOW = 64;
+
+  // seconds to wait for outstanding responses
+  static const unsigned int TIMEOUT = 5;
+
+  unsigned int num_hosts;
+  unsigned int num_ports;
+
+  rofl::cctlid ctlid;
+  bool connected;
+  bool flows;
+
+  // send time of unanswered Packet-Ins by source hardware address
+  std::map<uint64_t, double> pending;
+  std::vector<double> latencies;
+  rofl::crwlock pending_rwlock;
+};
+
+}; // namespace ethswctld
+}; // namespace examples
+}; // namespace rofl
+
+#endif /* CETHSWLOAD_H_ */
@@ -10,11 +10,11 @@
 
 #include <inttypes.h>
 #include <ostream>
+#include <time.h>
 
 #include <rofl/common/caddress.h>
 #include <rofl/common/crofbase.h>
 #include <rofl/common/crofdpt.h>
-#include <rofl/common/cthread.hpp>
 
 namespace rofl {
 namespace examples {
@@ -54,36 +54,6 @@ public:
 
 }; // namespace exceptions
 
-class cfibentry; // forward declaration
-
-/**
- * @ingroup common_howto_ethswctld
- * @interface cfibentry_env
- *
- * @brief	Defines the environment expected by an instance of class
- * cfibentry.
- */
-class cfibentry_env {
-  friend class cfibentry;
-
-public:
-  /**
-   * @brief	cfibentry_env destructor
-   */
-  virtual ~cfibentry_env(){};
-
-protected:
-  /**
-   * @brief	Called when this FIB entry has expired.
-   */
-  virtual void fib_timer_expired(const rofl::caddress_ll &hwaddr) = 0;
-
-  /**
-   * @brief	Called when this FIB entry's port number has been updated.
-   */
-  virtual void fib_port_update(const cfibentry &entry) = 0;
-};
-
 /**
  * @ingroup common_howto_ethswctld
  *
@@ -93,27 +63,30 @@ protected:
  * and stores a single mapping between a host hardware address used
  * for ethernet based communication and the physical port on the datapath
  * element pointing towards this station. An entry is a soft-state
- * entity running a timer of length 60 seconds. Once expired, a notification
- * method is called in cfibentry's environment to indicate that is entry
- * has become stale. For timer support, cfibentry derives from class
- * rofl::ciosrv.
+ * entity expiring 60 seconds after it has been learned or refreshed.
+ * Entries are plain values stored in place in the hash table of class
+ * cfibtable, which ages them on a single timer wheel.
+ *
+ * @see cfibtable
  */
-class cfibentry : public rofl::cthread_env {
+class cfibentry {
+  friend class cfibtable;
+
 public:
+  /**
+   * @brief	cfibentry default constructor for empty table slots
+   */
+  cfibentry() : hwaddr(0), port_no(0), expiry(0), scheduled(0){};
+
   /**
    * @brief	cfibentry constructor
    *
-   * @param env environment for this cfibentry instance
    * @param hwaddr ethernet hardware address used by station
    * @param port_no OpenFlow port number of port pointing towards the station
    */
-  cfibentry(cfibentry_env *env, const rofl::caddress_ll &hwaddr,
-            uint32_t port_no);
-
-  /**
-   * @brief	cfibentry destructor
-   */
-  virtual ~cfibentry();
+  cfibentry(const rofl::caddress_ll &hwaddr, uint32_t port_no)
+      : hwaddr(hwaddr.get_mac()), port_no(port_no), expiry(0),
+        scheduled(0){};
 
 public:
   /**
@@ -134,35 +107,21 @@ public:
    *
    * @param port_no new OpenFlow port number of port pointing towards station
    */
-  void set_port_no(uint32_t port_no);
+  void set_port_no(uint32_t port_no) { this->port_no = port_no; };
 
   /**
    * @brief	Returns ethernet hardware address identifying this host.
    *
    * @return host ethernet hardware address
    */
-  const rofl::caddress_ll &get_hwaddr() const { return hwaddr; };
-
-  /**@}*/
+  rofl::caddress_ll get_hwaddr() const { return rofl::caddress_ll(hwaddr); };
 
-private:
   /**
-   * @brief	Handle timeout events generated by class rofl::ciosrv.
-   *
-   * This method is overwritten from class rofl::ciosrv and is
-   * called whenever a previously registered timer event has occured.
-   * The 'opaque' and 'data' values are the ones used when calling method
-   * rofl::ciosrv::register_timer().
-   *
-   * @param opaque timer type that can be freely chosen by this class
-   * @param data pointer to an opaque data segment or NULL
-   *
-   * @see rofl::ciosrv
+   * @brief	Returns point in time in seconds this entry expires at.
    */
-  void handle_timeout(cthread &thread, uint32_t timer_id) override;
-  void handle_read_event(cthread &thread, int fd) override {}
-  void handle_write_event(cthread &thread, int fd) override {}
-  void handle_wakeup(cthread &thread) override {}
+  time_t get_expiry() const { return expiry; };
+
+  /**@}*/
 
 public:
   /**
@@ -170,28 +129,22 @@ public:
    */
   friend std::ostream &operator<<(std::ostream &os, cfibentry const &entry) {
     os << "<cfibentry portno: " << entry.port_no << " >" << std::endl;
-    os << entry.hwaddr;
+    os << entry.get_hwaddr();
     return os;
   };
 
 private:
-  enum cfibentry_timer_t {
-    TIMER_ID_ENTRY_EXPIRED = 1,
-  };
-
-  // pointer to class defining the environment for this cfibentry
-  cfibentry_env *env;
+  // station ethernet hardware address
+  uint64_t hwaddr;
 
   // OpenFlow port number pointing towards port
   uint32_t port_no;
-  // station ethernet hardware address
-  rofl::caddress_ll hwaddr;
 
-  // timeout value in seconds for this FIB entry
-  time_t entry_timeout;
-  static const time_t CFIBENTRY_DEFAULT_TIMEOUT;
+  // entry expires at this point in time
+  time_t expiry;
 
-  rofl::cthread thread;
+  // expiry of the event scheduled on the timer wheel for this entry
+  time_t scheduled;
 };
 
 }; // namespace ethswctld
@@ -10,3 +10,5 @@
 using namespace rofl::examples::ethswctld;
 
 std::map<rofl::cdptid, cfibtable *> cfibtable::fibtables;
+rofl::crwlock cfibtable::fibtables_rwlock;
+/*static*/ const time_t cfibtable::CFIBENTRY_DEFAULT_TIMEOUT = 60;
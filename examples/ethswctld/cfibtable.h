@@ -12,12 +12,15 @@
 #include <inttypes.h>
 #include <map>
 #include <ostream>
+#include <time.h>
 
 #include <rofl/common/caddress.h>
 #include <rofl/common/crofbase.h>
 #include <rofl/common/crofdpt.h>
 
 #include "cfibentry.h"
+#include "chashtable.h"
+#include "ctimerwheel.h"
 
 namespace rofl {
 namespace examples {
@@ -40,10 +43,14 @@ namespace ethswctld {
  * 2. Methods on CRUD operations for instances of class cfibentry in a cfibtable
  * instance
  *
+ * Entries are stored in an open-addressing hash table keyed by the 48-bit
+ * hardware address and expire via a single timer wheel per table, which is
+ * advanced by method age(). References to entries returned by this class
+ * are invalidated by adding or removing entries, including expiry.
+ *
  * @see cfibentry
- * @see cfibentry_env
  */
-class cfibtable : public cfibentry_env {
+class cfibtable {
 public:
   /**
    * @name	Methods for managing Forwarding Information Bases
@@ -61,6 +68,7 @@ public:
    * @param dptid rofl-common's internal handle for datapath element
    */
   static cfibtable &add_fib(const rofl::cdptid &dptid) {
+    AcquireReadWriteLock rwlock(cfibtable::fibtables_rwlock);
     if (cfibtable::fibtables.find(dptid) != cfibtable::fibtables.end()) {
       delete cfibtable::fibtables[dptid];
       cfibtable::fibtables.erase(dptid);
@@ -81,6 +89,7 @@ public:
    * @param dptid rofl-common's internal handle for datapath element
    */
   static cfibtable &set_fib(const rofl::cdptid &dptid) {
+    AcquireReadWriteLock rwlock(cfibtable::fibtables_rwlock);
     if (cfibtable::fibtables.find(dptid) == cfibtable::fibtables.end()) {
       new cfibtable(dptid);
     }
@@ -99,6 +108,7 @@ public:
    * @exception eFibNotFound
    */
   static const cfibtable &get_fib(const rofl::cdptid &dptid) {
+    AcquireReadLock rlock(cfibtable::fibtables_rwlock);
     if (cfibtable::fibtables.find(dptid) == cfibtable::fibtables.end()) {
       throw exceptions::eFibNotFound("cfibtable::get_fib() dptid not found");
     }
@@ -111,6 +121,7 @@ public:
    * @param dptid rofl-common's internal handle for datapath element
    */
   static void drop_fib(const rofl::cdptid &dptid) {
+    AcquireReadWriteLock rwlock(cfibtable::fibtables_rwlock);
     if (cfibtable::fibtables.find(dptid) == cfibtable::fibtables.end()) {
       return;
     }
@@ -124,10 +135,24 @@ public:
    * @param dptid rofl-common's internal handle for datapath element
    */
   static bool has_fib(const rofl::cdptid &dptid) {
+    AcquireReadLock rlock(cfibtable::fibtables_rwlock);
     return (
         not(cfibtable::fibtables.find(dptid) == cfibtable::fibtables.end()));
   };
 
+  /**
+   * @brief	Removes expired entries from all cfibtable instances.
+   *
+   * To be called periodically, once per second.
+   */
+  static void age_fibs() {
+    AcquireReadLock rlock(cfibtable::fibtables_rwlock);
+    time_t now = cfibtable::now();
+    for (auto it : cfibtable::fibtables) {
+      it.second->age(now);
+    }
+  };
+
   /**@}*/
 
 public:
@@ -141,11 +166,9 @@ public:
    * @brief	Deletes all entries stored in this cfibtable instance.
    */
   void clear() {
-    for (std::map<rofl::caddress_ll, cfibentry *>::iterator it = ftable.begin();
-         it != ftable.end(); ++it) {
-      delete it->second;
-    }
+    AcquireReadWriteLock rwlock(ftable_rwlock);
     ftable.clear();
+    timers.clear();
   };
 
   /**
@@ -164,11 +187,9 @@ public:
       throw exceptions::eFibInval(
           "cfibtable::add_fib_entry() hwaddr validation failed");
     }
-    if (ftable.find(hwaddr) != ftable.end()) {
-      drop_fib_entry(hwaddr);
-    }
-    ftable[hwaddr] = new cfibentry(this, hwaddr, portno);
-    return *(ftable[hwaddr]);
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    ftable.erase(hwaddr.get_mac());
+    return insert(hwaddr, portno, now());
   };
 
   /**
@@ -187,10 +208,11 @@ public:
       throw exceptions::eFibInval(
           "cfibtable::set_fib_entry() hwaddr validation failed");
     }
-    if (ftable.find(hwaddr) == ftable.end()) {
-      ftable[hwaddr] = new cfibentry(this, hwaddr, portno);
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    if (cfibentry *entry = ftable.find(hwaddr.get_mac())) {
+      return *entry;
     }
-    return *(ftable[hwaddr]);
+    return insert(hwaddr, portno, now());
   };
 
   /**
@@ -209,11 +231,13 @@ public:
       throw exceptions::eFibInval(
           "cfibtable::set_fib_entry() hwaddr validation failed");
     }
-    if (ftable.find(hwaddr) == ftable.end()) {
+    AcquireReadLock rlock(ftable_rwlock);
+    cfibentry *entry = ftable.find(hwaddr.get_mac());
+    if (nullptr == entry) {
       throw exceptions::eFibNotFound(
           "cfibtable::set_fib_entry() hwaddr not found");
     }
-    return *(ftable[hwaddr]);
+    return *entry;
   };
 
   /**
@@ -232,11 +256,13 @@ public:
       throw exceptions::eFibInval(
           "cfibtable::get_fib_entry() hwaddr validation failed");
     }
-    if (ftable.find(hwaddr) == ftable.end()) {
+    AcquireReadLock rlock(ftable_rwlock);
+    const cfibentry *entry = ftable.find(hwaddr.get_mac());
+    if (nullptr == entry) {
       throw exceptions::eFibNotFound(
-          "cfibtable::set_fib_entry() hwaddr not found");
+          "cfibtable::get_fib_entry() hwaddr not found");
     }
-    return *(ftable.at(hwaddr));
+    return *entry;
   };
 
   /**
@@ -245,12 +271,8 @@ public:
    * @param hwaddr ethernet hardware address
    */
   void drop_fib_entry(const rofl::caddress_ll &hwaddr) {
-    if (ftable.find(hwaddr) == ftable.end()) {
-      return;
-    }
-    cfibentry *fibentry = ftable[hwaddr];
-    ftable.erase(hwaddr);
-    delete fibentry;
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    ftable.erase(hwaddr.get_mac());
   };
 
   /**
@@ -259,7 +281,108 @@ public:
    * @param hwaddr ethernet hardware address
    */
   bool has_fib_entry(const rofl::caddress_ll &hwaddr) const {
-    return (not(ftable.find(hwaddr) == ftable.end()));
+    AcquireReadLock rlock(ftable_rwlock);
+    return (nullptr != ftable.find(hwaddr.get_mac()));
+  };
+
+  /**@}*/
+
+public:
+  /**
+   * @name	Methods for learning and aging
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Learns or refreshes the port a host is reachable via.
+   *
+   * Creates an entry for hwaddr or updates its port number and restarts
+   * its expiry timer.
+   *
+   * @param hwaddr ethernet hardware address
+   * @param portno host is reachable via port using this OpenFlow port number
+   * @exception eFibInval hardware address validation failed
+   */
+  void learn(const rofl::caddress_ll &hwaddr, uint32_t portno) {
+    if (hwaddr.is_multicast() || hwaddr.is_null()) {
+      throw exceptions::eFibInval(
+          "cfibtable::learn() hwaddr validation failed");
+    }
+    time_t now = cfibtable::now();
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    if (cfibentry *entry = ftable.find(hwaddr.get_mac())) {
+      /* the scheduled event reschedules itself on expiry */
+      entry->set_port_no(portno);
+      entry->expiry = now + entry_timeout;
+      return;
+    }
+    insert(hwaddr, portno, now);
+  };
+
+  /**
+   * @brief	Looks up the port a host is reachable via.
+   *
+   * @param hwaddr ethernet hardware address
+   * @param portno set to port number of existing entry
+   * @return true if an entry for hwaddr exists
+   */
+  bool lookup(const rofl::caddress_ll &hwaddr, uint32_t &portno) const {
+    AcquireReadLock rlock(ftable_rwlock);
+    const cfibentry *entry = ftable.find(hwaddr.get_mac());
+    if (nullptr == entry) {
+      return false;
+    }
+    portno = entry->get_port_no();
+    return true;
+  };
+
+  /**
+   * @brief	Removes all entries expired until now.
+   *
+   * @param now current time in seconds as returned by cfibtable::now()
+   */
+  void age(time_t now) {
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    timers.advance(now, [&](uint64_t hwaddr, time_t expiry) {
+      cfibentry *entry = ftable.find(hwaddr);
+      if ((nullptr == entry) || (entry->scheduled != expiry)) {
+        /* entry was removed or replaced meanwhile */
+        return;
+      }
+      if (entry->expiry > now) {
+        /* entry was refreshed meanwhile */
+        entry->scheduled = entry->expiry;
+        timers.schedule(hwaddr, entry->scheduled);
+        return;
+      }
+      ftable.erase(hwaddr);
+    });
+  };
+
+  /**
+   * @brief	Returns number of entries.
+   */
+  size_t size() const {
+    AcquireReadLock rlock(ftable_rwlock);
+    return ftable.size();
+  };
+
+  /**
+   * @brief	Returns bytes allocated for entries and timers.
+   */
+  size_t memory() const {
+    AcquireReadLock rlock(ftable_rwlock);
+    return ftable.memory() + timers.memory();
+  };
+
+  /**
+   * @brief	Returns current time in seconds from a monotonic clock.
+   */
+  static time_t now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
   };
 
   /**@}*/
@@ -268,7 +391,9 @@ private:
   /**
    * @brief	cfibtable constructor
    */
-  cfibtable(const rofl::cdptid &dptid) : dptid(dptid) {
+  cfibtable(const rofl::cdptid &dptid)
+      : dptid(dptid), entry_timeout(CFIBENTRY_DEFAULT_TIMEOUT),
+        timers(cfibtable::now()) {
     cfibtable::fibtables[dptid] = this;
   };
 
@@ -281,48 +406,48 @@ private:
   };
 
 private:
-  /*
-   * methods overwritten from cfibentry_env
-   */
-
   /**
-   * @brief	Called when a cfibentry's timer has expired.
+   * @brief	Stores a new entry and schedules its expiry, called with
+   * ftable_rwlock held.
    */
-  virtual void fib_timer_expired(const rofl::caddress_ll &hwaddr) {
-    drop_fib_entry(hwaddr);
+  cfibentry &insert(const rofl::caddress_ll &hwaddr, uint32_t portno,
+                    time_t now) {
+    cfibentry entry(hwaddr, portno);
+    entry.expiry = entry.scheduled = now + entry_timeout;
+    timers.schedule(entry.hwaddr, entry.scheduled);
+    return *(ftable.insert(entry.hwaddr, std::move(entry)).first);
   };
 
-  /**
-   * @brief	Called when a cfibentry's assigned port has changed.
-   */
-  virtual void fib_port_update(const cfibentry &entry){};
-
 public:
   /**
    *
    */
   friend std::ostream &operator<<(std::ostream &os, cfibtable const &fib) {
-    try {
-#if 0
-			os << "<cfibtable dpid: "
-					<< rofl::crofdpt::get_dpt(fib.dptid).get_dpid().str() << " >" << std::endl;
-#endif
-    } catch (rofl::eRofDptNotFound &e) {
-      os << "<cfibtable dptid:" << fib.dptid << " >" << std::endl;
-    }
+    os << "<cfibtable dptid:" << fib.dptid << " entries: " << fib.size()
+       << " memory: " << fib.memory() << " >" << std::endl;
 
-    for (std::map<rofl::caddress_ll, cfibentry *>::const_iterator it =
-             fib.ftable.begin();
-         it != fib.ftable.end(); ++it) {
-      os << *(it->second);
-    }
+    AcquireReadLock rlock(fib.ftable_rwlock);
+    fib.ftable.for_each([&](uint64_t hwaddr, const cfibentry &entry) {
+      os << entry;
+    });
     return os;
   };
 
 private:
   static std::map<rofl::cdptid, cfibtable *> fibtables;
+  static crwlock fibtables_rwlock;
   rofl::cdptid dptid;
-  std::map<rofl::caddress_ll, cfibentry *> ftable;
+
+  // entries keyed by hardware address
+  chashtable<uint64_t, cfibentry, cmachash> ftable;
+  mutable crwlock ftable_rwlock;
+
+  // timeout value in seconds for FIB entries
+  time_t entry_timeout;
+  static const time_t CFIBENTRY_DEFAULT_TIMEOUT;
+
+  // expiry events for all entries
+  ctimerwheel<uint64_t> timers;
 };
 
 }; // namespace ethswctld
@@ -7,105 +7,93 @@
 
 #include "cflowentry.h"
 
+#include <map>
+
 using namespace rofl::examples::ethswctld;
 
-cflowentry::cflowentry(cflowentry_env *flowenv, const rofl::cdptid &dptid,
-                       const rofl::caddress_ll &src,
-                       const rofl::caddress_ll &dst, uint32_t port_no)
-    : env(flowenv), dptid(dptid), port_no(port_no), src(src), dst(dst),
-      entry_timeout(CFLOWENTRY_DEFAULT_TIMEOUT), thread(this) {
-  flow_mod_add();
-  thread.add_timer(CFLOWENTRY_ENTRY_EXPIRED,
-                   rofl::ctimespec().expire_in(entry_timeout));
-  std::cerr << "[cflowentry] created" << std::endl << *this;
-  thread.start("cflowentry");
-}
+namespace {
+
+/* Flow-Mods differ in addresses, port and timeout only, so they are
+ * stamped from templates compiled once per version and command */
+rofl::crwlock templates_lock;
+std::map<std::pair<uint8_t, uint16_t>, rofl::openflow::cofmsg_template>
+    templates;
+
+}; // end of anonymous namespace
+
+rofl::openflow::cofmsg_stamped *
+cflowentry::flow_mod_stamp(uint8_t version, uint16_t command) const {
+  std::pair<uint8_t, uint16_t> key(version, command);
+  rofl::openflow::cofmsg_template tmpl;
+  {
+    rofl::AcquireReadLock rlock(templates_lock);
+    auto it = templates.find(key);
+    if (it != templates.end())
+      tmpl = it->second;
+  }
 
-cflowentry::~cflowentry() {
-  std::cerr << "[cflowentry] deleted" << std::endl << *this;
-  flow_mod_delete();
-}
+  if (tmpl.empty()) {
+    rofl::openflow::cofflowmod fe(version);
+    rofl::cindex index(0);
 
-void cflowentry::handle_timeout(cthread &thread, uint32_t timer_id) {
-  switch (timer_id) {
-  case CFLOWENTRY_ENTRY_EXPIRED: {
-    env->flow_timer_expired(*this);
-  } break;
-  }
-}
+    fe.set_command(command);
+    fe.set_table_id(0);
+    fe.set_match().set_eth_src(get_src());
+    fe.set_match().set_eth_dst(get_dst());
+
+    if (command != rofl::openflow::OFPFC_DELETE_STRICT) {
+      switch (version) {
+      case rofl::openflow10::OFP_VERSION: {
+        fe.set_actions().add_action_output(index++).set_port_no(port_no);
+      } break;
+      default: {
+        fe.set_instructions()
+            .set_inst_apply_actions()
+            .set_actions()
+            .add_action_output(index++)
+            .set_port_no(port_no);
+      };
+      }
+    }
 
-void cflowentry::set_out_port_no(uint32_t port_no) {
-  if (port_no != this->port_no) {
-    this->port_no = port_no;
-    flow_mod_modify();
+    rofl::openflow::cofmsg_flow_mod msg(version, 0, fe);
+    tmpl = rofl::openflow::cofmsg_template(msg);
+
+    rofl::AcquireReadWriteLock rwlock(templates_lock);
+    templates[key] = tmpl;
   }
 
-  thread.add_timer(CFLOWENTRY_ENTRY_EXPIRED,
-                   rofl::ctimespec().expire_in(entry_timeout));
+  rofl::openflow::cofmsg_stamped *msg = tmpl.stamp();
+  msg->set_eth_src(get_src()).set_eth_dst(get_dst());
+  msg->set_field(rofl::openflow::cofmsg_template::FIELD_HARD_TIMEOUT,
+                 entry_timeout);
+  if (tmpl.has_field(rofl::openflow::cofmsg_template::FIELD_OUT_PORT))
+    msg->set_out_port(port_no);
+  return msg;
 }
 
-void cflowentry::flow_mod_add() {
+void cflowentry::flow_mod_add(rofl::crofdpt &dpt) const {
   try {
-    rofl::crofdpt &dpt = env->set_dpt(dptid);
-
-    rofl::openflow::cofflowmod fe(dpt.get_version());
-    rofl::cindex index(0);
-
-    fe.set_command(rofl::openflow::OFPFC_ADD);
-    fe.set_table_id(0);
-    fe.set_hard_timeout(entry_timeout);
-    fe.set_match().set_eth_src(src);
-    fe.set_match().set_eth_dst(dst);
-
-    switch (dpt.get_version()) {
-    case rofl::openflow10::OFP_VERSION: {
-      fe.set_actions().add_action_output(index++).set_port_no(port_no);
-    } break;
-    default: {
-      fe.set_instructions()
-          .set_inst_apply_actions()
-          .set_actions()
-          .add_action_output(index++)
-          .set_port_no(port_no);
-    };
-    }
-
-    dpt.send_flow_mod_message(rofl::cauxid(0), fe);
+    dpt.send_stamped_message(
+        rofl::cauxid(0),
+        flow_mod_stamp(dpt.get_version(), rofl::openflow::OFPFC_ADD));
 
   } catch (rofl::eRofConnNotConnected &e) {
     // control connection not connected
   } catch (rofl::eRofQueueFull &e) {
     // control channel congested
+  } catch (rofl::eRofConnInvalid &e) {
+    // datapath changed OpenFlow version
+  } catch (rofl::eBadVersion &e) {
+    // OpenFlow version not negotiated yet
   }
 }
 
-void cflowentry::flow_mod_modify() {
+void cflowentry::flow_mod_modify(rofl::crofdpt &dpt) const {
   try {
-    rofl::crofdpt &dpt = env->set_dpt(dptid);
-
-    rofl::openflow::cofflowmod fe(dpt.get_version());
-    rofl::cindex index(0);
-
-    fe.set_command(rofl::openflow::OFPFC_MODIFY_STRICT);
-    fe.set_table_id(0);
-    fe.set_hard_timeout(entry_timeout);
-    fe.set_match().set_eth_src(src);
-    fe.set_match().set_eth_dst(dst);
-
-    switch (dpt.get_version()) {
-    case rofl::openflow10::OFP_VERSION: {
-      fe.set_actions().add_action_output(index++).set_port_no(port_no);
-    } break;
-    default: {
-      fe.set_instructions()
-          .set_inst_apply_actions()
-          .set_actions()
-          .add_action_output(index++)
-          .set_port_no(port_no);
-    };
-    }
-
-    dpt.send_flow_mod_message(rofl::cauxid(0), fe);
+    dpt.send_stamped_message(
+        rofl::cauxid(0),
+        flow_mod_stamp(dpt.get_version(), rofl::openflow::OFPFC_MODIFY_STRICT));
 
   } catch (rofl::eRofConnNotConnected &e) {
     // control connection not connected
@@ -116,24 +104,19 @@ void cflowentry::flow_mod_modify() {
   }
 }
 
-void cflowentry::flow_mod_delete() {
+void cflowentry::flow_mod_delete(rofl::crofdpt &dpt) const {
   try {
-    rofl::crofdpt &dpt = env->set_dpt(dptid);
-
-    rofl::openflow::cofflowmod fe(dpt.get_version());
-    rofl::cindex index(0);
-
-    fe.set_command(rofl::openflow::OFPFC_DELETE_STRICT);
-    fe.set_table_id(0);
-    fe.set_hard_timeout(entry_timeout);
-    fe.set_match().set_eth_src(src);
-    fe.set_match().set_eth_dst(dst);
-
-    dpt.send_flow_mod_message(rofl::cauxid(0), fe);
+    dpt.send_stamped_message(
+        rofl::cauxid(0),
+        flow_mod_stamp(dpt.get_version(), rofl::openflow::OFPFC_DELETE_STRICT));
 
   } catch (rofl::eRofConnNotConnected &e) {
     // control connection not connected
   } catch (rofl::eRofQueueFull &e) {
     // control channel congested
+  } catch (rofl::eRofConnInvalid &e) {
+    // datapath changed OpenFlow version
+  } catch (rofl::eBadVersion &e) {
+    // OpenFlow version not negotiated yet
   }
 }
@@ -10,12 +10,13 @@
 
 #include <inttypes.h>
 #include <ostream>
+#include <time.h>
 
 #include <rofl/common/caddress.h>
 #include <rofl/common/crofbase.h>
 #include <rofl/common/crofdpt.h>
 
-#include <rofl/common/cthread.hpp>
+#include "chashtable.h"
 
 namespace rofl {
 namespace examples {
@@ -57,34 +58,33 @@ public:
 
 }; // namespace exceptions
 
-class cflowentry; // forward declaration
-
 /**
  * @ingroup common_howto_ethswctld
- * @interface cflowentry_env
  *
- * @brief	Defines the environment expected by an instance of class
- * cflowentry.
+ * @brief	Identifies a flow by its source and destination hardware address
  */
-class cflowentry_env {
-  friend class cflowentry;
+struct cflowkey {
+  uint64_t src;
+  uint64_t dst;
 
-public:
-  /**
-   * @brief	cflowentry_env destructor
-   */
-  virtual ~cflowentry_env(){};
+  cflowkey() : src(0), dst(0){};
 
-public:
-  /**
-   * @brief	Called once the timer for this flow entry has expired.
-   */
-  virtual void flow_timer_expired(const cflowentry &entry) = 0;
+  cflowkey(uint64_t src, uint64_t dst) : src(src), dst(dst){};
 
-  /**
-   *
-   */
-  virtual rofl::crofdpt &set_dpt(const rofl::cdptid &dptid) = 0;
+  bool operator==(const cflowkey &key) const {
+    return (src == key.src) && (dst == key.dst);
+  };
+};
+
+/**
+ * @ingroup common_howto_ethswctld
+ *
+ * @brief	Hash functor for class cflowkey
+ */
+struct cflowhash {
+  size_t operator()(const cflowkey &key) const {
+    return cmachash()(key.src ^ (key.dst * 0x9e3779b97f4a7c15ULL));
+  };
 };
 
 /**
@@ -96,32 +96,37 @@ public:
  * datapath element. A flow entry is unidirectional and consists of
  * a source and a destination host identified by their respective
  * ethernet hardware addresses. The installed flow entry on the datapath
- * element forwards frames via the specified outgoing port. Class
- * cflowentry_env defines the environment expected by an instance
- * of class cflowentry. A flow entry is a soft-state entity and installs
- * a timer upon creation
+ * element forwards frames via the specified outgoing port. A flow entry
+ * is a soft-state entity expiring 60 seconds after its creation. Entries
+ * are plain values stored in place in the hash table of class cflowtable,
+ * which sends the Flow-Mod messages for adding and removing an entry and
+ * ages all entries on a single timer wheel.
  *
- * @see cflowentry_env
+ * @see cflowtable
  */
-class cflowentry : public rofl::cthread_env {
+class cflowentry {
+  friend class cflowtable;
+
 public:
+  /**
+   * @brief	cflowentry default constructor for empty table slots
+   */
+  cflowentry()
+      : src(0), dst(0), port_no(0), entry_timeout(CFLOWENTRY_DEFAULT_TIMEOUT),
+        expiry(0), scheduled(0){};
+
   /**
    * @brief	cflowentry constructor
    *
-   * @param env environment for this cflowentry instance
-   * @param dptid rofl-common's internal datapath handle
    * @param src ethernet hardware address used by source station
    * @param dst ethernet hardware address used by destination station
    * @param port_no OpenFlow port number of port pointing towards the station
    */
-  cflowentry(cflowentry_env *flowenv, const rofl::cdptid &dptid,
-             const rofl::caddress_ll &src, const rofl::caddress_ll &dst,
-             uint32_t port_no);
-
-  /**
-   * @brief	cflowentry destructor
-   */
-  virtual ~cflowentry();
+  cflowentry(const rofl::caddress_ll &src, const rofl::caddress_ll &dst,
+             uint32_t port_no)
+      : src(src.get_mac()), dst(dst.get_mac()), port_no(port_no),
+        entry_timeout(CFLOWENTRY_DEFAULT_TIMEOUT), expiry(0),
+        scheduled(0){};
 
 public:
   /**
@@ -137,43 +142,37 @@ public:
    */
   uint32_t get_out_port_no() const { return port_no; };
 
-  /**
-   * @brief	Update port number stored for this flow
-   *
-   * @param port_no new OpenFlow port number of port pointing towards
-   * destination
-   */
-  void set_out_port_no(uint32_t out_port_no);
-
   /**
    * @brief	Returns ethernet hardware address identifying the destination
    * host
    *
    * @return host ethernet hardware address of destination host
    */
-  const rofl::caddress_ll &get_dst() const { return dst; };
+  rofl::caddress_ll get_dst() const { return rofl::caddress_ll(dst); };
 
   /**
    * @brief	Returns ethernet hardware address identifying the source host
    *
    * @return host ethernet hardware address of source host
    */
-  const rofl::caddress_ll &get_src() const { return src; };
+  rofl::caddress_ll get_src() const { return rofl::caddress_ll(src); };
+
+  /**
+   * @brief	Returns point in time in seconds this entry expires at.
+   */
+  time_t get_expiry() const { return expiry; };
 
   /**@}*/
 
 private:
-  void flow_mod_add();
+  void flow_mod_add(rofl::crofdpt &dpt) const;
 
-  void flow_mod_delete();
+  void flow_mod_delete(rofl::crofdpt &dpt) const;
 
-  void flow_mod_modify();
+  void flow_mod_modify(rofl::crofdpt &dpt) const;
 
-private:
-  void handle_timeout(cthread &thread, uint32_t timer_id) override;
-  void handle_read_event(cthread &thread, int fd) override {}
-  void handle_write_event(cthread &thread, int fd) override {}
-  void handle_wakeup(cthread &thread) override {}
+  rofl::openflow::cofmsg_stamped *flow_mod_stamp(uint8_t version,
+                                                 uint16_t command) const;
 
 public:
   /**
@@ -183,25 +182,24 @@ public:
     os << "<cflowentry portno: " << (unsigned int)entry.port_no << " >"
        << std::endl;
 
-    os << entry.src;
-    os << entry.dst;
+    os << entry.get_src();
+    os << entry.get_dst();
     return os;
   };
 
 private:
   static const long CFLOWENTRY_DEFAULT_TIMEOUT = 60;
 
-  enum cflowentry_timer_t {
-    CFLOWENTRY_ENTRY_EXPIRED = 1,
-  };
-
-  cflowentry_env *env;
-  rofl::cdptid dptid;
+  uint64_t src;
+  uint64_t dst;
   uint32_t port_no;
-  rofl::caddress_ll src;
-  rofl::caddress_ll dst;
   int entry_timeout;
-  rofl::cthread thread;
+
+  // entry expires at this point in time
+  time_t expiry;
+
+  // expiry of the pending timer wheel event for this entry
+  time_t scheduled;
 };
 
 }; // namespace ethswctld
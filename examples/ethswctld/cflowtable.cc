@@ -14,3 +14,4 @@
 using namespace rofl::examples::ethswctld;
 
 std::map<rofl::cdptid, cflowtable *> cflowtable::flowtables;
+rofl::crwlock cflowtable::flowtables_rwlock;
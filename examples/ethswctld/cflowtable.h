@@ -21,7 +21,10 @@
 #include <rofl/common/crofbase.h>
 #include <rofl/common/crofdpt.h>
 
+#include "cfibtable.h"
 #include "cflowentry.h"
+#include "chashtable.h"
+#include "ctimerwheel.h"
 
 namespace rofl {
 namespace examples {
@@ -66,10 +69,15 @@ public:
  * 2. Methods on CRUD operations for instances of class cflowentry in a
  * cflowtable instance
  *
+ * Entries are stored in an open-addressing hash table keyed by source and
+ * destination hardware address and expire via a single timer wheel per
+ * table, which is advanced by method age(). References to entries returned
+ * by this class are invalidated by adding or removing entries, including
+ * expiry.
+ *
  * @see cflowentry
- * @see cflowentry_env
  */
-class cflowtable : public cflowentry_env {
+class cflowtable {
 public:
   /**
    * @name	Methods for managing Active Flow Tables
@@ -88,6 +96,7 @@ public:
    */
   static cflowtable &add_flowtable(cflowtable_env *env,
                                    const rofl::cdptid &dptid) {
+    AcquireReadWriteLock rwlock(cflowtable::flowtables_rwlock);
     if (cflowtable::flowtables.find(dptid) != cflowtable::flowtables.end()) {
       delete cflowtable::flowtables[dptid];
       cflowtable::flowtables.erase(dptid);
@@ -109,6 +118,7 @@ public:
    */
   static cflowtable &set_flowtable(cflowtable_env *env,
                                    const rofl::cdptid &dptid) {
+    AcquireReadWriteLock rwlock(cflowtable::flowtables_rwlock);
     if (cflowtable::flowtables.find(dptid) == cflowtable::flowtables.end()) {
       new cflowtable(env, dptid);
     }
@@ -128,6 +138,7 @@ public:
    * @exception eFibNotFound
    */
   static const cflowtable &get_flowtable(const rofl::cdptid &dptid) {
+    AcquireReadLock rlock(cflowtable::flowtables_rwlock);
     if (cflowtable::flowtables.find(dptid) == cflowtable::flowtables.end()) {
       throw exceptions::eFlowNotFound(
           "cflowtable::get_flowtable() dptid not found");
@@ -141,6 +152,7 @@ public:
    * @param dptid rofl-common's internal handle for datapath element
    */
   static void drop_flowtable(const rofl::cdptid &dptid) {
+    AcquireReadWriteLock rwlock(cflowtable::flowtables_rwlock);
     if (cflowtable::flowtables.find(dptid) == cflowtable::flowtables.end()) {
       return;
     }
@@ -154,10 +166,24 @@ public:
    * @param dptid rofl-common's internal handle for datapath element
    */
   static bool has_flowtable(const rofl::cdptid &dptid) {
+    AcquireReadLock rlock(cflowtable::flowtables_rwlock);
     return (not(cflowtable::flowtables.find(dptid) ==
                 cflowtable::flowtables.end()));
   };
 
+  /**
+   * @brief	Removes expired entries from all cflowtable instances.
+   *
+   * To be called periodically, once per second.
+   */
+  static void age_flowtables() {
+    AcquireReadLock rlock(cflowtable::flowtables_rwlock);
+    time_t now = cfibtable::now();
+    for (auto it : cflowtable::flowtables) {
+      it.second->age(now);
+    }
+  };
+
   /**@}*/
 
 public:
@@ -171,17 +197,12 @@ public:
    * @brief	Deletes all entries stored in this cflowtable instance.
    */
   void clear() {
-    for (std::map<rofl::caddress_ll,
-                  std::map<rofl::caddress_ll, cflowentry *>>::iterator it =
-             ftable.begin();
-         it != ftable.end(); ++it) {
-      for (std::map<rofl::caddress_ll, cflowentry *>::iterator jt =
-               it->second.begin();
-           jt != it->second.end(); ++jt) {
-        delete jt->second;
-      }
-    }
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    ftable.for_each([&](const cflowkey &key, const cflowentry &entry) {
+      flow_mod_delete(entry);
+    });
     ftable.clear();
+    timers.clear();
   };
 
   /**
@@ -204,11 +225,9 @@ public:
       throw exceptions::eFlowInval(
           "cflowtable::add_flow_entry() invalid address");
     }
-    if (ftable[src].find(dst) != ftable[src].end()) {
-      drop_flow_entry(src, dst);
-    }
-    ftable[src][dst] = new cflowentry(this, dptid, src, dst, portno);
-    return *(ftable[src][dst]);
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    erase(cflowkey(src.get_mac(), dst.get_mac()));
+    return insert(src, dst, portno);
   };
 
   /**
@@ -230,10 +249,12 @@ public:
       throw exceptions::eFlowInval(
           "cflowtable::set_flow_entry() invalid address");
     }
-    if (ftable[src].find(dst) == ftable[src].end()) {
-      ftable[src][dst] = new cflowentry(this, dptid, src, dst, portno);
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    cflowentry *entry = ftable.find(cflowkey(src.get_mac(), dst.get_mac()));
+    if (nullptr != entry) {
+      return *entry;
     }
-    return *(ftable[src][dst]);
+    return insert(src, dst, portno);
   };
 
   /**
@@ -255,11 +276,13 @@ public:
       throw exceptions::eFlowInval(
           "cflowtable::set_flow_entry() invalid address");
     }
-    if (ftable[src].find(dst) == ftable[src].end()) {
+    AcquireReadLock rlock(ftable_rwlock);
+    cflowentry *entry = ftable.find(cflowkey(src.get_mac(), dst.get_mac()));
+    if (nullptr == entry) {
       throw exceptions::eFlowNotFound(
           "cflowtable::set_flow_entry() destination address not found");
     }
-    return *(ftable[src][dst]);
+    return *entry;
   };
 
   /**
@@ -282,11 +305,40 @@ public:
       throw exceptions::eFlowInval(
           "cflowtable::get_flow_entry() invalid address");
     }
-    if (ftable.at(src).find(dst) == ftable.at(src).end()) {
+    AcquireReadLock rlock(ftable_rwlock);
+    const cflowentry *entry =
+        ftable.find(cflowkey(src.get_mac(), dst.get_mac()));
+    if (nullptr == entry) {
       throw exceptions::eFlowNotFound(
           "cflowtable::get_flow_entry() destination address not found");
     }
-    return *(ftable.at(src).at(dst));
+    return *entry;
+  };
+
+  /**
+   * @brief	Updates outgoing port of an existing flow entry
+   *
+   * Sends a Flow-Mod modifying the entry on the datapath element if the
+   * port has changed and restarts the entry's expiry timer.
+   *
+   * @param src ethernet hardware address for source station of flow
+   * @param dst ethernet hardware address for destination station of flow
+   * @param portno outgoing port for this flow
+   * @exception eFlowNotFound flow destination address not found
+   */
+  void set_out_port_no(const rofl::caddress_ll &src,
+                       const rofl::caddress_ll &dst, uint32_t portno) {
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    cflowentry *entry = ftable.find(cflowkey(src.get_mac(), dst.get_mac()));
+    if (nullptr == entry) {
+      throw exceptions::eFlowNotFound(
+          "cflowtable::set_out_port_no() destination address not found");
+    }
+    if (entry->port_no != portno) {
+      entry->port_no = portno;
+      entry->flow_mod_modify(env->set_dpt(dptid));
+    }
+    entry->expiry = cfibtable::now() + entry->entry_timeout;
   };
 
   /**
@@ -298,12 +350,8 @@ public:
    */
   void drop_flow_entry(const rofl::caddress_ll &src,
                        const rofl::caddress_ll &dst) {
-    if (ftable[src].find(dst) == ftable[src].end()) {
-      return;
-    }
-    cflowentry *flowentry = ftable[src][dst];
-    ftable[src].erase(dst);
-    delete flowentry;
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    erase(cflowkey(src.get_mac(), dst.get_mac()));
   };
 
   /**
@@ -315,7 +363,56 @@ public:
    */
   bool has_flow_entry(const rofl::caddress_ll &src,
                       const rofl::caddress_ll &dst) const {
-    return (not(ftable.at(src).find(dst) == ftable.at(src).end()));
+    AcquireReadLock rlock(ftable_rwlock);
+    return (nullptr != ftable.find(cflowkey(src.get_mac(), dst.get_mac())));
+  };
+
+  /**@}*/
+
+public:
+  /**
+   * @name	Methods for aging
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Removes all entries expired until now.
+   *
+   * @param now current time in seconds as returned by cfibtable::now()
+   */
+  void age(time_t now) {
+    AcquireReadWriteLock rwlock(ftable_rwlock);
+    timers.advance(now, [&](const cflowkey &key, time_t expiry) {
+      cflowentry *entry = ftable.find(key);
+      if ((nullptr == entry) || (entry->scheduled != expiry)) {
+        /* entry was removed or replaced meanwhile */
+        return;
+      }
+      if (entry->expiry > now) {
+        /* entry was refreshed meanwhile */
+        entry->scheduled = entry->expiry;
+        timers.schedule(key, entry->scheduled);
+        return;
+      }
+      erase(key);
+    });
+  };
+
+  /**
+   * @brief	Returns number of entries.
+   */
+  size_t size() const {
+    AcquireReadLock rlock(ftable_rwlock);
+    return ftable.size();
+  };
+
+  /**
+   * @brief	Returns bytes allocated for entries and timers.
+   */
+  size_t memory() const {
+    AcquireReadLock rlock(ftable_rwlock);
+    return ftable.memory() + timers.memory();
   };
 
   /**@}*/
@@ -325,7 +422,7 @@ private:
    * @brief	cflowtable constructor for given datapath handle
    */
   cflowtable(cflowtable_env *env, const rofl::cdptid &dptid)
-      : env(env), dptid(dptid) {
+      : env(env), dptid(dptid), timers(cfibtable::now()) {
     cflowtable::flowtables[dptid] = this;
   };
 
@@ -339,17 +436,44 @@ private:
 
 private:
   /**
-   * @brief	Called once the timer for a flow entry has expired.
+   * @brief	Stores a new entry, installs it on the datapath element and
+   * schedules its expiry, called with ftable_rwlock held.
+   */
+  cflowentry &insert(const rofl::caddress_ll &src, const rofl::caddress_ll &dst,
+                     uint32_t portno) {
+    cflowentry entry(src, dst, portno);
+    entry.expiry = entry.scheduled = cfibtable::now() + entry.entry_timeout;
+    cflowkey key(entry.src, entry.dst);
+    timers.schedule(key, entry.scheduled);
+    cflowentry &stored = *(ftable.insert(key, std::move(entry)).first);
+    stored.flow_mod_add(env->set_dpt(dptid));
+    return stored;
+  };
+
+  /**
+   * @brief	Removes an entry from the datapath element and this table,
+   * called with ftable_rwlock held.
    */
-  virtual void flow_timer_expired(const cflowentry &entry) {
-    drop_flow_entry(entry.get_src(), entry.get_dst());
+  void erase(const cflowkey &key) {
+    cflowentry *entry = ftable.find(key);
+    if (nullptr == entry) {
+      return;
+    }
+    flow_mod_delete(*entry);
+    ftable.erase(key);
   };
 
   /**
    *
    */
-  virtual rofl::crofdpt &set_dpt(const rofl::cdptid &dptid) {
-    return env->set_dpt(dptid);
+  void flow_mod_delete(const cflowentry &entry) {
+    try {
+      entry.flow_mod_delete(env->set_dpt(dptid));
+    } catch (rofl::eRofDptNotFound &e) {
+      // datapath already detached
+    } catch (rofl::eRofBaseNotConnected &e) {
+      // datapath already detached
+    }
   };
 
 public:
@@ -360,30 +484,32 @@ public:
                                   cflowtable const &flowtable) {
     try {
       os << "<cflowtable dpid:"
-         << flowtable.env->set_dpt(flowtable.dptid).get_dpid() << " >"
-         << std::endl;
+         << flowtable.env->set_dpt(flowtable.dptid).get_dpid()
+         << " entries: " << flowtable.size()
+         << " memory: " << flowtable.memory() << " >" << std::endl;
     } catch (rofl::eRofDptNotFound &e) {
       os << "<cflowtable dptid:" << flowtable.dptid << " >" << std::endl;
     }
 
-    for (std::map<rofl::caddress_ll,
-                  std::map<rofl::caddress_ll, cflowentry *>>::const_iterator
-             it = flowtable.ftable.begin();
-         it != flowtable.ftable.end(); ++it) {
-      for (std::map<rofl::caddress_ll, cflowentry *>::const_iterator jt =
-               it->second.begin();
-           jt != it->second.end(); ++jt) {
-        os << *(jt->second);
-      }
-    }
+    AcquireReadLock rlock(flowtable.ftable_rwlock);
+    flowtable.ftable.for_each(
+        [&](const cflowkey &key, const cflowentry &entry) { os << entry; });
     return os;
   };
 
 private:
   cflowtable_env *env;
   rofl::cdptid dptid;
-  std::map<rofl::caddress_ll, std::map<rofl::caddress_ll, cflowentry *>> ftable;
+
+  // entries keyed by source and destination hardware address
+  chashtable<cflowkey, cflowentry, cflowhash> ftable;
+  mutable crwlock ftable_rwlock;
+
+  // expiry events for all entries
+  ctimerwheel<cflowkey> timers;
+
   static std::map<rofl::cdptid, cflowtable *> flowtables;
+  static crwlock flowtables_rwlock;
 };
 
 }; // namespace ethswctld
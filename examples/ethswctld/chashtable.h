@@ -0,0 +1,203 @@
+/*
+ * chashtable.h
+ *
+ *  Created on: 18.10.2026
+ */
+
+#ifndef CHASHTABLE_H_
+#define CHASHTABLE_H_ 1
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+namespace rofl {
+namespace examples {
+namespace ethswctld {
+
+/**
+ * @ingroup common_howto_ethswctld
+ *
+ * @brief	Hash functor for 48-bit ethernet hardware addresses
+ *
+ * Mixes all address bits into the lower bits used for indexing a
+ * chashtable, as consecutive host addresses differ in their lower bytes
+ * only.
+ */
+struct cmachash {
+  size_t operator()(uint64_t mac) const {
+    mac ^= mac >> 33;
+    mac *= 0xff51afd7ed558ccdULL;
+    mac ^= mac >> 33;
+    return (size_t)mac;
+  };
+};
+
+/**
+ * @ingroup common_howto_ethswctld
+ *
+ * @brief	Open-addressing hash table with linear probing
+ *
+ * Values are stored in place in a single array of slots, so a lookup
+ * touches a few adjacent slots instead of following tree nodes. Removal
+ * shifts subsequent slots of a probe sequence backwards, no tombstones
+ * are left behind. The table doubles its capacity at a load factor of
+ * 70%. Insertion and removal move values, so pointers and references
+ * to values are invalidated by both. Values must be default
+ * constructible and movable.
+ */
+template <typename K, typename V, typename H> class chashtable {
+public:
+  /**
+   * @brief	chashtable constructor
+   *
+   * @param capacity initial number of slots, rounded up to a power of two
+   */
+  chashtable(size_t capacity = 16) : count(0) {
+    size_t n = 8;
+    while (n < capacity)
+      n <<= 1;
+    slots.resize(n);
+    mask = n - 1;
+  };
+
+  /**
+   * @brief	Returns number of stored values
+   */
+  size_t size() const { return count; };
+
+  /**
+   * @brief	Returns number of slots
+   */
+  size_t capacity() const { return slots.size(); };
+
+  /**
+   * @brief	Returns bytes allocated for slots
+   */
+  size_t memory() const { return slots.capacity() * sizeof(cslot); };
+
+  /**
+   * @brief	Returns pointer to value stored for key or NULL
+   */
+  V *find(const K &key) {
+    size_t i = H()(key) & mask;
+    while (slots[i].used) {
+      if (slots[i].key == key)
+        return &slots[i].value;
+      i = (i + 1) & mask;
+    }
+    return nullptr;
+  };
+
+  /**
+   * @brief	Returns pointer to value stored for key or NULL
+   */
+  const V *find(const K &key) const {
+    return const_cast<chashtable *>(this)->find(key);
+  };
+
+  /**
+   * @brief	Stores value for key unless key exists already
+   *
+   * @return pointer to stored value and true if value was inserted
+   */
+  std::pair<V *, bool> insert(const K &key, V &&value) {
+    if (V *v = find(key))
+      return std::make_pair(v, false);
+    if ((count + 1) * 10 > slots.size() * 7)
+      grow();
+    size_t i = H()(key) & mask;
+    while (slots[i].used)
+      i = (i + 1) & mask;
+    slots[i].key = key;
+    slots[i].value = std::move(value);
+    slots[i].used = true;
+    count++;
+    return std::make_pair(&slots[i].value, true);
+  };
+
+  /**
+   * @brief	Removes value stored for key
+   *
+   * @return true if a value was removed
+   */
+  bool erase(const K &key) {
+    size_t i = H()(key) & mask;
+    while (slots[i].used && not(slots[i].key == key))
+      i = (i + 1) & mask;
+    if (not slots[i].used)
+      return false;
+
+    /* close the gap for slots whose probe sequence passes it */
+    size_t j = i;
+    while (true) {
+      j = (j + 1) & mask;
+      if (not slots[j].used)
+        break;
+      size_t k = H()(slots[j].key) & mask;
+      if ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)))
+        continue;
+      slots[i].key = slots[j].key;
+      slots[i].value = std::move(slots[j].value);
+      i = j;
+    }
+    slots[i].value = V();
+    slots[i].used = false;
+    count--;
+    return true;
+  };
+
+  /**
+   * @brief	Removes all values and releases slots beyond initial capacity
+   */
+  void clear() {
+    std::vector<cslot>(8).swap(slots);
+    mask = slots.size() - 1;
+    count = 0;
+  };
+
+  /**
+   * @brief	Calls f(key, value) for all stored values
+   */
+  template <typename F> void for_each(F f) const {
+    for (auto &slot : slots) {
+      if (slot.used)
+        f(slot.key, slot.value);
+    }
+  };
+
+private:
+  struct cslot {
+    K key;
+    V value;
+    bool used;
+    cslot() : key(), value(), used(false){};
+  };
+
+  void grow() {
+    std::vector<cslot> prev(slots.size() * 2);
+    prev.swap(slots);
+    mask = slots.size() - 1;
+    for (auto &slot : prev) {
+      if (not slot.used)
+        continue;
+      size_t i = H()(slot.key) & mask;
+      while (slots[i].used)
+        i = (i + 1) & mask;
+      slots[i].key = slot.key;
+      slots[i].value = std::move(slot.value);
+      slots[i].used = true;
+    }
+  };
+
+  std::vector<cslot> slots;
+  size_t mask;
+  size_t count;
+};
+
+}; // namespace ethswctld
+}; // namespace examples
+}; // namespace rofl
+
+#endif /* CHASHTABLE_H_ */
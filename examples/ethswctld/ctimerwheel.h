@@ -0,0 +1,119 @@
+/*
+ * ctimerwheel.h
+ *
+ *  Created on: 18.10.2026
+ */
+
+#ifndef CTIMERWHEEL_H_
+#define CTIMERWHEEL_H_ 1
+
+#include <time.h>
+#include <vector>
+
+namespace rofl {
+namespace examples {
+namespace ethswctld {
+
+/**
+ * @ingroup common_howto_ethswctld
+ *
+ * @brief	Hashed timer wheel with a resolution of one second
+ *
+ * Stores (key, expiry) events in num_slots buckets indexed by expiry
+ * modulo num_slots. advance() visits the buckets of all seconds elapsed
+ * since its last call and hands out due events, events for a later
+ * round of the wheel stay in their bucket. Scheduling costs one append,
+ * each tick touches the events of a single bucket only.
+ *
+ * Events are never cancelled: owners of an event store the expiry it
+ * was scheduled for and ignore events whose expiry does not match, e.g.
+ * after a refresh or removal of the entry.
+ */
+template <typename K> class ctimerwheel {
+public:
+  /**
+   * @brief	ctimerwheel constructor
+   *
+   * @param now current time in seconds
+   * @param num_slots number of buckets, should exceed common timeouts
+   */
+  ctimerwheel(time_t now, unsigned int num_slots = 64)
+      : slots(num_slots), last(now), count(0){};
+
+  /**
+   * @brief	Returns number of scheduled events
+   */
+  size_t size() const { return count; };
+
+  /**
+   * @brief	Returns bytes allocated for buckets and events
+   */
+  size_t memory() const {
+    size_t bytes = slots.capacity() * sizeof(std::vector<cevent>);
+    for (auto &slot : slots)
+      bytes += slot.capacity() * sizeof(cevent);
+    return bytes;
+  };
+
+  /**
+   * @brief	Schedules an event for key, expiry must be in the future
+   */
+  void schedule(const K &key, time_t expiry) {
+    slots[expiry % slots.size()].push_back(cevent(key, expiry));
+    count++;
+  };
+
+  /**
+   * @brief	Calls f(key, expiry) for all events due until now
+   *
+   * f may schedule new events.
+   */
+  template <typename F> void advance(time_t now, F f) {
+    if (now <= last)
+      return;
+    time_t first = last + 1;
+    if ((now - last) > (time_t)slots.size())
+      first = now - slots.size() + 1;
+    last = now;
+
+    for (time_t t = first; t <= now; t++) {
+      std::vector<cevent> bucket;
+      bucket.swap(slots[t % slots.size()]);
+      std::vector<cevent> &pending = slots[t % slots.size()];
+      for (auto &event : bucket) {
+        if (event.expiry <= now) {
+          count--;
+          f(event.key, event.expiry);
+        } else {
+          pending.push_back(event);
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief	Drops all events
+   */
+  void clear() {
+    for (auto &slot : slots)
+      std::vector<cevent>().swap(slot);
+    count = 0;
+  };
+
+private:
+  struct cevent {
+    K key;
+    time_t expiry;
+    cevent(const K &key, time_t expiry) : key(key), expiry(expiry){};
+  };
+
+  std::vector<std::vector<cevent>> slots;
+  time_t last;
+  size_t count;
+};
+
+}; // namespace ethswctld
+}; // namespace examples
+}; // namespace rofl
+
+#endif /* CTIMERWHEEL_H_ */
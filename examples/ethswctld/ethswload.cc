@@ -0,0 +1,5 @@
+#include "cethswload.h"
+
+int main(int argc, char **argv) {
+  return rofl::examples::ethswctld::cethswload::run(argc, argv);
+}
@@ -0,0 +1,123 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cenvs.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "cenvs.hpp"
+
+#include <new>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/membarrier.h>
+#endif
+
+using namespace rofl;
+
+/*static*/ std::atomic<chazard::crecord *> chazard::records(nullptr);
+/*static*/ std::atomic_bool
+    chazard::asymmetric(chazard::register_asymmetric());
+
+chazard::clocal::~clocal() {
+  if (record == nullptr)
+    return;
+  for (unsigned int i = 0; i < MAX_SLOTS; i++) {
+    record->slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+  record->depth = 0;
+  record->in_use.store(false, std::memory_order_release);
+  record = nullptr;
+}
+
+chazard::crecord &chazard::get_record() {
+  static thread_local clocal local = {nullptr};
+  if (local.record != nullptr)
+    return *local.record;
+
+  /* recycle a record released by a terminated thread */
+  for (crecord *rec = records.load(std::memory_order_acquire); rec != nullptr;
+       rec = rec->next) {
+    bool in_use = false;
+    if ((not rec->in_use.load(std::memory_order_relaxed)) &&
+        rec->in_use.compare_exchange_strong(in_use, true)) {
+      return *(local.record = rec);
+    }
+  }
+
+  /* records sit on cache lines of their own */
+  void *mem = nullptr;
+  if (posix_memalign(&mem, alignof(crecord), sizeof(crecord)) != 0) {
+    throw eOutOfMem("chazard::get_record() out of memory", __FILE__,
+                    __FUNCTION__, __LINE__);
+  }
+  crecord *rec = new (mem) crecord();
+  for (unsigned int i = 0; i < MAX_SLOTS; i++) {
+    rec->slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+  rec->depth = 0;
+  rec->in_use.store(true, std::memory_order_relaxed);
+  rec->next = records.load(std::memory_order_relaxed);
+  while (not records.compare_exchange_weak(rec->next, rec)) {
+  }
+  return *(local.record = rec);
+}
+
+void chazard::guard::acquire() {
+  crecord &rec = get_record();
+  if (rec.depth >= MAX_SLOTS) {
+    throw eHazardSlotsExhausted("chazard::guard::acquire() no free slot",
+                                __FILE__, __FUNCTION__, __LINE__);
+  }
+  record = &rec;
+  slot = &rec.slots[rec.depth++];
+}
+
+bool chazard::register_asymmetric() {
+#if defined(__linux__) && defined(__NR_membarrier)
+  long cmds = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0);
+  if ((cmds < 0) || (not(cmds & MEMBARRIER_CMD_PRIVATE_EXPEDITED)))
+    return false;
+  return (syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED,
+                  0) == 0);
+#else
+  return false;
+#endif
+}
+
+void chazard::heavy_barrier() {
+#if defined(__linux__) && defined(__NR_membarrier)
+  if (asymmetric.load(std::memory_order_relaxed) &&
+      (syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0) == 0))
+    return;
+#endif
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+bool chazard::is_protected(const void *ptr) {
+  heavy_barrier();
+  crecord *own = &get_record();
+  for (crecord *rec = records.load(std::memory_order_acquire); rec != nullptr;
+       rec = rec->next) {
+    if (rec == own)
+      continue;
+    for (unsigned int i = 0; i < MAX_SLOTS; i++) {
+      if (rec->slots[i].load(std::memory_order_seq_cst) == ptr)
+        return true;
+    }
+  }
+  return false;
+}
+
+void chazard::wait_unprotected(const void *ptr) {
+  while (is_protected(ptr)) {
+    sched_yield();
+  }
+}
@@ -0,0 +1,290 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cenvs.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CENVS_HPP_
+#define SRC_ROFL_COMMON_CENVS_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <inttypes.h>
+#include <vector>
+
+#include "rofl/common/exception.hpp"
+#include "rofl/common/locking.hpp"
+
+namespace rofl {
+
+class eHazardSlotsExhausted : public exception {
+public:
+  eHazardSlotsExhausted(const std::string &__arg = std::string(""),
+                        const std::string &__file = std::string(""),
+                        const std::string &__func = std::string(""),
+                        int __line = 0)
+      : exception(__arg, __file, __func, __line) {
+    set_exception("eHazardSlotsExhausted");
+  };
+};
+
+/**
+ * @brief	Hazard pointers announcing objects in use by a thread
+ *
+ * Every thread owns a small array of slots on a cache line of its own.
+ * Publishing a pointer in a slot only writes thread local memory, so
+ * readers on different cores never contend. A thread retiring an object
+ * scans the slots of all other threads and waits until no slot refers
+ * to it anymore.
+ *
+ * Where the kernel supports membarrier(2), the store-load barrier
+ * required between publishing a hazard and validating it is moved to
+ * the rare retiring side and readers only need a compiler barrier.
+ */
+class chazard {
+  struct crecord;
+
+public:
+  // maximum number of pointers protected by a thread at the same time
+  static const unsigned int MAX_SLOTS = 30;
+
+  /**
+   * @brief	Protects a pointer for the lifetime of this guard
+   *
+   * Guards nest, they must be released in reverse order of acquisition
+   * on the thread that created them.
+   */
+  class guard {
+  public:
+    /**
+     *
+     */
+    ~guard() { release(); };
+
+    /**
+     *
+     */
+    guard() : record(nullptr), slot(nullptr){};
+
+    /**
+     *
+     */
+    guard(guard &&g) : record(g.record), slot(g.slot) {
+      g.record = nullptr;
+      g.slot = nullptr;
+    };
+
+    /**
+     * @brief	Publishes ptr without any memory barrier
+     *
+     * Call chazard::barrier() before validating ptr.
+     */
+    void protect(const void *ptr) {
+      if (slot == nullptr)
+        acquire();
+      slot->store(ptr, std::memory_order_relaxed);
+    };
+
+    /**
+     * @brief	Clears the slot, no-op if nothing is protected
+     */
+    void release();
+
+  private:
+    guard(const guard &g);
+    guard &operator=(const guard &g);
+
+    void acquire();
+
+    crecord *record;
+    std::atomic<const void *> *slot;
+  };
+
+  /**
+   * @brief	Orders hazards published before against loads after
+   */
+  static void barrier() {
+    if (asymmetric.load(std::memory_order_relaxed)) {
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+    } else {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  };
+
+  /**
+   * @brief	Returns true when any thread except the caller protects ptr
+   */
+  static bool is_protected(const void *ptr);
+
+  /**
+   * @brief	Blocks until no thread except the caller protects ptr
+   */
+  static void wait_unprotected(const void *ptr);
+
+private:
+  struct alignas(64) crecord {
+    std::atomic<const void *> slots[MAX_SLOTS];
+    unsigned int depth;
+    std::atomic_bool in_use;
+    crecord *next;
+  };
+
+  struct clocal {
+    crecord *record;
+    ~clocal();
+  };
+
+  static crecord &get_record();
+
+  static bool register_asymmetric();
+
+  static void heavy_barrier();
+
+  // list of all thread records, records are never freed but recycled
+  static std::atomic<crecord *> records;
+
+  // membarrier(2) is available, see barrier()
+  static std::atomic_bool asymmetric;
+};
+
+inline void chazard::guard::release() {
+  if (slot == nullptr)
+    return;
+  slot->store(nullptr, std::memory_order_release);
+  record->depth--;
+  record = nullptr;
+  slot = nullptr;
+}
+
+/**
+ * @brief	Registry of live environment instances
+ *
+ * Replaces a std::set guarded by a process wide crwlock. The set of
+ * registered instances is kept as an immutable sorted snapshot, which
+ * is replaced on registration and deregistration only. Lookups take a
+ * hazard pointer on the snapshot, so an upcall does not write any
+ * shared memory.
+ *
+ * protect() additionally publishes a hazard pointer on the instance
+ * itself, which keeps it alive for the lifetime of the caller's guard.
+ * drop() waits for all guards on other threads to be released, so a
+ * class implementing an environment must call it first thing in its
+ * destructor, before any of its members are destroyed. The destructor
+ * must not hold locks acquired by upcalls into the instance.
+ */
+template <class T> class cenvs {
+  typedef std::vector<const T *> snapshot_t;
+
+public:
+  /**
+   *
+   */
+  ~cenvs() { delete snapshot.load(); };
+
+  /**
+   *
+   */
+  cenvs() : snapshot(new snapshot_t()){};
+
+public:
+  /**
+   * @brief	Registers env
+   *
+   * @result number of registered instances including env
+   */
+  size_t add(const T *env) {
+    AcquireReadWriteLock lock(rwlock);
+    snapshot_t *next = new snapshot_t(*snapshot.load());
+    next->insert(std::lower_bound(next->begin(), next->end(), env), env);
+    replace(next);
+    return next->size();
+  };
+
+  /**
+   * @brief	Deregisters env and waits for guards protecting it
+   *
+   * Guards held by the calling thread are ignored, so env may be
+   * dropped from within an upcall into env. Calling drop() for an
+   * instance not registered (anymore) is a no-op.
+   *
+   * @result number of instances remaining registered
+   */
+  size_t drop(const T *env) {
+    size_t remaining = 0;
+    {
+      AcquireReadWriteLock lock(rwlock);
+      const snapshot_t *current = snapshot.load();
+      if (not std::binary_search(current->begin(), current->end(), env))
+        return current->size();
+      snapshot_t *next = new snapshot_t(*current);
+      next->erase(std::remove(next->begin(), next->end(), env), next->end());
+      replace(next);
+      remaining = next->size();
+    }
+    chazard::wait_unprotected(env);
+    return remaining;
+  };
+
+  /**
+   * @brief	Returns true if env is registered
+   */
+  bool contains(const T *env) const {
+    chazard::guard guard;
+    const snapshot_t *current = snapshot.load(std::memory_order_acquire);
+    while (true) {
+      guard.protect(current);
+      chazard::barrier();
+      const snapshot_t *next = snapshot.load(std::memory_order_acquire);
+      if (next == current)
+        break;
+      current = next;
+    }
+    return std::binary_search(current->begin(), current->end(), env);
+  };
+
+  /**
+   * @brief	Protects env by guard, if env is registered
+   *
+   * While guard protects env, drop() called on any other thread blocks.
+   *
+   * @result true if env is registered, false otherwise
+   */
+  bool protect(const T *env, chazard::guard &guard) const {
+    guard.protect(env);
+    chazard::barrier();
+    if (contains(env))
+      return true;
+    guard.release();
+    return false;
+  };
+
+  /**
+   *
+   */
+  size_t size() const {
+    AcquireReadLock lock(rwlock);
+    return snapshot.load()->size();
+  };
+
+private:
+  // publishes next and frees previous snapshot, called with rwlock held
+  void replace(snapshot_t *next) {
+    snapshot_t *prev = snapshot.exchange(next);
+    chazard::wait_unprotected(prev);
+    delete prev;
+  };
+
+  // serializes writers
+  mutable crwlock rwlock;
+
+  // sorted instances, readers access it without lock
+  std::atomic<snapshot_t *> snapshot;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CENVS_HPP_ */
@@ -182,21 +182,13 @@ uint8_t *cmemory::resize(size_t len) {
   if (0 == len) {
     mfree();
   } else if (len <= data.second) {
-    if ((data.first = (uint8_t *)realloc(data.first, len)) == 0) {
-      throw eSysCall("realloc syscall failed")
-          .set_func(__FUNCTION__)
-          .set_line(__LINE__);
-    }
+    data.first = (uint8_t *)cslab::reallocate(data.first, data.second, len);
     // memset(data.first + len, 0x00, data.second);
 
     // adjust data
     data.second = len;
   } else {
-    if ((data.first = (uint8_t *)realloc(data.first, len)) == 0) {
-      throw eSysCall("realloc syscall failed")
-          .set_func(__FUNCTION__)
-          .set_line(__LINE__);
-    }
+    data.first = (uint8_t *)cslab::reallocate(data.first, data.second, len);
     memset(data.first + data.second, 0x00, len - data.second);
 
     // adjust data
@@ -229,11 +221,7 @@ void cmemory::mallocate(size_t len) {
   }
   data.second = len;
 
-  if ((data.first = (uint8_t *)calloc(1, data.second)) == 0) {
-    throw eSysCall("calloc syscall failed")
-        .set_func(__FUNCTION__)
-        .set_line(__LINE__);
-  }
+  data.first = (uint8_t *)cslab::allocate(data.second);
 
   memset(data.first, 0, data.second);
 }
@@ -241,7 +229,7 @@ void cmemory::mallocate(size_t len) {
 void cmemory::mfree() {
   if (data.first) {
     memset(data.first, 0, data.second);
-    free(data.first);
+    cslab::deallocate(data.first, data.second);
   }
   data = std::make_pair<uint8_t *, size_t>(NULL, 0);
 }
@@ -271,17 +259,13 @@ uint8_t *cmemory::insert(unsigned int offset, size_t len) {
   uint8_t *p_ptr = (uint8_t *)0;
   size_t p_len = data.second + len;
 
-  if ((p_ptr = (uint8_t *)calloc(1, p_len)) == 0) {
-    throw eSysCall("calloc syscall failed")
-        .set_func(__FUNCTION__)
-        .set_line(__LINE__);
-  }
+  p_ptr = (uint8_t *)cslab::allocate(p_len);
 
   memcpy(p_ptr, data.first, offset);
   memset(p_ptr + offset, 0x00, len);
   memcpy(p_ptr + offset + len, data.first + offset, data.second - offset);
 
-  free(data.first);
+  cslab::deallocate(data.first, data.second);
 
   data.first = p_ptr;
   data.second = p_len;
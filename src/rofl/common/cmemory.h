@@ -14,6 +14,7 @@
 #include <sstream>
 #include <string>
 
+#include "rofl/common/cslab.hpp"
 #include "rofl/common/exception.hpp"
 
 namespace rofl {
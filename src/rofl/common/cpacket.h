@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cslice.hpp"
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/openflow.h"
 
@@ -46,7 +47,13 @@ public:
 };
 
 /**
+ * @brief	Packet buffer with head and tail space for tag operations
  *
+ * A cpacket either owns its frame or shares it read-mostly with other
+ * instances via a cslice, e.g. pointing into a crofsock receive buffer.
+ * Copies of a shared cpacket share the same frame. Operations changing
+ * the frame's length (tags, push/pop, resize, append) or obtaining a
+ * reference via operator[] copy the frame into private memory first.
  */
 class cpacket : public rofl::cmemory {
 public:
@@ -80,6 +87,14 @@ public:
       memcpy(somem() + head, buf, buflen);
   };
 
+  /**
+   * @brief	Creates a cpacket sharing the frame referred to by slice
+   */
+  cpacket(const cslice &slice, size_t head = DEFAULT_HSPACE,
+          size_t tail = DEFAULT_TSPACE)
+      : rofl::cmemory(0), head(head), tail(tail), initial_head(head),
+        initial_tail(tail), slice(slice){};
+
   /**
    *
    */
@@ -91,7 +106,12 @@ public:
   cpacket &operator=(const cpacket &pack) {
     if (this == &pack)
       return *this;
-    rofl::cmemory::operator=(pack);
+    if (pack.is_shared()) {
+      rofl::cmemory::resize(0);
+    } else {
+      rofl::cmemory::operator=(pack);
+    }
+    slice = pack.slice;
     head = pack.head;
     tail = pack.tail;
     initial_head = pack.initial_head;
@@ -104,6 +124,7 @@ public:
    *
    */
   void clear() {
+    unshare();
     rofl::cmemory::clear();
     head = initial_head;
     tail = initial_tail;
@@ -117,6 +138,7 @@ public:
     if (index >= length()) {
       throw ePacketOutOfRange("cpacket::operator[] index out of range");
     }
+    unshare();
     return (rofl::cmemory::operator[](head + index));
   };
 
@@ -170,6 +192,7 @@ public:
    *
    */
   cpacket &operator+=(const cpacket &pack) {
+    unshare();
     size_t offset = this->length();
     rofl::cmemory::resize(this->length() + pack.length());
     memcpy(this->soframe() + offset, pack.soframe(), pack.length());
@@ -181,6 +204,7 @@ public:
    *
    */
   virtual void assign(uint8_t *buf, size_t buflen) {
+    slice.clear();
     head = initial_head;
     tail = initial_tail;
     cmemory::resize(head + buflen + tail);
@@ -192,6 +216,7 @@ public:
    *
    */
   virtual uint8_t *resize(size_t len) {
+    unshare();
     cmemory::resize(head + len + tail);
     return soframe();
   };
@@ -199,7 +224,9 @@ public:
   /**
    *
    */
-  uint8_t *soframe() const { return (rofl::cmemory::somem() + head); };
+  uint8_t *soframe() const {
+    return (is_shared()) ? slice.somem() : (rofl::cmemory::somem() + head);
+  };
 
   /**
    *
@@ -209,7 +236,10 @@ public:
   /**
    *
    */
-  size_t length() const { return (rofl::cmemory::memlen() - head - tail); };
+  size_t length() const {
+    return (is_shared()) ? slice.length()
+                         : (rofl::cmemory::memlen() - head - tail);
+  };
 
   /**
    *
@@ -225,15 +255,46 @@ public:
    *
    */
   virtual void unpack(uint8_t *buf, size_t buflen) {
+    slice.clear();
     rofl::cmemory::resize(head + buflen + tail);
     memcpy(soframe(), buf, buflen);
   };
 
+  /**
+   * @brief	Shares the frame referred to by slice without copying
+   */
+  void unpack(const cslice &slice) {
+    rofl::cmemory::resize(0);
+    head = initial_head;
+    tail = initial_tail;
+    this->slice = slice;
+  };
+
+  /**
+   * @brief	Returns true when the frame is shared via a cslice
+   */
+  bool is_shared() const { return (not slice.is_null()); };
+
+  /**
+   * @brief	Copies a shared frame into private memory
+   */
+  void unshare() {
+    if (not is_shared())
+      return;
+    cslice tmp(slice);
+    slice.clear();
+    head = initial_head;
+    tail = initial_tail;
+    rofl::cmemory::resize(head + tmp.length() + tail);
+    memcpy(rofl::cmemory::somem() + head, tmp.somem(), tmp.length());
+  };
+
 public:
   /**
    *
    */
   void tag_insert(size_t len) {
+    unshare();
     if (len > head) {
       throw ePacketInval("cpacket::tag_insert() insufficient head space");
     }
@@ -244,6 +305,7 @@ public:
    *
    */
   void tag_remove(size_t len) {
+    unshare();
     if ((len + head) > rofl::cmemory::memlen()) {
       throw ePacketInval("cpacket::tag_insert() invalid tag size");
     }
@@ -254,6 +316,7 @@ public:
    *
    */
   uint8_t *push(unsigned int offset, unsigned int nbytes) {
+    unshare();
     if (nbytes > head) {
       resize(length() + nbytes);
     }
@@ -267,6 +330,7 @@ public:
    *
    */
   void pop(unsigned int offset, unsigned int nbytes) {
+    unshare();
     if ((head + offset + nbytes) > memlen()) {
       throw ePacketOutOfRange("rofl::cpacket::pop()");
     }
@@ -316,6 +380,9 @@ private:
                // payload(s)
   size_t initial_head;
   size_t initial_tail;
+
+  // shared frame, if any
+  cslice slice;
 };
 
 }; // end of namespace rofl
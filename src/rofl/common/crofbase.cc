@@ -15,8 +15,8 @@
 
 using namespace rofl;
 
-/*static*/ std::set<crofbase *> crofbase::rofbases;
-/*static*/ crwlock crofbase::rofbases_rwlock;
+/*static*/ cenvs<crofbase> crofbase::rofbases;
+/*static*/ const int crofbase::DEFAULT_LISTEN_BACKLOG = 10;
 
 crofbase::~crofbase() {
   /* close listening sockets */
@@ -32,21 +32,29 @@ crofbase::~crofbase() {
   /* stop background management thread */
   thread.stop();
 
-  AcquireReadWriteLock rwlock(rofbases_rwlock);
-  crofbase::rofbases.erase(this);
-  if (crofbase::rofbases.empty()) {
+  /* stop accept threads */
+  for (auto accept_thread : accept_threads) {
+    accept_thread->stop();
+    delete accept_thread;
+  }
+
+  /* wait for upcalls from remaining connections and channels */
+  crofconn_env::drop_env();
+  crofctl_env::drop_env();
+  crofdpt_env::drop_env();
+
+  if (crofbase::rofbases.drop(this) == 0) {
     crofbase::terminate();
   }
 }
 
 crofbase::crofbase()
-    : thread(this), generation_is_defined(false),
+    : thread(this), num_accept_threads(1),
+      listen_backlog(DEFAULT_LISTEN_BACKLOG), generation_is_defined(false),
       cached_generation_id((uint64_t)((int64_t)-1)), enforce_tls(false) {
-  AcquireReadWriteLock rwlock(rofbases_rwlock);
-  if (crofbase::rofbases.empty()) {
+  if (crofbase::rofbases.add(this) == 1) {
     crofbase::initialize();
   }
-  crofbase::rofbases.insert(this);
   /* start background management thread */
   thread.start("crofbase");
 }
@@ -200,12 +208,55 @@ void crofbase::send_port_status_message(const cauxid &auxid, uint8_t reason,
   }
 }
 
-int crofbase::listen(const csockaddr &baddr) {
+crofbase &crofbase::set_accept_threads(unsigned int num_threads) {
+  if (num_threads == 0)
+    num_threads = 1;
+
+  /* threads are kept until destruction, as listening sockets may still
+   * be served by them */
+  while (accept_threads.size() + 1 < num_threads) {
+    cthread *accept_thread = new cthread(this);
+    /* spread accept threads over cthread_pool workers */
+    accept_thread->set_affinity(accept_thread);
+    accept_thread->start("crofbase-accept");
+    accept_threads.push_back(accept_thread);
+  }
+  num_accept_threads = num_threads;
+  return *this;
+}
+
+std::vector<int> crofbase::open_listeners(const csockaddr &baddr) {
+  std::vector<int> sds;
+  bool reuseport = (num_accept_threads > 1);
+  try {
+    for (unsigned int i = 0; i < num_accept_threads; i++) {
+      sds.push_back(listen(baddr, reuseport));
+
+      /* instruct thread to read from socket descriptor */
+      get_accept_thread(i).add_fd(sds.back());
+      get_accept_thread(i).add_read_fd(sds.back(), false);
+    }
+  } catch (...) {
+    close_listeners(sds);
+    throw;
+  }
+  return sds;
+}
+
+void crofbase::close_listeners(const std::vector<int> &sds) {
+  for (unsigned int i = 0; i < sds.size(); i++) {
+    /* stop polling before the descriptor may be reused */
+    get_accept_thread(i).drop_fd(sds[i], false);
+    ::close(sds[i]);
+  }
+}
+
+int crofbase::listen(const csockaddr &baddr, bool reuseport) {
   int sd;
   int rc;
   int type = SOCK_STREAM;
   int protocol = IPPROTO_TCP;
-  int backlog = 10;
+  int backlog = listen_backlog;
 
   /* open socket */
   if ((sd = ::socket(baddr.get_family(), type, protocol)) < 0) {
@@ -231,12 +282,13 @@ int crofbase::listen(const csockaddr &baddr) {
       throw eSysCall("setsockopt() SOL_SOCKET, SO_REUSEADDR");
     }
 
-#if 0
-		int on = 1;
-		if ((rc = ::setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on))) < 0) {
-			throw eSysCall("setsockopt(SOL_SOCKET, SO_REUSEPORT)");
-		}
-#endif
+    // set SO_REUSEPORT option for sharing baddr among accept threads
+    if (reuseport &&
+        ((rc = ::setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, (int *)&optval,
+                            sizeof(optval))) < 0)) {
+      ::close(sd);
+      throw eSysCall("setsockopt() SOL_SOCKET, SO_REUSEPORT");
+    }
 
     // set TCP_NODELAY option on TCP sockets
     if ((rc = ::setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, (int *)&optval,
@@ -277,112 +329,91 @@ void crofbase::handle_wakeup(cthread &thread) {}
 void crofbase::handle_timeout(cthread &thread, uint32_t timer_id) {
   switch (timer_id) {
   case TIMER_ID_ROFCTL_DESTROY: {
-    AcquireReadWriteLock rwlock(rofctls_rwlock);
+    std::set<crofctl *> deletion;
+    {
+      AcquireReadWriteLock rwlock(rofctls_rwlock);
+      deletion.swap(rofctls_deletion);
+    }
     /* iterate over all crofctl pointers on the heap marked for destruction */
-    for (auto ctl : rofctls_deletion) {
+    for (auto ctl : deletion) {
       delete ctl;
     }
-    rofctls_deletion.clear();
   } break;
   case TIMER_ID_ROFDPT_DESTROY: {
-    AcquireReadWriteLock rwlock(rofdpts_rwlock);
+    std::set<crofdpt *> deletion;
+    {
+      AcquireReadWriteLock rwlock(rofdpts_rwlock);
+      deletion.swap(rofdpts_deletion);
+    }
     /* iterate over all crofdpt pointers on the heap marked for destruction */
-    for (auto dpt : rofdpts_deletion) {
+    for (auto dpt : deletion) {
       delete dpt;
     }
-    rofdpts_deletion.clear();
   } break;
   default: {};
   }
 }
 
 void crofbase::handle_read_event(cthread &thread, int fd) {
-  std::map<csockaddr, int>::iterator it;
-
   {
     /* incoming datapath connection */
     AcquireReadLock rlock(dpt_sockets_rwlock);
-    if ((it = find_if(dpt_sockets.begin(), dpt_sockets.end(),
-                      csocket_find_by_sock_descriptor(fd))) !=
-        dpt_sockets.end()) {
-
-      while (true) {
-        rofl::csockaddr raddr;
-        int sockfd = 0;
-        /* extract new connection from listening queue */
-        if ((sockfd = ::accept(fd, raddr.ca_saddr, &(raddr.salen))) < 0) {
-          switch (errno) {
-          case EAGAIN: {
-            /* do nothing */
-            return;
-          } break;
-          default: {
-            throw eSysCall("eSysCall", "accept", __FILE__, __FUNCTION__,
-                           __LINE__);
-          };
-          }
-        }
-
-        if (enforce_tls) {
-          (new crofconn(this))
-              ->set_tls_capath(capath)
-              .set_tls_cafile(cafile)
-              .set_tls_certfile(certfile)
-              .set_tls_keyfile(keyfile)
-              .set_tls_pswd(password)
-              .set_tls_verify_mode(verify_mode)
-              .set_tls_verify_depth(verify_depth)
-              .set_tls_ciphers(ciphers)
-              .tls_accept(sockfd, versionbitmap, crofconn::MODE_CONTROLLER);
-        } else {
-          (new crofconn(this))
-              ->tcp_accept(sockfd, versionbitmap, crofconn::MODE_CONTROLLER);
-        }
-      }
+    if (find_if(dpt_sockets.begin(), dpt_sockets.end(),
+                csocket_find_by_sock_descriptor(fd)) != dpt_sockets.end()) {
+      accept_connections(fd, crofconn::MODE_CONTROLLER);
+      return;
     }
   }
 
   {
     /* incoming controller connection */
     AcquireReadLock rlock(ctl_sockets_rwlock);
-    if ((it = find_if(ctl_sockets.begin(), ctl_sockets.end(),
-                      csocket_find_by_sock_descriptor(fd))) !=
-        ctl_sockets.end()) {
-
-      while (true) {
-        rofl::csockaddr raddr;
-        int sockfd = 0;
-        /* extract new connection from listening queue */
-        if ((sockfd = ::accept(fd, raddr.ca_saddr, &(raddr.salen))) < 0) {
-          switch (errno) {
-          case EAGAIN: {
-            /* do nothing */
-            return;
-          } break;
-          default: {
-            throw eSysCall("eSysCall", "accept", __FILE__, __FUNCTION__,
-                           __LINE__);
-          };
-          }
-        }
-
-        if (enforce_tls) {
-          (new crofconn(this))
-              ->set_tls_capath(capath)
-              .set_tls_cafile(cafile)
-              .set_tls_certfile(certfile)
-              .set_tls_keyfile(keyfile)
-              .set_tls_pswd(password)
-              .set_tls_verify_mode(verify_mode)
-              .set_tls_verify_depth(verify_depth)
-              .set_tls_ciphers(ciphers)
-              .tls_accept(sockfd, versionbitmap, crofconn::MODE_DATAPATH);
-        } else {
-          (new crofconn(this))
-              ->tcp_accept(sockfd, versionbitmap, crofconn::MODE_DATAPATH);
-        }
+    if (find_if(ctl_sockets.begin(), ctl_sockets.end(),
+                csocket_find_by_sock_descriptor(fd)) != ctl_sockets.end()) {
+      accept_connections(fd, crofconn::MODE_DATAPATH);
+      return;
+    }
+  }
+}
+
+void crofbase::accept_connections(int fd,
+                                  enum crofconn::crofconn_mode_t mode) {
+  while (true) {
+    int sockfd = 0;
+    /* extract new connection from listening queue, crofsock queries the
+     * addresses itself */
+    if ((sockfd = ::accept4(fd, NULL, NULL, SOCK_NONBLOCK)) < 0) {
+      switch (errno) {
+      case EAGAIN: {
+        /* do nothing */
+        return;
+      } break;
+      case EINTR:
+      case ECONNABORTED: {
+        /* connection reset while in listening queue */
+        continue;
+      } break;
+      default: {
+        throw eSysCall("eSysCall", "accept4", __FILE__, __FUNCTION__,
+                       __LINE__);
+      };
       }
     }
+
+    if (enforce_tls) {
+      (new crofconn(this))
+          ->set_tls_capath(capath)
+          .set_tls_cafile(cafile)
+          .set_tls_certfile(certfile)
+          .set_tls_keyfile(keyfile)
+          .set_tls_pswd(password)
+          .set_tls_verify_mode(verify_mode)
+          .set_tls_verify_depth(verify_depth)
+          .set_tls_ciphers(ciphers)
+          .tls_accept(sockfd, versionbitmap, mode);
+    } else {
+      (new crofconn(this))->tcp_accept(sockfd, versionbitmap, mode);
+    }
   }
 }
 
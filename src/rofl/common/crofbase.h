@@ -13,12 +13,14 @@
 #ifndef CROFBASE_H
 #define CROFBASE_H 1
 
+#include <algorithm>
 #include <glog/logging.h>
 #include <vector>
 
 #include "rofl/common/exception.hpp"
 #include "rofl/common/locking.hpp"
 
+#include "rofl/common/cenvs.hpp"
 #include "rofl/common/crandom.h"
 #include "rofl/common/crofctl.h"
 #include "rofl/common/crofdpt.h"
@@ -46,11 +48,8 @@ class crofbase : public virtual rofl::cthread_env,
                  public rofl::crofconn_env,
                  public rofl::crofctl_env,
                  public rofl::crofdpt_env {
-  // map of active crofbase instances
-  static std::set<crofbase *> rofbases;
-
-  // rwlock for rofbases
-  static crwlock rofbases_rwlock;
+  // active crofbase instances
+  static cenvs<crofbase> rofbases;
 
 public:
   /**
@@ -184,6 +183,46 @@ public:
     return *this;
   };
 
+public:
+  /**
+   * @name	Methods for accepting connections on multiple threads
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Sets number of threads accepting connections on each binding
+   * address
+   *
+   * By default, the management thread accepts all incoming connections
+   * and starts their TCP and TLS handshakes. With num_threads > 1, each
+   * binding address is served by num_threads listening sockets with
+   * SO_REUSEPORT, one per thread, and the kernel distributes incoming
+   * connections among them. Applies to listening sockets opened
+   * afterwards.
+   */
+  crofbase &set_accept_threads(unsigned int num_threads);
+
+  /**
+   *
+   */
+  unsigned int get_accept_threads() const { return num_accept_threads; };
+
+  /**
+   * @brief	Sets backlog for listening sockets opened afterwards
+   */
+  crofbase &set_listen_backlog(int backlog) {
+    this->listen_backlog = backlog;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  int get_listen_backlog() const { return listen_backlog; };
+
+  /**@}*/
+
 public:
   /**
    * @name	Methods for listening sockets accepting connections from
@@ -200,8 +239,7 @@ public:
   void close_dpt_socks() {
     AcquireReadWriteLock rwlock(dpt_sockets_rwlock);
     for (auto it : dpt_sockets) {
-      ::close(it.second);
-      thread.drop_read_fd(it.second, false);
+      close_listeners(it.second);
     }
     dpt_sockets.clear();
   };
@@ -218,11 +256,7 @@ public:
       return;
     }
 
-    dpt_sockets[baddr] = listen(baddr);
-
-    /* instruct thread to read from socket descriptor */
-    thread.add_fd(dpt_sockets[baddr]);
-    thread.add_read_fd(dpt_sockets[baddr], false);
+    dpt_sockets[baddr] = open_listeners(baddr);
   };
 
   /**
@@ -235,8 +269,7 @@ public:
     if (dpt_sockets.find(baddr) == dpt_sockets.end()) {
       return false;
     }
-    ::close(dpt_sockets[baddr]);
-    thread.drop_read_fd(dpt_sockets[baddr], false);
+    close_listeners(dpt_sockets[baddr]);
     dpt_sockets.erase(baddr);
     return true;
   };
@@ -270,8 +303,7 @@ public:
   void close_ctl_socks() {
     AcquireReadWriteLock rwlock(ctl_sockets_rwlock);
     for (auto it : ctl_sockets) {
-      ::close(it.second);
-      thread.drop_read_fd(it.second, false);
+      close_listeners(it.second);
     }
     ctl_sockets.clear();
   };
@@ -288,11 +320,7 @@ public:
       return;
     }
 
-    ctl_sockets[baddr] = listen(baddr);
-
-    /* instruct thread to read from socket descriptor */
-    thread.add_fd(ctl_sockets[baddr]);
-    thread.add_read_fd(ctl_sockets[baddr], false);
+    ctl_sockets[baddr] = open_listeners(baddr);
   };
 
   /**
@@ -305,8 +333,7 @@ public:
     if (ctl_sockets.find(baddr) == ctl_sockets.end()) {
       return false;
     }
-    ::close(dpt_sockets[baddr]);
-    thread.drop_read_fd(ctl_sockets[baddr], false);
+    close_listeners(ctl_sockets[baddr]);
     ctl_sockets.erase(baddr);
     return true;
   };
@@ -415,13 +442,18 @@ public:
    * @result reference to new rofl::crofdpt instance
    */
   rofl::crofdpt &add_dpt(const rofl::cdptid &dptid) {
-    AcquireReadWriteLock rwlock(rofdpts_rwlock);
-    if (rofdpts.find(dptid) != rofdpts.end()) {
-      delete rofdpts[dptid];
-      rofdpts.erase(dptid);
+    crofdpt *dropped = nullptr;
+    crofdpt *dpt = new crofdpt(this, dptid);
+    {
+      AcquireReadWriteLock rwlock(rofdpts_rwlock);
+      if (rofdpts.find(dptid) != rofdpts.end()) {
+        dropped = rofdpts[dptid];
+      }
+      rofdpts[dptid] = dpt;
     }
-    rofdpts[dptid] = new crofdpt(this, dptid);
-    return *(rofdpts[dptid]);
+    /* delete outside of lock, see __drop_dpts() */
+    delete dropped;
+    return *dpt;
   };
 
   /**
@@ -649,14 +681,18 @@ public:
    * @result reference to new rofl::crofctl instance
    */
   rofl::crofctl &add_ctl(const rofl::cctlid &ctlid) {
-    AcquireReadWriteLock rwlock(rofctls_rwlock);
-    ;
-    if (rofctls.find(ctlid) != rofctls.end()) {
-      delete rofctls[ctlid];
-      rofctls.erase(ctlid);
+    crofctl *dropped = nullptr;
+    crofctl *ctl = new crofctl(this, ctlid);
+    {
+      AcquireReadWriteLock rwlock(rofctls_rwlock);
+      if (rofctls.find(ctlid) != rofctls.end()) {
+        dropped = rofctls[ctlid];
+      }
+      rofctls[ctlid] = ctl;
     }
-    rofctls[ctlid] = new crofctl(this, ctlid);
-    return *(rofctls[ctlid]);
+    /* delete outside of lock, see __drop_dpts() */
+    delete dropped;
+    return *ctl;
   };
 
   /**
@@ -1589,6 +1625,20 @@ public:
   virtual void handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg_packet_in &msg){};
 
+  /**
+   * @brief	Message of a passthrough type received.
+   *
+   * Enable passthrough via rofl::crofdpt::set_rx_passthrough(). Called
+   * from the receiving socket's thread, frame may be relayed via
+   * rofl::crofctl::send_frame().
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param frame received message including its common header
+   */
+  virtual void handle_recv_frame(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                 const rofl::cslice &frame){};
+
   /**
    * @brief	OpenFlow Barrier-Reply message received.
    *
@@ -1611,6 +1661,57 @@ public:
    */
   virtual void handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control message received.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                              rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	Timer expired while waiting for OpenFlow Bundle-Control reply.
+   *
+   * @param dpt datapath instance
+   * @param xid OpenFlow transaction identifier
+   */
+  virtual void handle_bundle_control_reply_timeout(rofl::crofdpt &dpt,
+                                                   uint32_t xid){};
+
+  /**
+   * @brief	Shadow tables have been restored on the datapath element.
+   *
+   * @param dpt datapath instance
+   * @param num_msgs number of Flow-Mod, Group-Mod and Meter-Mod messages sent
+   */
+  virtual void handle_shadow_reconciled(rofl::crofdpt &dpt,
+                                        unsigned int num_msgs){};
+
+  /**
+   * @brief	Reconciliation of the shadow tables has been given up.
+   *
+   * @param dpt datapath instance
+   * @param reason textual description of the failure
+   */
+  virtual void handle_shadow_aborted(rofl::crofdpt &dpt,
+                                     const std::string &reason){};
+
+  /**
+   * @brief	Last segment of a streamed multipart reply handed over.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param xid OpenFlow transaction identifier
+   * @param stats_type OpenFlow multipart type
+   */
+  virtual void handle_multipart_reply_complete(rofl::crofdpt &dpt,
+                                               const rofl::cauxid &auxid,
+                                               uint32_t xid,
+                                               uint16_t stats_type){};
+
   /**
    * @brief	OpenFlow Flow-Removed message received.
    *
@@ -1974,6 +2075,20 @@ public:
   virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                                  rofl::openflow::cofmsg_packet_out &msg){};
 
+  /**
+   * @brief	Message of a passthrough type received.
+   *
+   * Enable passthrough via rofl::crofctl::set_rx_passthrough(). Called
+   * from the receiving socket's thread, frame may be relayed via
+   * rofl::crofdpt::send_frame().
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param frame received message including its common header
+   */
+  virtual void handle_recv_frame(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 const rofl::cslice &frame){};
+
   /**
    * @brief	OpenFlow Barrier-Request message received.
    *
@@ -1985,6 +2100,28 @@ public:
   handle_barrier_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                          rofl::openflow::cofmsg_barrier_request &msg){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control request received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	OpenFlow Bundle-Add-Message message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_add_message(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_bundle_add_message &msg){};
+
   /**
    * @brief	OpenFlow Flow-Mod message received.
    *
@@ -2130,8 +2267,9 @@ public:
 
   public:
     csocket_find_by_sock_descriptor(int sd) : sd(sd){};
-    bool operator()(const std::pair<csockaddr, int> &p) {
-      return (p.second == sd);
+    bool operator()(const std::pair<csockaddr, std::vector<int>> &p) {
+      return (std::find(p.second.begin(), p.second.end(), sd) !=
+              p.second.end());
     };
   };
 
@@ -2237,29 +2375,60 @@ private:
    *
    * @return socket descriptor
    */
-  int listen(const csockaddr &baddr);
+  int listen(const csockaddr &baddr, bool reuseport = false);
+
+  /**
+   * @brief	Opens one listening socket per accept thread for baddr
+   */
+  std::vector<int> open_listeners(const csockaddr &baddr);
+
+  /**
+   * @brief	Closes listening sockets opened by open_listeners()
+   */
+  void close_listeners(const std::vector<int> &sds);
+
+  /**
+   * @brief	Returns thread serving the listening socket with index
+   */
+  cthread &get_accept_thread(unsigned int index) {
+    return (index == 0) ? thread : *(accept_threads[index - 1]);
+  };
+
+  /**
+   * @brief	Accepts all pending connections on listening socket sd
+   */
+  void accept_connections(int sd, enum crofconn::crofconn_mode_t mode);
 
 private:
   /**
    * @brief	Deletes all existing rofl::crofdpt instances
    */
   void __drop_dpts() {
-    AcquireReadWriteLock rwlock(rofdpts_rwlock);
-    for (auto it : rofdpts) {
+    /* delete outside of lock, destructors wait for upcalls in progress
+     * on connection threads that may acquire it */
+    std::map<cdptid, crofdpt *> dropped;
+    {
+      AcquireReadWriteLock rwlock(rofdpts_rwlock);
+      dropped.swap(rofdpts);
+    }
+    for (auto it : dropped) {
       delete it.second;
     }
-    rofdpts.clear();
   };
 
   /**
    * @brief	Deletes all existing rofl::crofctl instances
    */
   void __drop_ctls() {
-    AcquireReadWriteLock rwlock(rofctls_rwlock);
-    for (auto it : rofctls) {
+    /* delete outside of lock, see __drop_dpts() */
+    std::map<cctlid, crofctl *> dropped;
+    {
+      AcquireReadWriteLock rwlock(rofctls_rwlock);
+      dropped.swap(rofctls);
+    }
+    for (auto it : dropped) {
       delete it.second;
     }
-    rofctls.clear();
   };
 
 private:
@@ -2271,6 +2440,16 @@ private:
   // management thread
   cthread thread;
 
+  // threads serving additional listening sockets with SO_REUSEPORT
+  std::vector<cthread *> accept_threads;
+
+  // number of listening sockets per binding address
+  unsigned int num_accept_threads;
+
+  // backlog for listening sockets
+  int listen_backlog;
+  static const int DEFAULT_LISTEN_BACKLOG;
+
   // peer controllers
   std::map<cctlid, crofctl *> rofctls;
 
@@ -2297,14 +2476,16 @@ private:
    *
    */
 
-  // listening sockets for accepting connections from datapath elements
-  std::map<csockaddr, int> dpt_sockets;
+  // listening sockets for accepting connections from datapath elements,
+  // one per accept thread
+  std::map<csockaddr, std::vector<int>> dpt_sockets;
 
   // associated rwlock
   mutable crwlock dpt_sockets_rwlock;
 
-  // listening sockets for accepting connections from controller elements
-  std::map<csockaddr, int> ctl_sockets;
+  // listening sockets for accepting connections from controller elements,
+  // one per accept thread
+  std::map<csockaddr, std::vector<int>> ctl_sockets;
 
   mutable crwlock ctl_sockets_rwlock;
 
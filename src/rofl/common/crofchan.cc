@@ -11,11 +11,12 @@
  */
 
 #include "rofl/common/crofchan.h"
+#include "rofl/common/openflow/messages/cofmsg_packet_in.h"
+#include "rofl/common/openflow/messages/cofmsg_packet_out.h"
 
 using namespace rofl;
 
-/*static*/ std::set<crofchan_env *> crofchan_env::channel_envs;
-/*static*/ crwlock crofchan_env::channel_envs_lock;
+/*static*/ cenvs<crofchan_env> crofchan_env::channel_envs;
 
 bool crofchan::is_established() const {
   AcquireReadLock rwlock(conns_rwlock);
@@ -28,33 +29,60 @@ bool crofchan::is_established() const {
 rofl::crofsock::msg_result_t
 crofchan::send_message(const cauxid &auxid, rofl::openflow::cofmsg *msg) {
   AcquireReadLock rwlock(conns_rwlock);
-  if (not is_established()) {
-    throw eRofConnNotConnected(
-        "crofchan::send_message() channel not established")
-        .set_func(__FUNCTION__)
-        .set_line(__LINE__);
-  }
-  if (conns.find(auxid) == conns.end()) {
-    throw eRofConnNotConnected("crofchan::send_message() connection not found")
-        .set_func(__FUNCTION__)
-        .set_line(__LINE__)
-        .set_key("auxid", auxid.str());
-  }
-  if (not conns[auxid]->is_established()) {
-    throw eRofConnNotConnected(
-        "crofchan::send_message() connection not established")
-        .set_func(__FUNCTION__)
-        .set_line(__LINE__)
-        .set_key("auxid", auxid.str());
-  }
-  return conns[auxid]->send_message(msg);
+  crofconn &conn = get_tx_conn(auxid, msg);
+  return count(conn.get_auxid(), conn.send_message(msg));
 }
 
 rofl::crofsock::msg_result_t crofchan::send_message(const cauxid &auxid,
                                                     rofl::openflow::cofmsg *msg,
                                                     const ctimespec &ts) {
   AcquireReadLock rwlock(conns_rwlock);
-  if (not is_established()) {
+  crofconn &conn = get_tx_conn(auxid, msg);
+  return count(conn.get_auxid(), conn.send_message(msg, ts));
+}
+
+rofl::crofsock::msg_result_t
+crofchan::try_send_message(const cauxid &auxid, rofl::openflow::cofmsg *&msg) {
+  AcquireReadLock rwlock(conns_rwlock);
+  crofconn *conn = find_tx_conn(auxid, msg);
+  if (conn == nullptr)
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  return count(conn->get_auxid(), conn->try_send_message(msg));
+}
+
+rofl::crofsock::msg_result_t
+crofchan::try_send_message(const cauxid &auxid, rofl::openflow::cofmsg *&msg,
+                           const ctimespec &ts) {
+  AcquireReadLock rwlock(conns_rwlock);
+  crofconn *conn = find_tx_conn(auxid, msg);
+  if (conn == nullptr)
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  return count(conn->get_auxid(), conn->try_send_message(msg, ts));
+}
+
+rofl::crofsock::msg_result_t crofchan::send_frame(const cauxid &auxid,
+                                                  const cslice &frame,
+                                                  uint32_t xid) {
+  AcquireReadLock rwlock(conns_rwlock);
+  /* this channel is up, when its main connection is up */
+  std::map<cauxid, crofconn *>::iterator it = conns.find(cauxid(0));
+  if ((it == conns.end()) || (not it->second->is_established()))
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  it = conns.find(auxid);
+  if ((it == conns.end()) || (not it->second->is_established()))
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+  return count(auxid, it->second->send_frame(frame, xid));
+}
+
+crofconn &crofchan::get_tx_conn(const cauxid &auxid,
+                                const rofl::openflow::cofmsg *msg) {
+  crofconn *conn = find_tx_conn(auxid, msg);
+  if (conn != nullptr)
+    return *conn;
+
+  /* slow path: tell the caller why */
+  std::map<cauxid, crofconn *>::iterator it = conns.find(cauxid(0));
+  if ((it == conns.end()) || (not it->second->is_established())) {
     throw eRofConnNotConnected(
         "crofchan::send_message() channel not established")
         .set_func(__FUNCTION__)
@@ -66,12 +94,110 @@ rofl::crofsock::msg_result_t crofchan::send_message(const cauxid &auxid,
         .set_line(__LINE__)
         .set_key("auxid", auxid.str());
   }
-  if (not conns[auxid]->is_established()) {
-    throw eRofConnNotConnected(
-        "crofchan::send_message() connection not established")
-        .set_func(__FUNCTION__)
-        .set_line(__LINE__)
-        .set_key("auxid", auxid.str());
+  throw eRofConnNotConnected(
+      "crofchan::send_message() connection not established")
+      .set_func(__FUNCTION__)
+      .set_line(__LINE__)
+      .set_key("auxid", auxid.str());
+}
+
+crofconn *crofchan::find_tx_conn(const cauxid &auxid,
+                                 const rofl::openflow::cofmsg *msg) {
+  /* this channel is up, when its main connection is up */
+  std::map<cauxid, crofconn *>::iterator it = conns.find(cauxid(0));
+  if ((it == conns.end()) || (not it->second->is_established()))
+    return nullptr;
+  if (auxid.get_id() == 0) {
+    if (sched_policy != SCHED_EXPLICIT) {
+      crofconn *conn = schedule(msg);
+      if (conn != nullptr)
+        return conn;
+    }
+    return it->second;
+  }
+  it = conns.find(auxid);
+  if ((it == conns.end()) || (not it->second->is_established()))
+    return nullptr;
+  return it->second;
+}
+
+crofconn *crofchan::schedule(const rofl::openflow::cofmsg *msg) {
+  uint32_t in_port = 0;
+  /* no flow key for packets without in_port or from a reserved port, e.g.
+   * Packet-Outs originated by the controller with OFPP_CONTROLLER */
+  bool has_flow_key = false;
+  switch (msg->get_type()) {
+  case rofl::openflow::OFPT_PACKET_IN: {
+    const rofl::openflow::cofmsg_packet_in *pin =
+        dynamic_cast<const rofl::openflow::cofmsg_packet_in *>(msg);
+    if (pin == nullptr)
+      return nullptr;
+    if (msg->get_version() == rofl::openflow10::OFP_VERSION) {
+      in_port = pin->get_in_port();
+      has_flow_key = (in_port <= rofl::openflow10::OFPP_MAX);
+    } else if (pin->get_match().has_in_port()) {
+      in_port = pin->get_match().get_in_port();
+      has_flow_key = (in_port <= rofl::openflow13::OFPP_MAX);
+    }
+  } break;
+  case rofl::openflow::OFPT_PACKET_OUT: {
+    const rofl::openflow::cofmsg_packet_out *pout =
+        dynamic_cast<const rofl::openflow::cofmsg_packet_out *>(msg);
+    if (pout == nullptr)
+      return nullptr;
+    in_port = pout->get_in_port();
+    if (msg->get_version() == rofl::openflow10::OFP_VERSION) {
+      has_flow_key = (in_port <= rofl::openflow10::OFPP_MAX);
+    } else {
+      has_flow_key = (in_port <= rofl::openflow13::OFPP_MAX);
+    }
+  } break;
+  default:
+    return nullptr;
+  }
+
+  /* established auxiliary connections in auxid order */
+  crofconn *candidates[256];
+  unsigned int num = 0;
+  for (std::map<cauxid, crofconn *>::const_iterator it = conns.begin();
+       it != conns.end(); ++it) {
+    if ((it->first.get_id() != 0) && it->second->is_established()) {
+      candidates[num++] = it->second;
+    }
+  }
+  if (num == 0)
+    return nullptr;
+
+  switch (sched_policy) {
+  case SCHED_FLOW_HASH: {
+    /* nothing to keep in order without a flow key, so rotate */
+    if (not has_flow_key) {
+      return candidates[sched_next.fetch_add(1, std::memory_order_relaxed) %
+                        num];
+    }
+    /* multiplicative hash spreads consecutive port numbers */
+    return candidates[((uint64_t)(in_port * 2654435761U) * num) >> 32];
+  }
+  case SCHED_LEAST_QUEUED: {
+    /* start at a rotating position, so idle connections share the load */
+    unsigned int first = sched_next.fetch_add(1, std::memory_order_relaxed);
+    crofconn *conn = candidates[first % num];
+    size_t backlog = conn->get_txqueue_pending_pkts();
+    for (unsigned int i = 1; (i < num) && (backlog > 0); i++) {
+      crofconn *next = candidates[(first + i) % num];
+      size_t pending = next->get_txqueue_pending_pkts();
+      if (pending < backlog) {
+        conn = next;
+        backlog = pending;
+      }
+    }
+    return conn;
+  }
+  case SCHED_ROUND_ROBIN: {
+    return candidates[sched_next.fetch_add(1, std::memory_order_relaxed) %
+                      num];
+  }
+  default:
+    return nullptr;
   }
-  return conns[auxid]->send_message(msg, ts);
 }
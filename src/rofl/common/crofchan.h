@@ -20,6 +20,7 @@
 #include <map>
 
 #include "rofl/common/cauxid.h"
+#include "rofl/common/cenvs.hpp"
 #include "rofl/common/crandom.h"
 #include "rofl/common/crofconn.h"
 #include "rofl/common/cthread.hpp"
@@ -65,10 +66,9 @@ class crofchan_env {
   friend class crofchan;
 
 public:
-  static crofchan_env &call_env(crofchan_env *env) {
-    AcquireReadLock lock(crofchan_env::channel_envs_lock);
-    if (crofchan_env::channel_envs.find(env) ==
-        crofchan_env::channel_envs.end()) {
+  static crofchan_env &call_env(crofchan_env *env,
+                                chazard::guard &&guard = chazard::guard()) {
+    if (not crofchan_env::channel_envs.protect(env, guard)) {
       throw eRofChanNotFound(
           "crofchan_env::call_env() crofchan_env instance not found")
           .set_func(__FUNCTION__)
@@ -80,15 +80,18 @@ public:
 
 public:
   virtual ~crofchan_env() {
-    AcquireReadWriteLock lock(crofchan_env::channel_envs_lock);
-    crofchan_env::channel_envs.erase(this);
+    crofchan_env::channel_envs.drop(this);
   };
   crofchan_env() {
-    AcquireReadWriteLock lock(crofchan_env::channel_envs_lock);
-    crofchan_env::channel_envs.insert(this);
+    crofchan_env::channel_envs.add(this);
   };
 
 protected:
+  /**
+   * @brief	Deregisters this instance, see cenvs::drop()
+   */
+  void drop_env() { crofchan_env::channel_envs.drop(this); };
+
   virtual void handle_established(crofchan &chan, uint8_t ofp_version) = 0;
 
   virtual void handle_closed(crofchan &chan) = 0;
@@ -109,6 +112,15 @@ protected:
   virtual void handle_recv(crofchan &chan, crofconn &conn,
                            rofl::openflow::cofmsg *msg) = 0;
 
+  /**
+   * @brief	Called for received messages with a passthrough type, see
+   * crofconn_env::handle_recv_frame()
+   */
+  virtual void handle_recv_frame(crofchan &chan, crofconn &conn,
+                                 const cslice &frame) {
+    handle_recv(chan, conn, new rofl::openflow::cofmsg_frame(frame));
+  };
+
   virtual void congestion_occured_indication(crofchan &chan,
                                              crofconn &conn) = 0;
 
@@ -119,8 +131,7 @@ protected:
                                           uint16_t sub_type = 0){};
 
 private:
-  static std::set<crofchan_env *> channel_envs;
-  static crwlock channel_envs_lock;
+  static cenvs<crofchan_env> channel_envs;
 };
 
 /**
@@ -133,11 +144,36 @@ class crofchan : public cthread_env, public rofl::crofconn_env {
     TIMER_ID_ROFCONN_DESTROY = 1,
   };
 
+public:
+  /**
+   * @brief	Policies for distributing messages over auxiliary connections
+   *
+   * Only Packet-In and Packet-Out messages addressed to the main
+   * connection are redistributed. Explicitly selected auxiliary
+   * connections and all other message types, which rely on ordering
+   * against barriers and transactions on the main connection, are never
+   * moved. Without any established auxiliary connection all messages
+   * remain on the main connection.
+   */
+  enum crofchan_sched_t {
+    // send on the connection selected by the caller
+    SCHED_EXPLICIT = 0,
+    // hash by in_port, keeps ordering per in_port; packets from a
+    // reserved port like OFPP_CONTROLLER are rotated
+    SCHED_FLOW_HASH = 1,
+    // connection with the smallest transmission backlog
+    SCHED_LEAST_QUEUED = 2,
+    // rotate over auxiliary connections
+    SCHED_ROUND_ROBIN = 3,
+  };
+
 public:
   /**
    *
    */
   virtual ~crofchan() {
+    /* wait for upcalls from connections in progress */
+    drop_env();
     /* stop management thread */
     thread.stop();
     /* drop connections scheduled for removal */
@@ -151,7 +187,11 @@ public:
    */
   crofchan(crofchan_env *env)
       : env(env), thread(this), last_auxid(0),
-        ofp_version(rofl::openflow::OFP_VERSION_UNKNOWN) {
+        ofp_version(rofl::openflow::OFP_VERSION_UNKNOWN),
+        sched_policy(SCHED_EXPLICIT), sched_next(0), multipart_streaming(false),
+        rx_lazy_decoding(false) {
+    rx_passthrough.reset();
+    clear_tx_counters();
     thread.start("crofchan");
   };
 
@@ -169,6 +209,34 @@ public:
                                             rofl::openflow::cofmsg *msg,
                                             const ctimespec &ts);
 
+  /**
+   * @brief	Sends msg without throwing
+   *
+   * Returns MSG_QUEUEING_FAILED_NOT_ESTABLISHED when the channel or
+   * connection auxid is not established. On success msg is set to
+   * nullptr, otherwise it remains owned by the caller.
+   */
+  rofl::crofsock::msg_result_t try_send_message(const cauxid &auxid,
+                                                rofl::openflow::cofmsg *&msg);
+
+  /**
+   * @brief	Sends msg with expiration timer without throwing
+   */
+  rofl::crofsock::msg_result_t try_send_message(const cauxid &auxid,
+                                                rofl::openflow::cofmsg *&msg,
+                                                const ctimespec &ts);
+
+  /**
+   * @brief	Sends a received wire frame with a new xid on connection
+   * auxid, see rofl::crofconn::send_frame()
+   *
+   * No scheduling policy is applied. Returns
+   * MSG_QUEUEING_FAILED_NOT_ESTABLISHED when the channel or connection
+   * auxid is not established.
+   */
+  rofl::crofsock::msg_result_t send_frame(const cauxid &auxid,
+                                          const cslice &frame, uint32_t xid);
+
 public:
   /**
    *
@@ -180,6 +248,36 @@ public:
    */
   uint8_t get_version() const { return ofp_version; };
 
+public:
+  /**
+   * @brief	Selects how messages are distributed over auxiliary connections
+   */
+  crofchan &set_sched_policy(crofchan_sched_t policy) {
+    sched_policy = policy;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  crofchan_sched_t get_sched_policy() const { return sched_policy; };
+
+  /**
+   * @brief	Returns number of messages queued on connection auxid
+   */
+  uint64_t get_tx_counter(const cauxid &auxid) const {
+    return tx_counters[auxid.get_id()];
+  };
+
+  /**
+   *
+   */
+  void clear_tx_counters() {
+    for (unsigned int i = 0; i < 256; i++) {
+      tx_counters[i] = 0;
+    }
+  };
+
 public:
   /**
    *
@@ -246,19 +344,26 @@ public:
           .set_line(__LINE__);
     }
     (conns[last_auxid] = new crofconn(this))->set_auxid(cauxid(last_auxid));
-    return *(conns[last_auxid]);
+    return init_conn(*(conns[last_auxid]));
   };
 
   /**
    *
    */
   crofconn &add_conn(const cauxid &auxid) {
-    AcquireReadWriteLock rwlock(conns_rwlock);
-    if (conns.find(auxid) != conns.end()) {
-      delete conns[auxid];
+    crofconn *dropped = nullptr;
+    crofconn *conn = nullptr;
+    {
+      AcquireReadWriteLock rwlock(conns_rwlock);
+      if (conns.find(auxid) != conns.end()) {
+        dropped = conns[auxid];
+      }
+      (conn = conns[auxid] = new crofconn(this))->set_auxid(auxid);
+      init_conn(*conn);
     }
-    (conns[auxid] = new crofconn(this))->set_auxid(auxid);
-    return *(conns[auxid]);
+    /* delete outside of lock, see __drop_conns() */
+    delete dropped;
+    return *conn;
   };
 
   /**
@@ -288,7 +393,7 @@ public:
     if (auxid == cauxid(0)) {
       ofp_version = conn->get_version();
     }
-    return *(conns[auxid]);
+    return init_conn(*(conns[auxid]));
   };
 
   /**
@@ -298,6 +403,7 @@ public:
     AcquireReadWriteLock rwlock(conns_rwlock);
     if (conns.find(auxid) == conns.end()) {
       (conns[auxid] = new crofconn(this))->set_auxid(auxid);
+      init_conn(*(conns[auxid]));
     }
     return *(conns[auxid]);
   };
@@ -367,23 +473,154 @@ public:
     return (not(conns.find(auxid) == conns.end()));
   };
 
+  /**
+   * @brief	Returns true when multipart replies are streamed
+   */
+  bool get_multipart_streaming() const { return multipart_streaming; };
+
+  /**
+   * @brief	Enables/disables streaming of multipart replies on all
+   * connections, see rofl::crofconn::set_multipart_streaming()
+   *
+   * Connections added later inherit this setting.
+   */
+  crofchan &set_multipart_streaming(bool multipart_streaming) {
+    AcquireReadLock rwlock(conns_rwlock);
+    this->multipart_streaming = multipart_streaming;
+    for (auto it : conns) {
+      it.second->set_multipart_streaming(multipart_streaming);
+    }
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when received messages are decoded lazily
+   */
+  bool get_rx_lazy_decoding() const { return rx_lazy_decoding; };
+
+  /**
+   * @brief	Enables/disables lazy decoding of received messages on all
+   * connections, see rofl::crofsock::set_rx_lazy_decoding()
+   *
+   * Connections added to this channel later inherit the setting.
+   */
+  crofchan &set_rx_lazy_decoding(bool rx_lazy_decoding) {
+    AcquireReadLock rwlock(conns_rwlock);
+    this->rx_lazy_decoding = rx_lazy_decoding;
+    for (auto it : conns) {
+      it.second->set_rx_lazy_decoding(rx_lazy_decoding);
+    }
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when messages of type are passed through
+   */
+  bool get_rx_passthrough(uint8_t type) const {
+    AcquireReadLock rwlock(conns_rwlock);
+    return rx_passthrough[type];
+  };
+
+  /**
+   * @brief	Enables or disables passthrough for messages of type on all
+   * connections, see rofl::crofconn::set_rx_passthrough()
+   *
+   * Connections added to this channel later inherit the setting.
+   */
+  crofchan &set_rx_passthrough(uint8_t type, bool passthrough = true) {
+    if (not crofconn::is_rx_passthrough_allowed(type)) {
+      throw eRofConnInvalid(
+          "crofchan::set_rx_passthrough() connection management message type")
+          .set_func(__FUNCTION__)
+          .set_file(__FILE__)
+          .set_line(__LINE__)
+          .set_key("type", (int)type);
+    }
+    AcquireReadWriteLock rwlock(conns_rwlock);
+    rx_passthrough[type] = passthrough;
+    for (auto it : conns) {
+      it.second->set_rx_passthrough(type, passthrough);
+    }
+    return *this;
+  };
+
+  /**
+   * @brief	Disables passthrough for all message types on all connections
+   */
+  crofchan &clear_rx_passthrough() {
+    AcquireReadWriteLock rwlock(conns_rwlock);
+    rx_passthrough.reset();
+    for (auto it : conns) {
+      it.second->clear_rx_passthrough();
+    }
+    return *this;
+  };
+
+private:
+  /**
+   * @brief	Applies channel wide settings to conn, called with conns_rwlock
+   * held
+   */
+  crofconn &init_conn(crofconn &conn) {
+    conn.set_multipart_streaming(multipart_streaming);
+    conn.set_rx_lazy_decoding(rx_lazy_decoding);
+    for (unsigned int type = 0; type < rx_passthrough.size(); type++) {
+      if (rx_passthrough[type])
+        conn.set_rx_passthrough(type);
+    }
+    return conn;
+  };
+
+  /**
+   * @brief	Selects the connection for msg, called with conns_rwlock held
+   */
+  crofconn &get_tx_conn(const cauxid &auxid,
+                        const rofl::openflow::cofmsg *msg);
+
+  /**
+   * @brief	Same as get_tx_conn(), returns nullptr instead of throwing
+   */
+  crofconn *find_tx_conn(const cauxid &auxid,
+                         const rofl::openflow::cofmsg *msg);
+
+  /**
+   * @brief	Maps msg to an established auxiliary connection
+   */
+  crofconn *schedule(const rofl::openflow::cofmsg *msg);
+
+  /**
+   *
+   */
+  rofl::crofsock::msg_result_t count(const cauxid &auxid,
+                                     rofl::crofsock::msg_result_t result) {
+    if ((result == rofl::crofsock::MSG_QUEUED) ||
+        (result == rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+      tx_counters[auxid.get_id()].fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+  };
+
 private:
   /**
    *
    */
   bool __drop_conn(const cauxid &auxid) {
-    AcquireReadWriteLock rwlock(conns_rwlock);
-    if (auxid.get_id() == 0) {
-      for (auto it : conns) {
-        delete it.second;
-      }
-      conns.clear();
-    } else {
-      if (conns.find(auxid) == conns.end()) {
-        return false;
+    /* delete outside of lock, see __drop_conns() */
+    std::map<cauxid, crofconn *> dropped;
+    {
+      AcquireReadWriteLock rwlock(conns_rwlock);
+      if (auxid.get_id() == 0) {
+        dropped.swap(conns);
+      } else {
+        if (conns.find(auxid) == conns.end()) {
+          return false;
+        }
+        dropped[auxid] = conns[auxid];
+        conns.erase(auxid);
       }
-      delete conns[auxid];
-      conns.erase(auxid);
+    }
+    for (auto it : dropped) {
+      delete it.second;
     }
     return true;
   };
@@ -392,27 +629,36 @@ private:
    *
    */
   void __drop_conns() {
-    AcquireReadWriteLock rwlock(conns_rwlock);
-    for (auto it : conns) {
+    /* delete outside of lock, a connection's destructor waits for upcalls
+     * in progress on its threads that may acquire conns_rwlock */
+    std::map<cauxid, crofconn *> dropped;
+    {
+      AcquireReadWriteLock rwlock(conns_rwlock);
+      dropped.swap(conns);
+    }
+    for (auto it : dropped) {
       // std::cerr << "__drop_conns: deleting conn (" <<
       // (int)it.second->get_auxid().get_id() << ") 0x" << it.second <<
       // std::endl;
       delete it.second;
     }
-    conns.clear();
   };
 
   /**
    *
    */
   void __drop_conns_deletion() {
-    AcquireReadWriteLock lock(conns_deletion_rwlock);
-    for (auto conn : conns_deletion) {
+    /* delete outside of lock, see __drop_conns() */
+    std::set<crofconn *> deletion;
+    {
+      AcquireReadWriteLock lock(conns_deletion_rwlock);
+      deletion.swap(conns_deletion);
+    }
+    for (auto conn : deletion) {
       // std::cerr << "__drop_conns_deletion: deleting conn (" <<
       // (int)conn->get_auxid().get_id() << ") 0x" << conn << std::endl;
       delete conn;
     }
-    conns_deletion.clear();
   };
 
 public:
@@ -527,6 +773,10 @@ private:
     crofchan_env::call_env(env).handle_recv(*this, conn, msg);
   };
 
+  virtual void handle_recv_frame(crofconn &conn, const cslice &frame) {
+    crofchan_env::call_env(env).handle_recv_frame(*this, conn, frame);
+  };
+
   virtual void congestion_occured_indication(crofconn &conn) {
     crofchan_env::call_env(env).congestion_occured_indication(*this, conn);
   };
@@ -579,6 +829,26 @@ private:
   // state related flags
   std::bitset<32> flags;
 
+  // distribution of messages over auxiliary connections
+  std::atomic<crofchan_sched_t> sched_policy;
+
+  // rotating position for SCHED_ROUND_ROBIN, SCHED_LEAST_QUEUED and
+  // SCHED_FLOW_HASH without a flow key
+  std::atomic_uint sched_next;
+
+  // messages queued per auxid
+  std::atomic<uint64_t> tx_counters[256];
+
+  // streaming of multipart replies on all connections
+  std::atomic_bool multipart_streaming;
+
+  // lazy decoding of received messages on all connections
+  std::atomic_bool rx_lazy_decoding;
+
+  // message types passed through on all connections, guarded by
+  // conns_rwlock
+  std::bitset<256> rx_passthrough;
+
   // connections scheduled for deletion
   std::set<crofconn *> conns_deletion;
 
@@ -15,8 +15,7 @@
 
 using namespace rofl;
 
-/*static*/ std::set<crofconn_env *> crofconn_env::connection_envs;
-/*static*/ crwlock crofconn_env::connection_envs_lock;
+/*static*/ cenvs<crofconn_env> crofconn_env::connection_envs;
 /*static*/ const int crofconn::RXQUEUE_MAX_SIZE_DEFAULT = 128;
 /*static*/ const unsigned int crofconn::DEFAULT_SEGMENTATION_THRESHOLD = 65535;
 /*static*/ const time_t crofconn::DEFAULT_HELLO_TIMEOUT = 3;
@@ -27,6 +26,8 @@ using namespace rofl;
 /*static*/ const unsigned int crofconn::DEFAULT_PENDING_SEGMENTS_MAX = 256;
 
 crofconn::~crofconn() {
+  /* wait for upcalls from rofsock in progress */
+  drop_env();
   /* stop worker thread */
   set_state(STATE_CLOSING);
   thread.stop();
@@ -39,6 +40,7 @@ crofconn::crofconn(crofconn_env *env)
       rxweights(QUEUE_MAX), rxqueues(QUEUE_MAX), rx_thread_working(false),
       rx_thread_scheduled(false), rxqueue_max_size(RXQUEUE_MAX_SIZE_DEFAULT),
       segmentation_threshold(DEFAULT_SEGMENTATION_THRESHOLD),
+      segmenter(DEFAULT_SEGMENTATION_THRESHOLD),
       timeout_hello(DEFAULT_HELLO_TIMEOUT),
       timeout_features(DEFAULT_FEATURES_TIMEOUT),
       timeout_echo(DEFAULT_ECHO_TIMEOUT),
@@ -47,7 +49,8 @@ crofconn::crofconn(crofconn_env *env)
       xid_features_request_last(random.uint32()),
       xid_echo_request_last(random.uint32()),
       timeout_segments(DEFAULT_SEGMENTS_TIMEOUT),
-      pending_segments_max(DEFAULT_PENDING_SEGMENTS_MAX) {
+      pending_segments_max(DEFAULT_PENDING_SEGMENTS_MAX),
+      multipart_streaming(false) {
   /* scheduler weights for transmission */
   rxweights[QUEUE_OAM] = 16;
   rxweights[QUEUE_MGMT] = 32;
@@ -57,7 +60,8 @@ crofconn::crofconn(crofconn_env *env)
   for (unsigned int queue_id = 0; queue_id < QUEUE_MAX; queue_id++) {
     rxqueues[queue_id].set_queue_max_size(rxqueue_max_size);
   }
-  /* start worker thread */
+  /* start worker thread, share a cthread_pool worker with rofsock */
+  thread.set_affinity(static_cast<crofsock_env *>(this));
   thread.start("crofconn");
 }
 
@@ -155,6 +159,7 @@ void crofconn::set_state(enum crofconn_state_t new_state) {
       /* stop periodic checks for connection state (OAM) */
       thread.drop_timer(TIMER_ID_NEED_LIFE_CHECK);
 
+      rofsock.clear_rx_passthrough();
       clear_pending_requests();
       clear_pending_segments();
 
@@ -168,10 +173,11 @@ void crofconn::set_state(enum crofconn_state_t new_state) {
       VLOG(2) << __FUNCTION__
               << " STATE_CONNECT_PENDING laddr=" << rofsock.get_laddr().str()
               << " raddr=" << rofsock.get_raddr().str();
+      rofsock.clear_rx_passthrough();
       versionbitmap_peer.clear();
       set_version(rofl::openflow::OFP_VERSION_UNKNOWN);
 
-      for (auto rxqueue : rxqueues) {
+      for (auto &rxqueue : rxqueues) {
         rxqueue.clear();
       }
 
@@ -180,10 +186,11 @@ void crofconn::set_state(enum crofconn_state_t new_state) {
       VLOG(2) << __FUNCTION__
               << " STATE_ACCEPT_PENDING laddr=" << rofsock.get_laddr().str()
               << " raddr=" << rofsock.get_raddr().str();
+      rofsock.clear_rx_passthrough();
       versionbitmap_peer.clear();
       set_version(rofl::openflow::OFP_VERSION_UNKNOWN);
 
-      for (auto rxqueue : rxqueues) {
+      for (auto &rxqueue : rxqueues) {
         rxqueue.clear();
       }
 
@@ -220,6 +227,13 @@ void crofconn::set_state(enum crofconn_state_t new_state) {
       /* start periodic checks for connection state (OAM) */
       thread.add_timer(TIMER_ID_NEED_LIFE_CHECK,
                        ctimespec().expire_in(timeout_lifecheck));
+      {
+        AcquireReadLock lock(rx_passthrough_rwlock);
+        for (unsigned int type = 0; type < rx_passthrough.size(); type++) {
+          if (rx_passthrough[type])
+            rofsock.set_rx_passthrough(type);
+        }
+      }
       crofconn_env::call_env(env).handle_established(*this, ofp_version);
 
     } break;
@@ -644,6 +658,51 @@ void crofconn::echo_request_expired() {
   handle_closed(rofsock);
 }
 
+bool crofconn::get_rx_passthrough(uint8_t type) const {
+  AcquireReadLock lock(rx_passthrough_rwlock);
+  return rx_passthrough[type];
+}
+
+bool crofconn::is_rx_passthrough_allowed(uint8_t type) {
+  switch (type) {
+  case rofl::openflow::OFPT_HELLO:
+  case rofl::openflow::OFPT_ERROR:
+  case rofl::openflow::OFPT_ECHO_REQUEST:
+  case rofl::openflow::OFPT_ECHO_REPLY:
+  case rofl::openflow::OFPT_FEATURES_REQUEST:
+  case rofl::openflow::OFPT_FEATURES_REPLY:
+    return false;
+  default:
+    return true;
+  }
+}
+
+crofconn &crofconn::set_rx_passthrough(uint8_t type, bool passthrough) {
+  if (not is_rx_passthrough_allowed(type)) {
+    throw eRofConnInvalid(
+        "crofconn::set_rx_passthrough() connection management message type")
+        .set_func(__FUNCTION__)
+        .set_file(__FILE__)
+        .set_line(__LINE__)
+        .set_key("type", (int)type);
+  }
+
+  AcquireReadWriteLock lock(rx_passthrough_rwlock);
+  rx_passthrough[type] = passthrough;
+  /* passthrough on the socket is enabled in STATE_ESTABLISHED only */
+  if (STATE_ESTABLISHED == state) {
+    rofsock.set_rx_passthrough(type, passthrough);
+  }
+  return *this;
+}
+
+crofconn &crofconn::clear_rx_passthrough() {
+  AcquireReadWriteLock lock(rx_passthrough_rwlock);
+  rx_passthrough.reset();
+  rofsock.clear_rx_passthrough();
+  return *this;
+}
+
 void crofconn::echo_request_rcvd(rofl::openflow::cofmsg *pmsg) {
   rofl::openflow::cofmsg_echo_request *msg =
       dynamic_cast<rofl::openflow::cofmsg_echo_request *>(pmsg);
@@ -836,6 +895,44 @@ void crofconn::congestion_occured_indication(crofsock &rofsock) {
   crofconn_env::call_env(env).congestion_occured_indication(*this);
 };
 
+void crofconn::handle_recv_frame(crofsock &socket, const cslice &frame) {
+  /* Executed in crofsock's rxthread context like handle_recv(). Frames
+   * bypass the rxqueues and are handed over to the application directly. */
+  const struct rofl::openflow::ofp_header *hdr =
+      (const struct rofl::openflow::ofp_header *)frame.somem();
+
+  if (STATE_ESTABLISHED != get_state()) {
+    VLOG(2) << __FUNCTION__
+            << " frame received in invalid state, dropping state=" << state
+            << " type=" << (int)hdr->type;
+    return;
+  }
+
+  /* sanity check: frame version must match negotiated version */
+  if (hdr->version != ofp_version) {
+    VLOG(2) << __FUNCTION__ << " frame with invalid version received "
+                               "state=STATE_ESTABLISHED rcvd version="
+            << (int)hdr->version << " negotiated version=" << ofp_version;
+
+    send_message(new rofl::openflow::cofmsg_error_bad_request_bad_version(
+        ofp_version, be32toh(hdr->xid), frame.somem(),
+        frame.length() < 64 ? frame.length() : 64));
+    return;
+  }
+
+  try {
+    /* check pending xids */
+    drop_pending_request(be32toh(hdr->xid));
+
+    crofconn_env::call_env(env).handle_recv_frame(*this, frame);
+
+  } catch (eRofConnNotFound &e) {
+    VLOG(1) << __FUNCTION__ << " env not found, dropping frame";
+  } catch (std::runtime_error &e) {
+    VLOG(1) << __FUNCTION__ << " runtime error: " << e.what();
+  }
+}
+
 void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
   /* This method is executed in crofsock's (not crofconn's!) rxthread context.
    * It deals with messages during connection establishment and negotiation
@@ -961,9 +1058,7 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
   try {
 
     /* check pending xids */
-    if (has_pending_request(msg->get_xid())) {
-      drop_pending_request(msg->get_xid());
-    }
+    drop_pending_request(msg->get_xid());
 
     /* Store message in appropriate rxqueue:
      * Strategy: we enforce queueing of successful received messages
@@ -1089,7 +1184,8 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       };
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_PACKET_IN:
       case rofl::openflow13::OFPT_PACKET_OUT: {
@@ -1111,7 +1207,9 @@ void crofconn::handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) {
       case rofl::openflow13::OFPT_MULTIPART_REQUEST:
       case rofl::openflow13::OFPT_MULTIPART_REPLY:
       case rofl::openflow13::OFPT_BARRIER_REQUEST:
-      case rofl::openflow13::OFPT_BARRIER_REPLY: {
+      case rofl::openflow13::OFPT_BARRIER_REPLY:
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL:
+      case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
         rxqueues[QUEUE_FLOW].store(msg, true);
         if (rxqueues[QUEUE_FLOW].capacity() == 0) {
           if (not rofsock.is_rx_disabled()) {
@@ -1287,27 +1385,17 @@ void crofconn::handle_rx_multipart_message(rofl::openflow::cofmsg *msg) {
     // start new or continue pending transaction
     if (stats->get_stats_flags() & rofl::openflow13::OFPMPF_REQ_MORE) {
 
-      set_pending_segment(msg->get_xid(), stats->get_type(),
-                          stats->get_stats_type())
-          .store_and_merge_msg(*msg);
-      delete msg; // delete msg here, we store a copy in the transaction
+      // msg is adopted or merged and destroyed by the pending segment
+      add_pending_segment(msg, stats->get_type(), stats->get_stats_type());
 
       // end pending transaction or multipart message with single message only
     } else {
 
       if (has_pending_segment(msg->get_xid())) {
 
-        set_pending_segment(msg->get_xid(), stats->get_type(),
-                            stats->get_stats_type())
-            .store_and_merge_msg(*msg);
-
-        rofl::openflow::cofmsg *reassembled_msg =
-            set_pending_segment(msg->get_xid()).retrieve_and_detach_msg();
-
-        drop_pending_segment(msg->get_xid());
-
-        delete msg; // delete msg here, we may get an exception from the next
-                    // line
+        // msg is merged and destroyed by the pending segment
+        rofl::openflow::cofmsg *reassembled_msg = retrieve_pending_segment(
+            msg, stats->get_type(), stats->get_stats_type());
 
         crofconn_env::call_env(env).handle_recv(*this, reassembled_msg);
       } else {
@@ -1331,30 +1419,27 @@ void crofconn::handle_rx_multipart_message(rofl::openflow::cofmsg *msg) {
       return;
     }
 
+    // streaming mode: hand over each segment as it arrives
+    if (multipart_streaming) {
+      VLOG(3) << __FUNCTION__ << " call application: " << msg->str().c_str();
+      crofconn_env::call_env(env).handle_recv(*this, msg);
+      return;
+    }
+
     // start new or continue pending transaction
     if (stats->get_stats_flags() & rofl::openflow13::OFPMPF_REQ_MORE) {
 
-      set_pending_segment(msg->get_xid(), stats->get_type(),
-                          stats->get_stats_type())
-          .store_and_merge_msg(*msg);
-      delete msg; // delete msg here, we store a copy in the transaction
+      // msg is adopted or merged and destroyed by the pending segment
+      add_pending_segment(msg, stats->get_type(), stats->get_stats_type());
 
       // end pending transaction or multipart message with single message only
     } else {
 
       if (has_pending_segment(msg->get_xid())) {
 
-        set_pending_segment(msg->get_xid(), stats->get_type(),
-                            stats->get_stats_type())
-            .store_and_merge_msg(*msg);
-
-        rofl::openflow::cofmsg *reassembled_msg =
-            set_pending_segment(msg->get_xid()).retrieve_and_detach_msg();
-
-        drop_pending_segment(msg->get_xid());
-
-        delete msg; // delete msg here, we may get an exception from the next
-                    // line
+        // msg is merged and destroyed by the pending segment
+        rofl::openflow::cofmsg *reassembled_msg = retrieve_pending_segment(
+            msg, stats->get_type(), stats->get_stats_type());
 
         crofconn_env::call_env(env).handle_recv(*this, reassembled_msg);
       } else {
@@ -1368,9 +1453,61 @@ void crofconn::handle_rx_multipart_message(rofl::openflow::cofmsg *msg) {
   }
 }
 
+rofl::crofsock::msg_result_t
+crofconn::send_message(rofl::openflow::cofmsg *msg) {
+  rofl::crofsock::msg_result_t result;
+  try {
+    result = segment_and_send_message(msg);
+  } catch (...) {
+    delete msg;
+    throw;
+  }
+  /* message could not be segmented and is deleted here */
+  if (rofl::crofsock::MSG_IGNORED == result)
+    delete msg;
+  return result;
+}
+
 rofl::crofsock::msg_result_t crofconn::send_message(rofl::openflow::cofmsg *msg,
                                                     const ctimespec &ts) {
+  add_pending_request(msg, ts);
+  return send_message(msg);
+}
+
+rofl::crofsock::msg_result_t
+crofconn::try_send_message(rofl::openflow::cofmsg *&msg) {
+  if (msg->length() <= segmentation_threshold)
+    return rofsock.try_send_message(msg);
 
+  if (not rofsock.is_established())
+    return rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
+
+  try {
+    rofl::crofsock::msg_result_t result = segment_and_send_message(msg);
+    /* msg was replaced by its segments */
+    if (rofl::crofsock::MSG_IGNORED != result)
+      msg = nullptr;
+    return result;
+  } catch (std::exception &e) {
+    VLOG(2) << __FUNCTION__ << " segmentation failed: " << e.what()
+            << " msg: " << msg->str().c_str();
+    return rofl::crofsock::MSG_IGNORED;
+  }
+}
+
+rofl::crofsock::msg_result_t
+crofconn::try_send_message(rofl::openflow::cofmsg *&msg, const ctimespec &ts) {
+  uint32_t xid = msg->get_xid();
+  add_pending_request(msg, ts);
+  rofl::crofsock::msg_result_t result = try_send_message(msg);
+  /* no reply expected for a message not sent */
+  if (msg != nullptr)
+    drop_pending_request(xid);
+  return result;
+}
+
+void crofconn::add_pending_request(const rofl::openflow::cofmsg *msg,
+                                   const ctimespec &ts) {
   switch (msg->get_version()) {
   case rofl::openflow10::OFP_VERSION: {
 
@@ -1378,7 +1515,7 @@ rofl::crofsock::msg_result_t crofconn::send_message(rofl::openflow::cofmsg *msg,
     case rofl::openflow10::OFPT_STATS_REQUEST: {
       add_pending_request(
           msg->get_xid(), ts, msg->get_type(),
-          dynamic_cast<rofl::openflow::cofmsg_stats_request *>(msg)
+          dynamic_cast<const rofl::openflow::cofmsg_stats_request *>(msg)
               ->get_stats_type());
     } break;
     default: { add_pending_request(msg->get_xid(), ts, msg->get_type()); };
@@ -1391,20 +1528,21 @@ rofl::crofsock::msg_result_t crofconn::send_message(rofl::openflow::cofmsg *msg,
     case rofl::openflow12::OFPT_STATS_REQUEST: {
       add_pending_request(
           msg->get_xid(), ts, msg->get_type(),
-          dynamic_cast<rofl::openflow::cofmsg_stats_request *>(msg)
+          dynamic_cast<const rofl::openflow::cofmsg_stats_request *>(msg)
               ->get_stats_type());
     } break;
     default: { add_pending_request(msg->get_xid(), ts, msg->get_type()); };
     }
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     switch (msg->get_type()) {
     case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
       add_pending_request(
           msg->get_xid(), ts, msg->get_type(),
-          dynamic_cast<rofl::openflow::cofmsg_stats_request *>(msg)
+          dynamic_cast<const rofl::openflow::cofmsg_stats_request *>(msg)
               ->get_stats_type());
     } break;
     default: { add_pending_request(msg->get_xid(), ts, msg->get_type()); };
@@ -1413,9 +1551,7 @@ rofl::crofsock::msg_result_t crofconn::send_message(rofl::openflow::cofmsg *msg,
   } break;
   default: {};
   }
-
-  return segment_and_send_message(msg);
-};
+}
 
 rofl::crofsock::msg_result_t
 crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
@@ -1428,6 +1564,9 @@ crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
     msg_result = rofsock.send_message(
         msg); // default behaviour for now: send message directly to rofsock
 
+  } else if (send_packed_segments(msg, msg_result)) {
+    // entries packed directly into wire format segments
+
   } else {
 
     // segment the packet
@@ -1439,33 +1578,17 @@ crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
 
         switch (dynamic_cast<rofl::openflow::cofmsg_stats_reply *>(msg)
                     ->get_stats_type()) {
-        case rofl::openflow12::OFPST_FLOW: {
-          msg_result = segment_flow_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_flow_stats_reply *>(msg));
-        } break;
-        case rofl::openflow12::OFPST_TABLE: {
-          msg_result = segment_table_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_table_stats_reply *>(msg));
-        } break;
         case rofl::openflow12::OFPST_QUEUE: {
           msg_result = segment_queue_stats_reply(
               dynamic_cast<rofl::openflow::cofmsg_queue_stats_reply *>(msg));
         } break;
-        case rofl::openflow12::OFPST_GROUP: {
-          msg_result = segment_group_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_group_stats_reply *>(msg));
-        } break;
-        case rofl::openflow12::OFPST_GROUP_DESC: {
-          msg_result = segment_group_desc_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_group_desc_stats_reply *>(
-                  msg));
-        } break;
         }
 
       } break;
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
 
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
@@ -1484,50 +1607,15 @@ crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
 
         switch (dynamic_cast<rofl::openflow::cofmsg_stats_reply *>(msg)
                     ->get_stats_type()) {
-        case rofl::openflow13::OFPMP_FLOW: {
-          msg_result = segment_flow_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_flow_stats_reply *>(msg));
-        } break;
-        case rofl::openflow13::OFPMP_TABLE: {
-          msg_result = segment_table_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_table_stats_reply *>(msg));
-        } break;
-        case rofl::openflow13::OFPMP_PORT_STATS: {
-          msg_result = segment_port_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_port_stats_reply *>(msg));
-        } break;
         case rofl::openflow13::OFPMP_QUEUE: {
           msg_result = segment_queue_stats_reply(
               dynamic_cast<rofl::openflow::cofmsg_queue_stats_reply *>(msg));
         } break;
-        case rofl::openflow13::OFPMP_GROUP: {
-          msg_result = segment_group_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_group_stats_reply *>(msg));
-        } break;
-        case rofl::openflow13::OFPMP_GROUP_DESC: {
-          msg_result = segment_group_desc_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_group_desc_stats_reply *>(
-                  msg));
-        } break;
         case rofl::openflow13::OFPMP_TABLE_FEATURES: {
           msg_result = segment_table_features_stats_reply(
               dynamic_cast<rofl::openflow::cofmsg_table_features_stats_reply *>(
                   msg));
         } break;
-        case rofl::openflow13::OFPMP_PORT_DESC: {
-          msg_result = segment_port_desc_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_port_desc_stats_reply *>(
-                  msg));
-        } break;
-        case rofl::openflow13::OFPMP_METER: {
-          msg_result = segment_meter_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_meter_stats_reply *>(msg));
-        } break;
-        case rofl::openflow13::OFPMP_METER_CONFIG: {
-          msg_result = segment_meter_config_stats_reply(
-              dynamic_cast<rofl::openflow::cofmsg_meter_config_stats_reply *>(
-                  msg));
-        } break;
         case rofl::openflow13::OFPMP_METER_FEATURES: {
           // no array in meter-features, so no need to segment
           msg_result = rofsock.send_message(
@@ -1545,6 +1633,30 @@ crofconn::segment_and_send_message(rofl::openflow::cofmsg *msg) {
   return msg_result;
 }
 
+bool crofconn::send_packed_segments(rofl::openflow::cofmsg *msg,
+                                    rofl::crofsock::msg_result_t &msg_result) {
+  rofl::openflow::cofmsg_stats_reply *reply =
+      dynamic_cast<rofl::openflow::cofmsg_stats_reply *>(msg);
+  if (nullptr == reply)
+    return false;
+
+  /* msg remains owned by the caller when segmentation fails */
+  std::list<rofl::openflow::cofmsg_packed *> segments;
+  if (not segmenter.segment(*reply, segments))
+    return false;
+
+  /* delete original message */
+  delete msg;
+
+  /* send segments, MORE flags are set already. We return the result
+   * received for the last segment. */
+  for (auto segment : segments) {
+    msg_result = rofsock.send_message(segment, /*enforce-queueing*/ true);
+  }
+
+  return true;
+}
+
 rofl::crofsock::msg_result_t crofconn::segment_table_features_stats_request(
     rofl::openflow::cofmsg_table_features_stats_request *msg) {
   std::list<rofl::openflow::cofmsg_table_features_stats_request *> segments;
@@ -1629,221 +1741,6 @@ rofl::crofsock::msg_result_t crofconn::segment_table_features_stats_reply(
   return msg_result;
 }
 
-rofl::crofsock::msg_result_t crofconn::segment_flow_stats_reply(
-    rofl::openflow::cofmsg_flow_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_flow_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto flowids = msg->get_flow_stats_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not flowids.empty()) {
-    rofl::openflow::cofflowstatsarray array(msg->get_version());
-
-    while ((not flowids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t flowid = flowids.front();
-      flowids.pop_front();
-      array.add_flow_stats(flowid) =
-          msg->get_flow_stats_array().get_flow_stats(flowid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_flow_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_flow_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
-rofl::crofsock::msg_result_t crofconn::segment_group_desc_stats_reply(
-    rofl::openflow::cofmsg_group_desc_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_group_desc_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto groupids = msg->get_group_desc_stats_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not groupids.empty()) {
-    rofl::openflow::cofgroupdescstatsarray array(msg->get_version());
-
-    while ((not groupids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t groupid = groupids.front();
-      groupids.pop_front();
-      array.add_group_desc_stats(groupid) =
-          msg->get_group_desc_stats_array().get_group_desc_stats(groupid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_group_desc_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_group_desc_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
-rofl::crofsock::msg_result_t crofconn::segment_group_stats_reply(
-    rofl::openflow::cofmsg_group_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_group_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto groupids = msg->get_group_stats_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not groupids.empty()) {
-    rofl::openflow::cofgroupstatsarray array(msg->get_version());
-
-    while ((not groupids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t groupid = groupids.front();
-      groupids.pop_front();
-      array.add_group_stats(groupid) =
-          msg->get_group_stats_array().get_group_stats(groupid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_group_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_group_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
-rofl::crofsock::msg_result_t crofconn::segment_table_stats_reply(
-    rofl::openflow::cofmsg_table_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_table_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto tableids = msg->get_table_stats_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not tableids.empty()) {
-    rofl::openflow::coftablestatsarray array(msg->get_version());
-
-    while ((not tableids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t tableid = tableids.front();
-      tableids.pop_front();
-      array.add_table_stats(tableid) =
-          msg->get_table_stats_array().get_table_stats(tableid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_table_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_table_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
-rofl::crofsock::msg_result_t crofconn::segment_port_stats_reply(
-    rofl::openflow::cofmsg_port_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_port_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto portids = msg->get_port_stats_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not portids.empty()) {
-    rofl::openflow::cofportstatsarray array(msg->get_version());
-
-    while ((not portids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t portid = portids.front();
-      portids.pop_front();
-      array.add_port_stats(portid) =
-          msg->get_port_stats_array().get_port_stats(portid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_port_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_port_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
 rofl::crofsock::msg_result_t crofconn::segment_queue_stats_reply(
     rofl::openflow::cofmsg_queue_stats_reply *msg) {
   std::list<rofl::openflow::cofmsg_queue_stats_reply *> segments;
@@ -1889,131 +1786,3 @@ rofl::crofsock::msg_result_t crofconn::segment_queue_stats_reply(
 
   return msg_result;
 }
-
-rofl::crofsock::msg_result_t crofconn::segment_port_desc_stats_reply(
-    rofl::openflow::cofmsg_port_desc_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_port_desc_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto portids = msg->get_ports().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not portids.empty()) {
-    rofl::openflow::cofports ports(msg->get_version());
-
-    while ((not portids.empty()) && (ports.length() < MAX_LENGTH)) {
-      uint32_t portid = portids.front();
-      portids.pop_front();
-      ports.add_port(portid) = msg->get_ports().get_port(portid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_port_desc_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), ports));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_port_desc_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
-rofl::crofsock::msg_result_t crofconn::segment_meter_stats_reply(
-    rofl::openflow::cofmsg_meter_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_meter_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto meterids = msg->get_meter_stats_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not meterids.empty()) {
-    rofl::openflow::cofmeterstatsarray array(msg->get_version());
-
-    while ((not meterids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t meterid = meterids.front();
-      meterids.pop_front();
-      array.add_meter_stats(meterid) =
-          msg->get_meter_stats_array().get_meter_stats(meterid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_meter_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_meter_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
-
-rofl::crofsock::msg_result_t crofconn::segment_meter_config_stats_reply(
-    rofl::openflow::cofmsg_meter_config_stats_reply *msg) {
-  std::list<rofl::openflow::cofmsg_meter_config_stats_reply *> segments;
-  const int MAX_LENGTH = 64000 /*bytes*/;
-  auto meterids = msg->get_meter_config_array().keys();
-  rofl::crofsock::msg_result_t msg_result = rofl::crofsock::MSG_QUEUED;
-
-  /* create fragments */
-  while (not meterids.empty()) {
-    rofl::openflow::cofmeterconfigarray array(msg->get_version());
-
-    while ((not meterids.empty()) && (array.length() < MAX_LENGTH)) {
-      uint32_t meterid = meterids.front();
-      meterids.pop_front();
-      array.add_meter_config(meterid) =
-          msg->get_meter_config_array().get_meter_config(meterid);
-    }
-
-    segments.push_back(new rofl::openflow::cofmsg_meter_config_stats_reply(
-        msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
-  }
-
-  /* delete original message */
-  delete msg;
-
-  /* send fragments */
-  while (not segments.empty()) {
-    rofl::openflow::cofmsg_meter_config_stats_reply *msg = segments.front();
-    segments.pop_front();
-    // set MORE flag on all segments except last one
-    if (not segments.empty()) {
-      msg->set_stats_flags(msg->get_stats_flags() |
-                           rofl::openflow13::OFPMPF_REPLY_MORE);
-    }
-    /* when enforcing queueing, there are only two return values possible:
-     * MSQ_QUEUED and MSG_QUEUED_CONGESTION. We return the result received for
-     * the last fragment. */
-    msg_result = rofsock.send_message(msg, /*enforce-queueing*/ true);
-  }
-
-  return msg_result;
-}
@@ -19,11 +19,13 @@
 #include <set>
 
 #include "rofl/common/cauxid.h"
+#include "rofl/common/cenvs.hpp"
 #include "rofl/common/crandom.h"
 #include "rofl/common/crofqueue.h"
 #include "rofl/common/crofsock.h"
-#include "rofl/common/csegment.hpp"
+#include "rofl/common/csegments.hpp"
 #include "rofl/common/cthread.hpp"
+#include "rofl/common/ctransactions.hpp"
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/cofhelloelems.h"
 #include "rofl/common/openflow/cofhelloelemversionbitmap.h"
@@ -62,10 +64,9 @@ class crofconn_env {
   friend class crofconn;
 
 public:
-  static crofconn_env &call_env(crofconn_env *env) {
-    AcquireReadLock lock(crofconn_env::connection_envs_lock);
-    if (crofconn_env::connection_envs.find(env) ==
-        crofconn_env::connection_envs.end()) {
+  static crofconn_env &call_env(crofconn_env *env,
+                                chazard::guard &&guard = chazard::guard()) {
+    if (not crofconn_env::connection_envs.protect(env, guard)) {
       throw eRofConnNotFound(
           "crofconn_env::call_env() crofconn_env instance not found")
           .set_func(__FUNCTION__)
@@ -77,15 +78,18 @@ public:
 
 public:
   virtual ~crofconn_env() {
-    AcquireReadWriteLock lock(crofconn_env::connection_envs_lock);
-    crofconn_env::connection_envs.erase(this);
+    crofconn_env::connection_envs.drop(this);
   };
   crofconn_env() {
-    AcquireReadWriteLock lock(crofconn_env::connection_envs_lock);
-    crofconn_env::connection_envs.insert(this);
+    crofconn_env::connection_envs.add(this);
   };
 
 protected:
+  /**
+   * @brief	Deregisters this instance, see cenvs::drop()
+   */
+  void drop_env() { crofconn_env::connection_envs.drop(this); };
+
   virtual void handle_established(crofconn &conn, uint8_t ofp_version) = 0;
 
   virtual void handle_connect_refused(crofconn &conn) = 0;
@@ -100,6 +104,17 @@ protected:
 
   virtual void handle_recv(crofconn &conn, rofl::openflow::cofmsg *msg) = 0;
 
+  /**
+   * @brief	Called for received messages with a passthrough type
+   *
+   * See crofconn::set_rx_passthrough(). Executed in the receiving
+   * socket's thread, the rxqueues are bypassed. The default hands over
+   * frame as cofmsg_frame to handle_recv().
+   */
+  virtual void handle_recv_frame(crofconn &conn, const cslice &frame) {
+    handle_recv(conn, new rofl::openflow::cofmsg_frame(frame));
+  };
+
   virtual void congestion_occured_indication(crofconn &conn) = 0;
 
   virtual void congestion_solved_indication(crofconn &conn) = 0;
@@ -109,8 +124,7 @@ protected:
                                           uint16_t sub_type = 0) = 0;
 
 private:
-  static std::set<crofconn_env *> connection_envs;
-  static crwlock connection_envs_lock;
+  static cenvs<crofconn_env> connection_envs;
 };
 
 /**
@@ -261,9 +275,7 @@ public:
   /**
    * @brief	Send OFP message via socket
    */
-  rofl::crofsock::msg_result_t send_message(rofl::openflow::cofmsg *msg) {
-    return segment_and_send_message(msg);
-  };
+  rofl::crofsock::msg_result_t send_message(rofl::openflow::cofmsg *msg);
 
   /**
    * @brief	Send OFP message via socket with expiration timer
@@ -271,6 +283,30 @@ public:
   rofl::crofsock::msg_result_t send_message(rofl::openflow::cofmsg *msg,
                                             const ctimespec &ts);
 
+  /**
+   * @brief	Send OFP message via socket without throwing
+   *
+   * On success msg is set to nullptr. On failure msg remains owned by
+   * the caller. A message exceeding the segmentation threshold is replaced
+   * by its segments. If its type cannot be segmented or segmentation
+   * fails, MSG_IGNORED is returned and msg remains owned by the caller.
+   */
+  rofl::crofsock::msg_result_t try_send_message(rofl::openflow::cofmsg *&msg);
+
+  /**
+   * @brief	Send OFP message with expiration timer without throwing
+   */
+  rofl::crofsock::msg_result_t try_send_message(rofl::openflow::cofmsg *&msg,
+                                                const ctimespec &ts);
+
+  /**
+   * @brief	Send a received wire frame with a new xid, see
+   * rofl::crofsock::send_frame()
+   */
+  rofl::crofsock::msg_result_t send_frame(const cslice &frame, uint32_t xid) {
+    return rofsock.send_frame(frame, xid);
+  };
+
 public:
   /**
    * @brief	Returns a reference to the versionbitmap announced by this
@@ -354,6 +390,13 @@ public:
     return rofsock.get_txqueue_max_size();
   };
 
+  /**
+   * @brief	Returns number of messages waiting in transmission queues
+   */
+  size_t get_txqueue_pending_pkts() const {
+    return rofsock.get_txqueue_pending_pkts();
+  };
+
   /**
    * @brief	Sets capacity of transmission queues in messages
    */
@@ -572,6 +615,14 @@ public:
     return *this;
   };
 
+public:
+  /**
+   * @brief	Returns segmenter for outgoing multipart replies and its counters
+   */
+  const rofl::openflow::cofmsg_segmenter &get_segmenter() const {
+    return segmenter;
+  };
+
 public:
   /**
    *
@@ -588,6 +639,68 @@ public:
     return *this;
   };
 
+  /**
+   *
+   */
+  bool get_multipart_streaming() const { return multipart_streaming; };
+
+  /**
+   * @brief	Enables/disables streaming of multipart replies
+   *
+   * By default, all segments of a multipart reply are reassembled and the
+   * application receives a single message once the last segment has
+   * arrived. In streaming mode, each segment of a multipart reply is
+   * handed over to the application as it arrives. All segments except
+   * the last one carry the OFPMPF_REPLY_MORE flag, so at most one segment
+   * is held in memory. Multipart requests are always reassembled.
+   */
+  crofconn &set_multipart_streaming(bool multipart_streaming) {
+    this->multipart_streaming = multipart_streaming;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when received messages are decoded lazily
+   */
+  bool get_rx_lazy_decoding() const { return rofsock.get_rx_lazy_decoding(); };
+
+  /**
+   * @brief	Enables/disables lazy decoding of received messages, see
+   * rofl::crofsock::set_rx_lazy_decoding()
+   */
+  crofconn &set_rx_lazy_decoding(bool rx_lazy_decoding) {
+    rofsock.set_rx_lazy_decoding(rx_lazy_decoding);
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when messages of type are passed through
+   */
+  bool get_rx_passthrough(uint8_t type) const;
+
+  /**
+   * @brief	Enables or disables passthrough for messages of type
+   *
+   * Received messages of a passthrough type are not decoded and handed
+   * over to crofconn_env::handle_recv_frame(), see
+   * rofl::crofsock::set_rx_passthrough(). The setting becomes active
+   * once the connection is established and is suspended while it is
+   * down. Types required for connection management (Hello, Error,
+   * Echo-Request/-Reply, Features-Request/-Reply) are rejected with
+   * eRofConnInvalid.
+   */
+  crofconn &set_rx_passthrough(uint8_t type, bool passthrough = true);
+
+  /**
+   * @brief	Disables passthrough for all message types
+   */
+  crofconn &clear_rx_passthrough();
+
+  /**
+   * @brief	Returns false for types required for connection management
+   */
+  static bool is_rx_passthrough_allowed(uint8_t type);
+
   friend std::ostream &operator<<(std::ostream &os, const crofconn &conn) {
     os << "<crofconn ofp-version: " << (int)conn.ofp_version
        << " openflow-connection-established: " << conn.is_established()
@@ -694,6 +807,8 @@ private:
 
   virtual void handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg);
 
+  virtual void handle_recv_frame(crofsock &socket, const cslice &frame);
+
   virtual void congestion_occured_indication(crofsock &socket);
 
   virtual void congestion_solved_indication(crofsock &rofsock);
@@ -740,34 +855,26 @@ private:
 
 private:
   /**
+   * @brief	Sends msg, segmented if it exceeds the segmentation threshold
    *
+   * msg is consumed unless MSG_IGNORED is returned, i.e. its type cannot be
+   * segmented, or an exception is thrown during segmentation.
    */
   rofl::crofsock::msg_result_t
   segment_and_send_message(rofl::openflow::cofmsg *msg);
 
   /**
-   *
+   * @brief	Packs entries of a multipart reply directly into segments and
+   * sends them, returns false if msg must be segmented otherwise
    */
-  rofl::crofsock::msg_result_t segment_table_features_stats_request(
-      rofl::openflow::cofmsg_table_features_stats_request *msg);
-
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t
-  segment_flow_stats_reply(rofl::openflow::cofmsg_flow_stats_reply *msg);
-
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t
-  segment_table_stats_reply(rofl::openflow::cofmsg_table_stats_reply *msg);
+  bool send_packed_segments(rofl::openflow::cofmsg *msg,
+                            rofl::crofsock::msg_result_t &msg_result);
 
   /**
    *
    */
-  rofl::crofsock::msg_result_t
-  segment_port_stats_reply(rofl::openflow::cofmsg_port_stats_reply *msg);
+  rofl::crofsock::msg_result_t segment_table_features_stats_request(
+      rofl::openflow::cofmsg_table_features_stats_request *msg);
 
   /**
    *
@@ -775,110 +882,13 @@ private:
   rofl::crofsock::msg_result_t
   segment_queue_stats_reply(rofl::openflow::cofmsg_queue_stats_reply *msg);
 
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t
-  segment_group_stats_reply(rofl::openflow::cofmsg_group_stats_reply *msg);
-
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t segment_group_desc_stats_reply(
-      rofl::openflow::cofmsg_group_desc_stats_reply *msg);
-
   /**
    *
    */
   rofl::crofsock::msg_result_t segment_table_features_stats_reply(
       rofl::openflow::cofmsg_table_features_stats_reply *msg);
 
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t segment_port_desc_stats_reply(
-      rofl::openflow::cofmsg_port_desc_stats_reply *msg);
-
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t
-  segment_meter_stats_reply(rofl::openflow::cofmsg_meter_stats_reply *msg);
-
-  /**
-   *
-   */
-  rofl::crofsock::msg_result_t segment_meter_config_stats_reply(
-      rofl::openflow::cofmsg_meter_config_stats_reply *msg);
-
 private:
-  /**
-   *
-   */
-  class ctransaction {
-  public:
-    uint32_t xid;
-    ctimespec tspec;
-    uint8_t type;
-    uint16_t subtype;
-
-  public:
-    /**
-     *
-     */
-    ctransaction() : xid(0), type(0), subtype(0){};
-
-    /**
-     *
-     */
-    ctransaction(uint32_t xid, const ctimespec tspec, uint8_t type,
-                 uint16_t subtype = 0)
-        : xid(xid), tspec(tspec), type(type), subtype(subtype){};
-
-    /**
-     *
-     */
-    ctransaction(const ctransaction &ta) { *this = ta; };
-
-    /**
-     *
-     */
-    ctransaction &operator=(const ctransaction &ta) {
-      if (this == &ta)
-        return *this;
-      xid = ta.xid;
-      tspec = ta.tspec;
-      type = ta.type;
-      subtype = ta.subtype;
-      return *this;
-    };
-
-    /**
-     *
-     */
-    bool operator<(const ctransaction &ta) const { return (tspec < ta.tspec); };
-
-  public:
-    uint32_t get_xid() const { return xid; };
-
-    uint8_t get_type() const { return type; };
-
-    uint16_t get_subtype() const { return subtype; };
-
-    const ctimespec &get_tspec() const { return tspec; };
-
-  public:
-    class ctransaction_find_by_xid {
-      uint32_t xid;
-
-    public:
-      ctransaction_find_by_xid(uint32_t xid) : xid(xid){};
-      bool operator()(const ctransaction &ta) const {
-        return (ta.get_xid() == xid);
-      };
-    };
-  };
-
   /**
    *
    */
@@ -894,31 +904,23 @@ private:
   void add_pending_request(uint32_t xid, const ctimespec &ts, uint8_t type,
                            uint16_t sub_type = 0) {
     AcquireReadWriteLock rwlock(pending_requests_rwlock);
-    if (not pending_requests.empty()) {
-      uint32_t xid_first = pending_requests.begin()->get_xid();
-      pending_requests.insert(ctransaction(xid, ts, type, sub_type));
-      const ctransaction &ta_first = *(pending_requests.begin());
-      if (xid_first != ta_first.get_xid()) {
-        thread.add_timer(TIMER_ID_PENDING_REQUESTS, ta_first.tspec);
-      }
-    } else {
-      pending_requests.insert(ctransaction(xid, ts, type, sub_type));
-      thread.add_timer(TIMER_ID_PENDING_REQUESTS,
-                       pending_requests.begin()->tspec);
+    if (pending_requests.add(ctransaction(xid, ts, type, sub_type))) {
+      thread.add_timer(TIMER_ID_PENDING_REQUESTS, ts);
     }
   };
 
   /**
    *
    */
-  void drop_pending_request(uint32_t xid) {
+  void add_pending_request(const rofl::openflow::cofmsg *msg,
+                           const ctimespec &ts);
+
+  /**
+   *
+   */
+  bool drop_pending_request(uint32_t xid) {
     AcquireReadWriteLock rwlock(pending_requests_rwlock);
-    std::set<ctransaction>::iterator it;
-    while ((it = find_if(pending_requests.begin(), pending_requests.end(),
-                         ctransaction::ctransaction_find_by_xid(xid))) !=
-           pending_requests.end()) {
-      pending_requests.erase(it);
-    }
+    return pending_requests.drop(xid);
   };
 
   /**
@@ -926,13 +928,7 @@ private:
    */
   bool has_pending_request(uint32_t xid) const {
     AcquireReadLock rlock(pending_requests_rwlock);
-    std::set<ctransaction>::iterator it;
-    if ((it = find_if(pending_requests.begin(), pending_requests.end(),
-                      ctransaction::ctransaction_find_by_xid(xid))) !=
-        pending_requests.end()) {
-      return true;
-    }
-    return false;
+    return pending_requests.has(xid);
   };
 
   /**
@@ -943,15 +939,13 @@ private:
       ctransaction ta;
       {
         AcquireReadWriteLock rwlock(pending_requests_rwlock);
-        if (pending_requests.empty()) {
-          return;
-        }
-        ta = *(pending_requests.begin());
-        if (not ta.get_tspec().is_expired()) {
-          thread.add_timer(TIMER_ID_PENDING_REQUESTS, ta.get_tspec());
+        if (not pending_requests.pop_expired(ta)) {
+          ctimespec tspec;
+          if (pending_requests.get_next_expiry(tspec)) {
+            thread.add_timer(TIMER_ID_PENDING_REQUESTS, tspec);
+          }
           return;
         }
-        pending_requests.erase(pending_requests.begin());
       } // release rwlock
       try {
         crofconn_env::call_env(env).handle_transaction_timeout(
@@ -973,90 +967,52 @@ private:
   };
 
   /**
-   *
+   * @brief	Appends a multipart segment to its pending message, takes
+   * ownership of msg
    */
-  csegment &add_pending_segment(uint32_t xid, uint8_t msg_type,
-                                uint16_t msg_multipart_type) {
+  void add_pending_segment(rofl::openflow::cofmsg *msg, uint8_t msg_type,
+                           uint16_t msg_multipart_type) {
     AcquireReadWriteLock rwlock(pending_segments_rwlock);
-    if (not(pending_segments.size() < pending_segments_max)) {
+    if ((not pending_segments.has(msg->get_xid())) &&
+        (not(pending_segments.size() < pending_segments_max))) {
+      delete msg;
       throw eRofConnInvalid("crofconn::add_pending_segment() too many segments "
                             "in transit, dropping")
           .set_func(__FUNCTION__)
           .set_file(__FILE__)
           .set_line(__LINE__);
     }
-    pending_segments[xid] =
-        csegment(xid, ctimespec().expire_in(timeout_segments), msg_type,
-                 msg_multipart_type);
-    if (not thread.has_timer(TIMER_ID_PENDING_SEGMENTS)) {
-      thread.add_timer(TIMER_ID_PENDING_SEGMENTS,
-                       ctimespec().expire_in(timeout_segments));
-    }
-    return pending_segments[xid];
-  };
-
-  /**
-   *
-   */
-  csegment &set_pending_segment(uint32_t xid, uint8_t msg_type,
-                                uint16_t msg_multipart_type) {
-    AcquireReadWriteLock rwlock(pending_segments_rwlock);
-    if (not(pending_segments.size() < pending_segments_max)) {
-      throw eRofConnInvalid("crofconn::set_pending_segment() too many segments "
-                            "in transit, dropping")
-          .set_func(__FUNCTION__)
-          .set_file(__FILE__)
-          .set_line(__LINE__);
-    }
-    if (pending_segments.find(xid) == pending_segments.end()) {
-      pending_segments[xid] =
-          csegment(xid, ctimespec().expire_in(timeout_segments), msg_type,
-                   msg_multipart_type);
+    ctimespec tspec = ctimespec().expire_in(timeout_segments);
+    bool first = pending_segments.empty();
+    pending_segments
+        .add(msg->get_xid(), tspec, msg_type, msg_multipart_type)
+        .store_and_merge_msg(msg);
+    if (first) {
+      thread.add_timer(TIMER_ID_PENDING_SEGMENTS, tspec);
     }
-    if (not thread.has_timer(TIMER_ID_PENDING_SEGMENTS)) {
-      thread.add_timer(TIMER_ID_PENDING_SEGMENTS,
-                       ctimespec().expire_in(timeout_segments));
-    }
-    return pending_segments[xid];
   };
 
   /**
-   *
+   * @brief	Appends the final multipart segment to its pending message,
+   * takes ownership of msg and returns the reassembled message
    */
-  csegment &set_pending_segment(uint32_t xid) {
+  rofl::openflow::cofmsg *
+  retrieve_pending_segment(rofl::openflow::cofmsg *msg, uint8_t msg_type,
+                           uint16_t msg_multipart_type) {
     AcquireReadWriteLock rwlock(pending_segments_rwlock);
-    if (not(pending_segments.size() < pending_segments_max)) {
-      throw eRofConnInvalid("crofconn::set_pending_segment() too many segments "
-                            "in transit, dropping")
-          .set_func(__FUNCTION__)
-          .set_file(__FILE__)
-          .set_line(__LINE__);
-    }
-    if (pending_segments.find(xid) == pending_segments.end()) {
-      throw eRofConnNotFound("crofconn::set_pending_segment() xid not found")
-          .set_func(__FUNCTION__)
-          .set_file(__FILE__)
-          .set_line(__LINE__);
-    }
-    if (not thread.has_timer(TIMER_ID_PENDING_SEGMENTS)) {
-      thread.add_timer(TIMER_ID_PENDING_SEGMENTS,
-                       ctimespec().expire_in(timeout_segments));
-    }
-    return pending_segments[xid];
-  };
-
-  /**
-   *
-   */
-  const csegment &get_pending_segment(uint32_t xid) const {
-    AcquireReadLock rlock(pending_segments_rwlock);
-    if (pending_segments.find(xid) == pending_segments.end()) {
-      throw eRofConnNotFound("crofconn::get_pending_segment() xid not found")
-          .set_func(__FUNCTION__)
-          .set_file(__FILE__)
-          .set_line(__LINE__);
+    uint32_t xid = msg->get_xid();
+    csegment &segment = pending_segments.add(
+        xid, ctimespec().expire_in(timeout_segments), msg_type,
+        msg_multipart_type);
+    try {
+      segment.store_and_merge_msg(msg);
+    } catch (...) {
+      pending_segments.drop(xid);
+      throw;
     }
-    return pending_segments.at(xid);
+    rofl::openflow::cofmsg *reassembled = segment.retrieve_and_detach_msg();
+    pending_segments.drop(xid);
+    return reassembled;
   };
 
   /**
@@ -1064,11 +1020,7 @@ private:
    */
   bool drop_pending_segment(uint32_t xid) {
     AcquireReadWriteLock rwlock(pending_segments_rwlock);
-    if (pending_segments.find(xid) == pending_segments.end()) {
-      return false;
-    }
-    pending_segments.erase(xid);
-    return true;
+    return pending_segments.drop(xid);
   };
 
   /**
@@ -1076,7 +1028,7 @@ private:
    */
   bool has_pending_segment(uint32_t xid) const {
     AcquireReadLock rlock(pending_segments_rwlock);
-    return (not(pending_segments.find(xid) == pending_segments.end()));
+    return pending_segments.has(xid);
   };
 
   /**
@@ -1084,15 +1036,13 @@ private:
    */
   void check_pending_segments() {
     AcquireReadWriteLock rwlock(pending_segments_rwlock);
-    std::map<uint32_t, csegment>::iterator it;
-    while ((it = find_if(pending_segments.begin(), pending_segments.end(),
-                         csegment::csegment_is_expired())) !=
-           pending_segments.end()) {
-      pending_segments.erase(it);
+    csegment segment;
+    while (pending_segments.pop_expired(segment)) {
+      // incomplete message is destroyed with the next popped segment
     }
-    if (not pending_segments.empty()) {
-      thread.add_timer(TIMER_ID_PENDING_SEGMENTS,
-                       ctimespec().expire_in(timeout_segments));
+    ctimespec tspec;
+    if (pending_segments.get_next_expiry(tspec)) {
+      thread.add_timer(TIMER_ID_PENDING_SEGMENTS, tspec);
     }
   };
 
@@ -1139,6 +1089,12 @@ private:
   // hello lock
   rofl::crwlock hello_lock;
 
+  // message types passed through once established
+  std::bitset<256> rx_passthrough;
+
+  // rwlock for rx_passthrough
+  rofl::crwlock rx_passthrough_rwlock;
+
   // relative scheduling weights for rxqueues
   std::vector<unsigned int> rxweights;
 
@@ -1161,6 +1117,9 @@ private:
   // default segmentation threshold: 65535 bytes
   static const unsigned int DEFAULT_SEGMENTATION_THRESHOLD;
 
+  // packs multipart replies exceeding the threshold into segments
+  rofl::openflow::cofmsg_segmenter segmenter;
+
   // timeout value for HELLO messages
   time_t timeout_hello;
   static const time_t DEFAULT_HELLO_TIMEOUT;
@@ -1177,8 +1136,8 @@ private:
   time_t timeout_lifecheck;
   static const time_t DEFAULT_LIFECHECK_TIMEOUT;
 
-  // set of pending requests
-  std::set<ctransaction> pending_requests;
+  // pending requests by xid and expiry
+  ctransactions pending_requests;
 
   // .. and associated rwlock
   crwlock pending_requests_rwlock;
@@ -1193,7 +1152,7 @@ private:
   uint32_t xid_echo_request_last;
 
   // set of pending OpenFlow message segments
-  std::map<uint32_t, csegment> pending_segments;
+  csegments pending_segments;
 
   // ... and associated rwlock
   crwlock pending_segments_rwlock;
@@ -1205,6 +1164,9 @@ private:
   // maximum number of pending segments in parallel
   unsigned int pending_segments_max;
   static const unsigned int DEFAULT_PENDING_SEGMENTS_MAX;
+
+  // hand over multipart reply segments without reassembly
+  std::atomic_bool multipart_streaming;
 };
 
 }; /* namespace rofl */
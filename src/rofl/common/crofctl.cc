@@ -15,10 +15,12 @@
 
 using namespace rofl;
 
-/*static*/ std::set<crofctl_env *> crofctl_env::rofctl_envs;
-/*static*/ crwlock crofctl_env::rofctl_envs_lock;
+/*static*/ cenvs<crofctl_env> crofctl_env::rofctl_envs;
 
-crofctl::~crofctl(){};
+crofctl::~crofctl() {
+  /* wait for upcalls from rofchan in progress */
+  drop_env();
+};
 
 crofctl::crofctl(crofctl_env *env, const cctlid &ctlid)
     : env(env), ctlid(ctlid), rofchan(this), xid_last(random.uint32()),
@@ -28,6 +30,50 @@ crofctl::crofctl(crofctl_env *env, const cctlid &ctlid)
   async_config = get_async_config_role_default_template();
 };
 
+void crofctl::handle_recv_frame(crofchan &chan, crofconn &conn,
+                                const rofl::cslice &frame) {
+  const struct rofl::openflow::ofp_header *hdr =
+      (const struct rofl::openflow::ofp_header *)frame.somem();
+  try {
+    /* enforce role as for decoded messages, no roles in OFP1.0 */
+    if (hdr->version >= rofl::openflow12::OFP_VERSION) {
+      switch (hdr->type) {
+      case rofl::openflow13::OFPT_GET_CONFIG_REQUEST:
+      case rofl::openflow13::OFPT_SET_CONFIG:
+      case rofl::openflow13::OFPT_PACKET_OUT:
+      case rofl::openflow13::OFPT_FLOW_MOD:
+      case rofl::openflow13::OFPT_GROUP_MOD:
+      case rofl::openflow13::OFPT_PORT_MOD:
+      case rofl::openflow13::OFPT_TABLE_MOD:
+      case rofl::openflow13::OFPT_METER_MOD:
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL:
+      case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+        check_role();
+      } break;
+      default: {};
+      }
+    }
+
+    crofctl_env::call_env(env).handle_recv_frame(*this, conn.get_auxid(),
+                                                 frame);
+
+  } catch (eRofCtlNotFound &e) {
+
+    VLOG(1) << e.what();
+
+  } catch (eBadRequestIsSlave &e) {
+
+    VLOG(1) << __FUNCTION__ << " frame type: " << (int)hdr->type
+            << " error: " << e.what();
+
+    rofchan.send_message(
+        conn.get_auxid(),
+        new rofl::openflow::cofmsg_error_bad_request_is_slave(
+            rofchan.get_version(), be32toh(hdr->xid), frame.somem(),
+            frame.length() < 64 ? frame.length() : 64));
+  }
+}
+
 void crofctl::handle_recv(crofchan &chan, crofconn &conn,
                           rofl::openflow::cofmsg *msg) {
   try {
@@ -367,7 +413,8 @@ void crofctl::handle_recv(crofchan &chan, crofconn &conn,
       default: {};
       }
     } break;
-    case openflow13::OFP_VERSION: {
+    case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION: {
 
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_EXPERIMENTER: {
@@ -614,6 +661,18 @@ void crofctl::handle_recv(crofchan &chan, crofconn &conn,
             *this, conn.get_auxid(),
             dynamic_cast<rofl::openflow::cofmsg_meter_mod &>(*msg));
       } break;
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+        check_role();
+        crofctl_env::call_env(env).handle_bundle_control_request(
+            *this, conn.get_auxid(),
+            dynamic_cast<rofl::openflow::cofmsg_bundle_control &>(*msg));
+      } break;
+      case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+        check_role();
+        crofctl_env::call_env(env).handle_bundle_add_message(
+            *this, conn.get_auxid(),
+            dynamic_cast<rofl::openflow::cofmsg_bundle_add_message &>(*msg));
+      } break;
       default: {};
       }
     } break;
@@ -2155,7 +2214,8 @@ void crofctl::handle_transaction_timeout(crofchan &chan, crofconn &conn,
       }
 
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (type) {
       case rofl::openflow13::OFPT_EXPERIMENTER: {
         crofctl_env::call_env(env).handle_experimenter_timeout(*this, xid);
@@ -2552,33 +2612,8 @@ rofl::crofsock::msg_result_t crofctl::send_packet_in_message(
     const rofl::openflow::cofmatch &match, uint8_t *data, size_t datalen) {
   rofl::openflow::cofmsg *msg = nullptr;
   try {
-    switch (rofchan.get_version()) {
-    case rofl::openflow12::OFP_VERSION: {
-      if (is_slave()) {
-        return rofl::crofsock::MSG_IGNORED;
-      }
-    } break;
-    case rofl::openflow13::OFP_VERSION: {
-      switch (role.get_role()) {
-      case rofl::openflow13::OFPCR_ROLE_EQUAL:
-      case rofl::openflow13::OFPCR_ROLE_MASTER: {
-        if (not(async_config.get_packet_in_mask_master() & (1 << reason))) {
-          return rofl::crofsock::MSG_IGNORED;
-        }
-      } break;
-      case rofl::openflow13::OFPCR_ROLE_SLAVE: {
-        if (not(async_config.get_packet_in_mask_slave() & (1 << reason))) {
-          return rofl::crofsock::MSG_IGNORED;
-        }
-      } break;
-      default: {
-        // unknown role: send packet-in to controller
-      };
-      }
-    } break;
-    default: {
-      // send packet-in
-    };
+    if (is_packet_in_masked(reason)) {
+      return rofl::crofsock::MSG_IGNORED;
     }
 
     msg = new rofl::openflow::cofmsg_packet_in(
@@ -2618,6 +2653,28 @@ rofl::crofsock::msg_result_t crofctl::send_barrier_reply(const cauxid &auxid,
   }
 }
 
+rofl::crofsock::msg_result_t
+crofctl::send_bundle_control_reply(const cauxid &auxid, uint32_t xid,
+                                   uint32_t bundle_id, uint16_t ctrl_type,
+                                   uint16_t flags) {
+  rofl::openflow::cofmsg *msg = nullptr;
+  try {
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        rofchan.get_version(), xid, bundle_id, ctrl_type, flags);
+
+    return rofchan.send_message(auxid, msg);
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping message " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
 rofl::crofsock::msg_result_t
 crofctl::send_role_reply(const cauxid &auxid, uint32_t xid,
                          const rofl::openflow::cofrole &role) {
@@ -2693,33 +2750,8 @@ rofl::crofsock::msg_result_t crofctl::send_flow_removed_message(
     uint64_t packet_count, uint64_t byte_count) {
   rofl::openflow::cofmsg *msg = nullptr;
   try {
-    switch (rofchan.get_version()) {
-    case rofl::openflow12::OFP_VERSION: {
-      if (is_slave()) {
-        return rofl::crofsock::MSG_IGNORED;
-      }
-    } break;
-    case rofl::openflow13::OFP_VERSION: {
-      switch (role.get_role()) {
-      case rofl::openflow13::OFPCR_ROLE_EQUAL:
-      case rofl::openflow13::OFPCR_ROLE_MASTER: {
-        if (not(async_config.get_flow_removed_mask_master() & (1 << reason))) {
-          return rofl::crofsock::MSG_IGNORED;
-        }
-      } break;
-      case rofl::openflow13::OFPCR_ROLE_SLAVE: {
-        if (not(async_config.get_flow_removed_mask_slave() & (1 << reason))) {
-          return rofl::crofsock::MSG_IGNORED;
-        }
-      } break;
-      default: {
-        // unknown role: send flow-removed to controller
-      };
-      }
-    } break;
-    default: {
-      // send flow-removed
-    };
+    if (is_flow_removed_masked(reason)) {
+      return rofl::crofsock::MSG_IGNORED;
     }
 
     msg = new rofl::openflow::cofmsg_flow_removed(
@@ -2740,6 +2772,54 @@ rofl::crofsock::msg_result_t crofctl::send_flow_removed_message(
   }
 }
 
+rofl::crofsock::msg_result_t crofctl::try_send_packet_in_message(
+    const cauxid &auxid, uint32_t buffer_id, uint16_t total_len, uint8_t reason,
+    uint8_t table_id, uint64_t cookie,
+    uint16_t in_port, // for OF 1.0
+    const rofl::openflow::cofmatch &match, uint8_t *data, size_t datalen,
+    rofl::openflow::cofmsg **unsent) {
+  if (is_packet_in_masked(reason)) {
+    return rofl::crofsock::MSG_IGNORED;
+  }
+
+  rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg_packet_in(
+      rofchan.get_version(), ++xid_last, buffer_id, total_len, reason,
+      table_id, cookie, in_port, /* in_port for OF1.0 */
+      match, data, datalen);
+
+  rofl::crofsock::msg_result_t result = rofchan.try_send_message(auxid, msg);
+  if (unsent != nullptr) {
+    *unsent = msg;
+  } else {
+    delete msg;
+  }
+  return result;
+}
+
+rofl::crofsock::msg_result_t crofctl::try_send_flow_removed_message(
+    const cauxid &auxid, const rofl::openflow::cofmatch &match, uint64_t cookie,
+    uint16_t priority, uint8_t reason, uint8_t table_id, uint32_t duration_sec,
+    uint32_t duration_nsec, uint16_t idle_timeout, uint16_t hard_timeout,
+    uint64_t packet_count, uint64_t byte_count,
+    rofl::openflow::cofmsg **unsent) {
+  if (is_flow_removed_masked(reason)) {
+    return rofl::crofsock::MSG_IGNORED;
+  }
+
+  rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg_flow_removed(
+      rofchan.get_version(), ++xid_last, cookie, priority, reason, table_id,
+      duration_sec, duration_nsec, idle_timeout, hard_timeout, packet_count,
+      byte_count, match);
+
+  rofl::crofsock::msg_result_t result = rofchan.try_send_message(auxid, msg);
+  if (unsent != nullptr) {
+    *unsent = msg;
+  } else {
+    delete msg;
+  }
+  return result;
+}
+
 rofl::crofsock::msg_result_t
 crofctl::send_port_status_message(const cauxid &auxid, uint8_t reason,
                                   const rofl::openflow::cofport &port) {
@@ -2749,7 +2829,8 @@ crofctl::send_port_status_message(const cauxid &auxid, uint8_t reason,
     case rofl::openflow12::OFP_VERSION: {
       // OFP 1.2 => send port-status to controller entity in slave mode
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (role.get_role()) {
       case rofl::openflow13::OFPCR_ROLE_EQUAL:
       case rofl::openflow13::OFPCR_ROLE_MASTER: {
@@ -2830,6 +2911,72 @@ rofl::crofsock::msg_result_t crofctl::send_get_async_config_reply(
   }
 }
 
+bool crofctl::is_packet_in_masked(uint8_t reason) const {
+  switch (rofchan.get_version()) {
+  case rofl::openflow12::OFP_VERSION: {
+    if (is_slave()) {
+      return true;
+    }
+  } break;
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+    switch (role.get_role()) {
+    case rofl::openflow13::OFPCR_ROLE_EQUAL:
+    case rofl::openflow13::OFPCR_ROLE_MASTER: {
+      if (not(async_config.get_packet_in_mask_master() & (1 << reason))) {
+        return true;
+      }
+    } break;
+    case rofl::openflow13::OFPCR_ROLE_SLAVE: {
+      if (not(async_config.get_packet_in_mask_slave() & (1 << reason))) {
+        return true;
+      }
+    } break;
+    default: {
+      // unknown role: send packet-in to controller
+    };
+    }
+  } break;
+  default: {
+    // send packet-in
+  };
+  }
+  return false;
+}
+
+bool crofctl::is_flow_removed_masked(uint8_t reason) const {
+  switch (rofchan.get_version()) {
+  case rofl::openflow12::OFP_VERSION: {
+    if (is_slave()) {
+      return true;
+    }
+  } break;
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+    switch (role.get_role()) {
+    case rofl::openflow13::OFPCR_ROLE_EQUAL:
+    case rofl::openflow13::OFPCR_ROLE_MASTER: {
+      if (not(async_config.get_flow_removed_mask_master() & (1 << reason))) {
+        return true;
+      }
+    } break;
+    case rofl::openflow13::OFPCR_ROLE_SLAVE: {
+      if (not(async_config.get_flow_removed_mask_slave() & (1 << reason))) {
+        return true;
+      }
+    } break;
+    default: {
+      // unknown role: send flow-removed to controller
+    };
+    }
+  } break;
+  default: {
+    // send flow-removed
+  };
+  }
+  return false;
+}
+
 void crofctl::init_async_config_role_default_template() {
   async_config_role_default_template.set_packet_in_mask_master() =
       (1 << rofl::openflow13::OFPR_NO_MATCH) |
@@ -19,6 +19,7 @@
 
 #include "rofl/common/cauxid.h"
 #include "rofl/common/cctlid.h"
+#include "rofl/common/cenvs.hpp"
 #include "rofl/common/cmemory.h"
 #include "rofl/common/crofchan.h"
 #include "rofl/common/exception.hpp"
@@ -81,13 +82,12 @@ class crofctl;
  */
 class crofctl_env {
   friend class crofctl;
-  static std::set<crofctl_env *> rofctl_envs;
-  static crwlock rofctl_envs_lock;
+  static cenvs<crofctl_env> rofctl_envs;
 
 public:
-  static crofctl_env &call_env(crofctl_env *env) {
-    AcquireReadLock lock(crofctl_env::rofctl_envs_lock);
-    if (crofctl_env::rofctl_envs.find(env) == crofctl_env::rofctl_envs.end()) {
+  static crofctl_env &call_env(crofctl_env *env,
+                               chazard::guard &&guard = chazard::guard()) {
+    if (not crofctl_env::rofctl_envs.protect(env, guard)) {
       throw eRofCtlNotFound(
           "crofctl_env::call_env() crofctl_env instance not found");
     }
@@ -96,15 +96,18 @@ public:
 
 public:
   virtual ~crofctl_env() {
-    AcquireReadWriteLock lock(crofctl_env::rofctl_envs_lock);
-    crofctl_env::rofctl_envs.erase(this);
+    crofctl_env::rofctl_envs.drop(this);
   };
   crofctl_env() {
-    AcquireReadWriteLock lock(crofctl_env::rofctl_envs_lock);
-    crofctl_env::rofctl_envs.insert(this);
+    crofctl_env::rofctl_envs.add(this);
   };
 
 protected:
+  /**
+   * @brief	Deregisters this instance, see cenvs::drop()
+   */
+  void drop_env() { crofctl_env::rofctl_envs.drop(this); };
+
   /**
    * @name 	Event handlers for management notifications for controller
    * entities
@@ -482,6 +485,21 @@ protected:
   virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                                  rofl::openflow::cofmsg_packet_out &msg){};
 
+  /**
+   * @brief	Message of a passthrough type received, see
+   * rofl::crofctl::set_rx_passthrough().
+   *
+   * Called from the receiving socket's thread. frame holds the complete
+   * message including its common header and may be relayed via
+   * rofl::crofdpt::send_frame(). The default drops the frame.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param frame received message
+   */
+  virtual void handle_recv_frame(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 const rofl::cslice &frame){};
+
   /**
    * @brief	OpenFlow Barrier-Request message received.
    *
@@ -493,6 +511,31 @@ protected:
   handle_barrier_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
                          rofl::openflow::cofmsg_barrier_request &msg){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control request received.
+   *
+   * Datapath elements supporting bundles reply via
+   * crofctl::send_bundle_control_reply() or an OpenFlow Error message.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	OpenFlow Bundle-Add-Message message received.
+   *
+   * @param ctl controller instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance carrying the message to be added
+   */
+  virtual void
+  handle_bundle_add_message(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                            rofl::openflow::cofmsg_bundle_add_message &msg){};
+
   /**
    * @brief	OpenFlow Flow-Mod message received.
    *
@@ -715,6 +758,7 @@ public:
     case rofl::openflow12::OFP_VERSION:
       return (rofl::openflow12::OFPCR_ROLE_SLAVE == role.get_role());
     case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION:
       return (rofl::openflow13::OFPCR_ROLE_SLAVE == role.get_role());
     default:
       return false;
@@ -782,6 +826,74 @@ public:
    */
   std::list<cauxid> keys() const { return rofchan.keys(); };
 
+  /**
+   * @brief	Selects how messages are distributed over auxiliary connections
+   */
+  void set_sched_policy(crofchan::crofchan_sched_t policy) {
+    rofchan.set_sched_policy(policy);
+  };
+
+  /**
+   *
+   */
+  crofchan::crofchan_sched_t get_sched_policy() const {
+    return rofchan.get_sched_policy();
+  };
+
+  /**
+   * @brief	Returns true when received messages are decoded lazily
+   */
+  bool get_rx_lazy_decoding() const { return rofchan.get_rx_lazy_decoding(); };
+
+  /**
+   * @brief	Enables/disables lazy decoding of received messages on all
+   * control connections
+   *
+   * Flow-Mod, Flow-Stats and Packet-In bodies are decoded on first
+   * access, see rofl::crofsock::set_rx_lazy_decoding().
+   */
+  crofctl &set_rx_lazy_decoding(bool rx_lazy_decoding) {
+    rofchan.set_rx_lazy_decoding(rx_lazy_decoding);
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when messages of type are passed through
+   */
+  bool get_rx_passthrough(uint8_t type) const {
+    return rofchan.get_rx_passthrough(type);
+  };
+
+  /**
+   * @brief	Enables or disables passthrough for messages of type on all
+   * control connections
+   *
+   * Messages of a passthrough type are not decoded, but handed over to
+   * crofctl_env::handle_recv_frame() once a connection is established.
+   * The controller's role is still enforced for state modifying types.
+   * Types required for connection management are rejected, see
+   * rofl::crofconn::set_rx_passthrough().
+   */
+  crofctl &set_rx_passthrough(uint8_t type, bool passthrough = true) {
+    rofchan.set_rx_passthrough(type, passthrough);
+    return *this;
+  };
+
+  /**
+   * @brief	Disables passthrough for all message types
+   */
+  crofctl &clear_rx_passthrough() {
+    rofchan.clear_rx_passthrough();
+    return *this;
+  };
+
+  /**
+   * @brief	Returns number of messages sent on connection auxid
+   */
+  uint64_t get_tx_counter(const cauxid &auxid) const {
+    return rofchan.get_tx_counter(auxid);
+  };
+
   /**
    *
    */
@@ -1109,6 +1221,20 @@ public:
   rofl::crofsock::msg_result_t send_barrier_reply(const rofl::cauxid &auxid,
                                                   uint32_t xid);
 
+  /**
+   * @brief	Sends OpenFlow Bundle-Control reply to attached controller
+   * entity.
+   *
+   * @param xid OpenFlow transaction identifier of the request
+   * @param bundle_id OpenFlow bundle identifier
+   * @param ctrl_type one of rofl::openflow14::OFPBCT_*_REPLY
+   * @param flags bitmap of rofl::openflow14::OFPBF_* flags
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_control_reply(const rofl::cauxid &auxid, uint32_t xid,
+                            uint32_t bundle_id, uint16_t ctrl_type,
+                            uint16_t flags = 0);
+
   /**
    * @brief	Sends OpenFlow Error message to attached controller entity.
    *
@@ -1207,6 +1333,61 @@ public:
 
   /**@}*/
 
+public:
+  /**
+   * @name	Methods for sending OpenFlow messages without exceptions
+   *
+   * Ordinary conditions like a full transmission queue or a connection
+   * being re-established are reported via the returned msg_result_t. A
+   * message not queued is handed back via unsent, if given, and deleted
+   * otherwise.
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Sends msg to attached controller entity without throwing
+   *
+   * On success msg is set to nullptr. Otherwise msg remains owned by the
+   * caller and may be sent again, e.g. after congestion has been solved.
+   */
+  rofl::crofsock::msg_result_t try_send_message(const rofl::cauxid &auxid,
+                                                rofl::openflow::cofmsg *&msg) {
+    return rofchan.try_send_message(auxid, msg);
+  };
+
+  /**
+   * @brief	Sends a received wire frame with a new xid on connection
+   * auxid, see rofl::crofchan::send_frame()
+   */
+  rofl::crofsock::msg_result_t send_frame(const rofl::cauxid &auxid,
+                                          const rofl::cslice &frame,
+                                          uint32_t xid) {
+    return rofchan.send_frame(auxid, frame, xid);
+  };
+
+  /**
+   * @brief	Sends OpenFlow Packet-In message without throwing
+   */
+  rofl::crofsock::msg_result_t try_send_packet_in_message(
+      const rofl::cauxid &auxid, uint32_t buffer_id, uint16_t total_len,
+      uint8_t reason, uint8_t table_id, uint64_t cookie,
+      uint16_t in_port, // for OF1.0
+      const rofl::openflow::cofmatch &match, uint8_t *data, size_t datalen,
+      rofl::openflow::cofmsg **unsent = nullptr);
+
+  /**
+   * @brief	Sends OpenFlow Flow-Removed message without throwing
+   */
+  rofl::crofsock::msg_result_t try_send_flow_removed_message(
+      const rofl::cauxid &auxid, const rofl::openflow::cofmatch &match,
+      uint64_t cookie, uint16_t priority, uint8_t reason, uint8_t table_id,
+      uint32_t duration_sec, uint32_t duration_nsec, uint16_t idle_timeout,
+      uint16_t hard_timeout, uint64_t packet_count, uint64_t byte_count,
+      rofl::openflow::cofmsg **unsent = nullptr);
+
+  /**@}*/
+
 public:
   /**
    *
@@ -1239,7 +1420,8 @@ private:
     case rofl::openflow12::OFP_VERSION: {
       role.set_role(rofl::openflow12::OFPCR_ROLE_EQUAL);
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       role.set_role(rofl::openflow13::OFPCR_ROLE_EQUAL);
     } break;
     }
@@ -1251,7 +1433,8 @@ private:
     case rofl::openflow12::OFP_VERSION: {
       role.set_role(rofl::openflow12::OFPCR_ROLE_EQUAL);
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       role.set_role(rofl::openflow13::OFPCR_ROLE_EQUAL);
     } break;
     }
@@ -1299,9 +1482,16 @@ private:
   virtual void handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
                            rofl::openflow::cofmsg *msg);
 
+  virtual void handle_recv_frame(rofl::crofchan &chan, rofl::crofconn &conn,
+                                 const rofl::cslice &frame);
+
 private:
   void init_async_config_role_default_template();
 
+  bool is_packet_in_masked(uint8_t reason) const;
+
+  bool is_flow_removed_masked(uint8_t reason) const;
+
 private:
   // environment
   rofl::crofctl_env *env;
@@ -15,15 +15,46 @@
 
 using namespace rofl;
 
-/*static*/ std::set<crofdpt_env *> crofdpt_env::rofdpt_envs;
-/*static*/ crwlock crofdpt_env::rofdpt_envs_lock;
+/*static*/ cenvs<crofdpt_env> crofdpt_env::rofdpt_envs;
 
-crofdpt::~crofdpt(){};
+crofdpt::~crofdpt() {
+  /* wait for upcalls from rofchan in progress */
+  drop_env();
+  for (auto msg : shadow_pending)
+    delete msg;
+};
 
 crofdpt::crofdpt(rofl::crofdpt_env *env, const rofl::cdptid &dptid)
     : env(env), dptid(dptid), snoop(true), rofchan(this),
       xid_last(random.uint32()), n_buffers(0), n_tables(0), capabilities(0),
-      miss_send_len(0), flags(0){};
+      miss_send_len(0), flags(0), shadowing(false),
+      shadow_state(SHADOW_STATE_IDLE), shadow_xid(0), shadow_num_sent(0),
+      multipart_streaming(false){};
+
+void crofdpt::handle_established(crofchan &chan, uint8_t ofp_version) {
+  /* dump tables before the application sends any message */
+  if (shadowing) {
+    shadow_reconcile();
+  }
+  crofdpt_env::call_env(env).handle_established(*this, ofp_version);
+}
+
+void crofdpt::handle_closed(crofchan &chan) {
+  if (shadowing) {
+    shadow_abort("control channel closed");
+  }
+  crofdpt_env::call_env(env).handle_closed(*this);
+}
+
+void crofdpt::handle_recv_frame(rofl::crofchan &chan, rofl::crofconn &conn,
+                                const rofl::cslice &frame) {
+  try {
+    crofdpt_env::call_env(env).handle_recv_frame(*this, conn.get_auxid(),
+                                                 frame);
+  } catch (eRofDptNotFound &e) {
+    VLOG(1) << __FUNCTION__ << " " << e.what();
+  }
+}
 
 void crofdpt::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
                           rofl::openflow::cofmsg *msg) {
@@ -103,7 +134,8 @@ void crofdpt::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
       default: {};
       }
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (msg->get_type()) {
       case rofl::openflow13::OFPT_EXPERIMENTER: {
         experimenter_rcvd(conn.get_auxid(), msg);
@@ -141,6 +173,9 @@ void crofdpt::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
       case rofl::openflow13::OFPT_GET_ASYNC_REPLY: {
         get_async_config_reply_rcvd(conn.get_auxid(), msg);
       } break;
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+        bundle_control_reply_rcvd(conn.get_auxid(), msg);
+      } break;
       default: {};
       }
     } break;
@@ -164,6 +199,11 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
                                          uint16_t sub_type) {
   VLOG(2) << __FUNCTION__ << " transaction xid=" << (unsigned int)xid;
 
+  if (shadow_is_pending(xid)) {
+    shadow_abort("request timed out");
+    return;
+  }
+
   try {
     switch (get_version()) {
     case rofl::openflow10::OFP_VERSION: {
@@ -303,7 +343,8 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
       }
 
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (type) {
       case rofl::openflow13::OFPT_FEATURES_REQUEST: {
         crofdpt_env::call_env(env).handle_features_reply_timeout(*this, xid);
@@ -397,6 +438,10 @@ void crofdpt::handle_transaction_timeout(crofchan &chan, crofconn &conn,
       case rofl::openflow13::OFPT_EXPERIMENTER: {
         crofdpt_env::call_env(env).handle_experimenter_timeout(*this, xid);
       } break;
+      case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+        crofdpt_env::call_env(env).handle_bundle_control_reply_timeout(*this,
+                                                                       xid);
+      } break;
       default: {};
       }
 
@@ -462,6 +507,13 @@ void crofdpt::multipart_reply_rcvd(const rofl::cauxid &auxid,
       dynamic_cast<rofl::openflow::cofmsg_stats_reply *>(msg);
   assert(reply != NULL);
 
+  /* reply handlers may not access msg after returning */
+  uint32_t xid = reply->get_xid();
+  uint16_t stats_type = reply->get_stats_type();
+  bool complete =
+      multipart_streaming and not shadow_is_pending(xid) and
+      not(reply->get_stats_flags() & rofl::openflow13::OFPMPF_REPLY_MORE);
+
   switch (reply->get_stats_type()) {
   case rofl::openflow13::OFPMP_DESC: {
     desc_stats_reply_rcvd(auxid, msg);
@@ -510,6 +562,11 @@ void crofdpt::multipart_reply_rcvd(const rofl::cauxid &auxid,
   } break;
   default: {};
   }
+
+  if (complete) {
+    crofdpt_env::call_env(env).handle_multipart_reply_complete(
+        *this, auxid, xid, stats_type);
+  }
 }
 
 void crofdpt::desc_stats_reply_rcvd(const rofl::cauxid &auxid,
@@ -541,6 +598,31 @@ void crofdpt::flow_stats_reply_rcvd(const rofl::cauxid &auxid,
   rofl::openflow::cofmsg_flow_stats_reply &reply =
       dynamic_cast<rofl::openflow::cofmsg_flow_stats_reply &>(*msg);
 
+  if (shadow_is_pending(reply.get_xid())) {
+    std::string error;
+    {
+      AcquireReadWriteLock rwlock(shadow_lock);
+      /* segments arrive one by one when streaming or below OFP1.3 */
+      shadow_flows += reply.get_flow_stats_array();
+      if (reply.get_stats_flags() & rofl::openflow13::OFPMPF_REPLY_MORE)
+        return;
+      try {
+        shadow_pending =
+            shadow.reconcile(shadow_flows, shadow_groups, shadow_meters);
+        shadow_state = SHADOW_STATE_SYNC;
+        shadow_num_sent = 0;
+      } catch (rofl::exception &e) {
+        error = e.what();
+      }
+    }
+    if (error.empty()) {
+      shadow_send_batch();
+    } else {
+      shadow_abort(error);
+    }
+    return;
+  }
+
   crofdpt_env::call_env(env).handle_flow_stats_reply(*this, auxid, reply);
 }
 
@@ -573,6 +655,17 @@ void crofdpt::group_desc_stats_reply_rcvd(const rofl::cauxid &auxid,
   rofl::openflow::cofmsg_group_desc_stats_reply &reply =
       dynamic_cast<rofl::openflow::cofmsg_group_desc_stats_reply &>(*msg);
 
+  if (shadow_is_pending(reply.get_xid())) {
+    {
+      AcquireReadWriteLock rwlock(shadow_lock);
+      shadow_groups += reply.get_group_desc_stats_array();
+      if (reply.get_stats_flags() & rofl::openflow13::OFPMPF_REPLY_MORE)
+        return;
+    }
+    shadow_request_next();
+    return;
+  }
+
   crofdpt_env::call_env(env).handle_group_desc_stats_reply(*this, auxid, reply);
 }
 
@@ -607,6 +700,17 @@ void crofdpt::meter_config_stats_reply_rcvd(const rofl::cauxid &auxid,
   rofl::openflow::cofmsg_meter_config_stats_reply &reply =
       dynamic_cast<rofl::openflow::cofmsg_meter_config_stats_reply &>(*msg);
 
+  if (shadow_is_pending(reply.get_xid())) {
+    {
+      AcquireReadWriteLock rwlock(shadow_lock);
+      shadow_meters += reply.get_meter_config_array();
+      if (reply.get_stats_flags() & rofl::openflow13::OFPMPF_REPLY_MORE)
+        return;
+    }
+    shadow_request_next();
+    return;
+  }
+
   crofdpt_env::call_env(env).handle_meter_config_stats_reply(*this, auxid,
                                                              reply);
 }
@@ -671,14 +775,33 @@ void crofdpt::barrier_reply_rcvd(const rofl::cauxid &auxid,
   rofl::openflow::cofmsg_barrier_reply &reply =
       dynamic_cast<rofl::openflow::cofmsg_barrier_reply &>(*msg);
 
+  if (shadow_is_pending(reply.get_xid())) {
+    shadow_send_batch();
+    return;
+  }
+
   crofdpt_env::call_env(env).handle_barrier_reply(*this, auxid, reply);
 }
 
+void crofdpt::bundle_control_reply_rcvd(const rofl::cauxid &auxid,
+                                        rofl::openflow::cofmsg *msg) {
+  rofl::openflow::cofmsg_bundle_control &reply =
+      dynamic_cast<rofl::openflow::cofmsg_bundle_control &>(*msg);
+
+  crofdpt_env::call_env(env).handle_bundle_control_reply(*this, auxid, reply);
+}
+
 void crofdpt::flow_removed_rcvd(const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg *msg) {
   rofl::openflow::cofmsg_flow_removed &flow_removed =
       dynamic_cast<rofl::openflow::cofmsg_flow_removed &>(*msg);
 
+  if (shadowing) {
+    shadow.record_flow_removed(flow_removed.get_table_id(),
+                               flow_removed.get_priority(),
+                               flow_removed.get_match());
+  }
+
   crofdpt_env::call_env(env).handle_flow_removed(*this, auxid, flow_removed);
 }
 
@@ -729,6 +852,10 @@ void crofdpt::error_rcvd(const rofl::cauxid &auxid,
   rofl::openflow::cofmsg_error &error =
       dynamic_cast<rofl::openflow::cofmsg_error &>(*msg);
 
+  if (shadow_is_pending(error.get_xid())) {
+    shadow_abort("error message received");
+  }
+
   crofdpt_env::call_env(env).handle_error_message(*this, auxid, error);
 }
 
@@ -767,7 +894,8 @@ void crofdpt::flow_mod_reset() {
     fe.set_command(rofl::openflow12::OFPFC_DELETE);
     fe.set_table_id(rofl::openflow12::OFPTT_ALL /*all tables*/);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     fe.set_command(rofl::openflow13::OFPFC_DELETE);
     fe.set_table_id(rofl::openflow13::OFPTT_ALL /*all tables*/);
   } break;
@@ -787,7 +915,8 @@ void crofdpt::group_mod_reset() {
     ge.set_command(openflow12::OFPGC_DELETE);
     ge.set_group_id(openflow12::OFPG_ALL);
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     ge.set_command(openflow13::OFPGC_DELETE);
     ge.set_group_id(openflow13::OFPG_ALL);
   } break;
@@ -1350,7 +1479,48 @@ crofdpt::send_flow_mod_message(const rofl::cauxid &auxid,
     if (xid != nullptr) {
       *xid = __xid;
     }
-    return rofchan.send_message(auxid, msg);
+    rofl::crofsock::msg_result_t result = rofchan.send_message(auxid, msg);
+    if (shadowing && ((result == rofl::crofsock::MSG_QUEUED) ||
+                      (result == rofl::crofsock::MSG_QUEUED_CONGESTION))) {
+      shadow.record_flow_mod(fe);
+    }
+    return result;
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_stamped_message(const rofl::cauxid &auxid,
+                              rofl::openflow::cofmsg_stamped *msg,
+                              uint32_t *xid) {
+  uint32_t __xid = ++xid_last;
+  try {
+    if (msg->get_version() != rofchan.get_version()) {
+      throw eRofConnInvalid(
+          "crofdpt::send_stamped_message() template version mismatch");
+    }
+    msg->set_xid(__xid);
+
+    /* msg is owned by the control channel once queued */
+    rofl::cmemory frame(shadow_frame(*msg));
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    rofl::crofsock::msg_result_t result = rofchan.send_message(auxid, msg);
+    if ((result == rofl::crofsock::MSG_QUEUED) ||
+        (result == rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+      shadow_record(frame);
+    }
+    return result;
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1360,6 +1530,10 @@ crofdpt::send_flow_mod_message(const rofl::cauxid &auxid,
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
     delete msg;
     throw;
+  } catch (eRofConnInvalid &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
   }
 }
 
@@ -1376,7 +1550,12 @@ crofdpt::send_group_mod_message(const rofl::cauxid &auxid,
     if (xid != nullptr) {
       *xid = __xid;
     }
-    return rofchan.send_message(auxid, msg);
+    rofl::crofsock::msg_result_t result = rofchan.send_message(auxid, msg);
+    if (shadowing && ((result == rofl::crofsock::MSG_QUEUED) ||
+                      (result == rofl::crofsock::MSG_QUEUED_CONGESTION))) {
+      shadow.record_group_mod(ge);
+    }
+    return result;
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1568,7 +1747,12 @@ rofl::crofsock::msg_result_t crofdpt::send_meter_mod_message(
     if (xid != nullptr) {
       *xid = __xid;
     }
-    return rofchan.send_message(auxid, msg);
+    rofl::crofsock::msg_result_t result = rofchan.send_message(auxid, msg);
+    if (shadowing && ((result == rofl::crofsock::MSG_QUEUED) ||
+                      (result == rofl::crofsock::MSG_QUEUED_CONGESTION))) {
+      shadow.record_meter_mod(command, flags, meter_id, meter_bands);
+    }
+    return result;
 
   } catch (eRofConnNotConnected &e) {
     VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
@@ -1628,3 +1812,350 @@ rofl::crofsock::msg_result_t crofdpt::send_experimenter_message(
     throw;
   }
 }
+
+rofl::crofsock::msg_result_t crofdpt::send_bundle_control_request(
+    const rofl::cauxid &auxid, uint32_t bundle_id, uint16_t ctrl_type,
+    uint16_t flags, int timeout_in_secs, uint32_t *xid) {
+  if (rofchan.get_version() < rofl::openflow14::OFP_VERSION)
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+  try {
+    msg = new rofl::openflow::cofmsg_bundle_control(
+        rofchan.get_version(), __xid, bundle_id, ctrl_type, flags);
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    return rofchan.send_message(auxid, msg,
+                                ctimespec().expire_in(timeout_in_secs));
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_bundle_add_message(const rofl::cauxid &auxid, uint32_t bundle_id,
+                                 uint16_t flags,
+                                 const rofl::openflow::cofflowmod &fe,
+                                 uint32_t *xid) {
+  if (rofchan.get_version() < rofl::openflow14::OFP_VERSION)
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+
+  return send_bundle_add_message(
+      auxid, bundle_id, flags,
+      new rofl::openflow::cofmsg_flow_mod(rofchan.get_version(), 0, fe), xid);
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_bundle_add_message(const rofl::cauxid &auxid, uint32_t bundle_id,
+                                 uint16_t flags,
+                                 const rofl::openflow::cofgroupmod &ge,
+                                 uint32_t *xid) {
+  if (rofchan.get_version() < rofl::openflow14::OFP_VERSION)
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+
+  return send_bundle_add_message(
+      auxid, bundle_id, flags,
+      new rofl::openflow::cofmsg_group_mod(rofchan.get_version(), 0, ge), xid);
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::send_bundle_add_message(const rofl::cauxid &auxid, uint32_t bundle_id,
+                                 uint16_t flags, rofl::openflow::cofmsg *inner,
+                                 uint32_t *xid) {
+  if (rofchan.get_version() < rofl::openflow14::OFP_VERSION) {
+    delete inner;
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  rofl::openflow::cofmsg *msg = nullptr;
+  uint32_t __xid = ++xid_last;
+  try {
+    /* the embedded message is packed with the enclosing message's xid */
+    msg = new rofl::openflow::cofmsg_bundle_add_message(
+        rofchan.get_version(), __xid, bundle_id, flags, inner);
+
+    /* msg is owned by the control channel once queued */
+    rofl::cmemory frame(shadow_frame(*msg));
+
+    if (xid != nullptr) {
+      *xid = __xid;
+    }
+    rofl::crofsock::msg_result_t result = rofchan.send_message(auxid, msg);
+    if ((result == rofl::crofsock::MSG_QUEUED) ||
+        (result == rofl::crofsock::MSG_QUEUED_CONGESTION)) {
+      shadow_record(frame);
+    }
+    return result;
+
+  } catch (eRofConnNotConnected &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  } catch (eRofQueueFull &e) {
+    VLOG(1) << __FUNCTION__ << " dropping mesage " << e.what();
+    delete msg;
+    throw;
+  }
+}
+
+rofl::crofsock::msg_result_t crofdpt::try_send_packet_out_message(
+    const rofl::cauxid &auxid, uint32_t buffer_id, uint32_t in_port,
+    const rofl::openflow::cofactions &actions, uint8_t *data, size_t datalen,
+    uint32_t *xid, rofl::openflow::cofmsg **unsent) {
+  uint32_t __xid = ++xid_last;
+  rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg_packet_out(
+      rofchan.get_version(), __xid, buffer_id, in_port, actions, data, datalen);
+
+  if (xid != nullptr) {
+    *xid = __xid;
+  }
+  rofl::crofsock::msg_result_t result = rofchan.try_send_message(auxid, msg);
+  if (unsent != nullptr) {
+    *unsent = msg;
+  } else {
+    delete msg;
+  }
+  return result;
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::try_send_flow_mod_message(const rofl::cauxid &auxid,
+                                   const rofl::openflow::cofflowmod &fe,
+                                   uint32_t *xid,
+                                   rofl::openflow::cofmsg **unsent) {
+  uint32_t __xid = ++xid_last;
+  rofl::openflow::cofmsg *msg =
+      new rofl::openflow::cofmsg_flow_mod(rofchan.get_version(), __xid, fe);
+
+  if (xid != nullptr) {
+    *xid = __xid;
+  }
+  rofl::crofsock::msg_result_t result = rofchan.try_send_message(auxid, msg);
+  if (shadowing && (msg == nullptr)) {
+    shadow.record_flow_mod(fe);
+  }
+  if (unsent != nullptr) {
+    *unsent = msg;
+  } else {
+    delete msg;
+  }
+  return result;
+}
+
+rofl::crofsock::msg_result_t
+crofdpt::try_send_barrier_request(const rofl::cauxid &auxid,
+                                  int timeout_in_secs, uint32_t *xid,
+                                  rofl::openflow::cofmsg **unsent) {
+  uint32_t __xid = ++xid_last;
+  rofl::openflow::cofmsg *msg =
+      new rofl::openflow::cofmsg_barrier_request(rofchan.get_version(), __xid);
+
+  if (xid != nullptr) {
+    *xid = __xid;
+  }
+  rofl::crofsock::msg_result_t result = rofchan.try_send_message(
+      auxid, msg, ctimespec().expire_in(timeout_in_secs));
+  if (unsent != nullptr) {
+    *unsent = msg;
+  } else {
+    delete msg;
+  }
+  return result;
+}
+
+crofdpt &crofdpt::set_shadowing(bool shadowing) {
+  this->shadowing = shadowing;
+  if (not shadowing) {
+    shadow.clear();
+  } else if (is_established()) {
+    shadow.set_version(get_version());
+  }
+  return *this;
+}
+
+void crofdpt::shadow_reconcile() {
+  {
+    AcquireReadWriteLock rwlock(shadow_lock);
+    for (auto msg : shadow_pending)
+      delete msg;
+    shadow_pending.clear();
+    shadow_num_sent = 0;
+    shadow_state = SHADOW_STATE_IDLE;
+    shadow_flows = rofl::openflow::cofflowstatsarray(get_version());
+    shadow_groups = rofl::openflow::cofgroupdescstatsarray(get_version());
+    shadow_meters = rofl::openflow::cofmeterconfigarray(get_version());
+  }
+
+  /* a shadow recorded for another OpenFlow version is dropped */
+  shadow.set_version(get_version());
+
+  VLOG(2) << __FUNCTION__ << " dptid=" << dptid << " " << shadow;
+
+  shadow_request_next();
+}
+
+bool crofdpt::shadow_is_pending(uint32_t xid) const {
+  AcquireReadLock rlock(shadow_lock);
+  return ((shadow_state != SHADOW_STATE_IDLE) && (shadow_xid == xid));
+}
+
+void crofdpt::shadow_request_next() {
+  std::string error;
+  {
+    AcquireReadWriteLock rwlock(shadow_lock);
+    uint8_t version = get_version();
+    uint32_t __xid = ++xid_last;
+    rofl::openflow::cofmsg *msg = nullptr;
+
+    if ((shadow_state == SHADOW_STATE_IDLE) &&
+        (version >= rofl::openflow12::OFP_VERSION)) {
+      shadow_state = SHADOW_STATE_GROUPS;
+      msg = new rofl::openflow::cofmsg_group_desc_stats_request(version,
+                                                                __xid, 0);
+    } else if ((shadow_state <= SHADOW_STATE_GROUPS) &&
+               (version >= rofl::openflow13::OFP_VERSION)) {
+      shadow_state = SHADOW_STATE_METERS;
+      msg = new rofl::openflow::cofmsg_meter_config_stats_request(
+          version, __xid, 0, rofl::openflow13::OFPM_ALL);
+    } else if (shadow_state <= SHADOW_STATE_METERS) {
+      shadow_state = SHADOW_STATE_FLOWS;
+      rofl::openflow::cofflow_stats_request request(
+          version, rofl::openflow::cofmatch(version),
+          rofl::openflow::base::get_ofptt_all(version));
+      msg = new rofl::openflow::cofmsg_flow_stats_request(version, __xid, 0,
+                                                          request);
+    } else {
+      return;
+    }
+    shadow_xid = __xid;
+
+    /* a silent datapath element must not leave reconciliation pending */
+    rofchan.try_send_message(cauxid(0), msg,
+                             ctimespec().expire_in(SHADOW_REQUEST_TIMEOUT));
+    if (msg != nullptr) {
+      delete msg;
+      error = "sending request failed";
+    }
+  }
+  if (not error.empty()) {
+    shadow_abort(error);
+  }
+}
+
+void crofdpt::shadow_send_batch() {
+  std::string error;
+  bool done = false;
+  unsigned int num_msgs = 0;
+  {
+    AcquireReadWriteLock rwlock(shadow_lock);
+    if (shadow_state != SHADOW_STATE_SYNC)
+      return;
+
+    unsigned int count = 0;
+    while ((not shadow_pending.empty()) && (count < SHADOW_BATCH_SIZE)) {
+      rofl::openflow::cofmsg *msg = shadow_pending.front();
+      msg->set_xid(++xid_last);
+      rofl::crofsock::msg_result_t result =
+          rofchan.try_send_message(cauxid(0), msg);
+      if (msg != nullptr) {
+        /* retry remaining messages after the next Barrier-Reply */
+        if ((result != rofl::crofsock::MSG_QUEUEING_FAILED_QUEUE_FULL) ||
+            (count == 0))
+          error = "sending message failed";
+        break;
+      }
+      shadow_pending.pop_front();
+      shadow_num_sent++;
+      count++;
+    }
+
+    if (not error.empty()) {
+      /* aborted below */
+    } else if ((count == 0) && shadow_pending.empty()) {
+      shadow_state = SHADOW_STATE_IDLE;
+      num_msgs = shadow_num_sent;
+      done = true;
+    } else {
+      uint32_t __xid = ++xid_last;
+      rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg_barrier_request(
+          get_version(), __xid);
+      shadow_xid = __xid;
+      rofchan.try_send_message(cauxid(0), msg,
+                               ctimespec().expire_in(SHADOW_REQUEST_TIMEOUT));
+      if (msg != nullptr) {
+        delete msg;
+        error = "sending Barrier-Request failed";
+      }
+    }
+  }
+
+  if (not error.empty()) {
+    shadow_abort(error);
+  } else if (done) {
+    VLOG(2) << __FUNCTION__ << " dptid=" << dptid
+            << " reconciliation done, #msgs=" << num_msgs;
+    crofdpt_env::call_env(env).handle_shadow_reconciled(*this, num_msgs);
+  }
+}
+
+void crofdpt::shadow_abort(const std::string &reason) {
+  {
+    AcquireReadWriteLock rwlock(shadow_lock);
+    if (shadow_state == SHADOW_STATE_IDLE)
+      return;
+    VLOG(1) << __FUNCTION__ << " dptid=" << dptid
+            << " reconciliation aborted: " << reason;
+    for (auto msg : shadow_pending)
+      delete msg;
+    shadow_pending.clear();
+    shadow_state = SHADOW_STATE_IDLE;
+    shadow_flows = rofl::openflow::cofflowstatsarray(get_version());
+    shadow_groups = rofl::openflow::cofgroupdescstatsarray(get_version());
+    shadow_meters = rofl::openflow::cofmeterconfigarray(get_version());
+  }
+  crofdpt_env::call_env(env).handle_shadow_aborted(*this, reason);
+}
+
+rofl::cmemory crofdpt::shadow_frame(rofl::openflow::cofmsg &msg) const {
+  if (not shadowing)
+    return rofl::cmemory();
+  switch (msg.get_type()) {
+  case rofl::openflow::OFPT_FLOW_MOD:
+  case rofl::openflow::OFPT_GROUP_MOD:
+  case rofl::openflow13::OFPT_METER_MOD:
+  case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+    rofl::cmemory frame(msg.length());
+    msg.pack(frame.somem(), frame.length());
+    return frame;
+  };
+  default:
+    return rofl::cmemory();
+  }
+}
+
+void crofdpt::shadow_record(const rofl::cmemory &frame) {
+  if (frame.empty())
+    return;
+  try {
+    shadow.record_frame(frame);
+  } catch (rofl::exception &e) {
+    VLOG(1) << __FUNCTION__ << " dptid=" << dptid
+            << " unable to record message: " << e.what();
+  }
+}
+
+crofdpt &crofdpt::set_multipart_streaming(bool multipart_streaming) {
+  this->multipart_streaming = multipart_streaming;
+  rofchan.set_multipart_streaming(multipart_streaming);
+  return *this;
+}
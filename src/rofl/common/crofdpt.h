@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <strings.h>
 
+#include "rofl/common/cenvs.hpp"
 #include "rofl/common/cmemory.h"
 
 #include "rofl/common/cauxid.h"
@@ -30,6 +31,7 @@
 #include "rofl/common/crandom.h"
 #include "rofl/common/crofchan.h"
 #include "rofl/common/crofqueue.h"
+#include "rofl/common/crofshadow.hpp"
 #include "rofl/common/exception.hpp"
 
 #include "rofl/common/openflow/cofasyncconfig.h"
@@ -82,13 +84,12 @@ class crofdpt;
  */
 class crofdpt_env {
   friend class crofdpt;
-  static std::set<crofdpt_env *> rofdpt_envs;
-  static crwlock rofdpt_envs_lock;
+  static cenvs<crofdpt_env> rofdpt_envs;
 
 public:
-  static crofdpt_env &call_env(crofdpt_env *env) {
-    AcquireReadLock lock(crofdpt_env::rofdpt_envs_lock);
-    if (crofdpt_env::rofdpt_envs.find(env) == crofdpt_env::rofdpt_envs.end()) {
+  static crofdpt_env &call_env(crofdpt_env *env,
+                               chazard::guard &&guard = chazard::guard()) {
+    if (not crofdpt_env::rofdpt_envs.protect(env, guard)) {
       throw eRofDptNotFound(
           "crofdpt_env::call_env() crofdpt_env instance not found");
     }
@@ -97,15 +98,18 @@ public:
 
 public:
   virtual ~crofdpt_env() {
-    AcquireReadWriteLock lock(crofdpt_env::rofdpt_envs_lock);
-    crofdpt_env::rofdpt_envs.erase(this);
+    crofdpt_env::rofdpt_envs.drop(this);
   };
   crofdpt_env() {
-    AcquireReadWriteLock lock(crofdpt_env::rofdpt_envs_lock);
-    crofdpt_env::rofdpt_envs.insert(this);
+    crofdpt_env::rofdpt_envs.add(this);
   };
 
 protected:
+  /**
+   * @brief	Deregisters this instance, see cenvs::drop()
+   */
+  void drop_env() { crofdpt_env::rofdpt_envs.drop(this); };
+
   /**
    * @name 	Event handlers for management notifications for controller
    * entities
@@ -237,6 +241,57 @@ protected:
    */
   virtual void congestion_solved_indication(crofdpt &dpt, crofconn &conn){};
 
+  /**
+   * @brief	Called when the shadow tables have been restored on the
+   * datapath element.
+   *
+   * Shadowing must be enabled via rofl::crofdpt::set_shadowing(). This
+   * method is called once all messages computed by the reconciliation
+   * started after (re-)establishing the control channel have been
+   * acknowledged by a Barrier-Reply.
+   *
+   * @param dpt datapath instance
+   * @param num_msgs number of Flow-Mod, Group-Mod and Meter-Mod messages sent
+   */
+  virtual void handle_shadow_reconciled(crofdpt &dpt,
+                                        unsigned int num_msgs){};
+
+  /**
+   * @brief	Called when reconciliation of the shadow tables has been
+   * given up.
+   *
+   * Reconciliation is aborted when the control channel is closed, a
+   * request or message is rejected by the datapath element, e.g. due to
+   * missing group or meter support, a request cannot be sent or no reply
+   * arrives in time. The datapath element may hold entries differing from
+   * the shadow tables afterwards.
+   *
+   * @param dpt datapath instance
+   * @param reason textual description of the failure
+   */
+  virtual void handle_shadow_aborted(crofdpt &dpt, const std::string &reason){};
+
+  /**
+   * @brief	Called after the last segment of a multipart reply has been
+   * handed over in streaming mode.
+   *
+   * Streaming must be enabled via rofl::crofdpt::set_multipart_streaming().
+   * The reply handlers, e.g. handle_flow_stats_reply(), are then called once
+   * per segment as it arrives, all segments except the last one carry the
+   * OFPMPF_REPLY_MORE flag. While streaming is enabled, this method is
+   * called once for every multipart reply, including replies consisting of
+   * a single segment. It is never called with streaming disabled.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param xid transaction id of the multipart reply
+   * @param stats_type multipart type of the reply
+   */
+  virtual void handle_multipart_reply_complete(crofdpt &dpt,
+                                               const cauxid &auxid,
+                                               uint32_t xid,
+                                               uint16_t stats_type){};
+
   /**@}*/
 
 protected:
@@ -707,6 +762,21 @@ protected:
   virtual void handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
                                 rofl::openflow::cofmsg_packet_in &msg){};
 
+  /**
+   * @brief	Message of a passthrough type received, see
+   * rofl::crofdpt::set_rx_passthrough().
+   *
+   * Called from the receiving socket's thread. frame holds the complete
+   * message including its common header and may be relayed via
+   * rofl::crofctl::send_frame(). The default drops the frame.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param frame received message
+   */
+  virtual void handle_recv_frame(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                 const rofl::cslice &frame){};
+
   /**
    * @brief	OpenFlow Barrier-Reply message received.
    *
@@ -729,6 +799,29 @@ protected:
    */
   virtual void handle_barrier_reply_timeout(rofl::crofdpt &dpt, uint32_t xid){};
 
+  /**
+   * @brief	OpenFlow Bundle-Control message received.
+   *
+   * Replies to open, close, commit and discard requests. Failed bundle
+   * operations are reported via an OpenFlow Error message instead.
+   *
+   * @param dpt datapath instance
+   * @param auxid control connection identifier
+   * @param msg OpenFlow message instance
+   */
+  virtual void
+  handle_bundle_control_reply(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                              rofl::openflow::cofmsg_bundle_control &msg){};
+
+  /**
+   * @brief	Timer expired while waiting for OpenFlow Bundle-Control reply.
+   *
+   * @param dpt datapath instance
+   * @param xid OpenFlow transaction identifier
+   */
+  virtual void handle_bundle_control_reply_timeout(rofl::crofdpt &dpt,
+                                                   uint32_t xid){};
+
   /**
    * @brief	OpenFlow Flow-Removed message received.
    *
@@ -1037,6 +1130,118 @@ public:
 
   /**@}*/
 
+public:
+  /**
+   * @name	Methods for shadowing flow, group and meter tables
+   *
+   * When shadowing is enabled, all Flow-Mod, Group-Mod and Meter-Mod
+   * messages sent via this crofdpt instance are recorded in a
+   * rofl::crofshadow instance. Whenever the control channel is
+   * (re-)established, the tables are dumped from the datapath element and
+   * only the difference to the shadow state is sent. Messages rejected
+   * by the datapath element are not removed from the shadow.
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Returns true when shadowing is enabled
+   */
+  bool get_shadowing() const { return shadowing; };
+
+  /**
+   * @brief	Enables/disables shadowing, disabling drops the shadow state
+   */
+  crofdpt &set_shadowing(bool shadowing);
+
+  /**
+   * @brief	Returns the shadow tables of this datapath element
+   */
+  const rofl::crofshadow &get_shadow() const { return shadow; };
+
+  /**
+   * @brief	Returns the shadow tables of this datapath element
+   */
+  rofl::crofshadow &set_shadow() { return shadow; };
+
+  /**
+   * @brief	Restores the shadow state on the attached datapath element.
+   *
+   * Called automatically when the control channel has been established.
+   * Sends Group-Desc, Meter-Config and Flow-Stats requests and the
+   * messages computed by rofl::crofshadow::reconcile() afterwards in
+   * batches of SHADOW_BATCH_SIZE messages, each one followed by a
+   * Barrier-Request. rofl::crofdpt_env::handle_shadow_reconciled() is
+   * called after the final Barrier-Reply has been received.
+   */
+  void shadow_reconcile();
+
+  /**@}*/
+
+public:
+  /**
+   * @brief	Returns true when multipart replies are streamed
+   */
+  bool get_multipart_streaming() const { return multipart_streaming; };
+
+  /**
+   * @brief	Enables/disables streaming of multipart replies on all control
+   * connections
+   *
+   * In streaming mode, multipart replies are not reassembled. Each segment
+   * is handed over to the reply handler as it arrives, followed by a call
+   * to rofl::crofdpt_env::handle_multipart_reply_complete() after the last
+   * segment. Peak memory is bounded by a single segment, e.g. for large
+   * flow table dumps.
+   */
+  crofdpt &set_multipart_streaming(bool multipart_streaming);
+
+  /**
+   * @brief	Returns true when received messages are decoded lazily
+   */
+  bool get_rx_lazy_decoding() const { return rofchan.get_rx_lazy_decoding(); };
+
+  /**
+   * @brief	Enables/disables lazy decoding of received messages on all
+   * control connections
+   *
+   * Flow-Mod, Flow-Stats and Packet-In bodies are decoded on first
+   * access, see rofl::crofsock::set_rx_lazy_decoding().
+   */
+  crofdpt &set_rx_lazy_decoding(bool rx_lazy_decoding) {
+    rofchan.set_rx_lazy_decoding(rx_lazy_decoding);
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when messages of type are passed through
+   */
+  bool get_rx_passthrough(uint8_t type) const {
+    return rofchan.get_rx_passthrough(type);
+  };
+
+  /**
+   * @brief	Enables or disables passthrough for messages of type on all
+   * control connections
+   *
+   * Messages of a passthrough type are not decoded, but handed over to
+   * crofdpt_env::handle_recv_frame() once a connection is established.
+   * Types required for connection management are rejected, see
+   * rofl::crofconn::set_rx_passthrough().
+   */
+  crofdpt &set_rx_passthrough(uint8_t type, bool passthrough = true) {
+    rofchan.set_rx_passthrough(type, passthrough);
+    return *this;
+  };
+
+  /**
+   * @brief	Disables passthrough for all message types
+   */
+  crofdpt &clear_rx_passthrough() {
+    rofchan.clear_rx_passthrough();
+    return *this;
+  };
+
 public:
   /**
    *
@@ -1064,6 +1269,27 @@ public:
    */
   std::list<cauxid> keys() const { return rofchan.keys(); };
 
+  /**
+   * @brief	Selects how messages are distributed over auxiliary connections
+   */
+  void set_sched_policy(crofchan::crofchan_sched_t policy) {
+    rofchan.set_sched_policy(policy);
+  };
+
+  /**
+   *
+   */
+  crofchan::crofchan_sched_t get_sched_policy() const {
+    return rofchan.get_sched_policy();
+  };
+
+  /**
+   * @brief	Returns number of messages sent on connection auxid
+   */
+  uint64_t get_tx_counter(const cauxid &auxid) const {
+    return rofchan.get_tx_counter(auxid);
+  };
+
   /**
    *
    */
@@ -1459,6 +1685,24 @@ public:
                         const rofl::openflow::cofflowmod &flowmod,
                         uint32_t *xid = nullptr);
 
+  /**
+   * @brief	Sends an instance of a pre-serialized message template.
+   *
+   * Ownership of msg is transferred to this crofdpt instance, a message
+   * not queued is deleted before any exception is rethrown. A new
+   * transaction ID is assigned to msg.
+   *
+   * @param auxid controller connection identifier
+   * @param msg instance created by rofl::openflow::cofmsg_template::stamp()
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t
+  send_stamped_message(const rofl::cauxid &auxid,
+                       rofl::openflow::cofmsg_stamped *msg,
+                       uint32_t *xid = nullptr);
+
   /**
    * @brief	Sends OpenFlow Group-Mod message to attached datapath element.
    *
@@ -1623,6 +1867,215 @@ public:
 
   /**@}*/
 
+public:
+  /**
+   * @name	Methods for OpenFlow 1.4 bundles
+   *
+   * A bundle groups Flow-Mod, Group-Mod and Meter-Mod messages for atomic
+   * installation: open the bundle, add the messages and commit it. The
+   * datapath element replies to each control request, errors of added
+   * messages are reported via OpenFlow Error messages. All methods throw
+   * rofl::eBadVersion if the negotiated OpenFlow version is below 1.4.
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Sends OpenFlow Bundle-Control request to attached datapath
+   * element.
+   *
+   * @param auxid controller connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param ctrl_type one of rofl::openflow14::OFPBCT_*_REQUEST
+   * @param flags bitmap of rofl::openflow14::OFPBF_* flags
+   * @param timeout until this request expires
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t send_bundle_control_request(
+      const rofl::cauxid &auxid, uint32_t bundle_id, uint16_t ctrl_type,
+      uint16_t flags = 0, int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+      uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Opens a bundle on attached datapath element.
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_open_request(const rofl::cauxid &auxid, uint32_t bundle_id,
+                           uint16_t flags = rofl::openflow14::OFPBF_ATOMIC,
+                           int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+                           uint32_t *xid = nullptr) {
+    return send_bundle_control_request(auxid, bundle_id,
+                                       rofl::openflow14::OFPBCT_OPEN_REQUEST,
+                                       flags, timeout_in_secs, xid);
+  };
+
+  /**
+   * @brief	Commits all messages added to a bundle on attached datapath
+   * element.
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_commit_request(const rofl::cauxid &auxid, uint32_t bundle_id,
+                             uint16_t flags = rofl::openflow14::OFPBF_ATOMIC,
+                             int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+                             uint32_t *xid = nullptr) {
+    return send_bundle_control_request(auxid, bundle_id,
+                                       rofl::openflow14::OFPBCT_COMMIT_REQUEST,
+                                       flags, timeout_in_secs, xid);
+  };
+
+  /**
+   * @brief	Discards a bundle on attached datapath element.
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_discard_request(const rofl::cauxid &auxid, uint32_t bundle_id,
+                              uint16_t flags = rofl::openflow14::OFPBF_ATOMIC,
+                              int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+                              uint32_t *xid = nullptr) {
+    return send_bundle_control_request(
+        auxid, bundle_id, rofl::openflow14::OFPBCT_DISCARD_REQUEST, flags,
+        timeout_in_secs, xid);
+  };
+
+  /**
+   * @brief	Adds a Flow-Mod message to a bundle on attached datapath
+   * element.
+   *
+   * @param auxid controller connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param flags bitmap of rofl::openflow14::OFPBF_* flags used when opening
+   * @param flowmod OpenFlow flow mod entry
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_add_message(const rofl::cauxid &auxid, uint32_t bundle_id,
+                          uint16_t flags,
+                          const rofl::openflow::cofflowmod &flowmod,
+                          uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Adds a Group-Mod message to a bundle on attached datapath
+   * element.
+   *
+   * @param auxid controller connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param flags bitmap of rofl::openflow14::OFPBF_* flags used when opening
+   * @param groupmod OpenFlow group mod entry
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_add_message(const rofl::cauxid &auxid, uint32_t bundle_id,
+                          uint16_t flags,
+                          const rofl::openflow::cofgroupmod &groupmod,
+                          uint32_t *xid = nullptr);
+
+  /**
+   * @brief	Adds an arbitrary message to a bundle on attached datapath
+   * element, e.g. a Meter-Mod message.
+   *
+   * Ownership of msg is transferred to this crofdpt instance, a message
+   * not queued is deleted before any exception is rethrown.
+   *
+   * @param auxid controller connection identifier
+   * @param bundle_id OpenFlow bundle identifier
+   * @param flags bitmap of rofl::openflow14::OFPBF_* flags used when opening
+   * @param msg OpenFlow message to be added
+   * @return OpenFlow transaction ID assigned to this request
+   * @exception rofl::eRofBaseNotConnected
+   * @exception rofl::eRofBaseCongested
+   */
+  rofl::crofsock::msg_result_t
+  send_bundle_add_message(const rofl::cauxid &auxid, uint32_t bundle_id,
+                          uint16_t flags, rofl::openflow::cofmsg *msg,
+                          uint32_t *xid = nullptr);
+
+  /**@}*/
+
+public:
+  /**
+   * @name	Methods for sending OpenFlow messages without exceptions
+   *
+   * Ordinary conditions like a full transmission queue or a connection
+   * being re-established are reported via the returned msg_result_t. A
+   * message not queued is handed back via unsent, if given, and deleted
+   * otherwise.
+   */
+
+  /**@{*/
+
+  /**
+   * @brief	Sends msg to attached datapath element without throwing
+   *
+   * On success msg is set to nullptr. Otherwise msg remains owned by the
+   * caller and may be sent again, e.g. after congestion has been solved.
+   */
+  rofl::crofsock::msg_result_t try_send_message(const rofl::cauxid &auxid,
+                                                rofl::openflow::cofmsg *&msg) {
+    rofl::cmemory frame(shadow_frame(*msg));
+    rofl::crofsock::msg_result_t result = rofchan.try_send_message(auxid, msg);
+    if (msg == nullptr)
+      shadow_record(frame);
+    return result;
+  };
+
+  /**
+   * @brief	Sends msg with expiration timer without throwing
+   */
+  rofl::crofsock::msg_result_t
+  try_send_message(const rofl::cauxid &auxid, rofl::openflow::cofmsg *&msg,
+                   int timeout_in_secs) {
+    rofl::cmemory frame(shadow_frame(*msg));
+    rofl::crofsock::msg_result_t result = rofchan.try_send_message(
+        auxid, msg, ctimespec().expire_in(timeout_in_secs));
+    if (msg == nullptr)
+      shadow_record(frame);
+    return result;
+  };
+
+  /**
+   * @brief	Sends a received wire frame with a new xid on connection
+   * auxid, see rofl::crofchan::send_frame()
+   */
+  rofl::crofsock::msg_result_t send_frame(const rofl::cauxid &auxid,
+                                          const rofl::cslice &frame,
+                                          uint32_t xid) {
+    return rofchan.send_frame(auxid, frame, xid);
+  };
+
+  /**
+   * @brief	Sends OpenFlow Packet-Out message without throwing
+   */
+  rofl::crofsock::msg_result_t try_send_packet_out_message(
+      const rofl::cauxid &auxid, uint32_t buffer_id, uint32_t in_port,
+      const rofl::openflow::cofactions &actions, uint8_t *data = NULL,
+      size_t datalen = 0, uint32_t *xid = nullptr,
+      rofl::openflow::cofmsg **unsent = nullptr);
+
+  /**
+   * @brief	Sends OpenFlow Flow-Mod message without throwing
+   */
+  rofl::crofsock::msg_result_t
+  try_send_flow_mod_message(const rofl::cauxid &auxid,
+                            const rofl::openflow::cofflowmod &flowmod,
+                            uint32_t *xid = nullptr,
+                            rofl::openflow::cofmsg **unsent = nullptr);
+
+  /**
+   * @brief	Sends OpenFlow Barrier-Request message without throwing
+   */
+  rofl::crofsock::msg_result_t
+  try_send_barrier_request(const rofl::cauxid &auxid,
+                           int timeout_in_secs = DEFAULT_REQUEST_TIMEOUT,
+                           uint32_t *xid = nullptr,
+                           rofl::openflow::cofmsg **unsent = nullptr);
+
+  /**@}*/
+
 public:
   /**
    * @brief 	Predicate for finding a rofl::crofdpt instance by its
@@ -1671,16 +2124,13 @@ public:
   };
 
 private:
-  virtual void handle_established(crofchan &chan, uint8_t ofp_version) {
-    crofdpt_env::call_env(env).handle_established(*this, ofp_version);
-  };
+  virtual void handle_established(crofchan &chan, uint8_t ofp_version);
 
-  virtual void handle_closed(crofchan &chan) {
-    crofdpt_env::call_env(env).handle_closed(*this);
-  };
+  virtual void handle_closed(crofchan &chan);
 
   virtual void handle_established(crofchan &chan, crofconn &conn,
                                   uint8_t ofp_version) {
+    conn.set_multipart_streaming(multipart_streaming);
     crofdpt_env::call_env(env).handle_established(*this, conn, ofp_version);
   };
 
@@ -1720,6 +2170,9 @@ private:
   virtual void handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
                            rofl::openflow::cofmsg *msg);
 
+  virtual void handle_recv_frame(rofl::crofchan &chan, rofl::crofconn &conn,
+                                 const rofl::cslice &frame);
+
 private:
   void experimenter_rcvd(const rofl::cauxid &auxid,
                          rofl::openflow::cofmsg *msg);
@@ -1783,6 +2236,9 @@ private:
   void barrier_reply_rcvd(const rofl::cauxid &auxid,
                           rofl::openflow::cofmsg *msg);
 
+  void bundle_control_reply_rcvd(const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg *msg);
+
   void port_mod_sent(rofl::openflow::cofmsg *pack);
 
   void packet_in_rcvd(const rofl::cauxid &auxid, rofl::openflow::cofmsg *msg);
@@ -1800,6 +2256,19 @@ private:
   void get_async_config_reply_rcvd(const rofl::cauxid &auxid,
                                    rofl::openflow::cofmsg *msg);
 
+private:
+  bool shadow_is_pending(uint32_t xid) const;
+
+  void shadow_request_next();
+
+  void shadow_send_batch();
+
+  void shadow_abort(const std::string &reason);
+
+  rofl::cmemory shadow_frame(rofl::openflow::cofmsg &msg) const;
+
+  void shadow_record(const rofl::cmemory &frame);
+
 private:
   // environment
   rofl::crofdpt_env *env;
@@ -1851,6 +2320,48 @@ private:
 
   // groups
   rofl::openflow::cofgroup_features_stats_reply groups;
+
+  // states of shadow reconciliation
+  enum crofdpt_shadow_state_t {
+    SHADOW_STATE_IDLE = 0,
+    SHADOW_STATE_GROUPS = 1,
+    SHADOW_STATE_METERS = 2,
+    SHADOW_STATE_FLOWS = 3,
+    SHADOW_STATE_SYNC = 4,
+  };
+
+  // max number of messages sent per barrier during reconciliation
+  static const unsigned int SHADOW_BATCH_SIZE = 1024;
+
+  // seconds to wait for a reply to a reconciliation request
+  static const time_t SHADOW_REQUEST_TIMEOUT = 60;
+
+  // shadow tables enabled
+  bool shadowing;
+
+  // shadow flow, group and meter tables
+  rofl::crofshadow shadow;
+
+  // lock for reconciliation state
+  crwlock shadow_lock;
+
+  // reconciliation state
+  crofdpt_shadow_state_t shadow_state;
+
+  // xid of pending request sent for reconciliation
+  uint32_t shadow_xid;
+
+  // flows, groups and meters dumped from datapath element
+  rofl::openflow::cofflowstatsarray shadow_flows;
+  rofl::openflow::cofgroupdescstatsarray shadow_groups;
+  rofl::openflow::cofmeterconfigarray shadow_meters;
+
+  // messages not sent yet and number of messages sent
+  std::list<rofl::openflow::cofmsg *> shadow_pending;
+  unsigned int shadow_num_sent;
+
+  // hand over multipart reply segments without reassembly
+  bool multipart_streaming;
 };
 
 }; // end of namespace
@@ -8,8 +8,10 @@
 #ifndef CROFQUEUE_H_
 #define CROFQUEUE_H_
 
+#include <atomic>
 #include <list>
 #include <ostream>
+#include <stdint.h>
 
 #include "rofl/common/locking.hpp"
 #include "rofl/common/openflow/messages/cofmsg.h"
@@ -47,111 +49,180 @@ public:
       : eRofQueueBase(__arg, __file, __func, __line){};
 };
 
+/**
+ * @brief	Bounded multi-producer queue for cofmsg instances
+ *
+ * Messages are stored in a fixed size lock-free ring buffer (bounded
+ * MPMC queue with per-slot sequence numbers), so store() and retrieve()
+ * neither allocate memory nor take a lock. Messages exceeding the ring
+ * size (enforced stores or a queue_max_size larger than the ring) spill
+ * over into a locked overflow list. Once the overflow list is in use, all
+ * further messages are appended to it until the consumer has drained it,
+ * so per-producer FIFO order is preserved.
+ *
+ * front() and pop() must be called by a single consumer only.
+ */
 class crofqueue {
 public:
   /**
    *
    */
-  crofqueue() : queue_max_size(QUEUE_MAX_SIZE_DEFAULT){};
+  crofqueue(size_t ring_size = RING_SIZE_DEFAULT)
+      : queue_max_size(QUEUE_MAX_SIZE_DEFAULT), ring(nullptr), ring_mask(0),
+        enqueue_pos(0), dequeue_pos(0), overflow_size(0),
+        front_state(FRONT_NONE) {
+    size_t size = 2;
+    while (size < ring_size)
+      size <<= 1;
+    ring = new cslot[size];
+    ring_mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+      ring[i].sequence.store(i, std::memory_order_relaxed);
+      ring[i].msg = nullptr;
+    }
+  };
 
   /**
    *
    */
-  ~crofqueue() { clear(); };
+  ~crofqueue() {
+    clear();
+    delete[] ring;
+  };
 
 public:
   /**
    *
    */
-  bool empty() const {
-    AcquireReadLock rwlock(queue_lock);
-    return queue.empty();
-  };
+  bool empty() const { return (size() == 0); };
 
   /**
    *
    */
   size_t size() const {
-    AcquireReadLock rwlock(queue_lock);
-    return queue.size();
+    size_t deq = dequeue_pos.load(std::memory_order_acquire);
+    size_t enq = enqueue_pos.load(std::memory_order_acquire);
+    return ((enq > deq) ? (enq - deq) : 0) +
+           overflow_size.load(std::memory_order_acquire);
   };
 
   /**
-   *
+   * @brief	Removes and deletes all messages, returns their number
    */
-  void clear() {
-    while (true) {
-      rofl::openflow::cofmsg *msg = nullptr;
-      {
-        AcquireReadWriteLock rwlock(queue_lock);
-        if (queue.empty()) {
-          return;
-        }
-        msg = queue.front();
-        queue.pop_front();
-      }
+  size_t clear() {
+    size_t num = 0;
+    rofl::openflow::cofmsg *msg = nullptr;
+    while ((msg = retrieve()) != nullptr) {
       delete msg;
+      num++;
     }
+    return num;
   };
 
   /**
+   * @brief	Appends msg to queue
    *
+   * Throws eRofQueueFull when queue_max_size has been reached, unless
+   * enforce is set.
    */
   size_t store(rofl::openflow::cofmsg *msg, bool enforce = false) {
-    AcquireReadWriteLock rwlock(queue_lock);
-    if ((not enforce) && (queue.size() >= queue_max_size)) {
+    if (not try_store(msg, enforce)) {
       throw eRofQueueFull("crofqueue::store() queue max size exceeded",
                           __FILE__, __FUNCTION__, __LINE__);
     }
-    queue.push_back(msg);
-    return queue.size();
+    return size();
+  };
+
+  /**
+   * @brief	Appends msg to queue, returns false when queue is full
+   *
+   * msg remains owned by the caller if it was not stored.
+   */
+  bool try_store(rofl::openflow::cofmsg *msg, bool enforce = false) {
+    if ((not enforce) && (size() >= queue_max_size)) {
+      return false;
+    }
+    if ((overflow_size.load(std::memory_order_acquire) > 0) ||
+        (not ring_push(msg))) {
+      AcquireReadWriteLock rwlock(overflow_lock);
+      overflow.push_back(msg);
+      overflow_size.fetch_add(1, std::memory_order_release);
+    }
+    return true;
   };
 
   /**
    *
    */
   rofl::openflow::cofmsg *retrieve() {
-    rofl::openflow::cofmsg *msg = (rofl::openflow::cofmsg *)0;
-    AcquireReadWriteLock rwlock(queue_lock);
-    if (queue.empty()) {
+    rofl::openflow::cofmsg *msg = nullptr;
+    if (ring_pop(&msg)) {
+      return msg;
+    }
+    if (overflow_size.load(std::memory_order_acquire) == 0) {
       return msg;
     }
-    msg = queue.front();
-    queue.pop_front();
+    AcquireReadWriteLock rwlock(overflow_lock);
+    if (overflow.empty()) {
+      return msg;
+    }
+    msg = overflow.front();
+    overflow.pop_front();
+    overflow_size.fetch_sub(1, std::memory_order_release);
     return msg;
   };
 
   /**
-   *
+   * @brief	Returns next message without removing it, see pop()
    */
   rofl::openflow::cofmsg *front() {
-    rofl::openflow::cofmsg *msg = (rofl::openflow::cofmsg *)0;
-    AcquireReadWriteLock rwlock(queue_lock);
-    if (queue.empty()) {
-      return msg;
+    front_state = FRONT_NONE;
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    cslot &slot = ring[pos & ring_mask];
+    if (slot.sequence.load(std::memory_order_acquire) == pos + 1) {
+      front_state = FRONT_RING;
+      return slot.msg;
     }
-    msg = queue.front();
-    return msg;
+    if (overflow_size.load(std::memory_order_acquire) == 0) {
+      return nullptr;
+    }
+    AcquireReadLock rwlock(overflow_lock);
+    if (overflow.empty()) {
+      return nullptr;
+    }
+    front_state = FRONT_OVERFLOW;
+    return overflow.front();
   };
 
   /**
+   * @brief	Removes the message returned by the preceding front() call
    *
+   * A producer may fill the ring after front() has returned the head of
+   * the overflow list, so pop() removes the message from where front()
+   * found it instead of retrieving the next one.
    */
   void pop() {
-    AcquireReadWriteLock rwlock(queue_lock);
-    if (queue.empty()) {
-      return;
+    rofl::openflow::cofmsg *msg = nullptr;
+    switch (front_state) {
+    case FRONT_RING: {
+      ring_pop(&msg);
+    } break;
+    case FRONT_OVERFLOW: {
+      AcquireReadWriteLock rwlock(overflow_lock);
+      overflow.pop_front();
+      overflow_size.fetch_sub(1, std::memory_order_release);
+    } break;
+    default: { retrieve(); };
     }
-    queue.pop_front();
+    front_state = FRONT_NONE;
   };
 
   /**
    *
    */
   size_t capacity() const {
-    AcquireReadLock rwlock(queue_lock);
-    return (queue.size() < queue_max_size) ? (queue_max_size - queue.size())
-                                           : 0;
+    size_t queue_size = size();
+    return (queue_size < queue_max_size) ? (queue_max_size - queue_size) : 0;
   };
 
 public:
@@ -168,24 +239,112 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Returns number of slots in lock-free ring buffer
+   */
+  size_t get_ring_size() const { return ring_mask + 1; };
+
 public:
   friend std::ostream &operator<<(std::ostream &os, const crofqueue &queue) {
-    AcquireReadLock rwlock(queue.queue_lock);
-    os << "<crofqueue size #" << queue.queue.size() << " >" << std::endl;
+    os << "<crofqueue size #" << queue.size()
+       << " overflow #" << queue.overflow_size << " >" << std::endl;
+    return os;
+  };
 
-    for (std::list<rofl::openflow::cofmsg *>::const_iterator it =
-             queue.queue.begin();
-         it != queue.queue.end(); ++it) {
-      os << *(*it);
+private:
+  bool ring_push(rofl::openflow::cofmsg *msg) {
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    cslot *slot;
+    while (true) {
+      slot = &ring[pos & ring_mask];
+      size_t seq = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        /* ring is full */
+        return false;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
     }
-    return os;
+    slot->msg = msg;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  };
+
+  bool ring_pop(rofl::openflow::cofmsg **msg) {
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    cslot *slot;
+    while (true) {
+      slot = &ring[pos & ring_mask];
+      size_t seq = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        /* ring is empty */
+        return false;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    *msg = slot->msg;
+    slot->sequence.store(pos + ring_mask + 1, std::memory_order_release);
+    return true;
   };
 
 private:
-  std::list<rofl::openflow::cofmsg *> queue;
-  mutable crwlock queue_lock;
+  crofqueue(const crofqueue &);
+
+  crofqueue &operator=(const crofqueue &);
+
+private:
+  struct cslot {
+    std::atomic<size_t> sequence;
+    rofl::openflow::cofmsg *msg;
+  };
+
+  enum front_state_t {
+    FRONT_NONE = 0,
+    FRONT_RING = 1,
+    FRONT_OVERFLOW = 2,
+  };
+
+  // maximum number of messages accepted by non-enforced store() calls
   size_t queue_max_size;
+
+  // lock-free ring buffer, size is a power of two
+  cslot *ring;
+
+  // ring size - 1
+  size_t ring_mask;
+
+  // next slot to be written by producers
+  alignas(64) std::atomic<size_t> enqueue_pos;
+
+  // next slot to be read by consumers
+  alignas(64) std::atomic<size_t> dequeue_pos;
+
+  // messages not fitting into ring
+  std::list<rofl::openflow::cofmsg *> overflow;
+
+  // number of messages in overflow list
+  alignas(64) std::atomic<size_t> overflow_size;
+
+  // protects overflow list
+  mutable crwlock overflow_lock;
+
+  // where the message returned by front() was found, consumer only
+  front_state_t front_state;
+
   static const size_t QUEUE_MAX_SIZE_DEFAULT = 128;
+
+  static const size_t RING_SIZE_DEFAULT = 256;
 };
 
 }; // end of namespace rofl
@@ -0,0 +1,607 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofshadow.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "rofl/common/crofshadow.hpp"
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_group_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_mod.h"
+#include "rofl/common/openflow/openflow.h"
+
+#include <glog/logging.h>
+#include <set>
+
+using namespace rofl;
+
+namespace {
+
+/* wire representation used for comparing entries */
+template <class T> rofl::cmemory packed(const T &obj) {
+  T tmp(obj);
+  rofl::cmemory mem(tmp.length());
+  if (mem.length() > 0)
+    tmp.pack(mem.somem(), mem.length());
+  return mem;
+}
+
+/* collects all action lists of a flow entry */
+std::list<const rofl::openflow::cofactions *>
+action_lists(const rofl::openflow::cofflowmod &entry) {
+  std::list<const rofl::openflow::cofactions *> lists;
+  if (entry.get_version() == rofl::openflow10::OFP_VERSION) {
+    lists.push_back(&entry.get_actions());
+  } else {
+    const rofl::openflow::cofinstructions &insts = entry.get_instructions();
+    if (insts.has_inst_apply_actions())
+      lists.push_back(&insts.get_inst_apply_actions().get_actions());
+    if (insts.has_inst_write_actions())
+      lists.push_back(&insts.get_inst_write_actions().get_actions());
+  }
+  return lists;
+}
+
+/* checks out_port and out_group filters of Flow-Mod-Delete messages */
+bool refers_to(const rofl::openflow::cofflowmod &entry, uint32_t out_port,
+               uint32_t out_group) {
+  bool is_of10 = (entry.get_version() == rofl::openflow10::OFP_VERSION);
+  bool port_found = (out_port == rofl::openflow::OFPP_ANY) ||
+                    (is_of10 && (out_port == rofl::openflow10::OFPP_NONE));
+  bool group_found = is_of10 || (out_group == rofl::openflow::OFPG_ANY);
+
+  std::list<const rofl::openflow::cofactions *> lists = action_lists(entry);
+  for (auto list : lists) {
+    for (auto it : list->get_actions()) {
+      const rofl::openflow::cofaction &action = *(it.second);
+      if (action.get_type() == rofl::openflow::OFPAT_OUTPUT) {
+        const rofl::openflow::cofaction_output &output =
+            dynamic_cast<const rofl::openflow::cofaction_output &>(action);
+        port_found = port_found || (output.get_port_no() == out_port);
+      } else if (action.get_type() == rofl::openflow::OFPAT_GROUP) {
+        const rofl::openflow::cofaction_group &group =
+            dynamic_cast<const rofl::openflow::cofaction_group &>(action);
+        group_found = group_found || (group.get_group_id() == out_group);
+      }
+    }
+  }
+  return (port_found && group_found);
+}
+
+/* ids of groups chained via Group actions in buckets */
+std::set<uint32_t> chained_groups(const rofl::openflow::cofbuckets &buckets) {
+  std::set<uint32_t> ids;
+  for (auto bucket_id : buckets.keys()) {
+    const rofl::openflow::cofbucket &bucket = buckets.get_bucket(bucket_id);
+    for (auto it : bucket.get_actions().get_actions()) {
+      if (it.second->get_type() != rofl::openflow::OFPAT_GROUP)
+        continue;
+      ids.insert(
+          dynamic_cast<const rofl::openflow::cofaction_group &>(*(it.second))
+              .get_group_id());
+    }
+  }
+  return ids;
+}
+
+/* depth first walk along group chains, chained groups come first */
+void chain_visit(uint32_t group_id,
+                 const std::map<uint32_t, rofl::openflow::cofmsg *> &mods,
+                 const std::map<uint32_t, std::set<uint32_t>> &chains,
+                 std::set<uint32_t> &visited,
+                 std::list<rofl::openflow::cofmsg *> &ordered) {
+  if (not visited.insert(group_id).second)
+    return;
+  auto ct = chains.find(group_id);
+  if (ct != chains.end()) {
+    for (auto chained : ct->second)
+      chain_visit(chained, mods, chains, visited, ordered);
+  }
+  auto mt = mods.find(group_id);
+  if (mt != mods.end())
+    ordered.push_back(mt->second);
+}
+
+/* orders Group-Mods so that a chained group is added before and deleted
+ * after all groups referring to it */
+std::list<rofl::openflow::cofmsg *>
+chain_order(const std::list<rofl::openflow::cofmsg *> &group_mods,
+            const std::map<uint32_t, std::set<uint32_t>> &chains,
+            bool deletion) {
+  std::map<uint32_t, rofl::openflow::cofmsg *> mods;
+  for (auto msg : group_mods) {
+    mods[dynamic_cast<rofl::openflow::cofmsg_group_mod &>(*msg)
+             .get_groupmod()
+             .get_group_id()] = msg;
+  }
+  std::set<uint32_t> visited;
+  std::list<rofl::openflow::cofmsg *> ordered;
+  for (auto it : mods)
+    chain_visit(it.first, mods, chains, visited, ordered);
+  if (deletion)
+    ordered.reverse();
+  return ordered;
+}
+
+}; // end of anonymous namespace
+
+crofshadow::cflowkey::cflowkey(uint8_t table_id, uint16_t priority,
+                               const rofl::openflow::cofmatch &match)
+    : table_id(table_id), priority(priority), match(packed(match)) {}
+
+crofshadow &crofshadow::set_version(uint8_t version) {
+  AcquireReadWriteLock rwlock(lock);
+  if (this->version != version) {
+    flows.clear();
+    groups.clear();
+    meters.clear();
+    this->version = version;
+  }
+  return *this;
+}
+
+void crofshadow::clear() {
+  AcquireReadWriteLock rwlock(lock);
+  flows.clear();
+  groups.clear();
+  meters.clear();
+}
+
+void crofshadow::record_flow_mod(const rofl::openflow::cofflowmod &flowmod) {
+  AcquireReadWriteLock rwlock(lock);
+
+  /* OpenFlow 1.0 lacks a table_id in Flow-Mod messages */
+  uint8_t table_id = (version == rofl::openflow10::OFP_VERSION)
+                         ? 0
+                         : flowmod.get_table_id();
+  cflowkey key(table_id, flowmod.get_priority(), flowmod.get_match());
+
+  switch (flowmod.get_command()) {
+  case rofl::openflow::OFPFC_ADD: {
+    rofl::openflow::cofflowmod &entry = flows[key];
+    entry = flowmod;
+    entry.set_table_id(table_id);
+    entry.set_cookie_mask(0);
+    entry.set_buffer_id(rofl::openflow::base::get_ofp_no_buffer(version));
+    entry.set_out_port(rofl::openflow::OFPP_ANY);
+    entry.set_out_group(rofl::openflow::OFPG_ANY);
+  } break;
+  case rofl::openflow::OFPFC_MODIFY:
+  case rofl::openflow::OFPFC_MODIFY_STRICT: {
+    bool strict =
+        (flowmod.get_command() == rofl::openflow::OFPFC_MODIFY_STRICT);
+    bool found = false;
+    if (strict) {
+      auto it = flows.find(key);
+      if ((it != flows.end()) && flow_selected(flowmod, it->second)) {
+        flow_apply_modify(flowmod, it->second);
+        found = true;
+      }
+    } else {
+      for (auto &it : flows) {
+        if (not flow_selected(flowmod, it.second))
+          continue;
+        flow_apply_modify(flowmod, it.second);
+        found = true;
+      }
+    }
+    /* OpenFlow 1.0 adds a new entry when no entry has been modified */
+    if ((not found) && (version == rofl::openflow10::OFP_VERSION)) {
+      rofl::openflow::cofflowmod &entry = flows[key];
+      entry = flowmod;
+      entry.set_command(rofl::openflow::OFPFC_ADD);
+      entry.set_table_id(table_id);
+      entry.set_buffer_id(rofl::openflow::base::get_ofp_no_buffer(version));
+      entry.set_out_port(rofl::openflow::OFPP_ANY);
+    }
+  } break;
+  case rofl::openflow::OFPFC_DELETE_STRICT: {
+    auto it = flows.find(key);
+    if ((it != flows.end()) && flow_selected(flowmod, it->second) &&
+        refers_to(it->second, flowmod.get_out_port(),
+                  flowmod.get_out_group())) {
+      flows.erase(it);
+    }
+  } break;
+  case rofl::openflow::OFPFC_DELETE: {
+    for (auto it = flows.begin(); it != flows.end();) {
+      if (flow_selected(flowmod, it->second) &&
+          refers_to(it->second, flowmod.get_out_port(),
+                    flowmod.get_out_group())) {
+        flows.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  } break;
+  default: {
+    VLOG(2) << "crofshadow::" << __FUNCTION__ << "() ignoring command "
+            << (unsigned int)flowmod.get_command();
+  };
+  }
+}
+
+void crofshadow::record_flow_removed(uint8_t table_id, uint16_t priority,
+                                     const rofl::openflow::cofmatch &match) {
+  AcquireReadWriteLock rwlock(lock);
+  if (version == rofl::openflow10::OFP_VERSION)
+    table_id = 0;
+  flows.erase(cflowkey(table_id, priority, match));
+}
+
+void crofshadow::record_group_mod(const rofl::openflow::cofgroupmod &groupmod) {
+  AcquireReadWriteLock rwlock(lock);
+
+  switch (groupmod.get_command()) {
+  case rofl::openflow::OFPGC_ADD:
+  case rofl::openflow::OFPGC_MODIFY: {
+    rofl::openflow::cofgroupmod &entry = groups[groupmod.get_group_id()];
+    entry = groupmod;
+    entry.set_command(rofl::openflow::OFPGC_ADD);
+  } break;
+  case rofl::openflow::OFPGC_DELETE: {
+    if (groupmod.get_group_id() == rofl::openflow::OFPG_ALL) {
+      groups.clear();
+    } else {
+      groups.erase(groupmod.get_group_id());
+    }
+  } break;
+  default: {
+    VLOG(2) << "crofshadow::" << __FUNCTION__ << "() ignoring command "
+            << (unsigned int)groupmod.get_command();
+  };
+  }
+}
+
+void crofshadow::record_meter_mod(
+    uint16_t command, uint16_t flags, uint32_t meter_id,
+    const rofl::openflow::cofmeter_bands &meter_bands) {
+  AcquireReadWriteLock rwlock(lock);
+
+  switch (command) {
+  case rofl::openflow13::OFPMC_ADD:
+  case rofl::openflow13::OFPMC_MODIFY: {
+    meters[meter_id] = rofl::openflow::cofmeter_config_reply(
+        version, flags, meter_id, meter_bands);
+  } break;
+  case rofl::openflow13::OFPMC_DELETE: {
+    if (meter_id == rofl::openflow13::OFPM_ALL) {
+      meters.clear();
+    } else {
+      meters.erase(meter_id);
+    }
+  } break;
+  default: {
+    VLOG(2) << "crofshadow::" << __FUNCTION__ << "() ignoring command "
+            << (unsigned int)command;
+  };
+  }
+}
+
+void crofshadow::record_message(rofl::openflow::cofmsg &msg) {
+  switch (msg.get_type()) {
+  case rofl::openflow::OFPT_FLOW_MOD: {
+    rofl::openflow::cofmsg_flow_mod *flow_mod =
+        dynamic_cast<rofl::openflow::cofmsg_flow_mod *>(&msg);
+    if (flow_mod != nullptr) {
+      record_flow_mod(flow_mod->get_flowmod());
+    } else {
+      /* e.g. rofl::openflow::cofmsg_stamped */
+      rofl::cmemory mem(msg.length());
+      msg.pack(mem.somem(), mem.length());
+      rofl::openflow::cofmsg_flow_mod decoded;
+      decoded.unpack(mem.somem(), mem.length());
+      record_flow_mod(decoded.get_flowmod());
+    }
+  } break;
+  case rofl::openflow::OFPT_GROUP_MOD: {
+    record_group_mod(
+        dynamic_cast<rofl::openflow::cofmsg_group_mod &>(msg).get_groupmod());
+  } break;
+  case rofl::openflow13::OFPT_METER_MOD: {
+    if (msg.get_version() < rofl::openflow13::OFP_VERSION)
+      break;
+    rofl::openflow::cofmsg_meter_mod &meter_mod =
+        dynamic_cast<rofl::openflow::cofmsg_meter_mod &>(msg);
+    record_meter_mod(meter_mod.get_command(), meter_mod.get_flags(),
+                     meter_mod.get_meter_id(), meter_mod.get_meter_bands());
+  } break;
+  case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+    if (msg.get_version() < rofl::openflow14::OFP_VERSION)
+      break;
+    rofl::openflow::cofmsg_bundle_add_message &bundle =
+        dynamic_cast<rofl::openflow::cofmsg_bundle_add_message &>(msg);
+    if (bundle.has_message())
+      record_message(
+          const_cast<rofl::openflow::cofmsg &>(bundle.get_message()));
+  } break;
+  default: {};
+  }
+}
+
+void crofshadow::record_frame(const rofl::cmemory &frame) {
+  if (frame.length() < sizeof(struct rofl::openflow::ofp_header))
+    return;
+  struct rofl::openflow::ofp_header *hdr =
+      (struct rofl::openflow::ofp_header *)frame.somem();
+
+  switch (hdr->type) {
+  case rofl::openflow::OFPT_FLOW_MOD: {
+    rofl::openflow::cofmsg_flow_mod msg;
+    msg.unpack(frame.somem(), frame.length());
+    record_message(msg);
+  } break;
+  case rofl::openflow::OFPT_GROUP_MOD: {
+    if (hdr->version < rofl::openflow12::OFP_VERSION)
+      break;
+    rofl::openflow::cofmsg_group_mod msg;
+    msg.unpack(frame.somem(), frame.length());
+    record_message(msg);
+  } break;
+  case rofl::openflow13::OFPT_METER_MOD: {
+    if (hdr->version < rofl::openflow13::OFP_VERSION)
+      break;
+    rofl::openflow::cofmsg_meter_mod msg;
+    msg.unpack(frame.somem(), frame.length());
+    record_message(msg);
+  } break;
+  case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+    if (hdr->version < rofl::openflow14::OFP_VERSION)
+      break;
+    rofl::openflow::cofmsg_bundle_add_message msg;
+    msg.unpack(frame.somem(), frame.length());
+    record_message(msg);
+  } break;
+  default: {};
+  }
+}
+
+bool crofshadow::has_flow(uint8_t table_id, uint16_t priority,
+                          const rofl::openflow::cofmatch &match) const {
+  AcquireReadLock rlock(lock);
+  if (version == rofl::openflow10::OFP_VERSION)
+    table_id = 0;
+  return (flows.find(cflowkey(table_id, priority, match)) != flows.end());
+}
+
+rofl::openflow::cofflowmod
+crofshadow::get_flow(uint8_t table_id, uint16_t priority,
+                     const rofl::openflow::cofmatch &match) const {
+  AcquireReadLock rlock(lock);
+  if (version == rofl::openflow10::OFP_VERSION)
+    table_id = 0;
+  auto it = flows.find(cflowkey(table_id, priority, match));
+  if (it == flows.end())
+    throw eShadowNotFound("crofshadow::get_flow() flow entry not found");
+  return it->second;
+}
+
+rofl::openflow::cofgroupmod crofshadow::get_group(uint32_t group_id) const {
+  AcquireReadLock rlock(lock);
+  auto it = groups.find(group_id);
+  if (it == groups.end())
+    throw eShadowNotFound("crofshadow::get_group() group entry not found");
+  return it->second;
+}
+
+rofl::openflow::cofmeter_config_reply
+crofshadow::get_meter(uint32_t meter_id) const {
+  AcquireReadLock rlock(lock);
+  auto it = meters.find(meter_id);
+  if (it == meters.end())
+    throw eShadowNotFound("crofshadow::get_meter() meter entry not found");
+  return it->second;
+}
+
+bool crofshadow::flow_selected(const rofl::openflow::cofflowmod &filter,
+                               const rofl::openflow::cofflowmod &entry) const {
+  if (version != rofl::openflow10::OFP_VERSION) {
+    if ((filter.get_table_id() !=
+         rofl::openflow::base::get_ofptt_all(version)) &&
+        (filter.get_table_id() != entry.get_table_id()))
+      return false;
+    uint64_t mask = filter.get_cookie_mask();
+    if ((entry.get_cookie() & mask) != (filter.get_cookie() & mask))
+      return false;
+  }
+
+  switch (filter.get_command()) {
+  case rofl::openflow::OFPFC_MODIFY_STRICT:
+  case rofl::openflow::OFPFC_DELETE_STRICT: {
+    /* match and priority have been compared via the index already */
+    return true;
+  };
+  default: {
+    /* all fields of the filter must be present in the entry with the
+     * same value, the entry may carry additional fields */
+    rofl::openflow::coxmatches lmatches(filter.get_match().get_matches());
+    rofl::openflow::coxmatches rmatches(entry.get_match().get_matches());
+    for (auto it : lmatches.get_matches()) {
+      auto jt = rmatches.get_matches().find(it.first);
+      if (jt == rmatches.get_matches().end())
+        return false;
+      if (it.second->length() != jt->second->length())
+        return false;
+      rofl::cmemory lmem(it.second->length());
+      rofl::cmemory rmem(jt->second->length());
+      it.second->pack(lmem.somem(), lmem.length());
+      jt->second->pack(rmem.somem(), rmem.length());
+      if (not(lmem == rmem))
+        return false;
+    }
+    return true;
+  };
+  }
+}
+
+void crofshadow::flow_apply_modify(const rofl::openflow::cofflowmod &flowmod,
+                                   rofl::openflow::cofflowmod &entry) const {
+  /* cookie, timeouts and flags are kept */
+  if (version == rofl::openflow10::OFP_VERSION) {
+    entry.set_actions(flowmod.get_actions());
+  } else {
+    entry.set_instructions() = flowmod.get_instructions();
+  }
+}
+
+bool crofshadow::flow_equals(
+    const rofl::openflow::cofflowmod &entry,
+    const rofl::openflow::cofflow_stats_reply &stats) const {
+  if (entry.get_cookie() != stats.get_cookie())
+    return false;
+  if (version == rofl::openflow10::OFP_VERSION)
+    return (packed(entry.get_actions()) == packed(stats.get_actions()));
+  return (packed(entry.get_instructions()) ==
+          packed(stats.get_instructions()));
+}
+
+std::list<rofl::openflow::cofmsg *>
+crofshadow::reconcile(
+    const rofl::openflow::cofflowstatsarray &dumped_flows,
+    const rofl::openflow::cofgroupdescstatsarray &dumped_groups,
+    const rofl::openflow::cofmeterconfigarray &dumped_meters) {
+  AcquireReadWriteLock rwlock(lock);
+
+  std::list<rofl::openflow::cofmsg *> group_adds, group_dels;
+  std::list<rofl::openflow::cofmsg *> meter_adds, meter_dels;
+  std::list<rofl::openflow::cofmsg *> flow_adds, flow_dels;
+
+  try {
+    /* groups */
+    std::map<uint32_t, const rofl::openflow::cofgroup_desc_stats_reply *>
+        dgroups;
+    for (auto group_id : dumped_groups.keys()) {
+      dgroups[group_id] = &dumped_groups.get_group_desc_stats(group_id);
+    }
+    for (auto &it : groups) {
+      auto jt = dgroups.find(it.first);
+      if (jt == dgroups.end()) {
+        rofl::openflow::cofgroupmod ge(it.second);
+        ge.set_command(rofl::openflow::OFPGC_ADD);
+        group_adds.push_back(
+            new rofl::openflow::cofmsg_group_mod(version, 0, ge));
+      } else if ((jt->second->get_group_type() != it.second.get_type()) ||
+                 (packed(jt->second->get_buckets()) !=
+                  packed(it.second.get_buckets()))) {
+        rofl::openflow::cofgroupmod ge(it.second);
+        ge.set_command(rofl::openflow::OFPGC_MODIFY);
+        group_adds.push_back(
+            new rofl::openflow::cofmsg_group_mod(version, 0, ge));
+      }
+    }
+    for (auto &jt : dgroups) {
+      if (groups.find(jt.first) != groups.end())
+        continue;
+      rofl::openflow::cofgroupmod ge(version, rofl::openflow::OFPGC_DELETE,
+                                     jt.second->get_group_type(), jt.first);
+      group_dels.push_back(
+          new rofl::openflow::cofmsg_group_mod(version, 0, ge));
+    }
+
+    /* groups chained to other groups must exist on the datapath first */
+    std::map<uint32_t, std::set<uint32_t>> chains, dchains;
+    for (auto &it : groups)
+      chains[it.first] = chained_groups(it.second.get_buckets());
+    for (auto &jt : dgroups)
+      dchains[jt.first] = chained_groups(jt.second->get_buckets());
+    group_adds = chain_order(group_adds, chains, false);
+    group_dels = chain_order(group_dels, dchains, true);
+
+    /* meters */
+    std::map<uint32_t, const rofl::openflow::cofmeter_config_reply *> dmeters;
+    for (auto index : dumped_meters.keys()) {
+      const rofl::openflow::cofmeter_config_reply &mc =
+          dumped_meters.get_meter_config(index);
+      dmeters[mc.get_meter_id()] = &mc;
+    }
+    for (auto &it : meters) {
+      auto jt = dmeters.find(it.first);
+      uint16_t command = rofl::openflow13::OFPMC_ADD;
+      if (jt != dmeters.end()) {
+        if ((jt->second->get_flags() == it.second.get_flags()) &&
+            (packed(jt->second->get_meter_bands()) ==
+             packed(it.second.get_meter_bands())))
+          continue;
+        command = rofl::openflow13::OFPMC_MODIFY;
+      }
+      meter_adds.push_back(new rofl::openflow::cofmsg_meter_mod(
+          version, 0, command, it.second.get_flags(), it.first,
+          it.second.get_meter_bands()));
+    }
+    for (auto &jt : dmeters) {
+      if (meters.find(jt.first) != meters.end())
+        continue;
+      meter_dels.push_back(new rofl::openflow::cofmsg_meter_mod(
+          version, 0, rofl::openflow13::OFPMC_DELETE, 0, jt.first,
+          rofl::openflow::cofmeter_bands(version)));
+    }
+
+    /* flows */
+    std::map<cflowkey, const rofl::openflow::cofflow_stats_reply *> dflows;
+    for (auto flow_id : dumped_flows.keys()) {
+      const rofl::openflow::cofflow_stats_reply &fs =
+          dumped_flows.get_flow_stats(flow_id);
+      uint8_t table_id = (version == rofl::openflow10::OFP_VERSION)
+                             ? 0
+                             : fs.get_table_id();
+      dflows[cflowkey(table_id, fs.get_priority(), fs.get_match())] = &fs;
+    }
+    for (auto &jt : dflows) {
+      if (flows.find(jt.first) != flows.end())
+        continue;
+      rofl::openflow::cofflowmod fe(version);
+      fe.set_command(rofl::openflow::OFPFC_DELETE_STRICT);
+      fe.set_table_id(jt.second->get_table_id());
+      fe.set_priority(jt.second->get_priority());
+      fe.set_match(jt.second->get_match());
+      flow_dels.push_back(new rofl::openflow::cofmsg_flow_mod(version, 0, fe));
+    }
+    for (auto it = flows.begin(); it != flows.end();) {
+      auto jt = dflows.find(it->first);
+      if (jt == dflows.end()) {
+        if ((it->second.get_idle_timeout() != 0) ||
+            (it->second.get_hard_timeout() != 0)) {
+          /* expired meanwhile */
+          flows.erase(it++);
+          continue;
+        }
+      } else if (flow_equals(it->second, *(jt->second))) {
+        ++it;
+        continue;
+      }
+      /* Flow-Mod-Add replaces an entry with identical match and priority */
+      flow_adds.push_back(
+          new rofl::openflow::cofmsg_flow_mod(version, 0, it->second));
+      ++it;
+    }
+
+  } catch (...) {
+    for (auto msg : group_adds)
+      delete msg;
+    for (auto msg : meter_adds)
+      delete msg;
+    for (auto msg : flow_dels)
+      delete msg;
+    for (auto msg : flow_adds)
+      delete msg;
+    for (auto msg : meter_dels)
+      delete msg;
+    for (auto msg : group_dels)
+      delete msg;
+    throw;
+  }
+
+  std::list<rofl::openflow::cofmsg *> msgs;
+  msgs.splice(msgs.end(), group_adds);
+  msgs.splice(msgs.end(), meter_adds);
+  msgs.splice(msgs.end(), flow_dels);
+  msgs.splice(msgs.end(), flow_adds);
+  msgs.splice(msgs.end(), meter_dels);
+  msgs.splice(msgs.end(), group_dels);
+  return msgs;
+}
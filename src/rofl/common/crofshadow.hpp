@@ -0,0 +1,265 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofshadow.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CROFSHADOW_HPP_
+#define SRC_ROFL_COMMON_CROFSHADOW_HPP_
+
+#include <inttypes.h>
+
+#include <iostream>
+#include <list>
+#include <map>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/locking.hpp"
+#include "rofl/common/openflow/cofflowmod.h"
+#include "rofl/common/openflow/cofflowstatsarray.h"
+#include "rofl/common/openflow/cofgroupdescstatsarray.h"
+#include "rofl/common/openflow/cofgroupmod.h"
+#include "rofl/common/openflow/cofmeterbands.h"
+#include "rofl/common/openflow/cofmeterconfig.h"
+#include "rofl/common/openflow/cofmeterconfigarray.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+
+class eShadowBase : public exception {
+public:
+  eShadowBase(const std::string &__arg) : exception(__arg){};
+};
+class eShadowNotFound : public eShadowBase {
+public:
+  eShadowNotFound(const std::string &__arg) : eShadowBase(__arg){};
+};
+
+/**
+ * @brief	Controller-side shadow of the flow, group and meter tables
+ * of a datapath element
+ *
+ * Records the state an application intends to install on a datapath
+ * element by replaying all Flow-Mod, Group-Mod and Meter-Mod messages
+ * sent to it. Flow entries are indexed by (table_id, priority, match)
+ * like on the datapath element itself. After a reconnect, reconcile()
+ * compares the shadow with the tables dumped from the datapath element
+ * and returns only those messages required for restoring the intended
+ * state.
+ *
+ * Flow entries with idle or hard timeout are not reinstalled when missing
+ * on the datapath element, as they have most likely expired. Until then,
+ * expired entries are dropped from the shadow only when a Flow-Removed
+ * message is received for them.
+ */
+class crofshadow {
+public:
+  /**
+   *
+   */
+  ~crofshadow(){};
+
+  /**
+   *
+   */
+  crofshadow(uint8_t version = rofl::openflow::OFP_VERSION_UNKNOWN)
+      : version(version){};
+
+public:
+  /**
+   *
+   */
+  uint8_t get_version() const { return version; };
+
+  /**
+   * @brief	Sets OpenFlow version, all entries are dropped when the
+   * version changes
+   */
+  crofshadow &set_version(uint8_t version);
+
+  /**
+   * @brief	Drops all flow, group and meter entries
+   */
+  void clear();
+
+  /**
+   *
+   */
+  size_t size_flows() const {
+    AcquireReadLock rlock(lock);
+    return flows.size();
+  };
+
+  /**
+   *
+   */
+  size_t size_groups() const {
+    AcquireReadLock rlock(lock);
+    return groups.size();
+  };
+
+  /**
+   *
+   */
+  size_t size_meters() const {
+    AcquireReadLock rlock(lock);
+    return meters.size();
+  };
+
+public:
+  /**
+   * @brief	Applies a Flow-Mod message to the shadow flow tables
+   */
+  void record_flow_mod(const rofl::openflow::cofflowmod &flowmod);
+
+  /**
+   * @brief	Drops a flow entry removed by the datapath element
+   */
+  void record_flow_removed(uint8_t table_id, uint16_t priority,
+                           const rofl::openflow::cofmatch &match);
+
+  /**
+   * @brief	Applies a Group-Mod message to the shadow group table
+   */
+  void record_group_mod(const rofl::openflow::cofgroupmod &groupmod);
+
+  /**
+   * @brief	Applies a Meter-Mod message to the shadow meter table
+   */
+  void record_meter_mod(uint16_t command, uint16_t flags, uint32_t meter_id,
+                        const rofl::openflow::cofmeter_bands &meter_bands);
+
+  /**
+   * @brief	Applies a Flow-Mod, Group-Mod, Meter-Mod or
+   * Bundle-Add-Message, other message types are ignored
+   *
+   * Messages without a decoded representation, e.g.
+   * rofl::openflow::cofmsg_stamped, are decoded from their wire image.
+   */
+  void record_message(rofl::openflow::cofmsg &msg);
+
+  /**
+   * @brief	Applies a message given in wire format, see record_message()
+   *
+   * Used for messages handed over to a transmission queue, which may
+   * already have been sent and destroyed when recording them.
+   */
+  void record_frame(const rofl::cmemory &frame);
+
+public:
+  /**
+   *
+   */
+  bool has_flow(uint8_t table_id, uint16_t priority,
+                const rofl::openflow::cofmatch &match) const;
+
+  /**
+   * @brief	Returns a copy of a shadow flow entry, throws eShadowNotFound
+   */
+  rofl::openflow::cofflowmod
+  get_flow(uint8_t table_id, uint16_t priority,
+           const rofl::openflow::cofmatch &match) const;
+
+  /**
+   *
+   */
+  bool has_group(uint32_t group_id) const {
+    AcquireReadLock rlock(lock);
+    return (groups.find(group_id) != groups.end());
+  };
+
+  /**
+   * @brief	Returns a copy of a shadow group entry, throws eShadowNotFound
+   */
+  rofl::openflow::cofgroupmod get_group(uint32_t group_id) const;
+
+  /**
+   *
+   */
+  bool has_meter(uint32_t meter_id) const {
+    AcquireReadLock rlock(lock);
+    return (meters.find(meter_id) != meters.end());
+  };
+
+  /**
+   * @brief	Returns a copy of a shadow meter entry, throws eShadowNotFound
+   */
+  rofl::openflow::cofmeter_config_reply get_meter(uint32_t meter_id) const;
+
+public:
+  /**
+   * @brief	Computes the messages restoring the shadow state on a
+   * datapath element
+   *
+   * Messages are returned in sending order: Group-Mods and Meter-Mods
+   * adding or modifying entries, Flow-Mods deleting unknown entries,
+   * Flow-Mods adding missing or modifying changed entries and finally
+   * Meter-Mods and Group-Mods deleting unknown entries. Ownership of all
+   * messages is transferred to the caller, transaction ids are left 0.
+   * Shadow entries with timeouts missing on the datapath element are
+   * dropped from the shadow.
+   *
+   * @param flows flow entries dumped from the datapath element
+   * @param groups group entries dumped from the datapath element
+   * @param meters meter entries dumped from the datapath element
+   */
+  std::list<rofl::openflow::cofmsg *>
+  reconcile(const rofl::openflow::cofflowstatsarray &flows,
+            const rofl::openflow::cofgroupdescstatsarray &groups,
+            const rofl::openflow::cofmeterconfigarray &meters);
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const crofshadow &shadow) {
+    os << "<crofshadow version: " << (unsigned int)shadow.get_version()
+       << " #flows: " << shadow.size_flows()
+       << " #groups: " << shadow.size_groups()
+       << " #meters: " << shadow.size_meters() << " >" << std::endl;
+    return os;
+  };
+
+private:
+  /**
+   * @brief	Index of a flow entry: table_id, priority and packed match
+   */
+  class cflowkey {
+  public:
+    cflowkey(uint8_t table_id, uint16_t priority,
+             const rofl::openflow::cofmatch &match);
+
+    bool operator<(const cflowkey &key) const {
+      if (table_id != key.table_id)
+        return (table_id < key.table_id);
+      if (priority != key.priority)
+        return (priority < key.priority);
+      return (match < key.match);
+    };
+
+    uint8_t table_id;
+    uint16_t priority;
+    rofl::cmemory match;
+  };
+
+  bool flow_selected(const rofl::openflow::cofflowmod &filter,
+                     const rofl::openflow::cofflowmod &entry) const;
+
+  void flow_apply_modify(const rofl::openflow::cofflowmod &flowmod,
+                         rofl::openflow::cofflowmod &entry) const;
+
+  bool flow_equals(const rofl::openflow::cofflowmod &entry,
+                   const rofl::openflow::cofflow_stats_reply &stats) const;
+
+  uint8_t version;
+  mutable crwlock lock;
+  std::map<cflowkey, rofl::openflow::cofflowmod> flows;
+  std::map<uint32_t, rofl::openflow::cofgroupmod> groups;
+  std::map<uint32_t, rofl::openflow::cofmeter_config_reply> meters;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CROFSHADOW_HPP_ */
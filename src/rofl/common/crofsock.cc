@@ -12,12 +12,22 @@
 
 #include "crofsock.h"
 
+#include <endian.h>
 #include <glog/logging.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+
+#ifdef __linux__
+#include <linux/tls.h>
+#endif
+
+#if defined(TCP_ULP) && defined(SOL_TLS) && defined(TLS_TX)
+#define ROFL_HAVE_KTLS 1
+#endif
 
 using namespace rofl;
 
-/*static*/ std::set<crofsock_env *> crofsock_env::socket_envs;
-/*static*/ crwlock crofsock_env::socket_envs_lock;
+/*static*/ cenvs<crofsock_env> crofsock_env::socket_envs;
 /*static*/ crwlock crofsock::rwlock;
 /*static*/ bool crofsock::tls_initialized = false;
 
@@ -39,18 +49,29 @@ crofsock::crofsock(crofsock_env *env)
       ciphers("EECDH+ECDSA+AESGCM EECDH+aRSA+AESGCM EECDH+ECDSA+SHA256 "
               "EECDH+aRSA+RC4 EDH+aRSA EECDH RC4 !aNULL !eNULL !LOW !3DES !MD5 "
               "!EXP !PSK !SRP !DSS"),
-      rx_fragment_pending(false), rxbuffer((size_t)65536), msg_bytes_read(0),
-      max_pkts_rcvd_per_round(0), rx_disabled(false), tx_disabled(false),
+      tls_ktls(false), ktls_tx(false), ktls_rx(false),
+      rx_fragment_pending(false),
+      rxbuffer(new cmemory((size_t)RXBUFFER_SIZE)), msg_bytes_read(0),
+      max_pkts_rcvd_per_round(DEFAULT_MAX_PKTS_RVCD_PER_ROUND),
+      rx_streaming(true), rx_lazy_decoding(false), rx_offset(0),
+      rx_bytes_pending(0), rx_disabled(false), tx_disabled(false),
       txqueue_pending_pkts(0), txqueue_size_congestion_occured(0),
       txqueue_size_tx_threshold(0), txqueues(QUEUE_MAX), txweights(QUEUE_MAX),
-      tx_is_running(false), tx_fragment_pending(false), txbuffer((size_t)65536),
-      msg_bytes_sent(0), txlen(0) {
+      tx_is_running(false), tx_fragment_pending(false), txbuffer(TXBUFFER_SIZE),
+      msg_bytes_sent(0), txlen(0), tx_batching(true), tx_msgs_sent(0),
+      tx_sched_queue_id(0), tx_sched_num(0) {
   /* scheduler weights for transmission */
   txweights[QUEUE_OAM] = 16;
   txweights[QUEUE_MGMT] = 32;
   txweights[QUEUE_FLOW] = 16;
   txweights[QUEUE_PKT] = 8;
 
+  clear_rx_passthrough();
+
+  /* share a cthread_pool worker with our environment, if pooled */
+  rxthread.set_affinity(env);
+  txthread.set_affinity(env);
+
   rxthread.start("crofsock_rx");
   txthread.start("crofsock_tx");
 }
@@ -66,6 +87,12 @@ void crofsock::close() {
     rx_disabled = false;
     tx_disabled = false;
 
+    /* drop any partially received message */
+    rx_fragment_pending = false;
+    msg_bytes_read = 0;
+    rx_offset = 0;
+    rx_bytes_pending = 0;
+
   } break;
   case STATE_CLOSED: {
 
@@ -208,10 +235,20 @@ void crofsock::close() {
     rx_disable();
     tx_disable();
 
-    if (ssl) {
-      SSL_shutdown(ssl);
-      SSL_free(ssl);
-      ssl = NULL;
+    {
+      AcquireReadWriteLock lock(tls_lock);
+      if (ktls_tx) {
+        /* OpenSSL's record state is stale, let the kernel send the alert */
+        tls_ktls_close_notify();
+      } else if (ssl) {
+        SSL_shutdown(ssl);
+      }
+      if (ssl) {
+        SSL_free(ssl);
+        ssl = NULL;
+      }
+      ktls_tx = false;
+      ktls_rx = false;
     }
     tls_destroy_context();
     flag_set(FLAG_TLS_IN_USE, false);
@@ -233,8 +270,8 @@ void crofsock::listen() {
   }
 
   /* remove all pending messages from tx queues */
-  for (auto queue : txqueues) {
-    queue.clear();
+  for (auto &queue : txqueues) {
+    txqueue_pending_pkts -= queue.clear();
   }
 
   /* cancel potentially pending reconnect timer */
@@ -355,8 +392,8 @@ void crofsock::tcp_accept(int sd) {
   this->sd = sd;
 
   /* remove all pending messages from tx queues */
-  for (auto queue : txqueues) {
-    queue.clear();
+  for (auto &queue : txqueues) {
+    txqueue_pending_pkts -= queue.clear();
   }
 
   /* cancel potentially pending reconnect timer */
@@ -380,10 +417,12 @@ void crofsock::tcp_accept(int sd) {
     throw eSysCall("eSysCall", "fcntl (F_GETFL)", __FILE__, __FUNCTION__,
                    __LINE__);
   }
-  sockflags |= O_NONBLOCK;
-  if ((::fcntl(sd, F_SETFL, sockflags)) < 0) {
-    throw eSysCall("eSysCall", "fcntl (F_SETFL)", __FILE__, __FUNCTION__,
-                   __LINE__);
+  if (not(sockflags & O_NONBLOCK)) {
+    sockflags |= O_NONBLOCK;
+    if ((::fcntl(sd, F_SETFL, sockflags)) < 0) {
+      throw eSysCall("eSysCall", "fcntl (F_SETFL)", __FILE__, __FUNCTION__,
+                     __LINE__);
+    }
   }
 
   socklen_t optlen = 0;
@@ -480,8 +519,8 @@ void crofsock::tcp_connect(bool reconnect) {
   }
 
   /* remove all pending messages from tx queues */
-  for (auto queue : txqueues) {
-    queue.clear();
+  for (auto &queue : txqueues) {
+    txqueue_pending_pkts -= queue.clear();
   }
 
   /* cancel potentially pending reconnect timer */
@@ -837,6 +876,8 @@ void crofsock::tls_accept(int sockfd) {
 
       VLOG(2) << __FUNCTION__ << " TLS: accept succeeded";
 
+      tls_setup_data_path();
+
       state = STATE_TLS_ESTABLISHED;
 
       crofsock_env::call_env(env).handle_tls_accepted(*this);
@@ -960,6 +1001,8 @@ void crofsock::tls_connect(bool reconnect) {
 
       VLOG(2) << __FUNCTION__ << " TLS: connect succeeded";
 
+      tls_setup_data_path();
+
       state = STATE_TLS_ESTABLISHED;
 
       crofsock_env::call_env(env).handle_tls_connected(*this);
@@ -1191,6 +1234,250 @@ void crofsock::tls_log_errors() {
   BIO_free(ebio);
 }
 
+void crofsock::tls_setup_data_path() {
+  ktls_tx = false;
+  ktls_rx = false;
+
+  /* records may carry up to 16KiB of plaintext, send_from_queue() hands
+   * over a whole batch of messages per SSL_write() call, and short writes
+   * are accounted for like short sends on a plain socket */
+  SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE |
+                        SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+  if (tls_ktls && tls_ktls_setup()) {
+    VLOG(2) << __FUNCTION__ << " TLS: kernel offload tx=" << ktls_tx
+            << " rx=" << ktls_rx << " laddr=" << laddr.str()
+            << " raddr=" << raddr.str();
+  }
+
+  /* OpenSSL decrypts: fill its buffer with as many records as available
+   * per read() */
+  if (not ktls_rx) {
+    SSL_set_read_ahead(ssl, 1);
+  }
+}
+
+#ifdef ROFL_HAVE_KTLS
+namespace {
+
+union ktls_crypto_info {
+  struct tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+  struct tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+};
+
+/* derives the record protection parameters for one direction of an
+ * established TLS 1.2 AES-GCM session (RFC 5246 section 6.3) */
+bool ktls_crypto_info_get(SSL *ssl, bool tx, ktls_crypto_info &info,
+                          size_t &infolen) {
+  if (SSL_version(ssl) != TLS1_2_VERSION)
+    return false;
+
+  const SSL_CIPHER *cipher = SSL_get_current_cipher(ssl);
+  if (cipher == NULL)
+    return false;
+
+  size_t keylen = 0;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm: {
+    keylen = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+  } break;
+  case NID_aes_256_gcm: {
+    keylen = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+  } break;
+  default:
+    return false;
+  }
+  const size_t saltlen = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+
+  uint8_t master[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t masterlen =
+      SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+
+  uint8_t client_random[SSL3_RANDOM_SIZE];
+  uint8_t server_random[SSL3_RANDOM_SIZE];
+  SSL_get_client_random(ssl, client_random, sizeof(client_random));
+  SSL_get_server_random(ssl, server_random, sizeof(server_random));
+
+  /* key block: client key, server key, client salt, server salt */
+  uint8_t keyblock[2 * TLS_CIPHER_AES_GCM_256_KEY_SIZE + 2 * saltlen];
+  size_t keyblocklen = 2 * keylen + 2 * saltlen;
+
+  EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, NULL);
+  bool ok = (pctx != NULL) && (EVP_PKEY_derive_init(pctx) > 0) &&
+            (EVP_PKEY_CTX_set_tls1_prf_md(
+                 pctx, SSL_CIPHER_get_handshake_digest(cipher)) > 0) &&
+            (EVP_PKEY_CTX_set1_tls1_prf_secret(pctx, master, masterlen) > 0) &&
+            (EVP_PKEY_CTX_add1_tls1_prf_seed(
+                 pctx, (const unsigned char *)"key expansion", 13) > 0) &&
+            (EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, server_random,
+                                             sizeof(server_random)) > 0) &&
+            (EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, client_random,
+                                             sizeof(client_random)) > 0) &&
+            (EVP_PKEY_derive(pctx, keyblock, &keyblocklen) > 0);
+  EVP_PKEY_CTX_free(pctx);
+  OPENSSL_cleanse(master, sizeof(master));
+  if (not ok)
+    return false;
+
+  bool client_keys = (tx != (SSL_is_server(ssl) != 0));
+  const uint8_t *key = keyblock + (client_keys ? 0 : keylen);
+  const uint8_t *salt = keyblock + 2 * keylen + (client_keys ? 0 : saltlen);
+
+  /* the Finished message was the only record sent in either direction
+   * with the new keys, OpenSSL uses the sequence number as explicit
+   * nonce */
+  uint64_t seq = htobe64(1);
+
+  memset(&info, 0, sizeof(info));
+  if (keylen == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+    info.aes_gcm_128.info.version = TLS_1_2_VERSION;
+    info.aes_gcm_128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    memcpy(info.aes_gcm_128.key, key, keylen);
+    memcpy(info.aes_gcm_128.salt, salt, saltlen);
+    memcpy(info.aes_gcm_128.iv, &seq, sizeof(seq));
+    memcpy(info.aes_gcm_128.rec_seq, &seq, sizeof(seq));
+    infolen = sizeof(info.aes_gcm_128);
+  } else {
+    info.aes_gcm_256.info.version = TLS_1_2_VERSION;
+    info.aes_gcm_256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+    memcpy(info.aes_gcm_256.key, key, keylen);
+    memcpy(info.aes_gcm_256.salt, salt, saltlen);
+    memcpy(info.aes_gcm_256.iv, &seq, sizeof(seq));
+    memcpy(info.aes_gcm_256.rec_seq, &seq, sizeof(seq));
+    infolen = sizeof(info.aes_gcm_256);
+  }
+  OPENSSL_cleanse(keyblock, sizeof(keyblock));
+
+  return true;
+}
+
+}; // end of anonymous namespace
+#endif
+
+bool crofsock::tls_ktls_setup() {
+#ifdef ROFL_HAVE_KTLS
+  ktls_crypto_info tx_info, rx_info;
+  size_t tx_infolen = 0, rx_infolen = 0;
+
+  /* read_ahead must be off, no record beyond Finished may be buffered */
+  if ((SSL_get_read_ahead(ssl)) || (SSL_pending(ssl) > 0) ||
+      (not ktls_crypto_info_get(ssl, true, tx_info, tx_infolen)) ||
+      (not ktls_crypto_info_get(ssl, false, rx_info, rx_infolen))) {
+    VLOG(2) << __FUNCTION__ << " TLS: session not suitable for kernel offload";
+    return false;
+  }
+
+  if (::setsockopt(sd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) < 0) {
+    VLOG(2) << __FUNCTION__ << " TLS: TCP_ULP not available, error: " << errno
+            << ": " << strerror(errno);
+    OPENSSL_cleanse(&tx_info, sizeof(tx_info));
+    OPENSSL_cleanse(&rx_info, sizeof(rx_info));
+    return false;
+  }
+
+  /* without TLS_TX/TLS_RX parameters the socket still acts as plain TCP
+   * socket, so each direction may fall back to OpenSSL on its own */
+  ktls_tx = (::setsockopt(sd, SOL_TLS, TLS_TX, &tx_info, tx_infolen) == 0);
+  ktls_rx = (::setsockopt(sd, SOL_TLS, TLS_RX, &rx_info, rx_infolen) == 0);
+
+  OPENSSL_cleanse(&tx_info, sizeof(tx_info));
+  OPENSSL_cleanse(&rx_info, sizeof(rx_info));
+
+  return (ktls_tx || ktls_rx);
+#else
+  return false;
+#endif
+}
+
+void crofsock::tls_ktls_close_notify() {
+#ifdef ROFL_HAVE_KTLS
+  uint8_t alert[2] = {1 /* warning */, 0 /* close_notify */};
+  uint8_t cbuf[CMSG_SPACE(sizeof(uint8_t))];
+
+  struct iovec iov;
+  iov.iov_base = alert;
+  iov.iov_len = sizeof(alert);
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = cbuf;
+  msg.msg_controllen = sizeof(cbuf);
+
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = 21; /* alert */
+
+  ::sendmsg(sd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+#endif
+}
+
+ssize_t crofsock::tls_result(int rc) {
+  switch (SSL_get_error(ssl, rc)) {
+  case SSL_ERROR_WANT_READ:
+  case SSL_ERROR_WANT_WRITE: {
+    errno = EAGAIN;
+  }
+    return -1;
+  case SSL_ERROR_ZERO_RETURN: {
+    /* close_notify from peer */
+  }
+    return 0;
+  case SSL_ERROR_SYSCALL: {
+    /* session is unusable, do not send close_notify on shutdown */
+    SSL_set_quiet_shutdown(ssl, 1);
+    if (errno == 0)
+      return 0;
+  }
+    return -1;
+  default: {
+    tls_log_errors();
+    SSL_set_quiet_shutdown(ssl, 1);
+    errno = EPROTO;
+  }
+    return -1;
+  }
+}
+
+ssize_t crofsock::sock_recv(void *buf, size_t len) {
+  if ((STATE_TLS_ESTABLISHED != state) || ktls_rx) {
+    return ::recv(sd, buf, len, MSG_DONTWAIT);
+  }
+
+  AcquireReadWriteLock lock(tls_lock);
+  if (ssl == NULL) {
+    errno = ENOTCONN;
+    return -1;
+  }
+  ERR_clear_error();
+  errno = 0;
+  int rc = SSL_read(ssl, buf, len);
+  if (rc > 0)
+    return rc;
+  return tls_result(rc);
+}
+
+ssize_t crofsock::sock_send(const void *buf, size_t len) {
+  if ((STATE_TLS_ESTABLISHED != state) || ktls_tx) {
+    return ::send(sd, buf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+  }
+
+  AcquireReadWriteLock lock(tls_lock);
+  if (ssl == NULL) {
+    errno = ENOTCONN;
+    return -1;
+  }
+  ERR_clear_error();
+  errno = 0;
+  int rc = SSL_write(ssl, buf, len);
+  if (rc > 0)
+    return rc;
+  return tls_result(rc);
+}
+
 void crofsock::backoff_reconnect(bool reset_timeout) {
   if (rxthread.has_timer(TIMER_ID_RECONNECT)) {
     return;
@@ -1290,6 +1577,23 @@ void crofsock::handle_timeout(cthread &thread, uint32_t timer_id) {
 
 crofsock::msg_result_t crofsock::send_message(rofl::openflow::cofmsg *msg,
                                               bool enforce_queueing) {
+  msg_result_t result = try_send_message(msg, enforce_queueing);
+  /* message was not stored in txqueue and is deleted here */
+  if (msg != nullptr)
+    delete msg;
+  return result;
+}
+
+crofsock::msg_result_t crofsock::send_frame(const cslice &frame, uint32_t xid,
+                                            bool enforce_queueing) {
+  rofl::openflow::cofmsg_frame *msg = new rofl::openflow::cofmsg_frame(frame);
+  msg->set_xid(xid);
+  return send_message(msg, enforce_queueing);
+}
+
+crofsock::msg_result_t
+crofsock::try_send_message(rofl::openflow::cofmsg *&msg,
+                           bool enforce_queueing) {
 
   VLOG(3) << __FUNCTION__ << " msg=" << msg
           << " txqueue_pending_pkts=" << txqueue_pending_pkts
@@ -1297,17 +1601,12 @@ crofsock::msg_result_t crofsock::send_message(rofl::openflow::cofmsg *msg,
           << " tx_is_running=" << tx_is_running;
 
   if (tx_disabled) {
-    delete msg;
-    /* connection shutdown in progress, a very specific form of congestion ...,
-     * message is deleted */
+    /* connection shutdown in progress, a very specific form of congestion */
     return MSG_QUEUEING_FAILED_SHUTDOWN_IN_PROGRESS;
   }
 
   if ((state != STATE_TCP_ESTABLISHED) && (state != STATE_TLS_ESTABLISHED)) {
-
-    delete msg;
-
-    /* connection is not established: message is deleted */
+    /* connection is not established */
     return MSG_QUEUEING_FAILED_NOT_ESTABLISHED;
   }
 
@@ -1316,101 +1615,99 @@ crofsock::msg_result_t crofsock::send_message(rofl::openflow::cofmsg *msg,
     enforce_queueing = true;
   }
 
-  try {
-
-    /* enqueue the message in rofl's internal queue, as long
-     * as these are not exhausted */
-    switch (msg->get_version()) {
-    case rofl::openflow10::OFP_VERSION: {
-      switch (msg->get_type()) {
-      case rofl::openflow10::OFPT_PACKET_IN:
-      case rofl::openflow10::OFPT_PACKET_OUT: {
-        txqueues[QUEUE_PKT].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow10::OFPT_FLOW_MOD:
-      case rofl::openflow10::OFPT_FLOW_REMOVED:
-      case rofl::openflow10::OFPT_BARRIER_REPLY:
-      case rofl::openflow10::OFPT_BARRIER_REQUEST: {
-        txqueues[QUEUE_FLOW].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow10::OFPT_ECHO_REQUEST:
-      case rofl::openflow10::OFPT_ECHO_REPLY: {
-        txqueues[QUEUE_OAM].store(msg, enforce_queueing);
-      } break;
-      default: { txqueues[QUEUE_MGMT].store(msg, enforce_queueing); };
-      }
-    } break;
-    case rofl::openflow12::OFP_VERSION: {
-      switch (msg->get_type()) {
-      case rofl::openflow12::OFPT_PACKET_IN:
-      case rofl::openflow12::OFPT_PACKET_OUT: {
-        txqueues[QUEUE_PKT].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow12::OFPT_FLOW_MOD:
-      case rofl::openflow12::OFPT_FLOW_REMOVED:
-      case rofl::openflow12::OFPT_GROUP_MOD:
-      case rofl::openflow12::OFPT_PORT_MOD:
-      case rofl::openflow12::OFPT_TABLE_MOD:
-      case rofl::openflow12::OFPT_BARRIER_REPLY:
-      case rofl::openflow12::OFPT_BARRIER_REQUEST: {
-        txqueues[QUEUE_FLOW].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow12::OFPT_ECHO_REQUEST:
-      case rofl::openflow12::OFPT_ECHO_REPLY: {
-        txqueues[QUEUE_OAM].store(msg, enforce_queueing);
-      } break;
-      default: { txqueues[QUEUE_MGMT].store(msg, enforce_queueing); };
-      }
-    } break;
-    case rofl::openflow13::OFP_VERSION:
-    default: {
-      switch (msg->get_type()) {
-      case rofl::openflow13::OFPT_PACKET_IN:
-      case rofl::openflow13::OFPT_PACKET_OUT: {
-        txqueues[QUEUE_PKT].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow13::OFPT_FLOW_MOD:
-      case rofl::openflow13::OFPT_FLOW_REMOVED:
-      case rofl::openflow13::OFPT_GROUP_MOD:
-      case rofl::openflow13::OFPT_PORT_MOD:
-      case rofl::openflow13::OFPT_TABLE_MOD:
-      case rofl::openflow13::OFPT_BARRIER_REPLY:
-      case rofl::openflow13::OFPT_BARRIER_REQUEST: {
-        txqueues[QUEUE_FLOW].store(msg, enforce_queueing);
-      } break;
-      case rofl::openflow13::OFPT_ECHO_REQUEST:
-      case rofl::openflow13::OFPT_ECHO_REPLY: {
-        txqueues[QUEUE_OAM].store(msg, enforce_queueing);
-      } break;
-      default: { txqueues[QUEUE_MGMT].store(msg, enforce_queueing); };
-      }
-    };
-    }
-
-    txqueue_pending_pkts++;
-
-    if (not tx_is_running) {
-      txthread.wakeup();
-    }
-
-    if (flag_test(FLAG_TX_BLOCK_QUEUEING)) {
-      /* message was queued, but congestion prevents us from sending it */
-      return MSG_QUEUED_CONGESTION;
-    }
-
-    /* message was queued, waiting for transmission */
-    return MSG_QUEUED;
-
-  } catch (eRofQueueFull &e) {
+  /* enqueue the message in rofl's internal queue, as long
+   * as these are not exhausted */
+  if (not txqueues[get_txqueue_id(msg)].try_store(msg, enforce_queueing)) {
     VLOG(3) << __FUNCTION__ << " txqueue exhausted, "
             << " msg=" << msg
             << " txqueue_pending_pkts=" << txqueue_pending_pkts
             << " tx_disabled=" << tx_disabled
             << " tx_is_running=" << tx_is_running;
-    delete msg;
-    /* message was not stored in txqueue and deleted here */
     return MSG_QUEUEING_FAILED_QUEUE_FULL;
   }
+
+  /* txthread owns msg from now on */
+  msg = nullptr;
+
+  txqueue_pending_pkts++;
+
+  if (not tx_is_running) {
+    txthread.wakeup();
+  }
+
+  if (flag_test(FLAG_TX_BLOCK_QUEUEING)) {
+    /* message was queued, but congestion prevents us from sending it */
+    return MSG_QUEUED_CONGESTION;
+  }
+
+  /* message was queued, waiting for transmission */
+  return MSG_QUEUED;
+}
+
+crofsock::outqueue_type_t
+crofsock::get_txqueue_id(const rofl::openflow::cofmsg *msg) {
+  switch (msg->get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    switch (msg->get_type()) {
+    case rofl::openflow10::OFPT_PACKET_IN:
+    case rofl::openflow10::OFPT_PACKET_OUT:
+      return QUEUE_PKT;
+    case rofl::openflow10::OFPT_FLOW_MOD:
+    case rofl::openflow10::OFPT_FLOW_REMOVED:
+    case rofl::openflow10::OFPT_BARRIER_REPLY:
+    case rofl::openflow10::OFPT_BARRIER_REQUEST:
+      return QUEUE_FLOW;
+    case rofl::openflow10::OFPT_ECHO_REQUEST:
+    case rofl::openflow10::OFPT_ECHO_REPLY:
+      return QUEUE_OAM;
+    default:
+      return QUEUE_MGMT;
+    }
+  } break;
+  case rofl::openflow12::OFP_VERSION: {
+    switch (msg->get_type()) {
+    case rofl::openflow12::OFPT_PACKET_IN:
+    case rofl::openflow12::OFPT_PACKET_OUT:
+      return QUEUE_PKT;
+    case rofl::openflow12::OFPT_FLOW_MOD:
+    case rofl::openflow12::OFPT_FLOW_REMOVED:
+    case rofl::openflow12::OFPT_GROUP_MOD:
+    case rofl::openflow12::OFPT_PORT_MOD:
+    case rofl::openflow12::OFPT_TABLE_MOD:
+    case rofl::openflow12::OFPT_BARRIER_REPLY:
+    case rofl::openflow12::OFPT_BARRIER_REQUEST:
+      return QUEUE_FLOW;
+    case rofl::openflow12::OFPT_ECHO_REQUEST:
+    case rofl::openflow12::OFPT_ECHO_REPLY:
+      return QUEUE_OAM;
+    default:
+      return QUEUE_MGMT;
+    }
+  } break;
+  case rofl::openflow13::OFP_VERSION:
+  default: {
+    switch (msg->get_type()) {
+    case rofl::openflow13::OFPT_PACKET_IN:
+    case rofl::openflow13::OFPT_PACKET_OUT:
+      return QUEUE_PKT;
+    case rofl::openflow13::OFPT_FLOW_MOD:
+    case rofl::openflow13::OFPT_FLOW_REMOVED:
+    case rofl::openflow13::OFPT_GROUP_MOD:
+    case rofl::openflow13::OFPT_PORT_MOD:
+    case rofl::openflow13::OFPT_TABLE_MOD:
+    case rofl::openflow13::OFPT_BARRIER_REPLY:
+    case rofl::openflow13::OFPT_BARRIER_REQUEST:
+    case rofl::openflow14::OFPT_BUNDLE_CONTROL:
+    case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE:
+      return QUEUE_FLOW;
+    case rofl::openflow13::OFPT_ECHO_REQUEST:
+    case rofl::openflow13::OFPT_ECHO_REPLY:
+      return QUEUE_OAM;
+    default:
+      return QUEUE_MGMT;
+    }
+  };
+  }
 }
 
 void crofsock::handle_wakeup(cthread &thread) {
@@ -1448,114 +1745,80 @@ void crofsock::send_from_queue() {
 
   tx_is_running = true;
 
-  bool reschedule;
+  bool reschedule = false;
   do {
-    reschedule = false;
-    for (unsigned int queue_id = 0; queue_id < QUEUE_MAX; ++queue_id) {
-
-      for (unsigned int num = 0; num < txweights[queue_id]; ++num) {
-
-        if ((tx_disabled) || (state < STATE_TCP_ESTABLISHED)) {
-          tx_is_running = false;
-          return;
-        }
-
-        /* no pending fragment */
-        if (not tx_fragment_pending) {
-          rofl::openflow::cofmsg *msg = nullptr;
-
-          /* fetch a new message for transmission from tx queue */
-          if ((msg = txqueues[queue_id].retrieve()) == NULL)
-            break;
-          // txqueues[queue_id].pop();
-
-          /* bytes of this message sent so far */
-          msg_bytes_sent = 0;
-
-          /* overall length of this message */
-          txlen = msg->length();
+    if ((tx_disabled) || (state < STATE_TCP_ESTABLISHED)) {
+      tx_is_running = false;
+      return;
+    }
 
-          memset(txbuffer.somem(), 0, txlen);
+    /* no pending fragment: pack next batch of messages into txbuffer */
+    if (not tx_fragment_pending) {
+      reschedule = pack_tx_batch();
+      if (txlen == 0)
+        break;
+    }
 
-          /* pack message into txbuffer */
-          msg->pack(txbuffer.somem(), txlen);
+    /* send memory block via socket in non-blocking mode */
+    int nbytes =
+        sock_send(txbuffer.somem() + msg_bytes_sent, txlen - msg_bytes_sent);
 
-          VLOG(3) << __FUNCTION__ << " message sent: " << msg->str().c_str()
+    /* error occured */
+    if (nbytes < 0) {
+      switch (errno) {
+      case EAGAIN: /* socket would block */ {
+        tx_is_running = false;
+        tx_fragment_pending = true;
+        flag_set(FLAG_CONGESTED, true);
+        txthread.add_write_fd(sd);
+
+        if (not flag_test(FLAG_TX_BLOCK_QUEUEING)) {
+          /* block transmission of further packets */
+          flag_set(FLAG_TX_BLOCK_QUEUEING, true);
+          /* remember queue size, when congestion occured */
+          txqueue_size_congestion_occured = txqueue_pending_pkts;
+          /* threshold for re-enabling acceptance of packets */
+          txqueue_size_tx_threshold = txqueue_pending_pkts / 2;
+
+          VLOG(3) << __FUNCTION__ << " congestion occured"
+                  << " txqueue_pending_pkts" << txqueue_pending_pkts
+                  << " txqueue_size_congestion_occured"
+                  << txqueue_size_congestion_occured
+                  << " txqueue_size_tx_threshold" << txqueue_size_tx_threshold
                   << " laddr=" << laddr.str() << " raddr=" << raddr.str();
 
-          /* remove C++ message object from heap */
-          delete msg;
-        }
-
-        /* send memory block via socket in non-blocking mode */
-        int nbytes =
-            ::send(sd, txbuffer.somem() + msg_bytes_sent,
-                   txlen - msg_bytes_sent, MSG_DONTWAIT | MSG_NOSIGNAL);
-
-        /* error occured */
-        if (nbytes < 0) {
-          switch (errno) {
-          case EAGAIN: /* socket would block */ {
-            tx_is_running = false;
-            tx_fragment_pending = true;
-            flag_set(FLAG_CONGESTED, true);
-            txthread.add_write_fd(sd);
-
-            if (not flag_test(FLAG_TX_BLOCK_QUEUEING)) {
-              /* block transmission of further packets */
-              flag_set(FLAG_TX_BLOCK_QUEUEING, true);
-              /* remember queue size, when congestion occured */
-              txqueue_size_congestion_occured = txqueue_pending_pkts;
-              /* threshold for re-enabling acceptance of packets */
-              txqueue_size_tx_threshold = txqueue_pending_pkts / 2;
-
-              VLOG(3) << __FUNCTION__ << " congestion occured"
-                      << " txqueue_pending_pkts" << txqueue_pending_pkts
-                      << " txqueue_size_congestion_occured"
-                      << txqueue_size_congestion_occured
-                      << " txqueue_size_tx_threshold"
-                      << txqueue_size_tx_threshold << " laddr=" << laddr.str()
-                      << " raddr=" << raddr.str();
-
-              crofsock_env::call_env(env).congestion_occured_indication(*this);
-            }
-          }
-            return;
-          case SIGPIPE:
-          default: {
-            VLOG(1) << __FUNCTION__
-                    << " ::send() syscall failed, error: " << errno << ": "
-                    << strerror(errno);
-            tx_is_running = false;
-          }
-            return;
-          }
-
-          /* at least some bytes were sent successfully */
-        } else {
-          msg_bytes_sent += nbytes;
-          flag_set(FLAG_CONGESTED, false);
-
-          /* short write */
-          if (msg_bytes_sent < txlen) {
-            tx_fragment_pending = true;
-
-            /* packet successfully sent */
-          } else {
-            tx_fragment_pending = false;
-            txqueue_pending_pkts--;
-          }
-
-          VLOG(3) << __FUNCTION__ << ": sent " << nbytes
-                  << " bytes msg_bytes_sent=" << msg_bytes_sent
-                  << " tx_fragment_pending=" << tx_fragment_pending
-                  << " txqueue_pending_pkts=" << txqueue_pending_pkts;
+          crofsock_env::call_env(env).congestion_occured_indication(*this);
         }
       }
+        return;
+      case SIGPIPE:
+      default: {
+        VLOG(1) << __FUNCTION__ << " ::send() syscall failed, error: " << errno
+                << ": " << strerror(errno);
+        tx_is_running = false;
+      }
+        return;
+      }
 
-      if (not txqueues[queue_id].empty()) {
-        reschedule = true;
+      /* at least some bytes were sent successfully */
+    } else {
+      msg_bytes_sent += nbytes;
+      flag_set(FLAG_CONGESTED, false);
+
+      /* account for all messages sent completely */
+      while ((tx_msgs_sent < tx_msg_ends.size()) &&
+             (tx_msg_ends[tx_msgs_sent] <= msg_bytes_sent)) {
+        tx_msgs_sent++;
+        txqueue_pending_pkts--;
       }
+
+      /* short write, may end within any message of this batch */
+      tx_fragment_pending = (msg_bytes_sent < txlen);
+
+      VLOG(3) << __FUNCTION__ << ": sent " << nbytes
+              << " bytes msg_bytes_sent=" << msg_bytes_sent
+              << " tx_fragment_pending=" << tx_fragment_pending
+              << " txqueue_pending_pkts=" << txqueue_pending_pkts;
     }
 
     if ((not flag_test(FLAG_CONGESTED)) && flag_test(FLAG_TX_BLOCK_QUEUEING)) {
@@ -1572,7 +1835,7 @@ void crofsock::send_from_queue() {
       }
     }
 
-  } while (reschedule);
+  } while (reschedule || tx_fragment_pending);
 
   tx_is_running = false;
 
@@ -1581,6 +1844,59 @@ void crofsock::send_from_queue() {
   }
 }
 
+bool crofsock::pack_tx_batch() {
+  msg_bytes_sent = 0;
+  txlen = 0;
+  txbuffer.clear();
+  tx_msg_ends.clear();
+  tx_msgs_sent = 0;
+
+  /* weighted round robin over all txqueues, the scheduler position is
+   * preserved across batches for keeping txweights fairness */
+  unsigned int num_empty = 0;
+  while (num_empty < QUEUE_MAX) {
+
+    if (tx_sched_num < txweights[tx_sched_queue_id]) {
+      rofl::openflow::cofmsg *msg = txqueues[tx_sched_queue_id].front();
+
+      if (msg != nullptr) {
+        num_empty = 0;
+
+        /* batch is full, a batch may exceed TXBUFFER_SIZE by at most
+         * one message, as lengths are known after serialization only */
+        if ((txlen > 0) && ((txlen >= TXBUFFER_SIZE) || (not tx_batching))) {
+          return true;
+        }
+
+        txqueues[tx_sched_queue_id].pop();
+
+        /* append message to txbuffer */
+        msg->serialize(txbuffer);
+
+        VLOG(3) << __FUNCTION__ << " message sent: " << msg->str().c_str()
+                << " laddr=" << laddr.str() << " raddr=" << raddr.str();
+
+        /* remove C++ message object from heap */
+        delete msg;
+
+        txlen = txbuffer.length();
+        tx_msg_ends.push_back(txlen);
+        tx_sched_num++;
+        continue;
+      }
+
+      num_empty++;
+    }
+
+    /* advance to next queue */
+    tx_sched_num = 0;
+    tx_sched_queue_id = (tx_sched_queue_id + 1) % QUEUE_MAX;
+  }
+
+  /* all queues drained */
+  return false;
+}
+
 void crofsock::handle_read_event(cthread &thread, int fd) {
   if (&thread == &rxthread) {
     handle_read_event_rxthread(thread, fd);
@@ -1722,6 +2038,11 @@ void crofsock::handle_read_event_rxthread(cthread &thread, int fd) {
 }
 
 void crofsock::recv_message() {
+  if (rx_streaming) {
+    recv_stream();
+    return;
+  }
+
   while (not rx_disabled) {
 
     if (state <= STATE_CLOSED) {
@@ -1741,7 +2062,7 @@ void crofsock::recv_message() {
       msg_len = sizeof(struct openflow::ofp_header);
     } else {
       struct openflow::ofp_header *header =
-          (struct openflow::ofp_header *)(rxbuffer.somem());
+          (struct openflow::ofp_header *)(rxbuffer->somem());
       msg_len = be16toh(header->length);
     }
 
@@ -1754,9 +2075,12 @@ void crofsock::recv_message() {
       goto on_error;
     }
 
+    /* payload of a previous message may still refer to rxbuffer */
+    rx_reserve_buffer(0, msg_bytes_read);
+
     /* read from socket more bytes, at most "msg_len - msg_bytes_read" */
-    int rc = ::recv(sd, (void *)(rxbuffer.somem() + msg_bytes_read),
-                    msg_len - msg_bytes_read, MSG_DONTWAIT);
+    int rc = sock_recv((void *)(rxbuffer->somem() + msg_bytes_read),
+                       msg_len - msg_bytes_read);
 
     if (rc < 0) {
       switch (errno) {
@@ -1785,13 +2109,13 @@ void crofsock::recv_message() {
     /* minimum message length received, check completeness of message */
     if (msg_bytes_read >= sizeof(struct openflow::ofp_header)) {
       struct openflow::ofp_header *header =
-          (struct openflow::ofp_header *)(rxbuffer.somem());
+          (struct openflow::ofp_header *)(rxbuffer->somem());
       uint16_t msg_len = be16toh(header->length);
 
       /* ok, message was received completely */
       if (msg_len == msg_bytes_read) {
         rx_fragment_pending = false;
-        parse_message();
+        parse_message(rx_slice(0, msg_bytes_read));
         msg_bytes_read = 0;
       } else {
         rx_fragment_pending = true;
@@ -1804,6 +2128,114 @@ void crofsock::recv_message() {
 on_error:
 
   switch (state) {
+  case STATE_TLS_ESTABLISHED:
+  case STATE_TCP_ESTABLISHED: {
+    VLOG(2) << __FUNCTION__ << " TCP: peer shutdown laddr=" << laddr.str()
+            << " raddr=" << raddr.str();
+    close();
+
+    if (flag_test(FLAG_RECONNECT_ON_FAILURE)) {
+      backoff_reconnect(true);
+    }
+
+    try {
+      crofsock_env::call_env(env).handle_closed(*this);
+    } catch (std::runtime_error &e) {
+      VLOG(1) << __FUNCTION__ << "() caught runtime error, what: %s" << e.what()
+              << " laddr=" << laddr.str() << " raddr=" << raddr.str();
+    }
+    // WARNING: handle_closed might delete this socket, don't call anything here
+  } break;
+  default: { VLOG(2) << __FUNCTION__ << " error in state=" << state; };
+  }
+}
+
+void crofsock::recv_stream() {
+  unsigned int pkts_rcvd = 0;
+
+  while (not rx_disabled) {
+
+    if (state <= STATE_CLOSED) {
+      VLOG(3) << __FUNCTION__ << "() ignoring message laddr=" << laddr.str()
+              << " raddr=" << raddr.str() << " state=" << state;
+      return;
+    }
+
+    /* split out all complete messages stored in rxbuffer */
+    while (rx_bytes_pending >= sizeof(struct openflow::ofp_header)) {
+      struct openflow::ofp_header *header =
+          (struct openflow::ofp_header *)(rxbuffer->somem() + rx_offset);
+      uint16_t msg_len = be16toh(header->length);
+
+      /* sanity check: 8 <= msg_len <= 2^16 */
+      if (msg_len < sizeof(struct openflow::ofp_header)) {
+        /* out-of-sync => enforce reconnect in client mode */
+        VLOG(2) << __FUNCTION__
+                << " TCP: openflow out-of-sync laddr=" << laddr.str()
+                << " raddr=" << raddr.str();
+        goto on_error;
+      }
+
+      /* partial message, wait for more data */
+      if (msg_len > rx_bytes_pending)
+        break;
+
+      cslice msg_slice(rx_slice(rx_offset, msg_len));
+      rx_offset += msg_len;
+      rx_bytes_pending -= msg_len;
+
+      parse_message(msg_slice);
+
+      if ((state <= STATE_CLOSED) || (rx_disabled))
+        return;
+
+      /* bound work per round, remaining data is handled after wakeup */
+      if ((max_pkts_rcvd_per_round > 0) &&
+          (++pkts_rcvd >= max_pkts_rcvd_per_round)) {
+        rxthread.wakeup();
+        return;
+      }
+    }
+
+    /* carry over partial message to start of rxbuffer */
+    rx_reserve_buffer(rx_offset, rx_bytes_pending);
+    rx_offset = 0;
+
+    /* read as many bytes as fit into rxbuffer */
+    int rc = sock_recv((void *)(rxbuffer->somem() + rx_bytes_pending),
+                       rxbuffer->length() - rx_bytes_pending);
+
+    if (rc < 0) {
+      switch (errno) {
+      case EAGAIN: {
+        /* do not continue and let kernel inform us, once more data is available
+         */
+        VLOG(3) << __FUNCTION__ << " EAGAIN on fd=" << sd;
+        return;
+      } break;
+      default: {
+        VLOG(1) << __FUNCTION__ << " ::recv() syscall failed, error: " << errno
+                << ": " << strerror(errno) << " laddr=" << laddr.str()
+                << " raddr=" << raddr.str();
+        goto on_error;
+      };
+      }
+    } else if (rc == 0) {
+      /* shutdown from peer */
+      VLOG(2) << __FUNCTION__ << " TCP: peer shutdown laddr=" << laddr.str()
+              << " raddr=" << raddr.str();
+      goto on_error;
+    }
+
+    rx_bytes_pending += rc;
+  }
+
+  return;
+
+on_error:
+
+  switch (state) {
+  case STATE_TLS_ESTABLISHED:
   case STATE_TCP_ESTABLISHED: {
     VLOG(2) << __FUNCTION__ << " TCP: peer shutdown laddr=" << laddr.str()
             << " raddr=" << raddr.str();
@@ -1825,27 +2257,77 @@ on_error:
   }
 }
 
-void crofsock::parse_message() {
+void crofsock::rx_reserve_buffer(size_t offset, size_t len) {
+  if (rxbuffer.use_count() > 1) {
+    /* received messages still refer to rxbuffer, continue on a fresh chunk
+     * and leave the old one to its remaining owners */
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::shared_ptr<cmemory> chunk(new cmemory((size_t)RXBUFFER_SIZE));
+    if (len > 0) {
+      memcpy(chunk->somem(), rxbuffer->somem() + offset, len);
+    }
+    rx_pinned.push_back(rxbuffer);
+    rxbuffer = chunk;
+  } else if ((offset > 0) && (len > 0)) {
+    memmove(rxbuffer->somem(), rxbuffer->somem() + offset, len);
+  }
+}
+
+cslice crofsock::rx_slice(size_t offset, size_t len) {
+  if (rx_pinned.size() >= RXBUFFER_MAX_PINNED) {
+    rx_pinned.remove_if(
+        [](const std::weak_ptr<cmemory> &chunk) { return chunk.expired(); });
+  }
+  if (rx_pinned.size() < RXBUFFER_MAX_PINNED) {
+    return cslice(rxbuffer, offset, len);
+  }
+  /* too many chunks held by retained messages, a small retained message
+   * must not pin another RXBUFFER_SIZE bytes */
+  std::shared_ptr<cmemory> copy(new cmemory(rxbuffer->somem() + offset, len));
+  return cslice(copy, 0, len);
+}
+
+void crofsock::parse_message(const cslice &slice) {
+  uint8_t *buf = slice.somem();
+  size_t buflen = slice.length();
   struct rofl::openflow::ofp_header *hdr =
-      (struct rofl::openflow::ofp_header *)rxbuffer.somem();
+      (struct rofl::openflow::ofp_header *)buf;
 
   rofl::openflow::cofmsg *msg = (rofl::openflow::cofmsg *)0;
+  uint64_t num_allocs = cslab::get_num_allocs();
   try {
-    if (rxbuffer.length() < sizeof(struct rofl::openflow::ofp_header)) {
+    if (buflen < sizeof(struct rofl::openflow::ofp_header)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
 
+    /* relay frame without decoding */
+    if (get_rx_passthrough(hdr->type)) {
+      if (state <= STATE_CLOSED) {
+        return;
+      }
+
+      VLOG(3) << __FUNCTION__ << " frame rcvd: type=" << (int)hdr->type
+              << " xid=" << be32toh(hdr->xid) << " laddr=" << laddr.str()
+              << " raddr=" << raddr.str();
+
+      crofsock_env::call_env(env).handle_recv_frame(*this, slice);
+      return;
+    }
+
     /* make sure to have a valid cofmsg* msg object after parsing */
     switch (hdr->version) {
     case rofl::openflow10::OFP_VERSION: {
-      parse_of10_message(&msg);
+      parse_of10_message(&msg, slice);
     } break;
     case rofl::openflow12::OFP_VERSION: {
-      parse_of12_message(&msg);
+      parse_of12_message(&msg, slice);
     } break;
     case rofl::openflow13::OFP_VERSION: {
-      parse_of13_message(&msg);
+      parse_of13_message(&msg, slice);
+    } break;
+    case rofl::openflow14::OFP_VERSION: {
+      parse_of14_message(&msg, slice);
     } break;
     default: {
       throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
@@ -1853,6 +2335,9 @@ void crofsock::parse_message() {
     };
     }
 
+    rofl::openflow::cofmsg::count_allocs(
+        hdr->type, cslab::get_num_allocs() - num_allocs);
+
     if (state <= STATE_CLOSED) {
       return;
     }
@@ -1868,8 +2353,8 @@ void crofsock::parse_message() {
             << " laddr=" << laddr.str() << " raddr=" << raddr.str();
 
     send_message(new rofl::openflow::cofmsg_error_bad_request_bad_type(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.length() > 64) ? 64 : msg_bytes_read));
+        hdr->version, be32toh(hdr->xid), buf,
+        (buflen > 64) ? 64 : buflen));
 
   } catch (eBadRequestBadStat &e) {
 
@@ -1877,8 +2362,8 @@ void crofsock::parse_message() {
             << " laddr=" << laddr.str() << " raddr=" << raddr.str();
 
     send_message(new rofl::openflow::cofmsg_error_bad_request_bad_stat(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.length() > 64) ? 64 : msg_bytes_read));
+        hdr->version, be32toh(hdr->xid), buf,
+        (buflen > 64) ? 64 : buflen));
 
   } catch (eBadRequestBadVersion &e) {
 
@@ -1889,8 +2374,8 @@ void crofsock::parse_message() {
       delete msg;
 
     send_message(new rofl::openflow::cofmsg_error_bad_request_bad_version(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.length() > 64) ? 64 : msg_bytes_read));
+        hdr->version, be32toh(hdr->xid), buf,
+        (buflen > 64) ? 64 : buflen));
 
   } catch (eBadRequestBadLen &e) {
 
@@ -1901,8 +2386,8 @@ void crofsock::parse_message() {
       delete msg;
 
     send_message(new rofl::openflow::cofmsg_error_bad_request_bad_len(
-        hdr->version, be32toh(hdr->xid), rxbuffer.somem(),
-        (rxbuffer.length() > 64) ? 64 : msg_bytes_read));
+        hdr->version, be32toh(hdr->xid), buf,
+        (buflen > 64) ? 64 : buflen));
 
   } catch (rofl::exception &e) {
 
@@ -1917,9 +2402,12 @@ void crofsock::parse_message() {
   }
 }
 
-void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
+void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg,
+                                  const cslice &slice) {
+  uint8_t *buf = slice.somem();
+  size_t buflen = slice.length();
   struct openflow::ofp_header *header =
-      (struct openflow::ofp_header *)rxbuffer.somem();
+      (struct openflow::ofp_header *)buf;
 
   switch (header->type) {
   case rofl::openflow10::OFPT_HELLO: {
@@ -1971,13 +2459,13 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
     *pmsg = new rofl::openflow::cofmsg_port_status();
   } break;
   case rofl::openflow10::OFPT_STATS_REQUEST: {
-    if (rxbuffer.length() <
+    if (buflen <
         sizeof(struct rofl::openflow10::ofp_stats_request)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
     uint16_t stats_type = be16toh(
-        ((struct rofl::openflow10::ofp_stats_request *)rxbuffer.somem())->type);
+        ((struct rofl::openflow10::ofp_stats_request *)buf)->type);
     switch (stats_type) {
     case rofl::openflow10::OFPST_DESC: {
       *pmsg = new rofl::openflow::cofmsg_desc_stats_request();
@@ -2007,12 +2495,12 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
     }
   } break;
   case rofl::openflow10::OFPT_STATS_REPLY: {
-    if (rxbuffer.length() < sizeof(struct rofl::openflow10::ofp_stats_reply)) {
+    if (buflen < sizeof(struct rofl::openflow10::ofp_stats_reply)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
     uint16_t stats_type = be16toh(
-        ((struct rofl::openflow10::ofp_stats_reply *)rxbuffer.somem())->type);
+        ((struct rofl::openflow10::ofp_stats_reply *)buf)->type);
     switch (stats_type) {
     case rofl::openflow10::OFPST_DESC: {
       *pmsg = new rofl::openflow::cofmsg_desc_stats_reply();
@@ -2059,12 +2547,19 @@ void crofsock::parse_of10_message(rofl::openflow::cofmsg **pmsg) {
   };
   }
 
-  (*(*pmsg)).unpack(rxbuffer.somem(), msg_bytes_read);
+  if (rx_lazy_decoding) {
+    (*(*pmsg)).unpack_lazy(slice);
+  } else {
+    (*(*pmsg)).unpack_shared(slice);
+  }
 }
 
-void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
+void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg,
+                                  const cslice &slice) {
+  uint8_t *buf = slice.somem();
+  size_t buflen = slice.length();
   struct openflow::ofp_header *header =
-      (struct openflow::ofp_header *)rxbuffer.somem();
+      (struct openflow::ofp_header *)buf;
 
   switch (header->type) {
   case rofl::openflow12::OFPT_HELLO: {
@@ -2122,13 +2617,13 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
     *pmsg = new rofl::openflow::cofmsg_table_mod();
   } break;
   case rofl::openflow12::OFPT_STATS_REQUEST: {
-    if (rxbuffer.length() <
+    if (buflen <
         sizeof(struct rofl::openflow12::ofp_stats_request)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
     uint16_t stats_type = be16toh(
-        ((struct rofl::openflow12::ofp_stats_request *)rxbuffer.somem())->type);
+        ((struct rofl::openflow12::ofp_stats_request *)buf)->type);
     switch (stats_type) {
     case rofl::openflow12::OFPST_DESC: {
       *pmsg = new rofl::openflow::cofmsg_desc_stats_request();
@@ -2167,12 +2662,12 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
     }
   } break;
   case rofl::openflow12::OFPT_STATS_REPLY: {
-    if (rxbuffer.length() < sizeof(struct rofl::openflow12::ofp_stats_reply)) {
+    if (buflen < sizeof(struct rofl::openflow12::ofp_stats_reply)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
     uint16_t stats_type = be16toh(
-        ((struct rofl::openflow12::ofp_stats_reply *)rxbuffer.somem())->type);
+        ((struct rofl::openflow12::ofp_stats_reply *)buf)->type);
     switch (stats_type) {
     case rofl::openflow12::OFPST_DESC: {
       *pmsg = new rofl::openflow::cofmsg_desc_stats_reply();
@@ -2243,12 +2738,19 @@ void crofsock::parse_of12_message(rofl::openflow::cofmsg **pmsg) {
   };
   }
 
-  (*(*pmsg)).unpack(rxbuffer.somem(), msg_bytes_read);
+  if (rx_lazy_decoding) {
+    (*(*pmsg)).unpack_lazy(slice);
+  } else {
+    (*(*pmsg)).unpack_shared(slice);
+  }
 }
 
-void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
+void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg,
+                                  const cslice &slice) {
+  uint8_t *buf = slice.somem();
+  size_t buflen = slice.length();
   struct openflow::ofp_header *header =
-      (struct openflow::ofp_header *)rxbuffer.somem();
+      (struct openflow::ofp_header *)buf;
 
   switch (header->type) {
   case rofl::openflow13::OFPT_HELLO: {
@@ -2306,13 +2808,13 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
     *pmsg = new rofl::openflow::cofmsg_table_mod();
   } break;
   case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
-    if (rxbuffer.memlen() <
+    if (buflen <
         sizeof(struct rofl::openflow13::ofp_multipart_request)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
     uint16_t stats_type = be16toh(
-        ((struct rofl::openflow13::ofp_multipart_request *)rxbuffer.somem())
+        ((struct rofl::openflow13::ofp_multipart_request *)buf)
             ->type);
     switch (stats_type) {
     case rofl::openflow13::OFPMP_DESC: {
@@ -2367,13 +2869,13 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
     }
   } break;
   case rofl::openflow13::OFPT_MULTIPART_REPLY: {
-    if (rxbuffer.memlen() <
+    if (buflen <
         sizeof(struct rofl::openflow13::ofp_multipart_reply)) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
     }
     uint16_t stats_type = be16toh(
-        ((struct rofl::openflow13::ofp_multipart_reply *)rxbuffer.somem())
+        ((struct rofl::openflow13::ofp_multipart_reply *)buf)
             ->type);
     switch (stats_type) {
     case rofl::openflow13::OFPMP_DESC: {
@@ -2463,5 +2965,74 @@ void crofsock::parse_of13_message(rofl::openflow::cofmsg **pmsg) {
   };
   }
 
-  (*(*pmsg)).unpack(rxbuffer.somem(), msg_bytes_read);
+  if (rx_lazy_decoding) {
+    (*(*pmsg)).unpack_lazy(slice);
+  } else {
+    (*(*pmsg)).unpack_shared(slice);
+  }
+}
+
+void crofsock::parse_of14_message(rofl::openflow::cofmsg **pmsg,
+                                  const cslice &slice) {
+  uint8_t *buf = slice.somem();
+  size_t buflen = slice.length();
+  struct openflow::ofp_header *header =
+      (struct openflow::ofp_header *)buf;
+
+  /* messages sharing their OpenFlow 1.3 wire format are handled by
+   * parse_of13_message(), those with a changed layout are rejected */
+  switch (header->type) {
+  case rofl::openflow14::OFPT_BUNDLE_CONTROL: {
+    *pmsg = new rofl::openflow::cofmsg_bundle_control();
+  } break;
+  case rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE: {
+    *pmsg = new rofl::openflow::cofmsg_bundle_add_message();
+  } break;
+  case rofl::openflow14::OFPT_MULTIPART_REQUEST:
+  case rofl::openflow14::OFPT_MULTIPART_REPLY: {
+    if (buflen < sizeof(struct rofl::openflow14::ofp_multipart_request)) {
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+    }
+    uint16_t stats_type = be16toh(
+        ((struct rofl::openflow14::ofp_multipart_request *)buf)->type);
+    switch (stats_type) {
+    case rofl::openflow14::OFPMP_PORT_STATS:
+    case rofl::openflow14::OFPMP_QUEUE_STATS:
+    case rofl::openflow14::OFPMP_TABLE_DESC:
+    case rofl::openflow14::OFPMP_QUEUE_DESC:
+    case rofl::openflow14::OFPMP_FLOW_MONITOR: {
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+    };
+    default: {
+      parse_of13_message(pmsg, slice);
+    };
+    }
+    return;
+  };
+  case rofl::openflow14::OFPT_PORT_MOD:
+  case rofl::openflow14::OFPT_TABLE_MOD:
+  case rofl::openflow14::OFPT_GET_ASYNC_REQUEST:
+  case rofl::openflow14::OFPT_GET_ASYNC_REPLY:
+  case rofl::openflow14::OFPT_SET_ASYNC:
+  case rofl::openflow14::OFPT_ROLE_STATUS:
+  case rofl::openflow14::OFPT_TABLE_STATUS:
+  case rofl::openflow14::OFPT_REQUESTFORWARD:
+  case rofl::openflow13::OFPT_QUEUE_GET_CONFIG_REQUEST:
+  case rofl::openflow13::OFPT_QUEUE_GET_CONFIG_REPLY: {
+    throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                             __LINE__);
+  };
+  default: {
+    parse_of13_message(pmsg, slice);
+    return;
+  };
+  }
+
+  if (rx_lazy_decoding) {
+    (*(*pmsg)).unpack_lazy(slice);
+  } else {
+    (*(*pmsg)).unpack_shared(slice);
+  }
 }
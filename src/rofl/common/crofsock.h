@@ -40,10 +40,12 @@
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 
+#include "rofl/common/cenvs.hpp"
 #include "rofl/common/cmemory.h"
 
 #include "rofl/common/crandom.h"
 #include "rofl/common/crofqueue.h"
+#include "rofl/common/cslice.hpp"
 #include "rofl/common/csockaddr.h"
 #include "rofl/common/cthread.hpp"
 #include "rofl/common/exception.hpp"
@@ -52,6 +54,7 @@
 #include "rofl/common/openflow/messages/cofmsg_aggr_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_async_config.h"
 #include "rofl/common/openflow/messages/cofmsg_barrier.h"
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
 #include "rofl/common/openflow/messages/cofmsg_config.h"
 #include "rofl/common/openflow/messages/cofmsg_desc_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_echo.h"
@@ -63,6 +66,7 @@
 #include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
 #include "rofl/common/openflow/messages/cofmsg_flow_removed.h"
 #include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_frame.h"
 #include "rofl/common/openflow/messages/cofmsg_group_desc_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_group_features_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_group_mod.h"
@@ -72,6 +76,7 @@
 #include "rofl/common/openflow/messages/cofmsg_meter_features_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_meter_mod.h"
 #include "rofl/common/openflow/messages/cofmsg_meter_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_packed.h"
 #include "rofl/common/openflow/messages/cofmsg_packet_in.h"
 #include "rofl/common/openflow/messages/cofmsg_packet_out.h"
 #include "rofl/common/openflow/messages/cofmsg_port_desc_stats.h"
@@ -85,6 +90,7 @@
 #include "rofl/common/openflow/messages/cofmsg_table_features_stats.h"
 #include "rofl/common/openflow/messages/cofmsg_table_mod.h"
 #include "rofl/common/openflow/messages/cofmsg_table_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_template.h"
 
 namespace rofl {
 
@@ -155,10 +161,9 @@ class crofsock_env {
   friend class crofsock;
 
 public:
-  static crofsock_env &call_env(crofsock_env *env) {
-    AcquireReadLock lock(crofsock_env::socket_envs_lock);
-    if (crofsock_env::socket_envs.find(env) ==
-        crofsock_env::socket_envs.end()) {
+  static crofsock_env &call_env(crofsock_env *env,
+                                chazard::guard &&guard = chazard::guard()) {
+    if (not crofsock_env::socket_envs.protect(env, guard)) {
       throw eRofSockNotFound(
           "crofsock_env::call_env() crofsock_env instance not found")
           .set_func(__FUNCTION__)
@@ -170,15 +175,18 @@ public:
 
 public:
   virtual ~crofsock_env() {
-    AcquireReadWriteLock lock(crofsock_env::socket_envs_lock);
-    crofsock_env::socket_envs.erase(this);
+    crofsock_env::socket_envs.drop(this);
   };
   crofsock_env() {
-    AcquireReadWriteLock lock(crofsock_env::socket_envs_lock);
-    crofsock_env::socket_envs.insert(this);
+    crofsock_env::socket_envs.add(this);
   };
 
 protected:
+  /**
+   * @brief	Deregisters this instance, see cenvs::drop()
+   */
+  void drop_env() { crofsock_env::socket_envs.drop(this); };
+
   virtual void handle_listen(crofsock &socket) = 0;
 
   virtual void handle_tcp_connect_refused(crofsock &socket) = 0;
@@ -205,13 +213,25 @@ protected:
 
   virtual void handle_recv(crofsock &socket, rofl::openflow::cofmsg *msg) = 0;
 
+  /**
+   * @brief	Called for received messages with a passthrough type
+   *
+   * frame is a view of the complete message in the receive buffer,
+   * header included. It may be relayed via crofsock::send_frame() or
+   * kept beyond this call; the buffer is released when the last view
+   * is gone. The default hands over frame as cofmsg_frame to
+   * handle_recv().
+   */
+  virtual void handle_recv_frame(crofsock &socket, const cslice &frame) {
+    handle_recv(socket, new rofl::openflow::cofmsg_frame(frame));
+  };
+
   virtual void congestion_occured_indication(crofsock &socket) = 0;
 
   virtual void congestion_solved_indication(crofsock &socket) = 0;
 
 private:
-  static std::set<crofsock_env *> socket_envs;
-  static crwlock socket_envs_lock;
+  static cenvs<crofsock_env> socket_envs;
 };
 
 /**
@@ -269,6 +289,10 @@ public:
     MSG_QUEUEING_FAILED_SHUTDOWN_IN_PROGRESS = 5,
   };
 
+  // receive chunks left pinned by retained messages, beyond this number
+  // received messages are copied into buffers of their own
+  static size_t const RXBUFFER_MAX_PINNED = 16;
+
 public:
   /**
    *
@@ -320,6 +344,25 @@ public:
   rofl::crofsock::msg_result_t send_message(rofl::openflow::cofmsg *msg,
                                             bool enforce_queueing = false);
 
+  /**
+   * @brief	Queues msg for transmission without throwing
+   *
+   * On success msg is set to nullptr and owned by this socket. On
+   * failure msg remains owned by the caller and may be sent again.
+   */
+  rofl::crofsock::msg_result_t try_send_message(rofl::openflow::cofmsg *&msg,
+                                                bool enforce_queueing = false);
+
+  /**
+   * @brief	Queues a received wire frame for transmission with a new xid
+   *
+   * The frame shares its buffer with the socket it was received on and
+   * is not re-encoded. Only the xid in the common header is replaced
+   * when the frame is copied into the transmission buffer.
+   */
+  rofl::crofsock::msg_result_t send_frame(const cslice &frame, uint32_t xid,
+                                          bool enforce_queueing = false);
+
   /**
    *
    */
@@ -386,6 +429,11 @@ public:
     return txqueue_size_congestion_occured;
   };
 
+  /**
+   * @brief	Returns number of messages waiting in transmission queues
+   */
+  size_t get_txqueue_pending_pkts() const { return txqueue_pending_pkts; };
+
   /**
    * @brief	Sets capacity of transmission queues in messages
    */
@@ -397,6 +445,146 @@ public:
     return *this;
   };
 
+  /**
+   * @brief	Returns true when batched transmission is enabled
+   */
+  bool get_tx_batching() const { return tx_batching; };
+
+  /**
+   * @brief	Enables or disables batched transmission
+   *
+   * When enabled (default), the txthread packs as many queued messages
+   * as fit into its transmission buffer and hands them over to the
+   * kernel in a single send() call. When disabled, each message is sent
+   * by a send() call of its own.
+   */
+  crofsock &set_tx_batching(bool tx_batching) {
+    this->tx_batching = tx_batching;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when streaming reception is enabled
+   */
+  bool get_rx_streaming() const { return rx_streaming; };
+
+  /**
+   * @brief	Enables or disables streaming reception
+   *
+   * When enabled (default), the rxthread reads chunks of up to 64KiB
+   * from the socket and splits out all complete messages in place.
+   * Partial messages are carried over to the next read. When disabled,
+   * each message is read by separate recv() calls for header and body.
+   */
+  crofsock &set_rx_streaming(bool rx_streaming) {
+    this->rx_streaming = rx_streaming;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when received messages are decoded lazily
+   */
+  bool get_rx_lazy_decoding() const { return rx_lazy_decoding; };
+
+  /**
+   * @brief	Enables or disables lazy decoding of received messages
+   *
+   * When enabled, messages with variable length bodies (Flow-Mod,
+   * Flow-Stats, Packet-In) are handed over with their fixed header fields
+   * parsed only. Match, instructions and stats arrays are decoded on
+   * first access from a view of the receive buffer. Malformed bodies
+   * are reported by the accessor instead of an error message sent to
+   * the peer. Forwarding an unmodified message copies its original
+   * bytes. Disabled by default, may be changed at any time.
+   */
+  crofsock &set_rx_lazy_decoding(bool rx_lazy_decoding) {
+    this->rx_lazy_decoding = rx_lazy_decoding;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when messages of type are passed through
+   */
+  bool get_rx_passthrough(uint8_t type) const {
+    return (rx_passthrough[type >> 6].load() >> (type & 63)) & 1;
+  };
+
+  /**
+   * @brief	Enables or disables passthrough for messages of type
+   *
+   * Received messages of a passthrough type are not decoded. Only the
+   * common header is checked and the message is handed over as a view
+   * of the receive buffer to crofsock_env::handle_recv_frame(), e.g.
+   * for relaying it to another socket via send_frame(). May be changed
+   * at any time, messages already parsed are not affected.
+   */
+  crofsock &set_rx_passthrough(uint8_t type, bool passthrough = true) {
+    uint64_t bit = (uint64_t)1 << (type & 63);
+    if (passthrough) {
+      rx_passthrough[type >> 6].fetch_or(bit);
+    } else {
+      rx_passthrough[type >> 6].fetch_and(~bit);
+    }
+    return *this;
+  };
+
+  /**
+   * @brief	Disables passthrough for all message types
+   */
+  crofsock &clear_rx_passthrough() {
+    for (auto &word : rx_passthrough) {
+      word.store(0);
+    }
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when kernel TLS offload is requested
+   */
+  bool get_tls_ktls() const { return tls_ktls; };
+
+  /**
+   * @brief	Requests kernel TLS offload for TLS connections
+   *
+   * When enabled, the record keys negotiated by OpenSSL are handed over
+   * to the kernel (TCP_ULP "tls") after the handshake, so that encrypted
+   * connections use plain send()/recv() on the socket. Only TLS 1.2 with
+   * AES-GCM cipher suites is offloaded. If the kernel lacks TLS support,
+   * records are en-/decrypted by OpenSSL as usual.
+   */
+  crofsock &set_tls_ktls(bool tls_ktls) {
+    this->tls_ktls = tls_ktls;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true when TLS records are encrypted by the kernel
+   */
+  bool is_ktls_tx() const { return ktls_tx; };
+
+  /**
+   * @brief	Returns true when TLS records are decrypted by the kernel
+   */
+  bool is_ktls_rx() const { return ktls_rx; };
+
+  /**
+   * @brief	Returns maximum number of messages parsed per rxthread round
+   */
+  unsigned int get_max_pkts_rcvd_per_round() const {
+    return max_pkts_rcvd_per_round;
+  };
+
+  /**
+   * @brief	Sets maximum number of messages parsed per rxthread round
+   *
+   * Bounds the work done in streaming mode before the rxthread yields
+   * and reschedules itself. A value of zero disables the limit.
+   */
+  crofsock &set_max_pkts_rcvd_per_round(unsigned int max_pkts_rcvd_per_round) {
+    this->max_pkts_rcvd_per_round = max_pkts_rcvd_per_round;
+    return *this;
+  };
+
 public:
   /**
    *
@@ -636,19 +824,44 @@ private:
 
   void tls_log_errors();
 
+  void tls_setup_data_path();
+
+  bool tls_ktls_setup();
+
+  void tls_ktls_close_notify();
+
+  ssize_t tls_result(int rc);
+
+private:
+  ssize_t sock_recv(void *buf, size_t len);
+
+  ssize_t sock_send(const void *buf, size_t len);
+
 private:
   void recv_message();
 
-  void parse_message();
+  void recv_stream();
+
+  void rx_reserve_buffer(size_t offset, size_t len);
 
-  void parse_of10_message(rofl::openflow::cofmsg **pmsg);
+  cslice rx_slice(size_t offset, size_t len);
 
-  void parse_of12_message(rofl::openflow::cofmsg **pmsg);
+  void parse_message(const cslice &slice);
 
-  void parse_of13_message(rofl::openflow::cofmsg **pmsg);
+  void parse_of10_message(rofl::openflow::cofmsg **pmsg, const cslice &slice);
+
+  void parse_of12_message(rofl::openflow::cofmsg **pmsg, const cslice &slice);
+
+  void parse_of13_message(rofl::openflow::cofmsg **pmsg, const cslice &slice);
+
+  void parse_of14_message(rofl::openflow::cofmsg **pmsg, const cslice &slice);
 
   void send_from_queue();
 
+  static outqueue_type_t get_txqueue_id(const rofl::openflow::cofmsg *msg);
+
+  bool pack_tx_batch();
+
 private:
   void backoff_reconnect(bool reset_timeout = false);
 
@@ -740,6 +953,16 @@ private:
   std::string verify_depth;
   std::string ciphers;
 
+  // serializes SSL_read/SSL_write between rxthread and txthread
+  rofl::crwlock tls_lock;
+
+  // kernel TLS offload requested
+  bool tls_ktls;
+
+  // records are en-/decrypted by the kernel
+  std::atomic_bool ktls_tx;
+  std::atomic_bool ktls_rx;
+
   /*
    * receiving messages
    */
@@ -747,8 +970,14 @@ private:
   // fragment pending
   bool rx_fragment_pending;
 
-  // incomplete fragment message fragment received in last round
-  cmemory rxbuffer;
+  // receive buffer, shared with payloads of received messages
+  std::shared_ptr<cmemory> rxbuffer;
+
+  // size of rxbuffer chunks
+  static size_t const RXBUFFER_SIZE = 65536;
+
+  // previous chunks of rxbuffer handed over to received messages
+  std::list<std::weak_ptr<cmemory>> rx_pinned;
 
   // number of bytes already received for current message fragment
   unsigned int msg_bytes_read;
@@ -759,6 +988,21 @@ private:
   // default value for max_pkts_rcvd_per_round
   static unsigned int const DEFAULT_MAX_PKTS_RVCD_PER_ROUND = 16;
 
+  // read large chunks and split messages in place
+  bool rx_streaming;
+
+  // defer decoding of message bodies until first access
+  std::atomic_bool rx_lazy_decoding;
+
+  // message types handed over undecoded to handle_recv_frame()
+  std::atomic<uint64_t> rx_passthrough[4];
+
+  // streaming mode: offset of first unparsed byte in rxbuffer
+  size_t rx_offset;
+
+  // streaming mode: number of unparsed bytes in rxbuffer
+  size_t rx_bytes_pending;
+
   // flag for RX reception on socket
   std::atomic_bool rx_disabled;
 
@@ -794,14 +1038,32 @@ private:
   // fragment pending
   bool tx_fragment_pending;
 
-  // transmission buffer for packing cofmsg instances
-  cmemory txbuffer;
+  // transmission buffer for serializing cofmsg instances
+  rofl::openflow::cofwriter txbuffer;
+
+  // number of bytes serialized into txbuffer before a batch is sent
+  static size_t const TXBUFFER_SIZE = 65536;
 
-  // number of bytes already sent for current message fragment
+  // number of bytes already sent from txbuffer
   unsigned int msg_bytes_sent;
 
-  // message length of current tx-fragment
+  // number of bytes packed into txbuffer
   size_t txlen;
+
+  // pack several messages into txbuffer per send() call
+  bool tx_batching;
+
+  // end offsets of all messages packed into txbuffer
+  std::vector<size_t> tx_msg_ends;
+
+  // number of messages in txbuffer sent completely
+  size_t tx_msgs_sent;
+
+  // scheduler position: queue being served
+  unsigned int tx_sched_queue_id;
+
+  // scheduler position: messages taken from this queue in current round
+  unsigned int tx_sched_num;
 };
 
 } /* namespace rofl */
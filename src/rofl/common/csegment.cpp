@@ -438,6 +438,39 @@ void csegment::store_and_merge_msg(const rofl::openflow::cofmsg &msg_stats) {
   } // end else block
 }
 
+void csegment::store_and_merge_msg(rofl::openflow::cofmsg *msg_stats) {
+  if (NULL == msg) {
+    /* adopt first segment, the array grows in place from here */
+    msg = msg_stats;
+    clear_more_flag();
+    return;
+  }
+  try {
+    csegment::store_and_merge_msg(
+        static_cast<const rofl::openflow::cofmsg &>(*msg_stats));
+  } catch (...) {
+    delete msg_stats;
+    throw;
+  }
+  delete msg_stats;
+}
+
+void csegment::clear_more_flag() {
+  if (NULL == msg)
+    return;
+  if (dynamic_cast<rofl::openflow::cofmsg_stats_request *>(msg)) {
+    rofl::openflow::cofmsg_stats_request &req =
+        dynamic_cast<rofl::openflow::cofmsg_stats_request &>(*msg);
+    req.set_stats_flags(req.get_stats_flags() &
+                        ~rofl::openflow13::OFPMPF_REQ_MORE);
+  } else if (dynamic_cast<rofl::openflow::cofmsg_stats_reply *>(msg)) {
+    rofl::openflow::cofmsg_stats_reply &rep =
+        dynamic_cast<rofl::openflow::cofmsg_stats_reply &>(*msg);
+    rep.set_stats_flags(rep.get_stats_flags() &
+                        ~rofl::openflow13::OFPMPF_REQ_MORE);
+  }
+}
+
 rofl::openflow::cofmsg *csegment::retrieve_and_detach_msg() {
   rofl::openflow::cofmsg *tmp = msg;
   msg = NULL;
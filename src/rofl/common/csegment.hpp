@@ -15,6 +15,7 @@
 #include <inttypes.h>
 
 #include <iostream>
+#include <utility>
 
 #include "rofl/common/ctimespec.hpp"
 #include "rofl/common/exception.hpp"
@@ -75,24 +76,30 @@ public:
       : tspec(tspec), xid(xid), msg(nullptr), msg_type(msg_type),
         msg_multipart_type(msg_multipart_type){};
 
+  /**
+   * @brief	Segments own their stitched message and are move-only
+   */
+  csegment(const csegment &segment) = delete;
+  csegment &operator=(const csegment &segment) = delete;
+
   /**
    *
    */
-  csegment(const csegment &segment) { *this = segment; }
+  csegment(csegment &&segment) : msg(nullptr) { *this = std::move(segment); }
 
   /**
    *
    */
-  csegment &operator=(const csegment &segment) {
+  csegment &operator=(csegment &&segment) {
     if (this == &segment)
       return *this;
+    if (nullptr != msg) {
+      delete msg;
+    }
     tspec = segment.tspec;
     xid = segment.xid;
-    if (NULL != segment.msg) {
-      csegment::clone(*(segment.msg));
-    } else {
-      msg = NULL;
-    }
+    msg = segment.msg;
+    segment.msg = nullptr;
     msg_type = segment.msg_type;
     msg_multipart_type = segment.msg_multipart_type;
     return *this;
@@ -104,6 +111,11 @@ public:
    */
   bool is_expired() const { return tspec.is_expired(); };
 
+  /**
+   *
+   */
+  const ctimespec &get_tspec() const { return tspec; };
+
   /**
    *
    */
@@ -127,6 +139,13 @@ public:
    */
   void store_and_merge_msg(const rofl::openflow::cofmsg &msg);
 
+  /**
+   * @brief	Like store_and_merge_msg(const cofmsg&), but takes ownership of
+   * msg. The first segment is adopted without copying, further segments
+   * are merged and destroyed. msg is destroyed on error as well.
+   */
+  void store_and_merge_msg(rofl::openflow::cofmsg *msg);
+
   /**
    * @brief	Returns pointer to this->msg and sets this->msg to NULL. The
    * object resides on heap and must be destroyed by the calling entity.
@@ -139,6 +158,11 @@ private:
    */
   void clone(const rofl::openflow::cofmsg &msg);
 
+  /**
+   * @brief	Clears the MORE flag of the stitched message
+   */
+  void clear_more_flag();
+
 public:
   /**
    *
@@ -146,7 +170,7 @@ public:
   class csegment_is_expired {
   public:
     csegment_is_expired(){};
-    bool operator()(const std::pair<uint32_t, csegment> &p) const {
+    bool operator()(const std::pair<const uint32_t, csegment> &p) const {
       return p.second.is_expired();
     };
   };
@@ -173,7 +197,8 @@ public:
     }
 
     switch (msg.msg->get_version()) {
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
 
       switch (msg.msg->get_type()) {
       case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
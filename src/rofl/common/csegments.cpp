@@ -0,0 +1,99 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * csegments.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "csegments.hpp"
+
+#include <algorithm>
+
+using namespace rofl;
+
+csegment &csegments::add(uint32_t xid, const ctimespec &tspec,
+                         uint8_t msg_type, uint16_t msg_multipart_type) {
+  std::unordered_map<uint32_t, centry>::iterator it = segments.find(xid);
+  if (it != segments.end())
+    return it->second.segment;
+
+  purge();
+
+  it = segments
+           .emplace(xid, centry(csegment(xid, tspec, msg_type,
+                                         msg_multipart_type),
+                                seqno++))
+           .first;
+
+  cexpiry expiry;
+  expiry.tspec = tspec;
+  expiry.seqno = it->second.seqno;
+  expiry.xid = xid;
+  expiries.push_back(expiry);
+  std::push_heap(expiries.begin(), expiries.end());
+
+  return it->second.segment;
+}
+
+bool csegments::drop(uint32_t xid) {
+  if (segments.erase(xid) == 0)
+    return false;
+
+  if (segments.empty()) {
+    expiries.clear();
+  } else if (expiries.size() > 2 * segments.size() + 64) {
+    compact();
+  }
+  return true;
+}
+
+bool csegments::get_next_expiry(ctimespec &tspec) {
+  purge();
+  if (expiries.empty())
+    return false;
+  tspec = expiries.front().tspec;
+  return true;
+}
+
+bool csegments::pop_expired(csegment &segment,
+                            const ctimespec &reference_time) {
+  purge();
+  if (expiries.empty())
+    return false;
+  if (not expiries.front().tspec.is_expired(reference_time))
+    return false;
+
+  uint32_t xid = expiries.front().xid;
+  std::pop_heap(expiries.begin(), expiries.end());
+  expiries.pop_back();
+
+  std::unordered_map<uint32_t, centry>::iterator it = segments.find(xid);
+  segment = std::move(it->second.segment);
+  segments.erase(it);
+  return true;
+}
+
+void csegments::purge() {
+  while ((not expiries.empty()) &&
+         is_stale(expiries.front().xid, expiries.front().seqno)) {
+    std::pop_heap(expiries.begin(), expiries.end());
+    expiries.pop_back();
+  }
+}
+
+void csegments::compact() {
+  expiries.clear();
+  for (std::unordered_map<uint32_t, centry>::const_iterator it =
+           segments.begin();
+       it != segments.end(); ++it) {
+    cexpiry expiry;
+    expiry.tspec = it->second.segment.get_tspec();
+    expiry.seqno = it->second.seqno;
+    expiry.xid = it->first;
+    expiries.push_back(expiry);
+  }
+  std::make_heap(expiries.begin(), expiries.end());
+}
@@ -0,0 +1,162 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * csegments.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CSEGMENTS_HPP_
+#define SRC_ROFL_COMMON_CSEGMENTS_HPP_
+
+#include <inttypes.h>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "rofl/common/csegment.hpp"
+#include "rofl/common/ctimespec.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Set of multipart messages in reassembly indexed by xid and
+ * ordered by expiry
+ *
+ * Segments are stored in a hash table keyed by xid and are never copied,
+ * references returned by add() and get() stay valid until the segment is
+ * dropped. Expiry order is kept in a binary min-heap with lazy deletion
+ * like in ctransactions, so lookup, removal and insertion with a constant
+ * timeout are O(1) and an expiry sweep costs O(log n) per expired segment.
+ *
+ * This class does no locking on its own.
+ */
+class csegments {
+public:
+  /**
+   *
+   */
+  ~csegments(){};
+
+  /**
+   *
+   */
+  csegments() : seqno(0){};
+
+public:
+  /**
+   *
+   */
+  void clear() {
+    segments.clear();
+    expiries.clear();
+  };
+
+  /**
+   * @brief	Returns segment for xid, creates a new one if none is pending
+   */
+  csegment &add(uint32_t xid, const ctimespec &tspec, uint8_t msg_type,
+                uint16_t msg_multipart_type = 0);
+
+  /**
+   * @brief	Returns segment for xid, throws eSegmentedMessageNotFound
+   */
+  csegment &get(uint32_t xid) {
+    std::unordered_map<uint32_t, centry>::iterator it = segments.find(xid);
+    if (it == segments.end())
+      throw eSegmentedMessageNotFound("csegments::get() xid not found");
+    return it->second.segment;
+  };
+
+  /**
+   * @brief	Removes segment for xid, returns false if not found
+   */
+  bool drop(uint32_t xid);
+
+  /**
+   *
+   */
+  bool has(uint32_t xid) const {
+    return (segments.find(xid) != segments.end());
+  };
+
+  /**
+   *
+   */
+  size_t size() const { return segments.size(); };
+
+  /**
+   *
+   */
+  bool empty() const { return segments.empty(); };
+
+  /**
+   * @brief	Returns expiry of next segment, false if none is pending
+   */
+  bool get_next_expiry(ctimespec &tspec);
+
+  /**
+   * @brief	Removes next segment if expired at reference_time
+   */
+  bool pop_expired(csegment &segment,
+                   const ctimespec &reference_time = ctimespec::now());
+
+private:
+  /**
+   * @brief	Discards stale entries from top of heap
+   */
+  void purge();
+
+  /**
+   * @brief	Rebuilds heap from live segments
+   */
+  void compact();
+
+  /**
+   *
+   */
+  bool is_stale(uint32_t xid, uint64_t seqno) const {
+    std::unordered_map<uint32_t, centry>::const_iterator it =
+        segments.find(xid);
+    return ((it == segments.end()) || (it->second.seqno != seqno));
+  };
+
+private:
+  // segment in reassembly and the sequence number of its heap entry
+  struct centry {
+    csegment segment;
+    uint64_t seqno;
+
+    centry(csegment &&segment, uint64_t seqno)
+        : segment(std::move(segment)), seqno(seqno){};
+  };
+
+  // heap entry
+  struct cexpiry {
+    ctimespec tspec;
+    uint64_t seqno;
+    uint32_t xid;
+
+    // inverted for building a min-heap with std::push_heap
+    bool operator<(const cexpiry &e) const {
+      if (tspec == e.tspec)
+        return (seqno > e.seqno);
+      return (tspec > e.tspec);
+    };
+  };
+
+  // segments in reassembly by xid
+  std::unordered_map<uint32_t, centry> segments;
+
+  // expiry min-heap, may contain stale entries
+  std::vector<cexpiry> expiries;
+
+  // sequence number for next heap entry
+  uint64_t seqno;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CSEGMENTS_HPP_ */
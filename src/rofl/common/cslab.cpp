@@ -0,0 +1,252 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cslab.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "cslab.hpp"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+using namespace rofl;
+
+namespace {
+
+// free block, next_batch is valid for the first block of a depot batch only
+struct cblock {
+  cblock *next;
+  cblock *next_batch;
+};
+
+// free lists owned by a single thread
+struct ccache {
+  cblock *free_list[cslab::NUM_CLASSES];
+  unsigned int num_free[cslab::NUM_CLASSES];
+  uint64_t num_allocs;
+};
+
+// batches of free blocks shared by all threads, one entry per size class
+struct cdepot {
+  std::mutex lock;
+  cblock *batches = nullptr;
+  unsigned int num_batches = 0;
+};
+
+std::atomic_bool slab_enabled(true);
+
+cdepot depot[cslab::NUM_CLASSES];
+
+pthread_key_t cache_key;
+
+pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+
+// thread's cache
+thread_local ccache *tcache = nullptr;
+
+// true once thread exit cleanup has started
+thread_local bool tcache_dead = false;
+
+inline unsigned int size_class(size_t size) {
+  return (size == 0) ? 0 : (size - 1) / cslab::SLAB_ALIGN;
+}
+
+inline size_t class_size(unsigned int idx) {
+  return (idx + 1) * cslab::SLAB_ALIGN;
+}
+
+void *xmalloc(size_t size) {
+  void *ptr = ::malloc(size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/* moves BATCH_SIZE blocks from cache to depot, returns false if depot is
+ * full */
+bool release_batch(ccache *cache, unsigned int idx) {
+  cblock *head = cache->free_list[idx];
+  cblock *tail = head;
+  for (unsigned int i = 1; i < cslab::BATCH_SIZE; i++) {
+    tail = tail->next;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(depot[idx].lock);
+    if (depot[idx].num_batches >= cslab::MAX_DEPOT_BATCHES)
+      return false;
+    cache->free_list[idx] = tail->next;
+    cache->num_free[idx] -= cslab::BATCH_SIZE;
+    tail->next = nullptr;
+    head->next_batch = depot[idx].batches;
+    depot[idx].batches = head;
+    depot[idx].num_batches++;
+  }
+  return true;
+}
+
+/* fetches a batch from depot into an empty free list */
+void acquire_batch(ccache *cache, unsigned int idx) {
+  std::lock_guard<std::mutex> lock(depot[idx].lock);
+  cblock *head = depot[idx].batches;
+  if (head == nullptr)
+    return;
+  depot[idx].batches = head->next_batch;
+  depot[idx].num_batches--;
+  cache->free_list[idx] = head;
+  cache->num_free[idx] = cslab::BATCH_SIZE;
+}
+
+void flush_cache(ccache *cache) {
+  for (unsigned int idx = 0; idx < cslab::NUM_CLASSES; idx++) {
+    while (cache->num_free[idx] >= cslab::BATCH_SIZE) {
+      if (not release_batch(cache, idx))
+        break;
+    }
+    while (cache->free_list[idx] != nullptr) {
+      cblock *block = cache->free_list[idx];
+      cache->free_list[idx] = block->next;
+      ::free(block);
+    }
+    cache->num_free[idx] = 0;
+  }
+}
+
+void destroy_cache(void *arg) {
+  tcache = nullptr;
+  tcache_dead = true;
+  ccache *cache = static_cast<ccache *>(arg);
+  flush_cache(cache);
+  ::free(cache);
+}
+
+void create_cache_key() { pthread_key_create(&cache_key, &destroy_cache); }
+
+/* returns calling thread's cache or nullptr if unavailable */
+inline ccache *get_cache() {
+  ccache *cache = tcache;
+  if ((cache != nullptr) || tcache_dead)
+    return cache;
+  pthread_once(&cache_key_once, &create_cache_key);
+  if ((cache = static_cast<ccache *>(::calloc(1, sizeof(ccache)))) == nullptr)
+    return nullptr;
+  pthread_setspecific(cache_key, cache);
+  return (tcache = cache);
+}
+
+}; // end of anonymous namespace
+
+void *cslab::allocate(size_t size) {
+  ccache *cache = get_cache();
+  if (cache != nullptr)
+    cache->num_allocs++;
+
+  if (size > SLAB_MAX_SIZE)
+    return xmalloc(size);
+
+  /* small blocks always span their entire size class, so they can be
+   * cached by any thread regardless of slab_enabled */
+  unsigned int idx = size_class(size);
+  if ((cache == nullptr) || (not slab_enabled))
+    return xmalloc(class_size(idx));
+
+  if (cache->free_list[idx] == nullptr)
+    acquire_batch(cache, idx);
+
+  cblock *block = cache->free_list[idx];
+  if (block == nullptr)
+    return xmalloc(class_size(idx));
+
+  cache->free_list[idx] = block->next;
+  cache->num_free[idx]--;
+  return block;
+}
+
+void cslab::deallocate(void *ptr, size_t size) {
+  if (ptr == nullptr)
+    return;
+
+  ccache *cache = nullptr;
+  if ((size > SLAB_MAX_SIZE) || (not slab_enabled) ||
+      ((cache = get_cache()) == nullptr)) {
+    ::free(ptr);
+    return;
+  }
+
+  unsigned int idx = size_class(size);
+  cblock *block = static_cast<cblock *>(ptr);
+  block->next = cache->free_list[idx];
+  cache->free_list[idx] = block;
+
+  if (++(cache->num_free[idx]) > MAX_CACHED) {
+    if (not release_batch(cache, idx)) {
+      /* depot is full, return block to the system */
+      cache->free_list[idx] = block->next;
+      cache->num_free[idx]--;
+      ::free(block);
+    }
+  }
+}
+
+void *cslab::reallocate(void *ptr, size_t oldsize, size_t newsize) {
+  if (ptr == nullptr)
+    return allocate(newsize);
+
+  if ((oldsize > SLAB_MAX_SIZE) && (newsize > SLAB_MAX_SIZE)) {
+    ccache *cache = get_cache();
+    if (cache != nullptr)
+      cache->num_allocs++;
+    void *p = ::realloc(ptr, newsize);
+    if (p == nullptr)
+      throw std::bad_alloc();
+    return p;
+  }
+
+  if ((oldsize <= SLAB_MAX_SIZE) && (newsize <= SLAB_MAX_SIZE) &&
+      (size_class(oldsize) == size_class(newsize)))
+    return ptr;
+
+  void *p = allocate(newsize);
+  memcpy(p, ptr, (oldsize < newsize) ? oldsize : newsize);
+  deallocate(ptr, oldsize);
+  return p;
+}
+
+void cslab::set_enabled(bool enabled) {
+  slab_enabled = enabled;
+  if (not enabled)
+    flush();
+}
+
+bool cslab::is_enabled() { return slab_enabled; }
+
+uint64_t cslab::get_num_allocs() {
+  ccache *cache = get_cache();
+  return (cache != nullptr) ? cache->num_allocs : 0;
+}
+
+size_t cslab::get_num_cached() {
+  ccache *cache = get_cache();
+  if (cache == nullptr)
+    return 0;
+  size_t num_cached = 0;
+  for (unsigned int idx = 0; idx < NUM_CLASSES; idx++) {
+    num_cached += cache->num_free[idx];
+  }
+  return num_cached;
+}
+
+void cslab::flush() {
+  ccache *cache = get_cache();
+  if (cache != nullptr)
+    flush_cache(cache);
+}
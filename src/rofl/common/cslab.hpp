@@ -0,0 +1,103 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cslab.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CSLAB_HPP_
+#define SRC_ROFL_COMMON_CSLAB_HPP_
+
+#include <inttypes.h>
+#include <stddef.h>
+
+namespace rofl {
+
+/**
+ * @brief	Per-thread slab allocator for small objects and buffers
+ *
+ * Requests up to SLAB_MAX_SIZE bytes are rounded up to a multiple of
+ * SLAB_ALIGN bytes and served from a free list owned by the calling
+ * thread. Released blocks are put back on the releasing thread's free
+ * list. A thread holding more than MAX_CACHED blocks of a size class
+ * hands a batch of BATCH_SIZE blocks over to a global depot, where
+ * threads with an empty free list fetch it from. Thus messages decoded
+ * on one thread and destroyed on another one recycle their memory with
+ * a single lock operation per batch.
+ *
+ * Larger requests are passed through to malloc()/realloc()/free().
+ * Blocks must be released with the same size they were allocated with.
+ *
+ * Used by cofmsg, coxmatch, cofaction, cofinstruction and cmemory.
+ */
+class cslab {
+public:
+  /**
+   * @brief	Allocates size bytes, throws std::bad_alloc on failure
+   */
+  static void *allocate(size_t size);
+
+  /**
+   * @brief	Releases a block of size bytes obtained from allocate()
+   */
+  static void deallocate(void *ptr, size_t size);
+
+  /**
+   * @brief	Resizes a block, preserving min(oldsize, newsize) bytes
+   */
+  static void *reallocate(void *ptr, size_t oldsize, size_t newsize);
+
+public:
+  /**
+   * @brief	Enables or disables caching, e.g. for running memory checkers
+   *
+   * May be toggled at any time, blocks remain interchangeable.
+   */
+  static void set_enabled(bool enabled);
+
+  /**
+   *
+   */
+  static bool is_enabled();
+
+  /**
+   * @brief	Returns number of allocations made by the calling thread
+   */
+  static uint64_t get_num_allocs();
+
+  /**
+   * @brief	Returns number of blocks cached by the calling thread
+   */
+  static size_t get_num_cached();
+
+  /**
+   * @brief	Hands all blocks cached by the calling thread to the depot
+   */
+  static void flush();
+
+public:
+  // granularity of size classes
+  static size_t const SLAB_ALIGN = 16;
+
+  // largest size served from free lists
+  static size_t const SLAB_MAX_SIZE = 1024;
+
+  // number of size classes
+  static unsigned int const NUM_CLASSES = SLAB_MAX_SIZE / SLAB_ALIGN;
+
+  // number of blocks moved between thread and depot at once
+  static unsigned int const BATCH_SIZE = 32;
+
+  // maximum number of blocks per size class cached by a thread
+  static unsigned int const MAX_CACHED = 2 * BATCH_SIZE;
+
+  // maximum number of batches per size class stored in depot
+  static unsigned int const MAX_DEPOT_BATCHES = 64;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CSLAB_HPP_ */
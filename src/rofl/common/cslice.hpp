@@ -0,0 +1,142 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cslice.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CSLICE_HPP_
+#define SRC_ROFL_COMMON_CSLICE_HPP_
+
+#include <inttypes.h>
+#include <memory>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/exception.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Reference counted view into a shared memory chunk
+ *
+ * A cslice points to a byte range within a cmemory chunk owned by a
+ * std::shared_ptr. The chunk stays alive as long as any cslice refers
+ * to it, so payloads may be handed over without copying. The chunk must
+ * not be resized while slices refer to it.
+ */
+class cslice {
+public:
+  /**
+   *
+   */
+  ~cslice(){};
+
+  /**
+   *
+   */
+  cslice() : buf(nullptr), buflen(0){};
+
+  /**
+   *
+   */
+  cslice(const std::shared_ptr<cmemory> &chunk, size_t offset, size_t len)
+      : chunk(chunk), buf(nullptr), buflen(0) {
+    if ((not chunk) || (offset + len > chunk->memlen())) {
+      throw eInvalid("cslice::cslice() invalid range", __FILE__, __FUNCTION__,
+                     __LINE__);
+    }
+    buf = chunk->somem() + offset;
+    buflen = len;
+  };
+
+  /**
+   *
+   */
+  cslice(const cslice &slice)
+      : chunk(slice.chunk), buf(slice.buf), buflen(slice.buflen){};
+
+  /**
+   *
+   */
+  cslice &operator=(const cslice &slice) {
+    if (this == &slice)
+      return *this;
+    chunk = slice.chunk;
+    buf = slice.buf;
+    buflen = slice.buflen;
+    return *this;
+  };
+
+public:
+  /**
+   * @brief	Returns a view of len bytes starting at offset within this slice
+   */
+  cslice slice(size_t offset, size_t len) const {
+    if (offset + len > buflen) {
+      throw eInvalid("cslice::slice() invalid range", __FILE__, __FUNCTION__,
+                     __LINE__);
+    }
+    cslice s(*this);
+    s.buf = buf + offset;
+    s.buflen = len;
+    return s;
+  };
+
+  /**
+   * @brief	Drops the reference to the underlying chunk
+   */
+  void clear() {
+    chunk.reset();
+    buf = nullptr;
+    buflen = 0;
+  };
+
+  /**
+   * @brief	Returns true when no chunk is referenced
+   */
+  bool is_null() const { return (not chunk); };
+
+  /**
+   *
+   */
+  uint8_t *somem() const { return buf; };
+
+  /**
+   *
+   */
+  size_t length() const { return buflen; };
+
+  /**
+   *
+   */
+  bool empty() const { return (0 == buflen); };
+
+  /**
+   *
+   */
+  const std::shared_ptr<cmemory> &get_chunk() const { return chunk; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cslice &slice) {
+    os << "<cslice data:" << (void *)slice.buf << " datalen:" << slice.buflen
+       << " refs:" << slice.chunk.use_count() << " >" << std::endl;
+    return os;
+  };
+
+private:
+  // memory chunk shared by all slices
+  std::shared_ptr<cmemory> chunk;
+
+  // start of this view within chunk
+  uint8_t *buf;
+
+  // length of this view
+  size_t buflen;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CSLICE_HPP_ */
@@ -10,9 +10,11 @@
  */
 
 #include "cthread.hpp"
+#include "cthread_pool.hpp"
 #include <glog/logging.h>
 #include <iostream>
 #include <sys/eventfd.h>
+#include <sys/timerfd.h>
 
 using namespace rofl;
 
@@ -22,6 +24,7 @@ using namespace rofl;
 void cthread::initialize() {
   running = false;
   tid = 0;
+  timer_fd = -1;
 
   // worker thread
   if ((epfd = epoll_create(1)) < 0) {
@@ -91,6 +94,10 @@ void cthread::release() {
 
   ::close(epfd);
   ::close(event_fd);
+  if (timer_fd >= 0) {
+    ::close(timer_fd);
+    timer_fd = -1;
+  }
 }
 
 void cthread::add_fd(int fd, bool exception, bool edge_triggered) {
@@ -260,25 +267,31 @@ void cthread::drop_write_fd(int fd, bool exception) {
 
 void cthread::clear_timers() {
   AcquireReadWriteLock lock(tlock);
-  ordered_timers.clear();
+  timers.clear();
+  update_next_expiry();
 };
 
 bool cthread::add_timer(uint32_t timer_id, const ctimespec &tspec) {
-  std::pair<std::set<ctimer>::iterator, bool> rv;
   bool do_wakeup = false;
+  bool added = false;
   {
     AcquireReadWriteLock lock(tlock);
 
-    if (ordered_timers.empty() || tspec < ordered_timers.begin()->get_tspec())
+    /* wake up only if the thread would sleep past the new expiry, so
+     * re-arming a timer to a later point in time never wakes it up */
+    int64_t expiry = to_nsec(tspec);
+    if (expiry < next_expiry) {
+      next_expiry = expiry;
       do_wakeup = true;
+    }
 
-    auto timer_it = find_if(ordered_timers.begin(), ordered_timers.end(),
-                            ctimer_find_by_timer_id(timer_id));
-    if (timer_it != ordered_timers.end()) {
-      ordered_timers.erase(timer_it);
-      rv = ordered_timers.emplace(timer_id, tspec);
-    } else {
-      rv = ordered_timers.emplace(timer_id, tspec);
+    added = timers.add(timer_id, tspec);
+
+    /* pooled threads are woken up via timer_fd */
+    if (pooled) {
+      if (do_wakeup)
+        rearm_timer_fd();
+      return added;
     }
   }
 
@@ -286,46 +299,60 @@ bool cthread::add_timer(uint32_t timer_id, const ctimespec &tspec) {
     wakeup();
   }
 
-  return rv.second;
+  return added;
 }
 
-const ctimer &cthread::get_timer(uint32_t timer_id) const {
+ctimer cthread::get_timer(uint32_t timer_id) const {
   AcquireReadLock lock(tlock);
-  auto timer_it = find_if(ordered_timers.begin(), ordered_timers.end(),
-                          ctimer_find_by_timer_id(timer_id));
-  if (timer_it == ordered_timers.end()) {
+  const ctimer *timer = timers.find(timer_id);
+  if (timer == nullptr) {
     throw eThreadNotFound("cthread::get_timer() timer_id not found");
   }
-  return *timer_it;
+  return *timer;
 }
 
 bool cthread::drop_timer(uint32_t timer_id) {
+  /* no wakeup needed, an early return from epoll is harmless */
   AcquireReadWriteLock lock(tlock);
-  auto timer_it = find_if(ordered_timers.begin(), ordered_timers.end(),
-                          ctimer_find_by_timer_id(timer_id));
-  if (timer_it == ordered_timers.end()) {
-    return false;
-  }
-  ordered_timers.erase(timer_it);
-
-  if (tid != pthread_self()) {
-    wakeup();
-  }
-
-  return true;
+  return timers.drop(timer_id);
 }
 
 bool cthread::has_timer(uint32_t timer_id) const {
   AcquireReadLock lock(tlock);
-  auto timer_it = find_if(ordered_timers.begin(), ordered_timers.end(),
-                          ctimer_find_by_timer_id(timer_id));
-  return (not(timer_it == ordered_timers.end()));
+  return timers.has(timer_id);
 }
 
 void cthread::start(const std::string &thread_name) {
   switch (state) {
   case STATE_IDLE: {
 
+    if (cthread_pool::get_instance().is_running()) {
+      if (timer_fd < 0) {
+        if ((timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK)) < 0) {
+          throw eSysCall("eSysCall", "timerfd_create", __FILE__, __FUNCTION__,
+                         __LINE__);
+        }
+        struct epoll_event epev;
+        memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
+        epev.events = EPOLLIN; // level-triggered
+        epev.data.fd = timer_fd;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, timer_fd, &epev) < 0) {
+          throw eSysCall("eSysCall", "epoll_ctl (EPOLL_CTL_ADD)", __FILE__,
+                         __FUNCTION__, __LINE__);
+        }
+      }
+
+      running = true;
+      if (cthread_pool::get_instance().attach(this, affinity)) {
+        state = STATE_RUNNING;
+        AcquireReadLock lock(tlock);
+        rearm_timer_fd();
+        break;
+      }
+
+      /* pool has been stopped meanwhile, run on a thread of our own */
+    }
+
     running = true;
     if (pthread_create(&tid, NULL, &(cthread::start_loop), this) < 0) {
       throw eSysCall("eSysCall", "pthread_create", __FILE__, __FUNCTION__,
@@ -348,6 +375,12 @@ void cthread::stop() {
 
     running = false;
 
+    /* not pooled anymore, if a stopping pool moved us to our own thread */
+    if (pooled && cthread_pool::get_instance().detach(this)) {
+      state = STATE_IDLE;
+      break;
+    }
+
     wakeup();
 
     /* deletion of thread not initiated within this thread */
@@ -404,10 +437,14 @@ void *cthread::run_loop() {
 
       int timeout = 3600000; // in milliseconds: 1hour
 
-      {
-        AcquireReadLock lock(tlock);
-        if (not ordered_timers.empty()) {
-          timeout = ordered_timers.begin()->get_relative_timeout();
+      int64_t expiry = next_expiry;
+      if (expiry != NO_EXPIRY) {
+        /* round up, so we do not spin until the timer expires */
+        int64_t delta = expiry - to_nsec(ctimespec::now());
+        if (delta <= 0) {
+          timeout = 0;
+        } else if (delta < (int64_t)timeout * 1000000) {
+          timeout = (delta + 999999) / 1000000;
         }
       }
 
@@ -416,57 +453,10 @@ void *cthread::run_loop() {
       if (not running)
         goto out;
 
-      while (true) {
-        /* handle expired timers */
-        ctimer timer;
-        {
-          AcquireReadWriteLock lock(tlock);
-          if (ordered_timers.empty()) {
-            break;
-          }
-          timer = *(ordered_timers.begin());
-          if (not timer.get_tspec().is_expired()) {
-            break;
-          }
-          ordered_timers.erase(ordered_timers.begin());
-        } // release lock here
-        if (not running)
-          goto out;
-
-        env->handle_timeout(*this, timer.get_timer_id());
-      }
-
-      if (not running)
+      if (not handle_events(events, rc))
         goto out;
 
-      /* handle file descriptors */
-      if (rc > 0) {
-        for (int i = 0; i < rc; i++) {
-
-          if (not running)
-            goto out;
-
-          if (events[i].data.fd == event_fd) {
-
-            if (not running) {
-              return &retval;
-            }
-
-            if (events[i].events & EPOLLIN) {
-              uint64_t c;
-              int rcode = read(event_fd, &c, sizeof(c));
-              (void)rcode;
-              env->handle_wakeup(*this);
-            }
-
-          } else {
-            if (events[i].events & EPOLLIN)
-              env->handle_read_event(*this, events[i].data.fd);
-            if (events[i].events & EPOLLOUT)
-              env->handle_write_event(*this, events[i].data.fd);
-          }
-        }
-      } else if (rc < 0) {
+      if (rc < 0) {
 
         switch (errno) {
         case EINTR: {
@@ -497,3 +487,126 @@ out:
 
   return &retval;
 }
+
+void cthread::run_once() {
+  try {
+
+    struct epoll_event events[64];
+
+    int rc = epoll_wait(epfd, events, 64, 0);
+
+    if (not running)
+      return;
+
+    if (not handle_events(events, rc))
+      return;
+
+    AcquireReadLock lock(tlock);
+    rearm_timer_fd();
+
+  } catch (eThreadNotFound &e) {
+    std::cerr << __FUNCTION__
+              << ": ERROR, caught eThreadNotFound: " << e.what() << std::endl;
+  } catch (std::runtime_error &e) {
+    std::cerr << __FUNCTION__
+              << ": ERROR, caught runtime_error: " << e.what() << std::endl;
+  } catch (std::exception &e) {
+    std::cerr << __FUNCTION__ << ": ERROR, caught exception: " << e.what()
+              << std::endl;
+  } catch (...) {
+    std::cerr << __FUNCTION__ << ": ERROR, caught unknown error" << std::endl;
+  }
+}
+
+void cthread::unpool() {
+  pooled = false;
+  if (pthread_create(&tid, NULL, &(cthread::start_loop), this) != 0) {
+    std::cerr << __FUNCTION__
+              << ": ERROR, pthread_create failed, cthread stopped" << std::endl;
+    running = false;
+    state = STATE_IDLE;
+  }
+}
+
+bool cthread::handle_events(struct epoll_event *events, int rc) {
+  while (true) {
+    /* handle expired timers, skip locking when none is due */
+    ctimespec now = ctimespec::now();
+    if (next_expiry > to_nsec(now))
+      break;
+    ctimer timer;
+    {
+      AcquireReadWriteLock lock(tlock);
+      if (timers.empty()) {
+        next_expiry = NO_EXPIRY;
+        break;
+      }
+      timer = timers.front();
+      if (not timer.get_tspec().is_expired(now)) {
+        update_next_expiry();
+        break;
+      }
+      timers.pop_front();
+      update_next_expiry();
+    } // release lock here
+    if (not running)
+      return false;
+
+    env->handle_timeout(*this, timer.get_timer_id());
+  }
+
+  if (not running)
+    return false;
+
+  /* handle file descriptors */
+  for (int i = 0; i < rc; i++) {
+
+    if (not running)
+      return false;
+
+    if (events[i].data.fd == event_fd) {
+
+      if (events[i].events & EPOLLIN) {
+        uint64_t c;
+        int rcode = read(event_fd, &c, sizeof(c));
+        (void)rcode;
+        env->handle_wakeup(*this);
+      }
+
+    } else if (events[i].data.fd == timer_fd) {
+
+      /* expired timers have been handled above already */
+      uint64_t c;
+      int rcode = read(timer_fd, &c, sizeof(c));
+      (void)rcode;
+
+    } else {
+      if (events[i].events & EPOLLIN)
+        env->handle_read_event(*this, events[i].data.fd);
+      if (events[i].events & EPOLLOUT)
+        env->handle_write_event(*this, events[i].data.fd);
+    }
+  }
+
+  return true;
+}
+
+void cthread::rearm_timer_fd() {
+  if (timer_fd < 0)
+    return;
+
+  struct itimerspec its;
+  memset((uint8_t *)&its, 0, sizeof(its));
+  if (not timers.empty()) {
+    its.it_value = timers.front().get_tspec().get_tspec();
+    /* an all-zero it_value would disarm the timer */
+    if ((its.it_value.tv_sec == 0) && (its.it_value.tv_nsec == 0)) {
+      its.it_value.tv_nsec = 1;
+    }
+  }
+
+  if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+    throw eSysCall("eSysCall", "timerfd_settime", __FILE__, __FUNCTION__,
+                   __LINE__);
+  }
+}
@@ -64,6 +64,8 @@ protected:
 };
 
 class cthread {
+  friend class cthread_pool;
+
 public:
   /**
    *
@@ -79,7 +81,11 @@ public:
   /**
    *
    */
-  cthread(cthread_env *env) : env(env), state(STATE_IDLE) { initialize(); };
+  cthread(cthread_env *env)
+      : env(env), affinity(env), pooled(false), worker_id(0), cookie(0),
+        next_expiry(NO_EXPIRY), state(STATE_IDLE) {
+    initialize();
+  };
 
 public:
   /**
@@ -87,6 +93,23 @@ public:
    */
   pthread_t get_thread_id() const { return tid; };
 
+  /**
+   * @brief	Returns true when this cthread runs on a cthread_pool worker
+   */
+  bool is_pooled() const { return pooled; };
+
+  /**
+   * @brief	Set key for selecting a cthread_pool worker
+   *
+   * All cthread instances sharing the same key are attached to the same
+   * pool worker. Defaults to the cthread_env instance. Must be set before
+   * calling start().
+   */
+  cthread &set_affinity(const void *affinity) {
+    this->affinity = affinity;
+    return *this;
+  };
+
   /**
    * @brief	Wake up RX thread via rx pipe
    */
@@ -129,14 +152,16 @@ public:
   void clear_timers();
 
   /**
+   * @brief	Arms timer_id, an already armed timer_id is re-armed
    *
+   * @return true if timer_id was newly armed, false if it was re-armed
    */
   bool add_timer(uint32_t timer_id, const ctimespec &tspec);
 
   /**
-   *
+   * @brief	Returns a copy of timer_id, throws eThreadNotFound if not armed
    */
-  const ctimer &get_timer(uint32_t timer_id) const;
+  ctimer get_timer(uint32_t timer_id) const;
 
   /**
    *
@@ -153,7 +178,9 @@ public:
    * @brief	Starts worker thread
    *
    * Sets run flag run_rx_thread to true and calls
-   * syscall pthread_create() for starting worker thread.
+   * syscall pthread_create() for starting worker thread. If the
+   * cthread_pool is running, this cthread is attached to a pool worker
+   * instead and no thread is created.
    */
   void start(const std::string &thread_name = std::string(""));
 
@@ -171,10 +198,10 @@ public:
 public:
   friend std::ostream &operator<<(std::ostream &os, const cthread &thread) {
     os << "cthread, tid: " << &thread << std::endl;
-    if (not thread.ordered_timers.empty()) {
-      os << "next timeout: "
-         << thread.ordered_timers.begin()->get_relative_timeout() << std::endl;
-      for (auto tspec : thread.ordered_timers) {
+    if (not thread.timers.empty()) {
+      os << "next timeout: " << thread.timers.front().get_relative_timeout()
+         << std::endl;
+      for (auto tspec : thread.timers) {
         os << "timer: " << tspec << std::endl;
       }
     } else {
@@ -215,6 +242,46 @@ private:
    */
   void *run_loop();
 
+  /**
+   * @brief	Handle expired timers and events returned by epoll
+   *
+   * Returns false when this thread has been stopped meanwhile.
+   */
+  bool handle_events(struct epoll_event *events, int rc);
+
+  /**
+   * @brief	Single non-blocking round of the event loop, called by a
+   * cthread_pool worker
+   */
+  void run_once();
+
+  /**
+   * @brief	Continue on a pthread of its own, called by a stopping
+   * cthread_pool
+   */
+  void unpool();
+
+  /**
+   * @brief	Arm timer_fd for the next timer, must be called with tlock held
+   */
+  void rearm_timer_fd();
+
+  /**
+   * @brief	Set next_expiry to the next timer, must be called with tlock held
+   */
+  void update_next_expiry() {
+    next_expiry = timers.empty() ? NO_EXPIRY
+                                 : to_nsec(timers.front().get_tspec());
+  };
+
+  /**
+   *
+   */
+  static int64_t to_nsec(const ctimespec &tspec) {
+    return (int64_t)tspec.get_tspec().tv_sec * 1000000000 +
+           tspec.get_tspec().tv_nsec;
+  };
+
 private:
   // true: continue to run worker thread
   std::atomic_bool running;
@@ -222,6 +289,16 @@ private:
   // thread environment
   cthread_env *env;
 
+  // key for selecting a cthread_pool worker
+  const void *affinity;
+
+  // true: attached to a cthread_pool worker
+  std::atomic_bool pooled;
+
+  // cthread_pool worker index and cookie, valid when pooled
+  unsigned int worker_id;
+  uint32_t cookie;
+
   // thread related variables
   static const int PIPE_READ_FD;
   static const int PIPE_WRITE_FD;
@@ -232,11 +309,17 @@ private:
   // thread
   int retval; // worker thread return value
   int epfd;   // worker thread epoll fd
+  int timer_fd; // timerfd for next timer, used when pooled
 
   crwlock tlock; // thread lock
 
   std::map<int, uint32_t> fds;     // set of registered file descriptors
-  std::set<ctimer> ordered_timers; // ordered set of timers
+  ctimers timers;                  // timers indexed by timer_id
+
+  // lower bound for expiry of next timer in nanoseconds, the event loop
+  // sleeps until then without taking tlock
+  std::atomic<int64_t> next_expiry;
+  static const int64_t NO_EXPIRY = INT64_MAX;
 
   enum thread_state_t {
     STATE_IDLE = 0,
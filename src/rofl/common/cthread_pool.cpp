@@ -0,0 +1,335 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cthread_pool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "cthread_pool.hpp"
+#include "cthread.hpp"
+#include <glog/logging.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace rofl;
+
+/*static*/ cthread_pool &cthread_pool::get_instance() {
+  static cthread_pool pool;
+  return pool;
+}
+
+cthread_pool::~cthread_pool() { stop(); }
+
+cthread_pool::cthread_pool() : running(false) {}
+
+void cthread_pool::start(unsigned int num_workers) {
+  AcquireReadWriteLock slock(state_lock);
+  AcquireReadWriteLock lock(pool_lock);
+  if (running)
+    return;
+
+  if (num_workers == 0) {
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_workers = (num_cpus > 0) ? num_cpus : 1;
+  }
+
+  for (unsigned int i = 0; i < num_workers; i++) {
+    std::shared_ptr<cworker> worker(new cworker(i));
+    worker->start();
+    workers.push_back(worker);
+  }
+
+  running = true;
+
+  VLOG(2) << __FUNCTION__ << " started cthread_pool, #workers: " << num_workers;
+}
+
+void cthread_pool::stop() {
+  AcquireReadWriteLock slock(state_lock);
+  {
+    AcquireReadWriteLock lock(pool_lock);
+    if (not running)
+      return;
+
+    for (auto worker : workers) {
+      if (worker->get_thread_id() == pthread_self()) {
+        throw eInvalid("cthread_pool::stop() called from within a worker",
+                       __FILE__, __FUNCTION__, __LINE__);
+      }
+    }
+
+    /* attach() fails from now on, cthreads start on pthreads of their own */
+    running = false;
+  } // release lock here, event handlers may attach or detach meanwhile
+
+  for (auto worker : workers) {
+    worker->stop();
+  }
+
+  /* workers are idle, move cthreads still attached to their own pthread */
+  for (auto worker : workers) {
+    worker->unpool_all();
+  }
+
+  AcquireReadWriteLock lock(pool_lock);
+  workers.clear();
+  affinities.clear();
+
+  VLOG(2) << __FUNCTION__ << " stopped cthread_pool";
+}
+
+size_t cthread_pool::get_num_threads(unsigned int worker_id) const {
+  AcquireReadLock lock(pool_lock);
+  if (worker_id >= workers.size())
+    return 0;
+  pthread_mutex_lock(&(workers[worker_id]->mutex));
+  size_t num_threads = workers[worker_id]->threads.size();
+  pthread_mutex_unlock(&(workers[worker_id]->mutex));
+  return num_threads;
+}
+
+bool cthread_pool::attach(cthread *thread, const void *affinity) {
+  AcquireReadWriteLock lock(pool_lock);
+  if (not running)
+    return false;
+
+  auto it = affinities.find(affinity);
+  if (it == affinities.end()) {
+    /* new affinity key: select least loaded worker */
+    unsigned int worker_id = 0;
+    size_t min_threads = (size_t)-1;
+    for (unsigned int i = 0; i < workers.size(); i++) {
+      pthread_mutex_lock(&(workers[i]->mutex));
+      size_t num_threads = workers[i]->threads.size();
+      pthread_mutex_unlock(&(workers[i]->mutex));
+      if (num_threads < min_threads) {
+        min_threads = num_threads;
+        worker_id = i;
+      }
+    }
+    it = affinities.insert(std::make_pair(affinity, std::make_pair(worker_id, 0)))
+             .first;
+  }
+
+  thread->worker_id = it->second.first;
+  workers[thread->worker_id]->attach(thread);
+  it->second.second++;
+  return true;
+}
+
+bool cthread_pool::detach(cthread *thread) {
+  std::shared_ptr<cworker> worker;
+  {
+    AcquireReadWriteLock lock(pool_lock);
+    if (thread->worker_id >= workers.size())
+      return false;
+
+    worker = workers[thread->worker_id];
+    if (not worker->detach(thread))
+      return false;
+
+    auto it = affinities.find(thread->affinity);
+    if ((it != affinities.end()) && (--(it->second.second) == 0)) {
+      affinities.erase(it);
+    }
+  } // release lock here, the worker may attach other cthreads meanwhile
+
+  worker->wait_idle(thread);
+  return true;
+}
+
+cthread_pool::cworker::~cworker() {
+  pthread_cond_destroy(&cond);
+  pthread_mutex_destroy(&mutex);
+  ::close(event_fd);
+  ::close(epfd);
+}
+
+cthread_pool::cworker::cworker(unsigned int worker_id)
+    : worker_id(worker_id), running(false), epfd(-1), event_fd(-1), tid(0),
+      retval(0), next_cookie(1), current(nullptr) {
+  if ((epfd = epoll_create(1)) < 0) {
+    throw eSysCall("eSysCall", "epoll_create", __FILE__, __FUNCTION__,
+                   __LINE__);
+  }
+
+  if ((event_fd = eventfd(0, EFD_NONBLOCK)) < 0) {
+    ::close(epfd);
+    throw eSysCall("eSysCall", "eventfd", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  /* cookie 0 is reserved for the worker's own event_fd */
+  struct epoll_event epev;
+  memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
+  epev.events = EPOLLIN; // level-triggered
+  epev.data.u64 = 0;
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, event_fd, &epev) < 0) {
+    ::close(event_fd);
+    ::close(epfd);
+    throw eSysCall("eSysCall", "epoll_ctl (EPOLL_CTL_ADD)", __FILE__,
+                   __FUNCTION__, __LINE__);
+  }
+
+  pthread_mutex_init(&mutex, NULL);
+  pthread_cond_init(&cond, NULL);
+}
+
+void cthread_pool::cworker::start() {
+  running = true;
+  if (pthread_create(&tid, NULL, &(cworker::start_loop), this) < 0) {
+    running = false;
+    throw eSysCall("eSysCall", "pthread_create", __FILE__, __FUNCTION__,
+                   __LINE__);
+  }
+}
+
+void cthread_pool::cworker::stop() {
+  if (not running)
+    return;
+
+  running = false;
+
+  uint64_t c = 1;
+  int rcode = ::write(event_fd, &c, sizeof(c));
+  (void)rcode;
+
+  pthread_join(tid, NULL);
+}
+
+void cthread_pool::cworker::attach(cthread *thread) {
+  pthread_mutex_lock(&mutex);
+
+  uint32_t cookie = next_cookie++;
+  if (next_cookie == 0)
+    next_cookie = 1;
+  thread->cookie = cookie;
+  thread->tid = tid;
+  threads[cookie] = thread;
+
+  struct epoll_event epev;
+  memset((uint8_t *)&epev, 0, sizeof(struct epoll_event));
+  epev.events = EPOLLIN; // level-triggered
+  epev.data.u64 = cookie;
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, thread->epfd, &epev) < 0) {
+    threads.erase(cookie);
+    pthread_mutex_unlock(&mutex);
+    throw eSysCall("eSysCall", "epoll_ctl (EPOLL_CTL_ADD)", __FILE__,
+                   __FUNCTION__, __LINE__);
+  }
+  thread->pooled = true;
+
+  pthread_mutex_unlock(&mutex);
+
+  VLOG(3) << __FUNCTION__ << " attached cthread to worker: " << worker_id
+          << ", cookie: " << cookie;
+}
+
+bool cthread_pool::cworker::detach(cthread *thread) {
+  pthread_mutex_lock(&mutex);
+
+  auto it = threads.find(thread->cookie);
+  if ((it == threads.end()) || (it->second != thread)) {
+    pthread_mutex_unlock(&mutex);
+    return false;
+  }
+  threads.erase(it);
+  epoll_ctl(epfd, EPOLL_CTL_DEL, thread->epfd, NULL);
+  thread->pooled = false;
+
+  pthread_mutex_unlock(&mutex);
+
+  VLOG(3) << __FUNCTION__ << " detached cthread from worker: " << worker_id
+          << ", cookie: " << thread->cookie;
+
+  return true;
+}
+
+void cthread_pool::cworker::wait_idle(cthread *thread) {
+  if (pthread_self() == tid)
+    return;
+
+  /* wait for worker to finish processing this thread's events */
+  pthread_mutex_lock(&mutex);
+  while (current == thread) {
+    pthread_cond_wait(&cond, &mutex);
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+void cthread_pool::cworker::unpool_all() {
+  /* a concurrent detach() either finds a thread here or sees it unpooled */
+  pthread_mutex_lock(&mutex);
+  for (auto it : threads) {
+    epoll_ctl(epfd, EPOLL_CTL_DEL, it.second->epfd, NULL);
+    it.second->unpool();
+  }
+  threads.clear();
+  pthread_mutex_unlock(&mutex);
+}
+
+void *cthread_pool::cworker::run_loop() {
+  retval = 0;
+  sigset_t signal_set;
+  sigfillset(&signal_set); // ignore all signals
+
+  while (running) {
+    struct epoll_event events[64];
+
+    int rc = epoll_pwait(epfd, events, 64, -1, &signal_set);
+
+    if (rc < 0) {
+      switch (errno) {
+      case EINTR: {
+        // signal received
+      } break;
+      default: {
+        retval = -1;
+        goto out;
+      };
+      }
+      continue;
+    }
+
+    for (int i = 0; i < rc; i++) {
+
+      if (not running)
+        goto out;
+
+      uint32_t cookie = events[i].data.u64;
+
+      if (cookie == 0) {
+        uint64_t c;
+        int rcode = ::read(event_fd, &c, sizeof(c));
+        (void)rcode;
+        continue;
+      }
+
+      cthread *thread = nullptr;
+      pthread_mutex_lock(&mutex);
+      auto it = threads.find(cookie);
+      if (it != threads.end()) {
+        thread = current = it->second;
+      }
+      pthread_mutex_unlock(&mutex);
+
+      /* thread has been detached in the meantime */
+      if (thread == nullptr)
+        continue;
+
+      thread->run_once();
+
+      pthread_mutex_lock(&mutex);
+      current = nullptr;
+      pthread_cond_broadcast(&cond);
+      pthread_mutex_unlock(&mutex);
+    }
+  }
+
+out:
+
+  return &retval;
+}
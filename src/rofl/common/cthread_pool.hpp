@@ -0,0 +1,215 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cthread_pool.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CTHREAD_POOL_HPP_
+#define SRC_ROFL_COMMON_CTHREAD_POOL_HPP_
+
+#include <pthread.h>
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <inttypes.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "rofl/common/exception.hpp"
+#include "rofl/common/locking.hpp"
+
+namespace rofl {
+
+class cthread; // forward declaration
+
+/**
+ * @brief	Pool of event loop workers shared by cthread instances
+ *
+ * By default every cthread instance spawns its own pthread. Once the
+ * pool has been started, cthread::start() attaches a cthread to one of
+ * the pool's workers instead. A worker observes the epoll sets of all
+ * attached cthread instances and runs their event handlers in its own
+ * context, so a crofconn with its crofsock costs no dedicated threads.
+ *
+ * cthread instances announcing the same affinity key are pinned to the
+ * same worker, see cthread::set_affinity(). When the pool is stopped,
+ * all cthread instances still attached continue on pthreads of their
+ * own.
+ */
+class cthread_pool {
+  friend class cthread;
+
+public:
+  /**
+   * @brief	Returns the process wide pool instance
+   */
+  static cthread_pool &get_instance();
+
+public:
+  /**
+   *
+   */
+  ~cthread_pool();
+
+  /**
+   *
+   */
+  cthread_pool();
+
+public:
+  /**
+   * @brief	Starts num_workers workers
+   *
+   * A value of zero starts one worker per online CPU. Only cthread
+   * instances started after this call are attached to the pool.
+   */
+  void start(unsigned int num_workers = 0);
+
+  /**
+   * @brief	Stops all workers and waits for their termination
+   *
+   * cthread instances still attached are moved to pthreads of their
+   * own. Must not be called from within a worker, i.e. from an event
+   * handler of a pooled cthread.
+   */
+  void stop();
+
+  /**
+   *
+   */
+  bool is_running() const { return running; };
+
+  /**
+   *
+   */
+  unsigned int get_num_workers() const {
+    AcquireReadLock lock(pool_lock);
+    return workers.size();
+  };
+
+  /**
+   * @brief	Returns number of cthread instances attached to a worker
+   */
+  size_t get_num_threads(unsigned int worker_id) const;
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cthread_pool &pool) {
+    unsigned int num_workers = pool.get_num_workers();
+    os << "<cthread_pool #workers: " << num_workers << " >" << std::endl;
+    for (unsigned int i = 0; i < num_workers; i++) {
+      os << "  <worker " << i << " #threads: " << pool.get_num_threads(i)
+         << " >" << std::endl;
+    }
+    return os;
+  };
+
+private:
+  /**
+   * @brief	A single event loop running on its own pthread
+   */
+  class cworker {
+  public:
+    ~cworker();
+
+    cworker(unsigned int worker_id);
+
+  public:
+    void start();
+
+    void stop();
+
+    void attach(cthread *thread);
+
+    bool detach(cthread *thread);
+
+    void wait_idle(cthread *thread);
+
+    void unpool_all();
+
+    pthread_t get_thread_id() const { return tid; };
+
+  private:
+    static void *start_loop(void *arg) {
+      return static_cast<cworker *>(arg)->run_loop();
+    };
+
+    void *run_loop();
+
+  public:
+    // worker index within pool
+    unsigned int worker_id;
+
+    // true: continue to run worker
+    std::atomic_bool running;
+
+    // worker epoll fd, observing the epoll fds of all attached cthreads
+    int epfd;
+
+    // event fd for waking up the worker
+    int event_fd;
+
+    // pthread_t for worker
+    pthread_t tid;
+
+    // worker return value
+    int retval;
+
+    // cookie assigned to the next attached cthread
+    uint32_t next_cookie;
+
+    // attached cthread instances indexed by cookie
+    std::map<uint32_t, cthread *> threads;
+
+    // cthread instance currently processed by this worker
+    cthread *current;
+
+    // protects threads and current
+    pthread_mutex_t mutex;
+
+    // signaled when current is reset
+    pthread_cond_t cond;
+  };
+
+  /**
+   * @brief	Attaches thread to a worker selected by affinity key
+   *
+   * Returns false when the pool is not running.
+   */
+  bool attach(cthread *thread, const void *affinity);
+
+  /**
+   * @brief	Detaches thread from its worker
+   *
+   * When called from outside of the worker, waits until the worker
+   * has finished processing any pending events for thread. Returns
+   * false when thread is not attached anymore, i.e. stop() has moved
+   * it to a pthread of its own.
+   */
+  bool detach(cthread *thread);
+
+private:
+  // true: workers are running
+  std::atomic_bool running;
+
+  // all workers, shared with detach() waiting outside of pool_lock
+  std::vector<std::shared_ptr<cworker>> workers;
+
+  // affinity key => (worker index, number of cthreads using this key)
+  std::map<const void *, std::pair<unsigned int, unsigned int>> affinities;
+
+  // protects running, workers and affinities
+  crwlock pool_lock;
+
+  // serializes start() and stop()
+  crwlock state_lock;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CTHREAD_POOL_HPP_ */
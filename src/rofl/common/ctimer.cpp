@@ -12,3 +12,78 @@
 #include "ctimer.hpp"
 
 using namespace rofl;
+
+bool ctimers::add(uint32_t timer_id, const ctimespec &tspec) {
+  std::unordered_map<uint32_t, size_t>::iterator it = slots.find(timer_id);
+  if (it == slots.end()) {
+    heap.push_back(ctimer(timer_id, tspec));
+    slots[timer_id] = heap.size() - 1;
+    sift_up(heap.size() - 1);
+    return true;
+  }
+
+  /* re-arm in place */
+  size_t idx = it->second;
+  bool earlier = (tspec < heap[idx].get_tspec());
+  heap[idx] = ctimer(timer_id, tspec);
+  if (earlier) {
+    sift_up(idx);
+  } else {
+    sift_down(idx);
+  }
+  return false;
+}
+
+bool ctimers::drop(uint32_t timer_id) {
+  std::unordered_map<uint32_t, size_t>::iterator it = slots.find(timer_id);
+  if (it == slots.end())
+    return false;
+
+  size_t idx = it->second;
+  slots.erase(it);
+
+  size_t last = heap.size() - 1;
+  if (idx != last) {
+    heap[idx] = heap[last];
+    slots[heap[idx].get_timer_id()] = idx;
+  }
+  heap.pop_back();
+
+  if (idx < heap.size()) {
+    sift_up(idx);
+    sift_down(idx);
+  }
+  return true;
+}
+
+void ctimers::sift_up(size_t idx) {
+  while (idx > 0) {
+    size_t parent = (idx - 1) / 2;
+    if (not(heap[idx] < heap[parent]))
+      break;
+    swap(idx, parent);
+    idx = parent;
+  }
+}
+
+void ctimers::sift_down(size_t idx) {
+  while (true) {
+    size_t left = 2 * idx + 1;
+    size_t right = left + 1;
+    size_t smallest = idx;
+    if ((left < heap.size()) && (heap[left] < heap[smallest]))
+      smallest = left;
+    if ((right < heap.size()) && (heap[right] < heap[smallest]))
+      smallest = right;
+    if (smallest == idx)
+      break;
+    swap(idx, smallest);
+    idx = smallest;
+  }
+}
+
+void ctimers::swap(size_t a, size_t b) {
+  std::swap(heap[a], heap[b]);
+  slots[heap[a].get_timer_id()] = a;
+  slots[heap[b].get_timer_id()] = b;
+}
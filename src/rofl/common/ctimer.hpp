@@ -15,6 +15,8 @@
 #include <algorithm>
 #include <errno.h>
 #include <list>
+#include <unordered_map>
+#include <vector>
 #include <ostream>
 #include <time.h>
 
@@ -131,6 +133,120 @@ public:
   bool operator()(const ctimer &t) { return (t.get_timer_id() == timer_id); }
 };
 
+/**
+ * @brief	Set of timers indexed by timer_id and ordered by expiry
+ *
+ * Timers are kept in a binary min-heap, a hash table maps each timer_id
+ * to its slot in the heap. Lookup by timer_id and access to the next
+ * timer are O(1), arming, re-arming and cancelling a timer are O(log n)
+ * heap operations without any memory allocation once the heap has grown.
+ * This class does no locking on its own.
+ */
+class ctimers {
+public:
+  /**
+   *
+   */
+  ~ctimers(){};
+
+  /**
+   *
+   */
+  ctimers(){};
+
+public:
+  /**
+   *
+   */
+  void clear() {
+    heap.clear();
+    slots.clear();
+  };
+
+  /**
+   *
+   */
+  bool empty() const { return heap.empty(); };
+
+  /**
+   *
+   */
+  size_t size() const { return heap.size(); };
+
+  /**
+   * @brief	Arms timer_id, an already armed timer_id is re-armed
+   *
+   * @return true if timer_id was newly armed, false if it was re-armed
+   */
+  bool add(uint32_t timer_id, const ctimespec &tspec);
+
+  /**
+   * @brief	Cancels timer_id, returns false if not armed
+   */
+  bool drop(uint32_t timer_id);
+
+  /**
+   *
+   */
+  bool has(uint32_t timer_id) const {
+    return (slots.find(timer_id) != slots.end());
+  };
+
+  /**
+   * @brief	Returns timer for timer_id or nullptr if not armed
+   *
+   * The pointer is invalidated by the next call to add() or drop().
+   */
+  const ctimer *find(uint32_t timer_id) const {
+    std::unordered_map<uint32_t, size_t>::const_iterator it =
+        slots.find(timer_id);
+    return (it == slots.end()) ? nullptr : &heap[it->second];
+  };
+
+  /**
+   * @brief	Returns timer expiring next, must not be called when empty
+   */
+  const ctimer &front() const { return heap.front(); };
+
+  /**
+   * @brief	Removes timer expiring next
+   */
+  void pop_front() { drop(heap.front().get_timer_id()); };
+
+  /**
+   * @brief	Timers in heap order
+   */
+  std::vector<ctimer>::const_iterator begin() const { return heap.begin(); };
+
+  /**
+   *
+   */
+  std::vector<ctimer>::const_iterator end() const { return heap.end(); };
+
+private:
+  /**
+   *
+   */
+  void sift_up(size_t idx);
+
+  /**
+   *
+   */
+  void sift_down(size_t idx);
+
+  /**
+   *
+   */
+  void swap(size_t a, size_t b);
+
+private:
+  // min-heap ordered by expiry and timer_id
+  std::vector<ctimer> heap;
+
+  // timer_id => index in heap
+  std::unordered_map<uint32_t, size_t> slots;
+};
+
 }; // end of namespace rofl
 
 #endif /* SRC_ROFL_COMMON_CTIMER_HPP_ */
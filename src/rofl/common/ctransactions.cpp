@@ -0,0 +1,96 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * ctransactions.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ctransactions.hpp"
+
+#include <algorithm>
+
+using namespace rofl;
+
+bool ctransactions::add(const ctransaction &ta) {
+  purge();
+
+  centry &entry = transactions[ta.get_xid()];
+  entry.ta = ta;
+  entry.seqno = seqno++;
+
+  cexpiry expiry;
+  expiry.tspec = ta.get_tspec();
+  expiry.seqno = entry.seqno;
+  expiry.xid = ta.get_xid();
+  expiries.push_back(expiry);
+  std::push_heap(expiries.begin(), expiries.end());
+
+  /* replacing an xid leaves a stale entry behind */
+  if (expiries.size() > 2 * transactions.size() + 64)
+    compact();
+
+  return (expiries.front().seqno == entry.seqno);
+}
+
+bool ctransactions::drop(uint32_t xid) {
+  if (transactions.erase(xid) == 0)
+    return false;
+
+  if (transactions.empty()) {
+    expiries.clear();
+  } else if (expiries.size() > 2 * transactions.size() + 64) {
+    compact();
+  }
+  return true;
+}
+
+bool ctransactions::get_next_expiry(ctimespec &tspec) {
+  purge();
+  if (expiries.empty())
+    return false;
+  tspec = expiries.front().tspec;
+  return true;
+}
+
+bool ctransactions::pop_expired(ctransaction &ta,
+                                const ctimespec &reference_time) {
+  purge();
+  if (expiries.empty())
+    return false;
+  if (not expiries.front().tspec.is_expired(reference_time))
+    return false;
+
+  uint32_t xid = expiries.front().xid;
+  std::pop_heap(expiries.begin(), expiries.end());
+  expiries.pop_back();
+
+  std::unordered_map<uint32_t, centry>::iterator it = transactions.find(xid);
+  ta = it->second.ta;
+  transactions.erase(it);
+  return true;
+}
+
+void ctransactions::purge() {
+  while ((not expiries.empty()) &&
+         is_stale(expiries.front().xid, expiries.front().seqno)) {
+    std::pop_heap(expiries.begin(), expiries.end());
+    expiries.pop_back();
+  }
+}
+
+void ctransactions::compact() {
+  expiries.clear();
+  for (std::unordered_map<uint32_t, centry>::const_iterator it =
+           transactions.begin();
+       it != transactions.end(); ++it) {
+    cexpiry expiry;
+    expiry.tspec = it->second.ta.get_tspec();
+    expiry.seqno = it->second.seqno;
+    expiry.xid = it->first;
+    expiries.push_back(expiry);
+  }
+  std::make_heap(expiries.begin(), expiries.end());
+}
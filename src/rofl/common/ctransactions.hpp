@@ -0,0 +1,209 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * ctransactions.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_ROFL_COMMON_CTRANSACTIONS_HPP_
+#define SRC_ROFL_COMMON_CTRANSACTIONS_HPP_
+
+#include <inttypes.h>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "rofl/common/ctimespec.hpp"
+
+namespace rofl {
+
+/**
+ * @brief	Pending request awaiting a reply
+ */
+class ctransaction {
+public:
+  /**
+   *
+   */
+  ctransaction() : xid(0), type(0), subtype(0){};
+
+  /**
+   *
+   */
+  ctransaction(uint32_t xid, const ctimespec &tspec, uint8_t type,
+               uint16_t subtype = 0)
+      : xid(xid), tspec(tspec), type(type), subtype(subtype){};
+
+  /**
+   *
+   */
+  ctransaction(const ctransaction &ta) { *this = ta; };
+
+  /**
+   *
+   */
+  ctransaction &operator=(const ctransaction &ta) {
+    if (this == &ta)
+      return *this;
+    xid = ta.xid;
+    tspec = ta.tspec;
+    type = ta.type;
+    subtype = ta.subtype;
+    return *this;
+  };
+
+public:
+  uint32_t get_xid() const { return xid; };
+
+  uint8_t get_type() const { return type; };
+
+  uint16_t get_subtype() const { return subtype; };
+
+  const ctimespec &get_tspec() const { return tspec; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const ctransaction &ta) {
+    os << "<ctransaction xid: 0x" << std::hex << ta.xid << std::dec
+       << " type: " << (unsigned int)ta.type
+       << " subtype: " << (unsigned int)ta.subtype << " expires: " << ta.tspec
+       << " >" << std::endl;
+    return os;
+  };
+
+private:
+  uint32_t xid;
+  ctimespec tspec;
+  uint8_t type;
+  uint16_t subtype;
+};
+
+/**
+ * @brief	Set of pending transactions indexed by xid and ordered by expiry
+ *
+ * Transactions are stored in a hash table keyed by xid. Expiry order is
+ * kept in a binary min-heap. Dropping a transaction only removes it from
+ * the hash table, its heap entry becomes stale and is discarded once it
+ * reaches the top of the heap. Lookup and removal are O(1). Insertion is
+ * O(1) as well when transactions are added in order of their expiry,
+ * i.e. with a constant timeout, and O(log n) otherwise. The heap is
+ * rebuilt when stale entries outnumber live ones.
+ *
+ * Adding a transaction for an xid already pending replaces it. This class
+ * does no locking on its own.
+ */
+class ctransactions {
+public:
+  /**
+   *
+   */
+  ~ctransactions(){};
+
+  /**
+   *
+   */
+  ctransactions() : seqno(0){};
+
+public:
+  /**
+   *
+   */
+  void clear() {
+    transactions.clear();
+    expiries.clear();
+  };
+
+  /**
+   * @brief	Adds transaction, returns true when it is the next one to expire
+   */
+  bool add(const ctransaction &ta);
+
+  /**
+   * @brief	Removes transaction for xid, returns false if not found
+   */
+  bool drop(uint32_t xid);
+
+  /**
+   *
+   */
+  bool has(uint32_t xid) const {
+    return (transactions.find(xid) != transactions.end());
+  };
+
+  /**
+   *
+   */
+  size_t size() const { return transactions.size(); };
+
+  /**
+   *
+   */
+  bool empty() const { return transactions.empty(); };
+
+  /**
+   * @brief	Returns expiry of next transaction, false if none is pending
+   */
+  bool get_next_expiry(ctimespec &tspec);
+
+  /**
+   * @brief	Removes next transaction if expired at reference_time
+   */
+  bool pop_expired(ctransaction &ta,
+                   const ctimespec &reference_time = ctimespec::now());
+
+private:
+  /**
+   * @brief	Discards stale entries from top of heap
+   */
+  void purge();
+
+  /**
+   * @brief	Rebuilds heap from live transactions
+   */
+  void compact();
+
+  /**
+   *
+   */
+  bool is_stale(uint32_t xid, uint64_t seqno) const {
+    std::unordered_map<uint32_t, centry>::const_iterator it =
+        transactions.find(xid);
+    return ((it == transactions.end()) || (it->second.seqno != seqno));
+  };
+
+private:
+  // live transaction and the sequence number of its heap entry
+  struct centry {
+    ctransaction ta;
+    uint64_t seqno;
+  };
+
+  // heap entry
+  struct cexpiry {
+    ctimespec tspec;
+    uint64_t seqno;
+    uint32_t xid;
+
+    // inverted for building a min-heap with std::push_heap
+    bool operator<(const cexpiry &e) const {
+      if (tspec == e.tspec)
+        return (seqno > e.seqno);
+      return (tspec > e.tspec);
+    };
+  };
+
+  // pending transactions by xid
+  std::unordered_map<uint32_t, centry> transactions;
+
+  // expiry min-heap, may contain stale entries
+  std::vector<cexpiry> expiries;
+
+  // sequence number for next heap entry
+  uint64_t seqno;
+};
+
+}; // end of namespace rofl
+
+#endif /* SRC_ROFL_COMMON_CTRANSACTIONS_HPP_ */
@@ -104,7 +104,8 @@ size_t cofaction::length() const {
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION:
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow::ofp_action));
   } break;
   default:
@@ -125,7 +126,8 @@ void cofaction::pack(uint8_t *buf, size_t buflen) {
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION:
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow::ofp_action *hdr =
         (struct rofl::openflow::ofp_action *)buf;
@@ -151,7 +153,8 @@ void cofaction::unpack(uint8_t *buf, size_t buflen) {
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION:
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow::ofp_action *hdr =
         (struct rofl::openflow::ofp_action *)buf;
@@ -179,7 +182,8 @@ void cofaction_output::check_prerequisites() const {
     }
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if ((rofl::openflow13::OFPP_ANY == port_no) || (0 == port_no)) {
       throw eBadActionBadOutPort("cofaction_output::check_prerequisites()",
                                  __FILE__, __FUNCTION__, __LINE__);
@@ -194,6 +198,7 @@ size_t cofaction_output::length() const {
     return sizeof(struct rofl::openflow10::ofp_action_output);
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_output);
   default:
     throw eBadVersion("cofaction_output::length() invalid version", __FILE__,
@@ -222,7 +227,8 @@ void cofaction_output::pack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_output *hdr =
         (struct rofl::openflow13::ofp_action_output *)buf;
@@ -258,7 +264,8 @@ void cofaction_output::unpack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_output *hdr =
         (struct rofl::openflow13::ofp_action_output *)buf;
@@ -1012,6 +1019,7 @@ size_t cofaction_set_mpls_ttl::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_mpls_ttl);
   default:
     throw eBadVersion("cofaction_set_mpls_ttl::length() invalid version",
@@ -1031,7 +1039,8 @@ void cofaction_set_mpls_ttl::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_mpls_ttl *hdr =
         (struct rofl::openflow13::ofp_action_mpls_ttl *)buf;
@@ -1057,7 +1066,8 @@ void cofaction_set_mpls_ttl::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_mpls_ttl *hdr =
         (struct rofl::openflow13::ofp_action_mpls_ttl *)buf;
@@ -1075,6 +1085,7 @@ size_t cofaction_dec_mpls_ttl::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_header);
   default:
     throw eBadVersion("cofaction_dec_mpls_ttl::length() invalid version",
@@ -1094,7 +1105,8 @@ void cofaction_dec_mpls_ttl::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1115,7 +1127,8 @@ void cofaction_dec_mpls_ttl::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1128,6 +1141,7 @@ size_t cofaction_push_vlan::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_push);
   default:
     throw eBadVersion("cofaction_push_vlan::length() invalid version", __FILE__,
@@ -1147,7 +1161,8 @@ void cofaction_push_vlan::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_push *hdr =
         (struct rofl::openflow13::ofp_action_push *)buf;
@@ -1173,7 +1188,8 @@ void cofaction_push_vlan::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_push *hdr =
         (struct rofl::openflow13::ofp_action_push *)buf;
@@ -1191,6 +1207,7 @@ size_t cofaction_pop_vlan::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_header);
   default:
     throw eBadVersion("cofaction_pop_vlan::length() invalid version", __FILE__,
@@ -1210,7 +1227,8 @@ void cofaction_pop_vlan::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1231,7 +1249,8 @@ void cofaction_pop_vlan::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1244,6 +1263,7 @@ size_t cofaction_push_mpls::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_push);
   default:
     throw eBadVersion("cofaction_push_mpls::length() invalid version", __FILE__,
@@ -1263,7 +1283,8 @@ void cofaction_push_mpls::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_push *hdr =
         (struct rofl::openflow13::ofp_action_push *)buf;
@@ -1289,7 +1310,8 @@ void cofaction_push_mpls::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_push *hdr =
         (struct rofl::openflow13::ofp_action_push *)buf;
@@ -1307,6 +1329,7 @@ size_t cofaction_pop_mpls::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_pop_mpls);
   default:
     throw eBadVersion("cofaction_pop_mpls::length() invalid version", __FILE__,
@@ -1326,7 +1349,8 @@ void cofaction_pop_mpls::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_pop_mpls *hdr =
         (struct rofl::openflow13::ofp_action_pop_mpls *)buf;
@@ -1352,7 +1376,8 @@ void cofaction_pop_mpls::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_pop_mpls *hdr =
         (struct rofl::openflow13::ofp_action_pop_mpls *)buf;
@@ -1370,6 +1395,7 @@ size_t cofaction_group::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_group);
   default:
     throw eBadVersion("cofaction_group::length() invalid version", __FILE__,
@@ -1389,7 +1415,8 @@ void cofaction_group::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_group *hdr =
         (struct rofl::openflow13::ofp_action_group *)buf;
@@ -1415,7 +1442,8 @@ void cofaction_group::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_group *hdr =
         (struct rofl::openflow13::ofp_action_group *)buf;
@@ -1433,6 +1461,7 @@ size_t cofaction_set_nw_ttl::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_nw_ttl);
   default:
     throw eBadVersion("cofaction_set_nw_ttl::length() invalid version",
@@ -1452,7 +1481,8 @@ void cofaction_set_nw_ttl::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_nw_ttl *hdr =
         (struct rofl::openflow13::ofp_action_nw_ttl *)buf;
@@ -1478,7 +1508,8 @@ void cofaction_set_nw_ttl::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_nw_ttl *hdr =
         (struct rofl::openflow13::ofp_action_nw_ttl *)buf;
@@ -1496,6 +1527,7 @@ size_t cofaction_dec_nw_ttl::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_header);
   default:
     throw eBadVersion("cofaction_dec_nw_ttl::length() invalid version",
@@ -1515,7 +1547,8 @@ void cofaction_dec_nw_ttl::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1536,7 +1569,8 @@ void cofaction_dec_nw_ttl::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1549,6 +1583,7 @@ size_t cofaction_copy_ttl_out::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_header);
   default:
     throw eBadVersion("cofaction_copy_ttl_out::length() invalid version",
@@ -1568,7 +1603,8 @@ void cofaction_copy_ttl_out::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1589,7 +1625,8 @@ void cofaction_copy_ttl_out::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1602,6 +1639,7 @@ size_t cofaction_copy_ttl_in::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_header);
   default:
     throw eBadVersion("cofaction_copy_ttl_in::length() invalid version",
@@ -1621,7 +1659,8 @@ void cofaction_copy_ttl_in::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1642,7 +1681,8 @@ void cofaction_copy_ttl_in::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -1655,6 +1695,7 @@ size_t cofaction_set_queue::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_set_queue);
   default:
     throw eBadVersion("cofaction_set_queue::length() invalid version", __FILE__,
@@ -1674,7 +1715,8 @@ void cofaction_set_queue::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_set_queue *hdr =
         (struct rofl::openflow13::ofp_action_set_queue *)buf;
@@ -1700,7 +1742,8 @@ void cofaction_set_queue::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_set_queue *hdr =
         (struct rofl::openflow13::ofp_action_set_queue *)buf;
@@ -1717,7 +1760,8 @@ void cofaction_set_queue::unpack(uint8_t *buf, size_t buflen) {
 size_t cofaction_set_field::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     size_t total_length =
         sizeof(struct rofl::openflow::ofp_action_header) - 4 * sizeof(uint8_t);
 
@@ -1775,7 +1819,8 @@ void cofaction_set_field::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_set_field *hdr =
         (struct rofl::openflow13::ofp_action_set_field *)buf;
@@ -1827,7 +1872,8 @@ void cofaction_set_field::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_set_field *hdr =
         (struct rofl::openflow13::ofp_action_set_field *)buf;
@@ -1931,7 +1977,8 @@ void cofaction_set_field::unpack(uint8_t *buf, size_t buflen) {
 size_t cofaction_experimenter::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     size_t total_length =
         sizeof(struct rofl::openflow13::ofp_action_experimenter_header) +
         exp_body.length();
@@ -1962,7 +2009,8 @@ void cofaction_experimenter::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_experimenter_header *hdr =
         (struct rofl::openflow13::ofp_action_experimenter_header *)buf;
@@ -1992,7 +2040,8 @@ void cofaction_experimenter::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_experimenter_header *hdr =
         (struct rofl::openflow13::ofp_action_experimenter_header *)buf;
@@ -2021,6 +2070,7 @@ size_t cofaction_push_pbb::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_push);
   default:
     throw eBadVersion("cofaction_push_pbb::length() invalid version", __FILE__,
@@ -2040,7 +2090,8 @@ void cofaction_push_pbb::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_push *hdr =
         (struct rofl::openflow13::ofp_action_push *)buf;
@@ -2066,7 +2117,8 @@ void cofaction_push_pbb::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct rofl::openflow13::ofp_action_push *hdr =
         (struct rofl::openflow13::ofp_action_push *)buf;
@@ -2084,6 +2136,7 @@ size_t cofaction_pop_pbb::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return sizeof(struct rofl::openflow13::ofp_action_header);
   default:
     throw eBadVersion("cofaction_pop_pbb::length() invalid version", __FILE__,
@@ -2103,7 +2156,8 @@ void cofaction_pop_pbb::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -2124,7 +2178,8 @@ void cofaction_pop_pbb::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
   } break;
   default:
@@ -16,6 +16,7 @@
 
 #include "rofl/common/caddress.h"
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cslab.hpp"
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/coxmatch.h"
 #include "rofl/common/openflow/openflow_rofl_exceptions.h"
@@ -55,6 +56,20 @@ public:
    */
   virtual ~cofaction(){};
 
+  /**
+   * @brief	Instances are allocated from the calling thread's slab
+   */
+  static void *operator new(size_t size) {
+    return rofl::cslab::allocate(size);
+  };
+
+  /**
+   *
+   */
+  static void operator delete(void *ptr, size_t size) {
+    rofl::cslab::deallocate(ptr, size);
+  };
+
   /**
    *
    */
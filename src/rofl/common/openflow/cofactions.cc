@@ -196,6 +196,18 @@ void cofactions::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofactions::serialize(cofwriter &writer) {
+  for (std::map<cindex, cofaction *>::iterator it = actions.begin();
+       it != actions.end(); ++it) {
+    cofaction &action = *(it->second);
+
+    /* actions are leaves, their length is computed in constant time */
+    size_t aclen = action.length();
+    size_t offset = writer.reserve(aclen);
+    action.pack(writer.at(offset), aclen);
+  }
+}
+
 void cofactions::unpack(uint8_t *buf, size_t buflen) {
   if ((0 == buf) || (0 == buflen))
     return;
@@ -13,6 +13,7 @@
 #include "rofl/common/cindex.h"
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/cofaction.h"
+#include "rofl/common/openflow/cofwriter.h"
 #include "rofl/common/openflow/experimental/actions/gtp_actions.h"
 #include "rofl/common/openflow/openflow.h"
 
@@ -62,6 +63,11 @@ public:
    */
   void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends all actions to writer in a single pass
+   */
+  void serialize(cofwriter &writer);
+
 public:
   /**
    *
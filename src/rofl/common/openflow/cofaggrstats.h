@@ -231,7 +231,8 @@ public:
       os << aggr_stats_request.match;
 
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofaggr_stats_request >" << std::endl;
       os << "<table-id:" << (int)aggr_stats_request.get_table_id() << " >"
          << std::endl;
@@ -392,7 +393,8 @@ public:
     } break;
     case rofl::openflow10::OFP_VERSION:
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofaggr_stats_reply >" << std::endl;
       os << "<packet-count:" << (int)reply.get_packet_count() << " >"
          << std::endl;
@@ -11,7 +11,8 @@ uint8_t *cofbucket::pack(uint8_t *bucket, size_t bclen) {
   case openflow12::OFP_VERSION: {
     return pack_of12(bucket, bclen);
   } break;
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return pack_of13(bucket, bclen);
   } break;
   default:
@@ -19,12 +20,38 @@ uint8_t *cofbucket::pack(uint8_t *bucket, size_t bclen) {
   }
 }
 
+void cofbucket::serialize(cofwriter &writer) {
+  switch (ofp_version) {
+  case openflow12::OFP_VERSION:
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
+
+    /* struct ofp_bucket: len, weight, watch_port, watch_group, pad[4] */
+    size_t start = writer.length();
+    writer.put16(0);
+    writer.put16(weight);
+    writer.put32(watch_port);
+    writer.put32(watch_group);
+    writer.put32(0);
+
+    actions.serialize(writer);
+
+    writer.patch_length16(start, start);
+    writer.align(start, 8);
+
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
 void cofbucket::unpack(uint8_t *bucket, size_t bclen) {
   switch (ofp_version) {
   case openflow12::OFP_VERSION: {
     unpack_of12(bucket, bclen);
   } break;
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     unpack_of13(bucket, bclen);
   } break;
   default:
@@ -107,6 +107,11 @@ public:
    */
   uint8_t *pack(uint8_t *bucket, size_t bclen);
 
+  /**
+   * @brief	Appends this bucket to writer in a single pass
+   */
+  void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -224,7 +229,8 @@ public:
       os << "ofp-version:" << (int)bucket.ofp_version << " >" << std::endl;
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofbucket ";
       os << "ofp-version:" << (int)bucket.ofp_version << " >" << std::endl;
       os << std::hex;
@@ -32,7 +32,8 @@ void cofbucket_counters::pack(uint8_t *buf, size_t buflen) {
 
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     for (std::map<uint32_t, cofbucket_counter>::iterator it =
              bucketcounters.begin();
          it != bucketcounters.end(); ++it) {
@@ -63,7 +64,8 @@ void cofbucket_counters::unpack(uint8_t *buf, size_t buflen) {
     }
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     uint32_t bucket_counter_id = 0;
 
@@ -26,16 +26,33 @@ uint8_t *cofbuckets::pack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case openflow12::OFP_VERSION:
   case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION:
     return pack_of13(buf, buflen);
   default:
     throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
   }
 }
 
+void cofbuckets::serialize(cofwriter &writer) {
+  switch (ofp_version) {
+  case openflow12::OFP_VERSION:
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
+    for (std::map<uint32_t, cofbucket>::iterator it = buckets.begin();
+         it != buckets.end(); ++it) {
+      it->second.serialize(writer);
+    }
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
 void cofbuckets::unpack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case openflow12::OFP_VERSION:
   case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION:
     unpack_of13(buf, buflen);
     break;
   default:
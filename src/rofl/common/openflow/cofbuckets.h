@@ -211,6 +211,11 @@ public:
    */
   uint8_t *pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends all buckets to writer in a single pass
+   */
+  void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -225,7 +230,8 @@ public:
 
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << "<cofbuckets ofp-version:" << (int)buckets.ofp_version
          << " #buckets:" << buckets.buckets.size() << " >" << std::endl;
 
@@ -14,7 +14,8 @@ void cofflowmod::check_prerequisites() const {
     actions.check_prerequisites();
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     instructions.check_prerequisites();
   } break;
   default:
@@ -28,7 +29,8 @@ size_t cofflowmod::length() const {
     return (sizeof(struct ofp10_flow_mod) + actions.length());
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct ofp13_flow_mod) + match.length() +
             instructions.length());
   } break;
@@ -65,7 +67,8 @@ void cofflowmod::pack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp13_flow_mod *hdr = (struct ofp13_flow_mod *)buf;
 
@@ -91,6 +94,52 @@ void cofflowmod::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofflowmod::serialize(cofwriter &writer) {
+  switch (get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+
+    /* struct ofp10_flow_mod */
+    match.serialize(writer);
+    writer.put64(cookie);
+    writer.put16((uint16_t)command);
+    writer.put16(idle_timeout);
+    writer.put16(hard_timeout);
+    writer.put16(priority);
+    writer.put32(buffer_id);
+    writer.put16((uint16_t)out_port);
+    writer.put16(flags);
+
+    actions.serialize(writer);
+
+  } break;
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+
+    /* struct ofp13_flow_mod */
+    writer.put64(cookie);
+    writer.put64(cookie_mask);
+    writer.put8(table_id);
+    writer.put8(command);
+    writer.put16(idle_timeout);
+    writer.put16(hard_timeout);
+    writer.put16(priority);
+    writer.put32(buffer_id);
+    writer.put32(out_port);
+    writer.put32(out_group);
+    writer.put16(flags);
+    writer.put16(0);
+
+    match.serialize(writer);
+
+    instructions.serialize(writer);
+
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
 void cofflowmod::unpack(uint8_t *buf, size_t buflen) {
   if ((0 == buf) || (0 == buflen))
     return;
@@ -127,7 +176,8 @@ void cofflowmod::unpack(uint8_t *buf, size_t buflen) {
 
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < sizeof(struct ofp13_flow_mod))
       throw eInvalid("cofflowmod::unpack() buflen too short", __FILE__,
@@ -158,8 +208,16 @@ void cofflowmod::unpack(uint8_t *buf, size_t buflen) {
 
     size_t matchlen = be16toh(m->length);
 
+    if (matchlen > matchhdrlen)
+      throw eInvalid("cofflowmod::unpack() invalid match length", __FILE__,
+                     __FUNCTION__, __LINE__);
+
     match.unpack(hdr->match, matchlen);
 
+    if (match.length() > matchhdrlen)
+      throw eInvalid("cofflowmod::unpack() invalid match length", __FILE__,
+                     __FUNCTION__, __LINE__);
+
     size_t instructionslen =
         buflen - sizeof(struct ofp13_flow_mod) - match.length();
 
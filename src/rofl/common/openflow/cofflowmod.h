@@ -316,6 +316,11 @@ public:
    */
   void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends this flow-mod body to writer in a single pass
+   */
+  void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -378,7 +383,8 @@ public:
       os << fe.get_actions();
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << fe.get_instructions();
     } break;
     }
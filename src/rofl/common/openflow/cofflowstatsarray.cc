@@ -33,7 +33,8 @@ void cofflowstatsarray::pack(uint8_t *buf, size_t buflen) {
   switch (ofp_version) {
   case rofl::openflow10::OFP_VERSION:
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     for (std::map<uint32_t, cofflow_stats_reply>::iterator it = array.begin();
          it != array.end(); ++it) {
@@ -85,7 +86,8 @@ void cofflowstatsarray::unpack(uint8_t *buf, size_t buflen) {
     }
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     uint32_t flow_id = 0;
 
@@ -90,12 +90,13 @@ public:
     }
 
     /*
-     * this may replace existing flow descriptions
+     * ids are appended behind the last one, so insert at the end in
+     * amortized constant time per entry
      */
     for (std::map<uint32_t, cofflow_stats_reply>::const_iterator it =
              flows.array.begin();
          it != flows.array.end(); ++it) {
-      array[flow_id++] = it->second;
+      array.emplace_hint(array.end(), flow_id++, it->second);
     }
 
     return *this;
@@ -12,7 +12,8 @@ size_t cofgroup_desc_stats_reply::length() const {
     return (sizeof(struct rofl::openflow12::ofp_group_desc_stats) +
             buckets.length());
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_group_desc) + buckets.length());
   } break;
   default:
@@ -40,7 +41,8 @@ void cofgroup_desc_stats_reply::pack(uint8_t *buf, size_t buflen) {
     buckets.pack((uint8_t *)(stats->buckets), buckets.length());
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen <
         (sizeof(struct rofl::openflow13::ofp_group_desc) + buckets.length()))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -81,7 +83,8 @@ void cofgroup_desc_stats_reply::unpack(uint8_t *buf, size_t buflen) {
                        sizeof(struct rofl::openflow12::ofp_group_desc_stats));
 
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_group_desc))
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -9,7 +9,8 @@ using namespace rofl::openflow;
 size_t cofgroupmod::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct ofp_group_mod) + buckets.length());
   } break;
   default:
@@ -27,7 +28,8 @@ void cofgroupmod::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp_group_mod *hdr = (struct ofp_group_mod *)buf;
 
@@ -44,6 +46,26 @@ void cofgroupmod::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofgroupmod::serialize(cofwriter &writer) {
+  switch (get_version()) {
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+
+    /* struct ofp_group_mod */
+    writer.put16(command);
+    writer.put8(type);
+    writer.put8(0);
+    writer.put32(group_id);
+
+    buckets.serialize(writer);
+
+  } break;
+  default:
+    throw eBadVersion("cofgroupmod::serialize() unsupported version");
+  }
+}
+
 void cofgroupmod::unpack(uint8_t *buf, size_t buflen) {
   buckets.set_version(get_version());
   buckets.clear();
@@ -57,7 +79,8 @@ void cofgroupmod::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp_group_mod *hdr = (struct ofp_group_mod *)buf;
 
@@ -77,6 +77,11 @@ public:
    */
   void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends this group-mod body to writer in a single pass
+   */
+  void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -153,7 +158,8 @@ public:
     os << "cmd:";
     switch (groupmod.ofp_version) {
     case openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       switch (groupmod.get_command()) {
       case rofl::openflow13::OFPGC_ADD:
         os << "ADD ";
@@ -30,7 +30,8 @@ void cofgroupstatsarray::pack(uint8_t *buf, size_t buflen) {
 
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     for (std::map<uint32_t, cofgroup_stats_reply>::iterator it = array.begin();
          it != array.end(); ++it) {
@@ -67,7 +68,8 @@ void cofgroupstatsarray::unpack(uint8_t *buf, size_t buflen) {
       buflen -= length;
     }
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     while (buflen >= sizeof(struct rofl::openflow13::ofp_group_stats)) {
 
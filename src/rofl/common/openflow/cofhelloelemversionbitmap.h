@@ -146,6 +146,9 @@ public:
     if (has_ofp_version(rofl::openflow13::OFP_VERSION)) {
       ss << "1.3(" << (int)rofl::openflow13::OFP_VERSION << ") ";
     }
+    if (has_ofp_version(rofl::openflow14::OFP_VERSION)) {
+      ss << "1.4(" << (int)rofl::openflow14::OFP_VERSION << ") ";
+    }
     return ss.str();
   };
 };
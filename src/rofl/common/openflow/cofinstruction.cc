@@ -9,7 +9,8 @@ using namespace rofl::openflow;
 size_t cofinstruction::length() const {
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct ofp_instruction));
   } break;
   default:
@@ -26,7 +27,8 @@ void cofinstruction::pack(uint8_t *buf, size_t buflen) {
 
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp_instruction *hdr = (struct ofp_instruction *)buf;
 
@@ -39,6 +41,12 @@ void cofinstruction::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofinstruction::serialize(cofwriter &writer) {
+  size_t inlen = length();
+  size_t offset = writer.reserve(inlen);
+  pack(writer.at(offset), inlen);
+}
+
 void cofinstruction::unpack(uint8_t *buf, size_t buflen) {
   if ((0 == buf) || (0 == buflen))
     return;
@@ -48,7 +56,8 @@ void cofinstruction::unpack(uint8_t *buf, size_t buflen) {
 
   switch (ofp_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     struct ofp_instruction *hdr = (struct ofp_instruction *)buf;
 
@@ -66,7 +75,8 @@ void cofinstruction::unpack(uint8_t *buf, size_t buflen) {
 size_t cofinstruction_actions::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_instruction_actions) +
             actions.length());
   } break;
@@ -84,7 +94,8 @@ void cofinstruction_actions::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::pack(buf, buflen);
 
@@ -99,6 +110,28 @@ void cofinstruction_actions::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofinstruction_actions::serialize(cofwriter &writer) {
+  switch (get_version()) {
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+
+    /* struct ofp_instruction_actions: type, len, pad[4] */
+    size_t start = writer.length();
+    writer.put16(get_type());
+    writer.put16(0);
+    writer.put32(0);
+
+    actions.serialize(writer);
+
+    writer.patch_length16(start + 2, start);
+
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
 void cofinstruction_actions::unpack(uint8_t *buf, size_t buflen) {
   if ((0 == buf) || (0 == buflen))
     return;
@@ -110,7 +143,8 @@ void cofinstruction_actions::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::unpack(buf, buflen);
 
@@ -134,7 +168,8 @@ void cofinstruction_actions::unpack(uint8_t *buf, size_t buflen) {
 size_t cofinstruction_goto_table::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_instruction_goto_table));
   } break;
   default:
@@ -151,7 +186,8 @@ void cofinstruction_goto_table::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::pack(buf, buflen);
 
@@ -175,7 +211,8 @@ void cofinstruction_goto_table::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::unpack(buf, buflen);
 
@@ -196,7 +233,8 @@ void cofinstruction_goto_table::unpack(uint8_t *buf, size_t buflen) {
 void cofinstruction_goto_table::check_prerequisites() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (rofl::openflow13::OFPTT_ALL == get_table_id()) {
       throw eBadInstBadTableId();
     }
@@ -210,7 +248,8 @@ void cofinstruction_goto_table::check_prerequisites() const {
 size_t cofinstruction_write_metadata::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_instruction_write_metadata));
   } break;
   default:
@@ -227,7 +266,8 @@ void cofinstruction_write_metadata::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::pack(buf, buflen);
 
@@ -252,7 +292,8 @@ void cofinstruction_write_metadata::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::unpack(buf, buflen);
 
@@ -273,7 +314,8 @@ void cofinstruction_write_metadata::unpack(uint8_t *buf, size_t buflen) {
 
 size_t cofinstruction_meter::length() const {
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_instruction_meter));
   } break;
   default:
@@ -289,7 +331,8 @@ void cofinstruction_meter::pack(uint8_t *buf, size_t buflen) {
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::pack(buf, buflen);
 
@@ -312,7 +355,8 @@ void cofinstruction_meter::unpack(uint8_t *buf, size_t buflen) {
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::unpack(buf, buflen);
 
@@ -333,7 +377,8 @@ void cofinstruction_meter::unpack(uint8_t *buf, size_t buflen) {
 size_t cofinstruction_experimenter::length() const {
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_instruction_experimenter) +
             exp_body.memlen());
   } break;
@@ -351,7 +396,8 @@ void cofinstruction_experimenter::pack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::pack(buf, buflen);
 
@@ -379,7 +425,8 @@ void cofinstruction_experimenter::unpack(uint8_t *buf, size_t buflen) {
 
   switch (get_version()) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     cofinstruction::unpack(buf, sizeof(struct ofp_instruction));
 
@@ -15,6 +15,7 @@
 #endif
 
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cslab.hpp"
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/cofactions.h"
 #include "rofl/common/openflow/openflow.h"
@@ -29,6 +30,20 @@ public:
    */
   virtual ~cofinstruction(){};
 
+  /**
+   * @brief	Instances are allocated from the calling thread's slab
+   */
+  static void *operator new(size_t size) {
+    return rofl::cslab::allocate(size);
+  };
+
+  /**
+   *
+   */
+  static void operator delete(void *ptr, size_t size) {
+    rofl::cslab::deallocate(ptr, size);
+  };
+
   /**
    *
    */
@@ -97,6 +112,14 @@ public:
    */
   virtual void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends this instruction to writer in a single pass
+   *
+   * The default implementation reserves length() bytes and falls back
+   * to pack().
+   */
+  virtual void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -198,6 +221,12 @@ public:
    */
   virtual void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends this instruction and its actions to writer in a single
+   * pass
+   */
+  virtual void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -502,6 +502,13 @@ void cofinstructions::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofinstructions::serialize(cofwriter &writer) {
+  for (std::map<uint16_t, cofinstruction *>::iterator it = instmap.begin();
+       it != instmap.end(); ++it) {
+    it->second->serialize(writer);
+  }
+}
+
 void cofinstructions::unpack(uint8_t *buf, size_t buflen) {
   clear();
 
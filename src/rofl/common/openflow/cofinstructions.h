@@ -110,6 +110,11 @@ public:
    */
   void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends all instructions to writer in a single pass
+   */
+  void serialize(cofwriter &writer);
+
   /**
    *
    */
@@ -0,0 +1,138 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * coflazy.h
+ *
+ *  Created on: 18.10.2026
+ */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFLAZY_H
+#define ROFL_COMMON_OPENFLOW_COFLAZY_H 1
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "rofl/common/cslice.hpp"
+#include "rofl/common/exception.hpp"
+#include "rofl/common/openflow/cofwriter.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	View of a message body received from the wire
+ *
+ * Lazily decoded messages parse their header only and keep a coflazy
+ * referring to the body bytes within the receive buffer. The body is
+ * decoded on first access. As long as the body has not been handed out
+ * for modification, the view is retained and packing the message copies
+ * the original bytes instead of encoding the decoded body again.
+ *
+ * A coflazy is not thread-safe. The first access to a lazily decoded
+ * body must not race with other accesses to the same message.
+ */
+class coflazy {
+public:
+  /**
+   *
+   */
+  ~coflazy(){};
+
+  /**
+   *
+   */
+  coflazy() : pending(false){};
+
+  /**
+   *
+   */
+  coflazy(const coflazy &lazy) : body(lazy.body), pending(lazy.pending){};
+
+  /**
+   *
+   */
+  coflazy &operator=(const coflazy &lazy) {
+    if (this == &lazy)
+      return *this;
+    body = lazy.body;
+    pending = lazy.pending;
+    return *this;
+  };
+
+public:
+  /**
+   * @brief	Stores view of body bytes, decoding is deferred
+   */
+  void assign(const rofl::cslice &body) {
+    this->body = body;
+    pending = true;
+  };
+
+  /**
+   * @brief	Drops view of body bytes, e.g. when the body is modified
+   */
+  void release() {
+    body.clear();
+    pending = false;
+  };
+
+  /**
+   * @brief	Returns true when the body has not been decoded yet
+   */
+  bool is_pending() const { return pending; };
+
+  /**
+   * @brief	Returns view of the original body for decoding
+   */
+  const rofl::cslice &get_body() const { return body; };
+
+  /**
+   * @brief	Marks body as decoded, call only after decoding succeeded
+   *
+   * The view is retained for packing the unmodified body. A body that
+   * failed to decode stays pending, so every access reports the error.
+   */
+  void set_decoded() { pending = false; };
+
+  /**
+   * @brief	Returns true when the original body bytes are available
+   */
+  bool has_body() const { return (not body.is_null()); };
+
+  /**
+   * @brief	Returns length of original body
+   */
+  size_t length() const { return body.length(); };
+
+  /**
+   * @brief	Copies original body to buf
+   */
+  void pack(uint8_t *buf, size_t buflen) const {
+    if (buflen < body.length())
+      throw eInvalid("coflazy::pack() buflen too short", __FILE__,
+                     __FUNCTION__, __LINE__);
+    if (not body.empty())
+      memcpy(buf, body.somem(), body.length());
+  };
+
+  /**
+   * @brief	Appends original body to writer
+   */
+  void serialize(cofwriter &writer) const {
+    writer.put(body.somem(), body.length());
+  };
+
+private:
+  // original body bytes within receive buffer
+  rofl::cslice body;
+
+  // body has not been decoded yet
+  bool pending;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFLAZY_H */
@@ -7,25 +7,30 @@
 using namespace rofl::openflow;
 
 cofmatch::cofmatch(uint8_t of_version, uint16_t type)
-    : of_version(of_version), type(type) {}
+    : of_version(of_version), oxms_valid(false), oxms_dirty(false),
+      type(type) {}
 
 cofmatch::~cofmatch() {}
 
-cofmatch::cofmatch(cofmatch const &match) { *this = match; }
+cofmatch::cofmatch(cofmatch const &match)
+    : oxms_valid(false), oxms_dirty(false) {
+  *this = match;
+}
 
 cofmatch &cofmatch::operator=(const cofmatch &match) {
   if (this == &match)
     return *this;
 
   of_version = match.of_version;
-  matches = match.matches;
+  set_flat_matches() = match.get_flat_matches();
   type = match.type;
 
   return *this;
 }
 
 bool cofmatch::operator==(const cofmatch &match) const {
-  return ((of_version == match.of_version) && (matches == match.matches) &&
+  return ((of_version == match.of_version) &&
+          (get_flat_matches() == match.get_flat_matches()) &&
           (type == match.type));
 }
 
@@ -35,10 +40,11 @@ size_t cofmatch::length() const {
     return sizeof(struct rofl::openflow10::ofp_match);
   } break;
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     size_t total_length =
         2 * sizeof(uint16_t) +
-        matches.length(); // type-field + length-field + OXM-TLV list
+        get_flat_matches().length(); // type-field + length-field + OXM-TLVs
 
     size_t pad = (0x7 & total_length);
     /* append padding if not a multiple of 8 */
@@ -60,6 +66,7 @@ void cofmatch::pack(uint8_t *buf, size_t buflen) {
     break;
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     return pack_of13(buf, buflen);
     break;
   default:
@@ -67,6 +74,30 @@ void cofmatch::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofmatch::serialize(cofwriter &writer) {
+  switch (of_version) {
+  case rofl::openflow10::OFP_VERSION: {
+    size_t mlen = sizeof(struct rofl::openflow10::ofp_match);
+    size_t offset = writer.reserve(mlen);
+    pack_of10(writer.at(offset), mlen);
+  } break;
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+    /* OXM TLVs are stored in wire format already */
+    size_t start = writer.length();
+    size_t oxmlen = get_flat_matches().length();
+    writer.put16(type);
+    writer.put16(2 * sizeof(uint16_t) + oxmlen); // real length w/o padding
+    size_t offset = writer.reserve(oxmlen);
+    matches.pack(writer.at(offset), oxmlen);
+    writer.align(start, 8);
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+}
+
 void cofmatch::unpack(uint8_t *buf, size_t buflen) {
   switch (of_version) {
   case rofl::openflow10::OFP_VERSION:
@@ -74,6 +105,7 @@ void cofmatch::unpack(uint8_t *buf, size_t buflen) {
     break;
   case rofl::openflow12::OFP_VERSION:
   case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
     unpack_of13(buf, buflen);
     break;
   default:
@@ -88,6 +120,8 @@ void cofmatch::pack_of10(uint8_t *buf, size_t buflen) {
 
   uint32_t wildcards = 0;
 
+  sync_matches();
+
   memset(buf, 0, buflen);
 
   struct rofl::openflow10::ofp_match *m =
@@ -195,7 +229,7 @@ void cofmatch::pack_of10(uint8_t *buf, size_t buflen) {
 }
 
 void cofmatch::unpack_of10(uint8_t *buf, size_t buflen) {
-  matches.clear();
+  set_flat_matches().clear();
 
   if (buflen < sizeof(struct rofl::openflow10::ofp_match)) {
     throw eBadMatchBadLen("eBadMatchBadLen", __FILE__, __FUNCTION__, __LINE__);
@@ -330,6 +364,8 @@ void cofmatch::pack_of13(uint8_t *buf, size_t buflen) {
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
   }
 
+  sync_matches();
+
   struct rofl::openflow13::ofp_match *m =
       (struct rofl::openflow13::ofp_match *)buf;
 
@@ -341,7 +377,7 @@ void cofmatch::pack_of13(uint8_t *buf, size_t buflen) {
 }
 
 void cofmatch::unpack_of13(uint8_t *buf, size_t buflen) {
-  matches.clear();
+  set_flat_matches().clear();
 
   if (buflen < 2 * sizeof(uint16_t)) {
     throw eBadMatchBadLen("eBadMatchBadLen", __FILE__, __FUNCTION__, __LINE__);
@@ -365,9 +401,12 @@ void cofmatch::unpack_of13(uint8_t *buf, size_t buflen) {
 }
 
 void cofmatch::check_prerequisites() const {
+  sync_matches();
+
   switch (of_version) {
   case rofl::openflow12::OFP_VERSION:
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     /*
      * these are generic prerequisites as defined in OF 1.3, section 7.2.3.6,
@@ -39,7 +39,8 @@ const bool cofmeter_band::operator==(const cofmeter_band &mb) const {
 
 size_t cofmeter_band::length() const {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_meter_band_header) +
             body.memlen());
   } break;
@@ -56,7 +57,8 @@ void cofmeter_band::pack(uint8_t *buf, size_t buflen) {
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     len = length();
 
     struct rofl::openflow13::ofp_meter_band_header *mbh =
@@ -78,7 +80,8 @@ void cofmeter_band::unpack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     if (buflen < sizeof(struct rofl::openflow13::ofp_meter_band_header)) {
       std::cerr << "[rofl][cofmeterband][unpack] buffer too short" << std::endl;
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
@@ -115,7 +118,8 @@ cofmeter_band_drop::cofmeter_band_drop(uint8_t of_version)
     : cofmeter_band(of_version,
                     sizeof(struct rofl::openflow13::ofp_meter_band_drop)) {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     set_type(rofl::openflow13::OFPMBT_DROP);
   } break;
   default: {
@@ -150,7 +154,8 @@ cofmeter_band_dscp_remark::cofmeter_band_dscp_remark(uint8_t of_version)
                     sizeof(struct rofl::openflow13::ofp_meter_band_header)),
       prec_level(0) {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     set_type(rofl::openflow13::OFPMBT_DSCP_REMARK);
   } break;
   default: {
@@ -184,7 +189,8 @@ operator==(const cofmeter_band_dscp_remark &mb) const {
 
 size_t cofmeter_band_dscp_remark::length() const {
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_meter_band_dscp_remark));
   } break;
   default:
@@ -197,7 +203,8 @@ void cofmeter_band_dscp_remark::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -220,7 +227,8 @@ void cofmeter_band_dscp_remark::unpack(uint8_t *buf, size_t buflen) {
   cofmeter_band::unpack(buf, buflen);
 
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -247,7 +255,8 @@ cofmeter_band_experimenter::cofmeter_band_experimenter(uint8_t of_version)
                                                                    // here
       exp_id(0) {
   switch (of_version) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     set_type(openflow13::OFPMBT_EXPERIMENTER);
   } break;
   default: {
@@ -284,7 +293,8 @@ operator==(const cofmeter_band_experimenter &mb) const {
 
 size_t cofmeter_band_experimenter::length() const {
   switch (get_version()) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return (sizeof(struct openflow13::ofp_meter_band_experimenter) +
             exp_body.memlen());
   } break;
@@ -300,7 +310,8 @@ void cofmeter_band_experimenter::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length()) {
       std::cerr << "[rofl][cofmeterband_experimenter][pack] invalid length"
@@ -328,7 +339,8 @@ void cofmeter_band_experimenter::unpack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < sizeof(struct openflow13::ofp_meter_band_experimenter)) {
       std::cerr << "[rofl][cofmeterband_experimenter][unpack] invalid length"
@@ -38,7 +38,8 @@ operator==(const cofmeter_band_stats &mbs) const {
 
 size_t cofmeter_band_stats::length() const {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_meter_band_stats));
   } break;
   default:
@@ -51,7 +52,8 @@ void cofmeter_band_stats::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
@@ -70,7 +72,8 @@ void cofmeter_band_stats::pack(uint8_t *buf, size_t buflen) {
 
 void cofmeter_band_stats::unpack(uint8_t *buf, size_t buflen) {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
 
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
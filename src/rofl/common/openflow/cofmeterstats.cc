@@ -8,7 +8,8 @@ using namespace rofl::openflow;
 
 size_t cofmeter_stats_request::length() const {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return sizeof(struct rofl::openflow13::ofp_meter_multipart_request);
   } break;
   default:
@@ -21,7 +22,8 @@ void cofmeter_stats_request::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -41,7 +43,8 @@ void cofmeter_stats_request::unpack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -58,7 +61,8 @@ void cofmeter_stats_request::unpack(uint8_t *buf, size_t buflen) {
 
 size_t cofmeter_stats_reply::length() const {
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_meter_stats) +
             mbstats.length());
   } break;
@@ -73,7 +77,8 @@ void cofmeter_stats_reply::pack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     if (buflen < length())
       throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
@@ -101,7 +106,8 @@ void cofmeter_stats_reply::unpack(uint8_t *buf, size_t buflen) {
     return;
 
   switch (of_version) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     mbstats.clear();
 
     if (buflen < length())
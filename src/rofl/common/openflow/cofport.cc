@@ -66,6 +66,7 @@ void cofport::pack(uint8_t *buf, size_t buflen) {
         (struct rofl::openflow14::ofp_port *)buf;
 
     hdr->port_no = htobe32(portno);
+    hdr->length = htobe16(length());
     memcpy(hdr->hw_addr, hwaddr.somem(), OFP_ETH_ALEN);
     strncpy(hdr->name, name.c_str(), OFP_MAX_PORT_NAME_LEN);
     hdr->config = htobe32(config);
@@ -37,7 +37,9 @@ void cofports::pack(uint8_t *buf, size_t buflen) {
       buf += port.length();
     }
   } break;
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
+    /* OpenFlow 1.4 ports carry their length including properties */
     for (std::map<uint32_t, cofport *>::iterator it = ports.begin();
          it != ports.end(); ++it) {
       cofport &port = *(it->second);
@@ -97,6 +99,28 @@ void cofports::unpack(uint8_t *buf, size_t buflen) {
       buf += sizeof(struct rofl::openflow13::ofp_port);
       buflen -= sizeof(struct rofl::openflow13::ofp_port);
 
+    } break;
+    case rofl::openflow14::OFP_VERSION: {
+      if (buflen < (int)sizeof(struct rofl::openflow14::ofp_port))
+        return;
+
+      /* variable length due to port description properties */
+      size_t portlen =
+          be16toh(((struct rofl::openflow14::ofp_port *)buf)->length);
+      if ((portlen < sizeof(struct rofl::openflow14::ofp_port)) ||
+          (portlen > buflen))
+        throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                                __LINE__);
+
+      cofport port(ofp_version, buf, portlen);
+      if (ports.find(port.get_port_no()) != ports.end()) {
+        delete ports[port.get_port_no()];
+      }
+      ports[port.get_port_no()] = new cofport(port);
+
+      buf += portlen;
+      buflen -= portlen;
+
     } break;
     default:
       throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
@@ -0,0 +1,188 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofwriter.h
+ *
+ *  Created on: 18.10.2026
+ */
+
+#ifndef ROFL_COMMON_OPENFLOW_COFWRITER_H
+#define ROFL_COMMON_OPENFLOW_COFWRITER_H 1
+
+#include <endian.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <vector>
+
+#include "rofl/common/exception.hpp"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	Growable buffer for serializing OpenFlow elements in a single pass
+ *
+ * Elements append their wire representation and reserve length fields
+ * whose values are not known yet. Once all nested elements have been
+ * appended, the length is back-patched from the number of bytes written
+ * since the element's start offset, so no element must compute its
+ * length in advance. Memory is retained by clear() and truncate() for
+ * reuse by subsequent messages.
+ *
+ * Pointers returned by at() are invalidated by any subsequent append,
+ * store offsets instead.
+ */
+class cofwriter {
+public:
+  /**
+   * @brief	cofwriter destructor
+   */
+  ~cofwriter(){};
+
+  /**
+   * @brief	cofwriter constructor
+   *
+   * @param capacity initial number of bytes allocated
+   */
+  cofwriter(size_t capacity = 1024) : buf(capacity), len(0){};
+
+public:
+  /**
+   * @brief	Returns number of bytes written
+   */
+  size_t length() const { return len; };
+
+  /**
+   * @brief	Returns number of bytes allocated
+   */
+  size_t capacity() const { return buf.size(); };
+
+  /**
+   * @brief	Returns pointer to start of buffer
+   */
+  uint8_t *somem() { return buf.data(); };
+
+  /**
+   * @brief	Returns pointer to byte at offset
+   */
+  uint8_t *at(size_t offset) { return buf.data() + offset; };
+
+  /**
+   * @brief	Discards all bytes written
+   */
+  void clear() { len = 0; };
+
+  /**
+   * @brief	Discards all bytes beyond offset
+   */
+  void truncate(size_t offset) {
+    if (offset < len)
+      len = offset;
+  };
+
+public:
+  /**
+   * @brief	Appends n zero bytes, returns their offset
+   */
+  size_t reserve(size_t n) {
+    grow(n);
+    size_t offset = len;
+    memset(buf.data() + len, 0, n);
+    len += n;
+    return offset;
+  };
+
+  /**
+   * @brief	Appends n bytes copied from data
+   */
+  void put(const uint8_t *data, size_t n) {
+    grow(n);
+    memcpy(buf.data() + len, data, n);
+    len += n;
+  };
+
+  /**
+   * @brief	Appends a byte
+   */
+  void put8(uint8_t value) {
+    grow(sizeof(value));
+    buf[len++] = value;
+  };
+
+  /**
+   * @brief	Appends a 16 bit value in network byte order
+   */
+  void put16(uint16_t value) {
+    value = htobe16(value);
+    put((const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   * @brief	Appends a 32 bit value in network byte order
+   */
+  void put32(uint32_t value) {
+    value = htobe32(value);
+    put((const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   * @brief	Appends a 64 bit value in network byte order
+   */
+  void put64(uint64_t value) {
+    value = htobe64(value);
+    put((const uint8_t *)&value, sizeof(value));
+  };
+
+  /**
+   * @brief	Appends zero bytes until the number of bytes written since
+   * start is a multiple of alignment
+   */
+  void align(size_t start, size_t alignment = 8) {
+    size_t rem = (len - start) % alignment;
+    if (rem)
+      reserve(alignment - rem);
+  };
+
+public:
+  /**
+   * @brief	Overwrites 16 bit value at offset in network byte order
+   */
+  void patch16(size_t offset, uint16_t value) {
+    value = htobe16(value);
+    memcpy(buf.data() + offset, &value, sizeof(value));
+  };
+
+  /**
+   * @brief	Overwrites 16 bit length field at offset with the number of
+   * bytes written since start
+   *
+   * @exception eInvalid length exceeds 16 bits
+   */
+  void patch_length16(size_t offset, size_t start) {
+    if ((len - start) > UINT16_MAX)
+      throw eInvalid("cofwriter::patch_length16() length exceeds 16 bits",
+                     __FILE__, __FUNCTION__, __LINE__);
+    patch16(offset, len - start);
+  };
+
+private:
+  void grow(size_t n) {
+    if ((len + n) <= buf.size())
+      return;
+    size_t size = buf.size() ? buf.size() : 64;
+    while (size < (len + n))
+      size *= 2;
+    buf.resize(size);
+  };
+
+  std::vector<uint8_t> buf;
+  size_t len;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COFWRITER_H */
@@ -22,6 +22,7 @@
 
 #include "rofl/common/caddress.h"
 #include "rofl/common/cmemory.h"
+#include "rofl/common/cslab.hpp"
 #include "rofl/common/exception.hpp"
 #include "rofl/common/openflow/openflow.h"
 
@@ -76,6 +77,20 @@ public:
    */
   virtual ~coxmatch(){};
 
+  /**
+   * @brief	Instances are allocated from the calling thread's slab
+   */
+  static void *operator new(size_t size) {
+    return rofl::cslab::allocate(size);
+  };
+
+  /**
+   *
+   */
+  static void operator delete(void *ptr, size_t size) {
+    rofl::cslab::deallocate(ptr, size);
+  };
+
   /**
    *
    */
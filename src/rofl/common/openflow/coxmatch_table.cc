@@ -0,0 +1,86 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * coxmatch_table.cc
+ *
+ *  Created on: 18.10.2026
+ */
+
+#include "rofl/common/openflow/coxmatch_table.h"
+
+using namespace rofl::openflow;
+
+namespace {
+
+template <class T> coxmatch *create() { return new T(); }
+
+constexpr coxmatch_desc ofb(unsigned int field, uint8_t length,
+                            bool maskable, coxmatch *(*create)()) {
+  return coxmatch_desc{
+      ((uint32_t)rofl::openflow::OFPXMC_OPENFLOW_BASIC << 16) |
+          (field << 9) | length,
+      length, maskable, (uint8_t)field, create};
+}
+
+/* value lengths as packed by the typed coxmatch classes */
+constexpr coxmatch_desc ofb_table[] = {
+    ofb(OFPXMT_OFB_IN_PORT, 4, false, &create<coxmatch_ofb_in_port>),
+    ofb(OFPXMT_OFB_IN_PHY_PORT, 4, false, &create<coxmatch_ofb_in_phy_port>),
+    ofb(OFPXMT_OFB_METADATA, 8, true, &create<coxmatch_ofb_metadata>),
+    ofb(OFPXMT_OFB_ETH_DST, 6, true, &create<coxmatch_ofb_eth_dst>),
+    ofb(OFPXMT_OFB_ETH_SRC, 6, true, &create<coxmatch_ofb_eth_src>),
+    ofb(OFPXMT_OFB_ETH_TYPE, 2, false, &create<coxmatch_ofb_eth_type>),
+    ofb(OFPXMT_OFB_VLAN_VID, 2, true, &create<coxmatch_ofb_vlan_vid>),
+    ofb(OFPXMT_OFB_VLAN_PCP, 1, false, &create<coxmatch_ofb_vlan_pcp>),
+    ofb(OFPXMT_OFB_IP_DSCP, 1, false, &create<coxmatch_ofb_ip_dscp>),
+    ofb(OFPXMT_OFB_IP_ECN, 1, false, &create<coxmatch_ofb_ip_ecn>),
+    ofb(OFPXMT_OFB_IP_PROTO, 1, false, &create<coxmatch_ofb_ip_proto>),
+    ofb(OFPXMT_OFB_IPV4_SRC, 4, true, &create<coxmatch_ofb_ipv4_src>),
+    ofb(OFPXMT_OFB_IPV4_DST, 4, true, &create<coxmatch_ofb_ipv4_dst>),
+    ofb(OFPXMT_OFB_TCP_SRC, 2, false, &create<coxmatch_ofb_tcp_src>),
+    ofb(OFPXMT_OFB_TCP_DST, 2, false, &create<coxmatch_ofb_tcp_dst>),
+    ofb(OFPXMT_OFB_UDP_SRC, 2, false, &create<coxmatch_ofb_udp_src>),
+    ofb(OFPXMT_OFB_UDP_DST, 2, false, &create<coxmatch_ofb_udp_dst>),
+    ofb(OFPXMT_OFB_SCTP_SRC, 2, false, &create<coxmatch_ofb_sctp_src>),
+    ofb(OFPXMT_OFB_SCTP_DST, 2, false, &create<coxmatch_ofb_sctp_dst>),
+    ofb(OFPXMT_OFB_ICMPV4_TYPE, 1, false, &create<coxmatch_ofb_icmpv4_type>),
+    ofb(OFPXMT_OFB_ICMPV4_CODE, 1, false, &create<coxmatch_ofb_icmpv4_code>),
+    ofb(OFPXMT_OFB_ARP_OP, 2, false, &create<coxmatch_ofb_arp_opcode>),
+    ofb(OFPXMT_OFB_ARP_SPA, 4, true, &create<coxmatch_ofb_arp_spa>),
+    ofb(OFPXMT_OFB_ARP_TPA, 4, true, &create<coxmatch_ofb_arp_tpa>),
+    ofb(OFPXMT_OFB_ARP_SHA, 6, true, &create<coxmatch_ofb_arp_sha>),
+    ofb(OFPXMT_OFB_ARP_THA, 6, true, &create<coxmatch_ofb_arp_tha>),
+    ofb(OFPXMT_OFB_IPV6_SRC, 16, true, &create<coxmatch_ofb_ipv6_src>),
+    ofb(OFPXMT_OFB_IPV6_DST, 16, true, &create<coxmatch_ofb_ipv6_dst>),
+    ofb(OFPXMT_OFB_IPV6_FLABEL, 4, true, &create<coxmatch_ofb_ipv6_flabel>),
+    ofb(OFPXMT_OFB_ICMPV6_TYPE, 1, false, &create<coxmatch_ofb_icmpv6_type>),
+    ofb(OFPXMT_OFB_ICMPV6_CODE, 1, false, &create<coxmatch_ofb_icmpv6_code>),
+    ofb(OFPXMT_OFB_IPV6_ND_TARGET, 16, false,
+        &create<coxmatch_ofb_ipv6_nd_target>),
+    ofb(OFPXMT_OFB_IPV6_ND_SLL, 6, false, &create<coxmatch_ofb_ipv6_nd_sll>),
+    ofb(OFPXMT_OFB_IPV6_ND_TLL, 6, false, &create<coxmatch_ofb_ipv6_nd_tll>),
+    ofb(OFPXMT_OFB_MPLS_LABEL, 4, false, &create<coxmatch_ofb_mpls_label>),
+    ofb(OFPXMT_OFB_MPLS_TC, 1, false, &create<coxmatch_ofb_mpls_tc>),
+    ofb(OFPXMT_OFB_MPLS_BOS, 1, false, &create<coxmatch_ofb_mpls_bos>),
+    ofb(OFPXMT_OFB_PBB_ISID, 3, true, &create<coxmatch_ofb_pbb_isid>),
+    ofb(OFPXMT_OFB_TUNNEL_ID, 8, true, &create<coxmatch_ofb_tunnel_id>),
+    ofb(OFPXMT_OFB_IPV6_EXTHDR, 2, true, &create<coxmatch_ofb_ipv6_exthdr>),
+};
+
+constexpr bool is_indexed_by_field(unsigned int i) {
+  return (i == coxmatch_table::OFB_FIELDS) ||
+         ((ofb_table[i].slot == i) && (ofb_table[i].length > 0) &&
+          (2 * ofb_table[i].length <= 0xff) && is_indexed_by_field(i + 1));
+}
+
+static_assert(sizeof(ofb_table) / sizeof(ofb_table[0]) ==
+                  coxmatch_table::OFB_FIELDS,
+              "OXM descriptor table incomplete");
+static_assert(is_indexed_by_field(0),
+              "OXM descriptor table not indexed by field");
+
+}; // end of anonymous namespace
+
+const coxmatch_desc *const coxmatch_table::ofb_fields = ofb_table;
@@ -0,0 +1,126 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * coxmatch_table.h
+ *
+ *  Created on: 18.10.2026
+ */
+
+#ifndef ROFL_COMMON_OPENFLOW_COXMATCH_TABLE_H
+#define ROFL_COMMON_OPENFLOW_COXMATCH_TABLE_H 1
+
+#include <endian.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "rofl/common/openflow/coxmatch.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	Descriptor of an OpenFlow basic OXM field
+ */
+struct coxmatch_desc {
+  // OXM TLV header without mask
+  uint32_t oxm_id;
+  // length of value, a masked TLV carries twice as many bytes
+  uint8_t length;
+  // field may carry a mask
+  bool maskable;
+  // dense index of field in descriptor table
+  uint8_t slot;
+  // allocates a typed coxmatch instance for this field
+  coxmatch *(*create)();
+};
+
+/**
+ * @brief	Compile-time table of all OpenFlow basic OXM fields
+ *
+ * Descriptors are indexed by OXM field number, so decoders validate a TLV
+ * with a single table lookup instead of dispatching over all known types.
+ * The table is checked for completeness and ordering at compile time.
+ */
+class coxmatch_table {
+public:
+  /**
+   * @brief	Number of OpenFlow basic OXM fields
+   */
+  static const unsigned int OFB_FIELDS = rofl::openflow::OFPXMT_OFB_MAX;
+
+  /**
+   * @brief	Returns descriptor for OXM TLV header or NULL for unknown fields
+   */
+  static const coxmatch_desc *lookup(uint32_t oxm_id) {
+    if ((oxm_id >> 16) != rofl::openflow::OFPXMC_OPENFLOW_BASIC)
+      return (const coxmatch_desc *)0;
+    unsigned int field = (oxm_id >> 9) & 0x7f;
+    if (field >= OFB_FIELDS)
+      return (const coxmatch_desc *)0;
+    return &ofb_fields[field];
+  };
+
+  /**
+   * @brief	Returns OXM TLV header in host byte order
+   */
+  static uint32_t get_oxm_id(const uint8_t *tlv) {
+    uint32_t oxm_id;
+    memcpy(&oxm_id, tlv, sizeof(oxm_id));
+    return be32toh(oxm_id);
+  };
+
+  /**
+   * @brief	Validates OXM TLV at start of buf
+   *
+   * Basic TLVs of known fields must carry a value of the field's length and
+   * a mask only if the field is maskable. Experimenter TLVs must cover
+   * their experimenter id. TLVs of other classes and unknown fields are not
+   * validated and must be skipped by the caller, if they fit into buflen.
+   *
+   * @param buf start of TLV, at least sizeof(struct ofp_oxm_hdr) bytes
+   * @param buflen number of bytes available in buf
+   * @param tlvlen length of TLV including its header
+   * @return true: TLV is known and valid, false: TLV is unknown
+   * @exception eOxmBadLen known TLV is truncated or has an invalid length
+   */
+  static bool validate(const uint8_t *buf, size_t buflen, size_t &tlvlen) {
+    uint32_t oxm_id = get_oxm_id(buf);
+    size_t oxm_length = oxm_id & 0xff;
+    tlvlen = sizeof(struct rofl::openflow::ofp_oxm_hdr) + oxm_length;
+
+    switch (oxm_id >> 16) {
+    case rofl::openflow::OFPXMC_OPENFLOW_BASIC: {
+      const coxmatch_desc *desc = lookup(oxm_id);
+      if (0 == desc)
+        return false;
+      if (oxm_id & HAS_MASK_FLAG) {
+        if ((not desc->maskable) || (oxm_length != 2 * desc->length))
+          throw eOxmBadLen("coxmatch_table::validate() invalid masked TLV");
+      } else if (oxm_length != desc->length) {
+        throw eOxmBadLen("coxmatch_table::validate() invalid TLV length");
+      }
+    } break;
+    case rofl::openflow::OFPXMC_EXPERIMENTER: {
+      if (tlvlen < sizeof(struct rofl::openflow::ofp_oxm_experimenter_header))
+        throw eOxmBadLen("coxmatch_table::validate() experimenter TLV too "
+                         "short");
+    } break;
+    default:
+      return false;
+    }
+
+    if (tlvlen > buflen)
+      throw eOxmBadLen("coxmatch_table::validate() buflen too short");
+    return true;
+  };
+
+private:
+  static const coxmatch_desc *const ofb_fields;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* ROFL_COMMON_OPENFLOW_COXMATCH_TABLE_H */
@@ -3767,6 +3767,17 @@ public:
     return os;
   };
 
+private:
+  /**
+   * @brief	Stores oxm for oxm_type, replacing an existing instance
+   */
+  coxmatch &add_match(uint64_t oxm_type, coxmatch *oxm);
+
+  /**
+   * @brief	Unpacks a validated experimenter OXM TLV
+   */
+  void unpack_exp(uint8_t *buf, size_t buflen);
+
 private:
   mutable rofl::crwlock rwlock;
 
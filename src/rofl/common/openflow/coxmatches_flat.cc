@@ -0,0 +1,239 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * coxmatches_flat.cc
+ *
+ *  Created on: 17.10.2026
+ */
+
+#include <algorithm>
+
+#include "rofl/common/openflow/coxmatch_table.h"
+#include "rofl/common/openflow/coxmatches_flat.h"
+
+using namespace rofl::openflow;
+
+void coxmatches_flat::pack(uint8_t *buf, size_t buflen) const {
+  if (buflen < datalen) {
+    throw eBadMatchBadLen("eBadMatchBadLen", __FILE__, __FUNCTION__, __LINE__);
+  }
+  memcpy(buf, data, datalen);
+}
+
+void coxmatches_flat::unpack(uint8_t *buf, size_t buflen) {
+  clear();
+
+  /* validate all TLVs first, a list in ascending order without unknown or
+   * duplicate fields, as sent by most peers, is copied at once */
+  bool ordered = true;
+  bool skipped = false;
+  uint64_t last_key = 0;
+  size_t offset = 0;
+  size_t bulklen = 0;
+
+  /* remaining bytes not covering an entire ofp_oxm_hdr are padding */
+  while (buflen - offset >= sizeof(struct rofl::openflow::ofp_oxm_hdr)) {
+    size_t tlvlen = 0;
+    if (coxmatch_table::validate(buf + offset, buflen - offset, tlvlen)) {
+      uint64_t key = get_key(buf + offset);
+      if (skipped || (key <= last_key))
+        ordered = false;
+      last_key = key;
+      bulklen = offset + tlvlen;
+    } else if (tlvlen > buflen - offset) {
+      break;
+    } else {
+      skipped = true;
+    }
+    offset += tlvlen;
+  }
+
+  if (ordered) {
+    reserve(bulklen);
+    memcpy(data, buf, bulklen);
+    datalen = bulklen;
+    return;
+  }
+
+  /* sort TLVs one by one, skipping unknown ones */
+  for (offset = 0; offset < bulklen;) {
+    size_t tlvlen = 0;
+    if (coxmatch_table::validate(buf + offset, buflen - offset, tlvlen)) {
+      reserve(datalen + tlvlen);
+      memcpy(data + datalen, buf + offset, tlvlen);
+      insert_tail(tlvlen);
+    }
+    offset += tlvlen;
+  }
+}
+
+size_t coxmatches_flat::size() const {
+  size_t num = 0;
+  for (size_t offset = 0; offset < datalen;
+       offset += get_tlv_length(data + offset)) {
+    num++;
+  }
+  return num;
+}
+
+std::vector<uint64_t> coxmatches_flat::get_ids() const {
+  std::vector<uint64_t> ids;
+  for (size_t offset = 0; offset < datalen;
+       offset += get_tlv_length(data + offset)) {
+    ids.push_back(get_key(data + offset));
+  }
+  return ids;
+}
+
+uint64_t coxmatches_flat::hash() const {
+  uint64_t h = UINT64_C(14695981039346656037);
+  for (size_t i = 0; i < datalen; i++) {
+    h ^= data[i];
+    h *= UINT64_C(1099511628211);
+  }
+  return h;
+}
+
+bool coxmatches_flat::contains(const coxmatches_flat &oxms,
+                               bool strict) const {
+  /* both lists are sorted by key, so a single merge pass suffices */
+  size_t loffset = 0, roffset = 0;
+  while (loffset < datalen) {
+    uint64_t key = get_key(data + loffset);
+    while ((roffset < oxms.datalen) && (get_key(oxms.data + roffset) < key)) {
+      if (strict)
+        return false;
+      roffset += get_tlv_length(oxms.data + roffset);
+    }
+    if ((roffset >= oxms.datalen) || (get_key(oxms.data + roffset) != key))
+      return false;
+    size_t tlvlen = get_tlv_length(data + loffset);
+    if ((tlvlen != get_tlv_length(oxms.data + roffset)) ||
+        (0 != memcmp(data + loffset, oxms.data + roffset, tlvlen)))
+      return false;
+    loffset += tlvlen;
+    roffset += tlvlen;
+  }
+  return ((not strict) || (roffset == oxms.datalen));
+}
+
+bool coxmatches_flat::is_part_of(const coxmatches_flat &oxms,
+                                 uint16_t &exact_hits, uint16_t &wildcard_hits,
+                                 uint16_t &missed) const {
+  bool result = true;
+  size_t loffset = 0;
+  for (size_t roffset = 0; roffset < oxms.datalen;
+       roffset += get_tlv_length(oxms.data + roffset)) {
+    uint64_t key = get_key(oxms.data + roffset);
+    while ((loffset < datalen) && (get_key(data + loffset) < key)) {
+      loffset += get_tlv_length(data + loffset);
+    }
+    if ((loffset >= datalen) || (get_key(data + loffset) != key)) {
+      wildcard_hits++;
+      continue;
+    }
+    size_t tlvlen = get_tlv_length(oxms.data + roffset);
+    if ((tlvlen != get_tlv_length(data + loffset)) ||
+        (0 != memcmp(data + loffset, oxms.data + roffset, tlvlen))) {
+      missed++;
+      result = false;
+      continue;
+    }
+    exact_hits++;
+  }
+  return result;
+}
+
+coxmatches coxmatches_flat::get_matches() const {
+  coxmatches oxms;
+  if (datalen > 0) {
+    oxms.unpack(const_cast<uint8_t *>(data), datalen);
+  }
+  return oxms;
+}
+
+void coxmatches_flat::set_matches(const coxmatches &oxms) {
+  clear();
+  reserve(oxms.length());
+  /* the map is ordered by the same key, so the TLVs are sorted already */
+  for (auto it : oxms.get_matches()) {
+    size_t tlvlen = it.second->length();
+    it.second->pack(data + datalen, tlvlen);
+    datalen += tlvlen;
+  }
+}
+
+void coxmatches_flat::add(coxmatch &oxm) {
+  size_t tlvlen = oxm.length();
+  reserve(datalen + tlvlen);
+  oxm.pack(data + datalen, tlvlen);
+  insert_tail(tlvlen);
+}
+
+bool coxmatches_flat::drop(uint64_t key) {
+  size_t offset = 0;
+  if (not find(key, offset)) {
+    return false;
+  }
+  size_t tlvlen = get_tlv_length(data + offset);
+  memmove(data + offset, data + offset + tlvlen, datalen - offset - tlvlen);
+  datalen -= tlvlen;
+  return true;
+}
+
+bool coxmatches_flat::find(uint64_t key, size_t &offset) const {
+  offset = 0;
+  while (offset < datalen) {
+    uint64_t k = get_key(data + offset);
+    if (k == key)
+      return true;
+    if (k > key)
+      return false;
+    offset += get_tlv_length(data + offset);
+  }
+  return false;
+}
+
+void coxmatches_flat::insert_tail(size_t tlvlen) {
+  size_t tail = datalen;
+  size_t offset = 0;
+
+  /* remove an existing TLV with the same key first */
+  if (find(get_key(data + tail), offset)) {
+    size_t oldlen = get_tlv_length(data + offset);
+    memmove(data + offset, data + offset + oldlen,
+            tail + tlvlen - offset - oldlen);
+    tail -= oldlen;
+  }
+
+  /* no-op for TLVs arriving in ascending order */
+  std::rotate(data + offset, data + tail, data + tail + tlvlen);
+  datalen = tail + tlvlen;
+}
+
+void coxmatches_flat::reserve(size_t len) {
+  if (len <= datacap)
+    return;
+  size_t cap = std::max(len, 2 * datacap);
+  uint8_t *mem = new uint8_t[cap];
+  memcpy(mem, data, datalen);
+  if (data != inline_data)
+    delete[] data;
+  data = mem;
+  datacap = cap;
+}
+
+uint64_t coxmatches_flat::get_key(const uint8_t *tlv) {
+  uint32_t oxm_id;
+  memcpy(&oxm_id, tlv, sizeof(oxm_id));
+  oxm_id = be32toh(oxm_id);
+  uint64_t key = OXM_ROFL_TYPE(oxm_id);
+  if ((oxm_id >> 16) == rofl::openflow::OFPXMC_EXPERIMENTER) {
+    uint32_t exp_id;
+    memcpy(&exp_id, tlv + sizeof(oxm_id), sizeof(exp_id));
+    key |= ((uint64_t)be32toh(exp_id)) << 32;
+  }
+  return key;
+}
@@ -0,0 +1,1809 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * coxmatches_flat.h
+ *
+ *  Created on: 17.10.2026
+ */
+
+#ifndef COXMATCHES_FLAT_H_
+#define COXMATCHES_FLAT_H_
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <ostream>
+#include <vector>
+
+#include "rofl/common/openflow/coxmatch.h"
+#include "rofl/common/openflow/coxmatches.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	OXM TLV list stored inline in wire format
+ *
+ * Matches are kept as packed OXM TLVs within an inline buffer, sorted by
+ * the same key coxmatches uses for its map, so packing emits the same
+ * byte sequence. Copying, comparing and hashing a list operate on the
+ * used part of the buffer only and do not allocate memory, unless the
+ * list outgrows INLINE_CAPACITY and moves to the heap. Accessors mirror
+ * those of coxmatches, but return match objects by value.
+ */
+class coxmatches_flat {
+public:
+  /**
+   *
+   */
+  ~coxmatches_flat() {
+    if (data != inline_data)
+      delete[] data;
+  };
+
+  /**
+   *
+   */
+  coxmatches_flat()
+      : data(inline_data), datacap(INLINE_CAPACITY), datalen(0){};
+
+  /**
+   *
+   */
+  coxmatches_flat(const coxmatches_flat &oxms)
+      : data(inline_data), datacap(INLINE_CAPACITY), datalen(0) {
+    *this = oxms;
+  };
+
+  /**
+   *
+   */
+  explicit coxmatches_flat(const coxmatches &oxms)
+      : data(inline_data), datacap(INLINE_CAPACITY), datalen(0) {
+    set_matches(oxms);
+  };
+
+  /**
+   *
+   */
+  coxmatches_flat &operator=(const coxmatches_flat &oxms) {
+    if (this == &oxms)
+      return *this;
+    reserve(oxms.datalen);
+    memcpy(data, oxms.data, oxms.datalen);
+    datalen = oxms.datalen;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool operator==(const coxmatches_flat &oxms) const {
+    return ((datalen == oxms.datalen) &&
+            (0 == memcmp(data, oxms.data, datalen)));
+  };
+
+  /**
+   *
+   */
+  bool operator!=(const coxmatches_flat &oxms) const {
+    return (not operator==(oxms));
+  };
+
+public:
+  /**
+   *
+   */
+  size_t length() const { return datalen; };
+
+  /**
+   *
+   */
+  void pack(uint8_t *buf, size_t buflen) const;
+
+  /**
+   *
+   */
+  void unpack(uint8_t *buf, size_t buflen);
+
+  /**
+   *
+   */
+  void clear() { datalen = 0; };
+
+  /**
+   *
+   */
+  bool empty() const { return (0 == datalen); };
+
+  /**
+   * @brief	Returns number of OXM TLVs
+   */
+  size_t size() const;
+
+  /**
+   * @brief	Returns keys of all OXM TLVs in ascending order
+   */
+  std::vector<uint64_t> get_ids() const;
+
+  /**
+   * @brief	Returns FNV-1a hash over packed OXM TLVs
+   */
+  uint64_t hash() const;
+
+  /**
+   * @brief	Returns true if all OXM TLVs of this list exist with identical
+   * values in oxms, strict: and vice versa
+   */
+  bool contains(const coxmatches_flat &oxms, bool strict = false) const;
+
+  /**
+   * @brief	Counts OXM TLVs of oxms found with identical (exact_hits) or
+   * different values (missed) in this list or not present (wildcard_hits),
+   * returns false if any has been missed
+   */
+  bool is_part_of(const coxmatches_flat &oxms, uint16_t &exact_hits,
+                  uint16_t &wildcard_hits, uint16_t &missed) const;
+
+  /**
+   * @brief	Returns a coxmatches instance with the same OXM TLVs
+   */
+  coxmatches get_matches() const;
+
+  /**
+   * @brief	Replaces all OXM TLVs by those stored in oxms
+   */
+  void set_matches(const coxmatches &oxms);
+
+public:
+  /**
+   * @brief	Adds OXM TLV, replacing an existing one with the same key
+   */
+  void add(coxmatch &oxm);
+
+  /**
+   *
+   */
+  bool has(uint64_t key) const {
+    size_t offset = 0;
+    return find(key, offset);
+  };
+
+  /**
+   *
+   */
+  bool drop(uint64_t key);
+
+  /**
+   * @brief	Returns OXM TLV for key unpacked into a T instance
+   */
+  template <class T> T get(uint64_t key) const {
+    size_t offset = 0;
+    if (not find(key, offset)) {
+      throw eOxmInval("coxmatches_flat::get() not found");
+    }
+    T oxm;
+    oxm.unpack(const_cast<uint8_t *>(data) + offset, datalen - offset);
+    return oxm;
+  };
+
+public:
+  /**
+   *
+   */
+  void add_ofb_in_port(uint32_t in_port = 0) {
+    coxmatch_ofb_in_port oxm(in_port);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_in_port get_ofb_in_port() const {
+    return get<coxmatch_ofb_in_port>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PORT));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_in_port() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PORT));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_in_port() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PORT));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_in_phy_port(uint32_t in_phy_port = 0) {
+    coxmatch_ofb_in_phy_port oxm(in_phy_port);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_in_phy_port get_ofb_in_phy_port() const {
+    return get<coxmatch_ofb_in_phy_port>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PHY_PORT));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_in_phy_port() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PHY_PORT));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_in_phy_port() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IN_PHY_PORT));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_metadata(uint64_t metadata = 0) {
+    coxmatch_ofb_metadata oxm(metadata);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_metadata(uint64_t metadata, uint64_t mask) {
+    coxmatch_ofb_metadata oxm(metadata, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_metadata get_ofb_metadata() const {
+    return get<coxmatch_ofb_metadata>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_METADATA));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_metadata() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_METADATA));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_metadata() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_METADATA));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_eth_dst(const rofl::caddress_ll &eth_dst = rofl::caddress_ll()) {
+    coxmatch_ofb_eth_dst oxm(eth_dst);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_eth_dst(const rofl::caddress_ll &eth_dst,
+                       const rofl::caddress_ll &mask) {
+    coxmatch_ofb_eth_dst oxm(eth_dst, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_eth_dst get_ofb_eth_dst() const {
+    return get<coxmatch_ofb_eth_dst>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_eth_dst() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_eth_dst() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_eth_src(const rofl::caddress_ll &eth_src = rofl::caddress_ll()) {
+    coxmatch_ofb_eth_src oxm(eth_src);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_eth_src(const rofl::caddress_ll &eth_src,
+                       const rofl::caddress_ll &mask) {
+    coxmatch_ofb_eth_src oxm(eth_src, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_eth_src get_ofb_eth_src() const {
+    return get<coxmatch_ofb_eth_src>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_eth_src() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_eth_src() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_eth_type(uint16_t eth_type = 0) {
+    coxmatch_ofb_eth_type oxm(eth_type);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_eth_type get_ofb_eth_type() const {
+    return get<coxmatch_ofb_eth_type>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_TYPE));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_eth_type() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_TYPE));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_eth_type() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ETH_TYPE));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_vlan_vid(uint16_t vlan_vid = 0) {
+    coxmatch_ofb_vlan_vid oxm(vlan_vid);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_vlan_vid(uint16_t vlan_vid, uint16_t mask) {
+    coxmatch_ofb_vlan_vid oxm(vlan_vid, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_vlan_vid get_ofb_vlan_vid() const {
+    return get<coxmatch_ofb_vlan_vid>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_VID));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_vlan_vid() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_VID));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_vlan_vid() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_VID));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_vlan_pcp(uint8_t vlan_pcp = 0) {
+    coxmatch_ofb_vlan_pcp oxm(vlan_pcp);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_vlan_pcp get_ofb_vlan_pcp() const {
+    return get<coxmatch_ofb_vlan_pcp>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_PCP));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_vlan_pcp() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_PCP));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_vlan_pcp() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_VLAN_PCP));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ip_dscp(uint8_t ip_dscp = 0) {
+    coxmatch_ofb_ip_dscp oxm(ip_dscp);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ip_dscp get_ofb_ip_dscp() const {
+    return get<coxmatch_ofb_ip_dscp>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_DSCP));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ip_dscp() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_DSCP));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ip_dscp() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_DSCP));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ip_ecn(uint8_t ip_ecn = 0) {
+    coxmatch_ofb_ip_ecn oxm(ip_ecn);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ip_ecn get_ofb_ip_ecn() const {
+    return get<coxmatch_ofb_ip_ecn>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_ECN));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ip_ecn() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_ECN));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ip_ecn() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_ECN));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ip_proto(uint8_t ip_proto = 0) {
+    coxmatch_ofb_ip_proto oxm(ip_proto);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ip_proto get_ofb_ip_proto() const {
+    return get<coxmatch_ofb_ip_proto>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_PROTO));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ip_proto() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_PROTO));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ip_proto() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IP_PROTO));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv4_src(const rofl::caddress_in4 &addr = rofl::caddress_in4()) {
+    coxmatch_ofb_ipv4_src oxm(addr);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv4_src(const rofl::caddress_in4 &addr,
+                        const rofl::caddress_in4 &mask) {
+    coxmatch_ofb_ipv4_src oxm(addr, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv4_src get_ofb_ipv4_src() const {
+    return get<coxmatch_ofb_ipv4_src>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv4_src() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv4_src() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv4_dst(const rofl::caddress_in4 &addr = rofl::caddress_in4()) {
+    coxmatch_ofb_ipv4_dst oxm(addr);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv4_dst(const rofl::caddress_in4 &addr,
+                        const rofl::caddress_in4 &mask) {
+    coxmatch_ofb_ipv4_dst oxm(addr, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv4_dst get_ofb_ipv4_dst() const {
+    return get<coxmatch_ofb_ipv4_dst>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv4_dst() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv4_dst() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV4_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_src(const rofl::caddress_in6 &addr = rofl::caddress_in6()) {
+    coxmatch_ofb_ipv6_src oxm(addr);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_src(const rofl::caddress_in6 &addr,
+                        const rofl::caddress_in6 &mask) {
+    coxmatch_ofb_ipv6_src oxm(addr, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_src get_ofb_ipv6_src() const {
+    return get<coxmatch_ofb_ipv6_src>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_src() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_src() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_dst(const rofl::caddress_in6 &addr = rofl::caddress_in6()) {
+    coxmatch_ofb_ipv6_dst oxm(addr);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_dst(const rofl::caddress_in6 &addr,
+                        const rofl::caddress_in6 &mask) {
+    coxmatch_ofb_ipv6_dst oxm(addr, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_dst get_ofb_ipv6_dst() const {
+    return get<coxmatch_ofb_ipv6_dst>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_dst() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_dst() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_tcp_src(uint16_t tcp_src = 0) {
+    coxmatch_ofb_tcp_src oxm(tcp_src);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_tcp_src get_ofb_tcp_src() const {
+    return get<coxmatch_ofb_tcp_src>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_tcp_src() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_tcp_src() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_tcp_dst(uint16_t tcp_dst = 0) {
+    coxmatch_ofb_tcp_dst oxm(tcp_dst);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_tcp_dst get_ofb_tcp_dst() const {
+    return get<coxmatch_ofb_tcp_dst>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_tcp_dst() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_tcp_dst() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TCP_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_udp_src(uint16_t udp_src = 0) {
+    coxmatch_ofb_udp_src oxm(udp_src);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_udp_src get_ofb_udp_src() const {
+    return get<coxmatch_ofb_udp_src>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_udp_src() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_udp_src() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_udp_dst(uint16_t udp_dst = 0) {
+    coxmatch_ofb_udp_dst oxm(udp_dst);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_udp_dst get_ofb_udp_dst() const {
+    return get<coxmatch_ofb_udp_dst>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_udp_dst() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_udp_dst() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_UDP_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_sctp_src(uint16_t sctp_src = 0) {
+    coxmatch_ofb_sctp_src oxm(sctp_src);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_sctp_src get_ofb_sctp_src() const {
+    return get<coxmatch_ofb_sctp_src>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_sctp_src() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_sctp_src() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_sctp_dst(uint16_t sctp_dst = 0) {
+    coxmatch_ofb_sctp_dst oxm(sctp_dst);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_sctp_dst get_ofb_sctp_dst() const {
+    return get<coxmatch_ofb_sctp_dst>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_sctp_dst() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_sctp_dst() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_SCTP_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_icmpv4_type(uint8_t icmpv4_type = 0) {
+    coxmatch_ofb_icmpv4_type oxm(icmpv4_type);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_icmpv4_type get_ofb_icmpv4_type() const {
+    return get<coxmatch_ofb_icmpv4_type>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_TYPE));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_icmpv4_type() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_TYPE));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_icmpv4_type() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_TYPE));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_icmpv4_code(uint8_t icmpv4_code = 0) {
+    coxmatch_ofb_icmpv4_code oxm(icmpv4_code);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_icmpv4_code get_ofb_icmpv4_code() const {
+    return get<coxmatch_ofb_icmpv4_code>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_CODE));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_icmpv4_code() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_CODE));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_icmpv4_code() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV4_CODE));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_opcode(uint16_t arp_opcode = 0) {
+    coxmatch_ofb_arp_opcode oxm(arp_opcode);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_arp_opcode get_ofb_arp_opcode() const {
+    return get<coxmatch_ofb_arp_opcode>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_OP));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_arp_opcode() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_OP));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_arp_opcode() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_OP));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_spa(uint32_t arp_spa = 0) {
+    coxmatch_ofb_arp_spa oxm(arp_spa);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_spa(uint32_t arp_spa, uint32_t mask) {
+    coxmatch_ofb_arp_spa oxm(arp_spa, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_arp_spa get_ofb_arp_spa() const {
+    return get<coxmatch_ofb_arp_spa>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SPA));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_arp_spa() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SPA));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_arp_spa() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SPA));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_tpa(uint32_t arp_tpa = 0) {
+    coxmatch_ofb_arp_tpa oxm(arp_tpa);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_tpa(uint32_t arp_tpa, uint32_t mask) {
+    coxmatch_ofb_arp_tpa oxm(arp_tpa, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_arp_tpa get_ofb_arp_tpa() const {
+    return get<coxmatch_ofb_arp_tpa>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_TPA));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_arp_tpa() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_TPA));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_arp_tpa() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_TPA));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_sha(const rofl::caddress_ll &arp_sha = 0) {
+    coxmatch_ofb_arp_sha oxm(arp_sha);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_sha(const rofl::caddress_ll &arp_sha,
+                       const rofl::caddress_ll &mask) {
+    coxmatch_ofb_arp_sha oxm(arp_sha, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_arp_sha get_ofb_arp_sha() const {
+    return get<coxmatch_ofb_arp_sha>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SHA));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_arp_sha() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SHA));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_arp_sha() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_SHA));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_tha(const rofl::caddress_ll &arp_tha = 0) {
+    coxmatch_ofb_arp_tha oxm(arp_tha);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_arp_tha(const rofl::caddress_ll &arp_tha,
+                       const rofl::caddress_ll &mask) {
+    coxmatch_ofb_arp_tha oxm(arp_tha, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_arp_tha get_ofb_arp_tha() const {
+    return get<coxmatch_ofb_arp_tha>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_THA));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_arp_tha() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_THA));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_arp_tha() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ARP_THA));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_flabel(uint32_t ipv6_flabel = 0) {
+    coxmatch_ofb_ipv6_flabel oxm(ipv6_flabel);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_flabel(uint32_t ipv6_flabel, uint32_t mask) {
+    coxmatch_ofb_ipv6_flabel oxm(ipv6_flabel, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_flabel get_ofb_ipv6_flabel() const {
+    return get<coxmatch_ofb_ipv6_flabel>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_FLABEL));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_flabel() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_FLABEL));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_flabel() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_FLABEL));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_icmpv6_type(uint8_t icmpv6_type = 0) {
+    coxmatch_ofb_icmpv6_type oxm(icmpv6_type);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_icmpv6_type get_ofb_icmpv6_type() const {
+    return get<coxmatch_ofb_icmpv6_type>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_TYPE));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_icmpv6_type() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_TYPE));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_icmpv6_type() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_TYPE));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_icmpv6_code(uint8_t icmpv6_code = 0) {
+    coxmatch_ofb_icmpv6_code oxm(icmpv6_code);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_icmpv6_code get_ofb_icmpv6_code() const {
+    return get<coxmatch_ofb_icmpv6_code>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_CODE));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_icmpv6_code() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_CODE));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_icmpv6_code() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_ICMPV6_CODE));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_nd_target(
+      const rofl::caddress_in6 &ipv6_nd_target = rofl::caddress_in6()) {
+    coxmatch_ofb_ipv6_nd_target oxm(ipv6_nd_target);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_nd_target get_ofb_ipv6_nd_target() const {
+    return get<coxmatch_ofb_ipv6_nd_target>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TARGET));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_nd_target() {
+    return drop(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TARGET));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_nd_target() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TARGET));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_nd_sll(const rofl::caddress_ll &ipv6_nd_sll = 0) {
+    coxmatch_ofb_ipv6_nd_sll oxm(ipv6_nd_sll);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_nd_sll get_ofb_ipv6_nd_sll() const {
+    return get<coxmatch_ofb_ipv6_nd_sll>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_SLL));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_nd_sll() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_SLL));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_nd_sll() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_SLL));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_nd_tll(const rofl::caddress_ll &ipv6_nd_tll = 0) {
+    coxmatch_ofb_ipv6_nd_tll oxm(ipv6_nd_tll);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_nd_tll get_ofb_ipv6_nd_tll() const {
+    return get<coxmatch_ofb_ipv6_nd_tll>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TLL));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_nd_tll() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TLL));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_nd_tll() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_ND_TLL));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_mpls_label(uint32_t mpls_label = 0) {
+    coxmatch_ofb_mpls_label oxm(mpls_label);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_mpls_label get_ofb_mpls_label() const {
+    return get<coxmatch_ofb_mpls_label>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_LABEL));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_mpls_label() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_LABEL));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_mpls_label() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_LABEL));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_mpls_tc(uint8_t mpls_tc = 0) {
+    coxmatch_ofb_mpls_tc oxm(mpls_tc);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_mpls_tc get_ofb_mpls_tc() const {
+    return get<coxmatch_ofb_mpls_tc>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_TC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_mpls_tc() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_TC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_mpls_tc() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_TC));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_mpls_bos(uint8_t mpls_bos = 0) {
+    coxmatch_ofb_mpls_bos oxm(mpls_bos);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_mpls_bos get_ofb_mpls_bos() const {
+    return get<coxmatch_ofb_mpls_bos>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_BOS));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_mpls_bos() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_BOS));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_mpls_bos() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_MPLS_BOS));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_tunnel_id(uint64_t tunnel_id = 0) {
+    coxmatch_ofb_tunnel_id oxm(tunnel_id);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_tunnel_id(uint64_t tunnel_id, uint64_t mask) {
+    coxmatch_ofb_tunnel_id oxm(tunnel_id, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_tunnel_id get_ofb_tunnel_id() const {
+    return get<coxmatch_ofb_tunnel_id>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TUNNEL_ID));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_tunnel_id() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TUNNEL_ID));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_tunnel_id() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_TUNNEL_ID));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_pbb_isid(uint32_t pbb_isid = 0) {
+    coxmatch_ofb_pbb_isid oxm(pbb_isid);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_pbb_isid(uint32_t pbb_isid, uint32_t mask) {
+    coxmatch_ofb_pbb_isid oxm(pbb_isid, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_pbb_isid get_ofb_pbb_isid() const {
+    return get<coxmatch_ofb_pbb_isid>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_PBB_ISID));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_pbb_isid() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_PBB_ISID));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_pbb_isid() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_PBB_ISID));
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_exthdr(uint16_t ipv6_exthdr = 0) {
+    coxmatch_ofb_ipv6_exthdr oxm(ipv6_exthdr);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  void add_ofb_ipv6_exthdr(uint16_t ipv6_exthdr, uint16_t mask) {
+    coxmatch_ofb_ipv6_exthdr oxm(ipv6_exthdr, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofb_ipv6_exthdr get_ofb_ipv6_exthdr() const {
+    return get<coxmatch_ofb_ipv6_exthdr>(
+        OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_EXTHDR));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofb_ipv6_exthdr() {
+    return drop(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_EXTHDR));
+  };
+
+  /**
+   *
+   */
+  bool has_ofb_ipv6_exthdr() const {
+    return has(OXM_ROFL_OFB_TYPE(rofl::openflow::OXM_TLV_BASIC_IPV6_EXTHDR));
+  };
+
+  /**
+   *
+   */
+  void add_ofx_nw_proto(uint8_t nw_proto = 0) {
+    coxmatch_ofx_nw_proto oxm(nw_proto);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofx_nw_proto get_ofx_nw_proto() const {
+    return get<coxmatch_ofx_nw_proto>(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_PROTO));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofx_nw_proto() {
+    return drop(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_PROTO));
+  };
+
+  /**
+   *
+   */
+  bool has_ofx_nw_proto() const {
+    return has(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_PROTO));
+  };
+
+  /**
+   *
+   */
+  void add_ofx_nw_src(const rofl::caddress_in4 &nw_src = rofl::caddress_in4(),
+                      const rofl::caddress_in4 &mask = rofl::caddress_in4()) {
+    coxmatch_ofx_nw_src oxm(nw_src, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofx_nw_src get_ofx_nw_src() const {
+    return get<coxmatch_ofx_nw_src>(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofx_nw_src() {
+    return drop(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofx_nw_src() const {
+    return has(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofx_nw_dst(const rofl::caddress_in4 &nw_dst = rofl::caddress_in4(),
+                      const rofl::caddress_in4 &mask = rofl::caddress_in4()) {
+    coxmatch_ofx_nw_dst oxm(nw_dst, mask);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofx_nw_dst get_ofx_nw_dst() const {
+    return get<coxmatch_ofx_nw_dst>(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofx_nw_dst() {
+    return drop(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofx_nw_dst() const {
+    return has(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_DST));
+  };
+
+  /**
+   *
+   */
+  void add_ofx_nw_tos(uint8_t nw_tos = 0) {
+    coxmatch_ofx_nw_tos oxm(nw_tos);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofx_nw_tos get_ofx_nw_tos() const {
+    return get<coxmatch_ofx_nw_tos>(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_TOS));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofx_nw_tos() {
+    return drop(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_TOS));
+  };
+
+  /**
+   *
+   */
+  bool has_ofx_nw_tos() const {
+    return has(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_NW_TOS));
+  };
+
+  /**
+   *
+   */
+  void add_ofx_tp_src(uint16_t tp_src = 0) {
+    coxmatch_ofx_tp_src oxm(tp_src);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofx_tp_src get_ofx_tp_src() const {
+    return get<coxmatch_ofx_tp_src>(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_TP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofx_tp_src() {
+    return drop(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_TP_SRC));
+  };
+
+  /**
+   *
+   */
+  bool has_ofx_tp_src() const {
+    return has(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_TP_SRC));
+  };
+
+  /**
+   *
+   */
+  void add_ofx_tp_dst(uint16_t tp_dst = 0) {
+    coxmatch_ofx_tp_dst oxm(tp_dst);
+    add(oxm);
+  };
+
+  /**
+   *
+   */
+  coxmatch_ofx_tp_dst get_ofx_tp_dst() const {
+    return get<coxmatch_ofx_tp_dst>(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_TP_DST));
+  };
+
+  /**
+   *
+   */
+  bool drop_ofx_tp_dst() {
+    return drop(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_TP_DST));
+  };
+
+  /**
+   *
+   */
+  bool has_ofx_tp_dst() const {
+    return has(
+        OXM_ROFL_OFX_TYPE(rofl::openflow::experimental::OXM_TLV_EXPR_TP_DST));
+  };
+
+  /**
+   *
+   */
+  void add_exp_match(coxmatch_exp &oxm) { add(oxm); };
+
+  /**
+   *
+   */
+  coxmatch_exp get_exp_match(uint32_t exp_id, uint32_t oxm_id) const {
+    return get<coxmatch_exp>(OXM_EXPR_OFX_TYPE(exp_id, oxm_id));
+  };
+
+  /**
+   *
+   */
+  bool drop_exp_match(uint32_t exp_id, uint32_t oxm_id) {
+    return drop(OXM_EXPR_OFX_TYPE(exp_id, oxm_id));
+  };
+
+  /**
+   *
+   */
+  bool has_exp_match(uint32_t exp_id, uint32_t oxm_id) const {
+    return has(OXM_EXPR_OFX_TYPE(exp_id, oxm_id));
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const coxmatches_flat &oxms) {
+    os << oxms.get_matches();
+    return os;
+  };
+
+private:
+  /**
+   * @brief	Searches key, sets offset of TLV or of its insertion point
+   */
+  bool find(uint64_t key, size_t &offset) const;
+
+  /**
+   * @brief	Inserts TLV already copied to the end of data at its sorted
+   * position
+   */
+  void insert_tail(size_t tlvlen);
+
+  /**
+   * @brief	Ensures capacity for len bytes, keeping the used part
+   */
+  void reserve(size_t len);
+
+  /**
+   *
+   */
+  static uint64_t get_key(const uint8_t *tlv);
+
+  /**
+   *
+   */
+  static size_t get_tlv_length(const uint8_t *tlv) {
+    return sizeof(struct rofl::openflow::ofp_oxm_hdr) +
+           ((const struct rofl::openflow::ofp_oxm_hdr *)tlv)->oxm_length;
+  };
+
+public:
+  // length of all OXM TLVs stored without a heap allocation
+  static const size_t INLINE_CAPACITY = 512;
+
+private:
+  // packed OXM TLVs in ascending key order, inline_data or heap
+  uint8_t *data;
+
+  // number of bytes available in data
+  size_t datacap;
+
+  // number of bytes used in data
+  size_t datalen;
+
+  // storage for lists up to INLINE_CAPACITY bytes
+  uint8_t inline_data[INLINE_CAPACITY];
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* COXMATCHES_FLAT_H_ */
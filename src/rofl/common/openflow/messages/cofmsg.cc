@@ -4,8 +4,51 @@
 
 #include "rofl/common/openflow/messages/cofmsg.h"
 
+#include <atomic>
+
 using namespace rofl::openflow;
 
+namespace {
+// number of decoded messages per message type
+std::atomic<uint64_t> num_decoded[256];
+
+// number of allocations made while decoding per message type
+std::atomic<uint64_t> num_decoded_allocs[256];
+}; // end of anonymous namespace
+
+/*static*/ void cofmsg::count_allocs(uint8_t type, uint64_t num_allocs) {
+  num_decoded[type].fetch_add(1, std::memory_order_relaxed);
+  num_decoded_allocs[type].fetch_add(num_allocs, std::memory_order_relaxed);
+}
+
+/*static*/ uint64_t cofmsg::get_num_decoded(uint8_t type) {
+  return num_decoded[type].load(std::memory_order_relaxed);
+}
+
+/*static*/ uint64_t cofmsg::get_num_allocs(uint8_t type) {
+  return num_decoded_allocs[type].load(std::memory_order_relaxed);
+}
+
+/*static*/ void cofmsg::reset_alloc_counters() {
+  for (unsigned int type = 0; type < 256; type++) {
+    num_decoded[type] = 0;
+    num_decoded_allocs[type] = 0;
+  }
+}
+
+/*static*/ std::ostream &cofmsg::dump_alloc_counters(std::ostream &os) {
+  os << "<cofmsg alloc counters >" << std::endl;
+  for (unsigned int type = 0; type < 256; type++) {
+    uint64_t msgs = get_num_decoded(type);
+    if (msgs == 0)
+      continue;
+    uint64_t allocs = get_num_allocs(type);
+    os << "  <type: " << type << " #msgs: " << msgs << " #allocs: " << allocs
+       << " #allocs/msg: " << (double)allocs / msgs << " >" << std::endl;
+  }
+  return os;
+}
+
 size_t cofmsg::length() const {
   return sizeof(struct rofl::openflow::ofp_header);
 }
@@ -28,6 +71,26 @@ void cofmsg::pack(uint8_t *buf, size_t buflen) {
   hdr->xid = htobe32(xid);
 }
 
+void cofmsg::serialize(cofwriter &writer) {
+  size_t msglen = length();
+  size_t offset = writer.reserve(msglen);
+  pack(writer.at(offset), msglen);
+}
+
+size_t cofmsg::serialize_header(cofwriter &writer) {
+  size_t start = writer.length();
+  writer.put8(version);
+  writer.put8(type);
+  writer.put16(0);
+  writer.put32(xid);
+  return start;
+}
+
+void cofmsg::serialize_length(cofwriter &writer, size_t start) {
+  writer.patch_length16(start + 2, start);
+  len = writer.length() - start;
+}
+
 void cofmsg::unpack(uint8_t *buf, size_t buflen) {
   if ((0 == buf) || (0 == buflen))
     return;
@@ -7,6 +7,9 @@
 
 #include <sstream>
 
+#include "rofl/common/cslab.hpp"
+#include "rofl/common/cslice.hpp"
+#include "rofl/common/openflow/cofwriter.h"
 #include "rofl/common/openflow/openflow.h"
 #include "rofl/common/openflow/openflow_rofl_exceptions.h"
 
@@ -23,6 +26,20 @@ public:
    */
   virtual ~cofmsg(){};
 
+  /**
+   * @brief	Instances are allocated from the calling thread's slab
+   */
+  static void *operator new(size_t size) {
+    return rofl::cslab::allocate(size);
+  };
+
+  /**
+   *
+   */
+  static void operator delete(void *ptr, size_t size) {
+    rofl::cslab::deallocate(ptr, size);
+  };
+
   /**
    *
    */
@@ -55,6 +72,34 @@ public:
     return *this;
   };
 
+public:
+  /**
+   * @brief	Records a decoded message of given type and the number of
+   * allocations made while decoding it
+   */
+  static void count_allocs(uint8_t type, uint64_t num_allocs);
+
+  /**
+   * @brief	Returns number of decoded messages of given type
+   */
+  static uint64_t get_num_decoded(uint8_t type);
+
+  /**
+   * @brief	Returns number of allocations made while decoding messages of
+   * given type
+   */
+  static uint64_t get_num_allocs(uint8_t type);
+
+  /**
+   *
+   */
+  static void reset_alloc_counters();
+
+  /**
+   * @brief	Dumps allocation counters of all message types seen so far
+   */
+  static std::ostream &dump_alloc_counters(std::ostream &os);
+
 public:
   /**
    *
@@ -66,11 +111,45 @@ public:
    */
   virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
 
+  /**
+   * @brief	Appends this message to writer in a single pass
+   *
+   * Length fields are back-patched once nested elements have been
+   * written. The default implementation reserves length() bytes and
+   * falls back to pack().
+   */
+  virtual void serialize(cofwriter &writer);
+
   /**
    *
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Parses message from a shared buffer
+   *
+   * Messages carrying a payload (e.g. Packet-In, Packet-Out) keep a
+   * reference to the buffer instead of copying the payload. The default
+   * implementation falls back to unpack().
+   */
+  virtual void unpack_shared(const rofl::cslice &slice) {
+    unpack(slice.somem(), slice.length());
+  };
+
+  /**
+   * @brief	Parses message from a shared buffer, decoding deferred
+   *
+   * Messages carrying variable length bodies (e.g. Flow-Mod, Flow-Stats)
+   * parse their fixed header fields only and keep a view of the body
+   * bytes. The body is decoded on first access, so malformed bodies are
+   * reported by the accessor. Packing an unmodified body copies the
+   * original bytes. The default implementation falls back to
+   * unpack_shared().
+   */
+  virtual void unpack_lazy(const rofl::cslice &slice) {
+    unpack_shared(slice);
+  };
+
 public:
   /**
    *
@@ -139,6 +218,9 @@ public:
     case rofl::openflow13::OFP_VERSION: {
       ss << "version: 1.3";
     } break;
+    case rofl::openflow14::OFP_VERSION: {
+      ss << "version: 1.4";
+    } break;
     default: { ss << "version: " << (int)get_version() << "(on wire)"; } break;
     }
     ss << ", type: " << (int)get_type() << ", len: " << (int)get_length()
@@ -147,6 +229,19 @@ public:
     return ss.str();
   };
 
+protected:
+  /**
+   * @brief	Appends common header with a placeholder length field
+   *
+   * @return offset of header in writer
+   */
+  size_t serialize_header(cofwriter &writer);
+
+  /**
+   * @brief	Back-patches length field of header at offset start
+   */
+  void serialize_length(cofwriter &writer, size_t start);
+
 private:
   uint8_t version;
   uint8_t type;
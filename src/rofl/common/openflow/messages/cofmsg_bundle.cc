@@ -0,0 +1,295 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_group_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_packet_out.h"
+
+using namespace rofl::openflow;
+
+cofmsg_bundle_control::~cofmsg_bundle_control() {}
+
+cofmsg_bundle_control::cofmsg_bundle_control(uint8_t version, uint32_t xid,
+                                             uint32_t bundle_id,
+                                             uint16_t ctrl_type,
+                                             uint16_t flags)
+    : cofmsg(version, rofl::openflow14::OFPT_BUNDLE_CONTROL, xid),
+      bundle_id(bundle_id), ctrl_type(ctrl_type), flags(flags) {}
+
+cofmsg_bundle_control::cofmsg_bundle_control(const cofmsg_bundle_control &msg) {
+  *this = msg;
+}
+
+cofmsg_bundle_control &cofmsg_bundle_control::
+operator=(const cofmsg_bundle_control &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  bundle_id = msg.bundle_id;
+  ctrl_type = msg.ctrl_type;
+  flags = msg.flags;
+  properties = msg.properties;
+  return *this;
+}
+
+size_t cofmsg_bundle_control::length() const {
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    return (sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg) +
+            properties.length());
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofmsg_bundle_control::pack(uint8_t *buf, size_t buflen) {
+  cofmsg::pack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_bundle_control::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow14::ofp_bundle_ctrl_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_ctrl_msg *)buf;
+
+    hdr->bundle_id = htobe32(bundle_id);
+    hdr->type = htobe16(ctrl_type);
+    hdr->flags = htobe16(flags);
+
+    if (properties.length() > 0) {
+      properties.pack(
+          buf + sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg),
+          properties.length());
+    }
+  };
+  }
+}
+
+void cofmsg_bundle_control::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  properties.clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+
+    if (get_type() != rofl::openflow14::OFPT_BUNDLE_CONTROL)
+      throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    if (buflen < sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow14::ofp_bundle_ctrl_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_ctrl_msg *)buf;
+
+    bundle_id = be32toh(hdr->bundle_id);
+    ctrl_type = be16toh(hdr->type);
+    flags = be16toh(hdr->flags);
+
+    if (get_length() > sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg)) {
+      properties.unpack(
+          buf + sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg),
+          get_length() - sizeof(struct rofl::openflow14::ofp_bundle_ctrl_msg));
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                __FUNCTION__, __LINE__);
+  }
+
+  if (get_length() < cofmsg_bundle_control::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
+
+cofmsg_bundle_add_message::~cofmsg_bundle_add_message() { delete msg; }
+
+cofmsg_bundle_add_message::cofmsg_bundle_add_message(uint8_t version,
+                                                     uint32_t xid,
+                                                     uint32_t bundle_id,
+                                                     uint16_t flags,
+                                                     cofmsg *msg)
+    : cofmsg(version, rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE, xid),
+      bundle_id(bundle_id), flags(flags), msg(msg) {}
+
+cofmsg_bundle_add_message::cofmsg_bundle_add_message(
+    const cofmsg_bundle_add_message &msg)
+    : msg(nullptr) {
+  *this = msg;
+}
+
+cofmsg_bundle_add_message &cofmsg_bundle_add_message::
+operator=(const cofmsg_bundle_add_message &msg) {
+  if (this == &msg)
+    return *this;
+  cofmsg::operator=(msg);
+  bundle_id = msg.bundle_id;
+  flags = msg.flags;
+  properties = msg.properties;
+
+  /* clone embedded message via its wire representation */
+  cofmsg *clone = nullptr;
+  if (msg.msg != nullptr) {
+    rofl::cmemory mem(msg.msg->length());
+    msg.msg->pack(mem.somem(), mem.length());
+    clone = create_message(msg.msg->get_type());
+    try {
+      clone->unpack(mem.somem(), mem.length());
+    } catch (...) {
+      delete clone;
+      throw;
+    }
+  }
+  delete this->msg;
+  this->msg = clone;
+  return *this;
+}
+
+cofmsg *cofmsg_bundle_add_message::create_message(uint8_t type) {
+  switch (type) {
+  case rofl::openflow::OFPT_FLOW_MOD:
+    return new cofmsg_flow_mod();
+  case rofl::openflow::OFPT_GROUP_MOD:
+    return new cofmsg_group_mod();
+  case rofl::openflow13::OFPT_METER_MOD:
+    return new cofmsg_meter_mod();
+  case rofl::openflow::OFPT_PACKET_OUT:
+    return new cofmsg_packet_out();
+  default:
+    throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                             __LINE__);
+  }
+  return nullptr;
+}
+
+size_t cofmsg_bundle_add_message::length() const {
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+    size_t len = sizeof(struct rofl::openflow14::ofp_bundle_add_msg) -
+                 sizeof(struct rofl::openflow14::ofp_header);
+    if (msg != nullptr)
+      len += msg->length();
+    if (properties.length() > 0)
+      len = ((len + 7) / 8) * 8 + properties.length();
+    return len;
+  } break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+  return 0;
+}
+
+void cofmsg_bundle_add_message::pack(uint8_t *buf, size_t buflen) {
+  cofmsg::pack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  if (buflen < cofmsg_bundle_add_message::length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  if (msg == nullptr)
+    throw eInvalid("cofmsg_bundle_add_message::pack() no message", __FILE__,
+                   __FUNCTION__, __LINE__);
+
+  switch (get_version()) {
+  default: {
+    struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_add_msg *)buf;
+
+    hdr->bundle_id = htobe32(bundle_id);
+    hdr->pad = 0;
+    hdr->flags = htobe16(flags);
+
+    /* the embedded message must carry the enclosing message's xid */
+    msg->set_xid(get_xid());
+    size_t offset = sizeof(struct rofl::openflow14::ofp_bundle_add_msg) -
+                    sizeof(struct rofl::openflow14::ofp_header);
+    msg->pack(buf + offset, msg->length());
+    offset += msg->length();
+
+    if (properties.length() > 0) {
+      size_t padded = ((offset + 7) / 8) * 8;
+      memset(buf + offset, 0, padded - offset);
+      properties.pack(buf + padded, properties.length());
+    }
+  };
+  }
+}
+
+void cofmsg_bundle_add_message::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  properties.clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  switch (get_version()) {
+  case rofl::openflow14::OFP_VERSION: {
+
+    if (get_type() != rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE)
+      throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                               __LINE__);
+
+    if (get_length() < sizeof(struct rofl::openflow14::ofp_bundle_add_msg))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+        (struct rofl::openflow14::ofp_bundle_add_msg *)buf;
+
+    bundle_id = be32toh(hdr->bundle_id);
+    flags = be16toh(hdr->flags);
+
+    size_t offset = sizeof(struct rofl::openflow14::ofp_bundle_add_msg) -
+                    sizeof(struct rofl::openflow14::ofp_header);
+    size_t msglen = be16toh(hdr->message.length);
+    if ((msglen < sizeof(struct rofl::openflow14::ofp_header)) ||
+        ((offset + msglen) > get_length()))
+      throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+
+    if (hdr->message.version != get_version())
+      throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                  __FUNCTION__, __LINE__);
+
+    cofmsg *inner = create_message(hdr->message.type);
+    try {
+      inner->unpack(buf + offset, msglen);
+    } catch (...) {
+      delete inner;
+      throw;
+    }
+    set_message(inner);
+    offset += msglen;
+
+    /* properties follow the embedded message padded to 8 bytes */
+    size_t padded = ((offset + 7) / 8) * 8;
+    if (get_length() > padded) {
+      properties.unpack(buf + padded, get_length() - padded);
+    }
+  } break;
+  default:
+    throw eBadRequestBadVersion("eBadRequestBadVersion", __FILE__,
+                                __FUNCTION__, __LINE__);
+  }
+
+  if (get_length() < cofmsg_bundle_add_message::length())
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+}
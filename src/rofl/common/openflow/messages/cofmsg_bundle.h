@@ -0,0 +1,299 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_bundle.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef COFMSG_BUNDLE_H
+#define COFMSG_BUNDLE_H 1
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	OpenFlow 1.4 Bundle-Control message
+ *
+ * Used for requests (open, close, commit, discard) and replies alike,
+ * see get_ctrl_type(). Bundle properties are kept as opaque bytes.
+ */
+class cofmsg_bundle_control : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_bundle_control();
+
+  /**
+   *
+   */
+  cofmsg_bundle_control(uint8_t version = 0, uint32_t xid = 0,
+                        uint32_t bundle_id = 0, uint16_t ctrl_type = 0,
+                        uint16_t flags = 0);
+
+  /**
+   *
+   */
+  cofmsg_bundle_control(const cofmsg_bundle_control &msg);
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &operator=(const cofmsg_bundle_control &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  uint32_t get_bundle_id() const { return bundle_id; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &set_bundle_id(uint32_t bundle_id) {
+    this->bundle_id = bundle_id;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns one of rofl::openflow14::OFPBCT_*
+   */
+  uint16_t get_ctrl_type() const { return ctrl_type; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &set_ctrl_type(uint16_t ctrl_type) {
+    this->ctrl_type = ctrl_type;
+    return *this;
+  };
+
+  /**
+   * @brief	Returns true for OFPBCT_*_REQUEST control types
+   */
+  bool is_request() const { return ((ctrl_type & 1) == 0); };
+
+  /**
+   * @brief	Returns bitmap of rofl::openflow14::OFPBF_* flags
+   */
+  uint16_t get_flags() const { return flags; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_control &set_flags(uint16_t flags) {
+    this->flags = flags;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  const rofl::cmemory &get_properties() const { return properties; };
+
+  /**
+   *
+   */
+  rofl::cmemory &set_properties() { return properties; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_bundle_control &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_bundle_control bundle_id: " << (unsigned int)msg.bundle_id
+       << " type: " << (unsigned int)msg.ctrl_type << " flags: 0x" << std::hex
+       << (unsigned int)msg.flags << std::dec << " >" << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Bundle-Control- "
+       << "{bundle_id: " << (unsigned int)bundle_id
+       << ", type: " << (unsigned int)ctrl_type << ", flags: 0x" << std::hex
+       << (unsigned int)flags << std::dec << "} ";
+    return ss.str();
+  };
+
+private:
+  uint32_t bundle_id;
+  uint16_t ctrl_type;
+  uint16_t flags;
+  rofl::cmemory properties;
+};
+
+/**
+ * @brief	OpenFlow 1.4 Bundle-Add-Message message
+ *
+ * Carries a single Flow-Mod, Group-Mod, Meter-Mod or Packet-Out message.
+ * The embedded message is owned by this instance and is packed with the
+ * transaction id of the enclosing message, as required by the
+ * specification. unpack() throws eBadRequestBadType for embedded messages
+ * of any other type.
+ */
+class cofmsg_bundle_add_message : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_bundle_add_message();
+
+  /**
+   * @brief	Takes ownership of msg
+   */
+  cofmsg_bundle_add_message(uint8_t version = 0, uint32_t xid = 0,
+                            uint32_t bundle_id = 0, uint16_t flags = 0,
+                            cofmsg *msg = nullptr);
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message(const cofmsg_bundle_add_message &msg);
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message &operator=(const cofmsg_bundle_add_message &msg);
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const;
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   *
+   */
+  uint32_t get_bundle_id() const { return bundle_id; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message &set_bundle_id(uint32_t bundle_id) {
+    this->bundle_id = bundle_id;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  uint16_t get_flags() const { return flags; };
+
+  /**
+   *
+   */
+  cofmsg_bundle_add_message &set_flags(uint16_t flags) {
+    this->flags = flags;
+    return *this;
+  };
+
+  /**
+   *
+   */
+  bool has_message() const { return (msg != nullptr); };
+
+  /**
+   * @brief	Returns embedded message, throws eInvalid if none is set
+   */
+  const cofmsg &get_message() const {
+    if (msg == nullptr)
+      throw eInvalid("cofmsg_bundle_add_message::get_message() no message");
+    return *msg;
+  };
+
+  /**
+   * @brief	Replaces embedded message, takes ownership of msg
+   */
+  cofmsg_bundle_add_message &set_message(cofmsg *msg) {
+    delete this->msg;
+    this->msg = msg;
+    return *this;
+  };
+
+  /**
+   * @brief	Hands embedded message over to the caller
+   */
+  cofmsg *release_message() {
+    cofmsg *tmp = msg;
+    msg = nullptr;
+    return tmp;
+  };
+
+  /**
+   *
+   */
+  const rofl::cmemory &get_properties() const { return properties; };
+
+  /**
+   *
+   */
+  rofl::cmemory &set_properties() { return properties; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_bundle_add_message &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_bundle_add_message bundle_id: "
+       << (unsigned int)msg.bundle_id << " flags: 0x" << std::hex
+       << (unsigned int)msg.flags << std::dec << " >" << std::endl;
+    if (msg.msg != nullptr)
+      os << *(msg.msg);
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Bundle-Add-Message- "
+       << "{bundle_id: " << (unsigned int)bundle_id << ", flags: 0x"
+       << std::hex << (unsigned int)flags << std::dec << "} ";
+    if (msg != nullptr)
+      ss << msg->str();
+    return ss.str();
+  };
+
+private:
+  static cofmsg *create_message(uint8_t type);
+
+  uint32_t bundle_id;
+  uint16_t flags;
+  cofmsg *msg;
+  rofl::cmemory properties;
+};
+
+} // end of namespace openflow
+} // end of namespace rofl
+
+#endif /* COFMSG_BUNDLE_H */
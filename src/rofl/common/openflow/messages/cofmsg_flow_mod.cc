@@ -17,14 +17,17 @@ cofmsg_flow_mod &cofmsg_flow_mod::operator=(const cofmsg_flow_mod &msg) {
     return *this;
   cofmsg::operator=(msg);
   flowmod = msg.flowmod;
+  lazy = msg.lazy;
   return *this;
 }
 
 void cofmsg_flow_mod::check_prerequisites() const {
-  flowmod.check_prerequisites();
+  get_flowmod().check_prerequisites();
 }
 
 size_t cofmsg_flow_mod::length() const {
+  if (lazy.has_body())
+    return cofmsg::length() + lazy.length();
   switch (get_version()) {
   default: { return cofmsg::length() + flowmod.length(); };
   }
@@ -46,16 +49,31 @@ void cofmsg_flow_mod::pack(uint8_t *buf, size_t buflen) {
     struct rofl::openflow::ofp_header *hdr =
         (struct rofl::openflow::ofp_header *)buf;
 
-    flowmod.pack(hdr->body, flowmod.length());
+    if (lazy.has_body()) {
+      lazy.pack(hdr->body, lazy.length());
+    } else {
+      flowmod.pack(hdr->body, flowmod.length());
+    }
   };
   }
 }
 
+void cofmsg_flow_mod::serialize(cofwriter &writer) {
+  size_t start = serialize_header(writer);
+  if (lazy.has_body()) {
+    lazy.serialize(writer);
+  } else {
+    flowmod.serialize(writer);
+  }
+  serialize_length(writer, start);
+}
+
 void cofmsg_flow_mod::unpack(uint8_t *buf, size_t buflen) {
   cofmsg::unpack(buf, buflen);
 
   flowmod.set_version(get_version());
   flowmod.clear();
+  lazy.release();
 
   if ((0 == buf) || (0 == buflen))
     return;
@@ -85,3 +103,27 @@ void cofmsg_flow_mod::unpack(uint8_t *buf, size_t buflen) {
     throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                             __LINE__);
 }
+
+void cofmsg_flow_mod::unpack_lazy(const rofl::cslice &slice) {
+  cofmsg::unpack(slice.somem(), slice.length());
+
+  flowmod.set_version(get_version());
+  flowmod.clear();
+  lazy.release();
+
+  if (slice.empty())
+    return;
+
+  if (get_type() != rofl::openflow::OFPT_FLOW_MOD)
+    throw eBadRequestBadType("eBadRequestBadType", __FILE__, __FUNCTION__,
+                             __LINE__);
+
+  size_t hdrlen = sizeof(struct rofl::openflow::ofp_header);
+  lazy.assign(slice.slice(hdrlen, get_length() - hdrlen));
+}
+
+void cofmsg_flow_mod::decode_lazy() const {
+  const rofl::cslice &body = lazy.get_body();
+  flowmod.unpack(body.somem(), body.length());
+  lazy.set_decoded();
+}
@@ -9,6 +9,7 @@
 #define COFMSG_FLOW_MOD_H_ 1
 
 #include "rofl/common/openflow/cofflowmod.h"
+#include "rofl/common/openflow/coflazy.h"
 #include "rofl/common/openflow/messages/cofmsg.h"
 
 namespace rofl {
@@ -57,21 +58,38 @@ public:
    */
   virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
 
+  /**
+   * @brief	Appends this message to writer in a single pass
+   */
+  virtual void serialize(cofwriter &writer);
+
   /**
    *
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Parses header only, flowmod is decoded on first access
+   */
+  virtual void unpack_lazy(const rofl::cslice &slice);
+
 public:
   /**
    *
    */
-  const rofl::openflow::cofflowmod &get_flowmod() const { return flowmod; };
+  const rofl::openflow::cofflowmod &get_flowmod() const {
+    decode();
+    return flowmod;
+  };
 
   /**
-   *
+   * @brief	Returns flowmod for modification, original bytes are dropped
    */
-  rofl::openflow::cofflowmod &set_flowmod() { return flowmod; };
+  rofl::openflow::cofflowmod &set_flowmod() {
+    decode();
+    lazy.release();
+    return flowmod;
+  };
 
 public:
   friend std::ostream &operator<<(std::ostream &os,
@@ -84,12 +102,30 @@ public:
 
   std::string str() const {
     std::stringstream ss;
-    ss << cofmsg::str() << "-Flow-Mod- flowmod: " << flowmod.str() << " ";
+    ss << cofmsg::str() << "-Flow-Mod- flowmod: " << get_flowmod().str()
+       << " ";
     return ss.str();
   };
 
 private:
-  rofl::openflow::cofflowmod flowmod;
+  /**
+   * @brief	Decodes flowmod from original bytes, if still pending
+   */
+  void decode() const {
+    if (lazy.is_pending())
+      decode_lazy();
+  };
+
+  /**
+   *
+   */
+  void decode_lazy() const;
+
+private:
+  mutable rofl::openflow::cofflowmod flowmod;
+
+  // original flowmod bytes of a lazily decoded message
+  mutable rofl::openflow::coflazy lazy;
 };
 
 } // end of namespace openflow
@@ -243,7 +243,8 @@ public:
 
     } break;
     case rofl::openflow12::OFP_VERSION:
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       os << dynamic_cast<cofmsg const &>(msg);
       os << "<cofmsg_flow_removed >" << std::endl;
       os << "<cookie:0x" << std::hex << (int)msg.get_cookie() << std::dec
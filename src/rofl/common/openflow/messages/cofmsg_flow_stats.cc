@@ -28,18 +28,18 @@ operator=(const cofmsg_flow_stats_request &msg) {
     return *this;
   cofmsg_stats_request::operator=(msg);
   flow_stats = msg.flow_stats;
+  lazy = msg.lazy;
   return *this;
 }
 
 size_t cofmsg_flow_stats_request::length() const {
+  size_t bodylen = lazy.has_body() ? lazy.length() : flow_stats.length();
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION: {
-    return (sizeof(struct rofl::openflow10::ofp_stats_request) +
-            flow_stats.length());
+    return (sizeof(struct rofl::openflow10::ofp_stats_request) + bodylen);
   } break;
   default: {
-    return (sizeof(struct rofl::openflow13::ofp_multipart_request) +
-            flow_stats.length());
+    return (sizeof(struct rofl::openflow13::ofp_multipart_request) + bodylen);
   };
   }
   return 0;
@@ -54,24 +54,28 @@ void cofmsg_flow_stats_request::pack(uint8_t *buf, size_t buflen) {
   if (buflen < cofmsg_flow_stats_request::length())
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
+  uint8_t *body;
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION: {
-    struct rofl::openflow10::ofp_stats_request *hdr =
-        (struct rofl::openflow10::ofp_stats_request *)buf;
-    flow_stats.pack(hdr->body, flow_stats.length());
+    body = ((struct rofl::openflow10::ofp_stats_request *)buf)->body;
   } break;
   default: {
-    struct rofl::openflow13::ofp_multipart_request *hdr =
-        (struct rofl::openflow13::ofp_multipart_request *)buf;
-    flow_stats.pack(hdr->body, flow_stats.length());
+    body = ((struct rofl::openflow13::ofp_multipart_request *)buf)->body;
   };
   }
+
+  if (lazy.has_body()) {
+    lazy.pack(body, lazy.length());
+  } else {
+    flow_stats.pack(body, flow_stats.length());
+  }
 }
 
 void cofmsg_flow_stats_request::unpack(uint8_t *buf, size_t buflen) {
   cofmsg_stats_request::unpack(buf, buflen);
 
   flow_stats.set_version(get_version());
+  lazy.release();
 
   if ((0 == buf) || (0 == buflen))
     return;
@@ -114,6 +118,45 @@ void cofmsg_flow_stats_request::unpack(uint8_t *buf, size_t buflen) {
                             __LINE__);
 }
 
+void cofmsg_flow_stats_request::unpack_lazy(const rofl::cslice &slice) {
+  cofmsg_stats_request::unpack(slice.somem(), slice.length());
+
+  flow_stats.set_version(get_version());
+  lazy.release();
+
+  if (slice.empty())
+    return;
+
+  size_t hdrlen;
+  switch (get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    if (get_stats_type() != rofl::openflow10::OFPST_FLOW)
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+    hdrlen = sizeof(struct rofl::openflow10::ofp_stats_request);
+  } break;
+  default: {
+    if (get_stats_type() != rofl::openflow13::OFPMP_FLOW)
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+    hdrlen = sizeof(struct rofl::openflow13::ofp_multipart_request);
+  };
+  }
+
+  if (get_length() < hdrlen)
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+
+  lazy.assign(slice.slice(hdrlen, get_length() - hdrlen));
+}
+
+void cofmsg_flow_stats_request::decode_lazy() const {
+  const rofl::cslice &body = lazy.get_body();
+  if (not body.empty())
+    flow_stats.unpack(body.somem(), body.length());
+  lazy.set_decoded();
+}
+
 cofmsg_flow_stats_reply::~cofmsg_flow_stats_reply() {}
 
 cofmsg_flow_stats_reply::cofmsg_flow_stats_reply(
@@ -135,18 +178,18 @@ operator=(const cofmsg_flow_stats_reply &msg) {
     return *this;
   cofmsg_stats_reply::operator=(msg);
   flowstatsarray = msg.flowstatsarray;
+  lazy = msg.lazy;
   return *this;
 }
 
 size_t cofmsg_flow_stats_reply::length() const {
+  size_t bodylen = lazy.has_body() ? lazy.length() : flowstatsarray.length();
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION: {
-    return (sizeof(struct rofl::openflow10::ofp_stats_reply) +
-            flowstatsarray.length());
+    return (sizeof(struct rofl::openflow10::ofp_stats_reply) + bodylen);
   } break;
   default: {
-    return (sizeof(struct rofl::openflow13::ofp_multipart_reply) +
-            flowstatsarray.length());
+    return (sizeof(struct rofl::openflow13::ofp_multipart_reply) + bodylen);
   };
   }
   return 0;
@@ -161,24 +204,28 @@ void cofmsg_flow_stats_reply::pack(uint8_t *buf, size_t buflen) {
   if (buflen < cofmsg_flow_stats_reply::length())
     throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
 
+  uint8_t *body;
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION: {
-    struct rofl::openflow10::ofp_stats_request *hdr =
-        (struct rofl::openflow10::ofp_stats_request *)buf;
-    flowstatsarray.pack(hdr->body, flowstatsarray.length());
+    body = ((struct rofl::openflow10::ofp_stats_reply *)buf)->body;
   } break;
   default: {
-    struct rofl::openflow13::ofp_multipart_request *hdr =
-        (struct rofl::openflow13::ofp_multipart_request *)buf;
-    flowstatsarray.pack(hdr->body, flowstatsarray.length());
+    body = ((struct rofl::openflow13::ofp_multipart_reply *)buf)->body;
   };
   }
+
+  if (lazy.has_body()) {
+    lazy.pack(body, lazy.length());
+  } else {
+    flowstatsarray.pack(body, flowstatsarray.length());
+  }
 }
 
 void cofmsg_flow_stats_reply::unpack(uint8_t *buf, size_t buflen) {
   cofmsg_stats_reply::unpack(buf, buflen);
 
   flowstatsarray.set_version(get_version());
+  lazy.release();
 
   if ((0 == buf) || (0 == buflen))
     return;
@@ -219,3 +266,43 @@ void cofmsg_flow_stats_reply::unpack(uint8_t *buf, size_t buflen) {
     throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                             __LINE__);
 }
+
+void cofmsg_flow_stats_reply::unpack_lazy(const rofl::cslice &slice) {
+  cofmsg_stats_reply::unpack(slice.somem(), slice.length());
+
+  flowstatsarray.set_version(get_version());
+  flowstatsarray.clear();
+  lazy.release();
+
+  if (slice.empty())
+    return;
+
+  size_t hdrlen;
+  switch (get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    if (get_stats_type() != rofl::openflow10::OFPST_FLOW)
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+    hdrlen = sizeof(struct rofl::openflow10::ofp_stats_reply);
+  } break;
+  default: {
+    if (get_stats_type() != rofl::openflow13::OFPMP_FLOW)
+      throw eBadRequestBadStat("eBadRequestBadStat", __FILE__, __FUNCTION__,
+                               __LINE__);
+    hdrlen = sizeof(struct rofl::openflow13::ofp_multipart_reply);
+  };
+  }
+
+  if (get_length() < hdrlen)
+    throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
+                            __LINE__);
+
+  lazy.assign(slice.slice(hdrlen, get_length() - hdrlen));
+}
+
+void cofmsg_flow_stats_reply::decode_lazy() const {
+  const rofl::cslice &body = lazy.get_body();
+  if (not body.empty())
+    flowstatsarray.unpack(body.somem(), body.length());
+  lazy.set_decoded();
+}
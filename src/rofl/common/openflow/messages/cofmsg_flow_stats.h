@@ -15,6 +15,7 @@
 
 #include "rofl/common/openflow/cofflowstats.h"
 #include "rofl/common/openflow/cofflowstatsarray.h"
+#include "rofl/common/openflow/coflazy.h"
 #include "rofl/common/openflow/messages/cofmsg_stats.h"
 
 namespace rofl {
@@ -64,16 +65,28 @@ public:
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Parses header only, flow stats are decoded on first access
+   */
+  virtual void unpack_lazy(const rofl::cslice &slice);
+
 public:
   /**
    *
    */
-  const cofflow_stats_request &get_flow_stats() const { return flow_stats; };
+  const cofflow_stats_request &get_flow_stats() const {
+    decode();
+    return flow_stats;
+  };
 
   /**
-   *
+   * @brief	Returns flow stats for modification, original bytes are dropped
    */
-  cofflow_stats_request &set_flow_stats() { return flow_stats; };
+  cofflow_stats_request &set_flow_stats() {
+    decode();
+    lazy.release();
+    return flow_stats;
+  };
 
 public:
   friend std::ostream &operator<<(std::ostream &os,
@@ -81,7 +94,7 @@ public:
     os << dynamic_cast<const cofmsg_stats_request &>(msg);
     os << "<cofmsg_flow_stats_request >" << std::endl;
 
-    os << msg.flow_stats;
+    os << msg.get_flow_stats();
     return os;
   };
 
@@ -92,7 +105,24 @@ public:
   };
 
 private:
-  cofflow_stats_request flow_stats;
+  /**
+   * @brief	Decodes flow stats from original bytes, if still pending
+   */
+  void decode() const {
+    if (lazy.is_pending())
+      decode_lazy();
+  };
+
+  /**
+   *
+   */
+  void decode_lazy() const;
+
+private:
+  mutable cofflow_stats_request flow_stats;
+
+  // original body bytes of a lazily decoded message
+  mutable rofl::openflow::coflazy lazy;
 };
 
 /**
@@ -139,18 +169,26 @@ public:
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Parses header only, flow stats are decoded on first access
+   */
+  virtual void unpack_lazy(const rofl::cslice &slice);
+
 public:
   /**
    *
    */
   const rofl::openflow::cofflowstatsarray &get_flow_stats_array() const {
+    decode();
     return flowstatsarray;
   };
 
   /**
-   *
+   * @brief	Returns flow stats for modification, original bytes are dropped
    */
   rofl::openflow::cofflowstatsarray &set_flow_stats_array() {
+    decode();
+    lazy.release();
     return flowstatsarray;
   };
 
@@ -160,7 +198,7 @@ public:
     os << dynamic_cast<const cofmsg_stats_reply &>(msg);
     os << "<cofmsg_flow_stats_reply >" << std::endl;
 
-    os << msg.flowstatsarray;
+    os << msg.get_flow_stats_array();
     return os;
   };
 
@@ -171,7 +209,24 @@ public:
   };
 
 private:
-  rofl::openflow::cofflowstatsarray flowstatsarray;
+  /**
+   * @brief	Decodes flow stats from original bytes, if still pending
+   */
+  void decode() const {
+    if (lazy.is_pending())
+      decode_lazy();
+  };
+
+  /**
+   *
+   */
+  void decode_lazy() const;
+
+private:
+  mutable rofl::openflow::cofflowstatsarray flowstatsarray;
+
+  // original body bytes of a lazily decoded message
+  mutable rofl::openflow::coflazy lazy;
 };
 
 } // end of namespace rofl
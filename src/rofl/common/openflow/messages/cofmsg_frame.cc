@@ -0,0 +1,59 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_frame.h"
+
+using namespace rofl::openflow;
+
+void cofmsg_frame::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen)) {
+    cofmsg::pack(buf, buflen);
+    return;
+  }
+
+  if (buflen < length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  if (not frame.is_null())
+    memcpy(buf, frame.somem(), frame.length());
+
+  /* header with this instance's xid */
+  cofmsg::pack(buf, buflen);
+}
+
+void cofmsg_frame::serialize(cofwriter &writer) {
+  if (frame.is_null()) {
+    cofmsg::serialize(writer);
+    return;
+  }
+
+  size_t start = writer.length();
+  writer.put(frame.somem(), frame.length());
+
+  /* header with this instance's xid */
+  cofmsg::pack(writer.at(start), frame.length());
+}
+
+void cofmsg_frame::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  frame.clear();
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(buf, get_length()));
+  frame = rofl::cslice(chunk, 0, chunk->length());
+}
+
+void cofmsg_frame::unpack_shared(const rofl::cslice &slice) {
+  cofmsg::unpack(slice.somem(), slice.length());
+
+  frame.clear();
+
+  if (slice.empty())
+    return;
+
+  frame = slice.slice(0, get_length());
+}
@@ -0,0 +1,118 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_frame.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef COFMSG_FRAME_H_
+#define COFMSG_FRAME_H_ 1
+
+#include "rofl/common/cslice.hpp"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	Undecoded wire frame shared with a receive buffer
+ *
+ * A cofmsg_frame refers to a complete message received on some socket
+ * without decoding or copying its body. pack() copies the frame into the
+ * transmission buffer and rewrites the common header with this instance's
+ * version, type, length and xid, so frames may be relayed to another
+ * socket with a translated xid. The receive buffer stays alive until
+ * all frames referring to it have been destroyed.
+ */
+class cofmsg_frame : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_frame(){};
+
+  /**
+   *
+   */
+  cofmsg_frame(){};
+
+  /**
+   * @brief	Refers to frame, header fields are parsed from frame
+   */
+  cofmsg_frame(const rofl::cslice &frame) { unpack_shared(frame); };
+
+  /**
+   *
+   */
+  cofmsg_frame(const cofmsg_frame &msg) { *this = msg; };
+
+  /**
+   *
+   */
+  cofmsg_frame &operator=(const cofmsg_frame &msg) {
+    if (this == &msg)
+      return *this;
+    cofmsg::operator=(msg);
+    frame = msg.frame;
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const {
+    return frame.is_null() ? cofmsg::length() : frame.length();
+  };
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   * @brief	Appends frame to writer with this instance's header
+   */
+  virtual void serialize(cofwriter &writer);
+
+  /**
+   * @brief	Copies message from buf into a chunk of its own
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+  /**
+   * @brief	Refers to message in slice without copying
+   */
+  virtual void unpack_shared(const rofl::cslice &slice);
+
+public:
+  /**
+   * @brief	Returns view of the frame as received
+   */
+  const rofl::cslice &get_frame() const { return frame; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cofmsg_frame &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_frame length: " << msg.length() << " >" << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Frame- "
+       << "{length: " << length() << "} ";
+    return ss.str();
+  };
+
+private:
+  rofl::cslice frame;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* COFMSG_FRAME_H_ */
@@ -26,6 +26,12 @@ void cofmsg_group_mod::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofmsg_group_mod::serialize(cofwriter &writer) {
+  size_t start = serialize_header(writer);
+  groupmod.serialize(writer);
+  serialize_length(writer, start);
+}
+
 void cofmsg_group_mod::unpack(uint8_t *buf, size_t buflen) {
   cofmsg::unpack(buf, buflen);
 
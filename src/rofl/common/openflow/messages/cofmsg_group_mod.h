@@ -69,6 +69,11 @@ public:
    */
   virtual void pack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Appends this message to writer in a single pass
+   */
+  virtual void serialize(cofwriter &writer);
+
   /**
    *
    */
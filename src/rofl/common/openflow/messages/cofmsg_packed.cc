@@ -0,0 +1,171 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_packed.h"
+
+#include <vector>
+
+#include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_group_desc_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_group_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_config_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_port_desc_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_port_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_table_stats.h"
+
+using namespace rofl::openflow;
+
+void cofmsg_packed::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen)) {
+    cofmsg::pack(buf, buflen);
+    return;
+  }
+
+  if (buflen < length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  memcpy(buf, mem.somem(), mem.length());
+
+  /* header with this instance's xid */
+  cofmsg::pack(buf, buflen);
+}
+
+void cofmsg_packed::unpack(uint8_t *buf, size_t buflen) {
+  cofmsg::unpack(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  mem.unpack(buf, buflen);
+}
+
+template <typename E, typename F>
+void cofmsg_segmenter::pack_entries(cofmsg_stats_reply &msg,
+                                    const std::list<uint32_t> &keys, F entry,
+                                    std::list<cofmsg_packed *> &segments) {
+  /* multipart header without body, its length depends on the version */
+  cofmsg_stats_reply hdr(msg.get_version(), msg.get_xid(),
+                         msg.get_stats_type(), msg.get_stats_flags());
+  size_t hdrlen = hdr.length();
+  size_t maxlen = std::min(threshold, (size_t)UINT16_MAX);
+
+  std::list<cofmsg_packed *> packed;
+  std::vector<std::pair<E *, size_t>> batch;
+  std::list<uint32_t>::const_iterator it = keys.begin();
+  do {
+    /* collect entries fitting into the next segment */
+    size_t seglen = hdrlen;
+    batch.clear();
+    while (it != keys.end()) {
+      E &e = entry(*it);
+      size_t len = e.length();
+      if ((hdrlen + len) > UINT16_MAX) {
+        for (auto segment : packed)
+          delete segment;
+        throw eInvalid("cofmsg_segmenter::segment() entry too large",
+                       __FILE__, __FUNCTION__, __LINE__);
+      }
+      if ((not batch.empty()) && ((seglen + len) > maxlen))
+        break;
+      batch.push_back(std::make_pair(&e, len));
+      seglen += len;
+      ++it;
+    }
+
+    if (it != keys.end()) {
+      hdr.set_stats_flags(msg.get_stats_flags() |
+                          rofl::openflow13::OFPMPF_REPLY_MORE);
+    } else {
+      hdr.set_stats_flags(msg.get_stats_flags());
+    }
+
+    cofmsg_packed *segment = new cofmsg_packed(
+        msg.get_version(), msg.get_type(), msg.get_xid(), seglen);
+    hdr.pack(segment->somem(), hdrlen);
+    size_t offset = hdrlen;
+    for (auto &e : batch) {
+      e.first->pack(segment->somem() + offset, e.second);
+      offset += e.second;
+    }
+    packed.push_back(segment);
+
+    entries_packed += batch.size();
+    bytes_packed += seglen;
+    segments_packed++;
+  } while (it != keys.end());
+
+  segments.splice(segments.end(), packed);
+}
+
+bool cofmsg_segmenter::segment(cofmsg_stats_reply &msg,
+                               std::list<cofmsg_packed *> &segments) {
+  if (cofmsg_flow_stats_reply *m =
+          dynamic_cast<cofmsg_flow_stats_reply *>(&msg)) {
+    cofflowstatsarray &array = m->set_flow_stats_array();
+    pack_entries<cofflow_stats_reply>(
+        msg, array.keys(), [&](uint32_t id) -> cofflow_stats_reply & {
+          return array.set_flow_stats(id);
+        },
+        segments);
+  } else if (cofmsg_port_stats_reply *m =
+                 dynamic_cast<cofmsg_port_stats_reply *>(&msg)) {
+    cofportstatsarray &array = m->set_port_stats_array();
+    pack_entries<cofport_stats_reply>(
+        msg, array.keys(), [&](uint32_t id) -> cofport_stats_reply & {
+          return array.set_port_stats(id);
+        },
+        segments);
+  } else if (cofmsg_table_stats_reply *m =
+                 dynamic_cast<cofmsg_table_stats_reply *>(&msg)) {
+    coftablestatsarray &array = m->set_table_stats_array();
+    pack_entries<coftable_stats_reply>(
+        msg, array.keys(), [&](uint32_t id) -> coftable_stats_reply & {
+          return array.set_table_stats(id);
+        },
+        segments);
+  } else if (cofmsg_group_stats_reply *m =
+                 dynamic_cast<cofmsg_group_stats_reply *>(&msg)) {
+    cofgroupstatsarray &array = m->set_group_stats_array();
+    pack_entries<cofgroup_stats_reply>(
+        msg, array.keys(), [&](uint32_t id) -> cofgroup_stats_reply & {
+          return array.set_group_stats(id);
+        },
+        segments);
+  } else if (cofmsg_group_desc_stats_reply *m =
+                 dynamic_cast<cofmsg_group_desc_stats_reply *>(&msg)) {
+    cofgroupdescstatsarray &array = m->set_group_desc_stats_array();
+    pack_entries<cofgroup_desc_stats_reply>(
+        msg, array.keys(), [&](uint32_t id) -> cofgroup_desc_stats_reply & {
+          return array.set_group_desc_stats(id);
+        },
+        segments);
+  } else if (cofmsg_meter_stats_reply *m =
+                 dynamic_cast<cofmsg_meter_stats_reply *>(&msg)) {
+    cofmeterstatsarray &array = m->set_meter_stats_array();
+    pack_entries<cofmeter_stats_reply>(
+        msg, array.keys(), [&](uint32_t id) -> cofmeter_stats_reply & {
+          return array.set_meter_stats(id);
+        },
+        segments);
+  } else if (cofmsg_meter_config_stats_reply *m =
+                 dynamic_cast<cofmsg_meter_config_stats_reply *>(&msg)) {
+    cofmeterconfigarray &array = m->set_meter_config_array();
+    pack_entries<cofmeter_config_reply>(
+        msg, array.keys(), [&](uint32_t id) -> cofmeter_config_reply & {
+          return array.set_meter_config(id);
+        },
+        segments);
+  } else if (cofmsg_port_desc_stats_reply *m =
+                 dynamic_cast<cofmsg_port_desc_stats_reply *>(&msg)) {
+    cofports &ports = m->set_ports();
+    pack_entries<cofport>(
+        msg, ports.keys(),
+        [&](uint32_t id) -> cofport & { return ports.set_port(id); },
+        segments);
+  } else {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,191 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_packed.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef COFMSG_PACKED_H_
+#define COFMSG_PACKED_H_ 1
+
+#include <atomic>
+#include <list>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+#include "rofl/common/openflow/messages/cofmsg_stats.h"
+
+namespace rofl {
+namespace openflow {
+
+/**
+ * @brief	Message packed into wire format beforehand
+ *
+ * pack() copies the wire image into the transmission buffer and rewrites
+ * the common header with this instance's version, type, length and xid.
+ */
+class cofmsg_packed : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_packed(){};
+
+  /**
+   * @brief	Creates a zeroed wire image of len bytes
+   */
+  cofmsg_packed(uint8_t version = 0, uint8_t type = 0, uint32_t xid = 0,
+                size_t len = sizeof(struct rofl::openflow::ofp_header))
+      : cofmsg(version, type, xid), mem(len){};
+
+  /**
+   *
+   */
+  cofmsg_packed(const cofmsg_packed &msg) { *this = msg; };
+
+  /**
+   *
+   */
+  cofmsg_packed &operator=(const cofmsg_packed &msg) {
+    if (this == &msg)
+      return *this;
+    cofmsg::operator=(msg);
+    mem = msg.mem;
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const { return mem.length(); };
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+  /**
+   *
+   */
+  virtual void unpack(uint8_t *buf, size_t buflen);
+
+public:
+  /**
+   * @brief	Returns start of wire image for packing its body in place
+   */
+  uint8_t *somem() { return mem.somem(); };
+
+  /**
+   *
+   */
+  const rofl::cmemory &get_wire() const { return mem; };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os, const cofmsg_packed &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_packed length: " << msg.length() << " >" << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Packed- "
+       << "{length: " << length() << "} ";
+    return ss.str();
+  };
+
+private:
+  rofl::cmemory mem;
+};
+
+/**
+ * @brief	Splits multipart replies into pre-packed segments
+ *
+ * The entry array of a reply is walked once and each entry is packed
+ * directly into the wire image of its segment, no intermediate arrays
+ * are built. The counters record how many entries and bytes were packed
+ * and how many segments were created since the last clear_counters().
+ */
+class cofmsg_segmenter {
+public:
+  /**
+   *
+   */
+  ~cofmsg_segmenter(){};
+
+  /**
+   * @brief	Segments are limited to threshold bytes including headers
+   */
+  cofmsg_segmenter(size_t threshold = 65535)
+      : threshold(threshold), entries_packed(0), bytes_packed(0),
+        segments_packed(0){};
+
+public:
+  /**
+   * @brief	Packs the entries of msg into segments appended to segments
+   *
+   * All segments except the last one carry the REPLY_MORE flag. Returns
+   * false without creating any segment if entries of msg's multipart type
+   * cannot be packed directly. The caller remains owner of msg and takes
+   * ownership of the segments. Throws eInvalid for a single entry
+   * exceeding the maximum OpenFlow message length.
+   */
+  bool segment(cofmsg_stats_reply &msg, std::list<cofmsg_packed *> &segments);
+
+public:
+  /**
+   *
+   */
+  size_t get_threshold() const { return threshold; };
+
+  /**
+   *
+   */
+  uint64_t get_entries_packed() const { return entries_packed; };
+
+  /**
+   *
+   */
+  uint64_t get_bytes_packed() const { return bytes_packed; };
+
+  /**
+   *
+   */
+  uint64_t get_segments_packed() const { return segments_packed; };
+
+  /**
+   *
+   */
+  void clear_counters() {
+    entries_packed = 0;
+    bytes_packed = 0;
+    segments_packed = 0;
+  };
+
+private:
+  template <typename E, typename F>
+  void pack_entries(cofmsg_stats_reply &msg, const std::list<uint32_t> &keys,
+                    F entry, std::list<cofmsg_packed *> &segments);
+
+private:
+  // maximum segment length in bytes
+  size_t threshold;
+
+  // entries packed into segments
+  std::atomic<uint64_t> entries_packed;
+
+  // bytes written into segments
+  std::atomic<uint64_t> bytes_packed;
+
+  // segments created
+  std::atomic<uint64_t> segments_packed;
+};
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* COFMSG_PACKED_H_ */
@@ -23,12 +23,12 @@ size_t cofmsg_packet_in::length() const {
 
   } break;
   case rofl::openflow12::OFP_VERSION: {
-    return (OFP12_PACKET_IN_STATIC_HDR_LEN + match.length() +
+    return (OFP12_PACKET_IN_STATIC_HDR_LEN + match_length() +
             2 /* bytes padding */
             + packet.length());
   } break;
   default: {
-    return (OFP13_PACKET_IN_STATIC_HDR_LEN + match.length() +
+    return (OFP13_PACKET_IN_STATIC_HDR_LEN + match_length() +
             2 /* bytes padding */
             + packet.length());
   };
@@ -71,12 +71,12 @@ void cofmsg_packet_in::pack(uint8_t *buf, size_t buflen) {
     hdr->reason = reason;
     hdr->table_id = table_id;
 
-    match.pack((buf + rofl::openflow12::OFP_PACKET_IN_STATIC_HDR_LEN),
-               match.length());
+    pack_match((buf + rofl::openflow12::OFP_PACKET_IN_STATIC_HDR_LEN),
+               match_length());
 
     if (not packet.empty()) {
       packet.pack(buf + rofl::openflow12::OFP_PACKET_IN_STATIC_HDR_LEN +
-                      match.length() + 2,
+                      match_length() + 2,
                   packet.length());
     }
 
@@ -92,12 +92,12 @@ void cofmsg_packet_in::pack(uint8_t *buf, size_t buflen) {
     hdr->table_id = table_id;
     hdr->cookie = htobe64(cookie);
 
-    match.pack((buf + rofl::openflow13::OFP_PACKET_IN_STATIC_HDR_LEN),
-               match.length());
+    pack_match((buf + rofl::openflow13::OFP_PACKET_IN_STATIC_HDR_LEN),
+               match_length());
 
     if (not packet.empty()) {
       packet.pack(buf + rofl::openflow13::OFP_PACKET_IN_STATIC_HDR_LEN +
-                      match.length() + 2,
+                      match_length() + 2,
                   packet.length());
     }
   };
@@ -105,14 +105,56 @@ void cofmsg_packet_in::pack(uint8_t *buf, size_t buflen) {
 }
 
 void cofmsg_packet_in::unpack(uint8_t *buf, size_t buflen) {
+  size_t offset = unpack_header(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  packet.unpack(buf + offset, buflen - offset);
+}
+
+void cofmsg_packet_in::unpack_shared(const rofl::cslice &slice) {
+  size_t offset = unpack_header(slice.somem(), slice.length());
+
+  if (slice.empty())
+    return;
+
+  /* payload refers to slice's buffer, no copy */
+  packet.unpack(slice.slice(offset, slice.length() - offset));
+}
+
+void cofmsg_packet_in::unpack_lazy(const rofl::cslice &slice) {
+  size_t matchlen = 0;
+  size_t offset = unpack_header(slice.somem(), slice.length(), &matchlen);
+
+  if (slice.empty())
+    return;
+
+  /* match is followed by 2 bytes padding */
+  if (matchlen > 0) {
+    lazy.assign(slice.slice(offset - 2 - matchlen, matchlen));
+  }
+
+  packet.unpack(slice.slice(offset, slice.length() - offset));
+}
+
+void cofmsg_packet_in::decode_lazy() const {
+  const rofl::cslice &body = lazy.get_body();
+  match.unpack(body.somem(), body.length());
+  lazy.set_decoded();
+}
+
+size_t cofmsg_packet_in::unpack_header(uint8_t *buf, size_t buflen,
+                                       size_t *matchlen) {
   cofmsg::unpack(buf, buflen);
 
   match.clear();
   match.set_version(get_version());
   packet.clear();
+  lazy.release();
 
   if ((0 == buf) || (0 == buflen))
-    return;
+    return 0;
 
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION: {
@@ -137,8 +179,7 @@ void cofmsg_packet_in::unpack(uint8_t *buf, size_t buflen) {
 
     match.set_in_port(in_port);
 
-    packet.unpack(buf + OFP10_PACKET_IN_STATIC_HDR_LEN,
-                  buflen - OFP10_PACKET_IN_STATIC_HDR_LEN);
+    return OFP10_PACKET_IN_STATIC_HDR_LEN;
 
   } break;
   case rofl::openflow12::OFP_VERSION: {
@@ -172,17 +213,27 @@ void cofmsg_packet_in::unpack(uint8_t *buf, size_t buflen) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
 
-    match.unpack((uint8_t *)&(hdr->match), be16toh(hdr->match.length));
+    size_t oxmlen = be16toh(hdr->match.length);
+    if (matchlen) {
+      /* decoding deferred, match is padded to a multiple of 8 bytes */
+      if (oxmlen < 2 * sizeof(uint16_t))
+        throw eBadMatchBadLen("eBadMatchBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+      *matchlen = (oxmlen + 7) & ~((size_t)7);
+    } else {
+      match.unpack((uint8_t *)&(hdr->match), oxmlen);
+    }
 
     /* set data and datalen variables */
-    uint16_t offset =
-        OFP12_PACKET_IN_STATIC_HDR_LEN + match.length() + 2; // +2: magic :)
+    size_t offset = OFP12_PACKET_IN_STATIC_HDR_LEN +
+                    (matchlen ? *matchlen : match.length()) +
+                    2; // +2: magic :)
 
     if (offset > buflen)
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
 
-    packet.unpack((uint8_t *)(buf + offset), buflen - offset);
+    return offset;
 
   } break;
   default: {
@@ -216,17 +267,28 @@ void cofmsg_packet_in::unpack(uint8_t *buf, size_t buflen) {
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
 
-    match.unpack((uint8_t *)&(hdr->match), be16toh(hdr->match.length));
+    size_t oxmlen = be16toh(hdr->match.length);
+    if (matchlen) {
+      /* decoding deferred, match is padded to a multiple of 8 bytes */
+      if (oxmlen < 2 * sizeof(uint16_t))
+        throw eBadMatchBadLen("eBadMatchBadLen", __FILE__, __FUNCTION__,
+                              __LINE__);
+      *matchlen = (oxmlen + 7) & ~((size_t)7);
+    } else {
+      match.unpack((uint8_t *)&(hdr->match), oxmlen);
+    }
 
     /* set data and datalen variables */
-    uint16_t offset =
-        OFP13_PACKET_IN_STATIC_HDR_LEN + match.length() + 2; // +2: magic :)
+    size_t offset = OFP13_PACKET_IN_STATIC_HDR_LEN +
+                    (matchlen ? *matchlen : match.length()) +
+                    2; // +2: magic :)
 
     if (offset > buflen)
       throw eBadRequestBadLen("eBadRequestBadLen", __FILE__, __FUNCTION__,
                               __LINE__);
 
-    packet.unpack((uint8_t *)(buf + offset), buflen - offset);
+    return offset;
   };
   }
+  return buflen;
 }
@@ -9,6 +9,7 @@
 #define COFMSG_PACKET_IN_H_ 1
 
 #include "rofl/common/cpacket.h"
+#include "rofl/common/openflow/coflazy.h"
 #include "rofl/common/openflow/cofmatch.h"
 #include "rofl/common/openflow/messages/cofmsg.h"
 
@@ -61,6 +62,7 @@ public:
     cookie = msg.cookie;
     match = msg.match;
     packet = msg.packet;
+    lazy = msg.lazy;
     return *this;
   };
 
@@ -80,6 +82,16 @@ public:
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Parses message, payload refers to slice without copying
+   */
+  virtual void unpack_shared(const rofl::cslice &slice);
+
+  /**
+   * @brief	Parses message, match is decoded on first access
+   */
+  virtual void unpack_lazy(const rofl::cslice &slice);
+
 public:
   /**
    *
@@ -144,12 +156,19 @@ public:
   /**
    *
    */
-  const rofl::openflow::cofmatch &get_match() const { return match; };
+  const rofl::openflow::cofmatch &get_match() const {
+    decode();
+    return match;
+  };
 
   /**
-   *
+   * @brief	Returns match for modification, original bytes are dropped
    */
-  rofl::openflow::cofmatch &set_match() { return match; };
+  rofl::openflow::cofmatch &set_match() {
+    decode();
+    lazy.release();
+    return match;
+  };
 
   /**
    *
@@ -161,6 +180,46 @@ public:
    */
   rofl::cpacket &set_packet() { return packet; };
 
+private:
+  /**
+   * @brief	Parses header fields and returns offset of packet payload
+   *
+   * @param matchlen if not NULL, match is not decoded and its padded
+   * length is stored in matchlen
+   */
+  size_t unpack_header(uint8_t *buf, size_t buflen, size_t *matchlen = 0);
+
+  /**
+   * @brief	Returns length of match in packed state
+   */
+  size_t match_length() const {
+    return lazy.has_body() ? lazy.length() : match.length();
+  };
+
+  /**
+   * @brief	Packs match, original bytes are copied if unmodified
+   */
+  void pack_match(uint8_t *buf, size_t buflen) {
+    if (lazy.has_body()) {
+      lazy.pack(buf, buflen);
+    } else {
+      match.pack(buf, buflen);
+    }
+  };
+
+  /**
+   * @brief	Decodes match from original bytes, if still pending
+   */
+  void decode() const {
+    if (lazy.is_pending())
+      decode_lazy();
+  };
+
+  /**
+   *
+   */
+  void decode_lazy() const;
+
 private:
   /**
    *
@@ -182,7 +241,8 @@ private:
       if (rofl::openflow12::OFPR_INVALID_TTL == get_reason())
         ss.append("invalid ttl ");
     } break;
-    case rofl::openflow13::OFP_VERSION: {
+    case rofl::openflow13::OFP_VERSION:
+    case rofl::openflow14::OFP_VERSION: {
       if (rofl::openflow13::OFPR_NO_MATCH == get_reason())
         ss.append("no match ");
       if (rofl::openflow13::OFPR_ACTION == get_reason())
@@ -227,7 +287,8 @@ public:
       os << "<table-id:" << (int)msg.get_table_id() << " >" << std::endl;
 
     } break;
-    case openflow13::OFP_VERSION: {
+    case openflow13::OFP_VERSION:
+    case openflow14::OFP_VERSION: {
       os << "<buffer-id:" << (int)msg.get_buffer_id() << " >" << std::endl;
       os << "<total-len:" << (int)msg.get_total_len() << " >" << std::endl;
       os << "<reason:" << msg.s_reason() << " >" << std::endl;
@@ -241,7 +302,7 @@ public:
          << std::endl;
     } break;
     }
-    os << msg.match;
+    os << msg.get_match();
     os << msg.packet;
     return os;
   };
@@ -267,9 +328,12 @@ private:
   uint8_t reason;
   uint8_t table_id; // since OFP 1.2
   uint64_t cookie;  // since OFP 1.3
-  rofl::openflow::cofmatch match;
+  mutable rofl::openflow::cofmatch match;
   rofl::cpacket packet;
 
+  // original match bytes of a lazily decoded message
+  mutable rofl::openflow::coflazy lazy;
+
   static const size_t OFP10_PACKET_IN_STATIC_HDR_LEN;
   static const size_t OFP12_PACKET_IN_STATIC_HDR_LEN;
   static const size_t OFP13_PACKET_IN_STATIC_HDR_LEN;
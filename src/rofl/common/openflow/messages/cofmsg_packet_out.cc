@@ -67,7 +67,58 @@ void cofmsg_packet_out::pack(uint8_t *buf, size_t buflen) {
   }
 }
 
+void cofmsg_packet_out::serialize(cofwriter &writer) {
+  size_t start = serialize_header(writer);
+  size_t actions_len_offset = 0;
+
+  switch (get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    writer.put32(buffer_id);
+    writer.put16(in_port & 0x0000ffff);
+    actions_len_offset = writer.length();
+    writer.put16(0);
+  } break;
+  default: {
+    writer.put32(buffer_id);
+    writer.put32(in_port);
+    actions_len_offset = writer.length();
+    writer.put16(0);
+    writer.reserve(6);
+  };
+  }
+
+  size_t actions_start = writer.length();
+  actions.serialize(writer);
+  writer.patch_length16(actions_len_offset, actions_start);
+
+  if (not packet.empty()) {
+    size_t offset = writer.reserve(packet.length());
+    packet.pack(writer.at(offset), packet.length());
+  }
+
+  serialize_length(writer, start);
+}
+
 void cofmsg_packet_out::unpack(uint8_t *buf, size_t buflen) {
+  size_t offset = unpack_header(buf, buflen);
+
+  if ((0 == buf) || (0 == buflen))
+    return;
+
+  packet.unpack(buf + offset, buflen - offset);
+}
+
+void cofmsg_packet_out::unpack_shared(const rofl::cslice &slice) {
+  size_t offset = unpack_header(slice.somem(), slice.length());
+
+  if (slice.empty())
+    return;
+
+  /* payload refers to slice's buffer, no copy */
+  packet.unpack(slice.slice(offset, slice.length() - offset));
+}
+
+size_t cofmsg_packet_out::unpack_header(uint8_t *buf, size_t buflen) {
   cofmsg::unpack(buf, buflen);
 
   actions.clear();
@@ -75,7 +126,7 @@ void cofmsg_packet_out::unpack(uint8_t *buf, size_t buflen) {
   packet.clear();
 
   if ((0 == buf) || (0 == buflen))
-    return;
+    return 0;
 
   switch (get_version()) {
   case rofl::openflow10::OFP_VERSION: {
@@ -104,7 +155,7 @@ void cofmsg_packet_out::unpack(uint8_t *buf, size_t buflen) {
 
     actions.unpack((uint8_t *)hdr->actions, actions_len);
 
-    packet.unpack(buf + packet_offset, buflen - packet_offset);
+    return packet_offset;
 
   } break;
   default: {
@@ -133,7 +184,8 @@ void cofmsg_packet_out::unpack(uint8_t *buf, size_t buflen) {
 
     actions.unpack((uint8_t *)hdr->actions, actions_len);
 
-    packet.unpack(buf + packet_offset, buflen - packet_offset);
+    return packet_offset;
   };
   }
+  return buflen;
 }
@@ -67,11 +67,21 @@ public:
    */
   virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
 
+  /**
+   * @brief	Appends this message to writer in a single pass
+   */
+  virtual void serialize(cofwriter &writer);
+
   /**
    *
    */
   virtual void unpack(uint8_t *buf, size_t buflen);
 
+  /**
+   * @brief	Parses message, payload refers to slice without copying
+   */
+  virtual void unpack_shared(const rofl::cslice &slice);
+
 public:
   /**
    *
@@ -137,6 +147,12 @@ public:
     return ss.str();
   };
 
+private:
+  /**
+   * @brief	Parses header fields and returns offset of packet payload
+   */
+  size_t unpack_header(uint8_t *buf, size_t buflen);
+
 private:
   uint32_t buffer_id;
   uint32_t in_port;
@@ -33,7 +33,8 @@ operator=(const cofmsg_table_features_stats_request &msg) {
 
 size_t cofmsg_table_features_stats_request::length() const {
   switch (get_version()) {
-  case openflow13::OFP_VERSION: {
+  case openflow13::OFP_VERSION:
+  case openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_request) +
             tables.length());
   } break;
@@ -121,7 +122,8 @@ operator=(const cofmsg_table_features_stats_reply &msg) {
 
 size_t cofmsg_table_features_stats_reply::length() const {
   switch (get_version()) {
-  case rofl::openflow13::OFP_VERSION: {
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION: {
     return (sizeof(struct rofl::openflow13::ofp_multipart_request) +
             tables.length());
   } break;
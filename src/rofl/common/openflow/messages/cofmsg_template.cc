@@ -0,0 +1,262 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "rofl/common/openflow/messages/cofmsg_template.h"
+
+#include <stddef.h>
+
+using namespace rofl::openflow;
+
+cofmsg_template::cofmsg_template(cofmsg &msg)
+    : wire(new cwire(msg.length())) {
+  msg.pack(wire->mem.somem(), wire->mem.length());
+
+  switch (msg.get_version()) {
+  case rofl::openflow10::OFP_VERSION:
+  case rofl::openflow12::OFP_VERSION:
+  case rofl::openflow13::OFP_VERSION:
+  case rofl::openflow14::OFP_VERSION:
+    break;
+  default:
+    throw eBadVersion("eBadVersion", __FILE__, __FUNCTION__, __LINE__);
+  }
+
+  switch (msg.get_type()) {
+  case rofl::openflow::OFPT_FLOW_MOD: {
+    compile_flow_mod();
+  } break;
+  case rofl::openflow::OFPT_PACKET_OUT: {
+    compile_packet_out();
+  } break;
+  default:
+    throw eInvalid("cofmsg_template() unsupported message type", __FILE__,
+                   __FUNCTION__, __LINE__);
+  }
+}
+
+void cofmsg_template::pack(uint8_t *buf, size_t buflen, uint32_t mask,
+                           const uint64_t *values) const {
+  if (buflen < length())
+    throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+  memcpy(buf, wire->mem.somem(), wire->mem.length());
+
+  for (unsigned int i = 0; mask != 0; i++, mask >>= 1) {
+    if (not(mask & 1))
+      continue;
+    /* values are right aligned in a big endian 64bit word */
+    uint64_t value = htobe64(values[i]);
+    memcpy(buf + wire->offset[i],
+           (uint8_t *)&value + sizeof(value) - wire->width[i],
+           wire->width[i]);
+  }
+}
+
+void cofmsg_template::compile_flow_mod() {
+  size_t msglen = wire->mem.length();
+
+  switch (get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    if (msglen < sizeof(struct rofl::openflow10::ofp_flow_mod))
+      throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow10::ofp_flow_mod *hdr =
+        (struct rofl::openflow10::ofp_flow_mod *)wire->mem.somem();
+    size_t match = offsetof(struct rofl::openflow10::ofp_flow_mod, match);
+    uint32_t wildcards = be32toh(hdr->match.wildcards);
+
+    if (not(wildcards & rofl::openflow10::OFPFW_IN_PORT))
+      set_field(FIELD_IN_PORT,
+                match + offsetof(struct rofl::openflow10::ofp_match, in_port),
+                sizeof(uint16_t));
+    if (not(wildcards & rofl::openflow10::OFPFW_DL_SRC))
+      set_field(FIELD_ETH_SRC,
+                match + offsetof(struct rofl::openflow10::ofp_match, dl_src),
+                OFP_ETH_ALEN);
+    if (not(wildcards & rofl::openflow10::OFPFW_DL_DST))
+      set_field(FIELD_ETH_DST,
+                match + offsetof(struct rofl::openflow10::ofp_match, dl_dst),
+                OFP_ETH_ALEN);
+
+    set_field(FIELD_COOKIE,
+              offsetof(struct rofl::openflow10::ofp_flow_mod, cookie),
+              sizeof(uint64_t));
+    set_field(FIELD_HARD_TIMEOUT,
+              offsetof(struct rofl::openflow10::ofp_flow_mod, hard_timeout),
+              sizeof(uint16_t));
+    set_field(FIELD_BUFFER_ID,
+              offsetof(struct rofl::openflow10::ofp_flow_mod, buffer_id),
+              sizeof(uint32_t));
+
+    compile_actions(sizeof(struct rofl::openflow10::ofp_flow_mod), msglen);
+
+  } break;
+  default: {
+    /* OpenFlow 1.2, 1.3 and 1.4 share the Flow-Mod layout */
+    if (msglen < sizeof(struct rofl::openflow13::ofp_flow_mod))
+      throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow13::ofp_flow_mod *hdr =
+        (struct rofl::openflow13::ofp_flow_mod *)wire->mem.somem();
+    size_t match = offsetof(struct rofl::openflow13::ofp_flow_mod, match);
+    size_t matchlen = be16toh(hdr->match.length);
+
+    set_field(FIELD_COOKIE,
+              offsetof(struct rofl::openflow13::ofp_flow_mod, cookie),
+              sizeof(uint64_t));
+    set_field(FIELD_HARD_TIMEOUT,
+              offsetof(struct rofl::openflow13::ofp_flow_mod, hard_timeout),
+              sizeof(uint16_t));
+    set_field(FIELD_BUFFER_ID,
+              offsetof(struct rofl::openflow13::ofp_flow_mod, buffer_id),
+              sizeof(uint32_t));
+
+    compile_match(match + rofl::openflow13::OFP_MATCH_STATIC_LEN,
+                  std::min(match + matchlen, msglen));
+
+    /* instructions follow the match padded to a multiple of 8 bytes */
+    size_t offset = match + ((matchlen + 7) / 8) * 8;
+    while ((offset + sizeof(struct rofl::openflow13::ofp_instruction)) <=
+           msglen) {
+      struct rofl::openflow13::ofp_instruction *inst =
+          (struct rofl::openflow13::ofp_instruction *)(wire->mem.somem() +
+                                                        offset);
+      size_t instlen = be16toh(inst->len);
+      if ((instlen < sizeof(struct rofl::openflow13::ofp_instruction)) ||
+          ((offset + instlen) > msglen))
+        break;
+      switch (be16toh(inst->type)) {
+      case rofl::openflow13::OFPIT_APPLY_ACTIONS:
+      case rofl::openflow13::OFPIT_WRITE_ACTIONS: {
+        compile_actions(
+            offset + sizeof(struct rofl::openflow13::ofp_instruction_actions),
+            offset + instlen);
+      } break;
+      default: {};
+      }
+      offset += instlen;
+    }
+
+  };
+  }
+}
+
+void cofmsg_template::compile_packet_out() {
+  size_t msglen = wire->mem.length();
+
+  switch (get_version()) {
+  case rofl::openflow10::OFP_VERSION: {
+    if (msglen < sizeof(struct rofl::openflow10::ofp_packet_out))
+      throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow10::ofp_packet_out *hdr =
+        (struct rofl::openflow10::ofp_packet_out *)wire->mem.somem();
+
+    set_field(FIELD_BUFFER_ID,
+              offsetof(struct rofl::openflow10::ofp_packet_out, buffer_id),
+              sizeof(uint32_t));
+    set_field(FIELD_IN_PORT,
+              offsetof(struct rofl::openflow10::ofp_packet_out, in_port),
+              sizeof(uint16_t));
+
+    size_t offset = sizeof(struct rofl::openflow10::ofp_packet_out);
+    compile_actions(offset,
+                    std::min(offset + be16toh(hdr->actions_len), msglen));
+
+  } break;
+  default: {
+    if (msglen < sizeof(struct rofl::openflow13::ofp_packet_out))
+      throw eInvalid("eInvalid", __FILE__, __FUNCTION__, __LINE__);
+
+    struct rofl::openflow13::ofp_packet_out *hdr =
+        (struct rofl::openflow13::ofp_packet_out *)wire->mem.somem();
+
+    set_field(FIELD_BUFFER_ID,
+              offsetof(struct rofl::openflow13::ofp_packet_out, buffer_id),
+              sizeof(uint32_t));
+    set_field(FIELD_IN_PORT,
+              offsetof(struct rofl::openflow13::ofp_packet_out, in_port),
+              sizeof(uint32_t));
+
+    size_t offset = sizeof(struct rofl::openflow13::ofp_packet_out);
+    compile_actions(offset,
+                    std::min(offset + be16toh(hdr->actions_len), msglen));
+
+  };
+  }
+}
+
+void cofmsg_template::compile_actions(size_t offset, size_t end) {
+  if (has_field(FIELD_OUT_PORT))
+    return;
+
+  /* ofp_action_header and ofp_action_output share type and len in all
+   * versions, only the width of the port number differs */
+  while ((offset + sizeof(struct rofl::openflow::ofp_action)) <= end) {
+    struct rofl::openflow::ofp_action *action =
+        (struct rofl::openflow::ofp_action *)(wire->mem.somem() + offset);
+    size_t actionlen = be16toh(action->len);
+    if ((actionlen < sizeof(struct rofl::openflow::ofp_action)) ||
+        ((offset + actionlen) > end))
+      return;
+
+    if (be16toh(action->type) == rofl::openflow::OFPAT_OUTPUT) {
+      if (get_version() == rofl::openflow10::OFP_VERSION) {
+        set_field(FIELD_OUT_PORT,
+                  offset +
+                      offsetof(struct rofl::openflow10::ofp_action_output,
+                               port),
+                  sizeof(uint16_t));
+      } else {
+        set_field(FIELD_OUT_PORT,
+                  offset +
+                      offsetof(struct rofl::openflow13::ofp_action_output,
+                               port),
+                  sizeof(uint32_t));
+      }
+      return;
+    }
+    offset += actionlen;
+  }
+}
+
+void cofmsg_template::compile_match(size_t offset, size_t end) {
+  while ((offset + sizeof(struct rofl::openflow::ofp_oxm_hdr)) <= end) {
+    struct rofl::openflow::ofp_oxm_hdr *oxm =
+        (struct rofl::openflow::ofp_oxm_hdr *)(wire->mem.somem() + offset);
+    size_t oxmlen = sizeof(struct rofl::openflow::ofp_oxm_hdr) + oxm->oxm_length;
+    if ((offset + oxmlen) > end)
+      return;
+
+    if (be16toh(oxm->oxm_class) == rofl::openflow13::OFPXMC_OPENFLOW_BASIC) {
+      /* value precedes the mask, if any */
+      size_t value = offset + sizeof(struct rofl::openflow::ofp_oxm_hdr);
+      switch (oxm->oxm_field >> 1) {
+      case rofl::openflow13::OFPXMT_OFB_IN_PORT: {
+        set_field(FIELD_IN_PORT, value, sizeof(uint32_t));
+      } break;
+      case rofl::openflow13::OFPXMT_OFB_ETH_DST: {
+        set_field(FIELD_ETH_DST, value, OFP_ETH_ALEN);
+      } break;
+      case rofl::openflow13::OFPXMT_OFB_ETH_SRC: {
+        set_field(FIELD_ETH_SRC, value, OFP_ETH_ALEN);
+      } break;
+      default: {};
+      }
+    }
+    offset += oxmlen;
+  }
+}
+
+void cofmsg_stamped::pack(uint8_t *buf, size_t buflen) {
+  if ((0 == buf) || (0 == buflen)) {
+    cofmsg::pack(buf, buflen);
+    return;
+  }
+
+  tmpl.pack(buf, buflen, mask, values);
+
+  /* header with this instance's xid */
+  cofmsg::pack(buf, buflen);
+}
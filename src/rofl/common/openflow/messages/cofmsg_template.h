@@ -0,0 +1,294 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsg_template.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef COFMSG_TEMPLATE_H_
+#define COFMSG_TEMPLATE_H_ 1
+
+#include <memory>
+
+#include "rofl/common/caddress.h"
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg.h"
+
+namespace rofl {
+namespace openflow {
+
+class cofmsg_stamped;
+
+/**
+ * @brief	Pre-serialized Flow-Mod or Packet-Out message
+ *
+ * The message is packed once into wire format and the byte offsets of
+ * fields varying between instances are recorded. Instances created by
+ * stamp() copy the wire image into the transmission buffer and patch
+ * these offsets, without rebuilding matches, instructions and actions.
+ * Copies of a template share the wire image.
+ */
+class cofmsg_template {
+public:
+  // fields patchable in a stamped instance
+  enum field_t {
+    FIELD_BUFFER_ID = 0,
+    FIELD_IN_PORT = 1,
+    FIELD_OUT_PORT = 2, // port of first output action
+    FIELD_ETH_SRC = 3,
+    FIELD_ETH_DST = 4,
+    FIELD_COOKIE = 5,
+    FIELD_HARD_TIMEOUT = 6,
+    FIELD_MAX = 7,
+  };
+
+public:
+  /**
+   *
+   */
+  ~cofmsg_template(){};
+
+  /**
+   *
+   */
+  cofmsg_template(){};
+
+  /**
+   * @brief	Packs msg and records the offsets of all fields present
+   *
+   * Throws eInvalid for message types other than Flow-Mod and Packet-Out
+   * and eBadVersion for an unknown OpenFlow version.
+   */
+  cofmsg_template(cofmsg &msg);
+
+  /**
+   *
+   */
+  cofmsg_template(const cofmsg_template &tmpl) : wire(tmpl.wire){};
+
+  /**
+   *
+   */
+  cofmsg_template &operator=(const cofmsg_template &tmpl) {
+    if (this == &tmpl)
+      return *this;
+    wire = tmpl.wire;
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  bool empty() const { return (not wire); };
+
+  /**
+   *
+   */
+  uint8_t get_version() const { return (wire ? wire->mem.somem()[0] : 0); };
+
+  /**
+   *
+   */
+  uint8_t get_type() const { return (wire ? wire->mem.somem()[1] : 0); };
+
+  /**
+   *
+   */
+  size_t length() const { return (wire ? wire->mem.length() : 0); };
+
+  /**
+   * @brief	Returns true if field can be patched in stamped instances
+   */
+  bool has_field(field_t field) const {
+    return (wire && (field < FIELD_MAX) && (wire->width[field] > 0));
+  };
+
+  /**
+   * @brief	Returns wire offset of field, only valid if has_field()
+   */
+  size_t get_offset(field_t field) const { return wire->offset[field]; };
+
+  /**
+   * @brief	Returns a new instance with transaction id xid
+   */
+  cofmsg_stamped *stamp(uint32_t xid = 0) const;
+
+  /**
+   * @brief	Copies the wire image to buf and patches all fields in mask
+   */
+  void pack(uint8_t *buf, size_t buflen, uint32_t mask,
+            const uint64_t *values) const;
+
+private:
+  void compile_flow_mod();
+
+  void compile_packet_out();
+
+  void compile_actions(size_t offset, size_t end);
+
+  void compile_match(size_t offset, size_t end);
+
+  void set_field(field_t field, size_t offset, uint8_t width) {
+    wire->offset[field] = offset;
+    wire->width[field] = width;
+  };
+
+private:
+  struct cwire {
+    cwire(size_t len) : mem(len) {
+      for (unsigned int i = 0; i < FIELD_MAX; i++) {
+        offset[i] = 0;
+        width[i] = 0;
+      }
+    };
+    rofl::cmemory mem;
+    uint16_t offset[FIELD_MAX];
+    uint8_t width[FIELD_MAX]; // bytes, 0: not present
+  };
+
+  // wire image shared by all copies and stamped instances
+  std::shared_ptr<cwire> wire;
+};
+
+/**
+ * @brief	Instance of a cofmsg_template
+ *
+ * Stores the values of patched fields only. pack() writes the template's
+ * wire image directly into the transmission buffer.
+ */
+class cofmsg_stamped : public cofmsg {
+public:
+  /**
+   *
+   */
+  virtual ~cofmsg_stamped(){};
+
+  /**
+   *
+   */
+  cofmsg_stamped(const cofmsg_template &tmpl, uint32_t xid = 0)
+      : cofmsg(tmpl.get_version(), tmpl.get_type(), xid), tmpl(tmpl),
+        mask(0){};
+
+  /**
+   *
+   */
+  cofmsg_stamped(const cofmsg_stamped &msg) { *this = msg; };
+
+  /**
+   *
+   */
+  cofmsg_stamped &operator=(const cofmsg_stamped &msg) {
+    if (this == &msg)
+      return *this;
+    cofmsg::operator=(msg);
+    tmpl = msg.tmpl;
+    mask = msg.mask;
+    for (unsigned int i = 0; i < cofmsg_template::FIELD_MAX; i++) {
+      values[i] = msg.values[i];
+    }
+    return *this;
+  };
+
+public:
+  /**
+   *
+   */
+  virtual size_t length() const { return tmpl.length(); };
+
+  /**
+   *
+   */
+  virtual void pack(uint8_t *buf = (uint8_t *)0, size_t buflen = 0);
+
+public:
+  /**
+   *
+   */
+  const cofmsg_template &get_template() const { return tmpl; };
+
+  /**
+   * @brief	Sets field to value in host byte order
+   *
+   * Values are truncated to the field's wire width, e.g. port numbers
+   * in OpenFlow 1.0 messages. Throws eInvalid if the template lacks
+   * the field.
+   */
+  cofmsg_stamped &set_field(cofmsg_template::field_t field, uint64_t value) {
+    if (not tmpl.has_field(field))
+      throw eInvalid("cofmsg_stamped::set_field() field not in template",
+                     __FILE__, __FUNCTION__, __LINE__);
+    values[field] = value;
+    mask |= (1 << field);
+    return *this;
+  };
+
+  /**
+   *
+   */
+  cofmsg_stamped &set_eth_src(const rofl::caddress_ll &addr) {
+    return set_field(cofmsg_template::FIELD_ETH_SRC, addr.get_mac());
+  };
+
+  /**
+   *
+   */
+  cofmsg_stamped &set_eth_dst(const rofl::caddress_ll &addr) {
+    return set_field(cofmsg_template::FIELD_ETH_DST, addr.get_mac());
+  };
+
+  /**
+   *
+   */
+  cofmsg_stamped &set_out_port(uint32_t port_no) {
+    return set_field(cofmsg_template::FIELD_OUT_PORT, port_no);
+  };
+
+  /**
+   *
+   */
+  cofmsg_stamped &set_in_port(uint32_t port_no) {
+    return set_field(cofmsg_template::FIELD_IN_PORT, port_no);
+  };
+
+  /**
+   *
+   */
+  cofmsg_stamped &set_buffer_id(uint32_t buffer_id) {
+    return set_field(cofmsg_template::FIELD_BUFFER_ID, buffer_id);
+  };
+
+public:
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const cofmsg_stamped &msg) {
+    os << dynamic_cast<const cofmsg &>(msg);
+    os << "<cofmsg_stamped fields: 0x" << std::hex << msg.mask << std::dec
+       << " >" << std::endl;
+    return os;
+  };
+
+  std::string str() const {
+    std::stringstream ss;
+    ss << cofmsg::str() << "-Stamped- "
+       << "{fields: 0x" << std::hex << mask << std::dec << "} ";
+    return ss.str();
+  };
+
+private:
+  cofmsg_template tmpl;
+  uint32_t mask;
+  uint64_t values[cofmsg_template::FIELD_MAX];
+};
+
+inline cofmsg_stamped *cofmsg_template::stamp(uint32_t xid) const {
+  return new cofmsg_stamped(*this, xid);
+}
+
+}; // end of namespace openflow
+}; // end of namespace rofl
+
+#endif /* COFMSG_TEMPLATE_H_ */
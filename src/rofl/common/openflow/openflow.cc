@@ -21,6 +21,9 @@ uint32_t base::get_ofp_no_buffer(uint8_t ofp_version) {
   case rofl::openflow13::OFP_VERSION:
     return rofl::openflow13::OFP_NO_BUFFER;
     break;
+  case rofl::openflow14::OFP_VERSION:
+    return rofl::openflow14::OFP_NO_BUFFER;
+    break;
   default:
     return 0;
   }
@@ -38,6 +41,9 @@ uint32_t base::get_ofpp_flood_port(uint8_t ofp_version) {
   case rofl::openflow13::OFP_VERSION:
     return rofl::openflow13::OFPP_FLOOD;
     break;
+  case rofl::openflow14::OFP_VERSION:
+    return rofl::openflow14::OFPP_FLOOD;
+    break;
   default:
     return 0;
   }
@@ -55,6 +61,9 @@ uint32_t base::get_ofpp_controller_port(uint8_t ofp_version) {
   case rofl::openflow13::OFP_VERSION:
     return rofl::openflow13::OFPP_CONTROLLER;
     break;
+  case rofl::openflow14::OFP_VERSION:
+    return rofl::openflow14::OFPP_CONTROLLER;
+    break;
   default:
     return 0;
   }
@@ -72,6 +81,9 @@ uint8_t base::get_ofptt_all(uint8_t ofp_version) {
   case rofl::openflow13::OFP_VERSION:
     return rofl::openflow13::OFPTT_ALL;
     break;
+  case rofl::openflow14::OFP_VERSION:
+    return rofl::openflow14::OFPTT_ALL;
+    break;
   default:
     return 0;
   }
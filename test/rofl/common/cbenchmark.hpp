@@ -0,0 +1,43 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cbenchmark.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_ROFL_COMMON_CBENCHMARK_HPP_
+#define TEST_ROFL_COMMON_CBENCHMARK_HPP_
+
+#include <time.h>
+
+/**
+ * @brief	Timing helpers shared by the benchmark programs
+ *
+ * Benchmarks are built as noinst_PROGRAMS next to the unit tests of the
+ * class they measure and are not run by make check.
+ */
+class cbenchmark {
+public:
+  /**
+   * @brief	Returns monotonic clock in seconds
+   */
+  static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+  };
+
+  /**
+   * @brief	Returns seconds spent in fn()
+   */
+  template <typename F> static double elapsed(F fn) {
+    double start = now();
+    fn();
+    return now() - start;
+  };
+};
+
+#endif /* TEST_ROFL_COMMON_CBENCHMARK_HPP_ */
@@ -0,0 +1,139 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cenvsbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sched.h>
+
+#include <atomic>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "rofl/common/cbenchmark.hpp"
+#include "rofl/common/cenvs.hpp"
+
+using rofl::cenvs;
+
+namespace {
+
+/* environment dispatching upcalls like crofsock_env and friends */
+class cenv {
+public:
+  static cenvs<cenv> envs;
+
+  static cenv &call_env(cenv *env,
+                        rofl::chazard::guard &&guard = rofl::chazard::guard()) {
+    if (not envs.protect(env, guard)) {
+      throw rofl::eInvalid("cenv::call_env() instance not found");
+    }
+    return *(env);
+  };
+
+  virtual ~cenv() { envs.drop(this); };
+
+  cenv(cenv *next = nullptr) : next(next), count(0) { envs.add(this); };
+
+  virtual void handle_recv() {
+    count++;
+    if (next)
+      call_env(next).handle_recv();
+  };
+
+  cenv *next;
+  uint64_t count;
+};
+
+/*static*/ cenvs<cenv> cenv::envs;
+
+/* previous scheme: global std::set guarded by a process wide crwlock */
+class clegacy {
+public:
+  static std::set<clegacy *> envs;
+  static rofl::crwlock envs_lock;
+
+  static clegacy &call_env(clegacy *env) {
+    rofl::AcquireReadLock lock(envs_lock);
+    if (envs.find(env) == envs.end()) {
+      throw rofl::eInvalid("clegacy::call_env() instance not found");
+    }
+    return *(env);
+  };
+
+  virtual ~clegacy() {
+    rofl::AcquireReadWriteLock lock(envs_lock);
+    envs.erase(this);
+  };
+
+  clegacy(clegacy *next = nullptr) : next(next), count(0) {
+    rofl::AcquireReadWriteLock lock(envs_lock);
+    envs.insert(this);
+  };
+
+  virtual void handle_recv() {
+    count++;
+    if (next)
+      call_env(next).handle_recv();
+  };
+
+  clegacy *next;
+  uint64_t count;
+};
+
+/*static*/ std::set<clegacy *> clegacy::envs;
+/*static*/ rofl::crwlock clegacy::envs_lock;
+
+/* every thread drives a connection of its own, each message crosses four
+ * environments (socket, connection, channel, datapath) */
+template <class T>
+double run_connections(unsigned int num_threads, unsigned int num_msgs) {
+  std::vector<std::thread> threads;
+  std::atomic_uint ready(0);
+  std::atomic_bool go(false);
+
+  for (unsigned int i = 0; i < num_threads; i++) {
+    threads.push_back(std::thread([&]() {
+      T dpt, chan(&dpt), conn(&chan), sock(&conn);
+      ready++;
+      while (not go)
+        sched_yield();
+      for (unsigned int n = 0; n < num_msgs; n++) {
+        T::call_env(&sock).handle_recv();
+      }
+    }));
+  }
+  while (ready < num_threads)
+    sched_yield();
+
+  double elapsed = cbenchmark::elapsed([&]() {
+    go = true;
+    for (auto &t : threads) {
+      t.join();
+    }
+  });
+  return (num_threads * num_msgs) / elapsed;
+}
+
+}; // end of anonymous namespace
+
+int main(int argc, char **argv) {
+  const unsigned int num_msgs = 200000;
+  unsigned int max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+  for (unsigned int n = 1; n <= max_threads; n *= 2) {
+    double legacy = run_connections<clegacy>(n, num_msgs);
+    double hazard = run_connections<cenv>(n, num_msgs);
+    std::cout << "cenvs: connections=" << n
+              << " set+crwlock=" << (unsigned long)(legacy / 1000)
+              << " kmsgs/s cenvs=" << (unsigned long)(hazard / 1000)
+              << " kmsgs/s" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * cenvstest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <thread>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cenvstest.hpp"
+
+using rofl::cenvs;
+using rofl::chazard;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cenvstest);
+
+namespace {
+
+/* environment dispatching upcalls like crofsock_env and friends */
+class cenv {
+public:
+  static cenvs<cenv> envs;
+
+  static cenv &call_env(cenv *env, chazard::guard &&guard = chazard::guard()) {
+    if (not envs.protect(env, guard)) {
+      throw rofl::eInvalid("cenv::call_env() instance not found");
+    }
+    return *(env);
+  };
+
+  virtual ~cenv() { envs.drop(this); };
+
+  cenv(cenv *next = nullptr) : next(next), count(0) { envs.add(this); };
+
+  virtual void handle_recv() {
+    count++;
+    if (next)
+      call_env(next).handle_recv();
+  };
+
+  virtual void handle_closed() { delete this; };
+
+  virtual void handle_wait(std::atomic_int &phase) {
+    phase = 1;
+    while (phase != 2)
+      sched_yield();
+    count++;
+  };
+
+  cenv *next;
+  uint64_t count;
+};
+
+/*static*/ cenvs<cenv> cenv::envs;
+
+}; // end of anonymous namespace
+
+void cenvstest::setUp() {}
+
+void cenvstest::tearDown() {}
+
+void cenvstest::test_add_drop() {
+  size_t size = cenv::envs.size();
+
+  cenv *env1 = new cenv();
+  cenv *env2 = new cenv(env1);
+  CPPUNIT_ASSERT(cenv::envs.size() == size + 2);
+
+  cenv::call_env(env2).handle_recv();
+  CPPUNIT_ASSERT(env1->count == 1);
+  CPPUNIT_ASSERT(env2->count == 1);
+
+  delete env1;
+  CPPUNIT_ASSERT(cenv::envs.size() == size + 1);
+
+  /* upcall into destroyed instance is refused */
+  try {
+    cenv::call_env(env2).handle_recv();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+  CPPUNIT_ASSERT(env2->count == 2);
+
+  delete env2;
+  CPPUNIT_ASSERT(cenv::envs.size() == size);
+}
+
+void cenvstest::test_nested_guards() {
+  cenv env1, env2, env3;
+  std::atomic_bool result(false);
+
+  auto check = [&](const void *ptr) {
+    std::thread t([&]() { result = chazard::is_protected(ptr); });
+    t.join();
+    return (bool)result;
+  };
+
+  {
+    chazard::guard g1, g2, g3;
+    g1.protect(&env1);
+    g2.protect(&env2);
+    g3.protect(&env3);
+
+    /* own hazards are invisible for the calling thread */
+    CPPUNIT_ASSERT(not chazard::is_protected(&env2));
+    CPPUNIT_ASSERT(check(&env1));
+    CPPUNIT_ASSERT(check(&env2));
+    CPPUNIT_ASSERT(check(&env3));
+
+    g3.release();
+    CPPUNIT_ASSERT(not check(&env3));
+    CPPUNIT_ASSERT(check(&env2));
+  }
+  CPPUNIT_ASSERT(not check(&env1));
+  CPPUNIT_ASSERT(not check(&env2));
+
+  /* lookups leave no hazard behind */
+  CPPUNIT_ASSERT(cenv::envs.contains(&env1));
+  CPPUNIT_ASSERT(not check(&env1));
+}
+
+void cenvstest::test_drop_during_upcall() {
+  cenv *env = new cenv();
+  std::atomic_int phase(0);
+
+  std::atomic_bool dropped(false);
+
+  /* upcall in progress on another thread */
+  std::thread t([&]() { cenv::call_env(env).handle_wait(phase); });
+
+  while (phase != 1)
+    sched_yield();
+
+  /* deregistration waits for the running upcall */
+  std::thread d([&]() {
+    cenv::envs.drop(env);
+    dropped = true;
+  });
+  while (cenv::envs.contains(env))
+    sched_yield();
+  try {
+    cenv::call_env(env);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  CPPUNIT_ASSERT(not dropped);
+
+  phase = 2;
+  t.join();
+  d.join();
+  CPPUNIT_ASSERT(dropped);
+  CPPUNIT_ASSERT(env->count == 1);
+  delete env;
+}
+
+void cenvstest::test_drop_own_thread() {
+  size_t size = cenv::envs.size();
+
+  /* environment destroys itself during an upcall */
+  cenv *env = new cenv();
+  cenv::call_env(env).handle_closed();
+  CPPUNIT_ASSERT(cenv::envs.size() == size);
+}
@@ -0,0 +1,34 @@
+/*
+ * cenvstest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CENVS_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CENVS_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cenvs.hpp"
+
+class cenvstest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cenvstest);
+  CPPUNIT_TEST(test_add_drop);
+  CPPUNIT_TEST(test_nested_guards);
+  CPPUNIT_TEST(test_drop_during_upcall);
+  CPPUNIT_TEST(test_drop_own_thread);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void test_add_drop();
+  void test_nested_guards();
+  void test_drop_during_upcall();
+  void test_drop_own_thread();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CENVS_TEST_HPP_ */
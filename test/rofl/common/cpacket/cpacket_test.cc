@@ -34,3 +34,72 @@ void cpacket_test::test_push() {
 }
 
 void cpacket_test::test_pop() {}
+
+void cpacket_test::test_shared() {
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(64));
+  for (unsigned int i = 0; i < 64; i++) {
+    (*chunk)[i] = i;
+  }
+
+  rofl::cpacket p(rofl::cslice(chunk, 16, 32));
+
+  /* frame refers to chunk, no copy */
+  CPPUNIT_ASSERT(p.is_shared());
+  CPPUNIT_ASSERT(p.length() == 32);
+  CPPUNIT_ASSERT(p.soframe() == chunk->somem() + 16);
+  CPPUNIT_ASSERT(chunk.use_count() == 2);
+
+  /* copies share the frame as well */
+  rofl::cpacket pclone(p);
+  CPPUNIT_ASSERT(pclone.is_shared());
+  CPPUNIT_ASSERT(pclone.soframe() == p.soframe());
+  CPPUNIT_ASSERT(chunk.use_count() == 3);
+  CPPUNIT_ASSERT(p == pclone);
+
+  /* length changing operations copy the frame first */
+  p.push(14, 4);
+  CPPUNIT_ASSERT(not p.is_shared());
+  CPPUNIT_ASSERT(p.length() == 36);
+  CPPUNIT_ASSERT(chunk.use_count() == 2);
+  p.pop(14, 4);
+  CPPUNIT_ASSERT(p == pclone);
+  CPPUNIT_ASSERT((*chunk)[16] == 16);
+
+  /* chunk outlives its creator */
+  rofl::cmemory *mem = chunk.get();
+  chunk.reset();
+  CPPUNIT_ASSERT(pclone.soframe() == mem->somem() + 16);
+  CPPUNIT_ASSERT(pclone.soframe()[31] == 47);
+
+  pclone.clear();
+  CPPUNIT_ASSERT(not pclone.is_shared());
+}
+
+void cpacket_test::test_packet_in_shared() {
+  uint8_t data[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01,
+                    0x02, 0x03, 0x04, 0x05, 0x08, 0x00, 0x45, 0x00};
+
+  rofl::openflow::cofmatch match(rofl::openflow13::OFP_VERSION);
+  match.set_in_port(3);
+  rofl::openflow::cofmsg_packet_in msg(rofl::openflow13::OFP_VERSION, 0xa1a2a3a4,
+                                       0xffffffff, sizeof(data),
+                                       rofl::openflow13::OFPR_ACTION, 1, 0, 0,
+                                       match, data, sizeof(data));
+
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(msg.length()));
+  msg.pack(chunk->somem(), chunk->memlen());
+
+  rofl::openflow::cofmsg_packet_in shared;
+  shared.unpack_shared(rofl::cslice(chunk, 0, chunk->memlen()));
+
+  rofl::openflow::cofmsg_packet_in copied;
+  copied.unpack(chunk->somem(), chunk->memlen());
+
+  CPPUNIT_ASSERT(shared.get_packet().is_shared());
+  CPPUNIT_ASSERT(not copied.get_packet().is_shared());
+  CPPUNIT_ASSERT(shared.get_packet().soframe() ==
+                 chunk->somem() + chunk->memlen() - sizeof(data));
+  CPPUNIT_ASSERT(shared.get_packet() == copied.get_packet());
+  CPPUNIT_ASSERT(shared.get_match().get_in_port() == 3);
+  CPPUNIT_ASSERT(shared.length() == msg.length());
+}
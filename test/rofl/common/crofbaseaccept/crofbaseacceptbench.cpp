@@ -0,0 +1,64 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofbaseacceptbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <sys/resource.h>
+
+#include <iostream>
+
+#include "cstorm.hpp"
+#include "rofl/common/cthread_pool.hpp"
+
+namespace {
+
+/* returns microseconds until num_dpts datapaths are attached */
+unsigned long storm(unsigned int num_accept_threads, unsigned int num_dpts) {
+  cstormctl ctl(num_accept_threads);
+  rofl::csockaddr baddr = ctl.listen();
+  cstormdpts dpts(num_dpts);
+  double elapsed = dpts.storm(ctl, baddr);
+  if (ctl.get_num_dpts() < num_dpts) {
+    std::cerr << "crofbaseaccept: only " << ctl.get_num_dpts() << " of "
+              << num_dpts << " datapaths attached" << std::endl;
+  }
+  ctl.close_dpt_socks();
+  return (unsigned long)(elapsed * 1e6);
+}
+
+}; // end of anonymous namespace
+
+int main(int argc, char **argv) {
+  /* both ends of all storm connections live in this process, a datapath
+   * takes about 24 descriptors for sockets and thread events on both ends,
+   * the controller side releases them deferred after some seconds and
+   * overlaps with the next storm */
+  struct rlimit rlim;
+  if (getrlimit(RLIMIT_NOFILE, &rlim) == 0) {
+    rlim.rlim_cur = rlim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rlim);
+  }
+  rofl::cthread_pool::get_instance().start(4);
+
+  unsigned int num_dpts[] = {100, 400};
+  for (auto n : num_dpts) {
+    if ((rlim.rlim_cur != RLIM_INFINITY) && (rlim.rlim_cur < 40 * n)) {
+      std::cout << "crofbaseaccept: datapaths=" << n
+                << " skipped, descriptor limit " << rlim.rlim_cur << std::endl;
+      continue;
+    }
+    unsigned long t_single = storm(1, n);
+    unsigned long t_multi = storm(4, n);
+    std::cout << "crofbaseaccept: datapaths=" << n
+              << " accept threads=1: " << t_single
+              << " us, accept threads=4: " << t_multi << " us" << std::endl;
+  }
+
+  rofl::cthread_pool::get_instance().stop();
+  return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * crofbaseaccepttest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "crofbaseaccepttest.hpp"
+#include "rofl/common/cthread_pool.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(crofbaseaccepttest);
+
+void crofbaseaccepttest::setUp() {
+  /* both ends of all storm connections live in this process */
+  struct rlimit rlim;
+  if (getrlimit(RLIMIT_NOFILE, &rlim) == 0) {
+    rlim.rlim_cur = rlim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rlim);
+  }
+  rofl::cthread_pool::get_instance().start(4);
+}
+
+void crofbaseaccepttest::tearDown() {
+  rofl::cthread_pool::get_instance().stop();
+}
+
+void crofbaseaccepttest::test_reuseport() {
+  cstormctl ctl(3);
+  CPPUNIT_ASSERT(ctl.get_accept_threads() == 3);
+  rofl::csockaddr baddr = ctl.listen();
+  CPPUNIT_ASSERT(ctl.has_dpt_sock(baddr));
+
+  /* binding address is taken by all listening sockets */
+  ctl.dpt_sock_listen(baddr);
+  CPPUNIT_ASSERT(ctl.dpt_sock_close(baddr));
+  CPPUNIT_ASSERT(not ctl.has_dpt_sock(baddr));
+  CPPUNIT_ASSERT(not ctl.dpt_sock_close(baddr));
+
+  /* reopen after close */
+  ctl.dpt_sock_listen(baddr);
+  CPPUNIT_ASSERT(ctl.has_dpt_sock(baddr));
+
+  /* datapaths connecting at once are spread over all accepting sockets */
+  cstormdpts dpts(16);
+  dpts.storm(ctl, baddr);
+  CPPUNIT_ASSERT(ctl.get_num_dpts() == 16);
+  CPPUNIT_ASSERT(dpts.get_num_established() == 16);
+}
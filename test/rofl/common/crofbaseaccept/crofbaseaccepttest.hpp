@@ -0,0 +1,28 @@
+/*
+ * crofbaseaccepttest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CROFBASEACCEPT_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CROFBASEACCEPT_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "cstorm.hpp"
+
+class crofbaseaccepttest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(crofbaseaccepttest);
+  CPPUNIT_TEST(test_reuseport);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void test_reuseport();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CROFBASEACCEPT_TEST_HPP_ */
@@ -0,0 +1,80 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cstorm.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <time.h>
+
+#include <iostream>
+
+#include "cstorm.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+cstormctl::cstormctl(unsigned int num_accept_threads) : num_dpts(0) {
+  set_accept_threads(num_accept_threads).set_listen_backlog(1024);
+  rofl::openflow::cofhello_elem_versionbitmap versionbitmap;
+  versionbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  set_versionbitmap(versionbitmap);
+}
+
+rofl::csockaddr cstormctl::listen() {
+  rofl::crandom rand;
+  while (true) {
+    uint16_t port = 10000 + rand.uint16() % 39000;
+    rofl::csockaddr baddr(rofl::caddress_in4("127.0.0.1"), port);
+    try {
+      dpt_sock_listen(baddr);
+      return baddr;
+    } catch (rofl::eSysCall &e) {
+      std::cerr << "port " << port << " in use" << std::endl;
+    }
+  }
+}
+
+cstormdpts::~cstormdpts() {
+  for (auto conn : conns)
+    delete conn;
+}
+
+cstormdpts::cstormdpts(unsigned int num_dpts) : num_established(0) {
+  versionbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  for (unsigned int i = 0; i < num_dpts; i++) {
+    conns.push_back(new rofl::crofconn(this));
+    dpids[conns.back()] = 0xa000000000000000ULL + i + 1;
+  }
+}
+
+double cstormdpts::storm(cstormctl &ctl, const rofl::csockaddr &raddr) {
+  double start = cbenchmark::now();
+  for (auto conn : conns) {
+    conn->set_raddr(raddr).tcp_connect(versionbitmap,
+                                       rofl::crofconn::MODE_DATAPATH, false);
+  }
+
+  double timeout = start + 60;
+  while ((ctl.get_num_dpts() < conns.size()) &&
+         (cbenchmark::now() < timeout)) {
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 1000000;
+    nanosleep(&ts, NULL);
+  }
+  return cbenchmark::now() - start;
+}
+
+void cstormdpts::handle_recv(rofl::crofconn &conn,
+                             rofl::openflow::cofmsg *msg) {
+  switch (msg->get_type()) {
+  case rofl::openflow::OFPT_FEATURES_REQUEST: {
+    conn.send_message(new rofl::openflow::cofmsg_features_reply(
+        msg->get_version(), msg->get_xid(), dpids.at(&conn), 0, 1, 0));
+  } break;
+  default: {};
+  }
+  delete msg;
+}
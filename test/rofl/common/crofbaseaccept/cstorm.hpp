@@ -0,0 +1,85 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cstorm.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CROFBASEACCEPT_CSTORM_HPP_
+#define TEST_SRC_ROFL_COMMON_CROFBASEACCEPT_CSTORM_HPP_
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "rofl/common/crofbase.h"
+#include "rofl/common/crofconn.h"
+
+/* controller counting attached datapaths */
+class cstormctl : public rofl::crofbase {
+public:
+  ~cstormctl(){};
+
+  cstormctl(unsigned int num_accept_threads);
+
+  /* binds to a random loopback port */
+  rofl::csockaddr listen();
+
+  unsigned int get_num_dpts() const { return num_dpts; };
+
+private:
+  virtual void handle_dpt_open(rofl::crofdpt &dpt) { num_dpts++; };
+
+private:
+  std::atomic_uint num_dpts;
+};
+
+/* loopback datapaths connecting all at once */
+class cstormdpts : public rofl::crofconn_env {
+public:
+  ~cstormdpts();
+
+  cstormdpts(unsigned int num_dpts);
+
+  /* returns seconds until all datapaths are attached to ctl or the
+   * storm timed out after 60 seconds */
+  double storm(cstormctl &ctl, const rofl::csockaddr &raddr);
+
+  unsigned int get_num_established() const { return num_established; };
+
+private:
+  virtual void handle_established(rofl::crofconn &conn, uint8_t ofp_version) {
+    num_established++;
+  };
+
+  virtual void handle_connect_refused(rofl::crofconn &conn){};
+
+  virtual void handle_connect_failed(rofl::crofconn &conn){};
+
+  virtual void handle_accept_failed(rofl::crofconn &conn){};
+
+  virtual void handle_negotiation_failed(rofl::crofconn &conn){};
+
+  virtual void handle_closed(rofl::crofconn &conn){};
+
+  virtual void handle_recv(rofl::crofconn &conn, rofl::openflow::cofmsg *msg);
+
+  virtual void congestion_occured_indication(rofl::crofconn &conn){};
+
+  virtual void congestion_solved_indication(rofl::crofconn &conn){};
+
+  virtual void handle_transaction_timeout(rofl::crofconn &conn, uint32_t xid,
+                                          uint8_t type,
+                                          uint16_t sub_type = 0){};
+
+private:
+  rofl::openflow::cofhello_elem_versionbitmap versionbitmap;
+  std::vector<rofl::crofconn *> conns;
+  std::map<rofl::crofconn *, uint64_t> dpids;
+  std::atomic_uint num_established;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CROFBASEACCEPT_CSTORM_HPP_ */
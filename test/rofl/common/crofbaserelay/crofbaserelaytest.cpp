@@ -0,0 +1,259 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofbaserelaytest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <functional>
+#include <iostream>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "crofbaserelaytest.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(crofbaserelaytest);
+
+namespace {
+
+const unsigned int NUM_PACKETS = 64;
+
+const size_t PACKET_LEN = 128;
+
+/* payload of packet i */
+rofl::cmemory payload(unsigned int i) {
+  rofl::cmemory mem(PACKET_LEN);
+  for (size_t j = 0; j < PACKET_LEN; j++) {
+    mem[j] = (uint8_t)(i + j);
+  }
+  return mem;
+}
+
+/* polls cond for up to 10 seconds */
+bool wait_for(std::function<bool()> cond) {
+  for (unsigned int i = 0; i < 1000; i++) {
+    if (cond())
+      return true;
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 10000000;
+    nanosleep(&ts, NULL);
+  }
+  return cond();
+}
+
+/* binds base to a random loopback port for datapath connections */
+rofl::csockaddr listen(rofl::crofbase &base) {
+  rofl::crandom rand;
+  while (true) {
+    uint16_t port = 10000 + rand.uint16() % 39000;
+    rofl::csockaddr baddr(rofl::caddress_in4("127.0.0.1"), port);
+    try {
+      base.dpt_sock_listen(baddr);
+      return baddr;
+    } catch (rofl::eSysCall &e) {
+      std::cerr << "port " << port << " in use" << std::endl;
+    }
+  }
+}
+
+uint32_t get_xid(const rofl::cslice &frame) {
+  return be32toh(
+      ((const struct rofl::openflow::ofp_header *)frame.somem())->xid);
+}
+
+}; // end of anonymous namespace
+
+crelayctl::crelayctl()
+    : dpt_open(false), num_packet_ins(0), num_barrier_replies(0),
+      num_errors(0) {
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  set_versionbitmap(vbitmap);
+}
+
+void crelayctl::handle_dpt_open(rofl::crofdpt &dpt) {
+  dptid = dpt.get_dptid();
+  dpt_open = true;
+}
+
+void crelayctl::handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_packet_in &msg) {
+  if ((msg.get_buffer_id() >= NUM_PACKETS) ||
+      (msg.get_total_len() != PACKET_LEN) ||
+      (not msg.get_match().has_in_port()) ||
+      (msg.get_match().get_in_port() != 1) ||
+      (not(msg.get_packet() == payload(msg.get_buffer_id())))) {
+    num_errors++;
+  }
+  num_packet_ins++;
+}
+
+crelaydpt::crelaydpt()
+    : ctl_open(false), num_packet_outs(0), num_barrier_requests(0),
+      num_errors(0) {}
+
+void crelaydpt::connect(const rofl::csockaddr &raddr) {
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  ctlid = add_ctl().get_ctlid();
+  set_ctl(ctlid).add_conn(rofl::cauxid(0)).set_raddr(raddr).tcp_connect(
+      vbitmap, rofl::crofconn::MODE_DATAPATH, false);
+}
+
+void crelaydpt::handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                  rofl::openflow::cofmsg_packet_out &msg) {
+  if ((msg.get_buffer_id() >= NUM_PACKETS) ||
+      (msg.get_in_port() != rofl::openflow13::OFPP_CONTROLLER) ||
+      (not(msg.get_packet() == payload(msg.get_buffer_id())))) {
+    num_errors++;
+  }
+  num_packet_outs++;
+}
+
+crelayproxy::crelayproxy()
+    : dpt_open(false), ctl_open(false), num_frames(0), num_decoded(0),
+      num_barrier_requests(0), num_barrier_replies(0) {
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  set_versionbitmap(vbitmap);
+}
+
+void crelayproxy::connect(const rofl::csockaddr &raddr) {
+  rofl::openflow::cofhello_elem_versionbitmap vbitmap;
+  vbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
+  ctlid = add_ctl().get_ctlid();
+  set_ctl(ctlid).add_conn(rofl::cauxid(0)).set_raddr(raddr).tcp_connect(
+      vbitmap, rofl::crofconn::MODE_DATAPATH, false);
+}
+
+void crelayproxy::handle_dpt_open(rofl::crofdpt &dpt) {
+  dptid = dpt.get_dptid();
+  dpt.set_rx_passthrough(rofl::openflow13::OFPT_PACKET_IN);
+  dpt_open = true;
+}
+
+void crelayproxy::handle_ctl_open(rofl::crofctl &ctl) {
+  ctl.set_rx_passthrough(rofl::openflow13::OFPT_PACKET_OUT);
+  ctl_open = true;
+}
+
+void crelayproxy::handle_recv_frame(rofl::crofdpt &dpt,
+                                    const rofl::cauxid &auxid,
+                                    const rofl::cslice &frame) {
+  num_frames++;
+  set_ctl(ctlid).send_frame(rofl::cauxid(0), frame, get_xid(frame));
+}
+
+void crelayproxy::handle_recv_frame(rofl::crofctl &ctl,
+                                    const rofl::cauxid &auxid,
+                                    const rofl::cslice &frame) {
+  num_frames++;
+  set_dpt(dptid).send_frame(rofl::cauxid(0), frame, get_xid(frame));
+}
+
+void crofbaserelaytest::test_relay() {
+  crelayctl ctl;
+  crelayproxy proxy;
+  crelaydpt dpt;
+
+  proxy.connect(listen(ctl));
+  dpt.connect(listen(proxy));
+
+  CPPUNIT_ASSERT(wait_for([&]() {
+    return ctl.is_dpt_open() && proxy.is_ctl_open() && proxy.is_dpt_open() &&
+           dpt.is_ctl_open();
+  }));
+
+  rofl::crofdpt &pdpt = proxy.set_dpt(proxy.get_dptid());
+  rofl::crofctl &pctl = proxy.set_ctl(proxy.get_ctlid());
+  CPPUNIT_ASSERT(pdpt.get_rx_passthrough(rofl::openflow13::OFPT_PACKET_IN));
+  CPPUNIT_ASSERT(
+      not pdpt.get_rx_passthrough(rofl::openflow13::OFPT_PACKET_OUT));
+  CPPUNIT_ASSERT(pctl.get_rx_passthrough(rofl::openflow13::OFPT_PACKET_OUT));
+  CPPUNIT_ASSERT(
+      pdpt.get_conn(rofl::cauxid(0))
+          .get_rx_passthrough(rofl::openflow13::OFPT_PACKET_IN));
+
+  /* connection management messages are never passed through */
+  try {
+    pdpt.set_rx_passthrough(rofl::openflow13::OFPT_ECHO_REQUEST);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::exception &e) {
+  }
+  try {
+    pctl.set_conn(rofl::cauxid(0))
+        .set_rx_passthrough(rofl::openflow13::OFPT_HELLO);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::exception &e) {
+  }
+  CPPUNIT_ASSERT(
+      not pdpt.get_rx_passthrough(rofl::openflow13::OFPT_ECHO_REQUEST));
+
+  /* datapath => proxy => controller */
+  rofl::openflow::cofmatch match(rofl::openflow13::OFP_VERSION);
+  match.set_in_port(1);
+  for (unsigned int i = 0; i < NUM_PACKETS; i++) {
+    rofl::cmemory mem(payload(i));
+    CPPUNIT_ASSERT(rofl::crofsock::MSG_QUEUED ==
+                   dpt.set_ctl(dpt.get_ctlid())
+                       .send_packet_in_message(
+                           rofl::cauxid(0), i, PACKET_LEN,
+                           rofl::openflow13::OFPR_NO_MATCH, 0, 0, 0, match,
+                           mem.somem(), mem.length()));
+  }
+  CPPUNIT_ASSERT(
+      wait_for([&]() { return ctl.get_num_packet_ins() == NUM_PACKETS; }));
+
+  /* controller => proxy => datapath */
+  rofl::openflow::cofactions actions(rofl::openflow13::OFP_VERSION);
+  for (unsigned int i = 0; i < NUM_PACKETS; i++) {
+    rofl::cmemory mem(payload(i));
+    CPPUNIT_ASSERT(rofl::crofsock::MSG_QUEUED ==
+                   ctl.set_dpt(ctl.get_dptid())
+                       .send_packet_out_message(
+                           rofl::cauxid(0), i,
+                           rofl::openflow13::OFPP_CONTROLLER, actions,
+                           mem.somem(), mem.length()));
+  }
+  CPPUNIT_ASSERT(
+      wait_for([&]() { return dpt.get_num_packet_outs() == NUM_PACKETS; }));
+
+  /* other message types are still decoded by the proxy */
+  ctl.set_dpt(ctl.get_dptid()).send_barrier_request(rofl::cauxid(0));
+  pdpt.send_barrier_request(rofl::cauxid(0));
+  CPPUNIT_ASSERT(wait_for([&]() {
+    return (ctl.get_num_barrier_replies() == 1) &&
+           (proxy.get_num_barrier_replies() == 1);
+  }));
+  CPPUNIT_ASSERT(proxy.get_num_barrier_requests() == 1);
+  CPPUNIT_ASSERT(dpt.get_num_barrier_requests() == 1);
+
+  CPPUNIT_ASSERT(proxy.get_num_frames() == 2 * NUM_PACKETS);
+  CPPUNIT_ASSERT(proxy.get_num_decoded() == 0);
+  CPPUNIT_ASSERT(ctl.get_num_errors() == 0);
+  CPPUNIT_ASSERT(dpt.get_num_errors() == 0);
+
+  /* disabled passthrough hands over decoded messages again */
+  pdpt.clear_rx_passthrough();
+  CPPUNIT_ASSERT(
+      not pdpt.get_rx_passthrough(rofl::openflow13::OFPT_PACKET_IN));
+  rofl::cmemory mem(payload(0));
+  dpt.set_ctl(dpt.get_ctlid())
+      .send_packet_in_message(rofl::cauxid(0), 0, PACKET_LEN,
+                              rofl::openflow13::OFPR_NO_MATCH, 0, 0, 0, match,
+                              mem.somem(), mem.length());
+  CPPUNIT_ASSERT(wait_for([&]() { return proxy.get_num_decoded() == 1; }));
+  CPPUNIT_ASSERT(proxy.get_num_frames() == 2 * NUM_PACKETS);
+
+  dpt.set_ctl(dpt.get_ctlid()).set_conn(rofl::cauxid(0)).close();
+  proxy.set_ctl(proxy.get_ctlid()).set_conn(rofl::cauxid(0)).close();
+  sleep(1);
+}
@@ -0,0 +1,199 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofbaserelaytest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CROFBASERELAY_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CROFBASERELAY_TEST_HPP_
+
+#include <atomic>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/crofbase.h"
+
+/* controller sending Packet-Outs to the relayed datapath */
+class crelayctl : public rofl::crofbase {
+public:
+  ~crelayctl(){};
+
+  crelayctl();
+
+  bool is_dpt_open() const { return dpt_open; };
+
+  const rofl::cdptid &get_dptid() const { return dptid; };
+
+  unsigned int get_num_packet_ins() const { return num_packet_ins; };
+
+  unsigned int get_num_barrier_replies() const { return num_barrier_replies; };
+
+  unsigned int get_num_errors() const { return num_errors; };
+
+private:
+  virtual void handle_dpt_open(rofl::crofdpt &dpt);
+
+  virtual void handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_packet_in &msg);
+
+  virtual void handle_barrier_reply(rofl::crofdpt &dpt,
+                                    const rofl::cauxid &auxid,
+                                    rofl::openflow::cofmsg_barrier_reply &msg) {
+    num_barrier_replies++;
+  };
+
+private:
+  rofl::cdptid dptid;
+  std::atomic_bool dpt_open;
+  std::atomic_uint num_packet_ins;
+  std::atomic_uint num_barrier_replies;
+  std::atomic_uint num_errors;
+};
+
+/* datapath sending Packet-Ins via the relay */
+class crelaydpt : public rofl::crofbase {
+public:
+  ~crelaydpt(){};
+
+  crelaydpt();
+
+  void connect(const rofl::csockaddr &raddr);
+
+  bool is_ctl_open() const { return ctl_open; };
+
+  const rofl::cctlid &get_ctlid() const { return ctlid; };
+
+  unsigned int get_num_packet_outs() const { return num_packet_outs; };
+
+  unsigned int get_num_barrier_requests() const {
+    return num_barrier_requests;
+  };
+
+  unsigned int get_num_errors() const { return num_errors; };
+
+private:
+  virtual void handle_ctl_open(rofl::crofctl &ctl) { ctl_open = true; };
+
+  virtual void
+  handle_features_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                          rofl::openflow::cofmsg_features_request &msg) {
+    ctl.send_features_reply(auxid, msg.get_xid(), 0xd0d1d2d3d4d5d6d7ULL, 0, 1,
+                            0);
+  };
+
+  virtual void
+  handle_barrier_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                         rofl::openflow::cofmsg_barrier_request &msg) {
+    num_barrier_requests++;
+    ctl.send_barrier_reply(auxid, msg.get_xid());
+  };
+
+  virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_packet_out &msg);
+
+private:
+  rofl::cctlid ctlid;
+  std::atomic_bool ctl_open;
+  std::atomic_uint num_packet_outs;
+  std::atomic_uint num_barrier_requests;
+  std::atomic_uint num_errors;
+};
+
+/* proxy relaying Packet-Ins and Packet-Outs undecoded */
+class crelayproxy : public rofl::crofbase {
+public:
+  ~crelayproxy(){};
+
+  crelayproxy();
+
+  void connect(const rofl::csockaddr &raddr);
+
+  bool is_dpt_open() const { return dpt_open; };
+
+  bool is_ctl_open() const { return ctl_open; };
+
+  const rofl::cdptid &get_dptid() const { return dptid; };
+
+  const rofl::cctlid &get_ctlid() const { return ctlid; };
+
+  unsigned int get_num_frames() const { return num_frames; };
+
+  unsigned int get_num_decoded() const { return num_decoded; };
+
+  unsigned int get_num_barrier_requests() const {
+    return num_barrier_requests;
+  };
+
+  unsigned int get_num_barrier_replies() const { return num_barrier_replies; };
+
+private:
+  virtual void handle_dpt_open(rofl::crofdpt &dpt);
+
+  virtual void handle_ctl_open(rofl::crofctl &ctl);
+
+  virtual void
+  handle_features_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                          rofl::openflow::cofmsg_features_request &msg) {
+    ctl.send_features_reply(auxid, msg.get_xid(), 0xe0e1e2e3e4e5e6e7ULL, 0, 1,
+                            0);
+  };
+
+  virtual void handle_recv_frame(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                 const rofl::cslice &frame);
+
+  virtual void handle_recv_frame(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 const rofl::cslice &frame);
+
+  virtual void handle_packet_in(rofl::crofdpt &dpt, const rofl::cauxid &auxid,
+                                rofl::openflow::cofmsg_packet_in &msg) {
+    num_decoded++;
+  };
+
+  virtual void handle_packet_out(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                                 rofl::openflow::cofmsg_packet_out &msg) {
+    num_decoded++;
+  };
+
+  virtual void
+  handle_barrier_request(rofl::crofctl &ctl, const rofl::cauxid &auxid,
+                         rofl::openflow::cofmsg_barrier_request &msg) {
+    num_barrier_requests++;
+    ctl.send_barrier_reply(auxid, msg.get_xid());
+  };
+
+  virtual void handle_barrier_reply(rofl::crofdpt &dpt,
+                                    const rofl::cauxid &auxid,
+                                    rofl::openflow::cofmsg_barrier_reply &msg) {
+    num_barrier_replies++;
+  };
+
+private:
+  rofl::cdptid dptid;
+  rofl::cctlid ctlid;
+  std::atomic_bool dpt_open;
+  std::atomic_bool ctl_open;
+  std::atomic_uint num_frames;
+  std::atomic_uint num_decoded;
+  std::atomic_uint num_barrier_requests;
+  std::atomic_uint num_barrier_replies;
+};
+
+class crofbaserelaytest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(crofbaserelaytest);
+  CPPUNIT_TEST(test_relay);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp(){};
+  void tearDown(){};
+
+public:
+  void test_relay();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CROFBASERELAY_TEST_HPP_ */
@@ -16,6 +16,58 @@ using namespace rofl::openflow;
 
 CPPUNIT_TEST_SUITE_REGISTRATION(crofchantest);
 
+namespace {
+
+/* sends num Packet-In messages with in_ports 1..num_ports via auxid 0 */
+unsigned int send_packet_ins(rofl::crofchan &chan, unsigned int num,
+                             unsigned int num_ports) {
+  unsigned int sent = 0;
+  rofl::cmemory packet(64);
+  for (unsigned int i = 0; i < num; i++) {
+    rofl::openflow::cofmatch match(rofl::openflow13::OFP_VERSION);
+    match.set_in_port(1 + (i % num_ports));
+    rofl::openflow::cofmsg_packet_in *msg =
+        new rofl::openflow::cofmsg_packet_in(
+            rofl::openflow13::OFP_VERSION, i, /*buffer_id=*/i,
+            /*total_len=*/packet.length(), /*reason=*/0, /*table_id=*/0,
+            /*cookie=*/0, /*in_port=*/0, match, packet.somem(),
+            packet.length());
+    switch (chan.send_message(rofl::cauxid(0), msg)) {
+    case rofl::crofsock::MSG_QUEUED:
+    case rofl::crofsock::MSG_QUEUED_CONGESTION: {
+      sent++;
+    } break;
+    default: {};
+    }
+  }
+  return sent;
+}
+
+/* Packet-Outs originated by the controller, sent to the main connection */
+unsigned int send_packet_outs(rofl::crofchan &chan, unsigned int num) {
+  unsigned int sent = 0;
+  rofl::cmemory packet(64);
+  rofl::openflow::cofactions actions(rofl::openflow13::OFP_VERSION);
+  for (unsigned int i = 0; i < num; i++) {
+    rofl::openflow::cofmsg_packet_out *msg =
+        new rofl::openflow::cofmsg_packet_out(
+            rofl::openflow13::OFP_VERSION, i,
+            /*buffer_id=*/rofl::openflow13::OFP_NO_BUFFER,
+            /*in_port=*/rofl::openflow13::OFPP_CONTROLLER, actions,
+            packet.somem(), packet.length());
+    switch (chan.send_message(rofl::cauxid(0), msg)) {
+    case rofl::crofsock::MSG_QUEUED:
+    case rofl::crofsock::MSG_QUEUED_CONGESTION: {
+      sent++;
+    } break;
+    default: {};
+    }
+  }
+  return sent;
+}
+
+}; // end of anonymous namespace
+
 void crofchantest::setUp() {
   versionbitmap.add_ofp_version(rofl::openflow13::OFP_VERSION);
   baddr = rofl::csockaddr(AF_INET, "127.0.0.1", 16455);
@@ -254,6 +306,187 @@ void crofchantest::test_congestion() {
   CPPUNIT_ASSERT(channel2->keys().size() == 0);
 }
 
+void crofchantest::test_sched() {
+  keep_running = true;
+  flood = false;
+  num_of_conns = 4;
+  num_of_accepts = 0;
+  num_of_dpt_established = 0;
+  num_of_ctl_established = 0;
+  num_of_match_errors = 0;
+  int seconds = 20;
+  const unsigned int num_pkts = 1200;
+
+  /* connections added later inherit lazy decoding and streaming */
+  channel2->set_rx_lazy_decoding(true);
+  channel1->set_multipart_streaming(true);
+
+  /* try to find idle port for test */
+  bool lookup_idle_port = true;
+  while (lookup_idle_port) {
+    do {
+      listening_port = rand.uint16();
+    } while ((listening_port < 10000) || (listening_port > 49000));
+    try {
+      baddr = rofl::csockaddr(rofl::caddress_in4("127.0.0.1"), listening_port);
+      rofsock->set_backlog(num_of_conns);
+      rofsock->set_baddr(baddr).listen();
+      lookup_idle_port = false;
+    } catch (rofl::eSysCall &e) {
+      /* port in use, try another one */
+    }
+  }
+
+  for (unsigned int i = 0; i < num_of_conns; i++) {
+    channel1->add_conn(rofl::cauxid(i))
+        .set_raddr(baddr)
+        .tcp_connect(versionbitmap, rofl::crofconn::MODE_DATAPATH, false);
+    num_of_dpt_established++;
+  }
+
+  while ((num_of_ctl_established < num_of_conns) && (seconds-- > 0)) {
+    sleep(1);
+  }
+  CPPUNIT_ASSERT(channel2->keys().size() == num_of_conns);
+  for (auto auxid : channel2->keys()) {
+    CPPUNIT_ASSERT(channel2->get_conn(auxid).get_rx_lazy_decoding());
+  }
+  for (auto auxid : channel1->keys()) {
+    CPPUNIT_ASSERT(channel1->get_conn(auxid).get_multipart_streaming());
+  }
+  for (auto auxid : channel1->keys()) {
+    while ((not channel1->get_conn(auxid).is_established()) &&
+           (seconds-- > 0)) {
+      sleep(1);
+    }
+  }
+
+  rofl::crofchan::crofchan_sched_t policies[] = {
+      rofl::crofchan::SCHED_EXPLICIT, rofl::crofchan::SCHED_FLOW_HASH,
+      rofl::crofchan::SCHED_LEAST_QUEUED, rofl::crofchan::SCHED_ROUND_ROBIN};
+
+  for (auto policy : policies) {
+    channel1->set_sched_policy(policy);
+    channel1->clear_tx_counters();
+    for (unsigned int i = 0; i < 256; i++) {
+      pkts_rcvd_per_auxid[i] = 0;
+    }
+    num_of_pkts_rcvd = 0;
+
+    num_of_pkts_sent = send_packet_ins(*channel1, num_pkts, 6);
+    CPPUNIT_ASSERT(num_of_pkts_sent == (int)num_pkts);
+
+    seconds = 20;
+    while ((num_of_pkts_rcvd < num_of_pkts_sent) && (seconds-- > 0)) {
+      sleep(1);
+    }
+    CPPUNIT_ASSERT(num_of_pkts_rcvd == num_of_pkts_sent);
+
+    std::cerr << "crofchantest::test_sched() policy=" << (int)policy;
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < num_of_conns; i++) {
+      rofl::cauxid auxid(i);
+      std::cerr << " auxid(" << i << ")=" << channel1->get_tx_counter(auxid);
+      /* every message queued by channel1 arrives on the same auxid */
+      CPPUNIT_ASSERT(channel1->get_tx_counter(auxid) ==
+                     pkts_rcvd_per_auxid[i]);
+      total += channel1->get_tx_counter(auxid);
+    }
+    std::cerr << std::endl;
+    CPPUNIT_ASSERT(total == num_pkts);
+
+    if (policy == rofl::crofchan::SCHED_EXPLICIT) {
+      CPPUNIT_ASSERT(channel1->get_tx_counter(rofl::cauxid(0)) == num_pkts);
+    } else {
+      /* main connection is kept free of Packet-In messages */
+      CPPUNIT_ASSERT(channel1->get_tx_counter(rofl::cauxid(0)) == 0);
+    }
+    if (policy == rofl::crofchan::SCHED_ROUND_ROBIN) {
+      for (unsigned int i = 1; i < num_of_conns; i++) {
+        CPPUNIT_ASSERT(channel1->get_tx_counter(rofl::cauxid(i)) ==
+                       num_pkts / (num_of_conns - 1));
+      }
+    }
+  }
+
+  /* Packet-Outs from OFPP_CONTROLLER have no flow key and are spread
+   * evenly over all auxiliary connections */
+  channel2->set_sched_policy(rofl::crofchan::SCHED_FLOW_HASH);
+  channel2->clear_tx_counters();
+  for (unsigned int i = 0; i < 256; i++) {
+    pkts_rcvd_per_auxid[i] = 0;
+  }
+  num_of_pkts_rcvd = 0;
+  /* a burst of 100 per connection fits into the transmission queues */
+  const unsigned int num_pkt_outs = 100 * (num_of_conns - 1);
+  num_of_pkts_sent = send_packet_outs(*channel2, num_pkt_outs);
+  CPPUNIT_ASSERT(num_of_pkts_sent == (int)num_pkt_outs);
+  seconds = 20;
+  while ((num_of_pkts_rcvd < num_of_pkts_sent) && (seconds-- > 0)) {
+    sleep(1);
+  }
+  CPPUNIT_ASSERT(num_of_pkts_rcvd == num_of_pkts_sent);
+  CPPUNIT_ASSERT(channel2->get_tx_counter(rofl::cauxid(0)) == 0);
+  CPPUNIT_ASSERT(pkts_rcvd_per_auxid[0] == 0);
+  for (unsigned int i = 1; i < num_of_conns; i++) {
+    CPPUNIT_ASSERT(channel2->get_tx_counter(rofl::cauxid(i)) == 100);
+    CPPUNIT_ASSERT(pkts_rcvd_per_auxid[i] == 100);
+  }
+
+  /* Packet-Ins were decoded lazily on first access */
+  CPPUNIT_ASSERT(num_of_match_errors == 0);
+  channel2->set_rx_lazy_decoding(false);
+  for (auto auxid : channel2->keys()) {
+    CPPUNIT_ASSERT(not channel2->get_conn(auxid).get_rx_lazy_decoding());
+  }
+
+  /* explicitly selected auxiliary connections are never redistributed */
+  channel1->set_sched_policy(rofl::crofchan::SCHED_ROUND_ROBIN);
+  channel1->clear_tx_counters();
+  channel1->send_message(
+      rofl::cauxid(2),
+      new rofl::openflow::cofmsg_echo_request(rofl::openflow13::OFP_VERSION));
+  CPPUNIT_ASSERT(channel1->get_tx_counter(rofl::cauxid(2)) == 1);
+
+  /* non-throwing variant takes ownership on success only */
+  rofl::openflow::cofmsg *msg =
+      new rofl::openflow::cofmsg_echo_request(rofl::openflow13::OFP_VERSION);
+  CPPUNIT_ASSERT(channel1->try_send_message(rofl::cauxid(3), msg) ==
+                 rofl::crofsock::MSG_QUEUED);
+  CPPUNIT_ASSERT(msg == nullptr);
+  msg = new rofl::openflow::cofmsg_echo_request(rofl::openflow13::OFP_VERSION);
+  CPPUNIT_ASSERT(channel1->try_send_message(rofl::cauxid(7), msg) ==
+                 rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED);
+  CPPUNIT_ASSERT(msg != nullptr);
+
+  /* oversized message of a type that cannot be segmented is handed back */
+  rofl::cmemory packet(70000);
+  rofl::openflow::cofmsg *oversized = new rofl::openflow::cofmsg_packet_out(
+      rofl::openflow13::OFP_VERSION, 0, rofl::openflow::OFP_NO_BUFFER,
+      rofl::openflow13::OFPP_CONTROLLER,
+      rofl::openflow::cofactions(rofl::openflow13::OFP_VERSION),
+      packet.somem(), packet.length());
+  CPPUNIT_ASSERT(channel1->try_send_message(rofl::cauxid(3), oversized) ==
+                 rofl::crofsock::MSG_IGNORED);
+  CPPUNIT_ASSERT(oversized != nullptr);
+  delete oversized;
+
+  for (auto auxid : channel2->keys()) {
+    channel2->drop_conn(auxid);
+  }
+  for (auto auxid : channel1->keys()) {
+    channel1->drop_conn(auxid);
+  }
+  CPPUNIT_ASSERT(channel1->keys().size() == 0);
+  CPPUNIT_ASSERT(channel2->keys().size() == 0);
+
+  /* channel down: the message is handed back for a later retry */
+  CPPUNIT_ASSERT(channel1->try_send_message(rofl::cauxid(0), msg) ==
+                 rofl::crofsock::MSG_QUEUEING_FAILED_NOT_ESTABLISHED);
+  CPPUNIT_ASSERT(msg != nullptr);
+  delete msg;
+}
+
 void crofchantest::handle_listen(rofl::crofsock &socket) {
   for (auto sd : socket.accept()) {
     num_of_accepts++;
@@ -321,7 +554,7 @@ void crofchantest::handle_established(rofl::crofchan &chan,
     conn.set_txqueue_max_size(65536);
   }
 
-  if (conn.get_auxid() == rofl::cauxid(0)) {
+  if (flood && (conn.get_auxid() == rofl::cauxid(0))) {
     thread.add_timer(TIMER_ID_START_SENDING_PACKET_INS,
                      rofl::ctimespec().expire_in(1));
   }
@@ -436,6 +669,17 @@ void crofchantest::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
 
   } break;
   case rofl::openflow13::OFPT_PACKET_IN: {
+    if (not flood) {
+      try {
+        rofl::openflow::cofmsg_packet_in &msg =
+            dynamic_cast<rofl::openflow::cofmsg_packet_in &>(*pmsg);
+        if (msg.get_match().get_in_port() == 0)
+          num_of_match_errors++;
+      } catch (std::exception &e) {
+        num_of_match_errors++;
+      }
+    }
+    pkts_rcvd_per_auxid[conn.get_auxid().get_id()]++;
     num_of_pkts_rcvd++;
     if ((num_of_pkts_sent == num_of_pkts_rcvd) &&
         (max_congestion_rounds <= 0)) {
@@ -443,7 +687,8 @@ void crofchantest::handle_recv(rofl::crofchan &chan, rofl::crofconn &conn,
     }
   } break;
   case rofl::openflow13::OFPT_PACKET_OUT: {
-
+    pkts_rcvd_per_auxid[conn.get_auxid().get_id()]++;
+    num_of_pkts_rcvd++;
   } break;
   default: {};
   }
@@ -25,6 +25,7 @@ class crofchantest : public CppUnit::TestFixture,
   CPPUNIT_TEST_SUITE(crofchantest);
   CPPUNIT_TEST(test_connections);
   CPPUNIT_TEST(test_congestion);
+  CPPUNIT_TEST(test_sched);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -32,7 +33,7 @@ public:
 
   crofchantest()
       : num_of_pkts_sent(0), num_of_pkts_rcvd(0), thread(this),
-        max_congestion_rounds(16){};
+        max_congestion_rounds(16), flood(true){};
 
 public:
   void setUp();
@@ -41,6 +42,7 @@ public:
 public:
   void test_connections();
   void test_congestion();
+  void test_sched();
 
 private:
   uint16_t listening_port;
@@ -64,13 +66,22 @@ private:
   rofl::crwlock plock;
   std::set<rofl::crofconn *> pending_conns;
 
-  int num_of_pkts_sent;
-  int num_of_pkts_rcvd;
+  std::atomic_int num_of_pkts_sent;
+  std::atomic_int num_of_pkts_rcvd;
   std::atomic_bool congested;
 
   rofl::cthread thread;
   int max_congestion_rounds;
 
+  // start overloading the main connection once established
+  bool flood;
+
+  // Packet-In and Packet-Out messages received per auxid
+  std::atomic_uint pkts_rcvd_per_auxid[256];
+
+  // Packet-In messages whose match could not be decoded
+  std::atomic_uint num_of_match_errors;
+
 private:
   enum crofchantest_timer_t {
     TIMER_ID_START_SENDING_PACKET_INS = 1,
@@ -21,8 +21,29 @@ void crofconntest::setUp() {}
 void crofconntest::tearDown() {}
 
 void crofconntest::test() {
+  test_mode = TEST_MODE_TCP;
+  run();
+}
+
+void crofconntest::test_streaming() {
+  test_mode = TEST_MODE_STREAMING;
+  num_of_flows = 10000;
+  num_of_segments = 0;
+  flows_rcvd = 0;
+  reply_complete = false;
+  run();
+
+  /* reply exceeds the segmentation threshold and arrives segment by
+   * segment, none of them holding the entire flow table */
+  std::cerr << "crofconntest::test_streaming() flows=" << flows_rcvd
+            << " segments=" << num_of_segments << std::endl;
+  CPPUNIT_ASSERT(reply_complete);
+  CPPUNIT_ASSERT(flows_rcvd == num_of_flows);
+  CPPUNIT_ASSERT(num_of_segments > 1);
+}
+
+void crofconntest::run() {
   try {
-    test_mode = TEST_MODE_TCP;
     keep_running = 10;
     msg_counter = 0;
     xid = 0xa1a2a3a4;
@@ -75,6 +96,9 @@ void crofconntest::test() {
       std::cerr << "s:" << srv_pkts_rcvd << "(" << cli_pkts_sent << "), ";
       std::cerr << "c:" << cli_pkts_rcvd << "(" << srv_pkts_sent << "), "
                 << std::endl;
+      if ((test_mode == TEST_MODE_STREAMING) && reply_complete) {
+        break;
+      }
       if ((cli_pkts_rcvd >= num_of_packets) &&
           (srv_pkts_rcvd >= num_of_packets)) {
         break;
@@ -98,10 +122,10 @@ void crofconntest::test() {
               << std::endl;
 
   } catch (rofl::eSysCall &e) {
-    std::cerr << "crofconntest::test() exception, what: " << e.what()
+    std::cerr << "crofconntest::run() exception, what: " << e.what()
               << std::endl;
   } catch (std::runtime_error &e) {
-    std::cerr << "crofconntest::test() exception, what: " << e.what()
+    std::cerr << "crofconntest::run() exception, what: " << e.what()
               << std::endl;
   }
 }
@@ -122,6 +146,15 @@ void crofconntest::handle_listen(rofl::crofsock &socket) {
       sserver->tcp_accept(sd, versionbitmap_ctl,
                           rofl::crofconn::MODE_CONTROLLER);
 
+    } break;
+    case TEST_MODE_STREAMING: {
+      versionbitmap_ctl.add_ofp_version(rofl::openflow13::OFP_VERSION);
+
+      sserver = new rofl::crofconn(this);
+      sserver->set_multipart_streaming(true);
+      sserver->tcp_accept(sd, versionbitmap_ctl,
+                          rofl::crofconn::MODE_CONTROLLER);
+
     } break;
     default: {};
     }
@@ -132,9 +165,15 @@ void crofconntest::handle_established(rofl::crofconn &conn,
                                       uint8_t ofp_version) {
   std::cerr << "crofconntest::handle_established()" << std::endl;
 
-  if (&conn == sserver) {
+  if ((&conn == sserver) && (test_mode == TEST_MODE_STREAMING)) {
+    sserver->send_message(new rofl::openflow::cofmsg_flow_stats_request(
+        ofp_version, ++xid_server, 0,
+        rofl::openflow::cofflow_stats_request(ofp_version)));
+  } else if (&conn == sserver) {
     std::cerr << "[Ss], ";
     send_packet_out(ofp_version);
+  } else if ((&conn == sclient) && (test_mode == TEST_MODE_STREAMING)) {
+    /* wait for Flow-Stats-Request */
   } else if (&conn == sclient) {
     std::cerr << "[Sc], ";
     send_packet_in(ofp_version);
@@ -224,6 +263,28 @@ void crofconntest::handle_recv(rofl::crofconn &conn,
     }
 
   } break;
+  case rofl::openflow13::OFPT_MULTIPART_REQUEST: {
+    rofl::openflow::cofmsg_flow_stats_reply *msg =
+        new rofl::openflow::cofmsg_flow_stats_reply(pmsg->get_version(),
+                                                    pmsg->get_xid());
+    for (unsigned int i = 0; i < num_of_flows; i++) {
+      msg->set_flow_stats_array()
+          .add_flow_stats(i)
+          .set_match()
+          .set_eth_dst(rofl::caddress_ll(i + 1));
+    }
+    conn.send_message(msg);
+  } break;
+  case rofl::openflow13::OFPT_MULTIPART_REPLY: {
+    rofl::openflow::cofmsg_flow_stats_reply &msg =
+        dynamic_cast<rofl::openflow::cofmsg_flow_stats_reply &>(*pmsg);
+    CPPUNIT_ASSERT(msg.get_flow_stats_array().size() < num_of_flows);
+    num_of_segments++;
+    flows_rcvd += msg.get_flow_stats_array().size();
+    if (not(msg.get_stats_flags() & rofl::openflow13::OFPMPF_REPLY_MORE)) {
+      reply_complete = true;
+    }
+  } break;
   default: { CPPUNIT_ASSERT(false); };
   }
 
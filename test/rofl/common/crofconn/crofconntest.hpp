@@ -20,6 +20,7 @@ class crofconntest : public CppUnit::TestFixture,
                      public rofl::crofsock_env {
   CPPUNIT_TEST_SUITE(crofconntest);
   CPPUNIT_TEST(test);
+  CPPUNIT_TEST(test_streaming);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -28,6 +29,7 @@ public:
 
 public:
   void test();
+  void test_streaming();
 
 private:
   virtual void handle_listen(rofl::crofsock &socket);
@@ -85,6 +87,8 @@ private:
                                           uint16_t sub_type = 0){};
 
 private:
+  void run();
+
   void send_packet_in(uint8_t version);
 
   void send_packet_out(uint8_t version);
@@ -92,6 +96,7 @@ private:
 private:
   enum crofconn_test_mode_t {
     TEST_MODE_TCP = 1,
+    TEST_MODE_STREAMING = 2,
   };
 
   rofl::openflow::cofhello_elem_versionbitmap versionbitmap_ctl;
@@ -120,6 +125,11 @@ private:
   int srv_pkts_sent;
   int cli_pkts_rcvd;
   int cli_pkts_sent;
+
+  unsigned int num_of_flows;
+  unsigned int num_of_segments;
+  unsigned int flows_rcvd;
+  bool reply_complete;
 };
 
 #endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGAGGRSTATS_TEST_HPP_ */
@@ -0,0 +1,67 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofqueuebench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "crofqueuetest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+int main(int argc, char **argv) {
+  const unsigned int num_msgs_total = 400000;
+  unsigned int num_producers[] = {1, 2, 8};
+  for (auto n : num_producers) {
+    bool in_order = false;
+    double t_list = crofqueuetest::run_producers<crofqueuetest::clistqueue>(
+        n, num_msgs_total / n, in_order);
+    double t_ring = crofqueuetest::run_producers<rofl::crofqueue>(
+        n, num_msgs_total / n, in_order);
+    std::cout << "crofqueue: producers=" << n << " msgs=" << num_msgs_total
+              << " list=" << (unsigned long)(num_msgs_total / t_list)
+              << " msgs/s ring=" << (unsigned long)(num_msgs_total / t_ring)
+              << " msgs/s" << std::endl;
+  }
+
+  /* rejecting messages on a full queue: exception vs. status code */
+  const unsigned int num_rejects = 100000;
+  rofl::crofqueue queue(4);
+  queue.set_queue_max_size(4);
+  for (uintptr_t i = 1; i <= 4; i++) {
+    queue.store((rofl::openflow::cofmsg *)i);
+  }
+  rofl::openflow::cofmsg *msg = (rofl::openflow::cofmsg *)5;
+  unsigned int rejected = 0;
+
+  double t_throw = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_rejects; i++) {
+      try {
+        queue.store(msg);
+      } catch (rofl::eRofQueueFull &e) {
+        rejected++;
+      }
+    }
+  });
+
+  double t_try = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_rejects; i++) {
+      if (not queue.try_store(msg))
+        rejected++;
+    }
+  });
+
+  std::cout << "crofqueue: rejects=" << rejected
+            << " store+catch=" << (unsigned long)(t_throw * 1e9 / num_rejects)
+            << " ns/msg try_store="
+            << (unsigned long)(t_try * 1e9 / num_rejects) << " ns/msg"
+            << std::endl;
+  while (queue.retrieve() != nullptr) {
+  }
+
+  return 0;
+}
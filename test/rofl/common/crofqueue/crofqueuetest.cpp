@@ -5,12 +5,14 @@
  *      Author: andi
  */
 
+#include <sched.h>
 #include <stdlib.h>
 
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
 
 #include "crofqueuetest.hpp"
+#include "rofl/common/cbenchmark.hpp"
 
 using namespace rofl::openflow;
 
@@ -50,6 +52,14 @@ void crofqueuetest::test1() {
     }
   }
 
+  /* non-throwing variant leaves the message with the caller */
+  rofl::openflow::cofmsg *msg = new rofl::openflow::cofmsg(
+      rofl::openflow13::OFP_VERSION, rofl::openflow13::OFPT_HELLO, xid++);
+  CPPUNIT_ASSERT(not queue.try_store(msg));
+  CPPUNIT_ASSERT(queue.size() == 128);
+  CPPUNIT_ASSERT(queue.try_store(msg, true));
+  CPPUNIT_ASSERT(queue.size() == 129);
+
   queue.clear();
 
   CPPUNIT_ASSERT(queue.size() == 0);
@@ -91,3 +101,157 @@ void crofqueuetest::test2() {
   CPPUNIT_ASSERT(queue.size() == 0);
   CPPUNIT_ASSERT(queue.empty());
 }
+
+namespace {
+
+template <class Q> struct cproducer {
+  Q *queue;
+  unsigned int producer_id;
+  unsigned int num_msgs;
+};
+
+/* messages are never dereferenced by the queue, encode producer id and
+ * sequence number into the pointer value for checking FIFO order */
+template <class Q> void *produce(void *arg) {
+  cproducer<Q> *producer = static_cast<cproducer<Q> *>(arg);
+  for (unsigned int seq = 0; seq < producer->num_msgs; seq++) {
+    uintptr_t value = ((uintptr_t)producer->producer_id << 24) | (seq + 1);
+    while (producer->queue->capacity() == 0) {
+      sched_yield();
+    }
+    producer->queue->store((rofl::openflow::cofmsg *)value, true);
+  }
+  return NULL;
+}
+
+} // namespace
+
+template <class Q>
+double crofqueuetest::run_producers(unsigned int num_producers,
+                                    unsigned int num_msgs, bool &in_order) {
+  Q queue;
+  queue.set_queue_max_size(256);
+
+  std::vector<cproducer<Q>> producers(num_producers);
+  std::vector<pthread_t> tids(num_producers);
+  std::vector<unsigned int> next_seq(num_producers, 1);
+
+  double start = cbenchmark::now();
+
+  for (unsigned int i = 0; i < num_producers; i++) {
+    producers[i].queue = &queue;
+    producers[i].producer_id = i;
+    producers[i].num_msgs = num_msgs;
+    pthread_create(&tids[i], NULL, &produce<Q>, &producers[i]);
+  }
+
+  in_order = true;
+  unsigned int num_rcvd = 0;
+  while (num_rcvd < num_producers * num_msgs) {
+    rofl::openflow::cofmsg *msg = queue.retrieve();
+    if (msg == nullptr) {
+      sched_yield();
+      continue;
+    }
+    uintptr_t value = (uintptr_t)msg;
+    unsigned int producer_id = value >> 24;
+    unsigned int seq = value & 0xffffff;
+    if ((producer_id >= num_producers) || (next_seq[producer_id] != seq)) {
+      in_order = false;
+    } else {
+      next_seq[producer_id]++;
+    }
+    num_rcvd++;
+  }
+
+  double stop = cbenchmark::now();
+
+  for (unsigned int i = 0; i < num_producers; i++) {
+    pthread_join(tids[i], NULL);
+  }
+
+  return stop - start;
+}
+
+/* both queues are measured by the benchmark */
+template double crofqueuetest::run_producers<rofl::crofqueue>(
+    unsigned int num_producers, unsigned int num_msgs, bool &in_order);
+template double crofqueuetest::run_producers<crofqueuetest::clistqueue>(
+    unsigned int num_producers, unsigned int num_msgs, bool &in_order);
+
+void crofqueuetest::test_producers() {
+  unsigned int num_producers[] = {1, 2, 8};
+  for (auto n : num_producers) {
+    bool in_order = false;
+    run_producers<rofl::crofqueue>(n, 50000, in_order);
+    CPPUNIT_ASSERT(in_order);
+  }
+
+  /* enforced stores exceeding the ring spill over and keep FIFO order */
+  rofl::crofqueue queue(4);
+  CPPUNIT_ASSERT(queue.get_ring_size() == 4);
+  for (uintptr_t i = 1; i <= 16; i++) {
+    queue.store((rofl::openflow::cofmsg *)i, true);
+    if (i == 6) {
+      CPPUNIT_ASSERT(queue.retrieve() == (rofl::openflow::cofmsg *)1);
+    }
+  }
+  CPPUNIT_ASSERT(queue.size() == 15);
+  for (uintptr_t i = 2; i <= 16; i++) {
+    CPPUNIT_ASSERT(queue.front() == (rofl::openflow::cofmsg *)i);
+    CPPUNIT_ASSERT(queue.retrieve() == (rofl::openflow::cofmsg *)i);
+  }
+  CPPUNIT_ASSERT(queue.empty());
+  CPPUNIT_ASSERT(queue.retrieve() == nullptr);
+}
+
+void crofqueuetest::test_front_pop() {
+  const unsigned int num_producers = 8;
+  const unsigned int num_msgs = 20000;
+
+  /* a tiny ring keeps producers spilling over into the overflow list while
+   * the consumer peeks and pops like crofsock::pack_tx_batch() */
+  rofl::crofqueue queue(4);
+  queue.set_queue_max_size(64);
+
+  std::vector<cproducer<rofl::crofqueue>> producers(num_producers);
+  std::vector<pthread_t> tids(num_producers);
+  std::vector<unsigned int> next_seq(num_producers, 1);
+
+  for (unsigned int i = 0; i < num_producers; i++) {
+    producers[i].queue = &queue;
+    producers[i].producer_id = i;
+    producers[i].num_msgs = num_msgs;
+    pthread_create(&tids[i], NULL, &produce<rofl::crofqueue>, &producers[i]);
+  }
+
+  bool in_order = true;
+  unsigned int num_rcvd = 0;
+  while (num_rcvd < num_producers * num_msgs) {
+    rofl::openflow::cofmsg *msg = queue.front();
+    if (msg == nullptr) {
+      sched_yield();
+      continue;
+    }
+    queue.pop();
+    uintptr_t value = (uintptr_t)msg;
+    unsigned int producer_id = value >> 24;
+    unsigned int seq = value & 0xffffff;
+    if ((producer_id >= num_producers) || (next_seq[producer_id] != seq)) {
+      in_order = false;
+    } else {
+      next_seq[producer_id]++;
+    }
+    num_rcvd++;
+  }
+
+  for (unsigned int i = 0; i < num_producers; i++) {
+    pthread_join(tids[i], NULL);
+  }
+
+  /* every message was popped exactly once */
+  CPPUNIT_ASSERT(in_order);
+  CPPUNIT_ASSERT(num_rcvd == num_producers * num_msgs);
+  CPPUNIT_ASSERT(queue.empty());
+  CPPUNIT_ASSERT(queue.front() == nullptr);
+}
@@ -11,12 +11,18 @@
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <list>
+#include <pthread.h>
+
 #include "rofl/common/crofqueue.h"
+#include "rofl/common/locking.hpp"
 
 class crofqueuetest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(crofqueuetest);
   CPPUNIT_TEST(test1);
   CPPUNIT_TEST(test2);
+  CPPUNIT_TEST(test_producers);
+  CPPUNIT_TEST(test_front_pop);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -26,6 +32,62 @@ public:
 public:
   void test1();
   void test2();
+  void test_producers();
+  void test_front_pop();
+
+public:
+  /**
+   * @brief	Former std::list based crofqueue, reference for benchmarking
+   */
+  class clistqueue {
+  public:
+    clistqueue() : queue_max_size(128){};
+
+    size_t store(rofl::openflow::cofmsg *msg, bool enforce = false) {
+      rofl::AcquireReadWriteLock rwlock(queue_lock);
+      if ((not enforce) && (queue.size() >= queue_max_size)) {
+        throw rofl::eRofQueueFull("clistqueue::store() queue max size exceeded",
+                                  __FILE__, __FUNCTION__, __LINE__);
+      }
+      queue.push_back(msg);
+      return queue.size();
+    };
+
+    rofl::openflow::cofmsg *retrieve() {
+      rofl::openflow::cofmsg *msg = (rofl::openflow::cofmsg *)0;
+      rofl::AcquireReadWriteLock rwlock(queue_lock);
+      if (queue.empty()) {
+        return msg;
+      }
+      msg = queue.front();
+      queue.pop_front();
+      return msg;
+    };
+
+    size_t capacity() const {
+      rofl::AcquireReadLock rwlock(queue_lock);
+      return (queue.size() < queue_max_size) ? (queue_max_size - queue.size())
+                                             : 0;
+    };
+
+    clistqueue &set_queue_max_size(size_t queue_max_size) {
+      this->queue_max_size = queue_max_size;
+      return *this;
+    };
+
+  private:
+    std::list<rofl::openflow::cofmsg *> queue;
+    mutable rofl::crwlock queue_lock;
+    size_t queue_max_size;
+  };
+
+public:
+  /**
+   * @brief	Drains messages of num_producers threads, returns seconds
+   */
+  template <class Q>
+  static double run_producers(unsigned int num_producers,
+                              unsigned int num_msgs, bool &in_order);
 };
 
 #endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGAGGRSTATS_TEST_HPP_ */
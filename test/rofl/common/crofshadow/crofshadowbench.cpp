@@ -0,0 +1,107 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofshadowbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "rofl/common/cbenchmark.hpp"
+#include "rofl/common/crofshadow.hpp"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
+
+using namespace rofl::openflow;
+
+namespace {
+
+const uint8_t version = rofl::openflow13::OFP_VERSION;
+
+cofflowmod flowmod(unsigned int i) {
+  cofflowmod fe(version);
+  fe.set_command(rofl::openflow::OFPFC_ADD);
+  fe.set_table_id(0);
+  fe.set_priority(10);
+  fe.set_match().set_eth_dst(rofl::caddress_ll(0x0000b1b2b3000000ULL + i));
+  fe.set_instructions()
+      .set_inst_apply_actions()
+      .set_actions()
+      .add_action_output(rofl::cindex(0))
+      .set_port_no(i % 48);
+  return fe;
+}
+
+/* flow table as dumped by a datapath element, decoded from the wire like
+ * received Flow-Stats-Replies */
+cofflowstatsarray dump(unsigned int first, unsigned int last) {
+  cofflowstatsarray flows(version);
+  for (unsigned int i = first; i < last; i += 256) {
+    cofflowstatsarray chunk(version);
+    for (unsigned int j = i; (j < last) && (j < i + 256); j++) {
+      cofflowmod fe = flowmod(j);
+      cofflow_stats_reply &fs = chunk.add_flow_stats(j);
+      fs.set_table_id(fe.get_table_id());
+      fs.set_priority(fe.get_priority());
+      fs.set_match(fe.get_match());
+      fs.set_instructions(fe.get_instructions());
+    }
+    cofmsg_flow_stats_reply msg(version, 0, 0, chunk);
+    rofl::cmemory mem(msg.length());
+    msg.pack(mem.somem(), mem.length());
+    cofmsg_flow_stats_reply reply;
+    reply.unpack(mem.somem(), mem.length());
+    flows += reply.get_flow_stats_array();
+  }
+  return flows;
+}
+
+}; // end of anonymous namespace
+
+int main(int argc, char **argv) {
+  const unsigned int num_flows = 100000;
+  const unsigned int num_changed = 100;
+  rofl::crofshadow shadow(version);
+
+  double recorded = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_flows; i++) {
+      shadow.record_flow_mod(flowmod(i));
+    }
+  });
+
+  /* the datapath lost the first num_changed entries */
+  cofflowstatsarray flows = dump(num_changed, num_flows);
+  std::list<cofmsg *> msgs;
+  double reconciled = cbenchmark::elapsed([&]() {
+    msgs = shadow.reconcile(flows, cofgroupdescstatsarray(version),
+                            cofmeterconfigarray(version));
+  });
+
+  /* resync via flow_mod_reset() and reinstalling all entries */
+  rofl::cmemory txbuffer(256);
+  uint64_t bytes = 0;
+  double reinstalled = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_flows; i++) {
+      cofmsg_flow_mod msg(version, i, flowmod(i));
+      msg.pack(txbuffer.somem(), msg.length());
+      bytes += msg.length();
+    }
+  });
+
+  uint64_t delta = 0;
+  for (auto msg : msgs) {
+    delta += msg->length();
+    delete msg;
+  }
+
+  std::cout << "crofshadow: #flows=" << num_flows << " record=" << recorded
+            << "s reconcile=" << reconciled << "s msgs=" << msgs.size()
+            << " (" << delta << " bytes), reinstall: msgs=" << (num_flows + 1)
+            << " (" << bytes << " bytes) pack=" << reinstalled << "s"
+            << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,470 @@
+/*
+ * crofshadowtest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "crofshadowtest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(crofshadowtest);
+
+namespace {
+
+cofflowmod flowmod(uint8_t version, uint8_t command, uint8_t table_id,
+                   uint16_t priority, uint64_t dst, uint32_t port_no,
+                   uint64_t cookie = 0) {
+  cofflowmod fe(version);
+  fe.set_command(command);
+  fe.set_table_id(table_id);
+  fe.set_priority(priority);
+  fe.set_cookie(cookie);
+  fe.set_match().set_eth_dst(rofl::caddress_ll(dst));
+  switch (version) {
+  case rofl::openflow10::OFP_VERSION: {
+    fe.set_actions().add_action_output(rofl::cindex(0)).set_port_no(port_no);
+  } break;
+  default: {
+    fe.set_instructions()
+        .set_inst_apply_actions()
+        .set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(port_no);
+  };
+  }
+  return fe;
+}
+
+/* flow table as dumped by a datapath element */
+class cdump {
+public:
+  cdump(uint8_t version) : version(version), array(version), flow_id(0){};
+
+  cdump &add(const cofflowmod &fe) {
+    cofflow_stats_reply &fs = array.add_flow_stats(flow_id++);
+    fs.set_table_id(fe.get_table_id());
+    fs.set_priority(fe.get_priority());
+    fs.set_cookie(fe.get_cookie());
+    fs.set_idle_timeout(fe.get_idle_timeout());
+    fs.set_hard_timeout(fe.get_hard_timeout());
+    fs.set_match(fe.get_match());
+    fs.set_actions(fe.get_actions());
+    fs.set_instructions(fe.get_instructions());
+    return *this;
+  };
+
+  /* decoded from the wire like received Flow-Stats-Replies, split into
+   * chunks fitting into a single message */
+  cofflowstatsarray get() const {
+    cofflowstatsarray flows(version);
+    for (uint32_t first = 0; first < flow_id; first += 256) {
+      cofflowstatsarray chunk(version);
+      for (uint32_t i = first; (i < flow_id) && (i < first + 256); i++)
+        chunk.add_flow_stats(i) = array.get_flow_stats(i);
+      cofmsg_flow_stats_reply msg(version, 0, 0, chunk);
+      rofl::cmemory mem(msg.length());
+      msg.pack(mem.somem(), mem.length());
+      cofmsg_flow_stats_reply reply;
+      reply.unpack(mem.somem(), mem.length());
+      flows += reply.get_flow_stats_array();
+    }
+    return flows;
+  };
+
+private:
+  uint8_t version;
+  cofflowstatsarray array;
+  uint32_t flow_id;
+};
+
+unsigned int count(const std::list<cofmsg *> &msgs, uint8_t type,
+                   uint16_t command) {
+  unsigned int n = 0;
+  for (auto msg : msgs) {
+    if (msg->get_type() != type)
+      continue;
+    switch (type) {
+    case rofl::openflow::OFPT_FLOW_MOD: {
+      cofmsg_flow_mod *fm = dynamic_cast<cofmsg_flow_mod *>(msg);
+      n += (fm->get_flowmod().get_command() == command);
+    } break;
+    case rofl::openflow::OFPT_GROUP_MOD: {
+      cofmsg_group_mod *gm = dynamic_cast<cofmsg_group_mod *>(msg);
+      n += (gm->get_groupmod().get_command() == command);
+    } break;
+    case rofl::openflow13::OFPT_METER_MOD: {
+      n += (dynamic_cast<cofmsg_meter_mod *>(msg)->get_command() == command);
+    } break;
+    default: {};
+    }
+  }
+  return n;
+}
+
+void release(std::list<cofmsg *> &msgs) {
+  for (auto msg : msgs)
+    delete msg;
+  msgs.clear();
+}
+
+}; // end of anonymous namespace
+
+void crofshadowtest::setUp() {}
+
+void crofshadowtest::tearDown() {}
+
+void crofshadowtest::test_record_flows() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 0x0a, 1));
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 20, 0x0a, 2));
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 1, 10, 0x0b, 3));
+  CPPUNIT_ASSERT(shadow.size_flows() == 3);
+
+  /* identical table_id, priority and match replaces an entry */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 0x0a, 4, 0xc0));
+  CPPUNIT_ASSERT(shadow.size_flows() == 3);
+  cofflowmod fe =
+      shadow.get_flow(0, 10, flowmod(version, 0, 0, 10, 0x0a, 0).get_match());
+  CPPUNIT_ASSERT(fe.get_cookie() == 0xc0);
+
+  /* modify-strict replaces instructions, but keeps the cookie */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_MODIFY_STRICT, 0, 10, 0x0a, 5));
+  fe = shadow.get_flow(0, 10, flowmod(version, 0, 0, 10, 0x0a, 0).get_match());
+  CPPUNIT_ASSERT(fe.get_cookie() == 0xc0);
+  CPPUNIT_ASSERT(fe.get_instructions() ==
+                 flowmod(version, 0, 0, 10, 0x0a, 5).get_instructions());
+
+  /* modify of a missing entry is ignored since OpenFlow 1.1 */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_MODIFY_STRICT, 0, 30, 0x0a, 5));
+  CPPUNIT_ASSERT(shadow.size_flows() == 3);
+
+  /* non-strict delete in table 0 only */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_DELETE, 0, 0, 0x0a, 0));
+  CPPUNIT_ASSERT(shadow.size_flows() == 1);
+  CPPUNIT_ASSERT(shadow.has_flow(
+      1, 10, flowmod(version, 0, 1, 10, 0x0b, 0).get_match()));
+
+  /* delete with empty match in all tables */
+  cofflowmod all(version);
+  all.set_command(rofl::openflow::OFPFC_DELETE);
+  all.set_table_id(rofl::openflow13::OFPTT_ALL);
+  shadow.record_flow_mod(all);
+  CPPUNIT_ASSERT(shadow.size_flows() == 0);
+
+  try {
+    shadow.get_flow(1, 10, flowmod(version, 0, 1, 10, 0x0b, 0).get_match());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eShadowNotFound &e) {
+  }
+}
+
+void crofshadowtest::test_record_flows_of10() {
+  uint8_t version = rofl::openflow10::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+
+  /* modify of a missing entry adds it in OpenFlow 1.0 */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_MODIFY, 0, 10, 0x0a, 1));
+  CPPUNIT_ASSERT(shadow.size_flows() == 1);
+
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 0x0b, 2));
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_DELETE_STRICT, 0, 10, 0x0a, 0));
+  CPPUNIT_ASSERT(shadow.size_flows() == 1);
+
+  /* flow removed */
+  shadow.record_flow_removed(
+      0, 10, flowmod(version, 0, 0, 10, 0x0b, 0).get_match());
+  CPPUNIT_ASSERT(shadow.size_flows() == 0);
+}
+
+void crofshadowtest::test_delete_filters() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+
+  for (unsigned int i = 0; i < 8; i++) {
+    shadow.record_flow_mod(flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10,
+                                   0x10 + i, i % 2, 0x100 + i));
+  }
+
+  /* cookie filter */
+  cofflowmod fe(version);
+  fe.set_command(rofl::openflow::OFPFC_DELETE);
+  fe.set_cookie(0x100);
+  fe.set_cookie_mask(0xfff);
+  shadow.record_flow_mod(fe);
+  CPPUNIT_ASSERT(shadow.size_flows() == 7);
+
+  /* out_port filter */
+  fe.set_cookie_mask(0);
+  fe.set_out_port(1);
+  shadow.record_flow_mod(fe);
+  CPPUNIT_ASSERT(shadow.size_flows() == 3);
+
+  /* out_group filter, no entry refers to group 1 */
+  fe.set_out_port(rofl::openflow::OFPP_ANY);
+  fe.set_out_group(1);
+  shadow.record_flow_mod(fe);
+  CPPUNIT_ASSERT(shadow.size_flows() == 3);
+
+  /* a different cookie prevents a strict delete */
+  cofflowmod strict =
+      flowmod(version, rofl::openflow::OFPFC_DELETE_STRICT, 0, 10, 0x12, 0);
+  strict.set_cookie(0x200);
+  strict.set_cookie_mask(0xfff);
+  shadow.record_flow_mod(strict);
+  CPPUNIT_ASSERT(shadow.size_flows() == 3);
+  strict.set_cookie(0x102);
+  shadow.record_flow_mod(strict);
+  CPPUNIT_ASSERT(shadow.size_flows() == 2);
+}
+
+void crofshadowtest::test_record_groups_meters() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+
+  for (uint32_t group_id = 1; group_id <= 4; group_id++) {
+    cofgroupmod ge(version, rofl::openflow::OFPGC_ADD,
+                   rofl::openflow::OFPGT_ALL, group_id);
+    shadow.record_group_mod(ge);
+  }
+  cofgroupmod ge(version, rofl::openflow::OFPGC_MODIFY,
+                 rofl::openflow::OFPGT_INDIRECT, 2);
+  shadow.record_group_mod(ge);
+  CPPUNIT_ASSERT(shadow.size_groups() == 4);
+  CPPUNIT_ASSERT(shadow.get_group(2).get_type() ==
+                 rofl::openflow::OFPGT_INDIRECT);
+  CPPUNIT_ASSERT(shadow.get_group(2).get_command() ==
+                 rofl::openflow::OFPGC_ADD);
+
+  ge.set_command(rofl::openflow::OFPGC_DELETE);
+  shadow.record_group_mod(ge);
+  CPPUNIT_ASSERT(not shadow.has_group(2));
+  ge.set_group_id(rofl::openflow::OFPG_ALL);
+  shadow.record_group_mod(ge);
+  CPPUNIT_ASSERT(shadow.size_groups() == 0);
+
+  cofmeter_bands bands(version);
+  bands.add_meter_band_drop(0).set_rate(1000);
+  shadow.record_meter_mod(rofl::openflow13::OFPMC_ADD,
+                          rofl::openflow13::OFPMF_KBPS, 1, bands);
+  shadow.record_meter_mod(rofl::openflow13::OFPMC_ADD,
+                          rofl::openflow13::OFPMF_KBPS, 2, bands);
+  CPPUNIT_ASSERT(shadow.size_meters() == 2);
+  CPPUNIT_ASSERT(shadow.get_meter(1).get_flags() ==
+                 rofl::openflow13::OFPMF_KBPS);
+  shadow.record_meter_mod(rofl::openflow13::OFPMC_DELETE, 0, 1,
+                          cofmeter_bands(version));
+  CPPUNIT_ASSERT(not shadow.has_meter(1));
+
+  /* messages as sent by crofdpt */
+  cofmsg_meter_mod mm(version, 0, rofl::openflow13::OFPMC_DELETE, 0,
+                      rofl::openflow13::OFPM_ALL);
+  shadow.record_message(mm);
+  CPPUNIT_ASSERT(shadow.size_meters() == 0);
+  cofmsg_flow_mod fm(version, 0,
+                     flowmod(version, rofl::openflow::OFPFC_ADD, 0, 1, 0x1, 1));
+  shadow.record_message(fm);
+  CPPUNIT_ASSERT(shadow.size_flows() == 1);
+
+  /* wire format as recorded once queued for transmission */
+  cofmsg_flow_mod fm2(version, 0,
+                      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 2, 0x2, 1));
+  rofl::cmemory frame(fm2.length());
+  fm2.pack(frame.somem(), frame.length());
+  shadow.record_frame(frame);
+  CPPUNIT_ASSERT(shadow.size_flows() == 2);
+  CPPUNIT_ASSERT(shadow.has_flow(0, 2, fm2.get_flowmod().get_match()));
+
+  /* a different version drops all entries */
+  shadow.set_version(rofl::openflow12::OFP_VERSION);
+  CPPUNIT_ASSERT(shadow.size_flows() == 0);
+}
+
+void crofshadowtest::test_reconcile() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+  cdump dump(version);
+
+  /* identical on both sides */
+  cofflowmod same = flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 1, 1);
+  shadow.record_flow_mod(same);
+  dump.add(same);
+
+  /* missing on the datapath element */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 2, 2));
+
+  /* instructions differ */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 1, 10, 3, 3));
+  dump.add(flowmod(version, rofl::openflow::OFPFC_ADD, 1, 10, 3, 4));
+
+  /* cookie differs */
+  shadow.record_flow_mod(
+      flowmod(version, rofl::openflow::OFPFC_ADD, 1, 20, 3, 3, 0xc1));
+  dump.add(flowmod(version, rofl::openflow::OFPFC_ADD, 1, 20, 3, 3, 0xc2));
+
+  /* unknown to the shadow */
+  dump.add(flowmod(version, rofl::openflow::OFPFC_ADD, 2, 10, 4, 4));
+
+  /* expired on the datapath element */
+  cofflowmod transient =
+      flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 5, 5);
+  transient.set_idle_timeout(30);
+  shadow.record_flow_mod(transient);
+
+  std::list<cofmsg *> msgs =
+      shadow.reconcile(dump.get(), cofgroupdescstatsarray(version),
+                       cofmeterconfigarray(version));
+
+  CPPUNIT_ASSERT(msgs.size() == 4);
+  CPPUNIT_ASSERT(
+      count(msgs, rofl::openflow::OFPT_FLOW_MOD, rofl::openflow::OFPFC_ADD) ==
+      3);
+  CPPUNIT_ASSERT(count(msgs, rofl::openflow::OFPT_FLOW_MOD,
+                       rofl::openflow::OFPFC_DELETE_STRICT) == 1);
+
+  /* deletes are sent first */
+  const cofflowmod &del =
+      dynamic_cast<cofmsg_flow_mod *>(msgs.front())->get_flowmod();
+  CPPUNIT_ASSERT(del.get_command() == rofl::openflow::OFPFC_DELETE_STRICT);
+  CPPUNIT_ASSERT(del.get_table_id() == 2);
+  CPPUNIT_ASSERT(del.get_match().get_eth_dst() == rofl::caddress_ll(4));
+
+  CPPUNIT_ASSERT(shadow.size_flows() == 4);
+  CPPUNIT_ASSERT(not shadow.has_flow(0, 10, transient.get_match()));
+
+  /* the datapath element is in sync after applying the messages */
+  cdump synced(version);
+  synced.add(same);
+  synced.add(flowmod(version, rofl::openflow::OFPFC_ADD, 0, 10, 2, 2));
+  synced.add(flowmod(version, rofl::openflow::OFPFC_ADD, 1, 10, 3, 3));
+  synced.add(flowmod(version, rofl::openflow::OFPFC_ADD, 1, 20, 3, 3, 0xc1));
+  release(msgs);
+  msgs = shadow.reconcile(synced.get(), cofgroupdescstatsarray(version),
+                          cofmeterconfigarray(version));
+  CPPUNIT_ASSERT(msgs.empty());
+}
+
+void crofshadowtest::test_reconcile_groups_meters() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+
+  cofgroupmod ge(version, rofl::openflow::OFPGC_ADD, rofl::openflow::OFPGT_ALL,
+                 1);
+  ge.set_buckets().add_bucket(0).set_actions().add_action_output(
+      rofl::cindex(0)).set_port_no(1);
+  shadow.record_group_mod(ge);
+  ge.set_group_id(2);
+  shadow.record_group_mod(ge);
+
+  cofgroupdescstatsarray groups(version);
+  groups.add_group_desc_stats(1)
+      .set_group_type(rofl::openflow::OFPGT_ALL)
+      .set_buckets(ge.get_buckets());
+  groups.add_group_desc_stats(3).set_group_type(rofl::openflow::OFPGT_ALL);
+
+  cofmeter_bands bands(version);
+  bands.add_meter_band_drop(0).set_rate(1000);
+  shadow.record_meter_mod(rofl::openflow13::OFPMC_ADD,
+                          rofl::openflow13::OFPMF_KBPS, 1, bands);
+
+  cofmeterconfigarray meters(version);
+  meters.add_meter_config(0)
+      .set_meter_id(1)
+      .set_flags(rofl::openflow13::OFPMF_KBPS)
+      .set_meter_bands(bands);
+  meters.add_meter_config(1).set_meter_id(5);
+
+  std::list<cofmsg *> msgs =
+      shadow.reconcile(cdump(version).get(), groups, meters);
+
+  /* group 2 added, group 3 and meter 5 deleted */
+  CPPUNIT_ASSERT(msgs.size() == 3);
+  CPPUNIT_ASSERT(count(msgs, rofl::openflow::OFPT_GROUP_MOD,
+                       rofl::openflow::OFPGC_ADD) == 1);
+  CPPUNIT_ASSERT(count(msgs, rofl::openflow::OFPT_GROUP_MOD,
+                       rofl::openflow::OFPGC_DELETE) == 1);
+  CPPUNIT_ASSERT(count(msgs, rofl::openflow13::OFPT_METER_MOD,
+                       rofl::openflow13::OFPMC_DELETE) == 1);
+  CPPUNIT_ASSERT(msgs.front()->get_type() == rofl::openflow::OFPT_GROUP_MOD);
+  CPPUNIT_ASSERT(msgs.back()->get_type() == rofl::openflow::OFPT_GROUP_MOD);
+  release(msgs);
+
+  /* changed meter bands */
+  cofmeter_bands other(version);
+  other.add_meter_band_drop(0).set_rate(2000);
+  shadow.record_meter_mod(rofl::openflow13::OFPMC_MODIFY,
+                          rofl::openflow13::OFPMF_KBPS, 1, other);
+  msgs = shadow.reconcile(cdump(version).get(), groups, meters);
+  CPPUNIT_ASSERT(count(msgs, rofl::openflow13::OFPT_METER_MOD,
+                       rofl::openflow13::OFPMC_MODIFY) == 1);
+  release(msgs);
+}
+
+void crofshadowtest::test_reconcile_group_chains() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::crofshadow shadow(version);
+
+  /* group 1 -> group 3 -> group 2 */
+  cofgroupmod ge(version, rofl::openflow::OFPGC_ADD, rofl::openflow::OFPGT_ALL,
+                 2);
+  ge.set_buckets().add_bucket(0).set_actions().add_action_output(
+      rofl::cindex(0)).set_port_no(1);
+  shadow.record_group_mod(ge);
+  ge.set_group_id(3);
+  ge.set_buckets().set_bucket(0).set_actions().clear();
+  ge.set_buckets().set_bucket(0).set_actions().add_action_group(
+      rofl::cindex(0)).set_group_id(2);
+  shadow.record_group_mod(ge);
+  ge.set_group_id(1);
+  ge.set_buckets().set_bucket(0).set_actions().set_action_group(
+      rofl::cindex(0)).set_group_id(3);
+  shadow.record_group_mod(ge);
+
+  /* stale group 7 -> group 9 */
+  cofgroupdescstatsarray groups(version);
+  groups.add_group_desc_stats(9).set_group_type(rofl::openflow::OFPGT_ALL);
+  groups.add_group_desc_stats(7)
+      .set_group_type(rofl::openflow::OFPGT_ALL)
+      .set_buckets()
+      .add_bucket(0)
+      .set_actions()
+      .add_action_group(rofl::cindex(0))
+      .set_group_id(9);
+
+  std::list<cofmsg *> msgs = shadow.reconcile(
+      cdump(version).get(), groups, cofmeterconfigarray(version));
+
+  std::vector<uint32_t> adds, dels;
+  for (auto msg : msgs) {
+    const cofgroupmod &gm =
+        dynamic_cast<cofmsg_group_mod *>(msg)->get_groupmod();
+    if (gm.get_command() == rofl::openflow::OFPGC_ADD) {
+      adds.push_back(gm.get_group_id());
+    } else {
+      dels.push_back(gm.get_group_id());
+    }
+  }
+  CPPUNIT_ASSERT(adds == std::vector<uint32_t>({2, 3, 1}));
+  CPPUNIT_ASSERT(dels == std::vector<uint32_t>({7, 9}));
+  release(msgs);
+}
@@ -0,0 +1,44 @@
+/*
+ * crofshadowtest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CROFSHADOW_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CROFSHADOW_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/crofshadow.hpp"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_group_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_mod.h"
+
+class crofshadowtest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(crofshadowtest);
+  CPPUNIT_TEST(test_record_flows);
+  CPPUNIT_TEST(test_record_flows_of10);
+  CPPUNIT_TEST(test_delete_filters);
+  CPPUNIT_TEST(test_record_groups_meters);
+  CPPUNIT_TEST(test_reconcile);
+  CPPUNIT_TEST(test_reconcile_groups_meters);
+  CPPUNIT_TEST(test_reconcile_group_chains);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void test_record_flows();
+  void test_record_flows_of10();
+  void test_delete_filters();
+  void test_record_groups_meters();
+  void test_reconcile();
+  void test_reconcile_groups_meters();
+  void test_reconcile_group_chains();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CROFSHADOW_TEST_HPP_ */
@@ -7,6 +7,9 @@
 
 #include <stdlib.h>
 
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
 
@@ -85,62 +88,228 @@ void crofsocktest::test() {
   }
 }
 
-void crofsocktest::test_tls() {
+void crofsocktest::test_burst() {
   try {
-    test_mode = TEST_MODE_TLS;
-    keep_running = true;
-    timeout = 60;
-    msg_counter = 0;
-
-    slisten = new rofl::crofsock(this);
-    sclient = new rofl::crofsock(this);
-
-    /* try to find idle port for test */
-    bool lookup_idle_port = true;
-    while (lookup_idle_port) {
-      do {
-        listening_port = rand.uint16();
-      } while ((listening_port < 10000) || (listening_port > 49000));
-      try {
-        std::cerr << "trying listening port=" << (int)listening_port
-                  << std::endl;
-        baddr =
-            rofl::csockaddr(rofl::caddress_in4("127.0.0.1"), listening_port);
-        /* try to bind address first */
-        slisten->set_baddr(baddr).listen();
-        std::cerr << "binding to " << baddr.str() << std::endl;
-        lookup_idle_port = false;
-      } catch (rofl::eSysCall &e) {
-        /* port in use, try another one */
+    for (unsigned int i = 0; i < 4; i++) {
+      test_mode = TEST_MODE_BURST;
+      keep_running = true;
+      timeout = 600; // in 100ms units
+      listening_port = 0;
+      tx_batching = ((i & 1) == 0);
+      rx_streaming = ((i & 2) == 0);
+      burst_msgs_rcvd = 0;
+      burst_error = false;
+
+      slisten = new rofl::crofsock(this);
+      sclient = new rofl::crofsock(this);
+      sclient->set_tx_batching(tx_batching);
+
+      /* try to find idle port for test */
+      bool lookup_idle_port = true;
+      while (lookup_idle_port) {
+        do {
+          listening_port = rand.uint16();
+        } while ((listening_port < 10000) || (listening_port > 49000));
+        try {
+          baddr =
+              rofl::csockaddr(rofl::caddress_in4("127.0.0.1"), listening_port);
+          /* try to bind address first */
+          slisten->set_baddr(baddr).listen();
+          lookup_idle_port = false;
+        } catch (rofl::eSysCall &e) {
+          /* port in use, try another one */
+        }
       }
-    }
 
-    sclient->set_raddr(baddr)
-        .set_tls_cafile("../../../../../tools/xca/ca.rofl-core.crt.pem")
-        .set_tls_certfile("../../../../../tools/xca/client.crt.pem")
-        .set_tls_keyfile("../../../../../tools/xca/client.key.pem")
-        .tls_connect(true);
-
-    while (keep_running && (--timeout > 0)) {
-      struct timespec ts;
-      ts.tv_sec = 1;
-      ts.tv_nsec = 0;
-      pselect(0, NULL, NULL, NULL, &ts, NULL);
+      rofl::ctimespec start = rofl::ctimespec::now();
+
+      sclient->set_raddr(baddr).tcp_connect(true);
+
+      while (keep_running && (--timeout > 0)) {
+        struct timespec ts;
+        ts.tv_sec = 0;
+        ts.tv_nsec = 100000000;
+        pselect(0, NULL, NULL, NULL, &ts, NULL);
+      }
+
+      rofl::ctimespec stop = rofl::ctimespec::now();
+      std::cerr << "crofsocktest::test_burst() tx_batching=" << tx_batching
+                << " rx_streaming=" << rx_streaming
+                << " msgs=" << burst_msgs_rcvd << " elapsed="
+                << (stop.get_tspec().tv_sec - start.get_tspec().tv_sec) * 1000 +
+                       (stop.get_tspec().tv_nsec - start.get_tspec().tv_nsec) /
+                           1000000
+                << "ms" << std::endl;
+
+      CPPUNIT_ASSERT(timeout > 0);
+      CPPUNIT_ASSERT(not burst_error);
+      CPPUNIT_ASSERT(burst_msgs_rcvd == BURST_SIZE);
+
+      slisten->close();
+      sclient->close();
+      sserver->close();
+
+      delete slisten;
+      delete sclient;
+      delete sserver;
     }
 
-    CPPUNIT_ASSERT(timeout > 0);
+  } catch (rofl::eSysCall &e) {
+    std::cerr << "crofsocktest::test_burst() exception, what: " << e.what()
+              << std::endl;
+  } catch (std::runtime_error &e) {
+    std::cerr << "crofsocktest::test_burst() exception, what: " << e.what()
+              << std::endl;
+  }
+}
+
+void crofsocktest::test_tls() {
+  char certfile[] = "/tmp/crofsocktest.crt.XXXXXX";
+  char keyfile[] = "/tmp/crofsocktest.key.XXXXXX";
+  int certfd = mkstemp(certfile);
+  int keyfd = mkstemp(keyfile);
+  CPPUNIT_ASSERT((certfd >= 0) && (keyfd >= 0));
+  ::close(certfd);
+  ::close(keyfd);
+  CPPUNIT_ASSERT(write_self_signed_cert(certfile, keyfile));
+  tls_certfile = certfile;
+  tls_keyfile = keyfile;
+
+  try {
+    for (unsigned int i = 0; i < 4; i++) {
+      test_mode = ((i & 2) == 0) ? TEST_MODE_TLS : TEST_MODE_TLS_BURST;
+      ktls = ((i & 1) == 1);
+      keep_running = true;
+      timeout = 600; // in 100ms units
+      server_msg_counter = 0;
+      client_msg_counter = 0;
+      burst_msgs_rcvd = 0;
+      burst_error = false;
 
-    delete slisten;
-    delete sclient;
-    delete sserver;
+      slisten = new rofl::crofsock(this);
+      sclient = new rofl::crofsock(this);
+
+      /* try to find idle port for test */
+      bool lookup_idle_port = true;
+      while (lookup_idle_port) {
+        do {
+          listening_port = rand.uint16();
+        } while ((listening_port < 10000) || (listening_port > 49000));
+        try {
+          baddr =
+              rofl::csockaddr(rofl::caddress_in4("127.0.0.1"), listening_port);
+          /* try to bind address first */
+          slisten->set_baddr(baddr).listen();
+          lookup_idle_port = false;
+        } catch (rofl::eSysCall &e) {
+          /* port in use, try another one */
+        }
+      }
+
+      rofl::ctimespec start = rofl::ctimespec::now();
+
+      /* self-signed certificate serves as its own CA on both sides */
+      sclient->set_raddr(baddr)
+          .set_tls_cafile(tls_certfile)
+          .set_tls_certfile(tls_certfile)
+          .set_tls_keyfile(tls_keyfile)
+          .set_tls_ktls(ktls)
+          .tls_connect(true);
+
+      while (keep_running && (--timeout > 0)) {
+        struct timespec ts;
+        ts.tv_sec = 0;
+        ts.tv_nsec = 100000000;
+        pselect(0, NULL, NULL, NULL, &ts, NULL);
+      }
+
+      rofl::ctimespec stop = rofl::ctimespec::now();
+      std::cerr << "crofsocktest::test_tls() ktls=" << ktls
+                << " ktls_tx=" << sclient->is_ktls_tx()
+                << " ktls_rx=" << sclient->is_ktls_rx()
+                << " msgs=" << (server_msg_counter + client_msg_counter +
+                                burst_msgs_rcvd)
+                << " elapsed="
+                << (stop.get_tspec().tv_sec - start.get_tspec().tv_sec) * 1000 +
+                       (stop.get_tspec().tv_nsec - start.get_tspec().tv_nsec) /
+                           1000000
+                << "ms" << std::endl;
+
+      CPPUNIT_ASSERT(timeout > 0);
+      CPPUNIT_ASSERT(sclient->is_tls_encrypted());
+      CPPUNIT_ASSERT(not burst_error);
+      if (test_mode == TEST_MODE_TLS_BURST) {
+        CPPUNIT_ASSERT(burst_msgs_rcvd == BURST_SIZE);
+      }
+      if (not ktls) {
+        CPPUNIT_ASSERT(not sclient->is_ktls_tx());
+        CPPUNIT_ASSERT(not sclient->is_ktls_rx());
+      }
+
+      slisten->close();
+      sclient->close();
+      sserver->close();
+
+      delete slisten;
+      delete sclient;
+      delete sserver;
+    }
 
   } catch (rofl::eSysCall &e) {
-    std::cerr << "crofsocktest::test() exception, what: " << e.what()
+    std::cerr << "crofsocktest::test_tls() exception, what: " << e.what()
               << std::endl;
   } catch (std::runtime_error &e) {
-    std::cerr << "crofsocktest::test() exception, what: " << e.what()
+    std::cerr << "crofsocktest::test_tls() exception, what: " << e.what()
               << std::endl;
   }
+
+  unlink(certfile);
+  unlink(keyfile);
+}
+
+bool crofsocktest::write_self_signed_cert(const std::string &certfile,
+                                          const std::string &keyfile) {
+  bool ok = false;
+  EVP_PKEY *pkey = NULL;
+  X509 *cert = NULL;
+  FILE *fp = NULL;
+
+  EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+  if ((pctx == NULL) || (EVP_PKEY_keygen_init(pctx) <= 0) ||
+      (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(pctx, NID_X9_62_prime256v1) <=
+       0) ||
+      (EVP_PKEY_keygen(pctx, &pkey) <= 0))
+    goto out;
+
+  cert = X509_new();
+  X509_set_version(cert, 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+  X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+  X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 3600);
+  X509_set_pubkey(cert, pkey);
+  X509_NAME_add_entry_by_txt(X509_get_subject_name(cert), "CN", MBSTRING_ASC,
+                             (const unsigned char *)"crofsocktest", -1, -1, 0);
+  X509_set_issuer_name(cert, X509_get_subject_name(cert));
+  if (X509_sign(cert, pkey, EVP_sha256()) <= 0)
+    goto out;
+
+  if ((fp = fopen(certfile.c_str(), "w")) == NULL)
+    goto out;
+  ok = (PEM_write_X509(fp, cert) == 1);
+  fclose(fp);
+
+  if ((fp = fopen(keyfile.c_str(), "w")) == NULL) {
+    ok = false;
+    goto out;
+  }
+  ok = ok && (PEM_write_PrivateKey(fp, pkey, NULL, NULL, 0, NULL, NULL) == 1);
+  fclose(fp);
+
+out:
+  X509_free(cert);
+  EVP_PKEY_free(pkey);
+  EVP_PKEY_CTX_free(pctx);
+  return ok;
 }
 
 void crofsocktest::handle_listen(rofl::crofsock &socket) {
@@ -157,10 +326,16 @@ void crofsocktest::handle_listen(rofl::crofsock &socket) {
       sserver->tcp_accept(sd);
 
     } break;
-    case TEST_MODE_TLS: {
-      sserver->set_tls_cafile("../../../../../tools/xca/ca.rofl-core.crt.pem")
-          .set_tls_certfile("../../../../../tools/xca/server.crt.pem")
-          .set_tls_keyfile("../../../../../tools/xca/server.key.pem")
+    case TEST_MODE_BURST: {
+      sserver->set_rx_streaming(rx_streaming).tcp_accept(sd);
+
+    } break;
+    case TEST_MODE_TLS:
+    case TEST_MODE_TLS_BURST: {
+      sserver->set_tls_cafile(tls_certfile)
+          .set_tls_certfile(tls_certfile)
+          .set_tls_keyfile(tls_keyfile)
+          .set_tls_ktls(ktls)
           .tls_accept(sd);
     } break;
     default: {};
@@ -187,6 +362,19 @@ void crofsocktest::handle_tcp_connected(rofl::crofsock &socket) {
 
     sclient->send_message(hello);
 
+  } break;
+  case TEST_MODE_BURST: {
+
+    /* queue the whole burst at once, the txthread drains it; an odd
+     * message length lets messages straddle read boundaries */
+    rofl::cmemory data(13);
+    for (unsigned int xid = 0; xid < BURST_SIZE; xid++) {
+      sclient->send_message(
+          new cofmsg_echo_request(rofl::openflow13::OFP_VERSION, xid,
+                                  data.somem(), data.length()),
+          /*enforce_queueing=*/true);
+    }
+
   } break;
   case TEST_MODE_TLS: {
 
@@ -246,6 +434,19 @@ void crofsocktest::congestion_occured_indication(rofl::crofsock &socket) {
 
 void crofsocktest::handle_recv(rofl::crofsock &socket,
                                rofl::openflow::cofmsg *msg) {
+  if ((test_mode == TEST_MODE_BURST) || (test_mode == TEST_MODE_TLS_BURST)) {
+    /* all messages must arrive complete and in order */
+    if ((&socket != sserver) || (msg->get_xid() != burst_msgs_rcvd)) {
+      burst_error = true;
+    }
+    delete msg;
+
+    if (++burst_msgs_rcvd >= BURST_SIZE) {
+      keep_running = false;
+    }
+    return;
+  }
+
   if (&socket == sserver) {
     std::cerr << "sserver => handle recv " << std::endl << *msg;
     delete msg;
@@ -292,6 +493,18 @@ void crofsocktest::handle_tls_connect_failed(rofl::crofsock &socket) {
 void crofsocktest::handle_tls_connected(rofl::crofsock &socket) {
   std::cerr << "handle tls connected" << std::endl;
 
+  if (test_mode == TEST_MODE_TLS_BURST) {
+    /* many small messages, packed into few large TLS records */
+    rofl::cmemory data(13);
+    for (unsigned int xid = 0; xid < BURST_SIZE; xid++) {
+      sclient->send_message(
+          new cofmsg_echo_request(rofl::openflow13::OFP_VERSION, xid,
+                                  data.somem(), data.length()),
+          /*enforce_queueing=*/true);
+    }
+    return;
+  }
+
   rofl::openflow::cofmsg_hello *hello =
       new cofmsg_hello(rofl::openflow13::OFP_VERSION, 0xa1a2a3a4);
 
@@ -305,6 +518,9 @@ void crofsocktest::handle_tls_accept_failed(rofl::crofsock &socket) {
 void crofsocktest::handle_tls_accepted(rofl::crofsock &socket) {
   std::cerr << "handle tls accepted" << std::endl;
 
+  if (test_mode == TEST_MODE_TLS_BURST)
+    return;
+
   rofl::openflow::cofmsg_features_request *features =
       new cofmsg_features_request(rofl::openflow13::OFP_VERSION, 0xb1b2b3b4);
 
@@ -18,7 +18,8 @@
 class crofsocktest : public CppUnit::TestFixture, public rofl::crofsock_env {
   CPPUNIT_TEST_SUITE(crofsocktest);
   CPPUNIT_TEST(test);
-  //	CPPUNIT_TEST( test_tls );
+  CPPUNIT_TEST(test_burst);
+  CPPUNIT_TEST(test_tls);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -28,6 +29,11 @@ public:
 public:
   void test();
   void test_tls();
+  void test_burst();
+
+private:
+  static bool write_self_signed_cert(const std::string &certfile,
+                                     const std::string &keyfile);
 
 private:
   virtual void handle_listen(rofl::crofsock &socket);
@@ -64,20 +70,31 @@ private:
   enum crofsock_test_mode_t {
     TEST_MODE_TCP = 1,
     TEST_MODE_TLS = 2,
+    TEST_MODE_BURST = 3,
+    TEST_MODE_TLS_BURST = 4,
   };
 
+  static const unsigned int BURST_SIZE = 20000;
+
   enum crofsock_test_mode_t test_mode;
   std::atomic_bool keep_running;
   int timeout;
   int msg_counter;
   std::atomic_int server_msg_counter;
-  int client_msg_counter;
+  std::atomic_int client_msg_counter;
   rofl::crandom rand;
   uint16_t listening_port;
   rofl::csockaddr baddr;
   rofl::crofsock *slisten;
   rofl::crofsock *sclient;
   rofl::crofsock *sserver;
+  bool tx_batching;
+  bool rx_streaming;
+  std::atomic_uint burst_msgs_rcvd;
+  std::atomic_bool burst_error;
+  bool ktls;
+  std::string tls_certfile;
+  std::string tls_keyfile;
 };
 
 #endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGAGGRSTATS_TEST_HPP_ */
@@ -0,0 +1,57 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * crofsockrelaybench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "crofsockrelaytest.hpp"
+
+/* reuses the sockets and proxy of the relay test fixture */
+class crofsockrelaybench : public crofsockrelaytest {
+public:
+  void run();
+
+private:
+  static const unsigned int BURST_SIZE = 20000;
+
+  static const unsigned int PINGPONG_SIZE = 2000;
+};
+
+void crofsockrelaybench::run() {
+  setUp();
+
+  start(false);
+  double t_direct = run_echo(PINGPONG_SIZE, true);
+  stop();
+
+  start(true);
+  double t_relayed = run_echo(PINGPONG_SIZE, true);
+  double t_burst = run_echo(BURST_SIZE, false);
+  if ((frames_relayed != 2 * (PINGPONG_SIZE + BURST_SIZE)) || relay_error) {
+    std::cerr << "crofsockrelay: relay error" << std::endl;
+  }
+  stop();
+
+  tearDown();
+
+  double rtt_direct = t_direct * 1e6 / PINGPONG_SIZE;
+  double rtt_relayed = t_relayed * 1e6 / PINGPONG_SIZE;
+  std::cout << "crofsockrelay: round trip direct: " << rtt_direct
+            << " us relayed: " << rtt_relayed
+            << " us added: " << (rtt_relayed - rtt_direct) << " us, burst of "
+            << BURST_SIZE << " echo requests: "
+            << (unsigned long)(2 * BURST_SIZE / t_burst) << " relayed msgs/s"
+            << std::endl;
+}
+
+int main(int argc, char **argv) {
+  crofsockrelaybench bench;
+  bench.run();
+  return 0;
+}
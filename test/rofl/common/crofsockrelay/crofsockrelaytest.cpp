@@ -0,0 +1,344 @@
+/*
+ * crofsockrelaytest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <set>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "crofsockrelaytest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+#include "rofl/common/openflow/messages/cofmsg_frame.h"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(crofsockrelaytest);
+
+void crofsockrelaytest::setUp() {
+  relayed = false;
+  lproxy = lserver = nullptr;
+  client = pdown = pup = server = nullptr;
+  echo_num = 0;
+  echo_pingpong = false;
+  echo_sent = echo_rcvd = 0;
+  frames_relayed = 0;
+  proxy_msgs_rcvd = 0;
+  num_retained = 0;
+  relay_error = false;
+}
+
+void crofsockrelaytest::tearDown() {}
+
+void crofsockrelaytest::testFrame() {
+  uint8_t data[] = {1, 2, 3, 4, 5};
+  cofmsg_echo_request echo(rofl::openflow13::OFP_VERSION, 0xa1a2a3a4, data,
+                           sizeof(data));
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(echo.length()));
+  echo.pack(chunk->somem(), chunk->length());
+
+  /* frame refers to chunk */
+  cofmsg_frame frame(rofl::cslice(chunk, 0, chunk->length()));
+  CPPUNIT_ASSERT(chunk.use_count() == 2);
+  CPPUNIT_ASSERT(frame.get_frame().somem() == chunk->somem());
+  CPPUNIT_ASSERT(frame.get_version() == rofl::openflow13::OFP_VERSION);
+  CPPUNIT_ASSERT(frame.get_type() == rofl::openflow::OFPT_ECHO_REQUEST);
+  CPPUNIT_ASSERT(frame.get_xid() == 0xa1a2a3a4);
+  CPPUNIT_ASSERT(frame.length() == echo.length());
+
+  /* only the xid is rewritten */
+  frame.set_xid(0xb1b2b3b4);
+  rofl::cmemory mem(frame.length());
+  frame.pack(mem.somem(), mem.length());
+  cofmsg_echo_request parsed;
+  parsed.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(parsed.get_xid() == 0xb1b2b3b4);
+  CPPUNIT_ASSERT(parsed.get_body() == echo.get_body());
+  CPPUNIT_ASSERT(be32toh(((struct ofp_header *)chunk->somem())->xid) ==
+                 0xa1a2a3a4);
+
+  cofwriter writer;
+  writer.put8(0xff);
+  frame.serialize(writer);
+  CPPUNIT_ASSERT(writer.length() == 1 + mem.length());
+  CPPUNIT_ASSERT(0 == memcmp(writer.at(1), mem.somem(), mem.length()));
+
+  /* trailing bytes of the receive buffer are not part of the frame */
+  std::shared_ptr<rofl::cmemory> larger(new rofl::cmemory(*chunk));
+  larger->resize(chunk->length() + 16);
+  cofmsg_frame shorter(rofl::cslice(larger, 0, larger->length()));
+  CPPUNIT_ASSERT(shorter.length() == chunk->length());
+
+  /* copies own a chunk of their own */
+  cofmsg_frame copy;
+  copy.unpack(chunk->somem(), chunk->length());
+  CPPUNIT_ASSERT(copy.get_frame().somem() != chunk->somem());
+  CPPUNIT_ASSERT(copy.length() == chunk->length());
+
+  /* chunk lives as long as frames refer to it */
+  std::weak_ptr<rofl::cmemory> weak(chunk);
+  chunk.reset();
+  CPPUNIT_ASSERT(not weak.expired());
+  frame = copy;
+  CPPUNIT_ASSERT(weak.expired());
+}
+
+void crofsockrelaytest::testRelay() {
+  start(true);
+
+  /* not relayed, decoded by proxy */
+  client.load()->send_message(new cofmsg_features_request(
+      rofl::openflow13::OFP_VERSION, 0xc1c2c3c4));
+  CPPUNIT_ASSERT(wait([&]() { return proxy_msgs_rcvd == 1; }));
+
+  run_echo(100, false);
+  CPPUNIT_ASSERT(echo_rcvd == 100);
+  CPPUNIT_ASSERT(frames_relayed == 200);
+  CPPUNIT_ASSERT(proxy_msgs_rcvd == 1);
+  CPPUNIT_ASSERT(not relay_error);
+
+  stop();
+}
+
+void crofsockrelaytest::testRetain() {
+  const unsigned int num = 4 * rofl::crofsock::RXBUFFER_MAX_PINNED;
+  start(false);
+  server.load()->set_rx_passthrough(rofl::openflow::OFPT_ECHO_REQUEST);
+
+  /* one frame per read, every retained frame pins the chunk it was read to */
+  uint8_t data[32];
+  memset(data, 0xee, sizeof(data));
+  for (unsigned int i = 0; i < num; i++) {
+    client.load()->send_message(new cofmsg_echo_request(
+        rofl::openflow13::OFP_VERSION, i, data, sizeof(data)));
+    CPPUNIT_ASSERT(wait([&]() { return num_retained == i + 1; }));
+  }
+
+  /* frames beyond the cap are copied out instead of pinning further chunks */
+  std::set<rofl::cmemory *> chunks;
+  for (auto &frame : frames_retained) {
+    CPPUNIT_ASSERT(frame.length() == sizeof(struct ofp_header) + sizeof(data));
+    if (frame.get_chunk()->memlen() > frame.length())
+      chunks.insert(frame.get_chunk().get());
+  }
+  CPPUNIT_ASSERT(chunks.size() <= rofl::crofsock::RXBUFFER_MAX_PINNED + 1);
+  CPPUNIT_ASSERT(frames_retained.back().get_chunk()->memlen() ==
+                 frames_retained.back().length());
+  CPPUNIT_ASSERT(
+      be32toh(((struct ofp_header *)frames_retained.back().somem())->xid) ==
+      num - 1);
+  CPPUNIT_ASSERT(not relay_error);
+
+  stop();
+  frames_retained.clear();
+}
+
+void crofsockrelaytest::start(bool relayed) {
+  this->relayed = relayed;
+  client = pdown = pup = server = nullptr;
+  frames_relayed = 0;
+  proxy_msgs_rcvd = 0;
+
+  lserver = new rofl::crofsock(this);
+  rofl::csockaddr saddr = listen(lserver);
+  rofl::csockaddr caddr = saddr;
+
+  if (relayed) {
+    lproxy = new rofl::crofsock(this);
+    caddr = listen(lproxy);
+
+    rofl::crofsock *sock = new rofl::crofsock(this);
+    pup = sock;
+    sock->set_rx_passthrough(rofl::openflow::OFPT_ECHO_REPLY)
+        .set_raddr(saddr)
+        .tcp_connect(true);
+    CPPUNIT_ASSERT(wait([&]() {
+      return (server != nullptr) && server.load()->is_established() &&
+             pup.load()->is_established();
+    }));
+  }
+
+  rofl::crofsock *sock = new rofl::crofsock(this);
+  client = sock;
+  sock->set_raddr(caddr).tcp_connect(true);
+  CPPUNIT_ASSERT(wait([&]() {
+    rofl::crofsock *peer = relayed ? pdown.load() : server.load();
+    return (peer != nullptr) && peer->is_established() &&
+           client.load()->is_established();
+  }));
+}
+
+void crofsockrelaytest::stop() {
+  rofl::crofsock *sockets[] = {client, pdown, pup, server, lproxy, lserver};
+  for (auto socket : sockets) {
+    if (socket)
+      socket->close();
+  }
+  client = pdown = pup = server = nullptr;
+  lproxy = lserver = nullptr;
+  for (auto socket : sockets) {
+    if (socket)
+      delete socket;
+  }
+}
+
+rofl::csockaddr crofsockrelaytest::listen(rofl::crofsock *socket) {
+  /* try to find idle port for test */
+  while (true) {
+    uint16_t port;
+    do {
+      port = rand.uint16();
+    } while ((port < 10000) || (port > 49000));
+    try {
+      rofl::csockaddr baddr(rofl::caddress_in4("127.0.0.1"), port);
+      socket->set_baddr(baddr).listen();
+      return baddr;
+    } catch (rofl::eSysCall &e) {
+      /* port in use, try another one */
+    }
+  }
+}
+
+template <typename F>
+bool crofsockrelaytest::wait(F cond, unsigned int timeout_ms) {
+  for (unsigned int i = 0; i < timeout_ms; i++) {
+    if (cond())
+      return true;
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 1000000;
+    pselect(0, NULL, NULL, NULL, &ts, NULL);
+  }
+  return cond();
+}
+
+double crofsockrelaytest::run_echo(unsigned int num, bool pingpong) {
+  echo_num = num;
+  echo_pingpong = pingpong;
+  echo_sent = 0;
+  echo_rcvd = 0;
+
+  uint8_t data[32];
+  memset(data, 0xee, sizeof(data));
+
+  double start = cbenchmark::now();
+  unsigned int burst = pingpong ? 1 : num;
+  for (unsigned int i = 0; i < burst; i++) {
+    client.load()->send_message(
+        new cofmsg_echo_request(rofl::openflow13::OFP_VERSION, echo_sent++,
+                                data, sizeof(data)),
+        /*enforce_queueing=*/true);
+  }
+  CPPUNIT_ASSERT(wait([&]() { return echo_rcvd >= num; }, 60000));
+  return cbenchmark::now() - start;
+}
+
+void crofsockrelaytest::handle_listen(rofl::crofsock &socket) {
+  for (auto sd : socket.accept()) {
+    rofl::crofsock *sock = new rofl::crofsock(this);
+    if (&socket == lproxy) {
+      pdown = sock;
+      sock->set_rx_passthrough(rofl::openflow::OFPT_ECHO_REQUEST)
+          .tcp_accept(sd);
+    } else {
+      server = sock;
+      sock->tcp_accept(sd);
+    }
+  }
+}
+
+void crofsockrelaytest::handle_tcp_connect_refused(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tcp_connect_failed(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tcp_connected(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tcp_accept_refused(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tcp_accept_failed(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tcp_accepted(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tls_connect_failed(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tls_connected(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tls_accept_failed(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_tls_accepted(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::handle_closed(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::congestion_solved_indication(rofl::crofsock &socket) {}
+
+void crofsockrelaytest::congestion_occured_indication(rofl::crofsock &socket) {
+}
+
+void crofsockrelaytest::handle_recv(rofl::crofsock &socket,
+                                    rofl::openflow::cofmsg *msg) {
+  if (&socket == server) {
+    cofmsg_echo_request *echo = dynamic_cast<cofmsg_echo_request *>(msg);
+    if ((nullptr == echo) ||
+        (relayed != ((echo->get_xid() & XID_PROXY) == XID_PROXY))) {
+      relay_error = true;
+    } else {
+      socket.send_message(new cofmsg_echo_reply(
+          echo->get_version(), echo->get_xid(), echo->get_body().somem(),
+          echo->get_body().length()));
+    }
+
+  } else if (&socket == client) {
+    cofmsg_echo_reply *echo = dynamic_cast<cofmsg_echo_reply *>(msg);
+    if ((nullptr == echo) || (echo->get_xid() != echo_rcvd) ||
+        (echo->get_body().length() != 32)) {
+      relay_error = true;
+    }
+    if (echo_pingpong && (echo_sent < echo_num)) {
+      uint8_t data[32];
+      memset(data, 0xee, sizeof(data));
+      socket.send_message(new cofmsg_echo_request(
+          rofl::openflow13::OFP_VERSION, echo_sent++, data, sizeof(data)));
+    }
+    ++echo_rcvd;
+
+  } else if (&socket == pdown) {
+    /* types without passthrough are decoded */
+    if (nullptr == dynamic_cast<cofmsg_features_request *>(msg))
+      relay_error = true;
+    ++proxy_msgs_rcvd;
+
+  } else {
+    relay_error = true;
+  }
+  delete msg;
+}
+
+void crofsockrelaytest::handle_recv_frame(rofl::crofsock &socket,
+                                          const rofl::cslice &frame) {
+  uint32_t xid = be32toh(((struct ofp_header *)frame.somem())->xid);
+
+  if (&socket == server) {
+    /* keep frame and the chunk it refers to */
+    if (xid != num_retained)
+      relay_error = true;
+    frames_retained.push_back(frame);
+    ++num_retained;
+    return;
+  }
+
+  if (&socket == pdown) {
+    pup.load()->send_frame(frame, xid | XID_PROXY, true);
+  } else if (&socket == pup) {
+    if (not(xid & XID_PROXY))
+      relay_error = true;
+    pdown.load()->send_frame(frame, xid & ~XID_PROXY, true);
+  } else {
+    relay_error = true;
+  }
+  ++frames_relayed;
+}
@@ -0,0 +1,138 @@
+/*
+ * crofsockrelaytest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CROFSOCKRELAYTEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CROFSOCKRELAYTEST_HPP_
+
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/crandom.h"
+#include "rofl/common/crofsock.h"
+
+class crofsockrelaytest : public CppUnit::TestFixture,
+                          public rofl::crofsock_env {
+  CPPUNIT_TEST_SUITE(crofsockrelaytest);
+  CPPUNIT_TEST(testFrame);
+  CPPUNIT_TEST(testRelay);
+  CPPUNIT_TEST(testRetain);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testFrame();
+  void testRelay();
+  void testRetain();
+
+private:
+  virtual void handle_listen(rofl::crofsock &socket);
+
+  virtual void handle_tcp_connect_refused(rofl::crofsock &socket);
+
+  virtual void handle_tcp_connect_failed(rofl::crofsock &socket);
+
+  virtual void handle_tcp_connected(rofl::crofsock &socket);
+
+  virtual void handle_tcp_accept_refused(rofl::crofsock &socket);
+
+  virtual void handle_tcp_accept_failed(rofl::crofsock &socket);
+
+  virtual void handle_tcp_accepted(rofl::crofsock &socket);
+
+  virtual void handle_tls_connect_failed(rofl::crofsock &socket);
+
+  virtual void handle_tls_connected(rofl::crofsock &socket);
+
+  virtual void handle_tls_accept_failed(rofl::crofsock &socket);
+
+  virtual void handle_tls_accepted(rofl::crofsock &socket);
+
+  virtual void handle_closed(rofl::crofsock &socket);
+
+  virtual void congestion_solved_indication(rofl::crofsock &socket);
+
+  virtual void handle_recv(rofl::crofsock &socket, rofl::openflow::cofmsg *msg);
+
+  virtual void handle_recv_frame(rofl::crofsock &socket,
+                                 const rofl::cslice &frame);
+
+  virtual void congestion_occured_indication(rofl::crofsock &socket);
+
+protected:
+  /**
+   * @brief	Sets up client, server and, if relayed, both proxy sockets
+   */
+  void start(bool relayed);
+
+  /**
+   * @brief	Closes and destroys all sockets
+   */
+  void stop();
+
+  /**
+   * @brief	Binds listening socket to an idle port on localhost
+   */
+  rofl::csockaddr listen(rofl::crofsock *socket);
+
+  /**
+   * @brief	Waits until cond holds or timeout expires
+   */
+  template <typename F> bool wait(F cond, unsigned int timeout_ms = 10000);
+
+  /**
+   * @brief	Sends num echo requests and waits for all replies
+   *
+   * @param pingpong send next request when the previous reply arrived
+   * @return elapsed time in seconds
+   */
+  double run_echo(unsigned int num, bool pingpong);
+
+protected:
+  // xid space used on the server side of the proxy
+  static const uint32_t XID_PROXY = 0x80000000;
+
+  rofl::crandom rand;
+
+  bool relayed;
+
+  // listening sockets of proxy and server
+  rofl::crofsock *lproxy;
+  rofl::crofsock *lserver;
+
+  // client and the proxy's socket accepted from client
+  std::atomic<rofl::crofsock *> client;
+  std::atomic<rofl::crofsock *> pdown;
+
+  // proxy's socket connected to server and server's accepted socket
+  std::atomic<rofl::crofsock *> pup;
+  std::atomic<rofl::crofsock *> server;
+
+  // echo requests sent and replies received by client
+  unsigned int echo_num;
+  bool echo_pingpong;
+  std::atomic_uint echo_sent;
+  std::atomic_uint echo_rcvd;
+
+  // frames relayed by the proxy
+  std::atomic_uint frames_relayed;
+
+  // frames kept by the server beyond handle_recv_frame()
+  std::vector<rofl::cslice> frames_retained;
+  std::atomic_uint num_retained;
+
+  // messages decoded by the proxy
+  std::atomic_uint proxy_msgs_rcvd;
+
+  // an unexpected message or xid was seen
+  std::atomic_bool relay_error;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CROFSOCKRELAYTEST_HPP_ */
@@ -0,0 +1,131 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * csegmentsbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "rofl/common/cbenchmark.hpp"
+#include "rofl/common/csegments.hpp"
+#include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
+
+using rofl::csegment;
+using rofl::csegments;
+using rofl::ctimespec;
+using rofl::openflow::cofmsg_flow_stats_reply;
+
+namespace {
+
+/* absolute point in time */
+ctimespec expiry(time_t sec, long nsec) {
+  struct timespec ts;
+  ts.tv_sec = sec;
+  ts.tv_nsec = nsec;
+  return ctimespec(ts);
+}
+
+/* one segment of a flow-stats dump with num_flows entries */
+cofmsg_flow_stats_reply *segment(uint32_t xid, unsigned int num_flows,
+                                 bool more) {
+  cofmsg_flow_stats_reply *msg =
+      new cofmsg_flow_stats_reply(rofl::openflow13::OFP_VERSION, xid);
+  msg->set_stats_flags(more ? rofl::openflow13::OFPMPF_REPLY_MORE : 0);
+  for (unsigned int i = 0; i < num_flows; i++) {
+    msg->set_flow_stats_array()
+        .add_flow_stats(i)
+        .set_match()
+        .set_eth_dst(rofl::caddress_ll(i + 1));
+  }
+  return msg;
+}
+
+/* previous crofconn implementation copies each segment, returns number of
+ * reassembled flows */
+size_t reassemble_copy(const std::vector<cofmsg_flow_stats_reply *> &parts) {
+  csegment seg(1, ctimespec().expire_in(60),
+               rofl::openflow13::OFPT_MULTIPART_REPLY,
+               rofl::openflow13::OFPMP_FLOW);
+  for (auto part : parts)
+    seg.store_and_merge_msg(*part);
+  cofmsg_flow_stats_reply *msg =
+      dynamic_cast<cofmsg_flow_stats_reply *>(seg.retrieve_and_detach_msg());
+  size_t n = msg->get_flow_stats_array().size();
+  delete msg;
+  return n;
+}
+
+size_t reassemble_adopt(std::vector<cofmsg_flow_stats_reply *> &parts) {
+  csegment seg(1, ctimespec().expire_in(60),
+               rofl::openflow13::OFPT_MULTIPART_REPLY,
+               rofl::openflow13::OFPMP_FLOW);
+  for (auto part : parts)
+    seg.store_and_merge_msg(part);
+  parts.clear();
+  cofmsg_flow_stats_reply *msg =
+      dynamic_cast<cofmsg_flow_stats_reply *>(seg.retrieve_and_detach_msg());
+  size_t n = msg->get_flow_stats_array().size();
+  delete msg;
+  return n;
+}
+
+}; // end of anonymous namespace
+
+int main(int argc, char **argv) {
+  /* expiry sweep with half of the segments expired: previous
+   * implementation restarts find_if from begin() for each of them */
+  unsigned int num_pending[] = {100, 1000, 5000};
+  for (auto n : num_pending) {
+    std::map<uint32_t, csegment> legacy;
+    csegments indexed;
+    for (unsigned int i = 0; i < n; i++) {
+      ctimespec tspec = (i < n / 2) ? ctimespec().expire_in(60) : expiry(1, i);
+      legacy.emplace(i, csegment(i, tspec, 19, 1));
+      indexed.add(i, tspec, 19, 1);
+    }
+
+    double t_legacy = cbenchmark::elapsed([&]() {
+      std::map<uint32_t, csegment>::iterator it;
+      while ((it = find_if(legacy.begin(), legacy.end(),
+                           csegment::csegment_is_expired())) != legacy.end()) {
+        legacy.erase(it);
+      }
+    });
+
+    double t_indexed = cbenchmark::elapsed([&]() {
+      csegment seg;
+      while (indexed.pop_expired(seg)) {
+      }
+    });
+
+    std::cout << "csegments: pending=" << n
+              << " map+find_if=" << (unsigned long)(t_legacy * 1e6)
+              << " us heap=" << (unsigned long)(t_indexed * 1e6) << " us"
+              << std::endl;
+  }
+
+  /* reassembly of a flow-stats dump arriving in many segments */
+  unsigned int num_segments[] = {100, 500};
+  for (auto n : num_segments) {
+    std::vector<cofmsg_flow_stats_reply *> parts;
+    for (unsigned int i = 0; i < n; i++)
+      parts.push_back(segment(1, 64, (i + 1 < n)));
+
+    double t_copy = cbenchmark::elapsed([&]() { reassemble_copy(parts); });
+    double t_adopt = cbenchmark::elapsed([&]() { reassemble_adopt(parts); });
+
+    std::cout << "csegments: segments=" << n << " flows=" << 64 * n
+              << " copy=" << (unsigned long)(t_copy * 1e6)
+              << " us adopt=" << (unsigned long)(t_adopt * 1e6) << " us"
+              << std::endl;
+  }
+
+  return 0;
+}
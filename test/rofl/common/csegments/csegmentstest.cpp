@@ -0,0 +1,166 @@
+/*
+ * csegmentstest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "csegmentstest.hpp"
+
+using rofl::csegment;
+using rofl::csegments;
+using rofl::ctimespec;
+using rofl::openflow::cofmsg_flow_stats_reply;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(csegmentstest);
+
+namespace {
+
+/* absolute point in time */
+ctimespec expiry(time_t sec, long nsec) {
+  struct timespec ts;
+  ts.tv_sec = sec;
+  ts.tv_nsec = nsec;
+  return ctimespec(ts);
+}
+
+/* one segment of a flow-stats dump with num_flows entries */
+cofmsg_flow_stats_reply *segment(uint32_t xid, unsigned int num_flows,
+                                 bool more) {
+  cofmsg_flow_stats_reply *msg =
+      new cofmsg_flow_stats_reply(rofl::openflow13::OFP_VERSION, xid);
+  msg->set_stats_flags(more ? rofl::openflow13::OFPMPF_REPLY_MORE : 0);
+  for (unsigned int i = 0; i < num_flows; i++) {
+    msg->set_flow_stats_array()
+        .add_flow_stats(i)
+        .set_match()
+        .set_eth_dst(rofl::caddress_ll(i + 1));
+  }
+  return msg;
+}
+
+}; // end of anonymous namespace
+
+void csegmentstest::setUp() {}
+
+void csegmentstest::tearDown() {}
+
+void csegmentstest::test_add_drop() {
+  csegments segments;
+
+  CPPUNIT_ASSERT(segments.empty());
+  csegment &seg = segments.add(1, expiry(10, 0), 19, 1);
+  CPPUNIT_ASSERT(seg.get_xid() == 1);
+  segments.add(2, expiry(20, 0), 19, 1);
+  CPPUNIT_ASSERT(segments.size() == 2);
+
+  /* adding a pending xid returns the existing segment */
+  CPPUNIT_ASSERT(&segments.add(1, expiry(30, 0), 19, 1) == &seg);
+  CPPUNIT_ASSERT(segments.size() == 2);
+  CPPUNIT_ASSERT(&segments.get(1) == &seg);
+
+  CPPUNIT_ASSERT(segments.has(2));
+  CPPUNIT_ASSERT(segments.drop(2));
+  CPPUNIT_ASSERT(not segments.drop(2));
+  CPPUNIT_ASSERT(not segments.has(2));
+
+  try {
+    segments.get(2);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eSegmentedMessageNotFound &e) {
+  }
+
+  ctimespec tspec;
+  CPPUNIT_ASSERT(segments.get_next_expiry(tspec));
+  CPPUNIT_ASSERT(tspec == expiry(10, 0));
+
+  segments.clear();
+  CPPUNIT_ASSERT(segments.empty());
+  CPPUNIT_ASSERT(not segments.get_next_expiry(tspec));
+}
+
+void csegmentstest::test_expiry_order() {
+  csegments segments;
+
+  segments.add(7, expiry(30, 0), 19, 1);
+  segments.add(5, expiry(10, 0), 19, 1);
+  segments.add(6, expiry(10, 0), 19, 1);
+  segments.add(8, expiry(20, 0), 19, 1);
+  segments.drop(6);
+
+  csegment seg;
+  CPPUNIT_ASSERT(not segments.pop_expired(seg, expiry(9, 0)));
+  CPPUNIT_ASSERT(segments.pop_expired(seg, expiry(25, 0)));
+  CPPUNIT_ASSERT(seg.get_xid() == 5);
+  CPPUNIT_ASSERT(segments.pop_expired(seg, expiry(25, 0)));
+  CPPUNIT_ASSERT(seg.get_xid() == 8);
+  CPPUNIT_ASSERT(not segments.pop_expired(seg, expiry(25, 0)));
+
+  CPPUNIT_ASSERT(segments.size() == 1);
+  CPPUNIT_ASSERT(segments.has(7));
+}
+
+void csegmentstest::test_move() {
+  csegment seg(1, expiry(10, 0), rofl::openflow13::OFPT_MULTIPART_REPLY,
+               rofl::openflow13::OFPMP_FLOW);
+  cofmsg_flow_stats_reply *msg = segment(1, 2, true);
+  seg.store_and_merge_msg(msg);
+
+  /* stitched message moves with the segment */
+  csegment moved(std::move(seg));
+  CPPUNIT_ASSERT(moved.get_xid() == 1);
+  CPPUNIT_ASSERT(&moved.get_msg() == msg);
+  CPPUNIT_ASSERT(seg.retrieve_and_detach_msg() == nullptr);
+
+  csegment assigned;
+  assigned = std::move(moved);
+  CPPUNIT_ASSERT(&assigned.get_msg() == msg);
+  CPPUNIT_ASSERT(moved.retrieve_and_detach_msg() == nullptr);
+}
+
+void csegmentstest::test_reassembly() {
+  csegments segments;
+
+  csegment &seg = segments.add(0x11121314, expiry(10, 0),
+                               rofl::openflow13::OFPT_MULTIPART_REPLY,
+                               rofl::openflow13::OFPMP_FLOW);
+
+  /* first segment is adopted, not copied */
+  cofmsg_flow_stats_reply *first = segment(0x11121314, 3, true);
+  seg.store_and_merge_msg(first);
+  CPPUNIT_ASSERT(&seg.get_msg() == first);
+  CPPUNIT_ASSERT(not(first->get_stats_flags() &
+                     rofl::openflow13::OFPMPF_REPLY_MORE));
+
+  seg.store_and_merge_msg(segment(0x11121314, 2, true));
+  seg.store_and_merge_msg(segment(0x11121314, 4, false));
+
+  /* segments of a different multipart type are rejected */
+  rofl::openflow::cofmsg_table_stats_reply *table =
+      new rofl::openflow::cofmsg_table_stats_reply(
+          rofl::openflow13::OFP_VERSION, 0x11121314);
+  try {
+    seg.store_and_merge_msg(table);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::exception &e) {
+  }
+
+  cofmsg_flow_stats_reply *msg =
+      dynamic_cast<cofmsg_flow_stats_reply *>(seg.retrieve_and_detach_msg());
+  CPPUNIT_ASSERT(msg == first);
+  CPPUNIT_ASSERT(msg->get_flow_stats_array().size() == 9);
+  CPPUNIT_ASSERT(msg->get_flow_stats_array()
+                     .get_flow_stats(5)
+                     .get_match()
+                     .get_eth_dst() == rofl::caddress_ll(1));
+  delete msg;
+
+  segments.drop(0x11121314);
+  CPPUNIT_ASSERT(segments.empty());
+}
+
@@ -0,0 +1,34 @@
+/*
+ * csegmentstest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CSEGMENTS_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CSEGMENTS_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/csegments.hpp"
+
+class csegmentstest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(csegmentstest);
+  CPPUNIT_TEST(test_add_drop);
+  CPPUNIT_TEST(test_expiry_order);
+  CPPUNIT_TEST(test_move);
+  CPPUNIT_TEST(test_reassembly);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void test_add_drop();
+  void test_expiry_order();
+  void test_move();
+  void test_reassembly();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CSEGMENTS_TEST_HPP_ */
@@ -0,0 +1,168 @@
+/*
+ * cslabtest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cslabtest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cslabtest);
+
+void cslabtest::setUp() { rofl::cslab::set_enabled(true); }
+
+void cslabtest::tearDown() { rofl::cslab::set_enabled(true); }
+
+void cslabtest::test_reuse() {
+  uint64_t num_allocs = rofl::cslab::get_num_allocs();
+
+  void *p1 = rofl::cslab::allocate(40);
+  memset(p1, 0xff, 40);
+  rofl::cslab::deallocate(p1, 40);
+
+  /* same size class, most recently released block is handed out first */
+  void *p2 = rofl::cslab::allocate(48);
+  CPPUNIT_ASSERT(p1 == p2);
+  rofl::cslab::deallocate(p2, 48);
+
+  /* different size class */
+  void *p3 = rofl::cslab::allocate(100);
+  CPPUNIT_ASSERT(p3 != p2);
+  rofl::cslab::deallocate(p3, 100);
+
+  /* large blocks are passed through */
+  void *p4 = rofl::cslab::allocate(rofl::cslab::SLAB_MAX_SIZE + 1);
+  memset(p4, 0xff, rofl::cslab::SLAB_MAX_SIZE + 1);
+  rofl::cslab::deallocate(p4, rofl::cslab::SLAB_MAX_SIZE + 1);
+
+  CPPUNIT_ASSERT(rofl::cslab::get_num_allocs() == num_allocs + 4);
+}
+
+void cslabtest::test_reallocate() {
+  uint8_t *p = (uint8_t *)rofl::cslab::reallocate(nullptr, 0, 20);
+  for (unsigned int i = 0; i < 20; i++) {
+    p[i] = i;
+  }
+
+  /* same size class, no copy */
+  CPPUNIT_ASSERT(p == rofl::cslab::reallocate(p, 20, 30));
+
+  /* grow into next size class and beyond */
+  p = (uint8_t *)rofl::cslab::reallocate(p, 30, 100);
+  p = (uint8_t *)rofl::cslab::reallocate(p, 100, 4096);
+  p = (uint8_t *)rofl::cslab::reallocate(p, 4096, 8192);
+  p = (uint8_t *)rofl::cslab::reallocate(p, 8192, 20);
+  for (unsigned int i = 0; i < 20; i++) {
+    CPPUNIT_ASSERT(p[i] == i);
+  }
+  rofl::cslab::deallocate(p, 20);
+}
+
+void *cslabtest::release_blocks(void *arg) {
+  cslabtest *test = static_cast<cslabtest *>(arg);
+  for (auto block : test->blocks) {
+    rofl::cslab::deallocate(block, 64);
+  }
+  test->blocks.clear();
+  /* hand remaining blocks over to depot before terminating */
+  rofl::cslab::flush();
+  return nullptr;
+}
+
+void cslabtest::test_cross_thread() {
+  const unsigned int NUM_BLOCKS = 4 * rofl::cslab::BATCH_SIZE;
+
+  rofl::cslab::flush();
+  CPPUNIT_ASSERT(rofl::cslab::get_num_cached() == 0);
+
+  for (unsigned int i = 0; i < NUM_BLOCKS; i++) {
+    blocks.push_back(rofl::cslab::allocate(64));
+  }
+  std::vector<void *> allocated(blocks);
+
+  pthread_t tid;
+  CPPUNIT_ASSERT(pthread_create(&tid, NULL, &release_blocks, this) == 0);
+  pthread_join(tid, NULL);
+
+  /* blocks released on the other thread are recycled via the depot */
+  unsigned int num_recycled = 0;
+  for (unsigned int i = 0; i < NUM_BLOCKS; i++) {
+    void *block = rofl::cslab::allocate(64);
+    for (auto p : allocated) {
+      if (p == block) {
+        num_recycled++;
+        break;
+      }
+    }
+    blocks.push_back(block);
+  }
+  CPPUNIT_ASSERT(num_recycled == NUM_BLOCKS);
+
+  for (auto block : blocks) {
+    rofl::cslab::deallocate(block, 64);
+  }
+  blocks.clear();
+}
+
+void cslabtest::test_disabled() {
+  void *p1 = rofl::cslab::allocate(64);
+
+  rofl::cslab::set_enabled(false);
+  CPPUNIT_ASSERT(not rofl::cslab::is_enabled());
+  CPPUNIT_ASSERT(rofl::cslab::get_num_cached() == 0);
+
+  /* blocks remain interchangeable */
+  void *p2 = rofl::cslab::allocate(64);
+  rofl::cslab::deallocate(p1, 64);
+  CPPUNIT_ASSERT(rofl::cslab::get_num_cached() == 0);
+
+  rofl::cslab::set_enabled(true);
+  rofl::cslab::deallocate(p2, 64);
+  CPPUNIT_ASSERT(rofl::cslab::get_num_cached() == 1);
+  rofl::cslab::flush();
+}
+
+void cslabtest::test_alloc_counters() {
+  cofflowmod flowmod(rofl::openflow13::OFP_VERSION);
+  flowmod.set_command(rofl::openflow13::OFPFC_ADD);
+  flowmod.set_table_id(1);
+  flowmod.set_match().set_in_port(1);
+  flowmod.set_match().set_eth_type(0x0800);
+  flowmod.set_instructions()
+      .add_inst_apply_actions()
+      .set_actions()
+      .add_action_output(rofl::cindex(0))
+      .set_port_no(2);
+
+  cofmsg_flow_mod msg(rofl::openflow13::OFP_VERSION, 0xa1a2a3a4, flowmod);
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.memlen());
+
+  cofmsg::reset_alloc_counters();
+
+  for (unsigned int i = 0; i < 3; i++) {
+    uint64_t num_allocs = rofl::cslab::get_num_allocs();
+    cofmsg *pmsg = new cofmsg_flow_mod();
+    pmsg->unpack(mem.somem(), mem.memlen());
+    cofmsg::count_allocs(pmsg->get_type(),
+                         rofl::cslab::get_num_allocs() - num_allocs);
+    delete pmsg;
+  }
+
+  CPPUNIT_ASSERT(cofmsg::get_num_decoded(rofl::openflow13::OFPT_FLOW_MOD) ==
+                 3);
+  /* message object, instruction and action, OXMs are stored inline */
+  CPPUNIT_ASSERT(cofmsg::get_num_allocs(rofl::openflow13::OFPT_FLOW_MOD) >=
+                 3 * 3);
+  CPPUNIT_ASSERT(cofmsg::get_num_decoded(rofl::openflow13::OFPT_PACKET_IN) ==
+                 0);
+
+  cofmsg::dump_alloc_counters(std::cerr);
+}
@@ -0,0 +1,46 @@
+/*
+ * cslabtest.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CSLAB_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CSLAB_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <pthread.h>
+#include <vector>
+
+#include "rofl/common/cslab.hpp"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+
+class cslabtest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cslabtest);
+  CPPUNIT_TEST(test_reuse);
+  CPPUNIT_TEST(test_reallocate);
+  CPPUNIT_TEST(test_cross_thread);
+  CPPUNIT_TEST(test_disabled);
+  CPPUNIT_TEST(test_alloc_counters);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void test_reuse();
+  void test_reallocate();
+  void test_cross_thread();
+  void test_disabled();
+  void test_alloc_counters();
+
+private:
+  static void *release_blocks(void *arg);
+
+  // blocks allocated on one thread and released on another one
+  std::vector<void *> blocks;
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CSLAB_TEST_HPP_ */
@@ -26,6 +26,173 @@ void cthread_test::test1() {
   CPPUNIT_ASSERT(keep_running > 0);
 }
 
+void cthread_test::test2() {
+  const unsigned int num_objects = 8;
+  unsigned int keep_running = 60;
+
+  rofl::cthread_pool::get_instance().start(2);
+  CPPUNIT_ASSERT(rofl::cthread_pool::get_instance().get_num_workers() == 2);
+
+  std::vector<cobject *> objects;
+  for (unsigned int i = 0; i < num_objects; i++) {
+    objects.push_back(new cobject());
+    CPPUNIT_ASSERT(objects.back()->thread.is_pooled());
+    objects.back()->thread.add_timer(0, rofl::ctimespec().expire_in(1));
+    objects.back()->thread.add_timer(1, rofl::ctimespec().expire_in(2));
+  }
+  CPPUNIT_ASSERT(rofl::cthread_pool::get_instance().get_num_threads(0) +
+                     rofl::cthread_pool::get_instance().get_num_threads(1) ==
+                 num_objects);
+
+  bool done = false;
+  while ((--keep_running > 0) && (not done)) {
+    done = true;
+    for (auto object : objects) {
+      CPPUNIT_ASSERT(not object->error);
+      if (object->cnt < 5)
+        done = false;
+    }
+    std::cerr << ".";
+    sleep(1);
+  }
+  std::cerr << std::endl;
+  CPPUNIT_ASSERT(keep_running > 0);
+
+  for (auto object : objects) {
+    delete object;
+  }
+  CPPUNIT_ASSERT(rofl::cthread_pool::get_instance().get_num_threads(0) == 0);
+  CPPUNIT_ASSERT(rofl::cthread_pool::get_instance().get_num_threads(1) == 0);
+
+  rofl::cthread_pool::get_instance().stop();
+  CPPUNIT_ASSERT(not rofl::cthread_pool::get_instance().is_running());
+}
+
+void cthread_test::test_pool_stop() {
+  const unsigned int num_objects = 4;
+  unsigned int keep_running = 60;
+
+  rofl::cthread_pool::get_instance().start(2);
+
+  std::vector<cobject *> objects;
+  for (unsigned int i = 0; i < num_objects; i++) {
+    objects.push_back(new cobject());
+    CPPUNIT_ASSERT(objects.back()->thread.is_pooled());
+  }
+
+  /* attached threads continue on pthreads of their own */
+  rofl::cthread_pool::get_instance().stop();
+  CPPUNIT_ASSERT(rofl::cthread_pool::get_instance().get_num_workers() == 0);
+  for (auto object : objects) {
+    CPPUNIT_ASSERT(not object->thread.is_pooled());
+    object->thread.add_timer(0, rofl::ctimespec().expire_in(1));
+    object->thread.add_timer(1, rofl::ctimespec().expire_in(2));
+  }
+
+  bool done = false;
+  while ((--keep_running > 0) && (not done)) {
+    done = true;
+    for (auto object : objects) {
+      CPPUNIT_ASSERT(not object->error);
+      if (object->cnt < 2)
+        done = false;
+    }
+    sleep(1);
+  }
+  CPPUNIT_ASSERT(keep_running > 0);
+
+  /* a restarted pool does not know the moved threads */
+  rofl::cthread_pool::get_instance().start(2);
+  cobject *pooled = new cobject();
+  CPPUNIT_ASSERT(pooled->thread.is_pooled());
+  for (auto object : objects) {
+    delete object;
+  }
+  CPPUNIT_ASSERT(rofl::cthread_pool::get_instance().get_num_threads(0) +
+                     rofl::cthread_pool::get_instance().get_num_threads(1) ==
+                 1);
+  delete pooled;
+
+  rofl::cthread_pool::get_instance().stop();
+}
+
+void cthread_test::test_rearm_wakeup() {
+  struct timespec ts = {0, 200000000};
+
+  /* first timer shortens the thread's sleep */
+  CPPUNIT_ASSERT(object->thread.add_timer(2, rofl::ctimespec().expire_in(10)));
+  nanosleep(&ts, NULL);
+  CPPUNIT_ASSERT(object->wakeups == 1);
+
+  /* re-arming and cancelling to later deadlines do not wake up the thread */
+  for (unsigned int i = 0; i < 1000; i++) {
+    CPPUNIT_ASSERT(
+        not object->thread.add_timer(2, rofl::ctimespec().expire_in(10, i)));
+    CPPUNIT_ASSERT(
+        object->thread.add_timer(3, rofl::ctimespec().expire_in(20, i)));
+    object->thread.drop_timer(3);
+  }
+  nanosleep(&ts, NULL);
+  CPPUNIT_ASSERT(object->wakeups == 1);
+  CPPUNIT_ASSERT(object->thread.has_timer(2));
+  CPPUNIT_ASSERT(not object->thread.has_timer(3));
+
+  /* copy stays valid while the timer is re-armed */
+  rofl::ctimer timer = object->thread.get_timer(2);
+  object->thread.add_timer(2, rofl::ctimespec().expire_in(30));
+  CPPUNIT_ASSERT(timer.get_timer_id() == 2);
+  CPPUNIT_ASSERT(timer.get_tspec() < object->thread.get_timer(2).get_tspec());
+  try {
+    object->thread.get_timer(3);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eThreadNotFound &e) {
+  }
+
+  /* an earlier deadline does */
+  object->thread.add_timer(2, rofl::ctimespec().expire_in(0, 50000000));
+  nanosleep(&ts, NULL);
+  CPPUNIT_ASSERT(object->wakeups == 2);
+  CPPUNIT_ASSERT(not object->thread.has_timer(2));
+  CPPUNIT_ASSERT(not object->error);
+}
+
+void cthread_test::test_timers() {
+  rofl::ctimers timers;
+  struct timespec ts = {100, 0};
+
+  for (uint32_t i = 0; i < 1000; i++) {
+    ts.tv_nsec = (i * 7919) % 1000;
+    CPPUNIT_ASSERT(timers.add(i, rofl::ctimespec(ts)));
+  }
+  CPPUNIT_ASSERT(timers.size() == 1000);
+
+  /* re-arm every third timer, cancel every fifth */
+  for (uint32_t i = 0; i < 1000; i += 3) {
+    ts.tv_nsec = 1000 + i;
+    CPPUNIT_ASSERT(not timers.add(i, rofl::ctimespec(ts)));
+  }
+  for (uint32_t i = 0; i < 1000; i += 5) {
+    CPPUNIT_ASSERT(timers.drop(i));
+    CPPUNIT_ASSERT(not timers.drop(i));
+  }
+  CPPUNIT_ASSERT(timers.size() == 800);
+  CPPUNIT_ASSERT(timers.has(1));
+  CPPUNIT_ASSERT(not timers.has(5));
+  CPPUNIT_ASSERT(timers.find(3)->get_tspec().get_tspec().tv_nsec == 1003);
+
+  rofl::ctimer last;
+  unsigned int num = 0;
+  while (not timers.empty()) {
+    rofl::ctimer timer = timers.front();
+    CPPUNIT_ASSERT(not(timer < last));
+    CPPUNIT_ASSERT(timers.find(timer.get_timer_id()) != nullptr);
+    timers.pop_front();
+    last = timer;
+    num++;
+  }
+  CPPUNIT_ASSERT(num == 800);
+}
+
 void cthread_test::cobject::handle_timeout(rofl::cthread &thread,
                                            uint32_t timer_id) {
   switch (timer_id) {
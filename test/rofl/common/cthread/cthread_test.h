@@ -1,4 +1,5 @@
 #include "rofl/common/cthread.hpp"
+#include "rofl/common/cthread_pool.hpp"
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -6,6 +7,10 @@ class cthread_test : public CppUnit::TestFixture {
 
   CPPUNIT_TEST_SUITE(cthread_test);
   CPPUNIT_TEST(test1);
+  CPPUNIT_TEST(test2);
+  CPPUNIT_TEST(test_pool_stop);
+  CPPUNIT_TEST(test_rearm_wakeup);
+  CPPUNIT_TEST(test_timers);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -19,10 +24,12 @@ private:
     /**
      *
      */
-    cobject() : thread(this), cnt(0), error(false) { thread.start(); };
+    cobject() : thread(this), cnt(0), error(false), wakeups(0) {
+      thread.start();
+    };
 
   protected:
-    virtual void handle_wakeup(rofl::cthread &thread){};
+    virtual void handle_wakeup(rofl::cthread &thread) { wakeups++; };
     virtual void handle_timeout(rofl::cthread &thread, uint32_t timer_id);
     virtual void handle_read_event(rofl::cthread &thread, int fd){};
     virtual void handle_write_event(rofl::cthread &thread, int fd){};
@@ -33,6 +40,8 @@ private:
     unsigned int cnt;
 
     bool error;
+
+    std::atomic_uint wakeups;
   };
 
 private:
@@ -43,4 +52,8 @@ public:
   void tearDown();
 
   void test1();
+  void test2();
+  void test_pool_stop();
+  void test_rearm_wakeup();
+  void test_timers();
 };
@@ -0,0 +1,94 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * ctransactionsbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+
+#include "rofl/common/cbenchmark.hpp"
+#include "rofl/common/ctransactions.hpp"
+
+using rofl::ctimespec;
+using rofl::ctransaction;
+using rofl::ctransactions;
+
+namespace {
+
+/* previous crofconn implementation: set ordered by expiry, linear xid lookup */
+class clegacy {
+  struct cless {
+    bool operator()(const ctransaction &a, const ctransaction &b) const {
+      return (a.get_tspec() < b.get_tspec());
+    };
+  };
+
+  struct cfind_by_xid {
+    uint32_t xid;
+    cfind_by_xid(uint32_t xid) : xid(xid){};
+    bool operator()(const ctransaction &ta) const {
+      return (ta.get_xid() == xid);
+    };
+  };
+
+  std::set<ctransaction, cless> transactions;
+
+public:
+  void add(const ctransaction &ta) { transactions.insert(ta); };
+
+  void drop(uint32_t xid) {
+    std::set<ctransaction, cless>::iterator it;
+    while ((it = find_if(transactions.begin(), transactions.end(),
+                         cfind_by_xid(xid))) != transactions.end()) {
+      transactions.erase(it);
+    }
+  };
+};
+
+/* absolute point in time */
+ctimespec expiry(time_t sec, long nsec) {
+  struct timespec ts;
+  ts.tv_sec = sec;
+  ts.tv_nsec = nsec;
+  return ctimespec(ts);
+}
+
+/* average cost of one reply (drop) plus one new request (add) with
+ * num_pending transactions outstanding */
+template <class T> double run_replies(unsigned int num_pending,
+                                      unsigned int num_replies) {
+  T transactions;
+  for (unsigned int i = 0; i < num_pending; i++) {
+    transactions.add(ctransaction(i, expiry(1000, i), 19));
+  }
+  double elapsed = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_replies; i++) {
+      uint32_t xid = num_pending + i;
+      transactions.drop(xid - num_pending);
+      transactions.add(ctransaction(xid, expiry(1000, xid), 19));
+    }
+  });
+  return elapsed / num_replies;
+}
+
+}; // end of anonymous namespace
+
+int main(int argc, char **argv) {
+  unsigned int num_pending[] = {10, 1000, 100000};
+  for (auto n : num_pending) {
+    double t_legacy = run_replies<clegacy>(n, (n < 100000) ? 20000 : 1000);
+    double t_indexed = run_replies<ctransactions>(n, 20000);
+    std::cout << "ctransactions: pending=" << n
+              << " set+find_if=" << (unsigned long)(t_legacy * 1e9)
+              << " ns/reply indexed=" << (unsigned long)(t_indexed * 1e9)
+              << " ns/reply" << std::endl;
+  }
+
+  return 0;
+}
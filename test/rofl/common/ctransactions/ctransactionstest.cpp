@@ -0,0 +1,134 @@
+/*
+ * ctransactionstest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "ctransactionstest.hpp"
+
+using rofl::ctimespec;
+using rofl::ctransaction;
+using rofl::ctransactions;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ctransactionstest);
+
+namespace {
+
+/* absolute point in time */
+ctimespec expiry(time_t sec, long nsec) {
+  struct timespec ts;
+  ts.tv_sec = sec;
+  ts.tv_nsec = nsec;
+  return ctimespec(ts);
+}
+
+}; // end of anonymous namespace
+
+void ctransactionstest::setUp() {}
+
+void ctransactionstest::tearDown() {}
+
+void ctransactionstest::test_add_drop() {
+  ctransactions transactions;
+
+  CPPUNIT_ASSERT(transactions.empty());
+  CPPUNIT_ASSERT(transactions.add(ctransaction(1, expiry(10, 0), 18)));
+  CPPUNIT_ASSERT(not transactions.add(ctransaction(2, expiry(20, 0), 20)));
+  CPPUNIT_ASSERT(transactions.add(ctransaction(3, expiry(5, 0), 18, 1)));
+  CPPUNIT_ASSERT(transactions.size() == 3);
+
+  CPPUNIT_ASSERT(transactions.has(1));
+  CPPUNIT_ASSERT(transactions.has(2));
+  CPPUNIT_ASSERT(not transactions.has(4));
+
+  CPPUNIT_ASSERT(transactions.drop(2));
+  CPPUNIT_ASSERT(not transactions.drop(2));
+  CPPUNIT_ASSERT(not transactions.has(2));
+  CPPUNIT_ASSERT(transactions.size() == 2);
+
+  ctimespec tspec;
+  CPPUNIT_ASSERT(transactions.get_next_expiry(tspec));
+  CPPUNIT_ASSERT(tspec == expiry(5, 0));
+
+  transactions.clear();
+  CPPUNIT_ASSERT(transactions.empty());
+  CPPUNIT_ASSERT(not transactions.get_next_expiry(tspec));
+}
+
+void ctransactionstest::test_expiry_order() {
+  ctransactions transactions;
+
+  /* identical expiry times are kept and pop in insertion order */
+  transactions.add(ctransaction(7, expiry(30, 0), 18));
+  transactions.add(ctransaction(5, expiry(10, 0), 18));
+  transactions.add(ctransaction(6, expiry(10, 0), 20));
+  transactions.add(ctransaction(8, expiry(20, 0), 18, 3));
+
+  ctransaction ta;
+  CPPUNIT_ASSERT(not transactions.pop_expired(ta, expiry(9, 0)));
+
+  CPPUNIT_ASSERT(transactions.pop_expired(ta, expiry(25, 0)));
+  CPPUNIT_ASSERT(ta.get_xid() == 5);
+  CPPUNIT_ASSERT(transactions.pop_expired(ta, expiry(25, 0)));
+  CPPUNIT_ASSERT(ta.get_xid() == 6);
+  CPPUNIT_ASSERT(ta.get_type() == 20);
+  CPPUNIT_ASSERT(transactions.pop_expired(ta, expiry(25, 0)));
+  CPPUNIT_ASSERT(ta.get_xid() == 8);
+  CPPUNIT_ASSERT(ta.get_subtype() == 3);
+  CPPUNIT_ASSERT(not transactions.pop_expired(ta, expiry(25, 0)));
+
+  CPPUNIT_ASSERT(transactions.size() == 1);
+  CPPUNIT_ASSERT(not transactions.has(5));
+  CPPUNIT_ASSERT(transactions.has(7));
+}
+
+void ctransactionstest::test_replace() {
+  ctransactions transactions;
+
+  transactions.add(ctransaction(1, expiry(10, 0), 18));
+  transactions.add(ctransaction(2, expiry(20, 0), 18));
+
+  /* re-adding an xid replaces its expiry */
+  CPPUNIT_ASSERT(not transactions.add(ctransaction(1, expiry(30, 0), 20)));
+  CPPUNIT_ASSERT(transactions.size() == 2);
+
+  ctimespec tspec;
+  CPPUNIT_ASSERT(transactions.get_next_expiry(tspec));
+  CPPUNIT_ASSERT(tspec == expiry(20, 0));
+
+  ctransaction ta;
+  CPPUNIT_ASSERT(transactions.pop_expired(ta, expiry(40, 0)));
+  CPPUNIT_ASSERT(ta.get_xid() == 2);
+  CPPUNIT_ASSERT(transactions.pop_expired(ta, expiry(40, 0)));
+  CPPUNIT_ASSERT(ta.get_xid() == 1);
+  CPPUNIT_ASSERT(ta.get_type() == 20);
+  CPPUNIT_ASSERT(transactions.empty());
+}
+
+void ctransactionstest::test_stale_entries() {
+  ctransactions transactions;
+
+  transactions.add(ctransaction(0, expiry(1, 0), 18));
+  for (unsigned int i = 1; i < 10000; i++) {
+    transactions.add(ctransaction(i, expiry(100, i), 18));
+    CPPUNIT_ASSERT(transactions.drop(i));
+  }
+  CPPUNIT_ASSERT(transactions.size() == 1);
+
+  ctimespec tspec;
+  CPPUNIT_ASSERT(transactions.get_next_expiry(tspec));
+  CPPUNIT_ASSERT(tspec == expiry(1, 0));
+
+  /* the earliest transaction is dropped, next expiry skips stale entries */
+  transactions.add(ctransaction(20000, expiry(50, 0), 18));
+  CPPUNIT_ASSERT(transactions.drop(0));
+  CPPUNIT_ASSERT(transactions.get_next_expiry(tspec));
+  CPPUNIT_ASSERT(tspec == expiry(50, 0));
+}
+
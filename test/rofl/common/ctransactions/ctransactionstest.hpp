@@ -0,0 +1,34 @@
+/*
+ * ctransactionstest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_CTRANSACTIONS_TEST_HPP_
+#define TEST_SRC_ROFL_COMMON_CTRANSACTIONS_TEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/ctransactions.hpp"
+
+class ctransactionstest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ctransactionstest);
+  CPPUNIT_TEST(test_add_drop);
+  CPPUNIT_TEST(test_expiry_order);
+  CPPUNIT_TEST(test_replace);
+  CPPUNIT_TEST(test_stale_entries);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void test_add_drop();
+  void test_expiry_order();
+  void test_replace();
+  void test_stale_entries();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_CTRANSACTIONS_TEST_HPP_ */
@@ -0,0 +1,75 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofwriterbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <string.h>
+
+#include <iostream>
+
+#include "cofwritertest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+using namespace rofl::openflow;
+
+namespace {
+
+void benchmark(const std::string &name, cofmsg &msg, unsigned int rounds) {
+  rofl::cmemory txbuffer(65536);
+  cofwriter writer(65536);
+  uint64_t sum = 0;
+
+  /* length() walks all nested elements, pack() computes their lengths again */
+  double t_pack = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < rounds; i++) {
+      size_t msglen = msg.length();
+      memset(txbuffer.somem(), 0, msglen);
+      msg.pack(txbuffer.somem(), msglen);
+      sum += txbuffer[3];
+    }
+  });
+
+  /* single pass, lengths are back-patched */
+  double t_serialize = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < rounds; i++) {
+      writer.clear();
+      msg.serialize(writer);
+      sum += writer.somem()[3];
+    }
+  });
+
+  std::cout << "cofwriter: " << name << " (" << msg.length() << " bytes) x "
+            << rounds << " pack: " << (unsigned long)(t_pack * 1e9 / rounds)
+            << " ns/msg, " << (unsigned long)(rounds / t_pack) << " msgs/s"
+            << " serialize: " << (unsigned long)(t_serialize * 1e9 / rounds)
+            << " ns/msg, " << (unsigned long)(rounds / t_serialize)
+            << " msgs/s (" << sum << ")" << std::endl;
+}
+
+}; // end of anonymous namespace
+
+int main(int argc, char **argv) {
+  const unsigned int rounds = 100000;
+
+  cofmsg_flow_mod *flowmod =
+      cofwritertest::flow_mod(rofl::openflow13::OFP_VERSION, 1);
+  benchmark("flow-mod", *flowmod, rounds);
+  delete flowmod;
+
+  cofmsg_group_mod *groupmod =
+      cofwritertest::group_mod(rofl::openflow13::OFP_VERSION, 1);
+  benchmark("group-mod", *groupmod, rounds);
+  delete groupmod;
+
+  cofmsg_packet_out *packetout =
+      cofwritertest::packet_out(rofl::openflow13::OFP_VERSION, 1);
+  benchmark("packet-out", *packetout, rounds);
+  delete packetout;
+
+  return 0;
+}
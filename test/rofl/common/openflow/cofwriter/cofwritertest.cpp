@@ -0,0 +1,252 @@
+/*
+ * cofwritertest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofwritertest.hpp"
+#include "rofl/common/openflow/messages/cofmsg_echo.h"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofwritertest);
+
+namespace {
+
+/* packs msg via length() and pack() */
+rofl::cmemory legacy(cofmsg &msg) {
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.memlen());
+  return mem;
+}
+
+/* serializes msg behind some unrelated bytes */
+rofl::cmemory serialized(cofmsg &msg) {
+  cofwriter writer(16);
+  writer.put32(0xdeadbeef);
+  msg.serialize(writer);
+  CPPUNIT_ASSERT(be32toh(*(uint32_t *)writer.somem()) == 0xdeadbeef);
+  CPPUNIT_ASSERT(msg.get_length() == writer.length() - sizeof(uint32_t));
+  return rofl::cmemory(writer.at(sizeof(uint32_t)),
+                       writer.length() - sizeof(uint32_t));
+}
+
+void check_identical(cofmsg &msg) {
+  rofl::cmemory packed = legacy(msg);
+  rofl::cmemory written = serialized(msg);
+  if (packed != written) {
+    std::cerr << "pack: " << packed << std::endl
+              << "serialize: " << written << std::endl;
+  }
+  CPPUNIT_ASSERT(packed == written);
+}
+
+}; // end of anonymous namespace
+
+cofmsg_flow_mod *cofwritertest::flow_mod(uint8_t version, uint32_t xid) {
+  cofmsg_flow_mod *msg = new cofmsg_flow_mod(version, xid);
+  cofflowmod &fm = msg->set_flowmod();
+  fm.set_command(OFPFC_ADD);
+  fm.set_table_id(1);
+  fm.set_cookie(0x0102030405060708ULL);
+  fm.set_idle_timeout(30);
+  fm.set_hard_timeout(300);
+  fm.set_priority(0x8000);
+  fm.set_buffer_id(0xffffffff);
+  fm.set_flags(0x0001);
+
+  /* 36 bytes match, padded to 40 bytes in OF1.3 */
+  fm.set_match().set_in_port(3);
+  fm.set_match().set_eth_dst(rofl::caddress_ll("00:11:22:33:44:55"));
+  fm.set_match().set_eth_type(0x0800);
+  fm.set_match().set_ipv4_dst(rofl::caddress_in4("10.1.2.3"));
+
+  if (rofl::openflow10::OFP_VERSION == version) {
+    fm.set_actions().add_action_set_vlan_vid(rofl::cindex(0)).set_vlan_vid(7);
+    fm.set_actions().add_action_output(rofl::cindex(1)).set_port_no(1);
+  } else {
+    fm.set_instructions().set_inst_goto_table().set_table_id(2);
+    fm.set_instructions().set_inst_write_metadata().set_metadata(0xcafe);
+    cofactions &actions =
+        fm.set_instructions().set_inst_apply_actions().set_actions();
+    actions.add_action_push_vlan(rofl::cindex(0)).set_eth_type(0x8100);
+    actions.add_action_set_field(rofl::cindex(1))
+        .set_oxm(coxmatch_ofb_vlan_vid(7 | OFPVID_PRESENT));
+    actions.add_action_output(rofl::cindex(2)).set_port_no(1);
+  }
+  return msg;
+}
+
+cofmsg_group_mod *cofwritertest::group_mod(uint8_t version, uint32_t xid) {
+  cofmsg_group_mod *msg = new cofmsg_group_mod(version, xid);
+  cofgroupmod &gm = msg->set_groupmod();
+  gm.set_command(OFPGC_ADD);
+  gm.set_type(OFPGT_ALL);
+  gm.set_group_id(0x1000);
+  for (unsigned int i = 0; i < 4; i++) {
+    cofbucket &bucket = gm.set_buckets().add_bucket(i);
+    bucket.set_weight(i).set_watch_port(i + 1).set_watch_group(OFPG_ANY);
+    bucket.set_actions()
+        .add_action_set_field(rofl::cindex(0))
+        .set_oxm(coxmatch_ofb_vlan_vid((i + 10) | OFPVID_PRESENT));
+    bucket.set_actions().add_action_output(rofl::cindex(1)).set_port_no(i + 1);
+  }
+  return msg;
+}
+
+cofmsg_packet_out *cofwritertest::packet_out(uint8_t version,
+                                             uint32_t xid) {
+  uint8_t frame[1500];
+  for (unsigned int i = 0; i < sizeof(frame); i++)
+    frame[i] = i;
+  cofactions actions(version);
+  actions.add_action_output(rofl::cindex(0)).set_port_no(OFPP_FLOOD);
+  return new cofmsg_packet_out(version, xid, 0xffffffff, 2, actions, frame,
+                               sizeof(frame));
+}
+
+void cofwritertest::setUp() {}
+
+void cofwritertest::tearDown() {}
+
+void cofwritertest::testWriter() {
+  cofwriter writer(4);
+  CPPUNIT_ASSERT(writer.length() == 0);
+  CPPUNIT_ASSERT(writer.capacity() == 4);
+
+  writer.put8(0x01);
+  writer.put16(0x0203);
+  writer.put32(0x04050607);
+  writer.put64(0x08090a0b0c0d0e0fULL);
+  CPPUNIT_ASSERT(writer.length() == 15);
+  CPPUNIT_ASSERT(writer.capacity() >= 15);
+  for (unsigned int i = 0; i < 15; i++)
+    CPPUNIT_ASSERT(writer.somem()[i] == i + 1);
+
+  /* pad to multiple of 8 relative to offset 1 */
+  writer.align(1, 8);
+  CPPUNIT_ASSERT(writer.length() == 17);
+  CPPUNIT_ASSERT(writer.somem()[15] == 0);
+  CPPUNIT_ASSERT(writer.somem()[16] == 0);
+  writer.align(1, 8);
+  CPPUNIT_ASSERT(writer.length() == 17);
+
+  size_t offset = writer.reserve(3);
+  CPPUNIT_ASSERT(offset == 17);
+  CPPUNIT_ASSERT(writer.length() == 20);
+
+  writer.patch16(1, 0xa0b0);
+  CPPUNIT_ASSERT(writer.somem()[1] == 0xa0);
+  CPPUNIT_ASSERT(writer.somem()[2] == 0xb0);
+
+  /* memory is retained for reuse */
+  size_t capacity = writer.capacity();
+  writer.truncate(7);
+  CPPUNIT_ASSERT(writer.length() == 7);
+  writer.truncate(10);
+  CPPUNIT_ASSERT(writer.length() == 7);
+  writer.clear();
+  CPPUNIT_ASSERT(writer.length() == 0);
+  CPPUNIT_ASSERT(writer.capacity() == capacity);
+
+  /* reserved bytes are zeroed even if previously written */
+  writer.put32(0xffffffff);
+  writer.clear();
+  writer.reserve(4);
+  CPPUNIT_ASSERT(*(uint32_t *)writer.somem() == 0);
+}
+
+void cofwritertest::testPatchLength() {
+  cofwriter writer;
+  writer.put16(0xffff);
+  size_t start = writer.length();
+  writer.put16(0);
+  writer.reserve(10);
+  writer.patch_length16(start, start);
+  CPPUNIT_ASSERT(be16toh(*(uint16_t *)writer.at(start)) == 12);
+
+  writer.reserve(UINT16_MAX);
+  try {
+    writer.patch_length16(start, start);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+}
+
+void cofwritertest::testFlowMod10() {
+  cofmsg_flow_mod *msg = flow_mod(rofl::openflow10::OFP_VERSION, 0x11);
+  check_identical(*msg);
+  delete msg;
+
+  /* without actions */
+  msg = new cofmsg_flow_mod(rofl::openflow10::OFP_VERSION, 0x12);
+  msg->set_flowmod().set_command(OFPFC_DELETE);
+  check_identical(*msg);
+  delete msg;
+}
+
+void cofwritertest::testFlowMod13() {
+  uint8_t versions[] = {rofl::openflow12::OFP_VERSION,
+                        rofl::openflow13::OFP_VERSION};
+  for (auto version : versions) {
+    cofmsg_flow_mod *msg = flow_mod(version, 0x21);
+    check_identical(*msg);
+
+    /* serialized message is parsed back */
+    rofl::cmemory mem = serialized(*msg);
+    cofmsg_flow_mod parsed;
+    parsed.unpack(mem.somem(), mem.memlen());
+    CPPUNIT_ASSERT(parsed.get_flowmod().get_match() ==
+                   msg->get_flowmod().get_match());
+    CPPUNIT_ASSERT(parsed.get_flowmod().get_instructions().length() ==
+                   msg->get_flowmod().get_instructions().length());
+    delete msg;
+
+    /* empty match and no instructions */
+    msg = new cofmsg_flow_mod(version, 0x22);
+    msg->set_flowmod().set_command(OFPFC_DELETE);
+    check_identical(*msg);
+    delete msg;
+  }
+}
+
+void cofwritertest::testGroupMod() {
+  cofmsg_group_mod *msg = group_mod(rofl::openflow13::OFP_VERSION, 0x31);
+  check_identical(*msg);
+  delete msg;
+
+  /* bucket without actions */
+  msg = new cofmsg_group_mod(rofl::openflow13::OFP_VERSION, 0x32);
+  msg->set_groupmod().set_buckets().add_bucket(0).set_weight(1);
+  check_identical(*msg);
+  delete msg;
+}
+
+void cofwritertest::testPacketOut() {
+  uint8_t versions[] = {rofl::openflow10::OFP_VERSION,
+                        rofl::openflow13::OFP_VERSION};
+  for (auto version : versions) {
+    cofmsg_packet_out *msg = packet_out(version, 0x41);
+    check_identical(*msg);
+    delete msg;
+
+    /* buffered packet, no frame */
+    msg = new cofmsg_packet_out(version, 0x42, 0x100, 1);
+    check_identical(*msg);
+    delete msg;
+  }
+}
+
+void cofwritertest::testFallback() {
+  uint8_t data[] = {1, 2, 3, 4, 5};
+  cofmsg_echo_request msg(rofl::openflow13::OFP_VERSION, 0x51, data,
+                          sizeof(data));
+  check_identical(msg);
+}
+
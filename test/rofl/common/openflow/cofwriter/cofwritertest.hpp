@@ -0,0 +1,53 @@
+/*
+ * cofwritertest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COFWRITERTEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COFWRITERTEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/cofwriter.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_group_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_packet_out.h"
+
+class cofwritertest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofwritertest);
+  CPPUNIT_TEST(testWriter);
+  CPPUNIT_TEST(testPatchLength);
+  CPPUNIT_TEST(testFlowMod10);
+  CPPUNIT_TEST(testFlowMod13);
+  CPPUNIT_TEST(testGroupMod);
+  CPPUNIT_TEST(testPacketOut);
+  CPPUNIT_TEST(testFallback);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testWriter();
+  void testPatchLength();
+  void testFlowMod10();
+  void testFlowMod13();
+  void testGroupMod();
+  void testPacketOut();
+  void testFallback();
+
+public:
+  /* messages with nested elements, shared with the benchmark */
+  static rofl::openflow::cofmsg_flow_mod *flow_mod(uint8_t version,
+                                                   uint32_t xid);
+  static rofl::openflow::cofmsg_group_mod *group_mod(uint8_t version,
+                                                     uint32_t xid);
+  static rofl::openflow::cofmsg_packet_out *packet_out(uint8_t version,
+                                                       uint32_t xid);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COFWRITERTEST_HPP_ */
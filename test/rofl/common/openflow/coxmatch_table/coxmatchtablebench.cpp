@@ -0,0 +1,66 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * coxmatchtablebench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "coxmatchtabletest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+using namespace rofl::openflow;
+
+int main(int argc, char **argv) {
+  const unsigned int rounds = 20;
+  std::vector<std::vector<uint8_t>> lists =
+      coxmatchtabletest::corpus(5000, 0x1234567890abcdef);
+
+  /* decode accepted lists only, exception handling is not measured */
+  std::vector<std::vector<uint8_t>> accepted;
+  size_t bytes = 0;
+  for (auto &buf : lists) {
+    try {
+      coxmatches_flat oxms;
+      oxms.unpack(buf.data(), buf.size());
+      accepted.push_back(buf);
+      bytes += buf.size();
+    } catch (eOxmBase &e) {
+    }
+  }
+
+  uint64_t sum = 0;
+  double t_map = cbenchmark::elapsed([&]() {
+    for (unsigned int r = 0; r < rounds; r++) {
+      for (auto &buf : accepted) {
+        coxmatches oxms;
+        oxms.unpack(buf.data(), buf.size());
+        sum += oxms.get_matches().size();
+      }
+    }
+  });
+
+  double t_flat = cbenchmark::elapsed([&]() {
+    for (unsigned int r = 0; r < rounds; r++) {
+      for (auto &buf : accepted) {
+        coxmatches_flat oxms;
+        oxms.unpack(buf.data(), buf.size());
+        sum += oxms.length();
+      }
+    }
+  });
+
+  unsigned long num = rounds * accepted.size();
+  std::cout << "coxmatch_table: " << accepted.size() << " lists, "
+            << bytes / accepted.size() << " bytes avg, x " << rounds
+            << " coxmatches: " << (unsigned long)(t_map * 1e9 / num)
+            << " ns/list, coxmatches_flat: "
+            << (unsigned long)(t_flat * 1e9 / num) << " ns/list (" << sum
+            << ")" << std::endl;
+
+  return 0;
+}
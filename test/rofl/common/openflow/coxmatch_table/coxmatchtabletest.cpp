@@ -0,0 +1,279 @@
+/*
+ * coxmatchtabletest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "coxmatchtabletest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(coxmatchtabletest);
+
+namespace {
+
+/* deterministic generator, the corpus is identical in every run */
+class cprng {
+public:
+  cprng(uint64_t seed) : state(seed){};
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+  unsigned int below(unsigned int n) { return next() % n; };
+
+private:
+  uint64_t state;
+};
+
+uint32_t ofb_id(unsigned int field) {
+  return ((uint32_t)OFPXMC_OPENFLOW_BASIC << 16) | (field << 9);
+}
+
+void put_tlv(std::vector<uint8_t> &buf, uint32_t oxm_id, size_t len,
+             cprng &rng) {
+  oxm_id = (oxm_id & 0xffffff00) | len;
+  buf.push_back(oxm_id >> 24);
+  buf.push_back(oxm_id >> 16);
+  buf.push_back(oxm_id >> 8);
+  buf.push_back(oxm_id);
+  for (size_t i = 0; i < len; i++)
+    buf.push_back(rng.next());
+}
+
+/* appends a valid TLV for field, masked at random if maskable */
+void put_field(std::vector<uint8_t> &buf, unsigned int field, cprng &rng) {
+  const coxmatch_desc *desc = coxmatch_table::lookup(ofb_id(field));
+  if (desc->maskable && rng.below(2)) {
+    put_tlv(buf, desc->oxm_id | HAS_MASK_FLAG, 2 * desc->length, rng);
+  } else {
+    put_tlv(buf, desc->oxm_id, desc->length, rng);
+  }
+}
+
+/* decodes buf via coxmatches, returns false if rejected */
+bool decode_map(std::vector<uint8_t> &buf, rofl::cmemory &packed) {
+  coxmatches oxms;
+  try {
+    oxms.unpack(buf.data(), buf.size());
+  } catch (eOxmBase &e) {
+    return false;
+  }
+  packed.resize(oxms.length());
+  oxms.pack(packed.somem(), packed.memlen());
+  return true;
+}
+
+/* decodes buf via coxmatches_flat, returns false if rejected */
+bool decode_flat(std::vector<uint8_t> &buf, rofl::cmemory &packed) {
+  coxmatches_flat oxms;
+  try {
+    oxms.unpack(buf.data(), buf.size());
+  } catch (eOxmBase &e) {
+    return false;
+  }
+  packed.resize(oxms.length());
+  oxms.pack(packed.somem(), packed.memlen());
+  return true;
+}
+
+}; // end of anonymous namespace
+
+/*
+ * Generates a corpus of OXM TLV lists: most are valid lists in ascending
+ * order as sent by peers, the remainder is derived by typical mutations,
+ * i.e. reordering, duplicates, unknown fields, padding, flipped bits in
+ * the field or length octet of a TLV header and truncation.
+ */
+std::vector<std::vector<uint8_t>>
+coxmatchtabletest::corpus(unsigned int num, uint64_t seed) {
+  cprng rng(seed);
+  std::vector<std::vector<uint8_t>> lists;
+
+  for (unsigned int n = 0; n < num; n++) {
+    std::vector<unsigned int> fields;
+    unsigned int k = 1 + rng.below(8);
+    while (fields.size() < k) {
+      unsigned int field = rng.below(coxmatch_table::OFB_FIELDS);
+      if (std::find(fields.begin(), fields.end(), field) == fields.end())
+        fields.push_back(field);
+    }
+    std::sort(fields.begin(), fields.end());
+
+    unsigned int mutation = rng.below(20);
+    switch (mutation) {
+    case 0: { /* reordered */
+      std::reverse(fields.begin(), fields.end());
+    } break;
+    case 1: { /* duplicate field */
+      fields.push_back(fields[0]);
+    } break;
+    default: {};
+    }
+
+    std::vector<uint8_t> buf;
+    std::vector<size_t> offsets;
+    for (auto field : fields) {
+      if (mutation == 2 && rng.below(2)) { /* unknown field */
+        put_tlv(buf, ofb_id(coxmatch_table::OFB_FIELDS + rng.below(20)),
+                rng.below(16), rng);
+      }
+      offsets.push_back(buf.size());
+      put_field(buf, field, rng);
+    }
+
+    switch (mutation) {
+    case 3: { /* padding of struct ofp_match */
+      buf.resize(buf.size() + rng.below(8), 0);
+    } break;
+    case 4:
+    case 5: { /* flipped bit in field or length octet */
+      size_t offset = offsets[rng.below(offsets.size())] + 2 + rng.below(2);
+      buf[offset] ^= 1 << rng.below(8);
+    } break;
+    case 6: { /* truncated */
+      buf.resize(rng.below(buf.size()));
+    } break;
+    default: {};
+    }
+
+    lists.push_back(buf);
+  }
+  return lists;
+}
+
+void coxmatchtabletest::setUp() {}
+
+void coxmatchtabletest::tearDown() {}
+
+void coxmatchtabletest::testTable() {
+  for (unsigned int field = 0; field < coxmatch_table::OFB_FIELDS; field++) {
+    const coxmatch_desc *desc = coxmatch_table::lookup(ofb_id(field));
+    CPPUNIT_ASSERT(desc != nullptr);
+    CPPUNIT_ASSERT(desc->slot == field);
+    CPPUNIT_ASSERT(OXM_ROFL_TYPE(desc->oxm_id) == ofb_id(field));
+
+    /* descriptor matches typed class */
+    coxmatch *oxm = desc->create();
+    CPPUNIT_ASSERT(oxm->get_oxm_field() == field);
+    CPPUNIT_ASSERT(oxm->length() ==
+                   sizeof(struct ofp_oxm_hdr) + desc->length);
+    delete oxm;
+  }
+
+  CPPUNIT_ASSERT(coxmatch_table::lookup(ofb_id(coxmatch_table::OFB_FIELDS)) ==
+                 nullptr);
+  CPPUNIT_ASSERT(coxmatch_table::lookup(0x00010000 | (3 << 9)) == nullptr);
+  CPPUNIT_ASSERT(coxmatch_table::lookup(0xffff0000) == nullptr);
+}
+
+void coxmatchtabletest::testValidate() {
+  size_t tlvlen = 0;
+
+  /* in_port */
+  uint8_t in_port[] = {0x80, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01};
+  CPPUNIT_ASSERT(coxmatch_table::validate(in_port, sizeof(in_port), tlvlen));
+  CPPUNIT_ASSERT(tlvlen == 8);
+
+  try { /* truncated */
+    coxmatch_table::validate(in_port, sizeof(in_port) - 1, tlvlen);
+    CPPUNIT_ASSERT(false);
+  } catch (eOxmBadLen &e) {
+  }
+
+  try { /* not maskable */
+    uint8_t masked[] = {0x80, 0x00, 0x01, 0x08, 0, 0, 0, 1, 0, 0, 0, 1};
+    coxmatch_table::validate(masked, sizeof(masked), tlvlen);
+    CPPUNIT_ASSERT(false);
+  } catch (eOxmBadLen &e) {
+  }
+
+  try { /* invalid length */
+    uint8_t eth_type[] = {0x80, 0x00, 0x0a, 0x04, 0x08, 0x00, 0x00, 0x00};
+    coxmatch_table::validate(eth_type, sizeof(eth_type), tlvlen);
+    CPPUNIT_ASSERT(false);
+  } catch (eOxmBadLen &e) {
+  }
+
+  /* masked vlan_vid */
+  uint8_t vlan_vid[] = {0x80, 0x00, 0x0d, 0x04, 0x10, 0x01, 0x1f, 0xff};
+  CPPUNIT_ASSERT(coxmatch_table::validate(vlan_vid, sizeof(vlan_vid), tlvlen));
+  CPPUNIT_ASSERT(tlvlen == 8);
+
+  /* unknown field and class are skipped */
+  uint8_t unknown[] = {0x80, 0x00, 0x7e, 0x02, 0xaa, 0xbb};
+  CPPUNIT_ASSERT(
+      not coxmatch_table::validate(unknown, sizeof(unknown), tlvlen));
+  CPPUNIT_ASSERT(tlvlen == 6);
+  uint8_t padding[] = {0x00, 0x00, 0x00, 0x00};
+  CPPUNIT_ASSERT(
+      not coxmatch_table::validate(padding, sizeof(padding), tlvlen));
+  CPPUNIT_ASSERT(tlvlen == 4);
+
+  try { /* experimenter without experimenter id */
+    uint8_t exp[] = {0xff, 0xff, 0x00, 0x02, 0x00, 0x00};
+    coxmatch_table::validate(exp, sizeof(exp), tlvlen);
+    CPPUNIT_ASSERT(false);
+  } catch (eOxmBadLen &e) {
+  }
+}
+
+void coxmatchtabletest::testUnordered() {
+  coxmatches_flat ordered;
+  ordered.add_ofb_in_port(1);
+  ordered.add_ofb_eth_type(0x0800);
+  ordered.add_ofb_ipv4_dst(rofl::caddress_in4("10.0.0.1"));
+
+  rofl::cmemory mem(ordered.length());
+  ordered.pack(mem.somem(), mem.memlen());
+
+  /* reverse order of TLVs (8, 6 and 8 bytes) and insert unknown field */
+  std::vector<uint8_t> buf;
+  buf.insert(buf.end(), mem.somem() + 14, mem.somem() + 22);
+  uint8_t unknown[] = {0x80, 0x00, 0x7e, 0x02, 0xaa, 0xbb};
+  buf.insert(buf.end(), unknown, unknown + sizeof(unknown));
+  buf.insert(buf.end(), mem.somem() + 8, mem.somem() + 14);
+  buf.insert(buf.end(), mem.somem(), mem.somem() + 8);
+
+  coxmatches_flat flat;
+  flat.unpack(buf.data(), buf.size());
+  CPPUNIT_ASSERT(flat == ordered);
+
+  rofl::cmemory packed;
+  CPPUNIT_ASSERT(decode_map(buf, packed));
+  CPPUNIT_ASSERT(packed == mem);
+}
+
+void coxmatchtabletest::testCorpus() {
+  std::vector<std::vector<uint8_t>> lists = corpus(20000, 0x0f1e2d3c4b5a6978);
+
+  /* both decoders must accept and reject the same lists and produce
+   * identical TLV lists */
+  unsigned int accepted = 0;
+  for (auto &buf : lists) {
+    rofl::cmemory map_packed, flat_packed;
+    bool map_ok = decode_map(buf, map_packed);
+    bool flat_ok = decode_flat(buf, flat_packed);
+    CPPUNIT_ASSERT(map_ok == flat_ok);
+    if (map_ok) {
+      CPPUNIT_ASSERT(map_packed == flat_packed);
+      accepted++;
+    }
+  }
+
+  std::cerr << "coxmatchtabletest::testCorpus() " << lists.size()
+            << " lists, " << accepted << " accepted" << std::endl;
+  CPPUNIT_ASSERT(accepted > lists.size() / 2);
+  CPPUNIT_ASSERT(accepted < lists.size());
+}
+
@@ -0,0 +1,44 @@
+/*
+ * coxmatchtabletest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCHTABLETEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCHTABLETEST_HPP_
+
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/coxmatch_table.h"
+#include "rofl/common/openflow/coxmatches.h"
+#include "rofl/common/openflow/coxmatches_flat.h"
+
+class coxmatchtabletest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(coxmatchtabletest);
+  CPPUNIT_TEST(testTable);
+  CPPUNIT_TEST(testValidate);
+  CPPUNIT_TEST(testUnordered);
+  CPPUNIT_TEST(testCorpus);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testTable();
+  void testValidate();
+  void testUnordered();
+  void testCorpus();
+
+public:
+  /* OXM TLV lists, shared with the benchmark */
+  static std::vector<std::vector<uint8_t>> corpus(unsigned int num,
+                                                  uint64_t seed);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCHTABLETEST_HPP_ */
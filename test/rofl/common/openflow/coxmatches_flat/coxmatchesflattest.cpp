@@ -0,0 +1,367 @@
+/*
+ * coxmatchesflattest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <atomic>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "coxmatchesflattest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(coxmatchesflattest);
+
+void coxmatchesflattest::setUp() {}
+
+void coxmatchesflattest::tearDown() {}
+
+void coxmatchesflattest::testPack() {
+  coxmatches matches;
+  coxmatches_flat flat;
+
+  matches.add_ofb_eth_dst(rofl::cmacaddr("b1:b2:b3:b4:b5:b6"),
+                          rofl::cmacaddr("ff:ff:ff:ff:ff:ff"));
+  matches.add_ofb_eth_src(rofl::cmacaddr("c1:c2:c3:c4:c5:c6"),
+                          rofl::cmacaddr("d1:d2:d3:d4:d5:d6"));
+  matches.add_ofb_vlan_vid(0x3132, 0x4142);
+  matches.add_ofb_ip_dscp(0xa1);
+  matches.add_ofb_udp_src(0x1112);
+
+  /* insertion order differs, wire order must not */
+  flat.add_ofb_udp_src(0x1112);
+  flat.add_ofb_vlan_vid(0x3132, 0x4142);
+  flat.add_ofb_eth_src(rofl::cmacaddr("c1:c2:c3:c4:c5:c6"),
+                       rofl::cmacaddr("d1:d2:d3:d4:d5:d6"));
+  flat.add_ofb_ip_dscp(0xa1);
+  flat.add_ofb_eth_dst(rofl::cmacaddr("b1:b2:b3:b4:b5:b6"),
+                       rofl::cmacaddr("ff:ff:ff:ff:ff:ff"));
+
+  CPPUNIT_ASSERT(flat.length() == matches.length());
+  CPPUNIT_ASSERT(flat.size() == 5);
+  CPPUNIT_ASSERT(flat.get_ids() == matches.get_ids());
+
+  rofl::cmemory mem(matches.length());
+  matches.pack(mem.somem(), mem.memlen());
+
+  rofl::cmemory test(flat.length());
+  flat.pack(test.somem(), test.memlen());
+
+  CPPUNIT_ASSERT(mem == test);
+
+  rofl::cmemory shorty(flat.length() - 1);
+  try {
+    flat.pack(shorty.somem(), shorty.memlen());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadMatchBadLen &e) {
+  }
+}
+
+void coxmatchesflattest::testUnPack() {
+  coxmatches matches;
+  matches.add_ofb_in_port(3);
+  matches.add_ofb_eth_type(0x0800);
+  matches.add_ofb_ipv4_dst(rofl::caddress_in4("10.1.1.0"),
+                           rofl::caddress_in4("255.255.255.0"));
+  matches.add_ofb_tunnel_id(0xa1a2a3a4a5a6a7a8ULL);
+
+  rofl::cmemory mem(matches.length() + 3); // trailing padding
+  matches.pack(mem.somem(), matches.length());
+
+  coxmatches_flat flat;
+  flat.unpack(mem.somem(), mem.memlen());
+
+  CPPUNIT_ASSERT(flat.size() == 4);
+  CPPUNIT_ASSERT(flat.length() == matches.length());
+  CPPUNIT_ASSERT(flat.get_ofb_in_port().get_u32value() == 3);
+  CPPUNIT_ASSERT(flat.get_ofb_eth_type().get_u16value() == 0x0800);
+  CPPUNIT_ASSERT(flat.get_ofb_ipv4_dst().get_u32value_as_addr() ==
+                 rofl::caddress_in4("10.1.1.0"));
+  CPPUNIT_ASSERT(flat.get_ofb_ipv4_dst().get_u32mask_as_addr() ==
+                 rofl::caddress_in4("255.255.255.0"));
+  CPPUNIT_ASSERT(flat.get_ofb_tunnel_id().get_u64value() ==
+                 0xa1a2a3a4a5a6a7a8ULL);
+
+  /* TLVs arriving out of order are sorted */
+  rofl::cmemory reversed(0);
+  std::vector<uint64_t> ids = flat.get_ids();
+  for (std::vector<uint64_t>::reverse_iterator it = ids.rbegin();
+       it != ids.rend(); ++it) {
+    coxmatches_flat single;
+    single.unpack(mem.somem(), matches.length());
+    for (std::vector<uint64_t>::iterator jt = ids.begin(); jt != ids.end();
+         ++jt) {
+      if (*jt != *it)
+        single.drop(*jt);
+    }
+    rofl::cmemory tlv(single.length());
+    single.pack(tlv.somem(), tlv.memlen());
+    reversed += tlv;
+  }
+  coxmatches_flat sorted;
+  sorted.unpack(reversed.somem(), reversed.memlen());
+  CPPUNIT_ASSERT(sorted == flat);
+
+  /* truncated TLV */
+  try {
+    coxmatches_flat truncated;
+    truncated.unpack(mem.somem(), matches.length() - 1);
+    CPPUNIT_ASSERT(false);
+  } catch (eOxmBadLen &e) {
+  }
+}
+
+void coxmatchesflattest::testAddMatch() {
+  coxmatches_flat flat;
+
+  flat.add_ofb_eth_type(0x0800);
+  flat.add_ofb_ip_proto(6);
+  CPPUNIT_ASSERT(flat.size() == 2);
+  CPPUNIT_ASSERT(flat.has_ofb_eth_type());
+  CPPUNIT_ASSERT(flat.has_ofb_ip_proto());
+  CPPUNIT_ASSERT(not flat.has_ofb_ip_dscp());
+
+  /* replace with a TLV of different length */
+  size_t len = flat.length();
+  flat.add_ofb_eth_type(0x86dd);
+  CPPUNIT_ASSERT(flat.size() == 2);
+  CPPUNIT_ASSERT(flat.length() == len);
+  CPPUNIT_ASSERT(flat.get_ofb_eth_type().get_u16value() == 0x86dd);
+
+  flat.add_ofb_metadata(0x1122334455667788ULL, 0xffffffff00000000ULL);
+  flat.add_ofb_metadata(0x8877665544332211ULL);
+  CPPUNIT_ASSERT(flat.size() == 3);
+  CPPUNIT_ASSERT(flat.get_ofb_metadata().get_u64value() ==
+                 0x8877665544332211ULL);
+  CPPUNIT_ASSERT(not flat.get_ofb_metadata().get_oxm_hasmask());
+  CPPUNIT_ASSERT(flat.get_ofb_ip_proto().get_u8value() == 6);
+
+  try {
+    flat.get_ofb_tcp_src();
+    CPPUNIT_ASSERT(false);
+  } catch (eOxmInval &e) {
+  }
+}
+
+void coxmatchesflattest::testDropMatch() {
+  coxmatches_flat flat;
+
+  flat.add_ofb_in_port(1);
+  flat.add_ofb_eth_type(0x0800);
+  flat.add_ofb_ipv4_src(rofl::caddress_in4("192.168.1.1"));
+
+  CPPUNIT_ASSERT(flat.drop_ofb_eth_type());
+  CPPUNIT_ASSERT(not flat.drop_ofb_eth_type());
+  CPPUNIT_ASSERT(flat.size() == 2);
+  CPPUNIT_ASSERT(flat.get_ofb_in_port().get_u32value() == 1);
+  CPPUNIT_ASSERT(flat.get_ofb_ipv4_src().get_u32value_as_addr() ==
+                 rofl::caddress_in4("192.168.1.1"));
+
+  flat.clear();
+  CPPUNIT_ASSERT(flat.empty());
+  CPPUNIT_ASSERT(flat.size() == 0);
+}
+
+void coxmatchesflattest::testCopyAndHash() {
+  coxmatches_flat flat;
+  flat.add_ofb_in_port(1);
+  flat.add_ofb_eth_dst(rofl::cmacaddr("00:11:22:33:44:55"));
+  flat.add_ofb_ipv6_src(rofl::caddress_in6("fe80::1"));
+
+  coxmatches_flat copy(flat);
+  CPPUNIT_ASSERT(copy == flat);
+  CPPUNIT_ASSERT(copy.hash() == flat.hash());
+
+  coxmatches_flat other;
+  other = flat;
+  other.add_ofb_in_port(2);
+  CPPUNIT_ASSERT(other != flat);
+  CPPUNIT_ASSERT(other.hash() != flat.hash());
+
+  other.add_ofb_in_port(1);
+  CPPUNIT_ASSERT(other == flat);
+  CPPUNIT_ASSERT(other.hash() == flat.hash());
+}
+
+void coxmatchesflattest::testConversion() {
+  coxmatches matches;
+  matches.add_ofb_vlan_vid(0x1005, 0x1fff);
+  matches.add_ofb_mpls_label(0x12345);
+  matches.add_ofx_nw_src(rofl::caddress_in4("10.0.0.1"),
+                         rofl::caddress_in4("255.0.0.0"));
+
+  coxmatches_flat flat(matches);
+  CPPUNIT_ASSERT(flat.length() == matches.length());
+  CPPUNIT_ASSERT(flat.get_ofb_vlan_vid().get_u16value() == 0x1005);
+  CPPUNIT_ASSERT(flat.get_ofb_mpls_label().get_u32value() == 0x12345);
+  CPPUNIT_ASSERT(flat.get_ofx_nw_src().get_u32mask() == 0xff000000);
+
+  coxmatches clone = flat.get_matches();
+  CPPUNIT_ASSERT(clone.get_ids() == matches.get_ids());
+  CPPUNIT_ASSERT(clone.get_ofb_mpls_label().get_u32value() == 0x12345);
+  CPPUNIT_ASSERT(clone.get_ofx_nw_src().get_u32value() == 0x0a000001);
+}
+
+void coxmatchesflattest::testExp() {
+  uint32_t exp_id = 0x40414243;
+  uint32_t oxm_id = (((uint32_t)0xffff) << 16) | (((uint32_t)0x52) << 9);
+  uint64_t u64value = 0xe0e1e2e3e4e5e6e7ULL;
+
+  coxmatches_flat flat;
+  coxmatch_exp oxm(oxm_id, exp_id, u64value);
+  flat.add_exp_match(oxm);
+  flat.add_ofx_nw_proto(17);
+  flat.add_ofb_eth_type(0x0800);
+
+  CPPUNIT_ASSERT(flat.has_exp_match(exp_id, oxm_id));
+  CPPUNIT_ASSERT(not flat.has_exp_match(exp_id + 1, oxm_id));
+
+  rofl::cmemory mem(flat.length());
+  flat.pack(mem.somem(), mem.memlen());
+
+  coxmatches_flat clone;
+  clone.unpack(mem.somem(), mem.memlen());
+  CPPUNIT_ASSERT(clone == flat);
+  CPPUNIT_ASSERT(clone.get_exp_match(exp_id, oxm_id).get_u64value() ==
+                 u64value);
+  CPPUNIT_ASSERT(clone.get_ofx_nw_proto().get_u8value() == 17);
+
+  coxmatches matches;
+  matches.unpack(mem.somem(), mem.memlen());
+  CPPUNIT_ASSERT(matches.get_exp_match(exp_id, oxm_id).get_u64value() ==
+                 u64value);
+
+  CPPUNIT_ASSERT(clone.drop_exp_match(exp_id, oxm_id));
+  CPPUNIT_ASSERT(clone.size() == 2);
+}
+
+void coxmatchesflattest::testGrow() {
+  coxmatches_flat flat;
+  uint32_t exp_id = 0x40414243;
+  rofl::cmemory value(120);
+  const unsigned int num = 8;
+
+  /* list moves from the inline buffer to the heap */
+  for (unsigned int i = 0; i < num; i++) {
+    uint32_t oxm_id = (((uint32_t)0xffff) << 16) | (i << 9);
+    value[0] = i;
+    coxmatch_exp oxm(oxm_id, exp_id);
+    oxm.set_value(value);
+    flat.add_exp_match(oxm);
+  }
+  CPPUNIT_ASSERT(flat.size() == num);
+  CPPUNIT_ASSERT(flat.length() == num * (8 + 120));
+  CPPUNIT_ASSERT(flat.length() > coxmatches_flat::INLINE_CAPACITY);
+
+  coxmatches_flat clone(flat);
+  CPPUNIT_ASSERT(clone == flat);
+  CPPUNIT_ASSERT(clone.hash() == flat.hash());
+
+  rofl::cmemory mem(flat.length());
+  flat.pack(mem.somem(), mem.memlen());
+  coxmatches_flat unpacked;
+  unpacked.unpack(mem.somem(), mem.memlen());
+  CPPUNIT_ASSERT(unpacked == flat);
+  CPPUNIT_ASSERT(unpacked.get_matches().get_matches().size() == num);
+
+  /* shrinking keeps the heap buffer intact */
+  for (unsigned int i = 1; i < num; i++) {
+    CPPUNIT_ASSERT(clone.drop_exp_match(exp_id, (((uint32_t)0xffff) << 16) |
+                                                    (i << 9)));
+  }
+  CPPUNIT_ASSERT(clone.size() == 1);
+  flat = clone;
+  CPPUNIT_ASSERT(flat == clone);
+  CPPUNIT_ASSERT(
+      flat.get_exp_match(exp_id, ((uint32_t)0xffff) << 16).get_value()[0] ==
+      0);
+}
+
+void coxmatchesflattest::testContains() {
+  coxmatches_flat left, right;
+  uint16_t exact_hits = 0, wildcard_hits = 0, missed = 0;
+
+  left.add_ofb_eth_type(0x0800);
+  left.add_ofb_ip_proto(17);
+
+  right.add_ofb_in_port(1);
+  right.add_ofb_eth_type(0x0800);
+  right.add_ofb_ip_proto(17);
+  right.add_ofb_udp_dst(53);
+
+  CPPUNIT_ASSERT(left.contains(right));
+  CPPUNIT_ASSERT(not left.contains(right, true));
+  CPPUNIT_ASSERT(not right.contains(left));
+  CPPUNIT_ASSERT(left.contains(left, true));
+
+  CPPUNIT_ASSERT(left.is_part_of(right, exact_hits, wildcard_hits, missed));
+  CPPUNIT_ASSERT(exact_hits == 2);
+  CPPUNIT_ASSERT(wildcard_hits == 2);
+  CPPUNIT_ASSERT(missed == 0);
+
+  /* same field, different value */
+  right.add_ofb_ip_proto(6);
+  CPPUNIT_ASSERT(not left.contains(right));
+  exact_hits = wildcard_hits = missed = 0;
+  CPPUNIT_ASSERT(
+      not left.is_part_of(right, exact_hits, wildcard_hits, missed));
+  CPPUNIT_ASSERT(exact_hits == 1);
+  CPPUNIT_ASSERT(wildcard_hits == 2);
+  CPPUNIT_ASSERT(missed == 1);
+}
+
+void coxmatchesflattest::testMatchView() {
+  cofmatch match(rofl::openflow13::OFP_VERSION);
+  match.set_eth_type(0x0800);
+
+  /* modifications via the coxmatches reference are synced back */
+  coxmatches &oxms = match.set_matches();
+  CPPUNIT_ASSERT(oxms.has_ofb_eth_type());
+  oxms.add_ofb_ip_proto(17);
+  CPPUNIT_ASSERT(match.get_ip_proto() == 17);
+  match.set_matches().add_ofb_udp_dst(53);
+  CPPUNIT_ASSERT(match.get_udp_dst() == 53);
+  CPPUNIT_ASSERT(match.get_matches().has_ofb_udp_dst());
+
+  /* concurrent readers import pending modifications once */
+  match.set_matches().add_ofb_ipv4_dst(rofl::caddress_in4("10.0.0.1"));
+  const cofmatch &cmatch = match;
+  std::atomic<unsigned int> hits(0);
+  std::vector<std::thread> readers;
+  for (unsigned int i = 0; i < 4; i++) {
+    readers.push_back(std::thread([&]() {
+      for (unsigned int j = 0; j < 1000; j++) {
+        if ((cmatch.get_flat_matches().size() == 4) &&
+            (cmatch.get_matches().has_ofb_ipv4_dst()))
+          hits++;
+      }
+    }));
+  }
+  for (auto &reader : readers)
+    reader.join();
+  CPPUNIT_ASSERT(hits == 4000);
+  match.set_flat_matches().drop_ofb_ipv4_dst();
+
+  cofmatch clone(match);
+  CPPUNIT_ASSERT(clone == match);
+  CPPUNIT_ASSERT(clone.get_flat_matches().size() == 3);
+
+  /* and vice versa */
+  match.set_udp_dst(5353);
+  CPPUNIT_ASSERT(match.get_matches().get_ofb_udp_dst().get_u16value() ==
+                 5353);
+  CPPUNIT_ASSERT(not(clone == match));
+
+  rofl::cmemory mem(match.length());
+  match.pack(mem.somem(), mem.memlen());
+  cofmatch unpacked(rofl::openflow13::OFP_VERSION);
+  unpacked.unpack(mem.somem(), mem.memlen());
+  CPPUNIT_ASSERT(unpacked == match);
+  CPPUNIT_ASSERT(unpacked.contains(match, true));
+}
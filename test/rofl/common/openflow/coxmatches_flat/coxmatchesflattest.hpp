@@ -0,0 +1,48 @@
+/*
+ * coxmatchesflattest.hpp
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCHESFLATTEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCHESFLATTEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/cofmatch.h"
+#include "rofl/common/openflow/coxmatches_flat.h"
+
+class coxmatchesflattest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(coxmatchesflattest);
+  CPPUNIT_TEST(testPack);
+  CPPUNIT_TEST(testUnPack);
+  CPPUNIT_TEST(testAddMatch);
+  CPPUNIT_TEST(testDropMatch);
+  CPPUNIT_TEST(testCopyAndHash);
+  CPPUNIT_TEST(testConversion);
+  CPPUNIT_TEST(testExp);
+  CPPUNIT_TEST(testGrow);
+  CPPUNIT_TEST(testContains);
+  CPPUNIT_TEST(testMatchView);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testPack();
+  void testUnPack();
+  void testAddMatch();
+  void testDropMatch();
+  void testCopyAndHash();
+  void testConversion();
+  void testExp();
+  void testGrow();
+  void testContains();
+  void testMatchView();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_COXMATCHESFLATTEST_HPP_ */
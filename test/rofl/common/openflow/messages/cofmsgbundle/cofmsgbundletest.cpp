@@ -0,0 +1,242 @@
+/*
+ * cofmsgbundletest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgbundletest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgbundletest);
+
+void cofmsgbundletest::setUp() {}
+
+void cofmsgbundletest::tearDown() {}
+
+void cofmsgbundletest::testBundleControl() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  cofmsg_bundle_control msg(version, 0xa1a2a3a4, 0xb1b2b3b4,
+                            rofl::openflow14::OFPBCT_COMMIT_REQUEST,
+                            rofl::openflow14::OFPBF_ATOMIC |
+                                rofl::openflow14::OFPBF_ORDERED);
+  CPPUNIT_ASSERT(msg.is_request());
+  CPPUNIT_ASSERT(msg.length() == 16);
+
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+
+  struct rofl::openflow14::ofp_bundle_ctrl_msg *hdr =
+      (struct rofl::openflow14::ofp_bundle_ctrl_msg *)mem.somem();
+  CPPUNIT_ASSERT(hdr->header.version == version);
+  CPPUNIT_ASSERT(hdr->header.type == rofl::openflow14::OFPT_BUNDLE_CONTROL);
+  CPPUNIT_ASSERT(be16toh(hdr->header.length) == 16);
+  CPPUNIT_ASSERT(be32toh(hdr->bundle_id) == 0xb1b2b3b4);
+  CPPUNIT_ASSERT(be16toh(hdr->type) ==
+                 rofl::openflow14::OFPBCT_COMMIT_REQUEST);
+  CPPUNIT_ASSERT(be16toh(hdr->flags) == 3);
+
+  cofmsg_bundle_control clone;
+  clone.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(clone.get_xid() == 0xa1a2a3a4);
+  CPPUNIT_ASSERT(clone.get_bundle_id() == 0xb1b2b3b4);
+  CPPUNIT_ASSERT(clone.get_ctrl_type() ==
+                 rofl::openflow14::OFPBCT_COMMIT_REQUEST);
+  CPPUNIT_ASSERT(clone.get_flags() == 3);
+  CPPUNIT_ASSERT(clone.get_properties().empty());
+
+  /* reply with an experimenter property */
+  cofmsg_bundle_control reply(version, 0xa1a2a3a4, 0xb1b2b3b4,
+                              rofl::openflow14::OFPBCT_COMMIT_REPLY);
+  reply.set_properties().resize(12);
+  reply.set_properties()[1] = 0xff;
+  reply.set_properties()[3] = 12;
+  CPPUNIT_ASSERT(not reply.is_request());
+  rofl::cmemory rmem(reply.length());
+  reply.pack(rmem.somem(), rmem.length());
+  CPPUNIT_ASSERT(rmem.length() == 28);
+
+  cofmsg_bundle_control rclone;
+  rclone.unpack(rmem.somem(), rmem.length());
+  CPPUNIT_ASSERT(rclone.get_properties() == reply.get_properties());
+
+  /* truncated message */
+  try {
+    cofmsg_bundle_control truncated;
+    rofl::cmemory short_mem(mem.somem(), 12);
+    ((struct rofl::openflow14::ofp_header *)short_mem.somem())->length =
+        htobe16(12);
+    truncated.unpack(short_mem.somem(), short_mem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadRequestBadLen &e) {
+  }
+}
+
+void cofmsgbundletest::testBundleAddFlowMod() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  cofflowmod fe(version);
+  fe.set_command(rofl::openflow::OFPFC_ADD);
+  fe.set_table_id(1);
+  fe.set_cookie(0xc1c2c3c4);
+  fe.set_match().set_eth_dst(rofl::caddress_ll("00:11:22:33:44:55"));
+  fe.set_instructions()
+      .set_inst_apply_actions()
+      .set_actions()
+      .add_action_output(rofl::cindex(0))
+      .set_port_no(3);
+
+  /* inner xid differs on purpose and is overwritten when packing */
+  cofmsg_flow_mod *inner = new cofmsg_flow_mod(version, 0x11111111, fe);
+  size_t innerlen = inner->length();
+  cofmsg_bundle_add_message msg(version, 0xa1a2a3a4, 7,
+                                rofl::openflow14::OFPBF_ATOMIC, inner);
+  CPPUNIT_ASSERT(msg.length() == 16 + innerlen);
+
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+
+  struct rofl::openflow14::ofp_bundle_add_msg *hdr =
+      (struct rofl::openflow14::ofp_bundle_add_msg *)mem.somem();
+  CPPUNIT_ASSERT(hdr->header.type ==
+                 rofl::openflow14::OFPT_BUNDLE_ADD_MESSAGE);
+  CPPUNIT_ASSERT(be32toh(hdr->bundle_id) == 7);
+  CPPUNIT_ASSERT(be16toh(hdr->flags) == rofl::openflow14::OFPBF_ATOMIC);
+  CPPUNIT_ASSERT(hdr->message.type == rofl::openflow::OFPT_FLOW_MOD);
+  CPPUNIT_ASSERT(be32toh(hdr->message.xid) == 0xa1a2a3a4);
+  CPPUNIT_ASSERT(be16toh(hdr->message.length) == innerlen);
+
+  cofmsg_bundle_add_message clone;
+  clone.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(clone.get_bundle_id() == 7);
+  CPPUNIT_ASSERT(clone.has_message());
+  const cofmsg_flow_mod &fm =
+      dynamic_cast<const cofmsg_flow_mod &>(clone.get_message());
+  CPPUNIT_ASSERT(fm.get_xid() == 0xa1a2a3a4);
+  CPPUNIT_ASSERT(fm.get_flowmod().get_cookie() == 0xc1c2c3c4);
+  CPPUNIT_ASSERT(fm.get_flowmod().get_match().get_eth_dst() ==
+                 rofl::caddress_ll("00:11:22:33:44:55"));
+
+  /* copies own a clone of the embedded message */
+  cofmsg_bundle_add_message copy(clone);
+  CPPUNIT_ASSERT(&copy.get_message() != &clone.get_message());
+  rofl::cmemory cmem(copy.length());
+  copy.pack(cmem.somem(), cmem.length());
+  CPPUNIT_ASSERT(cmem == mem);
+
+  cofmsg *released = copy.release_message();
+  CPPUNIT_ASSERT(not copy.has_message());
+  delete released;
+}
+
+void cofmsgbundletest::testBundleAddGroupMod() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  cofgroupmod ge(version, rofl::openflow13::OFPGC_ADD,
+                 rofl::openflow13::OFPGT_ALL, 0x31);
+  ge.set_buckets().add_bucket(0).set_actions().add_action_output(
+      rofl::cindex(0)).set_port_no(1);
+
+  cofmsg_bundle_add_message msg(version, 0xa1a2a3a4, 8, 0,
+                                new cofmsg_group_mod(version, 0, ge));
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+
+  cofmsg_bundle_add_message clone;
+  clone.unpack(mem.somem(), mem.length());
+  const cofmsg_group_mod &gm =
+      dynamic_cast<const cofmsg_group_mod &>(clone.get_message());
+  CPPUNIT_ASSERT(gm.get_groupmod().get_group_id() == 0x31);
+  CPPUNIT_ASSERT(gm.get_groupmod().get_buckets().has_bucket(0));
+}
+
+void cofmsgbundletest::testBundleAddMeterMod() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  cofmsg_bundle_add_message msg(
+      version, 0xa1a2a3a4, 9, 0,
+      new cofmsg_meter_mod(version, 0, rofl::openflow13::OFPMC_ADD,
+                           rofl::openflow13::OFPMF_KBPS, 0x41));
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+
+  cofmsg_bundle_add_message clone;
+  clone.unpack(mem.somem(), mem.length());
+  const cofmsg_meter_mod &mm =
+      dynamic_cast<const cofmsg_meter_mod &>(clone.get_message());
+  CPPUNIT_ASSERT(mm.get_command() == rofl::openflow13::OFPMC_ADD);
+  CPPUNIT_ASSERT(mm.get_meter_id() == 0x41);
+}
+
+void cofmsgbundletest::testBundleAddProperties() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  cofmsg_bundle_add_message msg(version, 0xa1a2a3a4, 10, 0,
+                                new cofmsg_meter_mod(version));
+  msg.set_properties().resize(12);
+  msg.set_properties()[1] = 0xff;
+  msg.set_properties()[3] = 12;
+
+  /* properties start on the next 8 byte boundary after the message */
+  size_t msglen = 16 + msg.get_message().length();
+  CPPUNIT_ASSERT(msg.length() == ((msglen + 7) / 8) * 8 + 12);
+
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+
+  cofmsg_bundle_add_message clone;
+  clone.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(clone.get_properties() == msg.get_properties());
+  CPPUNIT_ASSERT(clone.length() == msg.length());
+}
+
+void cofmsgbundletest::testBadVersion() {
+  cofmsg_bundle_control msg(rofl::openflow13::OFP_VERSION, 1, 1,
+                            rofl::openflow14::OFPBCT_OPEN_REQUEST);
+  try {
+    msg.length();
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadVersion &e) {
+  }
+
+  cofmsg_bundle_control valid(rofl::openflow14::OFP_VERSION, 1, 1,
+                              rofl::openflow14::OFPBCT_OPEN_REQUEST);
+  rofl::cmemory mem(valid.length());
+  valid.pack(mem.somem(), mem.length());
+  mem[0] = rofl::openflow13::OFP_VERSION;
+  try {
+    cofmsg_bundle_control clone;
+    clone.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadRequestBadVersion &e) {
+  }
+}
+
+void cofmsgbundletest::testUnsupportedMessage() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+  cofmsg_bundle_add_message msg(version, 1, 1, 0,
+                                new cofmsg_meter_mod(version));
+  rofl::cmemory mem(msg.length());
+  msg.pack(mem.somem(), mem.length());
+
+  /* turn the embedded Meter-Mod into a Barrier-Request */
+  ((struct rofl::openflow14::ofp_bundle_add_msg *)mem.somem())->message.type =
+      rofl::openflow14::OFPT_BARRIER_REQUEST;
+  try {
+    cofmsg_bundle_add_message clone;
+    clone.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadRequestBadType &e) {
+  }
+
+  /* a bundle without message cannot be packed */
+  cofmsg_bundle_add_message empty(version, 1, 1, 0);
+  rofl::cmemory emem(empty.length());
+  try {
+    empty.pack(emem.somem(), emem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+}
@@ -0,0 +1,44 @@
+/*
+ * cofmsgbundletest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGBUNDLETEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGBUNDLETEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg_bundle.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_group_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_meter_mod.h"
+
+class cofmsgbundletest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgbundletest);
+  CPPUNIT_TEST(testBundleControl);
+  CPPUNIT_TEST(testBundleAddFlowMod);
+  CPPUNIT_TEST(testBundleAddGroupMod);
+  CPPUNIT_TEST(testBundleAddMeterMod);
+  CPPUNIT_TEST(testBundleAddProperties);
+  CPPUNIT_TEST(testBadVersion);
+  CPPUNIT_TEST(testUnsupportedMessage);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testBundleControl();
+  void testBundleAddFlowMod();
+  void testBundleAddGroupMod();
+  void testBundleAddMeterMod();
+  void testBundleAddProperties();
+  void testBadVersion();
+  void testUnsupportedMessage();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGBUNDLETEST_HPP_ */
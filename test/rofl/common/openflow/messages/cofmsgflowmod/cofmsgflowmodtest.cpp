@@ -362,3 +362,71 @@ void cofmsgflowmodtest::testFlowModParser13() {
     }
   }
 }
+
+void cofmsgflowmodtest::testFlowModLazy() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::openflow::cofflowmod flowmod(version);
+  flowmod.set_command(rofl::openflow13::OFPFC_ADD);
+  flowmod.set_priority(0x8000);
+  flowmod.set_match().set_in_port(3);
+  flowmod.set_match().set_eth_type(0x0800);
+  flowmod.set_match().set_ipv4_dst(rofl::caddress_in4("10.1.2.3"));
+  flowmod.set_instructions().set_inst_goto_table().set_table_id(2);
+  rofl::openflow::cofmsg_flow_mod msg1(version, 0xa1a2a3a4, flowmod);
+
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(msg1.length()));
+  msg1.pack(chunk->somem(), chunk->length());
+  rofl::cmemory orig(*chunk);
+
+  rofl::openflow::cofmsg_flow_mod msg2;
+  msg2.unpack_lazy(rofl::cslice(chunk, 0, chunk->length()));
+  CPPUNIT_ASSERT(msg2.get_version() == version);
+  CPPUNIT_ASSERT(msg2.get_xid() == 0xa1a2a3a4);
+  CPPUNIT_ASSERT(msg2.length() == orig.length());
+
+  /* unmodified message is copied, xid is rewritten */
+  msg2.set_xid(0xb1b2b3b4);
+  rofl::cmemory mem(msg2.length());
+  msg2.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(be32toh(((struct rofl::openflow::ofp_header *)mem.somem())
+                             ->xid) == 0xb1b2b3b4);
+  CPPUNIT_ASSERT(0 == memcmp(mem.somem() + 8, orig.somem() + 8,
+                             orig.length() - 8));
+
+  /* copies keep the receive buffer alive */
+  rofl::openflow::cofmsg_flow_mod msg3(msg2);
+  chunk.reset();
+
+  /* decoded on first access */
+  CPPUNIT_ASSERT(msg3.get_flowmod().get_match() == flowmod.get_match());
+  CPPUNIT_ASSERT(msg3.get_flowmod().get_priority() == 0x8000);
+  rofl::openflow::cofwriter writer;
+  msg3.serialize(writer);
+  CPPUNIT_ASSERT(writer.length() == orig.length());
+  CPPUNIT_ASSERT(0 == memcmp(writer.at(8), orig.somem() + 8,
+                             orig.length() - 8));
+
+  /* modifications are packed */
+  msg3.set_flowmod().set_priority(0x9000);
+  msg3.set_flowmod().set_match().set_eth_type(0x86dd);
+  rofl::cmemory mod(msg3.length());
+  msg3.pack(mod.somem(), mod.length());
+  rofl::openflow::cofmsg_flow_mod msg4;
+  msg4.unpack(mod.somem(), mod.length());
+  CPPUNIT_ASSERT(msg4.get_flowmod().get_priority() == 0x9000);
+  CPPUNIT_ASSERT(msg4.get_flowmod().get_match().get_eth_type() == 0x86dd);
+
+  /* malformed bodies are reported on every access */
+  std::shared_ptr<rofl::cmemory> bad(new rofl::cmemory(orig));
+  ((struct rofl::openflow13::ofp_flow_mod *)bad->somem())->match.length =
+      htobe16(0xfff0);
+  rofl::openflow::cofmsg_flow_mod msg5;
+  msg5.unpack_lazy(rofl::cslice(bad, 0, bad->length()));
+  for (unsigned int i = 0; i < 2; i++) {
+    try {
+      msg5.get_flowmod();
+      CPPUNIT_ASSERT(false);
+    } catch (rofl::exception &e) {
+    }
+  }
+}
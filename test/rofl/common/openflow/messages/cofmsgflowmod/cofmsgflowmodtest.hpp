@@ -22,6 +22,7 @@ class cofmsgflowmodtest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testFlowModParser10);
   CPPUNIT_TEST(testFlowModParser12);
   CPPUNIT_TEST(testFlowModParser13);
+  CPPUNIT_TEST(testFlowModLazy);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +36,7 @@ public:
   void testFlowModParser10();
   void testFlowModParser12();
   void testFlowModParser13();
+  void testFlowModLazy();
 
 private:
   void testFlowMod(uint8_t version, uint8_t type, uint32_t xid);
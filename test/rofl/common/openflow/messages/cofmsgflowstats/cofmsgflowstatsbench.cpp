@@ -0,0 +1,57 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsgflowstatsbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "cofmsgflowstatstest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+using namespace rofl::openflow;
+
+int main(int argc, char **argv) {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  const unsigned int rounds = 2000;
+  cofmsg_flow_stats_reply msg(
+      version, 1, 0, cofmsgflowstatstest::flow_stats_array(version, 64));
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(msg.length()));
+  msg.pack(chunk->somem(), chunk->length());
+  rofl::cslice slice(chunk, 0, chunk->length());
+  rofl::cmemory txbuffer(chunk->length());
+  uint64_t sum = 0;
+
+  /* proxy: parse, rewrite xid, pack again */
+  double t_eager = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < rounds; i++) {
+      cofmsg_flow_stats_reply reply;
+      reply.unpack_shared(slice);
+      reply.set_xid(i);
+      reply.pack(txbuffer.somem(), txbuffer.length());
+      sum += txbuffer[7];
+    }
+  });
+
+  double t_lazy = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < rounds; i++) {
+      cofmsg_flow_stats_reply reply;
+      reply.unpack_lazy(slice);
+      reply.set_xid(i);
+      reply.pack(txbuffer.somem(), txbuffer.length());
+      sum += txbuffer[7];
+    }
+  });
+
+  std::cout << "cofmsgflowstats: flow-stats-reply (" << chunk->length()
+            << " bytes, 64 entries) x " << rounds
+            << " eager: " << (unsigned long)(t_eager * 1e9 / rounds)
+            << " ns/msg lazy: " << (unsigned long)(t_lazy * 1e9 / rounds)
+            << " ns/msg (" << sum << ")" << std::endl;
+
+  return 0;
+}
@@ -16,6 +16,38 @@ using namespace rofl::openflow;
 
 CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgflowstatstest);
 
+namespace {
+
+std::shared_ptr<rofl::cmemory> packed(cofmsg &msg) {
+  std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(msg.length()));
+  msg.pack(chunk->somem(), chunk->length());
+  return chunk;
+}
+
+}; // end of anonymous namespace
+
+cofflowstatsarray cofmsgflowstatstest::flow_stats_array(uint8_t version,
+                                                        unsigned int num) {
+  cofflowstatsarray array(version);
+  for (unsigned int i = 0; i < num; i++) {
+    cofflow_stats_reply &stats = array.add_flow_stats(i);
+    stats.set_table_id(i % 4);
+    stats.set_priority(0x8000 + i);
+    stats.set_cookie(0xa0a1a2a3a4a5a6a7ULL + i);
+    stats.set_packet_count(i * 100);
+    stats.set_byte_count(i * 6400);
+    stats.set_match().set_in_port(1 + i % 8);
+    stats.set_match().set_eth_type(0x0800);
+    stats.set_match().set_ipv4_dst(rofl::caddress_in4("10.0.0.1"));
+    stats.set_instructions()
+        .set_inst_apply_actions()
+        .set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(2 + i % 8);
+  }
+  return array;
+}
+
 void cofmsgflowstatstest::setUp() {}
 
 void cofmsgflowstatstest::tearDown() {}
@@ -604,3 +636,78 @@ void cofmsgflowstatstest::testReplyParser13() {
     }
   }
 }
+
+void cofmsgflowstatstest::testRequestLazy() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  cofflow_stats_request request(version);
+  request.set_table_id(1);
+  request.set_match().set_eth_type(0x0800);
+  cofmsg_flow_stats_request msg1(version, 0xa1a2a3a4, 0, request);
+  std::shared_ptr<rofl::cmemory> chunk = packed(msg1);
+
+  cofmsg_flow_stats_request msg2;
+  msg2.unpack_lazy(rofl::cslice(chunk, 0, chunk->length()));
+  CPPUNIT_ASSERT(msg2.get_stats_type() == rofl::openflow13::OFPMP_FLOW);
+  CPPUNIT_ASSERT(msg2.length() == chunk->length());
+
+  rofl::cmemory mem(msg2.length());
+  msg2.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == *chunk);
+
+  CPPUNIT_ASSERT(msg2.get_flow_stats().get_table_id() == 1);
+  CPPUNIT_ASSERT(msg2.get_flow_stats().get_match() == request.get_match());
+
+  msg2.set_flow_stats().set_table_id(2);
+  msg2.pack(mem.somem(), mem.length());
+  cofmsg_flow_stats_request msg3;
+  msg3.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(msg3.get_flow_stats().get_table_id() == 2);
+}
+
+void cofmsgflowstatstest::testReplyLazy() {
+  uint8_t versions[] = {rofl::openflow10::OFP_VERSION,
+                        rofl::openflow13::OFP_VERSION};
+  for (auto version : versions) {
+    cofmsg_flow_stats_reply msg1(version, 0xa1a2a3a4, 0,
+                                 flow_stats_array(version, 8));
+    std::shared_ptr<rofl::cmemory> chunk = packed(msg1);
+
+    cofmsg_flow_stats_reply msg2;
+    msg2.unpack_lazy(rofl::cslice(chunk, 0, chunk->length()));
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.length() == chunk->length());
+
+    /* stats flags are rewritten, body is copied */
+    msg2.set_stats_flags(rofl::openflow13::OFPMPF_REPLY_MORE);
+    rofl::cmemory mem(msg2.length());
+    msg2.pack(mem.somem(), mem.length());
+    rofl::cmemory expected(*chunk);
+    ((struct rofl::openflow13::ofp_multipart_reply *)expected.somem())
+        ->flags = htobe16(rofl::openflow13::OFPMPF_REPLY_MORE);
+    CPPUNIT_ASSERT(mem == expected);
+
+    /* decoded on first access like an eagerly parsed message */
+    cofmsg_flow_stats_reply eager;
+    eager.unpack(chunk->somem(), chunk->length());
+    CPPUNIT_ASSERT(msg2.get_flow_stats_array() ==
+                   eager.get_flow_stats_array());
+    CPPUNIT_ASSERT(msg2.get_flow_stats_array().size() == 8);
+
+    /* empty array */
+    cofmsg_flow_stats_reply msg3(version, 0xa1a2a3a4);
+    chunk = packed(msg3);
+    cofmsg_flow_stats_reply msg4;
+    msg4.unpack_lazy(rofl::cslice(chunk, 0, chunk->length()));
+    CPPUNIT_ASSERT(msg4.get_flow_stats_array().size() == 0);
+
+    /* wrong stats type is rejected early */
+    ((struct rofl::openflow13::ofp_multipart_reply *)chunk->somem())->type =
+        htobe16(rofl::openflow13::OFPMP_TABLE);
+    try {
+      msg4.unpack_lazy(rofl::cslice(chunk, 0, chunk->length()));
+      CPPUNIT_ASSERT(false);
+    } catch (rofl::eBadRequestBadStat &e) {
+    }
+  }
+}
+
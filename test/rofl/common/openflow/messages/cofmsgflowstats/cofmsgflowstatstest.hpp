@@ -28,6 +28,8 @@ class cofmsgflowstatstest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testReplyParser10);
   CPPUNIT_TEST(testReplyParser12);
   CPPUNIT_TEST(testReplyParser13);
+  CPPUNIT_TEST(testRequestLazy);
+  CPPUNIT_TEST(testReplyLazy);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -47,6 +49,13 @@ public:
   void testReplyParser10();
   void testReplyParser12();
   void testReplyParser13();
+  void testRequestLazy();
+  void testReplyLazy();
+
+public:
+  /* reply entries with match and instructions, shared with the benchmark */
+  static rofl::openflow::cofflowstatsarray flow_stats_array(uint8_t version,
+                                                            unsigned int num);
 
 private:
   void testRequest(uint8_t version, uint8_t type, uint32_t xid,
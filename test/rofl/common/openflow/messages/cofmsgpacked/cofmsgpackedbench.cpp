@@ -0,0 +1,74 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsgpackedbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "cofmsgpackedtest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+using namespace rofl::openflow;
+
+int main(int argc, char **argv) {
+  const unsigned int num_flows = 50000;
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::cmemory txbuffer(65536);
+  uint64_t sum = 0;
+
+  /* entries copied into segment arrays, segments packed on transmission */
+  cofmsg_flow_stats_reply *msg =
+      cofmsgpackedtest::flow_stats(version, 1, num_flows);
+  clegacysegmenter legacy;
+  std::list<cofmsg_flow_stats_reply *> legacy_segments;
+  size_t num_legacy_segments = 0;
+  uint64_t allocs = cofmsgpackedtest::get_num_allocs();
+  double t_legacy = cbenchmark::elapsed([&]() {
+    legacy.segment(msg, legacy_segments);
+    num_legacy_segments = legacy_segments.size();
+    for (auto segment : legacy_segments) {
+      segment->pack(txbuffer.somem(), segment->length());
+      sum += txbuffer[7];
+      delete segment;
+    }
+  });
+  uint64_t legacy_allocs = cofmsgpackedtest::get_num_allocs() - allocs;
+
+  /* entries packed into segments, segments copied on transmission */
+  msg = cofmsgpackedtest::flow_stats(version, 1, num_flows);
+  cofmsg_segmenter segmenter;
+  std::list<cofmsg_packed *> segments;
+  size_t num_segments = 0;
+  allocs = cofmsgpackedtest::get_num_allocs();
+  double t_packed = cbenchmark::elapsed([&]() {
+    segmenter.segment(*msg, segments);
+    delete msg;
+    num_segments = segments.size();
+    for (auto segment : segments) {
+      segment->pack(txbuffer.somem(), segment->length());
+      sum += txbuffer[7];
+      delete segment;
+    }
+  });
+  uint64_t packed_allocs = cofmsgpackedtest::get_num_allocs() - allocs;
+
+  std::cout << "cofmsgpacked: flows=" << num_flows
+            << " arrays: " << (unsigned long)(t_legacy * 1e6) << " us, "
+            << num_legacy_segments << " segments, " << legacy.entries_copied
+            << " entry copies, " << legacy.entries_packed
+            << " entries packed, " << legacy_allocs << " allocations"
+            << std::endl;
+  std::cout << "cofmsgpacked: flows=" << num_flows
+            << " packed: " << (unsigned long)(t_packed * 1e6) << " us, "
+            << num_segments << " segments, "
+            << segmenter.get_entries_packed() << " entries packed, "
+            << segmenter.get_bytes_packed() << " bytes, " << packed_allocs
+            << " allocations (" << sum << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,240 @@
+/*
+ * cofmsgpackedtest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <new>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgpackedtest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgpackedtest);
+
+namespace {
+
+std::atomic<uint64_t> num_allocs(0);
+
+}; // end of anonymous namespace
+
+void *operator new(size_t size) {
+  num_allocs++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+uint64_t cofmsgpackedtest::get_num_allocs() { return num_allocs; }
+
+cofmsg_flow_stats_reply *cofmsgpackedtest::flow_stats(uint8_t version,
+                                                      uint32_t xid,
+                                                      unsigned int num_flows) {
+  cofmsg_flow_stats_reply *msg = new cofmsg_flow_stats_reply(version, xid);
+  for (unsigned int i = 0; i < num_flows; i++) {
+    cofflow_stats_reply &fs = msg->set_flow_stats_array().add_flow_stats(i);
+    fs.set_cookie(i).set_packet_count(2 * i);
+    fs.set_match().set_eth_dst(rofl::caddress_ll(i + 1));
+    fs.set_instructions()
+        .set_inst_apply_actions()
+        .set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(i % 48);
+  }
+  return msg;
+}
+
+void cofmsgpackedtest::setUp() {}
+
+void cofmsgpackedtest::tearDown() {}
+
+void cofmsgpackedtest::testPacked() {
+  cofmsg_flow_stats_reply *msg =
+      flow_stats(rofl::openflow13::OFP_VERSION, 0xa1a2a3a4, 3);
+  cofmsg_packed packed(msg->get_version(), msg->get_type(), 0xb1b2b3b4,
+                       msg->length());
+  msg->pack(packed.somem(), packed.length());
+
+  /* xid of the wire image is rewritten on packing */
+  rofl::cmemory mem(packed.length());
+  packed.pack(mem.somem(), mem.length());
+  msg->set_xid(0xb1b2b3b4);
+  rofl::cmemory expected(msg->length());
+  msg->pack(expected.somem(), expected.length());
+  CPPUNIT_ASSERT(mem == expected);
+  delete msg;
+
+  cofmsg_packed unpacked;
+  unpacked.unpack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(unpacked.get_xid() == 0xb1b2b3b4);
+  CPPUNIT_ASSERT(unpacked.get_wire() == expected);
+
+  try {
+    packed.pack(mem.somem(), mem.length() - 1);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+}
+
+void cofmsgpackedtest::testFlowStats13() {
+  const unsigned int num_flows = 5000;
+  cofmsg_flow_stats_reply *msg =
+      flow_stats(rofl::openflow13::OFP_VERSION, 0x11121314, num_flows);
+  size_t total = msg->length();
+
+  cofmsg_segmenter segmenter(65535);
+  std::list<cofmsg_packed *> segments;
+  CPPUNIT_ASSERT(segmenter.segment(*msg, segments));
+  delete msg;
+
+  CPPUNIT_ASSERT(segments.size() > 1);
+  CPPUNIT_ASSERT(segmenter.get_entries_packed() == num_flows);
+  CPPUNIT_ASSERT(segmenter.get_segments_packed() == segments.size());
+
+  cofflowstatsarray reassembled(rofl::openflow13::OFP_VERSION);
+  size_t bytes = 0;
+  while (not segments.empty()) {
+    cofmsg_packed *segment = segments.front();
+    segments.pop_front();
+    CPPUNIT_ASSERT(segment->length() <= 65535);
+    bytes += segment->length();
+
+    rofl::cmemory mem(segment->length());
+    segment->pack(mem.somem(), mem.length());
+    cofmsg_flow_stats_reply part;
+    part.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(part.get_xid() == 0x11121314);
+    CPPUNIT_ASSERT(part.length() == segment->length());
+    CPPUNIT_ASSERT(
+        segments.empty() ==
+        not(part.get_stats_flags() & rofl::openflow13::OFPMPF_REPLY_MORE));
+    reassembled += part.get_flow_stats_array();
+    delete segment;
+  }
+
+  CPPUNIT_ASSERT(segmenter.get_bytes_packed() == bytes);
+  CPPUNIT_ASSERT(reassembled.size() == num_flows);
+  /* one multipart header per segment in addition to the entries */
+  CPPUNIT_ASSERT(bytes - total ==
+                 (segmenter.get_segments_packed() - 1) *
+                     sizeof(struct rofl::openflow13::ofp_multipart_reply));
+  CPPUNIT_ASSERT(reassembled.get_flow_stats(4711).get_cookie() == 4711);
+  CPPUNIT_ASSERT(reassembled.get_flow_stats(4711).get_match().get_eth_dst() ==
+                 rofl::caddress_ll(4712));
+}
+
+void cofmsgpackedtest::testPortStats12() {
+  const unsigned int num_ports = 1000;
+  cofmsg_port_stats_reply msg(rofl::openflow12::OFP_VERSION, 0x21222324);
+  for (unsigned int i = 0; i < num_ports; i++) {
+    msg.set_port_stats_array().add_port_stats(i).set_port_no(i).set_rx_packets(
+        i);
+  }
+
+  cofmsg_segmenter segmenter(4096);
+  std::list<cofmsg_packed *> segments;
+  CPPUNIT_ASSERT(segmenter.segment(msg, segments));
+  CPPUNIT_ASSERT(segmenter.get_entries_packed() == num_ports);
+
+  unsigned int count = 0;
+  while (not segments.empty()) {
+    cofmsg_packed *segment = segments.front();
+    segments.pop_front();
+    CPPUNIT_ASSERT(segment->length() <= 4096);
+
+    rofl::cmemory mem(segment->length());
+    segment->pack(mem.somem(), mem.length());
+    cofmsg_port_stats_reply part;
+    part.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(
+        segments.empty() ==
+        not(part.get_stats_flags() & rofl::openflow12::OFPSF_REPLY_MORE));
+    const cofportstatsarray &array = part.get_port_stats_array();
+    for (auto port_no : array.keys()) {
+      CPPUNIT_ASSERT(array.get_port_stats(port_no).get_rx_packets() ==
+                     port_no);
+      count++;
+    }
+    delete segment;
+  }
+  CPPUNIT_ASSERT(count == num_ports);
+}
+
+void cofmsgpackedtest::testSingleSegment() {
+  cofmsg_flow_stats_reply *msg =
+      flow_stats(rofl::openflow13::OFP_VERSION, 1, 10);
+
+  cofmsg_segmenter segmenter;
+  std::list<cofmsg_packed *> segments;
+  CPPUNIT_ASSERT(segmenter.segment(*msg, segments));
+  CPPUNIT_ASSERT(segments.size() == 1);
+
+  /* identical to the unsegmented message */
+  rofl::cmemory expected(msg->length());
+  msg->pack(expected.somem(), expected.length());
+  rofl::cmemory mem(segments.front()->length());
+  segments.front()->pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+
+  delete segments.front();
+  delete msg;
+}
+
+void cofmsgpackedtest::testUnsupported() {
+  cofmsg_queue_stats_reply msg(rofl::openflow13::OFP_VERSION, 1);
+  msg.set_queue_stats_array().add_queue_stats(1, 1);
+
+  cofmsg_segmenter segmenter;
+  std::list<cofmsg_packed *> segments;
+  CPPUNIT_ASSERT(not segmenter.segment(msg, segments));
+  CPPUNIT_ASSERT(segments.empty());
+  CPPUNIT_ASSERT(segmenter.get_segments_packed() == 0);
+}
+
+void cofmsgpackedtest::testCopies() {
+  const unsigned int num_flows = 5000;
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+
+  /* entries copied into an array and once more into the message */
+  cofmsg_flow_stats_reply *msg = flow_stats(version, 1, num_flows);
+  clegacysegmenter legacy;
+  std::list<cofmsg_flow_stats_reply *> legacy_segments;
+  uint64_t allocs = get_num_allocs();
+  legacy.segment(msg, legacy_segments);
+  uint64_t legacy_allocs = get_num_allocs() - allocs;
+  for (auto segment : legacy_segments)
+    delete segment;
+
+  /* entries packed in place */
+  msg = flow_stats(version, 1, num_flows);
+  cofmsg_segmenter segmenter;
+  std::list<cofmsg_packed *> segments;
+  allocs = get_num_allocs();
+  CPPUNIT_ASSERT(segmenter.segment(*msg, segments));
+  uint64_t packed_allocs = get_num_allocs() - allocs;
+  CPPUNIT_ASSERT(segmenter.get_segments_packed() == segments.size());
+  delete msg;
+  for (auto segment : segments)
+    delete segment;
+
+  CPPUNIT_ASSERT(legacy.entries_packed == num_flows);
+  CPPUNIT_ASSERT(legacy.entries_copied == 2 * num_flows);
+  CPPUNIT_ASSERT(segmenter.get_entries_packed() == num_flows);
+
+  /* at least one allocation saved per entry copy of the legacy path */
+  std::cerr << "cofmsgpackedtest::testCopies() flows=" << num_flows
+            << " legacy: " << legacy.entries_copied << " entry copies, "
+            << legacy_allocs << " allocations, packed: " << packed_allocs
+            << " allocations" << std::endl;
+  CPPUNIT_ASSERT(legacy_allocs >= packed_allocs + legacy.entries_copied);
+}
@@ -0,0 +1,94 @@
+/*
+ * cofmsgpackedtest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGPACKEDTEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGPACKEDTEST_HPP_
+
+#include <list>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_packed.h"
+#include "rofl/common/openflow/messages/cofmsg_port_stats.h"
+#include "rofl/common/openflow/messages/cofmsg_queue_stats.h"
+
+/* previous crofconn implementation copying entries into a new array per
+ * segment, shared with the benchmark */
+struct clegacysegmenter {
+  uint64_t entries_copied;
+  uint64_t entries_packed;
+
+  clegacysegmenter() : entries_copied(0), entries_packed(0){};
+
+  void segment(rofl::openflow::cofmsg_flow_stats_reply *msg,
+               std::list<rofl::openflow::cofmsg_flow_stats_reply *> &segments) {
+    const int MAX_LENGTH = 64000 /*bytes*/;
+    auto flowids = msg->get_flow_stats_array().keys();
+
+    while (not flowids.empty()) {
+      rofl::openflow::cofflowstatsarray array(msg->get_version());
+
+      while ((not flowids.empty()) && (array.length() < MAX_LENGTH)) {
+        uint32_t flowid = flowids.front();
+        flowids.pop_front();
+        array.add_flow_stats(flowid) =
+            msg->get_flow_stats_array().get_flow_stats(flowid);
+        entries_copied++;
+      }
+
+      segments.push_back(new rofl::openflow::cofmsg_flow_stats_reply(
+          msg->get_version(), msg->get_xid(), msg->get_stats_flags(), array));
+      /* and once more when constructing the message */
+      entries_copied += array.size();
+      entries_packed += array.size();
+    }
+    delete msg;
+
+    for (auto it = segments.begin(); it != segments.end(); ++it) {
+      if (std::next(it) != segments.end()) {
+        (*it)->set_stats_flags((*it)->get_stats_flags() |
+                               rofl::openflow13::OFPMPF_REPLY_MORE);
+      }
+    }
+  };
+};
+
+class cofmsgpackedtest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgpackedtest);
+  CPPUNIT_TEST(testPacked);
+  CPPUNIT_TEST(testFlowStats13);
+  CPPUNIT_TEST(testPortStats12);
+  CPPUNIT_TEST(testSingleSegment);
+  CPPUNIT_TEST(testUnsupported);
+  CPPUNIT_TEST(testCopies);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testPacked();
+  void testFlowStats13();
+  void testPortStats12();
+  void testSingleSegment();
+  void testUnsupported();
+  void testCopies();
+
+public:
+  /* flow-stats reply with num_flows entries of 96 bytes */
+  static rofl::openflow::cofmsg_flow_stats_reply *
+  flow_stats(uint8_t version, uint32_t xid, unsigned int num_flows);
+
+  /* heap allocations made by this process so far, every copy of a
+   * flow-stats entry allocates its match, instructions and actions */
+  static uint64_t get_num_allocs();
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGPACKEDTEST_HPP_ */
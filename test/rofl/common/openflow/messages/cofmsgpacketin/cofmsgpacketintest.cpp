@@ -372,3 +372,72 @@ void cofmsgpacketintest::testPacketInParser13() {
     }
   }
 }
+
+void cofmsgpacketintest::testPacketInLazy() {
+  uint8_t versions[] = {rofl::openflow10::OFP_VERSION,
+                        rofl::openflow12::OFP_VERSION,
+                        rofl::openflow13::OFP_VERSION};
+  for (auto version : versions) {
+    uint8_t frame[64];
+    for (unsigned int i = 0; i < sizeof(frame); i++)
+      frame[i] = i;
+    rofl::openflow::cofmatch match(version);
+    match.set_in_port(7);
+    if (version > rofl::openflow10::OFP_VERSION) {
+      /* 5 bytes TLV, padded */
+      match.set_ip_proto(17);
+    }
+    rofl::openflow::cofmsg_packet_in msg1(version, 0xa1a2a3a4, 0x100,
+                                          sizeof(frame), 1, 2, 0xcafe, 7,
+                                          match, frame, sizeof(frame));
+
+    std::shared_ptr<rofl::cmemory> chunk(new rofl::cmemory(msg1.length()));
+    msg1.pack(chunk->somem(), chunk->length());
+
+    rofl::openflow::cofmsg_packet_in msg2;
+    msg2.unpack_lazy(rofl::cslice(chunk, 0, chunk->length()));
+    CPPUNIT_ASSERT(msg2.get_buffer_id() == 0x100);
+    CPPUNIT_ASSERT(msg2.get_packet().length() == sizeof(frame));
+    CPPUNIT_ASSERT(0 ==
+                   memcmp(msg2.get_packet().soframe(), frame, sizeof(frame)));
+    CPPUNIT_ASSERT(msg2.length() == chunk->length());
+
+    rofl::cmemory mem(msg2.length());
+    msg2.pack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(mem == *chunk);
+
+    CPPUNIT_ASSERT(msg2.get_match().get_in_port() == 7);
+    if (version > rofl::openflow10::OFP_VERSION) {
+      CPPUNIT_ASSERT(msg2.get_match().get_ip_proto() == 17);
+    }
+
+    /* modified match is packed */
+    msg2.set_match().set_eth_type(0x0800);
+    rofl::cmemory mod(msg2.length());
+    msg2.pack(mod.somem(), mod.length());
+    rofl::openflow::cofmsg_packet_in msg3;
+    msg3.unpack(mod.somem(), mod.length());
+    CPPUNIT_ASSERT(msg3.get_packet().length() == sizeof(frame));
+    if (version > rofl::openflow10::OFP_VERSION) {
+      CPPUNIT_ASSERT(msg3.get_match().get_eth_type() == 0x0800);
+    }
+
+    if (version == rofl::openflow10::OFP_VERSION)
+      continue;
+
+    /* malformed match is reported on every access */
+    std::shared_ptr<rofl::cmemory> bad(new rofl::cmemory(*chunk));
+    struct rofl::openflow13::ofp_packet_in *hdr =
+        (struct rofl::openflow13::ofp_packet_in *)bad->somem();
+    hdr->match.oxm_fields[3] = 0xff; /* first OXM TLV's length */
+    rofl::openflow::cofmsg_packet_in msg4;
+    msg4.unpack_lazy(rofl::cslice(bad, 0, bad->length()));
+    for (unsigned int i = 0; i < 2; i++) {
+      try {
+        msg4.get_match();
+        CPPUNIT_ASSERT(false);
+      } catch (rofl::exception &e) {
+      }
+    }
+  }
+}
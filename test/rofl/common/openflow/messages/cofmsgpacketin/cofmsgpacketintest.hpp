@@ -22,6 +22,7 @@ class cofmsgpacketintest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testPacketInParser10);
   CPPUNIT_TEST(testPacketInParser12);
   CPPUNIT_TEST(testPacketInParser13);
+  CPPUNIT_TEST(testPacketInLazy);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +36,7 @@ public:
   void testPacketInParser10();
   void testPacketInParser12();
   void testPacketInParser13();
+  void testPacketInLazy();
 
 private:
   void testPacketIn(uint8_t version, uint8_t type, uint32_t xid);
@@ -242,3 +242,70 @@ void cofmsgportdescstatstest::testReplyParser13() {
     }
   }
 }
+
+void cofmsgportdescstatstest::testReply14() {
+  uint8_t version = rofl::openflow14::OFP_VERSION;
+
+  /* ports of different length due to their properties */
+  cofports ports(version);
+  ports.add_port(1).set_ethernet().set_advertised(0xb1b2b3b4);
+  ports.add_port(2).set_ethernet().set_advertised(0xc1c2c3c4);
+  ports.set_port(2).add_optical().set_supported(0xd1d2d3d4);
+  ports.add_port(3).drop_ethernet();
+
+  rofl::openflow::cofmsg_port_desc_stats_reply msg1(version, 0xa1a2a3a4,
+                                                    0xb1b2, ports);
+  rofl::openflow::cofmsg_port_desc_stats_reply msg2;
+  rofl::cmemory mem(msg1.length());
+
+  try {
+    msg1.pack(mem.somem(), mem.length());
+
+    /* each port announces its own length on the wire */
+    struct rofl::openflow13::ofp_multipart_reply *hdr =
+        (struct rofl::openflow13::ofp_multipart_reply *)mem.somem();
+    uint8_t *body = hdr->body;
+    for (unsigned int portno = 1; portno <= 3; portno++) {
+      struct rofl::openflow14::ofp_port *port =
+          (struct rofl::openflow14::ofp_port *)body;
+      CPPUNIT_ASSERT(be32toh(port->port_no) == portno);
+      CPPUNIT_ASSERT(be16toh(port->length) ==
+                     ports.get_port(portno).length());
+      body += be16toh(port->length);
+    }
+    CPPUNIT_ASSERT(body == mem.somem() + mem.length());
+
+    msg2.unpack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(msg2.get_version() == version);
+    CPPUNIT_ASSERT(msg2.get_length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.length() == msg1.length());
+    CPPUNIT_ASSERT(msg2.get_ports().size() == 3);
+    CPPUNIT_ASSERT(msg2.get_ports().get_port(1).get_ethernet().get_advertised() ==
+                   0xb1b2b3b4);
+    CPPUNIT_ASSERT(msg2.get_ports().get_port(2).get_ethernet().get_advertised() ==
+                   0xc1c2c3c4);
+    CPPUNIT_ASSERT(msg2.get_ports().get_port(2).get_optical().get_supported() ==
+                   0xd1d2d3d4);
+    CPPUNIT_ASSERT(not msg2.get_ports().get_port(3).has_ethernet());
+
+  } catch (...) {
+    std::cerr << ">>> reply <<<" << std::endl << msg1;
+    std::cerr << ">>> memory <<<" << std::endl << mem;
+    std::cerr << ">>> clone <<<" << std::endl << msg2;
+    throw;
+  }
+
+  /* a port exceeding the message is rejected */
+  struct rofl::openflow14::ofp_port *port =
+      (struct rofl::openflow14::ofp_port *)(
+          (struct rofl::openflow13::ofp_multipart_reply *)mem.somem())
+          ->body;
+  port->length = htobe16(mem.length());
+  try {
+    rofl::openflow::cofmsg_port_desc_stats_reply msg;
+    msg.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eBadRequestBadLen &e) {
+  }
+}
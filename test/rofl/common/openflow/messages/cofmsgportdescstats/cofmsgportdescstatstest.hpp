@@ -20,6 +20,7 @@ class cofmsgportdescstatstest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testReply13);
   CPPUNIT_TEST(testRequestParser13);
   CPPUNIT_TEST(testReplyParser13);
+  CPPUNIT_TEST(testReply14);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -31,6 +32,7 @@ public:
   void testReply13();
   void testRequestParser13();
   void testReplyParser13();
+  void testReply14();
 
 private:
   void testRequest(uint8_t version, uint8_t type, uint32_t xid,
@@ -0,0 +1,59 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * cofmsgtemplatebench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "cofmsgtemplatetest.hpp"
+#include "rofl/common/cbenchmark.hpp"
+
+using namespace rofl::openflow;
+
+int main(int argc, char **argv) {
+  const unsigned int num_msgs = 200000;
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  rofl::caddress_ll src("00:00:00:00:00:00");
+  rofl::caddress_ll dst("00:00:00:00:00:00");
+  rofl::cmemory txbuffer(256);
+  uint64_t sum = 0;
+
+  /* cofflowmod and cofmsg_flow_mod constructed and packed per message */
+  double t_legacy = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_msgs; i++) {
+      rofl::caddress_ll idst(0x0000b1b2b3b4b500ULL + (i & 0xff));
+      cofmsg *msg = new cofmsg_flow_mod(
+          version, i, cofmsgtemplatetest::flowmod(version, src, idst, i, 0));
+      msg->pack(txbuffer.somem(), msg->length());
+      sum += txbuffer[7];
+      delete msg;
+    }
+  });
+
+  /* template stamped per message */
+  cofmsg_flow_mod proto(version, 0,
+                        cofmsgtemplatetest::flowmod(version, src, dst, 0, 0));
+  cofmsg_template tmpl(proto);
+  double t_stamped = cbenchmark::elapsed([&]() {
+    for (unsigned int i = 0; i < num_msgs; i++) {
+      rofl::caddress_ll idst(0x0000b1b2b3b4b500ULL + (i & 0xff));
+      cofmsg_stamped *msg = tmpl.stamp(i);
+      msg->set_eth_dst(idst).set_out_port(i);
+      msg->pack(txbuffer.somem(), msg->length());
+      sum += txbuffer[7];
+      delete msg;
+    }
+  });
+
+  std::cout << "cofmsgtemplate: flow-mods/s cofflowmod="
+            << (unsigned long)(num_msgs / t_legacy)
+            << " cofmsg_template=" << (unsigned long)(num_msgs / t_stamped)
+            << " (" << sum << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * cofmsgtemplatetest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include "cofmsgtemplatetest.hpp"
+
+using namespace rofl::openflow;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cofmsgtemplatetest);
+
+/* flow entry as installed by ethswctld */
+cofflowmod cofmsgtemplatetest::flowmod(uint8_t version,
+                                       const rofl::caddress_ll &src,
+                                       const rofl::caddress_ll &dst,
+                                       uint32_t port_no, uint64_t cookie) {
+  cofflowmod fe(version);
+  fe.set_command(rofl::openflow::OFPFC_ADD);
+  fe.set_table_id(0);
+  fe.set_hard_timeout(60);
+  fe.set_cookie(cookie);
+  fe.set_match().set_eth_src(src);
+  fe.set_match().set_eth_dst(dst);
+  switch (version) {
+  case rofl::openflow10::OFP_VERSION: {
+    fe.set_actions().add_action_output(rofl::cindex(0)).set_port_no(port_no);
+  } break;
+  default: {
+    fe.set_instructions()
+        .set_inst_apply_actions()
+        .set_actions()
+        .add_action_output(rofl::cindex(0))
+        .set_port_no(port_no);
+  };
+  }
+  return fe;
+}
+
+void cofmsgtemplatetest::setUp() {}
+
+void cofmsgtemplatetest::tearDown() {}
+
+void cofmsgtemplatetest::testFlowMod10() {
+  testFlowMod(rofl::openflow10::OFP_VERSION);
+}
+
+void cofmsgtemplatetest::testFlowMod12() {
+  testFlowMod(rofl::openflow12::OFP_VERSION);
+}
+
+void cofmsgtemplatetest::testFlowMod13() {
+  testFlowMod(rofl::openflow13::OFP_VERSION);
+}
+
+void cofmsgtemplatetest::testFlowMod(uint8_t version) {
+  rofl::caddress_ll src("00:00:00:00:00:00");
+  rofl::caddress_ll dst("00:00:00:00:00:00");
+  cofmsg_flow_mod proto(version, 0, flowmod(version, src, dst, 0, 0));
+  cofmsg_template tmpl(proto);
+
+  CPPUNIT_ASSERT(tmpl.get_version() == version);
+  CPPUNIT_ASSERT(tmpl.get_type() == rofl::openflow::OFPT_FLOW_MOD);
+  CPPUNIT_ASSERT(tmpl.length() == proto.length());
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_ETH_SRC));
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_ETH_DST));
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_OUT_PORT));
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_COOKIE));
+  CPPUNIT_ASSERT(not tmpl.has_field(cofmsg_template::FIELD_IN_PORT));
+
+  for (unsigned int i = 1; i < 16; i++) {
+    rofl::caddress_ll isrc(0x0000a1a2a3a4a500ULL + i);
+    rofl::caddress_ll idst(0x0000b1b2b3b4b500ULL + i);
+    uint32_t port_no = 0x100 + i;
+    uint32_t xid = 0xa1a2a300 + i;
+
+    cofmsg_flow_mod msg(version, xid,
+                        flowmod(version, isrc, idst, port_no, 0xc1c2c3c4 + i));
+    rofl::cmemory expected(msg.length());
+    msg.pack(expected.somem(), expected.length());
+
+    cofmsg_stamped *stamped = tmpl.stamp(xid);
+    stamped->set_eth_src(isrc).set_eth_dst(idst).set_out_port(port_no);
+    stamped->set_field(cofmsg_template::FIELD_COOKIE, 0xc1c2c3c4 + i);
+    rofl::cmemory mem(stamped->length());
+    stamped->pack(mem.somem(), mem.length());
+
+    CPPUNIT_ASSERT(stamped->get_length() == msg.get_length());
+    if (not(mem == expected)) {
+      std::cerr << ">>> expected <<<" << std::endl << expected;
+      std::cerr << ">>> stamped <<<" << std::endl << mem;
+    }
+    CPPUNIT_ASSERT(mem == expected);
+
+    /* the wire image may be parsed like any other Flow-Mod */
+    cofmsg_flow_mod clone;
+    clone.unpack(mem.somem(), mem.length());
+    CPPUNIT_ASSERT(clone.get_xid() == xid);
+    CPPUNIT_ASSERT(clone.get_flowmod().get_match().get_eth_dst() == idst);
+
+    delete stamped;
+  }
+
+  /* the template is left unmodified by stamped instances */
+  rofl::cmemory pristine(proto.length());
+  proto.pack(pristine.somem(), pristine.length());
+  cofmsg_stamped plain(tmpl);
+  rofl::cmemory mem(plain.length());
+  plain.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == pristine);
+}
+
+void cofmsgtemplatetest::testPacketOut10() {
+  testPacketOut(rofl::openflow10::OFP_VERSION);
+}
+
+void cofmsgtemplatetest::testPacketOut13() {
+  testPacketOut(rofl::openflow13::OFP_VERSION);
+}
+
+void cofmsgtemplatetest::testPacketOut(uint8_t version) {
+  cofactions actions(version);
+  actions.add_action_output(rofl::cindex(0))
+      .set_port_no(rofl::openflow::OFPP_FLOOD);
+  cofmsg_packet_out proto(version, 0, rofl::openflow::OFP_NO_BUFFER,
+                          rofl::openflow::OFPP_CONTROLLER, actions);
+  cofmsg_template tmpl(proto);
+
+  CPPUNIT_ASSERT(tmpl.get_type() == rofl::openflow::OFPT_PACKET_OUT);
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_BUFFER_ID));
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_IN_PORT));
+  CPPUNIT_ASSERT(tmpl.has_field(cofmsg_template::FIELD_OUT_PORT));
+  CPPUNIT_ASSERT(not tmpl.has_field(cofmsg_template::FIELD_ETH_DST));
+
+  uint32_t buffer_id = 0x31323334;
+  uint32_t in_port = 0x4142;
+  uint32_t out_port = 0x5152;
+  cofactions iactions(version);
+  iactions.add_action_output(rofl::cindex(0)).set_port_no(out_port);
+  cofmsg_packet_out msg(version, 0xd1d2d3d4, buffer_id, in_port, iactions);
+  rofl::cmemory expected(msg.length());
+  msg.pack(expected.somem(), expected.length());
+
+  cofmsg_stamped stamped(tmpl, 0xd1d2d3d4);
+  stamped.set_buffer_id(buffer_id).set_in_port(in_port).set_out_port(
+      out_port);
+  rofl::cmemory mem(stamped.length());
+  stamped.pack(mem.somem(), mem.length());
+  CPPUNIT_ASSERT(mem == expected);
+}
+
+void cofmsgtemplatetest::testMissingField() {
+  uint8_t version = rofl::openflow13::OFP_VERSION;
+  cofflowmod fe(version);
+  fe.set_command(rofl::openflow::OFPFC_DELETE);
+  cofmsg_flow_mod proto(version, 0, fe);
+  cofmsg_template tmpl(proto);
+  CPPUNIT_ASSERT(not tmpl.has_field(cofmsg_template::FIELD_ETH_DST));
+  CPPUNIT_ASSERT(not tmpl.has_field(cofmsg_template::FIELD_OUT_PORT));
+
+  cofmsg_stamped stamped(tmpl);
+  try {
+    stamped.set_eth_dst(rofl::caddress_ll("00:11:22:33:44:55"));
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+
+  /* only Flow-Mod and Packet-Out messages are supported */
+  cofmsg msg(version, rofl::openflow::OFPT_BARRIER_REQUEST, 0);
+  try {
+    cofmsg_template invalid(msg);
+    CPPUNIT_ASSERT(false);
+  } catch (rofl::eInvalid &e) {
+  }
+
+  /* an empty template is valid */
+  cofmsg_template empty;
+  CPPUNIT_ASSERT(empty.empty());
+  CPPUNIT_ASSERT(not empty.has_field(cofmsg_template::FIELD_COOKIE));
+}
+
@@ -0,0 +1,52 @@
+/*
+ * cofmsgtemplatetest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGTEMPLATETEST_HPP_
+#define TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGTEMPLATETEST_HPP_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "rofl/common/cmemory.h"
+#include "rofl/common/openflow/messages/cofmsg_flow_mod.h"
+#include "rofl/common/openflow/messages/cofmsg_packet_out.h"
+#include "rofl/common/openflow/messages/cofmsg_template.h"
+
+class cofmsgtemplatetest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(cofmsgtemplatetest);
+  CPPUNIT_TEST(testFlowMod10);
+  CPPUNIT_TEST(testFlowMod12);
+  CPPUNIT_TEST(testFlowMod13);
+  CPPUNIT_TEST(testPacketOut10);
+  CPPUNIT_TEST(testPacketOut13);
+  CPPUNIT_TEST(testMissingField);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown();
+
+public:
+  void testFlowMod10();
+  void testFlowMod12();
+  void testFlowMod13();
+  void testPacketOut10();
+  void testPacketOut13();
+  void testMissingField();
+
+public:
+  /* flow entry as installed by ethswctld, shared with the benchmark */
+  static rofl::openflow::cofflowmod flowmod(uint8_t version,
+                                            const rofl::caddress_ll &src,
+                                            const rofl::caddress_ll &dst,
+                                            uint32_t port_no, uint64_t cookie);
+
+private:
+  void testFlowMod(uint8_t version);
+  void testPacketOut(uint8_t version);
+};
+
+#endif /* TEST_SRC_ROFL_COMMON_OPENFLOW_MESSAGES_COFMSGTEMPLATETEST_HPP_ */